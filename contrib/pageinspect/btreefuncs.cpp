@@ -31,6 +31,7 @@
 #include "access/nbtree.h"
 #include "catalog/namespace.h"
 #include "funcapi.h"
+#include "lib/stringinfo.h"
 #include "miscadmin.h"
 #include "utils/builtins.h"
 #include "utils/rel.h"
@@ -249,6 +250,9 @@ Datum bt_page_stats(PG_FUNCTION_ARGS)
  * Get IndexTupleData set in a btree page
  *
  * Usage: SELECT * FROM bt_page_items('t1_pkey', 1);
+ *
+ * For a posting list tuple, data shows the key only and htids lists its
+ * heap TIDs (htids is NULL for other tuples, and absent in version 1.0).
  *-------------------------------------------------------
  */
 
@@ -265,7 +269,7 @@ Datum bt_page_items(PG_FUNCTION_ARGS)
     text* relname = PG_GETARG_TEXT_P(0);
     uint32 blkno = PG_GETARG_UINT32(1);
     Datum result;
-    char* values[6];
+    char* values[7];
     HeapTuple tuple;
     FuncCallContext* fctx = NULL;
     MemoryContext mctx;
@@ -374,9 +378,12 @@ Datum bt_page_items(PG_FUNCTION_ARGS)
         snprintf(values[j++], 32, "%c", IndexTupleHasVarwidths(itup) ? 't' : 'f');
 
         ptr = (char*)itup + IndexInfoFindDataOffset(itup->t_info);
-        dlen = IndexTupleSize(itup) - IndexInfoFindDataOffset(itup->t_info);
+        if (BTreeTupleIsPosting(itup))
+            dlen = BTreeTupleGetPostingOffset(itup) - IndexInfoFindDataOffset(itup->t_info);
+        else
+            dlen = IndexTupleSize(itup) - IndexInfoFindDataOffset(itup->t_info);
         dump = (char*)palloc0(dlen * 3 + 1);
-        values[j] = dump;
+        values[j++] = dump;
         for (off = 0; off < dlen; off++) {
             if (off > 0)
                 *dump++ = ' ';
@@ -384,6 +391,26 @@ Datum bt_page_items(PG_FUNCTION_ARGS)
             dump += 2;
         }
 
+        if (fctx->attinmeta->tupdesc->natts > j) {
+            if (BTreeTupleIsPosting(itup)) {
+                StringInfoData htids;
+                int i;
+
+                initStringInfo(&htids);
+                appendStringInfoChar(&htids, '{');
+                for (i = 0; i < BTreeTupleGetNPosting(itup); i++) {
+                    ItemPointer htid = BTreeTupleGetPostingN(itup, i);
+
+                    appendStringInfo(&htids, "%s\"(%u,%u)\"", (i > 0) ? "," : "",
+                        ItemPointerGetBlockNumberNoCheck(htid), ItemPointerGetOffsetNumberNoCheck(htid));
+                }
+                appendStringInfoChar(&htids, '}');
+                values[j++] = htids.data;
+            } else {
+                values[j++] = NULL;
+            }
+        }
+
         tuple = BuildTupleFromCStrings(fctx->attinmeta, values);
         result = HeapTupleGetDatum(tuple);
 
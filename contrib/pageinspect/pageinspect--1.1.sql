@@ -1,4 +1,4 @@
-/* contrib/pageinspect/pageinspect--1.0.sql */
+/* contrib/pageinspect/pageinspect--1.1.sql */
 
 -- complain if script is sourced in psql, rather than via CREATE EXTENSION
 \echo Use "CREATE EXTENSION pageinspect" to load this file. \quit
@@ -108,7 +108,8 @@ CREATE FUNCTION bt_page_items(IN relname text, IN blkno int4,
     OUT itemlen smallint,
     OUT nulls bool,
     OUT vars bool,
-    OUT data text)
+    OUT data text,
+    OUT htids tid[])
 RETURNS SETOF record
 AS 'MODULE_PATHNAME', 'bt_page_items'
 LANGUAGE C STRICT;
@@ -1925,6 +1925,7 @@ IndexInfo* BuildDummyIndexInfo(Relation index)
     ii->ii_Concurrent = false;
     ii->ii_BrokenHotChain = false;
     ii->ii_PgClassAttrId = 0;
+    ii->ii_ParallelWorkers = 0;
 
     /* fill in attribute numbers */
     for (i = 0; i < numAtts; i++) {
@@ -2795,12 +2796,17 @@ double IndexBuildHeapScan(Relation heapRelation, Relation indexRelation, IndexIn
      * qual checks (because we have to index RECENTLY_DEAD tuples). In a
      * concurrent build, we take a regular MVCC snapshot and index whatever's
      * live according to that.	During bootstrap we just use SnapshotNow.
+     * A parallel build worker scans under the snapshot its leader took,
+     * which the worker has pushed as its active snapshot.
      */
     if (IsBootstrapProcessingMode()) {
         snapshot = SnapshotNow;
         OldestXmin = InvalidTransactionId; /* not used */
     } else if (indexInfo->ii_Concurrent) {
-        snapshot = RegisterSnapshot(GetTransactionSnapshot());
+        if (indexInfo->ii_ParallelWorkers > 1)
+            snapshot = RegisterSnapshot(GetActiveSnapshot());
+        else
+            snapshot = RegisterSnapshot(GetTransactionSnapshot());
         OldestXmin = InvalidTransactionId; /* not used */
     } else {
         snapshot = SnapshotAny;
@@ -2815,6 +2821,13 @@ double IndexBuildHeapScan(Relation heapRelation, Relation indexRelation, IndexIn
         true,                                 /* buffer access strategy OK */
         allow_sync);                          /* syncscan OK? */
 
+    /*
+     * In a parallel build each worker scans its own stripes of
+     * PARALLEL_SCAN_GAP blocks, picked by u_sess->stream_cxt.smp_id.
+     */
+    if (indexInfo->ii_ParallelWorkers > 1)
+        heap_init_parallel_seqscan(scan, indexInfo->ii_ParallelWorkers, ForwardScanDirection);
+
     reltuples = 0;
 
     /*
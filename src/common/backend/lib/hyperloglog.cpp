@@ -164,6 +164,36 @@ double estimateHyperLogLog(hyperLogLogState* cState)
     return result;
 }
 
+/*
+ * Merges the estimate from one HyperLogLog state to another, returning the
+ * union of the two sets.  Both states must have the same register width.
+ */
+void mergeHyperLogLog(hyperLogLogState* cState, const hyperLogLogState* oState)
+{
+    Size r;
+
+    if (cState->nRegisters != oState->nRegisters)
+        ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+                        errmsg("cannot merge hyperLogLog states with different register counts")));
+
+    for (r = 0; r < cState->nRegisters; ++r) {
+        cState->hashesArr[r] = Max(cState->hashesArr[r], oState->hashesArr[r]);
+    }
+}
+
+/*
+ * Free HyperLogLog track state
+ *
+ * Releases allocated resources, but not the state itself (in case it's not
+ * allocated by palloc).
+ */
+void freeHyperLogLog(hyperLogLogState* cState)
+{
+    Assert(cState->hashesArr != NULL);
+    pfree(cState->hashesArr);
+    cState->hashesArr = NULL;
+}
+
 /*
  * Worker for addHyperLogLog().
  *
@@ -3277,9 +3277,12 @@ IndexStmt* transformIndexStmt(Oid relid, IndexStmt* stmt, const char* queryStrin
     rel = relation_open(relid, NoLock);
     rte = addRangeTableEntry(pstate, stmt->relation, NULL, false, true, true, false, true);
 
+    bool isMOTHashIndex = false;
 #ifdef ENABLE_MOT
     if (RelationIsForeignTable(rel) && isMOTFromTblOid(RelationGetRelid(rel))) {
         stmt->internal_flag = true;
+        /* MOT implements hash indexes by itself */
+        isMOTHashIndex = (stmt->accessMethod != NULL && pg_strcasecmp(stmt->accessMethod, "hash") == 0);
     }
 #endif
 
@@ -3337,10 +3340,11 @@ IndexStmt* transformIndexStmt(Oid relid, IndexStmt* stmt, const char* queryStrin
             ereport(ERROR, (errcode(ERRCODE_FEATURE_NOT_SUPPORTED), errmsg("Unsupport cgin index in this version")));
         }
 
-        if (!isColStore && (0 != pg_strcasecmp(stmt->accessMethod, DEFAULT_INDEX_TYPE)) &&
+        if (!isColStore && !isMOTHashIndex && (0 != pg_strcasecmp(stmt->accessMethod, DEFAULT_INDEX_TYPE)) &&
             (0 != pg_strcasecmp(stmt->accessMethod, DEFAULT_GIN_INDEX_TYPE)) &&
-            (0 != pg_strcasecmp(stmt->accessMethod, DEFAULT_GIST_INDEX_TYPE))) {
-            /* row store only support btree/gin/gist index */
+            (0 != pg_strcasecmp(stmt->accessMethod, DEFAULT_GIST_INDEX_TYPE)) &&
+            (0 != pg_strcasecmp(stmt->accessMethod, DEFAULT_BRIN_INDEX_TYPE))) {
+            /* row store only support btree/gin/gist/brin index */
             ereport(ERROR,
                 (errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
                     errmsg("access method \"%s\" does not support row store", stmt->accessMethod)));
@@ -1819,6 +1819,50 @@ double point_dt(Point* pt1, Point* pt2)
     return HYPOT(pt1->x - pt2->x, pt1->y - pt2->y);
 }
 
+/*
+ * Map a coordinate to 32 bits that sort, as unsigned integers, the way the
+ * coordinate does, by way of its float4 representation.
+ */
+static uint32 point_coord_sortbits(double v)
+{
+    union {
+        float4 f;
+        uint32 i;
+    } u;
+
+    if (isnan(v))
+        return PG_UINT32_MAX;
+    u.f = (float4)Max(Min(v, (double)FLT_MAX), (double)-FLT_MAX);
+
+    /* negative values sort in reverse, and below the positive ones */
+    if (u.i & 0x80000000)
+        return ~u.i;
+    return u.i | 0x80000000;
+}
+
+/* spread the bits of a 32-bit value over the even bits of a 64-bit one */
+static uint64 point_spread_bits(uint32 v)
+{
+    uint64 x = v;
+
+    x = (x | (x << 16)) & UINT64CONST(0x0000FFFF0000FFFF);
+    x = (x | (x << 8)) & UINT64CONST(0x00FF00FF00FF00FF);
+    x = (x | (x << 4)) & UINT64CONST(0x0F0F0F0F0F0F0F0F);
+    x = (x | (x << 2)) & UINT64CONST(0x3333333333333333);
+    x = (x | (x << 1)) & UINT64CONST(0x5555555555555555);
+    return x;
+}
+
+/*
+ * Position of (x, y) on a Z-order curve.  Points close to each other mostly
+ * get close positions, so sorting on it clusters the points of an area,
+ * which is what the sorted builds of GiST and SP-GiST indexes rely on.
+ */
+uint64 point_zorder(double x, double y)
+{
+    return (point_spread_bits(point_coord_sortbits(x)) << 1) | point_spread_bits(point_coord_sortbits(y));
+}
+
 Datum point_slope(PG_FUNCTION_ARGS)
 {
     Point* pt1 = PG_GETARG_POINT_P(0);
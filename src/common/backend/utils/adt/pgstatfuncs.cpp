@@ -67,6 +67,7 @@
 #include "instruments/list.h"
 #include "replication/rto_statistic.h"
 #include "storage/lock/lock.h"
+#include "storage/mot/mot_fdw.h"
 
 #define UINT32_ACCESS_ONCE(var) ((uint32)(*((volatile uint32*)&(var))))
 #define NUM_PG_LOCKTAG_ID 12
@@ -239,6 +240,7 @@ extern Datum pv_session_memctx_detail(PG_FUNCTION_ARGS);
 extern Datum pv_total_memory_detail(PG_FUNCTION_ARGS);
 extern Datum mot_global_memory_detail(PG_FUNCTION_ARGS);
 extern Datum mot_local_memory_detail(PG_FUNCTION_ARGS);
+extern Datum mot_table_contention_detail(PG_FUNCTION_ARGS);
 extern Datum gs_total_nodegroup_memory_detail(PG_FUNCTION_ARGS);
 
 extern Datum track_memory_context_detail(PG_FUNCTION_ARGS);
@@ -7539,6 +7541,83 @@ Datum mot_local_memory_detail(PG_FUNCTION_ARGS)
 #endif
 }
 
+/*
+ * Description: Produce a view to show the concurrency control statistics of each MOT table
+ */
+Datum mot_table_contention_detail(PG_FUNCTION_ARGS)
+{
+#ifndef ENABLE_MOT
+    ereport(ERROR, (errcode(ERRCODE_FEATURE_NOT_SUPPORTED), errmsg("This function is not supported in cluster mode.")));
+    PG_RETURN_NULL();
+#else
+    FuncCallContext* funcctx = NULL;
+    MotTableContentionDetail* entry = NULL;
+    MemoryContext oldcontext;
+
+    if (SRF_IS_FIRSTCALL()) {
+        TupleDesc tupdesc;
+
+        /* create a function context for cross-call persistence */
+        funcctx = SRF_FIRSTCALL_INIT();
+
+        /*
+         * Switch to memory context appropriate for multiple function calls
+         */
+        oldcontext = MemoryContextSwitchTo(funcctx->multi_call_memory_ctx);
+
+        /* build tupdesc for result tuples */
+        tupdesc = CreateTemplateTupleDesc(NUM_MOT_TABLE_CONTENTION_DETAIL_ELEM, false);
+
+        TupleDescInitEntry(tupdesc, (AttrNumber) 1, "relid", OIDOID, -1, 0);
+        TupleDescInitEntry(tupdesc, (AttrNumber) 2, "relname", TEXTOID, -1, 0);
+        TupleDescInitEntry(tupdesc, (AttrNumber) 3, "conflicts", INT8OID, -1, 0);
+        TupleDescInitEntry(tupdesc, (AttrNumber) 4, "hot_rows", INT8OID, -1, 0);
+        TupleDescInitEntry(tupdesc, (AttrNumber) 5, "hot_row_locks", INT8OID, -1, 0);
+        TupleDescInitEntry(tupdesc, (AttrNumber) 6, "hot_row_lock_timeouts", INT8OID, -1, 0);
+
+        /* complete descriptor of the tupledesc */
+        funcctx->tuple_desc = BlessTupleDesc(tupdesc);
+
+        /* total number of tuples to be returned */
+        funcctx->user_fctx = (void *)MOTGetTableContentionDetail(&(funcctx->max_calls));
+
+        (void)MemoryContextSwitchTo(oldcontext);
+    }
+
+    /* stuff done on every call of the function */
+    funcctx = SRF_PERCALL_SETUP();
+    entry = (MotTableContentionDetail *)funcctx->user_fctx;
+
+    if (funcctx->call_cntr < funcctx->max_calls) {
+        Datum values[NUM_MOT_TABLE_CONTENTION_DETAIL_ELEM];
+        bool nulls[NUM_MOT_TABLE_CONTENTION_DETAIL_ELEM] = {false};
+        HeapTuple tuple = NULL;
+
+        errno_t rc = 0;
+        rc = memset_s(values, sizeof(values), 0, sizeof(values));
+        securec_check(rc, "\0", "\0");
+        rc = memset_s(nulls, sizeof(nulls), 0, sizeof(nulls));
+        securec_check(rc, "\0", "\0");
+
+        entry += funcctx->call_cntr;
+
+        values[0] = ObjectIdGetDatum(entry->relid);
+        values[1] = CStringGetTextDatum(entry->relname);
+        values[2] = Int64GetDatum(entry->conflicts);
+        values[3] = Int64GetDatum(entry->hotRows);
+        values[4] = Int64GetDatum(entry->hotRowLocks);
+        values[5] = Int64GetDatum(entry->hotRowLockTimeouts);
+
+        tuple = heap_form_tuple(funcctx->tuple_desc, values, nulls);
+
+        SRF_RETURN_NEXT(funcctx, HeapTupleGetDatum(tuple));
+    } else {
+        /* do when there is no more left */
+        SRF_RETURN_DONE(funcctx);
+    }
+#endif
+}
+
 /*
  * @@GaussDB@@
  * Brief		: Collect each thread Memory Context status,
@@ -3049,10 +3049,22 @@ static char* pg_get_constraintdef_worker(Oid constraintId, bool fullCommand, int
                 }
             }
 
+            indexId = get_constraint_index(constraintId);
+
             /* Start off the constraint definition */
-            if (conForm->contype == CONSTRAINT_PRIMARY)
-                appendStringInfo(&buf, "PRIMARY KEY (");
-            else
+            if (conForm->contype == CONSTRAINT_PRIMARY) {
+                appendStringInfo(&buf, "PRIMARY KEY ");
+                /* memory tables may have a hash primary key, any other one is a btree */
+                if (OidIsValid(indexId)) {
+                    HeapTuple idxTup = SearchSysCache1(RELOID, ObjectIdGetDatum(indexId));
+                    if (HeapTupleIsValid(idxTup)) {
+                        if (((Form_pg_class)GETSTRUCT(idxTup))->relam == HASH_AM_OID)
+                            appendStringInfo(&buf, "USING hash ");
+                        ReleaseSysCache(idxTup);
+                    }
+                }
+                appendStringInfo(&buf, "(");
+            } else
                 appendStringInfo(&buf, "UNIQUE (");
 
             /* Fetch and build target column list */
@@ -3074,7 +3086,6 @@ static char* pg_get_constraintdef_worker(Oid constraintId, bool fullCommand, int
                 appendStringInfoChar(&buf, ')');
             }
 
-            indexId = get_constraint_index(constraintId);
             /* XXX why do we only print these bits if fullCommand? */
             if (fullCommand && OidIsValid(indexId)) {
                 char* options = flatten_reloptions(indexId);
@@ -101,6 +101,7 @@
 #include <ctype.h>
 #include <math.h>
 
+#include "access/brin.h"
 #include "access/gin.h"
 #include "access/relscan.h"
 #include "access/sysattr.h"
@@ -6552,6 +6553,122 @@ static void genericcostestimate(PlannerInfo* root, IndexPath* path, double loop_
     *indexCorrelation = 0.0;
 }
 
+/*
+ * Estimate the ordering correlation of an index from the pg_statistic
+ * correlation of its first column, or return 0 if there is none.
+ */
+static double index_leading_column_correlation(PlannerInfo* root, IndexOptInfo* index)
+{
+    Oid relid;
+    AttrNumber colnum;
+    VariableStatData vardata;
+    double correlation = 0.0;
+
+    /*
+     * If we can get an estimate of the first column's ordering correlation C
+     * from pg_statistic, estimate the index correlation as C for a
+     * single-column index, or C * 0.75 for multiple columns. (The idea here
+     * is that multiple columns dilute the importance of the first column's
+     * ordering, but don't negate it entirely.  Before 8.0 we divided the
+     * correlation by the number of columns, but that seems too strong.)
+     */
+    errno_t rc = memset_s(&vardata, sizeof(vardata), 0, sizeof(vardata));
+    securec_check(rc, "\0", "\0");
+
+    if (index->indexkeys[0] != 0) {
+        /* Simple variable --- look to stats for the underlying table */
+        RangeTblEntry* rte = planner_rt_fetch(index->rel->relid, root);
+
+        char relPersistence = get_rel_persistence(rte->relid);
+        Assert(rte->rtekind == RTE_RELATION);
+        relid = rte->relid;
+        Assert(relid != InvalidOid);
+        colnum = index->indexkeys[0];
+
+        char stakind = STARELKIND_CLASS;
+        Oid staoid = relid;
+
+        if (OidIsValid(rte->partitionOid)) {
+            Assert(rte->isContainPartition && rte->ispartrel);
+            stakind = STARELKIND_PARTITION;
+            staoid = rte->partitionOid;
+        }
+
+        if (u_sess->attr.attr_common.upgrade_mode != 0) {
+            vardata.statsTuple = NULL;
+            vardata.freefunc = ReleaseSysCache;
+        } else if (relPersistence == RELPERSISTENCE_GLOBAL_TEMP) {
+            vardata.statsTuple = get_gtt_att_statistic(rte->relid, colnum);
+            vardata.freefunc = release_gtt_statistic_cache;
+        } else {
+            vardata.statsTuple =
+                SearchSysCache4(STATRELKINDATTINH, ObjectIdGetDatum(staoid),
+                              CharGetDatum(stakind), Int16GetDatum(colnum),
+                              BoolGetDatum(rte->inh));
+            vardata.freefunc = ReleaseSysCache;
+        }
+    } else {
+        /* Expression --- maybe there are stats for the index itself */
+        char relPersistence = get_rel_persistence(index->indexoid);
+        relid = index->indexoid;
+        colnum = 1;
+
+        char stakind = STARELKIND_CLASS;
+        Oid staoid = relid;
+
+        if (OidIsValid(index->partitionindex)) {
+            Assert(index->ispartitionedindex);
+            stakind = STARELKIND_PARTITION;
+            staoid = index->partitionindex;
+        }
+
+        if (u_sess->attr.attr_common.upgrade_mode != 0) {
+            vardata.statsTuple = NULL;
+            vardata.freefunc = ReleaseSysCache;
+        } else if (relPersistence == RELPERSISTENCE_GLOBAL_TEMP) {
+            vardata.statsTuple = get_gtt_att_statistic(relid, colnum);
+            vardata.freefunc = release_gtt_statistic_cache;
+        } else {
+            vardata.statsTuple =
+                SearchSysCache4(STATRELKINDATTINH, ObjectIdGetDatum(staoid),
+                              CharGetDatum(stakind), Int16GetDatum(colnum),
+                              BoolGetDatum(false));
+            vardata.freefunc = ReleaseSysCache;
+        }
+    }
+
+    if (HeapTupleIsValid(vardata.statsTuple)) {
+        Oid sortop;
+        float4* numbers = NULL;
+        int nnumbers;
+
+        sortop =
+            get_opfamily_member(index->opfamily[0], index->opcintype[0], index->opcintype[0], BTLessStrategyNumber);
+        if (OidIsValid(sortop) &&
+            get_attstatsslot(vardata.statsTuple, InvalidOid, 0, STATISTIC_KIND_CORRELATION,
+                             sortop, NULL, NULL, NULL, &numbers, &nnumbers)) {
+            double varCorrelation;
+
+            Assert(nnumbers == 1);
+            varCorrelation = numbers[0];
+
+            if (index->reverse_sort[0])
+                varCorrelation = -varCorrelation;
+
+            if (index->nkeycolumns > 1) {
+                correlation = varCorrelation * 0.75;
+            } else {
+                correlation = varCorrelation;
+            }
+            free_attstatsslot(InvalidOid, NULL, 0, numbers, nnumbers);
+        }
+    }
+
+    ReleaseVariableStats(vardata);
+
+    return correlation;
+}
+
 Datum btcostestimate(PG_FUNCTION_ARGS)
 {
     PlannerInfo* root = (PlannerInfo*)PG_GETARG_POINTER(0);
@@ -6562,9 +6679,6 @@ Datum btcostestimate(PG_FUNCTION_ARGS)
     Selectivity* indexSelectivity = (Selectivity*)PG_GETARG_POINTER(5);
     double* indexCorrelation = (double*)PG_GETARG_POINTER(6);
     IndexOptInfo* index = path->indexinfo;
-    Oid relid;
-    AttrNumber colnum;
-    VariableStatData vardata;
     double numIndexTuples;
     List* indexBoundQuals = NIL;
     int indexcol;
@@ -6722,107 +6836,7 @@ Datum btcostestimate(PG_FUNCTION_ARGS)
     genericcostestimate(
         root, path, loop_count, numIndexTuples, indexStartupCost, indexTotalCost, indexSelectivity, indexCorrelation);
 
-    /*
-     * If we can get an estimate of the first column's ordering correlation C
-     * from pg_statistic, estimate the index correlation as C for a
-     * single-column index, or C * 0.75 for multiple columns. (The idea here
-     * is that multiple columns dilute the importance of the first column's
-     * ordering, but don't negate it entirely.  Before 8.0 we divided the
-     * correlation by the number of columns, but that seems too strong.)
-     */
-    errno_t rc = memset_s(&vardata, sizeof(vardata), 0, sizeof(vardata));
-    securec_check(rc, "\0", "\0");
-
-    if (index->indexkeys[0] != 0) {
-        /* Simple variable --- look to stats for the underlying table */
-        RangeTblEntry* rte = planner_rt_fetch(index->rel->relid, root);
-
-        char relPersistence = get_rel_persistence(rte->relid);
-        Assert(rte->rtekind == RTE_RELATION);
-        relid = rte->relid;
-        Assert(relid != InvalidOid);
-        colnum = index->indexkeys[0];
-
-        char stakind = STARELKIND_CLASS;
-        Oid staoid = relid;
-
-        if (OidIsValid(rte->partitionOid)) {
-            Assert(rte->isContainPartition && rte->ispartrel);
-            stakind = STARELKIND_PARTITION;
-            staoid = rte->partitionOid;
-        }
-
-        if (u_sess->attr.attr_common.upgrade_mode != 0) {
-            vardata.statsTuple = NULL;
-            vardata.freefunc = ReleaseSysCache;
-        } else if (relPersistence == RELPERSISTENCE_GLOBAL_TEMP) {
-            vardata.statsTuple = get_gtt_att_statistic(rte->relid, colnum);
-            vardata.freefunc = release_gtt_statistic_cache;
-        } else {
-            vardata.statsTuple =
-                SearchSysCache4(STATRELKINDATTINH, ObjectIdGetDatum(staoid),
-                              CharGetDatum(stakind), Int16GetDatum(colnum),
-                              BoolGetDatum(rte->inh));
-            vardata.freefunc = ReleaseSysCache;
-        }
-    } else {
-        /* Expression --- maybe there are stats for the index itself */
-        char relPersistence = get_rel_persistence(index->indexoid);
-        relid = index->indexoid;
-        colnum = 1;
-
-        char stakind = STARELKIND_CLASS;
-        Oid staoid = relid;
-
-        if (OidIsValid(index->partitionindex)) {
-            Assert(index->ispartitionedindex);
-            stakind = STARELKIND_PARTITION;
-            staoid = index->partitionindex;
-        }
-
-        if (u_sess->attr.attr_common.upgrade_mode != 0) {
-            vardata.statsTuple = NULL;
-            vardata.freefunc = ReleaseSysCache;
-        } else if (relPersistence == RELPERSISTENCE_GLOBAL_TEMP) {
-            vardata.statsTuple = get_gtt_att_statistic(relid, colnum);
-            vardata.freefunc = release_gtt_statistic_cache;
-        } else {
-            vardata.statsTuple =
-                SearchSysCache4(STATRELKINDATTINH, ObjectIdGetDatum(staoid),
-                              CharGetDatum(stakind), Int16GetDatum(colnum),
-                              BoolGetDatum(false));
-            vardata.freefunc = ReleaseSysCache;
-        }
-    }
-
-    if (HeapTupleIsValid(vardata.statsTuple)) {
-        Oid sortop;
-        float4* numbers = NULL;
-        int nnumbers;
-
-        sortop =
-            get_opfamily_member(index->opfamily[0], index->opcintype[0], index->opcintype[0], BTLessStrategyNumber);
-        if (OidIsValid(sortop) &&
-            get_attstatsslot(vardata.statsTuple, InvalidOid, 0, STATISTIC_KIND_CORRELATION,
-                             sortop, NULL, NULL, NULL, &numbers, &nnumbers)) {
-            double varCorrelation;
-
-            Assert(nnumbers == 1);
-            varCorrelation = numbers[0];
-
-            if (index->reverse_sort[0])
-                varCorrelation = -varCorrelation;
-
-            if (index->nkeycolumns > 1) {
-                *indexCorrelation = varCorrelation * 0.75;
-            } else {
-                *indexCorrelation = varCorrelation;
-            }
-            free_attstatsslot(InvalidOid, NULL, 0, numbers, nnumbers);
-        }
-    }
-
-    ReleaseVariableStats(vardata);
+    *indexCorrelation = index_leading_column_correlation(root, index);
 
     PG_RETURN_VOID();
 }
@@ -7565,6 +7579,95 @@ Datum gincostestimate(PG_FUNCTION_ARGS)
     PG_RETURN_VOID();
 }
 
+/*
+ * A BRIN scan reads the whole range map and every summary tuple, and returns
+ * all heap blocks of the ranges that may match.  How many ranges that is
+ * depends on how closely the column follows the physical order of the table,
+ * for which we use the correlation of the leading index column.
+ */
+Datum brincostestimate(PG_FUNCTION_ARGS)
+{
+    PlannerInfo* root = (PlannerInfo*)PG_GETARG_POINTER(0);
+    IndexPath* path = (IndexPath*)PG_GETARG_POINTER(1);
+    double loop_count = PG_GETARG_FLOAT8(2);
+    Cost* indexStartupCost = (Cost*)PG_GETARG_POINTER(3);
+    Cost* indexTotalCost = (Cost*)PG_GETARG_POINTER(4);
+    Selectivity* indexSelectivity = (Selectivity*)PG_GETARG_POINTER(5);
+    double* indexCorrelation = (double*)PG_GETARG_POINTER(6);
+    IndexOptInfo* index = path->indexinfo;
+    List* indexQuals = path->indexquals;
+    double numPages = index->pages;
+    double indexRanges, minimalRanges, estimatedRanges, revmapPages;
+    double qualSelectivity, correlation;
+    double qual_op_cost, qual_arg_cost, spc_random_page_cost, spc_seq_page_cost;
+    QualCost index_qual_cost;
+    Relation indexRel;
+    BrinStatsData statsData;
+    List* saved_varratios = NIL;
+
+    /*
+     * Obtain the range size from the meta page
+     */
+    indexRel = index_open(index->indexoid, AccessShareLock);
+    brinGetStats(indexRel, &statsData);
+    index_close(indexRel, AccessShareLock);
+
+    indexRanges = Max(ceil((double)index->rel->pages / statsData.pagesPerRange), 1.0);
+
+    /* the range map holds one TID per range */
+    revmapPages = Min(ceil(indexRanges * sizeof(ItemPointerData) / BLCKSZ), numPages);
+
+    saved_varratios = index->rel->varratio;
+    index->rel->varratio = NULL;
+    qualSelectivity = clauselist_selectivity(
+        root, add_predicate_to_quals(index, indexQuals), index->rel->relid, JOIN_INNER, NULL, false);
+    list_free_deep(index->rel->varratio);
+    index->rel->varratio = saved_varratios;
+
+    /*
+     * With perfectly correlated data the matching rows fill the fewest
+     * possible ranges; as the correlation drops they spread over more of them,
+     * up to all ranges when there is no correlation at all.
+     */
+    correlation = fabs(index_leading_column_correlation(root, index));
+    minimalRanges = ceil(indexRanges * qualSelectivity);
+    if (correlation < 1.0e-10)
+        estimatedRanges = indexRanges;
+    else
+        estimatedRanges = Min(minimalRanges / correlation, indexRanges);
+
+    *indexSelectivity = estimatedRanges / indexRanges;
+    CLAMP_PROBABILITY(*indexSelectivity);
+    *indexCorrelation = correlation;
+
+    /* fetch estimated page costs for tablespace containing index */
+    get_tablespace_page_costs(index->reltablespace, &spc_random_page_cost, &spc_seq_page_cost);
+
+    /*
+     * Every scan reads the range map in order and then the summary tuples
+     * wherever they are.
+     */
+    *indexStartupCost = spc_seq_page_cost * revmapPages * loop_count;
+    *indexTotalCost = *indexStartupCost + spc_random_page_cost * (numPages - revmapPages) * loop_count;
+
+    /*
+     * Add on index qual eval costs, much as in genericcostestimate; the quals
+     * are checked once per range.
+     */
+    cost_qual_eval(&index_qual_cost, indexQuals, root);
+    qual_arg_cost = index_qual_cost.startup + index_qual_cost.per_tuple;
+    qual_op_cost = u_sess->attr.attr_sql.cpu_operator_cost * list_length(indexQuals);
+    qual_arg_cost -= qual_op_cost;
+    if (qual_arg_cost < 0) /* just in case... */
+        qual_arg_cost = 0;
+
+    *indexStartupCost += qual_arg_cost;
+    *indexTotalCost += qual_arg_cost;
+    *indexTotalCost += indexRanges * (u_sess->attr.attr_sql.cpu_index_tuple_cost + qual_op_cost);
+
+    PG_RETURN_VOID();
+}
+
 bool is_func_distinct_unshippable(Oid funcid)
 {
     for (uint i = 0; i < lengthof(distinct_unshippable_func); i++) {
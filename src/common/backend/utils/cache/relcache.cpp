@@ -33,6 +33,7 @@
 
 #include "access/reloptions.h"
 #include "access/sysattr.h"
+#include "access/toast_compression.h"
 #include "access/transam.h"
 #include "access/xact.h"
 #include "access/xlog.h"
@@ -162,6 +163,7 @@
 #include "storage/smgr.h"
 #include "threadpool/threadpool.h"
 #include "utils/array.h"
+#include "utils/attoptcache.h"
 #include "utils/builtins.h"
 #include "utils/fmgroids.h"
 #include "utils/inval.h"
@@ -1153,6 +1155,7 @@ static void load_critical_index(Oid indexoid, Oid heapoid);
 static TupleDesc GetPgClassDescriptor(void);
 static TupleDesc GetPgIndexDescriptor(void);
 static void AttrDefaultFetch(Relation relation);
+static void AttCompressionFetch(TupleDesc desc, AttrNumber attnum, Datum attoptions);
 static void CheckConstraintFetch(Relation relation);
 static List* insert_ordered_oid(List* list, Oid datum);
 static void IndexSupportInitialize(oidvector* indclass, RegProcedure* indexSupport, Oid* opFamily, Oid* opcInType,
@@ -1462,6 +1465,13 @@ static void RelationBuildTupleDesc(Relation relation, bool onlyLoadInitDefVal)
             }
         }
 
+        /* remember the toast_compression option, if any */
+        if (!onlyLoadInitDefVal) {
+            dval = heap_getattr(pg_attribute_tuple, Anum_pg_attribute_attoptions, pg_attribute_desc->rd_att, &isNull);
+            if (!isNull)
+                AttCompressionFetch(relation->rd_att, attp->attnum, dval);
+        }
+
         /* Update constraint/default info */
         if (attp->attnotnull && !onlyLoadInitDefVal)
             constr->has_not_null = true;
@@ -5002,6 +5012,29 @@ TupleDesc GetDefaultPgIndexDesc(void)
     return GetPgIndexDescriptor();
 }
 
+/*
+ * Store the toast_compression option of a column in the relcache's tuple
+ * descriptor, so that toasting a value needs no catalog lookup.  The array is
+ * only allocated once some column has the option.
+ */
+static void AttCompressionFetch(TupleDesc desc, AttrNumber attnum, Datum attoptions)
+{
+    AttributeOpts* aopts = (AttributeOpts*)attribute_reloptions(attoptions, false);
+
+    if (aopts == NULL)
+        return;
+    if (aopts->toast_compression != 0) {
+        if (desc->attcompression == NULL) {
+            desc->attcompression = (uint8*)MemoryContextAlloc(u_sess->cache_mem_cxt, desc->natts * sizeof(uint8));
+            errno_t rc = memset_s(desc->attcompression, desc->natts * sizeof(uint8), TOAST_INVALID_COMPRESSION_ID,
+                desc->natts * sizeof(uint8));
+            securec_check(rc, "\0", "\0");
+        }
+        desc->attcompression[attnum - 1] = (uint8)CompressionNameToId((char*)aopts + aopts->toast_compression);
+    }
+    pfree(aopts);
+}
+
 /*
  * Load any default attribute value definitions for the relation.
  */
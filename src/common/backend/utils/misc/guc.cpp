@@ -31,6 +31,7 @@
 #include "access/gin.h"
 #ifdef PGXC
 #include "access/gtm.h"
+#include "access/toast_compression.h"
 #include "pgxc/pgxc.h"
 #endif
 #include "access/transam.h"
@@ -272,6 +273,7 @@ const char* sync_guc_variable_namelist[] = {"work_mem",
     "enable_asp",
     "track_counts",
     "track_io_timing",
+    "track_wal_insert_latency",
     "track_functions",
     "update_process_title",
     "log_statement_stats",
@@ -723,6 +725,12 @@ static bool isOptLineCommented(char* optLine)
 static const struct config_enum_entry bytea_output_options[] = {
     {"escape", BYTEA_OUTPUT_ESCAPE, false}, {"hex", BYTEA_OUTPUT_HEX, false}, {NULL, 0, false}};
 
+static const struct config_enum_entry default_toast_compression_options[] = {
+    {"pglz", TOAST_PGLZ_COMPRESSION_ID, false},
+    {"lz4", TOAST_LZ4_COMPRESSION_ID, false},
+    {"zstd", TOAST_ZSTD_COMPRESSION_ID, false},
+    {NULL, 0, false}};
+
 /*
  * We have different sets for client and server message level options because
  * they sort slightly different (see "log" level)
@@ -1273,6 +1281,16 @@ static void InitConfigureNamesBool()
             NULL,
             NULL,
             NULL},
+        {{"enable_incremental_partition_stats",
+             PGC_USERSET,
+             QUERY_TUNING_OTHER,
+             gettext_noop("Enable keeping per-partition statistics and merging them when analyzing partitioned tables."),
+             gettext_noop("Only partitions changed since their statistics were collected are sampled again.")},
+            &u_sess->attr.attr_sql.enable_incremental_partition_stats,
+            false,
+            NULL,
+            NULL,
+            NULL},
         {{"enable_hypo_index",
              PGC_USERSET,                                                    
              QUERY_TUNING_METHOD,                                            
@@ -1600,6 +1618,26 @@ static void InitConfigureNamesBool()
             NULL,
             NULL,
             NULL},
+        {{"enable_vector_output",
+             PGC_USERSET,
+             QUERY_TUNING_METHOD,
+             gettext_noop("Enables sending results of the vector engine to the client a batch at a time."),
+             NULL},
+            &u_sess->attr.attr_sql.enable_vector_output,
+            false,
+            NULL,
+            NULL,
+            NULL},
+        {{"enable_vectorized_scan",
+             PGC_USERSET,
+             QUERY_TUNING_METHOD,
+             gettext_noop("Enables range and full scans of MOT tables to fill batches for the vector engine."),
+             NULL},
+            &u_sess->attr.attr_sql.enable_vectorized_scan,
+            false,
+            NULL,
+            NULL,
+            NULL},
         {{"enable_force_vector_engine",
              PGC_USERSET,
              QUERY_TUNING_METHOD,
@@ -2073,6 +2111,16 @@ static void InitConfigureNamesBool()
             NULL,
             NULL,
             NULL},
+        {{"track_wal_insert_latency",
+             PGC_SUSET,
+             STATS_COLLECTOR,
+             gettext_noop("Collects the latency histogram of WAL inserts."),
+             NULL},
+            &u_sess->attr.attr_common.track_wal_insert_latency,
+            false,
+            NULL,
+            NULL,
+            NULL},
 
         {{"update_process_title",
              PGC_INTERNAL,
@@ -2460,6 +2508,29 @@ static void InitConfigureNamesBool()
             NULL,
             NULL},
 
+        {{"enable_btree_bottomup_delete",
+             PGC_USERSET,
+             CLIENT_CONN_STATEMENT,
+             gettext_noop("Removes dead duplicates from a full B-tree leaf page before splitting it."),
+             gettext_noop("Inserting a duplicate into a full leaf page reads the heap blocks of the page's "
+                          "duplicates to find entries that are dead to everyone.")},
+            &u_sess->attr.attr_storage.enable_btree_bottomup_delete,
+            false,
+            NULL,
+            NULL,
+            NULL},
+        {{"enable_hot_row_locking",
+             PGC_USERSET,
+             LOCK_MANAGEMENT,
+             gettext_noop("Locks MOT rows that frequently fail commit-time validation at first write."),
+             gettext_noop("A transaction that reads a hot row for update locks it immediately and holds "
+                          "the lock until it ends, instead of aborting on the conflict at commit time.")},
+            &u_sess->attr.attr_storage.enable_hot_row_locking,
+            false,
+            NULL,
+            NULL,
+            NULL},
+
         {{"archive_mode",
              PGC_SIGHUP,
              WAL_ARCHIVING,
@@ -3256,6 +3327,17 @@ static void InitConfigureNamesBool()
             NULL,
             NULL},
 
+        {{"enable_auto_parameterize",
+             PGC_USERSET,
+             QUERY_TUNING_METHOD,
+             gettext_noop("Enables replacing literals of simple queries by parameters to reuse cached plans."),
+             NULL},
+            &u_sess->attr.attr_sql.enable_auto_parameterize,
+            false,
+            NULL,
+            NULL,
+            NULL},
+
 #ifndef ENABLE_MULTIPLE_NODES
         {{"enable_beta_opfusion",
              PGC_USERSET,
@@ -3658,6 +3740,18 @@ static void InitConfigureNamesInt()
             NULL,
             NULL,
             NULL},
+        {{"auto_parameterize_max_statements",
+             PGC_USERSET,
+             QUERY_TUNING_OTHER,
+             gettext_noop("Sets the maximum number of auto-parameterized statements kept by a session."),
+             NULL},
+            &u_sess->attr.attr_sql.auto_parameterize_max_statements,
+            256,
+            1,
+            65536,
+            NULL,
+            NULL,
+            NULL},
         {{"max_recursive_times",
              PGC_USERSET,
              QUERY_TUNING_OTHER,
@@ -5326,6 +5420,20 @@ static void InitConfigureNamesInt()
             NULL,
             NULL},
 
+        {{"max_parallel_maintenance_workers",
+             PGC_USERSET,
+             RESOURCES_ASYNCHRONOUS,
+             gettext_noop("Sets the maximum number of worker threads used by a single index build or index vacuum."),
+             gettext_noop("The parallel_workers storage parameter of the index being built, or of the table being "
+                          "vacuumed, overrides this. Index builds need at least 2 workers, vacuum 1.")},
+            &u_sess->attr.attr_storage.max_parallel_maintenance_workers,
+            0,
+            0,
+            64,
+            NULL,
+            NULL,
+            NULL},
+
         {{"log_rotation_age",
              PGC_SIGHUP,
              LOGGING_WHERE,
@@ -6408,6 +6516,19 @@ static void InitConfigureNamesInt()
             NULL,
             NULL},
 
+        {{"heap_extent_max_blocks",
+             PGC_USERSET,
+             RESOURCES_DISK,
+             gettext_noop("Sets the maximum number of new heap blocks a backend reserves for its own inserts."),
+             gettext_noop("The extent grows and shrinks with the backend's insert rate, 0 disables reservation.")},
+            &u_sess->attr.attr_storage.heap_extent_max_blocks,
+            0,
+            0,
+            8192,
+            NULL,
+            NULL,
+            NULL},
+
         {{"gin_pending_list_limit",
              PGC_USERSET,
              CLIENT_CONN_STATEMENT,
@@ -8672,6 +8793,18 @@ static void InitConfigureNamesEnum()
             NULL,
             NULL},
 
+        {{"default_toast_compression",
+             PGC_USERSET,
+             CLIENT_CONN_STATEMENT,
+             gettext_noop("Sets the default compression method for compressible values."),
+             gettext_noop("A column's toast_compression option overrides this.")},
+            &u_sess->attr.attr_storage.default_toast_compression,
+            TOAST_PGLZ_COMPRESSION_ID,
+            default_toast_compression_options,
+            NULL,
+            NULL,
+            NULL},
+
         {{"constraint_exclusion",
              PGC_USERSET,
              QUERY_TUNING_OTHER,
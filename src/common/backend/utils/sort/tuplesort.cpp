@@ -398,6 +398,9 @@ struct Tuplesortstate {
     /* These are specific to the index_hash subcase: */
     uint32 hash_mask; /* mask for sortable part of hash code */
 
+    /* These are specific to the index_sortkey subcase: */
+    FmgrInfo* sortkeyProc; /* maps the first column to an unsigned 64-bit sort key */
+
     /*
      * These variables are specific to the Datum case; they are set by
      * tuplesort_begin_datum and used only by the DatumTuple routines.
@@ -590,9 +593,12 @@ static void writetup_cluster(Tuplesortstate* state, int tapenum, SortTuple* stup
 static void readtup_cluster(Tuplesortstate* state, SortTuple* stup, int tapenum, unsigned int len);
 static int comparetup_index_btree(const SortTuple* a, const SortTuple* b, Tuplesortstate* state);
 static int comparetup_index_hash(const SortTuple* a, const SortTuple* b, Tuplesortstate* state);
+static int comparetup_index_sortkey(const SortTuple* a, const SortTuple* b, Tuplesortstate* state);
 static void copytup_index(Tuplesortstate* state, SortTuple* stup, void* tup);
+static void copytup_index_sortkey(Tuplesortstate* state, SortTuple* stup, void* tup);
 static void writetup_index(Tuplesortstate* state, int tapenum, SortTuple* stup);
 static void readtup_index(Tuplesortstate* state, SortTuple* stup, int tapenum, unsigned int len);
+static void readtup_index_sortkey(Tuplesortstate* state, SortTuple* stup, int tapenum, unsigned int len);
 static void reversedirection_index_btree(Tuplesortstate* state);
 static void reversedirection_index_hash(Tuplesortstate* state);
 static int comparetup_datum(const SortTuple* a, const SortTuple* b, Tuplesortstate* state);
@@ -956,6 +962,52 @@ Tuplesortstate* tuplesort_begin_index_hash(
     return state;
 }
 
+/*
+ * Sort index tuples on a key the opclass derives from their first column,
+ * such as the position of a geometric key on a space-filling curve.  The key
+ * is computed by sortkeyProc, which must return an int8 to be compared as
+ * unsigned; tuples whose first column is null sort last.
+ */
+Tuplesortstate* tuplesort_begin_index_sortkey(
+    Relation indexRel, FmgrInfo* sortkeyProc, int workMem, bool randomAccess, int maxMem)
+{
+    Tuplesortstate* state = tuplesort_begin_common(workMem, randomAccess);
+    MemoryContext oldcontext;
+
+    oldcontext = MemoryContextSwitchTo(state->sortcontext);
+
+#ifdef TRACE_SORT
+    if (u_sess->attr.attr_common.trace_sort) {
+        elog(LOG,
+            "begin index sort: sortkey proc = %u, workMem = %d, randomAccess = %c, maxMem = %d",
+            sortkeyProc->fn_oid,
+            workMem,
+            randomAccess ? 't' : 'f',
+            maxMem);
+    }
+#endif
+
+    state->nKeys = 1; /* Only one sort column, the derived key */
+
+    state->comparetup = comparetup_index_sortkey;
+    state->copytup = copytup_index_sortkey;
+    state->writetup = writetup_index;
+    state->readtup = readtup_index_sortkey;
+#ifdef PGXC
+    state->getlen = getlen;
+#endif
+    state->reversedirection = reversedirection_index_hash;
+
+    state->indexRel = indexRel;
+
+    state->sortkeyProc = sortkeyProc;
+    state->maxMem = maxMem * 1024L;
+
+    (void)MemoryContextSwitchTo(oldcontext);
+
+    return state;
+}
+
 Tuplesortstate* tuplesort_begin_datum(
     Oid datumType, Oid sortOperator, Oid sortCollation, bool nullsFirstFlag, int workMem, bool randomAccess)
 {
@@ -1342,6 +1394,24 @@ void tuplesort_putheaptuple(Tuplesortstate* state, HeapTuple tup)
     (void)MemoryContextSwitchTo(oldcontext);
 }
 
+/*
+ * Accept one index tuple while collecting input data for sort.
+ *
+ * Note that the input tuple is always copied; the caller need not save it.
+ */
+void tuplesort_putindextuple(Tuplesortstate* state, IndexTuple tuple)
+{
+    MemoryContext oldcontext = MemoryContextSwitchTo(state->sortcontext);
+    SortTuple stup;
+    stup.tupindex = 0;
+
+    COPYTUP(state, &stup, (void*)tuple);
+
+    puttuple_common(state, &stup);
+
+    (void)MemoryContextSwitchTo(oldcontext);
+}
+
 /*
  * Collect one index tuple while collecting input data for sort, building
  * it from caller-supplied values.
@@ -3658,6 +3728,55 @@ static int comparetup_index_hash(const SortTuple* a, const SortTuple* b, Tupleso
     return 0;
 }
 
+static int comparetup_index_sortkey(const SortTuple* a, const SortTuple* b, Tuplesortstate* state)
+{
+    IndexTuple tuple1;
+    IndexTuple tuple2;
+
+    if (a->isnull1 != b->isnull1) {
+        return a->isnull1 ? 1 : -1;
+    }
+    if (!a->isnull1) {
+        uint64 key1 = (uint64)DatumGetInt64(a->datum1);
+        uint64 key2 = (uint64)DatumGetInt64(b->datum1);
+
+        if (key1 != key2) {
+            return (key1 < key2) ? -1 : 1;
+        }
+    }
+
+    /* keep equal keys in physical order, as the hash case does */
+    tuple1 = (IndexTuple)a->tuple;
+    tuple2 = (IndexTuple)b->tuple;
+
+    {
+        BlockNumber blk1 = ItemPointerGetBlockNumber(&tuple1->t_tid);
+        BlockNumber blk2 = ItemPointerGetBlockNumber(&tuple2->t_tid);
+
+        if (blk1 != blk2) {
+            return (blk1 < blk2) ? -1 : 1;
+        }
+    }
+    {
+        OffsetNumber pos1 = ItemPointerGetOffsetNumber(&tuple1->t_tid);
+        OffsetNumber pos2 = ItemPointerGetOffsetNumber(&tuple2->t_tid);
+
+        if (pos1 != pos2) {
+            return (pos1 < pos2) ? -1 : 1;
+        }
+    }
+
+    return 0;
+}
+
+/* replace the first column value set up by copytup_index/readtup_index by its sort key */
+static inline void setsortkey_index(Tuplesortstate* state, SortTuple* stup)
+{
+    if (!stup->isnull1) {
+        stup->datum1 = FunctionCall1(state->sortkeyProc, stup->datum1);
+    }
+}
+
 static void copytup_index(Tuplesortstate* state, SortTuple* stup, void* tup)
 {
     IndexTuple tuple = (IndexTuple)tup;
@@ -3675,6 +3794,12 @@ static void copytup_index(Tuplesortstate* state, SortTuple* stup, void* tup)
     stup->datum1 = index_getattr(newtuple, 1, RelationGetDescr(state->indexRel), &stup->isnull1);
 }
 
+static void copytup_index_sortkey(Tuplesortstate* state, SortTuple* stup, void* tup)
+{
+    copytup_index(state, stup, tup);
+    setsortkey_index(state, stup);
+}
+
 static void writetup_index(Tuplesortstate* state, int tapenum, SortTuple* stup)
 {
     IndexTuple tuple = (IndexTuple)stup->tuple;
@@ -3714,6 +3839,12 @@ static void readtup_index(Tuplesortstate* state, SortTuple* stup, int tapenum, u
     stup->datum1 = index_getattr(tuple, 1, RelationGetDescr(state->indexRel), &stup->isnull1);
 }
 
+static void readtup_index_sortkey(Tuplesortstate* state, SortTuple* stup, int tapenum, unsigned int len)
+{
+    readtup_index(state, stup, tapenum, len);
+    setsortkey_index(state, stup);
+}
+
 static void reversedirection_index_btree(Tuplesortstate* state)
 {
     ScanKey scanKey = state->indexScanKey;
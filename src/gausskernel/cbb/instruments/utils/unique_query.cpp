@@ -42,9 +42,13 @@
 #include <unistd.h>
 
 #include "access/hash.h"
-#include "parser/scanner.h"
+#include "lib/stringinfo.h"
+#include "nodes/nodeFuncs.h"
+#include "parser/gramparse.h"
 #include "mb/pg_wchar.h"
 #include "instruments/unique_query.h"
+#include "utils/fmgroids.h"
+#include "utils/lsyscache.h"
 #include "instruments/instr_slow_query.h"
 #include "pgstat.h"
 
@@ -57,6 +61,10 @@ const int CLOCATIONS_BUF_SIZE = 32;
 typedef struct pgssLocationLen {
     int location; /* start offset in query text */
     int length;   /* length in bytes, or -1 to ignore */
+    Const* cnode; /* the constant found at this location */
+    int token;    /* lexer token of the constant, filled by fill_in_constant_lengths */
+    int prev_token;            /* lexer token just before the constant */
+    core_YYSTYPE prev_yylval;  /* semantic value of prev_token */
 } pgssLocationLen;
 
 /*
@@ -86,12 +94,16 @@ void AppendJumble(pgssJumbleState* jstate, const unsigned char* item, Size size)
 void JumbleQuery(pgssJumbleState* jstate, Query* query);
 void JumbleRangeTable(pgssJumbleState* jstate, List* rtable);
 void JumbleExpr(pgssJumbleState* jstate, Node* node);
-void RecordConstLocation(pgssJumbleState* jstate, int location);
+void RecordConstLocation(pgssJumbleState* jstate, int location, Const* cnode);
 uint32 pgss_hash_string(const char* str);
 char* generate_normalized_query(pgssJumbleState* jstate, const char* query, int* query_len_p, int encoding);
 void fill_in_constant_lengths(pgssJumbleState* jstate, const char* query);
 int comp_location(const void* a, const void* b);
 void generate_jstate(pgssJumbleState* jstate, Query* query);
+bool pattern_const_walker(Node* node, List** fixed_consts);
+bool sortgroup_const_walker(Node* node, List** fixed_consts);
+bool collect_const_walker(Node* node, List** consts);
+bool const_is_parameterizable(const pgssLocationLen* loc, List* fixed_consts);
 }  // namespace UniqueSql
 
 /*
@@ -194,6 +206,236 @@ bool normalized_unique_querystring(Query* query, const char* query_string, char*
 
     return result;
 }
+
+/*
+ * Produce the parameterized text of a query for automatic parameterization
+ * of simple-protocol statements: every literal that can be replaced safely
+ * is rewritten as $n, and the matching Const nodes are returned in
+ * *param_consts in parameter order. Literals that must stay in the text
+ * (typed literals, NULL/TRUE/FALSE, pattern-match operands, and literals of
+ * GROUP BY/ORDER BY/DISTINCT ON/HAVING expressions) are kept, so they become
+ * part of the cache key instead.
+ *
+ * Returns a palloc'd null-terminated string, or NULL if the query can't be
+ * parameterized.
+ */
+char* parameterize_unique_querystring(Query* query, const char* query_string, int* num_params, List** param_consts)
+{
+    pgssJumbleState jstate;
+    StringInfoData buf;
+    List* fixed_consts = NIL;
+    List* consts = NIL;
+    pgssLocationLen* last_param = NULL;
+    int query_len;
+    int quer_loc = 0;
+    int nparams = 0;
+    errno_t rc;
+
+    *num_params = 0;
+    *param_consts = NIL;
+    if (query == NULL || query_string == NULL || query->utilityStmt != NULL) {
+        return NULL;
+    }
+
+    rc = memset_s(&jstate, sizeof(jstate), 0, sizeof(jstate));
+    securec_check(rc, "\0", "\0");
+
+    UniqueSql::generate_jstate(&jstate, query);
+    if (jstate.clocations_count > 0) {
+        UniqueSql::fill_in_constant_lengths(&jstate, query_string);
+        (void)query_tree_walker(query, (bool (*)())UniqueSql::pattern_const_walker, (void*)&fixed_consts, 0);
+        (void)UniqueSql::sortgroup_const_walker((Node*)query, &fixed_consts);
+    }
+
+    query_len = strlen(query_string);
+    initStringInfo(&buf);
+
+    for (int i = 0; i < jstate.clocations_count; i++) {
+        pgssLocationLen* loc = &jstate.clocations[i];
+
+        if (loc->length < 0) {
+            /*
+             * A duplicate of the previous location shares its parameter, and
+             * a constant the scanner never reached is simply left in place.
+             */
+            if (last_param != NULL && loc->location == last_param->location &&
+                loc->cnode->consttype != last_param->cnode->consttype) {
+                goto fail;
+            }
+            continue;
+        }
+
+        if (loc->location < quer_loc || loc->location + loc->length > query_len) {
+            goto fail;
+        }
+
+        if (!UniqueSql::const_is_parameterizable(loc, fixed_consts)) {
+            last_param = NULL;
+            continue;
+        }
+
+        appendBinaryStringInfo(&buf, query_string + quer_loc, loc->location - quer_loc);
+        appendStringInfo(&buf, "$%d", ++nparams);
+        quer_loc = loc->location + loc->length;
+        consts = lappend(consts, loc->cnode);
+        last_param = loc;
+    }
+    appendBinaryStringInfo(&buf, query_string + quer_loc, query_len - quer_loc);
+
+    list_free(fixed_consts);
+    pfree(jstate.jumble);
+    pfree(jstate.clocations);
+
+    *num_params = nparams;
+    *param_consts = consts;
+    return buf.data;
+
+fail:
+    list_free(fixed_consts);
+    list_free(consts);
+    pfree(jstate.jumble);
+    pfree(jstate.clocations);
+    pfree(buf.data);
+    return NULL;
+}
+
+/*
+ * Collect the constants used as the pattern of LIKE/regex style operators.
+ * Their selectivity and the index paths the planner can build depend on
+ * the pattern text itself, so they stay literal in parameterized queries.
+ */
+bool UniqueSql::pattern_const_walker(Node* node, List** fixed_consts)
+{
+    if (node == NULL) {
+        return false;
+    }
+
+    if (IsA(node, OpExpr) && list_length(((OpExpr*)node)->args) == 2) {
+        OpExpr* expr = (OpExpr*)node;
+        RegProcedure oprrest = get_oprrest(expr->opno);
+
+        if (oprrest == F_LIKESEL || oprrest == F_NLIKESEL || oprrest == F_ICLIKESEL || oprrest == F_ICNLIKESEL ||
+            oprrest == F_REGEXEQSEL || oprrest == F_REGEXNESEL || oprrest == F_ICREGEXEQSEL ||
+            oprrest == F_ICREGEXNESEL) {
+            Node* pattern = (Node*)lsecond(expr->args);
+
+            while (pattern != NULL && IsA(pattern, RelabelType)) {
+                pattern = (Node*)((RelabelType*)pattern)->arg;
+            }
+            if (pattern != NULL && IsA(pattern, Const)) {
+                *fixed_consts = lappend(*fixed_consts, pattern);
+            }
+        }
+    }
+
+    if (IsA(node, Query)) {
+        return query_tree_walker((Query*)node, (bool (*)())UniqueSql::pattern_const_walker, (void*)fixed_consts, 0);
+    }
+    return expression_tree_walker(node, (bool (*)())UniqueSql::pattern_const_walker, (void*)fixed_consts);
+}
+
+/*
+ * Collect the constants of target entries referenced by GROUP BY, ORDER BY,
+ * DISTINCT ON or window clauses, and of HAVING quals. Parse analysis matches
+ * those expressions against each other by equality, and the clause text that
+ * repeats the expression has no Const of its own in the tree, so replacing
+ * just the target list literal would make the two sides differ ("must appear
+ * in the GROUP BY clause").
+ */
+bool UniqueSql::sortgroup_const_walker(Node* node, List** fixed_consts)
+{
+    if (node == NULL) {
+        return false;
+    }
+
+    if (IsA(node, TargetEntry) && ((TargetEntry*)node)->ressortgroupref != 0) {
+        (void)UniqueSql::collect_const_walker((Node*)((TargetEntry*)node)->expr, fixed_consts);
+    }
+
+    if (IsA(node, Query)) {
+        (void)UniqueSql::collect_const_walker(((Query*)node)->havingQual, fixed_consts);
+        return query_tree_walker((Query*)node, (bool (*)())UniqueSql::sortgroup_const_walker, (void*)fixed_consts, 0);
+    }
+    return expression_tree_walker(node, (bool (*)())UniqueSql::sortgroup_const_walker, (void*)fixed_consts);
+}
+
+bool UniqueSql::collect_const_walker(Node* node, List** consts)
+{
+    if (node == NULL) {
+        return false;
+    }
+
+    if (IsA(node, Const)) {
+        *consts = lappend(*consts, node);
+        return false;
+    }
+
+    if (IsA(node, Query)) {
+        return query_tree_walker((Query*)node, (bool (*)())UniqueSql::collect_const_walker, (void*)consts, 0);
+    }
+    return expression_tree_walker(node, (bool (*)())UniqueSql::collect_const_walker, (void*)consts);
+}
+
+/*
+ * Decide whether the literal at loc can be replaced by a parameter.
+ *
+ * Only plain literal tokens qualify. A literal right after an identifier or
+ * a non-reserved keyword is the "type 'string'" syntax (or an argument of a
+ * keyword construct like INTERVAL, ESCAPE or AT TIME ZONE), which the
+ * grammar only accepts as a string constant.
+ */
+bool UniqueSql::const_is_parameterizable(const pgssLocationLen* loc, List* fixed_consts)
+{
+    Const* cnode = loc->cnode;
+
+    switch (loc->token) {
+        case ICONST:
+        case FCONST:
+        case SCONST:
+        case BCONST:
+        case XCONST:
+            break;
+        default:
+            return false;
+    }
+
+    if (cnode->consttype == UNKNOWNOID || list_member_ptr(fixed_consts, cnode)) {
+        return false;
+    }
+
+    switch (loc->prev_token) {
+        case 0:
+        case Op:
+        case TYPECAST:
+        case PARAM:
+        case ICONST:
+        case FCONST:
+        case SCONST:
+        case BCONST:
+        case XCONST:
+        case COLON_EQUALS:
+        case PARA_EQUALS:
+        case DOT_DOT:
+            return true;
+        case IDENT:
+            return false;
+        default:
+            break;
+    }
+
+    /* single-character tokens are returned as themselves */
+    if (loc->prev_token < 256) {
+        return true;
+    }
+
+    if (loc->prev_yylval.keyword != NULL) {
+        const ScanKeyword* keyword = ScanKeywordLookup(loc->prev_yylval.keyword, ScanKeywords, NumScanKeywords);
+
+        return (keyword != NULL && keyword->category == RESERVED_KEYWORD);
+    }
+    return false;
+}
+
 /*
  * The function generate_jstate() is used to generate jumble for query
  */
@@ -385,7 +627,7 @@ void UniqueSql::JumbleExpr(pgssJumbleState* jstate, Node* node)
             /* We jumble only the constant's type, not its value */
             APP_JUMB(c->consttype);
             /* Also, record its parse location for query normalization */
-            UniqueSql::RecordConstLocation(jstate, c->location);
+            UniqueSql::RecordConstLocation(jstate, c->location, c);
             break;
         }
         case T_Param: {
@@ -699,7 +941,7 @@ void UniqueSql::JumbleExpr(pgssJumbleState* jstate, Node* node)
  * Record location of constant within query string of query tree
  * that is currently being walked.
  */
-void UniqueSql::RecordConstLocation(pgssJumbleState* jstate, int location)
+void UniqueSql::RecordConstLocation(pgssJumbleState* jstate, int location, Const* cnode)
 {
     const int DOUBLE_SIZE = 2;
     /* -1 indicates unknown or undefined location */
@@ -713,6 +955,10 @@ void UniqueSql::RecordConstLocation(pgssJumbleState* jstate, int location)
         jstate->clocations[jstate->clocations_count].location = location;
         /* initialize lengths to -1 to simplify fill_in_constant_lengths */
         jstate->clocations[jstate->clocations_count].length = -1;
+        jstate->clocations[jstate->clocations_count].cnode = cnode;
+        jstate->clocations[jstate->clocations_count].token = 0;
+        jstate->clocations[jstate->clocations_count].prev_token = 0;
+        jstate->clocations[jstate->clocations_count].prev_yylval.str = NULL;
         jstate->clocations_count++;
     }
 }
@@ -854,8 +1100,12 @@ void UniqueSql::fill_in_constant_lengths(pgssJumbleState* jstate, const char* qu
     core_YYSTYPE yylval;
     YYLTYPE yylloc;
     int last_loc = -1;
+    int prev_tok = 0;
+    core_YYSTYPE prev_yylval;
     int i;
 
+    prev_yylval.str = NULL;
+
     /*
      * Sort the records by location so that we can process them in order while
      * scanning the query text.
@@ -890,6 +1140,8 @@ void UniqueSql::fill_in_constant_lengths(pgssJumbleState* jstate, const char* qu
              * run past it, work with that.
              */
             if (yylloc >= loc) {
+                locs[i].prev_token = prev_tok;
+                locs[i].prev_yylval = prev_yylval;
                 if (query[loc] == '-') {
                     /*
                      * It's a negative value - this is the one and only case
@@ -914,8 +1166,13 @@ void UniqueSql::fill_in_constant_lengths(pgssJumbleState* jstate, const char* qu
                  * byte after the text of the current token in scanbuf.
                  */
                 locs[i].length = strlen(yyextra.scanbuf + loc);
+                locs[i].token = tok;
+                prev_tok = tok;
+                prev_yylval = yylval;
                 break; /* out of inner for-loop */
             }
+            prev_tok = tok;
+            prev_yylval = yylval;
         }
 
         /* If we hit end-of-string, give up, leaving remaining lengths -1 */
@@ -20,6 +20,7 @@
 
 #include <math.h>
 
+#include "access/hash.h"
 #include "access/heapam.h"
 #include "access/transam.h"
 #include "access/tupconvert.h"
@@ -45,6 +46,7 @@
 #include "executor/executor.h"
 #include "executor/spi.h"
 #include "foreign/fdwapi.h"
+#include "lib/hyperloglog.h"
 #include "libpq/pqformat.h"
 #include "miscadmin.h"
 #include "nodes/makefuncs.h"
@@ -76,6 +78,7 @@
 #include "utils/sortsupport.h"
 #include "utils/syscache.h"
 #include "utils/timestamp.h"
+#include "utils/typcache.h"
 #include "tcop/utility.h"
 #include "tcop/dest.h"
 #ifdef PGXC
@@ -213,6 +216,10 @@ static int64 acquirePartitionedSampleRows(Relation onerel, VacuumStmt* vacstmt,
     int64 targrows, double* totalrows, double* totaldeadrows, VacAttrStats** vacattrstats, int attrAnalyzeNum);
 
 static Datum std_fetch_func(VacAttrStatsP stats, int rownum, bool* isNull, Relation rel);
+static bool analyze_partitions_incrementally(Relation onerel, VacuumStmt* vacstmt, bool inh,
+    AnalyzeMode analyzemode, int attr_cnt, VacAttrStats** vacattrstats, int nindexes, AnlIndexData* indexdata);
+static void do_analyze_partitions_incremental(Relation onerel, VacuumStmt* vacstmt, int elevel, int64 targrows,
+    int attr_cnt, VacAttrStats** vacattrstats, double* totalrows, double* totaldeadrows, int64* numrows);
 static Datum ind_fetch_func(VacAttrStatsP stats, int rownum, bool* isNull, Relation rel);
 
 static int get_one_tuplesize(Relation onerel, int total_width);
@@ -1643,13 +1650,18 @@ static void do_analyze_rel(Relation onerel, VacuumStmt* vacstmt, BlockNumber rel
         }
     }
 
+    /* A partitioned table may be analyzed from the summaries of its partitions instead */
+    bool merge_partitions = NEED_ANALYZE_SAMPLEROWS(vacstmt) && !replicate_needs_extstats &&
+                            analyze_partitions_incrementally(
+                                onerel, vacstmt, inh, analyzemode, attr_cnt, vacattrstats, nindexes, indexdata);
+
     /*
      * If get sample rows on datanode or coordinator or not. there are two cases:
      * 1. sampleRate > 0 for hash or roundrobin table on datanode;
      * 2. sampleRate == 0 for replication table on datanode;
      * 3. for system table on all nodes.
      */
-    if (onerel->rd_id < FirstNormalObjectId || NEED_GET_SAMPLE_ROWS_DN(vacstmt)) {
+    if (!merge_partitions && (onerel->rd_id < FirstNormalObjectId || NEED_GET_SAMPLE_ROWS_DN(vacstmt))) {
         /*
          * CN has finish caculate sampleRate and DN get total rows and sample.
          * if sampleRate more or equal 0, it means CN should get sample rows from DN.
@@ -1743,7 +1755,10 @@ static void do_analyze_rel(Relation onerel, VacuumStmt* vacstmt, BlockNumber rel
      *
      * collect extended statistic for replicate table will use 'sampletable' method in data-node
      */
-    if (NEED_ANALYZE_SAMPLEROWS(vacstmt) && (!replicate_needs_extstats)) {
+    if (merge_partitions) {
+        do_analyze_partitions_incremental(
+            onerel, vacstmt, elevel, targrows, attr_cnt, vacattrstats, &totalrows, &totaldeadrows, &numrows);
+    } else if (NEED_ANALYZE_SAMPLEROWS(vacstmt) && (!replicate_needs_extstats)) {
         /*
          * Compute the statistics.	Temporary results during the calculations for
          * each column are stored in a child context.  The calc routines are
@@ -4353,6 +4368,684 @@ static int64 acquirePartitionedSampleRows(Relation onerel, VacuumStmt* vacstmt,
     return numRows;
 }
 
+/*
+ * Incremental statistics of partitioned tables
+ *
+ * With enable_incremental_partition_stats on, ANALYZE of a partitioned table
+ * keeps a summary of every partition in pg_statistic (starelkind 'p'): the
+ * partition's own null fraction, width, distinct count, MCV list, histogram
+ * and correlation, plus a HyperLogLog sketch of the distinct values of its
+ * sample.  Only partitions whose summary is missing or stale are sampled;
+ * the statistics of the whole table are then merged from the summaries:
+ *
+ * - null fraction, width and correlation are averaged, weighted by rows;
+ * - the distinct count is the sum over the partitions, scaled down by the
+ *   overlap between them that the union of the sketches shows;
+ * - the frequency of an MCV is summed over the partitions listing it, so a
+ *   value that is common overall but in no single partition is missed;
+ * - the histogram bounds are weighted quantiles of the partitions' bounds
+ *   and of their MCVs that did not make the merged list.
+ *
+ * The summaries also serve queries on a single partition, which the planner
+ * already looks up by the partition's oid.
+ */
+
+#define PARTITION_STATS_HLL_BWIDTH 10
+
+typedef struct {
+    Datum value;   /* a data value */
+    double weight; /* # of rows it stands for */
+} PartStatsItem;
+
+typedef struct {
+    PartStatsItem* items;
+    int nitems;
+    int maxitems;
+} PartStatsItemList;
+
+/*
+ * Can onerel be analyzed by merging the summaries of its partitions?  Only
+ * ordinary row-store range/list/hash partitioned tables on a single node
+ * are, and only if nothing needs the sample of the whole table: no
+ * multi-column statistics and no index expressions.
+ */
+static bool analyze_partitions_incrementally(Relation onerel, VacuumStmt* vacstmt, bool inh,
+    AnalyzeMode analyzemode, int attr_cnt, VacAttrStats** vacattrstats, int nindexes, AnlIndexData* indexdata)
+{
+    if (!u_sess->attr.attr_sql.enable_incremental_partition_stats || !IS_SINGLE_NODE)
+        return false;
+
+    if (inh || analyzemode != ANALYZENORMAL || vacstmt->partList == NIL)
+        return false;
+
+    if (!RELATION_IS_PARTITIONED(onerel) || RELATION_OWN_BUCKET(onerel) || RelationIsColStore(onerel) ||
+        onerel->rd_id < FirstNormalObjectId)
+        return false;
+
+    for (int i = 0; i < attr_cnt; i++) {
+        if (vacattrstats[i]->num_attrs > 1)
+            return false;
+    }
+
+    for (int ind = 0; ind < nindexes; ind++) {
+        if (indexdata[ind].attr_cnt > 0)
+            return false;
+    }
+
+    return true;
+}
+
+/*
+ * Does the partition need to be sampled again?  It does if any analyzed
+ * column has no summary, if it has changed size since the summary was taken
+ * (which catches truncation and exchange), or if enough rows have changed:
+ * any for a manual ANALYZE, as many as would trigger autoanalyze of a table
+ * of its size for autovacuum.
+ */
+static bool partition_summary_is_stale(
+    Relation onerel, Partition part, Relation partRel, int attr_cnt, VacAttrStats** vacattrstats)
+{
+    Oid partid = PartitionGetPartid(part);
+    PgStat_StatTabKey tabkey;
+    PgStat_StatTabEntry* tabentry = NULL;
+    double threshold = 0;
+
+    for (int i = 0; i < attr_cnt; i++) {
+        if (!SearchSysCacheExists4(STATRELKINDATTINH,
+                ObjectIdGetDatum(partid),
+                CharGetDatum(STARELKIND_PARTITION),
+                Int16GetDatum(vacattrstats[i]->attrs[0]->attnum),
+                BoolGetDatum(false)))
+            return true;
+    }
+
+    if ((double)RelationGetNumberOfBlocks(partRel) != part->pd_part->relpages)
+        return true;
+
+    tabkey.tableid = partid;
+    tabkey.statFlag = RelationGetRelid(onerel);
+    tabentry = pgstat_fetch_stat_tabentry(&tabkey);
+    if (tabentry == NULL)
+        return false;
+
+    if (IsAutoVacuumWorkerProcess())
+        threshold = u_sess->attr.attr_storage.autovacuum_anl_thresh +
+                    u_sess->attr.attr_storage.autovacuum_anl_scale * part->pd_part->reltuples;
+
+    return (double)tabentry->changes_since_analyze > threshold;
+}
+
+/*
+ * Forget what compute_stats left in stats for the previous partition.
+ */
+static void clear_attr_stats_result(VacAttrStats* stats, const VacAttrStats* initial)
+{
+    stats->stats_valid = false;
+    stats->stanullfrac = 0;
+    stats->stawidth = 0;
+    stats->stadistinct = 0;
+    stats->stadndistinct = 0;
+
+    for (int k = 0; k < STATISTIC_NUM_SLOTS; k++) {
+        stats->stakind[k] = 0;
+        stats->staop[k] = InvalidOid;
+        stats->numnumbers[k] = 0;
+        stats->stanumbers[k] = NULL;
+        stats->numvalues[k] = 0;
+        stats->stavalues[k] = NULL;
+        stats->stanulls[k] = NULL;
+        stats->statypid[k] = initial->statypid[k];
+        stats->statyplen[k] = initial->statyplen[k];
+        stats->statypbyval[k] = initial->statypbyval[k];
+        stats->statypalign[k] = initial->statypalign[k];
+    }
+}
+
+static uint32 hash_partition_stats_value(VacAttrStats* stats, TypeCacheEntry* typentry, Datum value)
+{
+    Form_pg_type typform = stats->attrtype[0];
+
+    if (OidIsValid(typentry->hash_proc_finfo.fn_oid))
+        return DatumGetUInt32(FunctionCall1Coll(&typentry->hash_proc_finfo, stats->attrs[0]->attcollation, value));
+
+    /* no hash opclass, hash the bytes; equal values stored differently count twice */
+    if (typform->typbyval)
+        return DatumGetUInt32(hash_any((const unsigned char*)&value, sizeof(Datum)));
+    if (typform->typlen == -1) {
+        struct varlena* vl = PG_DETOAST_DATUM_PACKED(value);
+
+        return DatumGetUInt32(hash_any((const unsigned char*)VARDATA_ANY(vl), VARSIZE_ANY_EXHDR(vl)));
+    }
+    if (typform->typlen == -2)
+        return DatumGetUInt32(hash_any((const unsigned char*)DatumGetCString(value), strlen(DatumGetCString(value))));
+    return DatumGetUInt32(hash_any((const unsigned char*)DatumGetPointer(value), typform->typlen));
+}
+
+/*
+ * Add a HyperLogLog slot with the distinct values of the sample to the
+ * statistics just computed, if compute_stats left a slot free.
+ */
+static void compute_partition_hll(VacAttrStats* stats, int samplerows, Relation partRel)
+{
+    TypeCacheEntry* typentry = lookup_type_cache(stats->attrtypid[0], TYPECACHE_HASH_PROC_FINFO);
+    hyperLogLogState hll;
+    MemoryContext old_context;
+    float4* registers = NULL;
+    int slot_idx;
+
+    for (slot_idx = 0; slot_idx < STATISTIC_NUM_SLOTS; slot_idx++) {
+        if (stats->stakind[slot_idx] == 0)
+            break;
+    }
+    if (slot_idx >= STATISTIC_NUM_SLOTS)
+        return;
+
+    initHyperLogLog(&hll, PARTITION_STATS_HLL_BWIDTH);
+    for (int i = 0; i < samplerows; i++) {
+        bool isnull = false;
+        Datum value = std_fetch_func(stats, i, &isnull, partRel);
+
+        if (!isnull)
+            addHyperLogLog(&hll, hash_partition_stats_value(stats, typentry, value));
+    }
+
+    old_context = MemoryContextSwitchTo(stats->anl_context);
+    registers = (float4*)palloc(hll.nRegisters * sizeof(float4));
+    (void)MemoryContextSwitchTo(old_context);
+    for (Size r = 0; r < hll.nRegisters; r++)
+        registers[r] = (float4)hll.hashesArr[r];
+    freeHyperLogLog(&hll);
+
+    stats->stakind[slot_idx] = STATISTIC_KIND_HLL;
+    stats->staop[slot_idx] = InvalidOid;
+    stats->stanumbers[slot_idx] = registers;
+    stats->numnumbers[slot_idx] = (int)hll.nRegisters;
+}
+
+/*
+ * Sample one partition and store its summary.  Returns the partition's live
+ * rows; its dead rows and sampled rows are returned through the pointers.
+ */
+static double summarize_partition(Relation onerel, Partition part, Relation partRel, int elevel, int64 targrows,
+    int attr_cnt, VacAttrStats** vacattrstats, const VacAttrStats* initial, double* deadrows, int64* numrows)
+{
+    HeapTuple* rows = (HeapTuple*)palloc(targrows * sizeof(HeapTuple));
+    double trows = 0;
+    double tdrows = 0;
+    int64 partrows;
+
+    partrows = acquire_sample_rows<false>(partRel, elevel, rows, targrows, &trows, &tdrows);
+
+    for (int i = 0; i < attr_cnt; i++) {
+        VacAttrStats* stats = vacattrstats[i];
+
+        clear_attr_stats_result(stats, &initial[i]);
+        if (partrows > 0) {
+            stats->rows = rows;
+            stats->tupDesc = onerel->rd_att;
+            (*stats->compute_stats)(stats, std_fetch_func, partrows, trows, partRel);
+            if (stats->stats_valid)
+                compute_partition_hll(stats, partrows, partRel);
+        } else {
+            /* an empty partition gets an empty summary, so it is not sampled every time */
+            stats->stats_valid = true;
+        }
+    }
+
+    update_attstats(PartitionGetPartid(part), STARELKIND_PARTITION, false, attr_cnt, vacattrstats,
+        RelationGetRelPersistence(onerel));
+    vac_update_partstats(
+        part, RelationGetNumberOfBlocks(partRel), trows, visibilitymap_count(onerel, part), InvalidTransactionId);
+    pgstat_report_analyze(partRel, trows, tdrows);
+
+    *deadrows = tdrows;
+    *numrows = partrows;
+    return trows;
+}
+
+static void add_partstats_item(PartStatsItemList* list, Datum value, double weight)
+{
+    if (list->nitems >= list->maxitems) {
+        list->maxitems = Max(list->maxitems * 2, 64);
+        if (list->items == NULL)
+            list->items = (PartStatsItem*)palloc(list->maxitems * sizeof(PartStatsItem));
+        else
+            list->items = (PartStatsItem*)repalloc(list->items, list->maxitems * sizeof(PartStatsItem));
+    }
+    list->items[list->nitems].value = value;
+    list->items[list->nitems].weight = weight;
+    list->nitems++;
+}
+
+static int compare_partstats_values(const void* a, const void* b, void* arg)
+{
+    return ApplySortComparator(
+        ((const PartStatsItem*)a)->value, false, ((const PartStatsItem*)b)->value, false, (SortSupport)arg);
+}
+
+static int compare_partstats_weights(const void* a, const void* b)
+{
+    double wa = ((const PartStatsItem*)a)->weight;
+    double wb = ((const PartStatsItem*)b)->weight;
+
+    if (wa > wb)
+        return -1;
+    return (wa < wb) ? 1 : 0;
+}
+
+/*
+ * Fold items with equal values together, adding up their weights.  With a
+ * sort operator this sorts the list by value; otherwise it compares every
+ * pair, which is fine for the few types without one.
+ */
+static void combine_partstats_items(PartStatsItemList* list, SortSupport ssup, FmgrInfo* eqproc)
+{
+    int nunique = 0;
+
+    if (list->nitems == 0)
+        return;
+
+    if (ssup != NULL) {
+        qsort_arg(list->items, list->nitems, sizeof(PartStatsItem), compare_partstats_values, ssup);
+        for (int i = 1; i < list->nitems; i++) {
+            if (ApplySortComparator(list->items[nunique].value, false, list->items[i].value, false, ssup) == 0)
+                list->items[nunique].weight += list->items[i].weight;
+            else
+                list->items[++nunique] = list->items[i];
+        }
+        list->nitems = nunique + 1;
+        return;
+    }
+
+    for (int i = 0; i < list->nitems; i++) {
+        int j;
+
+        for (j = 0; j < nunique; j++) {
+            if (DatumGetBool(
+                    FunctionCall2Coll(eqproc, DEFAULT_COLLATION_OID, list->items[j].value, list->items[i].value)))
+                break;
+        }
+        if (j < nunique)
+            list->items[j].weight += list->items[i].weight;
+        else
+            list->items[nunique++] = list->items[i];
+    }
+    list->nitems = nunique;
+}
+
+/*
+ * Merge the summaries of the partitions into the statistics of one column of
+ * the partitioned table.
+ */
+static void merge_partition_attr_stats(List* partList, const double* partrows, double totalrows, VacAttrStats* stats)
+{
+    Form_pg_attribute attr = stats->attrs[0];
+    Oid typid = stats->attrtypid[0];
+    int num_mcv = Min(attr->attstattarget, MAX_ATTR_MCV_STAT_TARGET);
+    int num_bins = Min(attr->attstattarget, MAX_ATTR_HIST_STAT_TARGET);
+    Oid ltopr = InvalidOid;
+    Oid eqopr = InvalidOid;
+    SortSupportData ssup;
+    FmgrInfo eqproc;
+    PartStatsItemList mcvs = {NULL, 0, 0};
+    PartStatsItemList points = {NULL, 0, 0};
+    hyperLogLogState unionhll = {0, 0, 0, NULL, 0};
+    bool use_hll = true;
+    bool hll_valid = false;
+    double nullrows = 0;
+    double nonnullrows = 0;
+    double widthsum = 0;
+    double sumdistinct = 0;
+    double maxdistinct = 0;
+    double sumsketch = 0;
+    double corrsum = 0;
+    double corrrows = 0;
+    double ndistinct = 0;
+    int nkeep = 0;
+    int slot_idx = 0;
+    int partidx = 0;
+    ListCell* lc = NULL;
+
+    get_sort_group_operators(typid, false, false, false, &ltopr, &eqopr, NULL, NULL);
+    if (!OidIsValid(eqopr))
+        return;
+
+    if (OidIsValid(ltopr)) {
+        errno_t rc = memset_s(&ssup, sizeof(ssup), 0, sizeof(ssup));
+        securec_check(rc, "", "");
+        ssup.ssup_cxt = CurrentMemoryContext;
+        /* We always use the default collation for statistics */
+        ssup.ssup_collation = DEFAULT_COLLATION_OID;
+        ssup.ssup_nulls_first = false;
+        ssup.abbreviate = false;
+        PrepareSortSupportFromOrderingOp(ltopr, &ssup);
+    } else {
+        fmgr_info(get_opcode(eqopr), &eqproc);
+    }
+
+    foreach (lc, partList) {
+        Partition part = (Partition)lfirst(lc);
+        double rows = partrows[partidx++];
+        HeapTuple statstup = NULL;
+        Form_pg_statistic statform = NULL;
+        Datum* values = NULL;
+        int nvalues = 0;
+        float4* numbers = NULL;
+        int nnumbers = 0;
+        double partnonnull;
+        double mcvrows = 0;
+        double partdistinct;
+
+        if (rows <= 0)
+            continue;
+
+        statstup = SearchSysCache4(STATRELKINDATTINH,
+            ObjectIdGetDatum(PartitionGetPartid(part)),
+            CharGetDatum(STARELKIND_PARTITION),
+            Int16GetDatum(attr->attnum),
+            BoolGetDatum(false));
+        if (!HeapTupleIsValid(statstup)) {
+            use_hll = false;
+            continue;
+        }
+        statform = (Form_pg_statistic)GETSTRUCT(statstup);
+
+        partnonnull = rows * (1.0 - statform->stanullfrac);
+        nullrows += rows * statform->stanullfrac;
+        widthsum += statform->stawidth * partnonnull;
+        partdistinct = (statform->stadistinct >= 0) ? statform->stadistinct : -statform->stadistinct * rows;
+        sumdistinct += partdistinct;
+        maxdistinct = Max(maxdistinct, partdistinct);
+
+        if (get_attstatsslot(statstup, typid, attr->atttypmod, STATISTIC_KIND_MCV, InvalidOid, NULL, &values,
+                &nvalues, &numbers, &nnumbers)) {
+            for (int i = 0; i < nvalues && i < nnumbers; i++) {
+                add_partstats_item(&mcvs, values[i], numbers[i] * rows);
+                mcvrows += numbers[i] * rows;
+            }
+            free_attstatsslot(typid, NULL, 0, numbers, nnumbers);
+        }
+
+        if (OidIsValid(ltopr) && get_attstatsslot(statstup, typid, attr->atttypmod, STATISTIC_KIND_HISTOGRAM,
+                                     InvalidOid, NULL, &values, &nvalues, NULL, NULL)) {
+            double weight = Max(partnonnull - mcvrows, 0) / nvalues;
+
+            for (int i = 0; i < nvalues; i++)
+                add_partstats_item(&points, values[i], weight);
+        }
+
+        if (OidIsValid(ltopr) && get_attstatsslot(statstup, typid, attr->atttypmod, STATISTIC_KIND_CORRELATION,
+                                     InvalidOid, NULL, NULL, NULL, &numbers, &nnumbers)) {
+            if (nnumbers > 0) {
+                corrsum += numbers[0] * partnonnull;
+                corrrows += partnonnull;
+            }
+            free_attstatsslot(typid, NULL, 0, numbers, nnumbers);
+        }
+
+        if (use_hll && get_attstatsslot(statstup, typid, attr->atttypmod, STATISTIC_KIND_HLL, InvalidOid, NULL, NULL,
+                           NULL, &numbers, &nnumbers)) {
+            if (nnumbers == (1 << PARTITION_STATS_HLL_BWIDTH)) {
+                hyperLogLogState hll;
+
+                initHyperLogLog(&hll, PARTITION_STATS_HLL_BWIDTH);
+                for (int r = 0; r < nnumbers; r++)
+                    hll.hashesArr[r] = (uint8)numbers[r];
+                sumsketch += estimateHyperLogLog(&hll);
+                if (!hll_valid) {
+                    unionhll = hll;
+                    hll_valid = true;
+                } else {
+                    mergeHyperLogLog(&unionhll, &hll);
+                    freeHyperLogLog(&hll);
+                }
+            } else {
+                /* a sketch of another width cannot be merged */
+                use_hll = false;
+            }
+            free_attstatsslot(typid, NULL, 0, numbers, nnumbers);
+        } else if (partnonnull > 0) {
+            use_hll = false;
+        }
+
+        ReleaseSysCache(statstup);
+    }
+
+    nonnullrows = totalrows - nullrows;
+    stats->stats_valid = true;
+    if (nonnullrows <= 0) {
+        /* the column is entirely null */
+        stats->stanullfrac = 1.0;
+        stats->stawidth = (stats->attrtype[0]->typlen > 0) ? stats->attrtype[0]->typlen : 0;
+        stats->stadistinct = 0.0;
+        return;
+    }
+    stats->stanullfrac = (float4)(nullrows / totalrows);
+    stats->stawidth = (int4)(widthsum / nonnullrows + 0.5);
+
+    /*
+     * Partitions holding disjoint values add up; partitions holding the same
+     * values do not.  The union of the sample sketches against their sum
+     * tells where between the two we are.
+     */
+    ndistinct = sumdistinct;
+    if (use_hll && hll_valid && sumsketch > 0)
+        ndistinct *= Min(estimateHyperLogLog(&unionhll) / sumsketch, 1.0);
+    ndistinct = Max(ndistinct, maxdistinct);
+    ndistinct = floor(Min(ndistinct, nonnullrows) + 0.5);
+
+    /* Keep the values common enough in the whole table as MCVs */
+    combine_partstats_items(&mcvs, OidIsValid(ltopr) ? &ssup : NULL, &eqproc);
+    if (mcvs.nitems > 0) {
+        qsort(mcvs.items, mcvs.nitems, sizeof(PartStatsItem), compare_partstats_weights);
+        if (mcvs.nitems <= num_mcv && mcvs.nitems >= ndistinct) {
+            nkeep = mcvs.nitems;
+        } else {
+            double mincount = (ndistinct > 0) ? 1.25 * nonnullrows / ndistinct : 0;
+
+            while (nkeep < mcvs.nitems && nkeep < num_mcv && mcvs.items[nkeep].weight > mincount)
+                nkeep++;
+        }
+    }
+
+    if (nkeep > 0) {
+        MemoryContext old_context = MemoryContextSwitchTo(stats->anl_context);
+        Datum* mcv_values = (Datum*)palloc(nkeep * sizeof(Datum));
+        float4* mcv_freqs = (float4*)palloc(nkeep * sizeof(float4));
+
+        for (int i = 0; i < nkeep; i++) {
+            mcv_values[i] =
+                datumCopy(mcvs.items[i].value, stats->attrtype[0]->typbyval, stats->attrtype[0]->typlen);
+            mcv_freqs[i] = (float4)(mcvs.items[i].weight / totalrows);
+        }
+        (void)MemoryContextSwitchTo(old_context);
+
+        stats->stakind[slot_idx] = STATISTIC_KIND_MCV;
+        stats->staop[slot_idx] = eqopr;
+        stats->stanumbers[slot_idx] = mcv_freqs;
+        stats->numnumbers[slot_idx] = nkeep;
+        stats->stavalues[slot_idx] = mcv_values;
+        stats->numvalues[slot_idx] = nkeep;
+        slot_idx++;
+    }
+
+    /* The MCVs left out now belong to the histogram population */
+    for (int i = nkeep; i < mcvs.nitems; i++)
+        add_partstats_item(&points, mcvs.items[i].value, mcvs.items[i].weight);
+
+    if (OidIsValid(ltopr) && points.nitems >= 2 && ndistinct - nkeep >= 2) {
+        int num_hist = Min(num_bins + 1, points.nitems);
+        double totalweight = 0;
+        double cumweight = 0;
+        int pos = 0;
+        MemoryContext old_context;
+        Datum* hist_values = NULL;
+
+        qsort_arg(points.items, points.nitems, sizeof(PartStatsItem), compare_partstats_values, &ssup);
+        for (int i = 0; i < points.nitems; i++)
+            totalweight += points.items[i].weight;
+
+        /* first and last bounds are the extremes, the others weighted quantiles */
+        old_context = MemoryContextSwitchTo(stats->anl_context);
+        hist_values = (Datum*)palloc(num_hist * sizeof(Datum));
+        for (int i = 0; i < num_hist; i++) {
+            Datum bound;
+
+            if (i == num_hist - 1) {
+                bound = points.items[points.nitems - 1].value;
+            } else {
+                double target = totalweight * i / (num_hist - 1);
+
+                while (pos < points.nitems - 1 && cumweight + points.items[pos].weight < target) {
+                    cumweight += points.items[pos].weight;
+                    pos++;
+                }
+                bound = points.items[pos].value;
+            }
+            hist_values[i] = datumCopy(bound, stats->attrtype[0]->typbyval, stats->attrtype[0]->typlen);
+        }
+        (void)MemoryContextSwitchTo(old_context);
+
+        stats->stakind[slot_idx] = STATISTIC_KIND_HISTOGRAM;
+        stats->staop[slot_idx] = ltopr;
+        stats->stavalues[slot_idx] = hist_values;
+        stats->numvalues[slot_idx] = num_hist;
+        slot_idx++;
+    }
+
+    if (corrrows > 0) {
+        MemoryContext old_context = MemoryContextSwitchTo(stats->anl_context);
+        float4* corrs = (float4*)palloc(sizeof(float4));
+
+        (void)MemoryContextSwitchTo(old_context);
+        corrs[0] = (float4)(corrsum / corrrows);
+        stats->stakind[slot_idx] = STATISTIC_KIND_CORRELATION;
+        stats->staop[slot_idx] = ltopr;
+        stats->stanumbers[slot_idx] = corrs;
+        stats->numnumbers[slot_idx] = 1;
+        slot_idx++;
+    }
+
+    /* Same convention as analyze_compute_ndistinct */
+    stats->stadistinct = (float4)ndistinct;
+    if (stats->stadistinct > 0.1 * totalrows)
+        stats->stadistinct = -(stats->stadistinct / totalrows);
+}
+
+/*
+ * Analyze a partitioned table by bringing the summaries of its partitions up
+ * to date and merging them, in place of sampling the whole table.  Returns
+ * the table's rows, dead rows and the number of rows sampled this time.
+ */
+static void do_analyze_partitions_incremental(Relation onerel, VacuumStmt* vacstmt, int elevel, int64 targrows,
+    int attr_cnt, VacAttrStats** vacattrstats, double* totalrows, double* totaldeadrows, int64* numrows)
+{
+    int nparts = list_length(vacstmt->partList);
+    double* partrows = (double*)palloc0(nparts * sizeof(double));
+    VacAttrStats* initial = (VacAttrStats*)palloc(attr_cnt * sizeof(VacAttrStats));
+    MemoryContext* anl_contexts = (MemoryContext*)palloc(attr_cnt * sizeof(MemoryContext));
+    MemoryContext part_context;
+    MemoryContext old_context;
+    ListCell* lc = NULL;
+    int partidx = 0;
+    int nsampled = 0;
+    errno_t rc;
+
+    *totalrows = 0;
+    *totaldeadrows = 0;
+    *numrows = 0;
+
+    for (int i = 0; i < attr_cnt; i++) {
+        rc = memcpy_s(&initial[i], sizeof(VacAttrStats), vacattrstats[i], sizeof(VacAttrStats));
+        securec_check(rc, "", "");
+        anl_contexts[i] = vacattrstats[i]->anl_context;
+    }
+
+    part_context = AllocSetContextCreate(CurrentMemoryContext,
+        "PartitionStatsContext",
+        ALLOCSET_DEFAULT_MINSIZE,
+        ALLOCSET_DEFAULT_INITSIZE,
+        ALLOCSET_DEFAULT_MAXSIZE);
+
+    /* Bring the summaries up to date; their results live only as long as the partition's turn */
+    foreach (lc, vacstmt->partList) {
+        Partition part = (Partition)lfirst(lc);
+        Relation partRel = partitionGetRelation(onerel, part);
+
+        vacuum_delay_point();
+
+        if (partition_summary_is_stale(onerel, part, partRel, attr_cnt, vacattrstats)) {
+            double deadrows = 0;
+            int64 sampled = 0;
+
+            old_context = MemoryContextSwitchTo(part_context);
+            for (int i = 0; i < attr_cnt; i++)
+                vacattrstats[i]->anl_context = part_context;
+            partrows[partidx] = summarize_partition(
+                onerel, part, partRel, elevel, targrows, attr_cnt, vacattrstats, initial, &deadrows, &sampled);
+            for (int i = 0; i < attr_cnt; i++)
+                vacattrstats[i]->anl_context = anl_contexts[i];
+            (void)MemoryContextSwitchTo(old_context);
+            MemoryContextReset(part_context);
+
+            *totaldeadrows += deadrows;
+            *numrows += sampled;
+            nsampled++;
+        } else {
+            PgStat_StatTabKey tabkey;
+            PgStat_StatTabEntry* tabentry = NULL;
+
+            partrows[partidx] = part->pd_part->reltuples;
+            tabkey.tableid = PartitionGetPartid(part);
+            tabkey.statFlag = RelationGetRelid(onerel);
+            tabentry = pgstat_fetch_stat_tabentry(&tabkey);
+            if (tabentry != NULL)
+                *totaldeadrows += tabentry->n_dead_tuples;
+        }
+
+        *totalrows += partrows[partidx];
+        partidx++;
+        releaseDummyRelation(&partRel);
+    }
+
+    /* Let the merge see the summaries just stored */
+    CommandCounterIncrement();
+
+    ereport(elevel,
+        (errmsg("\"%s\": sampled %d of %d partitions, merging partition statistics",
+            RelationGetRelationName(onerel),
+            nsampled,
+            nparts)));
+
+    for (int i = 0; i < attr_cnt; i++) {
+        VacAttrStats* stats = vacattrstats[i];
+        AttributeOpts* aopt = NULL;
+
+        clear_attr_stats_result(stats, &initial[i]);
+        if (*totalrows <= 0)
+            continue;
+
+        old_context = MemoryContextSwitchTo(part_context);
+        merge_partition_attr_stats(vacstmt->partList, partrows, *totalrows, stats);
+        (void)MemoryContextSwitchTo(old_context);
+        MemoryContextReset(part_context);
+
+        aopt = get_attribute_options(onerel->rd_id, stats->attrs[0]->attnum);
+        if (aopt != NULL && fabs(aopt->n_distinct) > EPSILON)
+            stats->stadistinct = aopt->n_distinct;
+
+        set_stats_dndistinct(stats, vacstmt, vacstmt->tableidx);
+    }
+
+    MemoryContextDelete(part_context);
+    pfree_ext(partrows);
+    pfree_ext(initial);
+    pfree_ext(anl_contexts);
+
+    update_attstats(RelationGetRelid(onerel), STARELKIND_CLASS, false, attr_cnt, vacattrstats,
+        RelationGetRelPersistence(onerel));
+}
+
 void releaseSourceAfterDelteOrUpdateAttStats(
     ResourceOwner asOwner, ResourceOwner oldOwner1, Relation pgstat, Relation pgstat_ext)
 {
@@ -65,6 +65,8 @@
 #include "rewrite/rewriteHandler.h"
 #include "storage/fd.h"
 #include "storage/pagecompress.h"
+#include "storage/cstore/cstore_compress.h"
+#include "access/reloptions.h"
 #include "tcop/tcopprot.h"
 #include "tcop/utility.h"
 #include "catalog/pg_partition_fn.h"
@@ -209,6 +211,37 @@ typedef struct {
         ((void)0)
 
 static const char BinarySignature[15] = "PGCOPY\n\377\r\n\0";
+static const char ColumnarSignature[15] = "PGCOLC\n\377\r\n\0";
+
+/*
+ * COLUMNAR format: a variant of BINARY that ships rows in chunks, one column
+ * after another, each column compressed by the cstore integer/string coders.
+ * Chunks are cut at a full CU worth of rows or at COLUMNAR_CHUNK_BYTES of raw
+ * data, whichever comes first.  A chunk with zero rows ends the stream.
+ */
+#define COLUMNAR_CHUNK_ROWS 60000
+#define COLUMNAR_CHUNK_BYTES (64 * 1024 * 1024)
+#define COLUMNAR_BYTE_ORDER_MARK 0x01020304
+
+typedef struct CopyColumnarColumn {
+    Oid typid;        /* column type */
+    int16 typlen;     /* 2/4/8 for integer-like columns, 0 for send/recv form */
+    bits8* nulls;     /* null bitmap of the current chunk, bit set means NULL */
+    StringInfoData data; /* raw column values being built (COPY TO) */
+    char* vals;       /* decompressed column values (COPY FROM) */
+    int vals_len;     /* length of vals */
+    int pos;          /* read offset in vals */
+} CopyColumnarColumn;
+
+typedef struct CopyColumnarState {
+    int natts;              /* number of columns in attnumlist */
+    int nrows;              /* rows in the current chunk */
+    int cur_row;            /* next row to return (COPY FROM) */
+    int16 compress_modes;   /* compressing modes for column values */
+    Size chunk_bytes;       /* raw bytes accumulated in the current chunk */
+    CopyColumnarColumn* cols;
+    MemoryContext chunkcxt; /* reset once per chunk */
+} CopyColumnarState;
 
 /* non-export function prototypes */
 static CopyState BeginCopy(bool is_from, Relation rel, Node* raw_query, const char* queryString, List* attnamelist,
@@ -252,6 +285,14 @@ static void bulkload_set_readattrs_func(CopyState cstate);
 static void bulkload_init_time_format(CopyState cstate);
 static Datum CopyReadBinaryAttribute(
     CopyState cstate, int column_no, FmgrInfo* flinfo, Oid typioparam, int32 typmod, bool* isnull);
+static int16 CopyColumnarIntLen(Oid typid);
+static CopyColumnarState* CopyColumnarInitState(CopyState cstate, TupleDesc tupDesc);
+static void CopyColumnarSendHeader(CopyState cstate);
+static void CopyColumnarAppendRow(CopyState cstate, Datum* values, const bool* nulls);
+static void CopyColumnarFlushChunk(CopyState cstate);
+static void CopyColumnarReadHeader(CopyState cstate, TupleDesc tupDesc);
+static bool CopyColumnarReadChunk(CopyState cstate);
+static bool CopyColumnarNextRow(CopyState cstate, Datum* values, bool* nulls);
 static void CopyAttributeOutText(CopyState cstate, char* string);
 static void CopyAttributeOutCSV(CopyState cstate, char* string, bool use_quote, bool single_attr);
 List* CopyGetAttnums(TupleDesc tupDesc, Relation rel, List* attnamelist);
@@ -1229,6 +1270,13 @@ static void CheckCopyIncompatibleOptions(CopyState cstate, int force_fix_width)
     if ((IS_BINARY(cstate) || IS_FIXED(cstate)) && cstate->null_print)
         ereport(ERROR, (errcode(ERRCODE_SYNTAX_ERROR), errmsg("cannot specify NULL in BINARY/FIXED mode")));
 
+    if (IS_COLUMNAR(cstate) && !IS_SINGLE_NODE)
+        ereport(ERROR,
+            (errcode(ERRCODE_FEATURE_NOT_SUPPORTED), errmsg("COLUMNAR format is only supported in single node mode")));
+
+    if (IS_COLUMNAR(cstate) && cstate->oids)
+        ereport(ERROR, (errcode(ERRCODE_SYNTAX_ERROR), errmsg("cannot specify OIDS in COLUMNAR mode")));
+
     if (!IS_FIXED(cstate) && cstate->formatter)
         ereport(ERROR, (errcode(ERRCODE_SYNTAX_ERROR), errmsg("FORMATTER only can be specified in FIXED mode")));
 
@@ -1307,6 +1355,10 @@ void ProcessCopyOptions(CopyState cstate, bool is_from, List* options)
                 cstate->fileformat = FORMAT_CSV;
             else if (strcasecmp(fmt, "binary") == 0)
                 cstate->fileformat = FORMAT_BINARY;
+            else if (strcasecmp(fmt, "columnar") == 0) {
+                cstate->fileformat = FORMAT_BINARY;
+                cstate->columnar = true;
+            }
             else if (strcasecmp(fmt, "fixed") == 0)
                 cstate->fileformat = FORMAT_FIXED;
             else
@@ -2573,7 +2625,13 @@ static uint64 CopyTo(CopyState cstate, bool isFirst, bool isLast)
     cstate->rowcontext = AllocSetContextCreate(
         CurrentMemoryContext, "COPY TO", ALLOCSET_DEFAULT_MINSIZE, ALLOCSET_DEFAULT_INITSIZE, ALLOCSET_DEFAULT_MAXSIZE);
 
-    if (IS_BINARY(cstate)) {
+    if (IS_COLUMNAR(cstate)) {
+        /* Chunk state outlives the per-partition CopyTo() calls */
+        if (cstate->columnar_state == NULL)
+            cstate->columnar_state = CopyColumnarInitState(cstate, tupDesc);
+        if (isFirst)
+            CopyColumnarSendHeader(cstate);
+    } else if (IS_BINARY(cstate)) {
 #ifdef PGXC
         if ((IS_PGXC_COORDINATOR || IS_SINGLE_NODE) && isFirst) {
 #endif
@@ -2694,14 +2752,21 @@ static uint64 CopyTo(CopyState cstate, bool isFirst, bool isLast)
     }
 #endif
 
+    if (IS_COLUMNAR(cstate)) {
+        if (isLast) {
+            /* Flush the pending chunk, then an empty chunk as the trailer */
+            CopyColumnarFlushChunk(cstate);
+            CopySendInt32(cstate, 0);
+            CopySendEndOfRow<false>(cstate);
+        }
 #ifdef PGXC
     /*
      * In PGXC, it is not necessary for a Datanode to generate
      * the trailer as Coordinator is in charge of it
      */
-    if (IS_BINARY(cstate) && IS_PGXC_COORDINATOR && isLast) {
+    } else if (IS_BINARY(cstate) && IS_PGXC_COORDINATOR && isLast) {
 #else
-    if (IS_BINARY(cstate) && isLast) {
+    } else if (IS_BINARY(cstate) && isLast) {
 #endif
         /* Generate trailer for a binary copy */
         CopySendInt16(cstate, -1);
@@ -2783,6 +2848,12 @@ static void CopyOneRowTo(CopyState cstate, Oid tupleOid, Datum* values, const bo
     MemoryContextReset(cstate->rowcontext);
     oldcontext = MemoryContextSwitchTo(cstate->rowcontext);
 
+    if (IS_COLUMNAR(cstate)) {
+        CopyColumnarAppendRow(cstate, values, nulls);
+        MemoryContextSwitchTo(oldcontext);
+        return;
+    }
+
     if (IS_BINARY(cstate)) {
         /* Binary per-tuple header */
         CopySendInt16(cstate, list_length(cstate->attnumlist));
@@ -5001,6 +5072,10 @@ CopyState BeginCopyFrom(Relation rel, const char* filename, List* attnamelist, L
     if (!IS_BINARY(cstate)) {
         /* must rely on user to tell us... */
         cstate->file_has_oids = cstate->oids;
+    } else if (IS_COLUMNAR(cstate)) {
+        /* Read and verify columnar header, OIDS are rejected up front */
+        cstate->file_has_oids = false;
+        CopyColumnarReadHeader(cstate, tupDesc);
     } else {
         /* Read and verify binary header */
         char readSig[11];
@@ -5454,6 +5529,10 @@ bool NextCopyFrom(CopyState cstate, ExprContext* econtext, Datum* values, bool*
         }
 
         Assert(fieldno == nfields);
+    } else if (IS_COLUMNAR(cstate)) {
+        cstate->cur_lineno++;
+        if (!CopyColumnarNextRow(cstate, values, nulls))
+            return false;
     } else {
         /* binary */
         int16 fld_count;
@@ -6806,6 +6885,502 @@ static Datum CopyReadBinaryAttribute(
     return result;
 }
 
+/*
+ * @Description: value size of a column stored in native integer form by the
+ *    COLUMNAR format, 0 if the column goes through its send/recv functions.
+ * @IN typid: column type
+ * @Return: 2, 4, 8 or 0
+ */
+static int16 CopyColumnarIntLen(Oid typid)
+{
+    switch (typid) {
+        case INT2OID:
+            return sizeof(int16);
+        case INT4OID:
+        case OIDOID:
+        case DATEOID:
+            return sizeof(int32);
+        case INT8OID:
+            return sizeof(int64);
+#ifdef HAVE_INT64_TIMESTAMP
+        case TIMEOID:
+        case TIMESTAMPOID:
+        case TIMESTAMPTZOID:
+            return sizeof(int64);
+#endif
+        default:
+            return 0;
+    }
+}
+
+/*
+ * @Description: set up the chunk state of a COLUMNAR copy. Column values are
+ *    compressed with the relation's own modes when copying a cstore table,
+ *    otherwise with the cheapest LZ4 level.
+ * @IN cstate: the current CopyState
+ * @IN tupDesc: descriptor the attnumlist refers to
+ * @Return: the new chunk state
+ */
+static CopyColumnarState* CopyColumnarInitState(CopyState cstate, TupleDesc tupDesc)
+{
+    CopyColumnarState* state = (CopyColumnarState*)palloc0(sizeof(CopyColumnarState));
+    Form_pg_attribute* attr = tupDesc->attrs;
+    ListCell* cur = NULL;
+    int c = 0;
+
+    state->natts = list_length(cstate->attnumlist);
+    state->cols = (CopyColumnarColumn*)palloc0(Max(state->natts, 1) * sizeof(CopyColumnarColumn));
+    state->chunkcxt = AllocSetContextCreate(CurrentMemoryContext,
+        "COPY COLUMNAR",
+        ALLOCSET_DEFAULT_MINSIZE,
+        ALLOCSET_DEFAULT_INITSIZE,
+        ALLOCSET_DEFAULT_MAXSIZE);
+
+    if (cstate->rel != NULL && RelationIsColStore(cstate->rel) && !RelationIsPAXFormat(cstate->rel))
+        heaprel_set_compressing_modes(cstate->rel, &state->compress_modes);
+    else
+        heaprel_make_compressing_modes(COMPRESS_LOW, 0, &state->compress_modes);
+
+    foreach (cur, cstate->attnumlist) {
+        int attnum = lfirst_int(cur);
+        CopyColumnarColumn* col = &state->cols[c++];
+
+        col->typid = attr[attnum - 1]->atttypid;
+        col->typlen = CopyColumnarIntLen(col->typid);
+        if (!cstate->is_from) {
+            col->nulls = (bits8*)palloc0(BITMAPLEN(COLUMNAR_CHUNK_ROWS));
+            initStringInfo(&col->data);
+        }
+    }
+
+    return state;
+}
+
+/*
+ * @Description: send the COLUMNAR file header: signature, flags, header
+ *    extension, column count, a native byte order mark and the type of each column.
+ * @IN cstate: the current CopyState
+ * @Return: void
+ */
+static void CopyColumnarSendHeader(CopyState cstate)
+{
+    CopyColumnarState* state = cstate->columnar_state;
+    int32 bom = COLUMNAR_BYTE_ORDER_MARK;
+
+    CopySendData(cstate, ColumnarSignature, 11);
+    /* Flags field */
+    CopySendInt32(cstate, 0);
+    /* No header extension */
+    CopySendInt32(cstate, 0);
+    CopySendInt16(cstate, (int16)state->natts);
+    /* Integer columns travel in native form, so the reader must match */
+    CopySendData(cstate, &bom, sizeof(int32));
+    for (int c = 0; c < state->natts; c++) {
+        CopySendInt32(cstate, (int32)state->cols[c].typid);
+        CopySendInt16(cstate, state->cols[c].typlen);
+    }
+    CopySendEndOfRow<false>(cstate);
+}
+
+/*
+ * @Description: append one row to the chunk being built, sending the chunk
+ *    once it is full. Called in the per-row memory context.
+ * @IN cstate: the current CopyState
+ * @IN values/nulls: the row
+ * @Return: void
+ */
+static void CopyColumnarAppendRow(CopyState cstate, Datum* values, const bool* nulls)
+{
+    CopyColumnarState* state = cstate->columnar_state;
+    int row = state->nrows;
+    ListCell* cur = NULL;
+    int c = 0;
+
+    foreach (cur, cstate->attnumlist) {
+        int attnum = lfirst_int(cur);
+        CopyColumnarColumn* col = &state->cols[c++];
+        Datum value = values[attnum - 1];
+        int oldlen = col->data.len;
+
+        if (nulls[attnum - 1]) {
+            col->nulls[row >> 3] |= (bits8)(1 << (row & 7));
+            continue;
+        }
+
+        switch (col->typlen) {
+            case sizeof(int16): {
+                int16 val = DatumGetInt16(value);
+                appendBinaryStringInfo(&col->data, (char*)&val, sizeof(int16));
+                break;
+            }
+            case sizeof(int32): {
+                int32 val = DatumGetInt32(value);
+                appendBinaryStringInfo(&col->data, (char*)&val, sizeof(int32));
+                break;
+            }
+            case sizeof(int64): {
+                int64 val = DatumGetInt64(value);
+                appendBinaryStringInfo(&col->data, (char*)&val, sizeof(int64));
+                break;
+            }
+            default: {
+                bytea* outputbytes = SendFunctionCall(&cstate->out_functions[attnum - 1], value);
+                int32 len = VARSIZE(outputbytes) - VARHDRSZ;
+
+                appendBinaryStringInfo(&col->data, (char*)&len, sizeof(int32));
+                appendBinaryStringInfo(&col->data, VARDATA(outputbytes), len);
+                break;
+            }
+        }
+        state->chunk_bytes += col->data.len - oldlen;
+    }
+
+    state->nrows++;
+    if (state->nrows >= COLUMNAR_CHUNK_ROWS || state->chunk_bytes >= COLUMNAR_CHUNK_BYTES)
+        CopyColumnarFlushChunk(cstate);
+}
+
+/*
+ * @Description: send the pending chunk. Each column goes out as its null
+ *    bitmap followed by its values, compressed by IntegerCoder or StringCoder
+ *    when that makes them smaller and stored raw (modes 0) otherwise.
+ * @IN cstate: the current CopyState
+ * @Return: void
+ */
+static void CopyColumnarFlushChunk(CopyState cstate)
+{
+    CopyColumnarState* state = cstate->columnar_state;
+    int8 compression = heaprel_get_compression_from_modes(state->compress_modes);
+    int bitmaplen = BITMAPLEN(state->nrows);
+    MemoryContext oldcontext;
+
+    if (state->nrows == 0)
+        return;
+
+    oldcontext = MemoryContextSwitchTo(state->chunkcxt);
+
+    CopySendInt32(cstate, state->nrows);
+    for (int c = 0; c < state->natts; c++) {
+        CopyColumnarColumn* col = &state->cols[c];
+        int16 modes = 0;
+        char* stored = col->data.data;
+        int storedsize = col->data.len;
+
+        if (col->data.len > 0 && compression != COMPRESS_NO) {
+            CompressionArg1 in = {0};
+            CompressionArg2 out = {0};
+            int outsize;
+
+            in.buf = col->data.data;
+            in.sz = col->data.len;
+            in.mode = state->compress_modes;
+            out.sz = col->data.len + BLCKSZ;
+            out.buf = (char*)palloc(out.sz);
+
+            if (col->typlen > 0) {
+                IntegerCoder intCoder(col->typlen);
+                outsize = intCoder.Compress(in, out);
+            } else {
+                StringCoder strCoder;
+                strCoder.m_adopt_dict = false;
+                in.useDict = false;
+                in.useGlobalDict = false;
+                in.buildGlobalDict = false;
+                in.globalDict = NULL;
+                outsize = strCoder.Compress(in, out);
+            }
+
+            if (outsize > 0 && outsize < col->data.len) {
+                modes = (int16)out.modes;
+                stored = out.buf;
+                storedsize = outsize;
+            }
+        }
+
+        CopySendData(cstate, col->nulls, bitmaplen);
+        CopySendInt16(cstate, modes);
+        CopySendInt32(cstate, col->data.len);
+        CopySendInt32(cstate, storedsize);
+        CopySendData(cstate, stored, storedsize);
+
+        resetStringInfo(&col->data);
+        errno_t rc = memset_s(col->nulls, bitmaplen, 0, bitmaplen);
+        securec_check(rc, "\0", "\0");
+    }
+    CopySendEndOfRow<false>(cstate);
+
+    (void)MemoryContextSwitchTo(oldcontext);
+    MemoryContextReset(state->chunkcxt);
+    state->nrows = 0;
+    state->chunk_bytes = 0;
+}
+
+/*
+ * @Description: read and verify the COLUMNAR file header. Integer columns
+ *    are loaded from their native form and must match the target type exactly.
+ * @IN cstate: the current CopyState
+ * @IN tupDesc: descriptor of the target relation
+ * @Return: void
+ */
+static void CopyColumnarReadHeader(CopyState cstate, TupleDesc tupDesc)
+{
+    CopyColumnarState* state = CopyColumnarInitState(cstate, tupDesc);
+    Form_pg_attribute* attr = tupDesc->attrs;
+    char readSig[11];
+    int32 tmp;
+    int16 natts;
+    ListCell* cur = NULL;
+    int c = 0;
+
+    if (CopyGetData(cstate, readSig, 11, 11) != 11 || memcmp(readSig, ColumnarSignature, 11) != 0)
+        ereport(ERROR, (errcode(ERRCODE_BAD_COPY_FILE_FORMAT), errmsg("COPY file signature not recognized")));
+    if (!CopyGetInt32(cstate, &tmp))
+        ereport(ERROR, (errcode(ERRCODE_BAD_COPY_FILE_FORMAT), errmsg("invalid COPY file header (missing flags)")));
+    if ((tmp >> 16) != 0)
+        ereport(
+            ERROR, (errcode(ERRCODE_BAD_COPY_FILE_FORMAT), errmsg("unrecognized critical flags in COPY file header")));
+    if (!CopyGetInt32(cstate, &tmp) || tmp < 0)
+        ereport(ERROR, (errcode(ERRCODE_BAD_COPY_FILE_FORMAT), errmsg("invalid COPY file header (missing length)")));
+    while (tmp-- > 0) {
+        if (CopyGetData(cstate, readSig, 1, 1) != 1)
+            ereport(
+                ERROR, (errcode(ERRCODE_BAD_COPY_FILE_FORMAT), errmsg("invalid COPY file header (wrong length)")));
+    }
+
+    if (!CopyGetInt16(cstate, &natts))
+        ereport(ERROR, (errcode(ERRCODE_BAD_COPY_FILE_FORMAT), errmsg("invalid COPY file header (missing columns)")));
+    if (natts != state->natts)
+        ereport(ERROR,
+            (errcode(ERRCODE_BAD_COPY_FILE_FORMAT),
+                errmsg("COPY file has %d columns, expected %d", (int)natts, state->natts)));
+    if (CopyGetData(cstate, &tmp, sizeof(int32), sizeof(int32)) != sizeof(int32) || tmp != COLUMNAR_BYTE_ORDER_MARK)
+        ereport(ERROR,
+            (errcode(ERRCODE_BAD_COPY_FILE_FORMAT), errmsg("COPY file byte order does not match the server")));
+
+    foreach (cur, cstate->attnumlist) {
+        int attnum = lfirst_int(cur);
+        CopyColumnarColumn* col = &state->cols[c++];
+        int32 typid;
+        int16 typlen;
+
+        if (!CopyGetInt32(cstate, &typid) || !CopyGetInt16(cstate, &typlen) ||
+            typlen != CopyColumnarIntLen((Oid)typid))
+            ereport(
+                ERROR, (errcode(ERRCODE_BAD_COPY_FILE_FORMAT), errmsg("invalid COPY file header (column types)")));
+        if (typlen > 0 && (Oid)typid != attr[attnum - 1]->atttypid)
+            ereport(ERROR,
+                (errcode(ERRCODE_BAD_COPY_FILE_FORMAT),
+                    errmsg("column \"%s\" is %s in COPY file, expected %s",
+                        NameStr(attr[attnum - 1]->attname),
+                        format_type_be((Oid)typid),
+                        format_type_be(attr[attnum - 1]->atttypid))));
+        col->typid = (Oid)typid;
+        col->typlen = typlen;
+    }
+
+    cstate->columnar_state = state;
+}
+
+/*
+ * @Description: read and decompress the next chunk.
+ * @IN cstate: the current CopyState
+ * @Return: false at the end of the data
+ */
+static bool CopyColumnarReadChunk(CopyState cstate)
+{
+    CopyColumnarState* state = cstate->columnar_state;
+    MemoryContext oldcontext;
+    int32 nrows;
+    int bitmaplen;
+
+    MemoryContextReset(state->chunkcxt);
+    state->nrows = state->cur_row = 0;
+
+    if (!CopyGetInt32(cstate, &nrows))
+        return false;
+
+    if (nrows == 0) {
+        /* Trailer, see the EOF marker handling of the binary format */
+        char dummy;
+
+        if (cstate->copy_dest != COPY_OLD_FE && CopyGetData(cstate, &dummy, 1, 1) > 0)
+            ereport(ERROR, (errcode(ERRCODE_BAD_COPY_FILE_FORMAT), errmsg("received copy data after EOF marker")));
+        return false;
+    }
+    if (nrows < 0 || nrows > COLUMNAR_CHUNK_ROWS)
+        ereport(ERROR, (errcode(ERRCODE_BAD_COPY_FILE_FORMAT), errmsg("invalid chunk row count %d", nrows)));
+
+    oldcontext = MemoryContextSwitchTo(state->chunkcxt);
+    bitmaplen = BITMAPLEN(nrows);
+
+    for (int c = 0; c < state->natts; c++) {
+        CopyColumnarColumn* col = &state->cols[c];
+        int16 modes;
+        int32 rawsize;
+        int32 storedsize;
+        char* stored = NULL;
+
+        col->nulls = (bits8*)palloc(bitmaplen);
+        if (CopyGetData(cstate, col->nulls, bitmaplen, bitmaplen) != bitmaplen || !CopyGetInt16(cstate, &modes) ||
+            !CopyGetInt32(cstate, &rawsize) || !CopyGetInt32(cstate, &storedsize))
+            ereport(ERROR, (errcode(ERRCODE_BAD_COPY_FILE_FORMAT), errmsg("unexpected EOF in COPY data")));
+        if (rawsize < 0 || storedsize < 0 || (modes == 0 && rawsize != storedsize))
+            ereport(ERROR, (errcode(ERRCODE_BAD_COPY_FILE_FORMAT), errmsg("invalid column chunk size")));
+
+        stored = (char*)palloc(storedsize + 1);
+        if (CopyGetData(cstate, stored, storedsize, storedsize) != storedsize)
+            ereport(ERROR, (errcode(ERRCODE_BAD_COPY_FILE_FORMAT), errmsg("unexpected EOF in COPY data")));
+
+        if (modes == 0) {
+            col->vals = stored;
+        } else {
+            CompressionArg2 in = {0};
+            CompressionArg1 out = {0};
+            int err_code;
+
+            in.buf = stored;
+            in.sz = storedsize;
+            in.modes = (uint16)modes;
+            out.buf = (char*)palloc(rawsize + 1);
+            out.sz = rawsize;
+
+            if (col->typlen > 0) {
+                IntegerCoder intDecoder(col->typlen);
+                err_code = intDecoder.Decompress(in, out);
+            } else {
+                StringCoder strDecoder;
+                err_code = strDecoder.Decompress(in, out);
+            }
+
+            if (err_code == -2)
+                ereport(ERROR,
+                    (errcode(ERRCODE_OUT_OF_MEMORY), errmsg("memory is not enough during decompressing COPY data")));
+            if (err_code != rawsize)
+                ereport(ERROR, (errcode(ERRCODE_BAD_COPY_FILE_FORMAT), errmsg("could not decompress COPY data")));
+            col->vals = out.buf;
+        }
+        col->vals_len = rawsize;
+        col->pos = 0;
+    }
+
+    (void)MemoryContextSwitchTo(oldcontext);
+    state->nrows = nrows;
+    return true;
+}
+
+/*
+ * @Description: form the next row of a COLUMNAR copy, reading a new chunk
+ *    when the current one is used up.
+ * @IN cstate: the current CopyState
+ * @OUT values/nulls: the row, indexed by physical attribute
+ * @Return: false at the end of the data
+ */
+static bool CopyColumnarNextRow(CopyState cstate, Datum* values, bool* nulls)
+{
+    CopyColumnarState* state = cstate->columnar_state;
+    Form_pg_attribute* attr = RelationGetDescr(cstate->rel)->attrs;
+    FmgrInfo* in_functions = cstate->in_functions;
+    Oid* typioparams = cstate->typioparams;
+    ListCell* cur = NULL;
+    int row;
+    int c = 0;
+
+    while (state->cur_row >= state->nrows) {
+        if (!CopyColumnarReadChunk(cstate))
+            return false;
+    }
+    row = state->cur_row++;
+
+    foreach (cur, cstate->attnumlist) {
+        int attnum = lfirst_int(cur);
+        int m = attnum - 1;
+        int32 typmod = attr[m]->atttypmod;
+        CopyColumnarColumn* col = &state->cols[c++];
+
+        cstate->cur_attname = NameStr(attr[m]->attname);
+
+        if (col->nulls[row >> 3] & (1 << (row & 7))) {
+            values[m] = ReceiveFunctionCall(&in_functions[m], NULL, typioparams[m], typmod);
+            nulls[m] = true;
+            cstate->cur_attname = NULL;
+            continue;
+        }
+
+        if (col->typlen > 0) {
+            char* ptr = col->vals + col->pos;
+            int64 val;
+
+            if (col->pos + col->typlen > col->vals_len)
+                ereport(ERROR, (errcode(ERRCODE_BAD_COPY_FILE_FORMAT), errmsg("unexpected end of column data")));
+            col->pos += col->typlen;
+
+            switch (col->typlen) {
+                case sizeof(int16): {
+                    int16 tmp;
+                    errno_t rc = memcpy_s(&tmp, sizeof(int16), ptr, sizeof(int16));
+                    securec_check(rc, "\0", "\0");
+                    val = tmp;
+                    break;
+                }
+                case sizeof(int32): {
+                    int32 tmp;
+                    errno_t rc = memcpy_s(&tmp, sizeof(int32), ptr, sizeof(int32));
+                    securec_check(rc, "\0", "\0");
+                    val = tmp;
+                    break;
+                }
+                default: {
+                    errno_t rc = memcpy_s(&val, sizeof(int64), ptr, sizeof(int64));
+                    securec_check(rc, "\0", "\0");
+                    break;
+                }
+            }
+
+            if (typmod < 0) {
+                /* No typmod to apply, the native value is the datum */
+                if (col->typlen == sizeof(int16))
+                    values[m] = Int16GetDatum((int16)val);
+                else if (col->typid == OIDOID)
+                    values[m] = ObjectIdGetDatum((Oid)val);
+                else if (col->typlen == sizeof(int32))
+                    values[m] = Int32GetDatum((int32)val);
+                else
+                    values[m] = Int64GetDatum(val);
+            } else {
+                resetStringInfo(&cstate->attribute_buf);
+                if (col->typlen == sizeof(int64))
+                    pq_sendint64(&cstate->attribute_buf, val);
+                else
+                    pq_sendint(&cstate->attribute_buf, (int)val, col->typlen);
+                values[m] = ReceiveFunctionCall(&in_functions[m], &cstate->attribute_buf, typioparams[m], typmod);
+            }
+        } else {
+            int32 len;
+
+            if (col->pos + (int)sizeof(int32) > col->vals_len)
+                ereport(ERROR, (errcode(ERRCODE_BAD_COPY_FILE_FORMAT), errmsg("unexpected end of column data")));
+            errno_t rc = memcpy_s(&len, sizeof(int32), col->vals + col->pos, sizeof(int32));
+            securec_check(rc, "\0", "\0");
+            col->pos += sizeof(int32);
+            if (len < 0 || len > col->vals_len - col->pos)
+                ereport(ERROR, (errcode(ERRCODE_BAD_COPY_FILE_FORMAT), errmsg("invalid field size")));
+
+            resetStringInfo(&cstate->attribute_buf);
+            appendBinaryStringInfo(&cstate->attribute_buf, col->vals + col->pos, len);
+            col->pos += len;
+
+            /* Call the column type's binary input converter */
+            values[m] = ReceiveFunctionCall(&in_functions[m], &cstate->attribute_buf, typioparams[m], typmod);
+            if (cstate->attribute_buf.cursor != cstate->attribute_buf.len)
+                ereport(ERROR, (errcode(ERRCODE_INVALID_BINARY_REPRESENTATION), errmsg("incorrect binary data format")));
+        }
+        nulls[m] = false;
+        cstate->cur_attname = NULL;
+    }
+
+    return true;
+}
+
 /*
  * Send text representation of one attribute, with conversion and escaping
  */
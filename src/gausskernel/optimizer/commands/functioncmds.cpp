@@ -76,6 +76,9 @@
 #include "pgxc/execRemote.h"
 #include "storage/lmgr.h"
 #include "tcop/utility.h"
+#ifdef ENABLE_MOT
+#include "storage/mot/jit_exec.h"
+#endif
 
 typedef struct PendingLibraryDelete {
     char* filename; /* library file name. */
@@ -1236,6 +1239,11 @@ void RemoveFunctionById(Oid funcOid)
     if (funcOid != InvalidOid) {
         DeletePgObject(funcOid, OBJECT_TYPE_PROC);
     }
+
+#ifdef ENABLE_MOT
+    /* forget the JIT statistics of the statements the function ran against memory tables */
+    JitExec::JitReportFunctionDropped(funcOid);
+#endif
 }
 
 /*
@@ -23,6 +23,7 @@
 #include "catalog/catalog.h"
 #include "catalog/index.h"
 #include "catalog/indexing.h"
+#include "catalog/pg_am.h"
 #include "catalog/pg_constraint.h"
 #include "catalog/pg_opclass.h"
 #include "catalog/pg_opfamily.h"
@@ -720,12 +721,18 @@ Oid DefineIndex(Oid relationId, IndexStmt* stmt, Oid indexRelationId, bool is_al
     }
     accessMethodId = HeapTupleGetOid(tuple);
     accessMethodForm = (Form_pg_am)GETSTRUCT(tuple);
-    if (stmt->unique && !accessMethodForm->amcanunique)
+#ifdef ENABLE_MOT
+    /* MOT implements hash indexes by itself, unique and multicolumn ones included */
+    bool isMOTHashIndex = (accessMethodId == HASH_AM_OID && isMOTFromTblOid(RelationGetRelid(rel)));
+#else
+    bool isMOTHashIndex = false;
+#endif
+    if (stmt->unique && !accessMethodForm->amcanunique && !isMOTHashIndex)
         ereport(ERROR,
             (errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
                 errmsg("access method \"%s\" does not support unique indexes", accessMethodName)));
 
-    if (numberOfAttributes > 1 && !accessMethodForm->amcanmulticol)
+    if (numberOfAttributes > 1 && !accessMethodForm->amcanmulticol && !isMOTHashIndex)
         ereport(ERROR,
             (errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
                 errmsg("access method \"%s\" does not support multicolumn indexes", accessMethodName)));
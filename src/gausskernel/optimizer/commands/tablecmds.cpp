@@ -15444,6 +15444,22 @@ static void ATExecGenericOptions(Relation rel, List* options)
     if (options == NIL)
         return;
 
+#ifdef ENABLE_MOT
+    /* rows of a memory table are already placed, so their NUMA placement is fixed at creation */
+    if (isMOTFromTblOid(RelationGetRelid(rel))) {
+        ListCell* cell = NULL;
+        foreach (cell, options) {
+            DefElem* def = (DefElem*)lfirst(cell);
+            if (pg_strcasecmp(def->defname, "numa_node") == 0) {
+                ereport(ERROR,
+                    (errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+                        errmsg("option \"numa_node\" of memory table \"%s\" cannot be changed",
+                            RelationGetRelationName(rel))));
+            }
+        }
+    }
+#endif
+
     ftrel = heap_open(ForeignTableRelationId, RowExclusiveLock);
 
     tuple = SearchSysCacheCopy1(FOREIGNTABLEREL, rel->rd_id);
@@ -123,6 +123,7 @@ static THR_LOCAL int elevel = -1;
 
 static void vac_truncate_clog(TransactionId frozenXID);
 static bool vacuum_rel(Oid relid, VacuumStmt* vacstmt, bool do_toast);
+static int vacuum_parallel_delay(void);
 static void GPIVacuumMainPartition(
     Relation onerel, const VacuumStmt* vacstmt, LOCKMODE lockmode, BufferAccessStrategy bstrategy);
 
@@ -2412,19 +2413,25 @@ void vac_close_indexes(int nindexes, Relation* Irel, LOCKMODE lockmode)
  */
 void vacuum_delay_point(void)
 {
+    int msec = 0;
+
     /* Always check for interrupts */
     CHECK_FOR_INTERRUPTS();
 
-    /* Nap if appropriate */
-    if (t_thrd.vacuum_cxt.VacuumCostActive && !InterruptPending &&
-        t_thrd.vacuum_cxt.VacuumCostBalance >= u_sess->attr.attr_storage.VacuumCostLimit) {
-        int msec;
+    if (!t_thrd.vacuum_cxt.VacuumCostActive || InterruptPending)
+        return;
 
+    /* Nap if appropriate */
+    if (t_thrd.vacuum_cxt.VacuumSharedCost != NULL) {
+        msec = vacuum_parallel_delay();
+    } else if (t_thrd.vacuum_cxt.VacuumCostBalance >= u_sess->attr.attr_storage.VacuumCostLimit) {
         msec = u_sess->attr.attr_storage.VacuumCostDelay * t_thrd.vacuum_cxt.VacuumCostBalance /
                u_sess->attr.attr_storage.VacuumCostLimit;
         if (msec > u_sess->attr.attr_storage.VacuumCostDelay * 4)
             msec = u_sess->attr.attr_storage.VacuumCostDelay * 4;
+    }
 
+    if (msec > 0) {
         pg_usleep(msec * 1000L);
 
         t_thrd.vacuum_cxt.VacuumCostBalance = 0;
@@ -2432,11 +2439,51 @@ void vacuum_delay_point(void)
         /* update balance values for workers */
         AutoVacuumUpdateDelay();
 
+        /* an autovacuum leader passes its new share on to its index workers */
+        if (t_thrd.vacuum_cxt.VacuumSharedCost != NULL && t_thrd.autovacuum_cxt.MyWorkerInfo != NULL) {
+            t_thrd.vacuum_cxt.VacuumSharedCost->costLimit = u_sess->attr.attr_storage.VacuumCostLimit;
+            t_thrd.vacuum_cxt.VacuumSharedCost->costDelay = u_sess->attr.attr_storage.VacuumCostDelay;
+        }
+
         /* Might have gotten an interrupt while sleeping */
         CHECK_FOR_INTERRUPTS();
     }
 }
 
+/*
+ * vacuum_parallel_delay --- cost-based delay while indexes are vacuumed
+ * in parallel.
+ *
+ * Moves our balance into the shared one.  Once that reaches the limit, a
+ * participant that spent at least half of its fair share naps for what it
+ * spent itself; that keeps the heavy users of I/O napping and the light
+ * ones going, while the total stays within one vacuum's limit.
+ */
+static int vacuum_parallel_delay(void)
+{
+    VacuumSharedCostData* shared = t_thrd.vacuum_cxt.VacuumSharedCost;
+    int costLimit = Max(shared->costLimit, 1);
+    int costDelay = shared->costDelay;
+    uint32 nactive = Max(pg_atomic_read_u32(&shared->nactive), 1);
+    uint32 balance;
+    int msec = 0;
+
+    balance = pg_atomic_add_fetch_u32(&shared->balance, (uint32)t_thrd.vacuum_cxt.VacuumCostBalance);
+    t_thrd.vacuum_cxt.VacuumCostBalanceLocal += t_thrd.vacuum_cxt.VacuumCostBalance;
+    t_thrd.vacuum_cxt.VacuumCostBalance = 0;
+
+    if (balance >= (uint32)costLimit &&
+        t_thrd.vacuum_cxt.VacuumCostBalanceLocal > 0.5 * ((double)costLimit / nactive)) {
+        msec = costDelay * t_thrd.vacuum_cxt.VacuumCostBalanceLocal / costLimit;
+        if (msec > costDelay * 4)
+            msec = costDelay * 4;
+        (void)pg_atomic_sub_fetch_u32(&shared->balance, t_thrd.vacuum_cxt.VacuumCostBalanceLocal);
+        t_thrd.vacuum_cxt.VacuumCostBalanceLocal = 0;
+    }
+
+    return msec;
+}
+
 void vac_update_partstats(Partition part, BlockNumber num_pages, double num_tuples, BlockNumber num_all_visible_pages,
     TransactionId frozenxid)
 {
@@ -4,24 +4,28 @@
  *	  Concurrent ("lazy") vacuuming.
  *
  *
- * The major space usage for LAZY VACUUM is storage for the array of dead
- * tuple TIDs, with the next biggest need being storage for per-disk-page
- * free space info.  We want to ensure we can vacuum even the very largest
- * relations with finite memory space usage.  To do that, we set upper bounds
- * on the number of tuples and pages we will keep track of at once.
+ * The major space usage for LAZY VACUUM is storage for the dead tuple TIDs,
+ * with the next biggest need being storage for per-disk-page free space
+ * info.  We want to ensure we can vacuum even the very largest relations
+ * with finite memory space usage.  To do that, we set upper bounds on the
+ * number of tuples and pages we will keep track of at once.
  *
  * We are willing to use at most maintenance_work_mem memory space to keep
- * track of dead tuples.  We initially allocate an array of TIDs of that size,
- * with an upper limit that depends on table size (this limit ensures we don't
- * allocate a huge area uselessly for vacuuming small tables).	If the array
- * threatens to overflow, we suspend the heap scan phase and perform a pass of
- * index cleanup and page compaction, then resume the heap scan with an empty
- * TID array.
+ * track of dead tuples.  They are kept in a TidStore (see tidstore.cpp),
+ * which holds a bitmap of the dead offsets of each page and only takes
+ * memory as it fills up.  If the store threatens to overflow, we suspend the
+ * heap scan phase and perform a pass of index cleanup and page compaction,
+ * then resume the heap scan with an empty store.
  *
  * If we're processing a table with no indexes, we can just vacuum each page
  * as we go; there's no need to save up multiple tuples to minimize the number
- * of index scans performed.  So we don't use maintenance_work_mem memory for
- * the TID array, just enough to hold as many heap tuples as fit on one page.
+ * of index scans performed.  So we don't use a TidStore at all, just the
+ * dead tuples of the page at hand.
+ *
+ * A table with several large indexes can have them vacuumed by worker
+ * threads (see parallelbuild.cpp) alongside the leader.  Each index pass
+ * hands the indexes out one at a time; the workers only read the TidStore,
+ * which does not change until the pass is over.
  *
  *
  * Portions Copyright (c) 2020 Huawei Technologies Co.,Ltd.
@@ -43,12 +47,15 @@
 #include "access/cstore_insert.h"
 #include "access/genam.h"
 #include "access/heapam.h"
+#include "access/parallelbuild.h"
 #include "access/tableam.h"
+#include "access/tidstore.h"
 #include "access/transam.h"
 #include "access/visibilitymap.h"
 #include "access/xlog.h"
 #include "catalog/catalog.h"
 #include "catalog/storage.h"
+#include "catalog/pg_am.h"
 #include "catalog/pg_hashbucket_fn.h"
 #include "commands/dbcommands.h"
 #include "commands/vacuum.h"
@@ -74,13 +81,6 @@
 #include "pgxc/pgxc.h"
 #endif
 
-/*
- * Guesstimation of number of dead tuples per page.  This is used to
- * provide an upper limit to memory allocated when vacuuming small
- * tables.
- */
-#define LAZY_ALLOC_TUPLES MaxHeapTuplesPerPage
-
 /*
  * Before we consider skipping a page that's marked as clean in
  * visibility map, we must've seen at least this many clean pages.
@@ -88,6 +88,13 @@
 #define SKIP_PAGES_THRESHOLD ((BlockNumber)32)
 
 #define CHANGE_XID_BASE (MaxShortTransactionId * 0.1)
+
+/*
+ * Indexes smaller than this are not worth a worker; the leader vacuums
+ * them itself.
+ */
+#define PARALLEL_VACUUM_MIN_INDEX_BLOCKS ((BlockNumber)64)
+
 typedef struct LVRelStats {
     /* hasindex = true means two-pass strategy; false means one-pass */
     bool hasindex;
@@ -101,11 +108,12 @@ typedef struct LVRelStats {
     BlockNumber pages_removed;
     double tuples_deleted;
     BlockNumber nonempty_pages; /* actually, last nonempty page + 1 */
-    /* List of TIDs of tuples we intend to delete */
-    /* NB: this list is ordered by TID address */
-    int num_dead_tuples;     /* current # of entries */
-    int max_dead_tuples;     /* # slots allocated in array */
-    ItemPointer dead_tuples; /* array of ItemPointerData */
+    /* TIDs of tuples we intend to delete, NULL if there are no indexes */
+    TidStore* dead_tuples;
+    int num_dead_tuples;     /* current # of TIDs in dead_tuples */
+    /* dead tuples of the page being scanned, not in dead_tuples yet */
+    int num_page_dead;
+    OffsetNumber page_dead[MaxHeapTuplesPerPage];
     int num_index_scans;
     TransactionId latestRemovedXid;
     bool lock_waiter_detected;
@@ -115,6 +123,35 @@ typedef struct LVRelStats {
     Oid currVacuumPartOid;    /* current lazy vacuum partition oid */
 } LVRelStats;
 
+/* An index vacuumed by whichever participant of a parallel index pass gets to it first */
+typedef struct LVParallelIndex {
+    int irelIndex;                /* position in the leader's Irel array */
+    Oid indexOid;
+    Oid parentOid;                /* parent index of an index partition */
+    BlockNumber nblocks;
+    IndexBulkDeleteResult* stats; /* allocated by the leader, filled in by whoever vacuums the index */
+    bool hasStats;                /* stats is valid; the serial code would have NULL */
+} LVParallelIndex;
+
+/* State shared by the leader and workers of a parallel index pass, amstate of the IndexBuildParallel */
+typedef struct LVParallelState {
+    LVRelStats* vacrelstats; /* read-only while a pass runs */
+    int nworkers;
+    bool cleanup;            /* amvacuumcleanup rather than ambulkdelete pass */
+    int nindexes;
+    LVParallelIndex* indexes; /* largest first */
+    int nextIndex;           /* next index to hand out, under the IndexBuildParallel mutex */
+
+    /* the leader's cost-based delay settings */
+    bool costActive;
+    int costPageHit;
+    int costPageMiss;
+    int costPageDirty;
+    VacuumSharedCostData cost;
+
+    bool* inParallel;        /* by Irel position, index is in indexes[] */
+} LVParallelState;
+
 typedef struct ValPrefetchList {
     uint32 block_guard; /* record last block id need to prefetch */
     uint32 count;       /* prefetch count */
@@ -145,11 +182,25 @@ static bool lazy_check_needs_freeze(Buffer buf);
 static void lazy_vacuum_index(Relation indrel, IndexBulkDeleteResult** stats, LVRelStats* vacrelstats);
 static IndexBulkDeleteResult* lazy_cleanup_index(
     Relation indrel, IndexBulkDeleteResult* stats, LVRelStats* vacrelstats);
-static int lazy_vacuum_page(Relation onerel, BlockNumber blkno, Buffer buffer, int tupindex, LVRelStats* vacrelstats);
-static void lazy_space_alloc(LVRelStats* vacrelstats, BlockNumber relblocks);
+static void lazy_vacuum_all_indexes(Relation onerel, LVRelStats* vacrelstats, Relation* Irel, int nindexes,
+    IndexBulkDeleteResult** indstats, LVParallelState* pstate);
+static void lazy_cleanup_all_indexes(Relation onerel, LVRelStats* vacrelstats, Relation* Irel, int nindexes,
+    IndexBulkDeleteResult** indstats, LVParallelState* pstate);
+static LVParallelState* lazy_parallel_begin(Relation onerel, LVRelStats* vacrelstats, Relation* Irel, int nindexes);
+static bool lazy_parallel_index_safe(Relation indrel);
+static int lazy_parallel_cmp_index(const void* left, const void* right);
+static void lazy_parallel_vacuum_indexes(Relation onerel, LVParallelState* pstate, Relation* Irel, int nindexes,
+    IndexBulkDeleteResult** indstats, bool cleanup);
+static LVParallelIndex* lazy_parallel_next_index(IndexBuildParallel* pbuild, LVParallelState* pstate);
+static void lazy_parallel_vacuum_one(LVParallelState* pstate, LVParallelIndex* pindex, Relation indrel);
+static double lazy_parallel_worker(
+    IndexBuildParallel* pbuild, int workerId, Relation heap, Relation index, IndexInfo* indexInfo);
+static void lazy_parallel_end(LVParallelState* pstate, IndexBulkDeleteResult** indstats);
+static void lazy_vacuum_page(Relation onerel, BlockNumber blkno, Buffer buffer, const OffsetNumber* deadoffsets,
+    int ndead, LVRelStats* vacrelstats);
+static void lazy_space_alloc(LVRelStats* vacrelstats);
 static void lazy_record_dead_tuple(LVRelStats* vacrelstats, ItemPointer itemptr);
 static bool lazy_tid_reaped(ItemPointer itemptr, void* state, Oid partOid = InvalidOid);
-static int vac_cmp_itemptr(const void* left, const void* right);
 
 /*
  *	lazy_vacuum_rel() -- perform LAZY VACUUM for one heap relation
@@ -772,7 +823,6 @@ static void lazy_scan_bucket(Relation onerel, LVRelStats* vacrelstats, VacuumStm
             vacrelstats->lock_waiter_detected = true;
         }
         *deleteTupleNum += deleteTupletemp;
-		pfree_ext(vacbucketstats->dead_tuples);
     }
 
     pfree_ext(ibuckRel);
@@ -805,7 +855,7 @@ static IndexBulkDeleteResult** lazy_scan_heap(
     BlockNumber empty_pages, vacuumed_pages;
     double num_tuples, tups_vacuumed, nkeep, nunused;
     IndexBulkDeleteResult** indstats;
-    int i;
+    LVParallelState* pstate = NULL;
     PGRUsage ru0;
     Buffer vmbuffer = InvalidBuffer;
     BlockNumber next_not_all_visible_block;
@@ -830,7 +880,10 @@ static IndexBulkDeleteResult** lazy_scan_heap(
     vacrelstats->nonempty_pages = 0;
     vacrelstats->latestRemovedXid = InvalidTransactionId;
 
-    lazy_space_alloc(vacrelstats, nblocks);
+    lazy_space_alloc(vacrelstats);
+
+    if (vacrelstats->hasindex)
+        pstate = lazy_parallel_begin(onerel, vacrelstats, Irel, nindexes);
 
     /*
      * We want to skip pages that don't require vacuuming according to the
@@ -898,7 +951,6 @@ static IndexBulkDeleteResult** lazy_scan_heap(
         OffsetNumber offnum, maxoff;
         bool tupgone = false;
         bool hastup = false;
-        int prev_dead_count;
         OffsetNumber frozen[MaxOffsetNumber];
         int nfrozen;
         Size freespace;
@@ -948,7 +1000,7 @@ static IndexBulkDeleteResult** lazy_scan_heap(
          * If we are close to overrunning the available space for dead-tuple
          * TIDs, pause and do a cycle of vacuuming before we tackle this page.
          */
-        if ((vacrelstats->max_dead_tuples - vacrelstats->num_dead_tuples) < MaxHeapTuplesPerPage &&
+        if (vacrelstats->dead_tuples != NULL && TidStoreIsFull(vacrelstats->dead_tuples) &&
             vacrelstats->num_dead_tuples > 0) {
             /*
              * Before beginning index vacuuming, we release any pin we may
@@ -965,8 +1017,7 @@ static IndexBulkDeleteResult** lazy_scan_heap(
             vacuum_log_cleanup_info(onerel, vacrelstats);
 
             /* Remove index entries */
-            for (i = 0; i < nindexes; i++)
-                lazy_vacuum_index(Irel[i], &indstats[i], vacrelstats);
+            lazy_vacuum_all_indexes(onerel, vacrelstats, Irel, nindexes, indstats, pstate);
             /* Remove tuples from heap */
             lazy_vacuum_heap(onerel, vacrelstats);
 
@@ -975,6 +1026,7 @@ static IndexBulkDeleteResult** lazy_scan_heap(
              * not to reset latestRemovedXid since we want that value to be
              * valid.
              */
+            TidStoreReset(vacrelstats->dead_tuples);
             vacrelstats->num_dead_tuples = 0;
             vacrelstats->num_index_scans++;
         }
@@ -1127,7 +1179,7 @@ static IndexBulkDeleteResult** lazy_scan_heap(
         has_dead_tuples = false;
         nfrozen = 0;
         hastup = false;
-        prev_dead_count = vacrelstats->num_dead_tuples;
+        vacrelstats->num_page_dead = 0;
         maxoff = PageGetMaxOffsetNumber(page);
         for (offnum = FirstOffsetNumber; offnum <= maxoff; offnum = OffsetNumberNext(offnum)) {
             ItemId itemid;
@@ -1304,11 +1356,12 @@ static IndexBulkDeleteResult** lazy_scan_heap(
 
         /*
          * If there are no indexes then we can vacuum the page right now
-         * instead of doing a second scan.
+         * instead of doing a second scan.  Otherwise remember its dead
+         * tuples until the indexes have been vacuumed.
          */
-        if (nindexes == 0 && vacrelstats->num_dead_tuples > 0) {
+        if (nindexes == 0 && vacrelstats->num_page_dead > 0) {
             /* Remove tuples from heap */
-            lazy_vacuum_page(onerel, blkno, buf, 0, vacrelstats);
+            lazy_vacuum_page(onerel, blkno, buf, vacrelstats->page_dead, vacrelstats->num_page_dead, vacrelstats);
             has_dead_tuples = false;
 
             /*
@@ -1316,8 +1369,12 @@ static IndexBulkDeleteResult** lazy_scan_heap(
              * not to reset latestRemovedXid since we want that value to be
              * valid.
              */
-            vacrelstats->num_dead_tuples = 0;
+            vacrelstats->num_page_dead = 0;
             vacuumed_pages++;
+        } else if (vacrelstats->num_page_dead > 0) {
+            TidStoreSetBlockOffsets(
+                vacrelstats->dead_tuples, blkno, vacrelstats->page_dead, vacrelstats->num_page_dead);
+            vacrelstats->num_dead_tuples += vacrelstats->num_page_dead;
         }
 
         freespace = PageGetHeapFreeSpace(page);
@@ -1392,7 +1449,7 @@ static IndexBulkDeleteResult** lazy_scan_heap(
          * page, so remember its free space as-is.	(This path will always be
          * taken if there are no indexes.)
          */
-        if (vacrelstats->num_dead_tuples == prev_dead_count)
+        if (vacrelstats->num_page_dead == 0)
             RecordPageWithFreeSpace(onerel, blkno, freespace);
     }
 
@@ -1418,20 +1475,20 @@ static IndexBulkDeleteResult** lazy_scan_heap(
         vacuum_log_cleanup_info(onerel, vacrelstats);
 
         /* Remove index entries */
-        for (i = 0; i < nindexes; i++)
-            lazy_vacuum_index(Irel[i], &indstats[i], vacrelstats);
+        lazy_vacuum_all_indexes(onerel, vacrelstats, Irel, nindexes, indstats, pstate);
         /* Remove tuples from heap */
         lazy_vacuum_heap(onerel, vacrelstats);
         vacrelstats->num_index_scans++;
     }
 
     /* Do post-vacuum cleanup and statistics update for each index */
-    for (i = 0; i < nindexes; i++) {
-        /* IO collector and IO scheduler for vacuum */
-        if (ENABLE_WORKLOAD_CONTROL)
-            IOSchedulerAndUpdate(IO_TYPE_WRITE, 1, IO_TYPE_ROW);
+    lazy_cleanup_all_indexes(onerel, vacrelstats, Irel, nindexes, indstats, pstate);
+    if (pstate != NULL)
+        lazy_parallel_end(pstate, indstats);
 
-        indstats[i] = lazy_cleanup_index(Irel[i], indstats[i], vacrelstats);
+    if (vacrelstats->dead_tuples != NULL) {
+        TidStoreDestroy(vacrelstats->dead_tuples);
+        vacrelstats->dead_tuples = NULL;
     }
 
     /* record vacuumed tuple for reporting to PgStatCollector */
@@ -1477,46 +1534,49 @@ static IndexBulkDeleteResult** lazy_scan_heap(
  */
 static void lazy_vacuum_heap(Relation onerel, LVRelStats* vacrelstats)
 {
-    int tupindex;
+    TidStoreIter* iter = NULL;
+    TidStoreIterResult* deadblock = NULL;
+    int ntuples;
     int npages;
     PGRUsage ru0;
 
     gstrace_entry(GS_TRC_ID_lazy_vacuum_heap);
 
     pg_rusage_init(&ru0);
+    ntuples = 0;
     npages = 0;
 
-    tupindex = 0;
-    while (tupindex < vacrelstats->num_dead_tuples) {
-        BlockNumber tblk;
+    iter = TidStoreBeginIterate(vacrelstats->dead_tuples);
+    while ((deadblock = TidStoreIterateNext(iter)) != NULL) {
         Buffer buf;
         Page page;
         Size freespace;
 
         vacuum_delay_point();
 
-        tblk = ItemPointerGetBlockNumber(&vacrelstats->dead_tuples[tupindex]);
-        buf = ReadBufferExtended(onerel, MAIN_FORKNUM, tblk, RBM_NORMAL, vac_strategy);
+        buf = ReadBufferExtended(onerel, MAIN_FORKNUM, deadblock->blkno, RBM_NORMAL, vac_strategy);
         if (!ConditionalLockBufferForCleanup(buf)) {
+            /* someone else has the page pinned, leave its dead items for the next vacuum */
             ReleaseBuffer(buf);
-            ++tupindex;
             continue;
         }
-        tupindex = lazy_vacuum_page(onerel, tblk, buf, tupindex, vacrelstats);
+        lazy_vacuum_page(onerel, deadblock->blkno, buf, deadblock->offsets, deadblock->noffsets, vacrelstats);
+        ntuples += deadblock->noffsets;
 
         /* Now that we've compacted the page, record its available space */
         page = BufferGetPage(buf);
         freespace = PageGetHeapFreeSpace(page);
 
         UnlockReleaseBuffer(buf);
-        RecordPageWithFreeSpace(onerel, tblk, freespace);
+        RecordPageWithFreeSpace(onerel, deadblock->blkno, freespace);
         npages++;
     }
+    TidStoreEndIterate(iter);
 
     ereport(LOG,
         (errmsg("vacuum %u/%u/%u, \"%s\": removed %d row versions in %d pages",
             onerel->rd_node.spcNode, onerel->rd_node.dbNode, onerel->rd_node.relNode,
-            RelationGetRelationName(onerel), tupindex, npages),
+            RelationGetRelationName(onerel), ntuples, npages),
             errdetail("%s.", pg_rusage_show(&ru0))));
     gstrace_exit(GS_TRC_ID_lazy_vacuum_heap);
 }
@@ -1527,27 +1587,22 @@ static void lazy_vacuum_heap(Relation onerel, LVRelStats* vacrelstats)
  *
  * Caller must hold pin and buffer cleanup lock on the buffer.
  *
- * tupindex is the index in vacrelstats->dead_tuples of the first dead
- * tuple for this page.  We assume the rest follow sequentially.
- * The return value is the first tupindex after the tuples of this page.
+ * deadoffsets are the offsets of the ndead dead tuples of this page.
  */
-static int lazy_vacuum_page(Relation onerel, BlockNumber blkno, Buffer buffer, int tupindex, LVRelStats* vacrelstats)
+static void lazy_vacuum_page(Relation onerel, BlockNumber blkno, Buffer buffer, const OffsetNumber* deadoffsets,
+    int ndead, LVRelStats* vacrelstats)
 {
     Page page = BufferGetPage(buffer);
     OffsetNumber unused[MaxOffsetNumber];
     int uncnt = 0;
+    int i;
 
     START_CRIT_SECTION();
 
-    for (; tupindex < vacrelstats->num_dead_tuples; tupindex++) {
-        BlockNumber tblk;
-        OffsetNumber toff;
+    for (i = 0; i < ndead; i++) {
+        OffsetNumber toff = deadoffsets[i];
         ItemId itemid;
 
-        tblk = ItemPointerGetBlockNumber(&vacrelstats->dead_tuples[tupindex]);
-        if (tblk != blkno)
-            break; /* past end of tuples for this block */
-        toff = ItemPointerGetOffsetNumber(&vacrelstats->dead_tuples[tupindex]);
         itemid = PageGetItemId(page, toff);
         ItemIdSetUnused(itemid);
         unused[uncnt++] = toff;
@@ -1566,8 +1621,6 @@ static int lazy_vacuum_page(Relation onerel, BlockNumber blkno, Buffer buffer, i
     }
 
     END_CRIT_SECTION();
-
-    return tupindex;
 }
 
 /*
@@ -1675,92 +1728,406 @@ static IndexBulkDeleteResult* lazy_cleanup_index(Relation indrel, IndexBulkDelet
 }
 
 /*
- * lazy_space_alloc - space allocation decisions for lazy vacuum
+ *	lazy_vacuum_all_indexes() -- vacuum all indexes of the relation.
+ */
+static void lazy_vacuum_all_indexes(Relation onerel, LVRelStats* vacrelstats, Relation* Irel, int nindexes,
+    IndexBulkDeleteResult** indstats, LVParallelState* pstate)
+{
+    int i;
+
+    if (pstate != NULL) {
+        lazy_parallel_vacuum_indexes(onerel, pstate, Irel, nindexes, indstats, false);
+        return;
+    }
+
+    for (i = 0; i < nindexes; i++)
+        lazy_vacuum_index(Irel[i], &indstats[i], vacrelstats);
+}
+
+/*
+ *	lazy_cleanup_all_indexes() -- do post-vacuum cleanup for all indexes.
+ */
+static void lazy_cleanup_all_indexes(Relation onerel, LVRelStats* vacrelstats, Relation* Irel, int nindexes,
+    IndexBulkDeleteResult** indstats, LVParallelState* pstate)
+{
+    int i;
+
+    if (pstate != NULL) {
+        lazy_parallel_vacuum_indexes(onerel, pstate, Irel, nindexes, indstats, true);
+        return;
+    }
+
+    for (i = 0; i < nindexes; i++) {
+        /* IO collector and IO scheduler for vacuum */
+        if (ENABLE_WORKLOAD_CONTROL)
+            IOSchedulerAndUpdate(IO_TYPE_WRITE, 1, IO_TYPE_ROW);
+
+        indstats[i] = lazy_cleanup_index(Irel[i], indstats[i], vacrelstats);
+    }
+}
+
+/*
+ *	lazy_parallel_begin() -- set up parallel index vacuuming, if worthwhile.
  *
- * See the comments at the head of this file for rationale.
+ *		Returns NULL to vacuum the indexes serially.  The table's
+ *		parallel_workers storage parameter wins over the
+ *		max_parallel_maintenance_workers GUC.  The leader takes part in
+ *		every pass, so a single worker already helps; indexes too small
+ *		to be worth it or that a worker cannot vacuum stay with the leader.
  */
-static void lazy_space_alloc(LVRelStats* vacrelstats, BlockNumber relblocks)
+static LVParallelState* lazy_parallel_begin(Relation onerel, LVRelStats* vacrelstats, Relation* Irel, int nindexes)
 {
-    unsigned long maxtuples;
-
-    if (vacrelstats->hasindex) {
-        maxtuples = (u_sess->attr.attr_memory.maintenance_work_mem * 1024L) / sizeof(ItemPointerData);
-        maxtuples = Min(maxtuples, INT_MAX);
-        maxtuples = Min(maxtuples, (int)(MaxAllocSize / sizeof(ItemPointerData)));
-        /* curious coding here to ensure the multiplication can't overflow */
-        if ((BlockNumber)(maxtuples / LAZY_ALLOC_TUPLES) > relblocks)
-            maxtuples = relblocks * LAZY_ALLOC_TUPLES;
-        /* stay sane if small maintenance_work_mem */
-        maxtuples = Max(maxtuples, MaxHeapTuplesPerPage);
-    } else {
-        maxtuples = MaxHeapTuplesPerPage;
+    LVParallelState* pstate = NULL;
+    int nworkers = RelationGetParallelWorkers(onerel, -1);
+    int nparallel = 0;
+    int i;
+
+    if (nworkers < 0)
+        nworkers = u_sess->attr.attr_storage.max_parallel_maintenance_workers;
+    if (nworkers < 1 || nindexes < 2)
+        return NULL;
+
+    /* the workers reopen the heap, so only what IndexBuildWorkerOpen can find */
+    if (!IsUnderPostmaster || IsSystemRelation(onerel) || RelationUsesLocalBuffers(onerel) ||
+        RELATION_OWN_BUCKET(onerel) || onerel->rd_tam_type != TAM_HEAP)
+        return NULL;
+    if (OidIsValid(onerel->parentId) && get_rel_relkind(onerel->parentId) != RELKIND_RELATION)
+        return NULL;
+
+    pstate = (LVParallelState*)palloc0(sizeof(LVParallelState));
+    pstate->indexes = (LVParallelIndex*)palloc0(nindexes * sizeof(LVParallelIndex));
+    pstate->inParallel = (bool*)palloc0(nindexes * sizeof(bool));
+
+    for (i = 0; i < nindexes; i++) {
+        LVParallelIndex* pindex = &pstate->indexes[nparallel];
+        BlockNumber nblocks;
+
+        if (!lazy_parallel_index_safe(Irel[i]))
+            continue;
+        nblocks = RelationGetNumberOfBlocks(Irel[i]);
+        if (nblocks < PARALLEL_VACUUM_MIN_INDEX_BLOCKS)
+            continue;
+
+        pindex->irelIndex = i;
+        pindex->indexOid = RelationGetRelid(Irel[i]);
+        pindex->parentOid = Irel[i]->parentId;
+        pindex->nblocks = nblocks;
+        pstate->inParallel[i] = true;
+        nparallel++;
+    }
+
+    /* the leader would vacuum a lone large index all by itself anyway */
+    nworkers = Min(nworkers, nparallel - 1);
+    if (nworkers < 1) {
+        pfree(pstate->indexes);
+        pfree(pstate->inParallel);
+        pfree(pstate);
+        return NULL;
+    }
+
+    /* hand out the largest indexes first, so no one is left with a big one at the end */
+    qsort(pstate->indexes, nparallel, sizeof(LVParallelIndex), lazy_parallel_cmp_index);
+    for (i = 0; i < nparallel; i++)
+        pstate->indexes[i].stats = (IndexBulkDeleteResult*)palloc0(sizeof(IndexBulkDeleteResult));
+
+    pstate->vacrelstats = vacrelstats;
+    pstate->nworkers = nworkers;
+    pstate->nindexes = nparallel;
+    pstate->costActive = t_thrd.vacuum_cxt.VacuumCostActive;
+    pstate->costPageHit = u_sess->attr.attr_storage.VacuumCostPageHit;
+    pstate->costPageMiss = u_sess->attr.attr_storage.VacuumCostPageMiss;
+    pstate->costPageDirty = u_sess->attr.attr_storage.VacuumCostPageDirty;
+
+    return pstate;
+}
+
+/*
+ * Whether a worker can vacuum this index.  The leader keeps a copy of the
+ * vacuum results across passes, so the access method must return a plain
+ * IndexBulkDeleteResult.  Global indexes need the partition the leader is
+ * vacuuming, so they stay with the leader too.
+ */
+static bool lazy_parallel_index_safe(Relation indrel)
+{
+    switch (indrel->rd_rel->relam) {
+        case BTREE_AM_OID:
+        case HASH_AM_OID:
+        case GIST_AM_OID:
+        case GIN_AM_OID:
+        case SPGIST_AM_OID:
+            break;
+        default:
+            return false;
+    }
+
+    if (RelationIsGlobalIndex(indrel))
+        return false;
+    if (OidIsValid(indrel->parentId) && get_rel_relkind(indrel->parentId) != RELKIND_INDEX)
+        return false;
+
+    return true;
+}
+
+/*
+ * qsort comparator putting larger indexes first.
+ */
+static int lazy_parallel_cmp_index(const void* left, const void* right)
+{
+    BlockNumber lblocks = ((const LVParallelIndex*)left)->nblocks;
+    BlockNumber rblocks = ((const LVParallelIndex*)right)->nblocks;
+
+    if (lblocks > rblocks)
+        return -1;
+    if (lblocks < rblocks)
+        return 1;
+    return 0;
+}
+
+/*
+ *	lazy_parallel_vacuum_indexes() -- one ambulkdelete or amvacuumcleanup
+ *		pass over all indexes, with workers.
+ *
+ *		While the workers start up, the leader vacuums the indexes they
+ *		cannot take, then joins them on the rest.  If the workers cannot be
+ *		started the leader does everything itself.
+ */
+static void lazy_parallel_vacuum_indexes(Relation onerel, LVParallelState* pstate, Relation* Irel, int nindexes,
+    IndexBulkDeleteResult** indstats, bool cleanup)
+{
+    IndexBuildParallel* pbuild = NULL;
+    LVParallelIndex* pindex = NULL;
+    PGRUsage ru0;
+    int i;
+
+    pg_rusage_init(&ru0);
+
+    pstate->cleanup = cleanup;
+    pstate->nextIndex = 0;
+
+    /* share the leader's cost limit, and what it has spent so far */
+    if (pstate->costActive) {
+        pg_atomic_init_u32(&pstate->cost.balance, (uint32)t_thrd.vacuum_cxt.VacuumCostBalance);
+        pg_atomic_init_u32(&pstate->cost.nactive, 0);
+        pstate->cost.costLimit = u_sess->attr.attr_storage.VacuumCostLimit;
+        pstate->cost.costDelay = u_sess->attr.attr_storage.VacuumCostDelay;
+        t_thrd.vacuum_cxt.VacuumCostBalance = 0;
+        t_thrd.vacuum_cxt.VacuumCostBalanceLocal = 0;
+        t_thrd.vacuum_cxt.VacuumSharedCost = &pstate->cost;
+    }
+
+    pbuild = IndexVacuumParallelBegin(onerel, pstate->nworkers, lazy_parallel_worker, pstate);
+
+    PG_TRY();
+    {
+        for (i = 0; i < nindexes; i++) {
+            if (pstate->inParallel[i])
+                continue;
+
+            if (cleanup) {
+                /* IO collector and IO scheduler for vacuum */
+                if (ENABLE_WORKLOAD_CONTROL)
+                    IOSchedulerAndUpdate(IO_TYPE_WRITE, 1, IO_TYPE_ROW);
+
+                indstats[i] = lazy_cleanup_index(Irel[i], indstats[i], pstate->vacrelstats);
+            } else {
+                lazy_vacuum_index(Irel[i], &indstats[i], pstate->vacrelstats);
+            }
+            if (pbuild != NULL)
+                IndexBuildParallelCheck(pbuild);
+        }
+
+        while ((pindex = lazy_parallel_next_index(pbuild, pstate)) != NULL) {
+            if (cleanup && ENABLE_WORKLOAD_CONTROL)
+                IOSchedulerAndUpdate(IO_TYPE_WRITE, 1, IO_TYPE_ROW);
+
+            lazy_parallel_vacuum_one(pstate, pindex, Irel[pindex->irelIndex]);
+            if (pbuild != NULL)
+                IndexBuildParallelCheck(pbuild);
+        }
+
+        if (pbuild != NULL)
+            (void)IndexBuildParallelEnd(pbuild, NULL);
+    }
+    PG_CATCH();
+    {
+        if (pbuild != NULL)
+            IndexBuildParallelAbort(pbuild);
+        t_thrd.vacuum_cxt.VacuumSharedCost = NULL;
+        PG_RE_THROW();
+    }
+    PG_END_TRY();
+
+    /* the leader naps for whatever is left at its next delay point */
+    if (t_thrd.vacuum_cxt.VacuumSharedCost != NULL) {
+        t_thrd.vacuum_cxt.VacuumCostBalance = (int)pg_atomic_read_u32(&pstate->cost.balance);
+        t_thrd.vacuum_cxt.VacuumSharedCost = NULL;
+    }
+
+    if (pbuild != NULL)
+        ereport(elevel,
+            (errmsg("%s %d indexes of \"%s\" with %d parallel workers",
+                cleanup ? "cleaned up" : "vacuumed",
+                pstate->nindexes,
+                RelationGetRelationName(onerel),
+                pstate->nworkers),
+                errdetail("%s.", pg_rusage_show(&ru0))));
+}
+
+/*
+ * Hand out the next index of the pass, NULL once all are taken.  pbuild
+ * is NULL when the leader runs the pass on its own.
+ */
+static LVParallelIndex* lazy_parallel_next_index(IndexBuildParallel* pbuild, LVParallelState* pstate)
+{
+    LVParallelIndex* pindex = NULL;
+
+    if (pbuild != NULL)
+        (void)pthread_mutex_lock(&pbuild->mutex);
+    if (pstate->nextIndex < pstate->nindexes)
+        pindex = &pstate->indexes[pstate->nextIndex++];
+    if (pbuild != NULL)
+        (void)pthread_mutex_unlock(&pbuild->mutex);
+
+    return pindex;
+}
+
+/*
+ * Vacuum or clean up one index of a parallel pass, in the leader or a
+ * worker, and keep its results where the leader finds them.
+ */
+static void lazy_parallel_vacuum_one(LVParallelState* pstate, LVParallelIndex* pindex, Relation indrel)
+{
+    IndexBulkDeleteResult* stats = pindex->hasStats ? pindex->stats : NULL;
+
+    if (pstate->costActive)
+        (void)pg_atomic_add_fetch_u32(&pstate->cost.nactive, 1);
+
+    if (pstate->cleanup)
+        stats = lazy_cleanup_index(indrel, stats, pstate->vacrelstats);
+    else
+        lazy_vacuum_index(indrel, &stats, pstate->vacrelstats);
+
+    if (pstate->costActive)
+        (void)pg_atomic_sub_fetch_u32(&pstate->cost.nactive, 1);
+
+    /* results the access method allocated are in our own memory */
+    if (stats != NULL && stats != pindex->stats) {
+        errno_t rc = memcpy_s(pindex->stats, sizeof(IndexBulkDeleteResult), stats, sizeof(IndexBulkDeleteResult));
+        securec_check(rc, "\0", "\0");
+        pfree(stats);
+    }
+    pindex->hasStats = (stats != NULL);
+}
+
+/*
+ * Worker function of a parallel index pass; see IndexVacuumParallelBegin.
+ */
+static double lazy_parallel_worker(
+    IndexBuildParallel* pbuild, int workerId, Relation heap, Relation index, IndexInfo* indexInfo)
+{
+    LVParallelState* pstate = (LVParallelState*)pbuild->amstate;
+    LVParallelIndex* pindex = NULL;
+
+    /* the leader reports on the pass; a worker has no client to be verbose to */
+    elevel = DEBUG2;
+    vac_strategy = GetAccessStrategy(BAS_VACUUM);
+
+    u_sess->attr.attr_storage.VacuumCostPageHit = pstate->costPageHit;
+    u_sess->attr.attr_storage.VacuumCostPageMiss = pstate->costPageMiss;
+    u_sess->attr.attr_storage.VacuumCostPageDirty = pstate->costPageDirty;
+    t_thrd.vacuum_cxt.VacuumCostActive = pstate->costActive;
+    t_thrd.vacuum_cxt.VacuumCostBalance = 0;
+    t_thrd.vacuum_cxt.VacuumCostBalanceLocal = 0;
+    if (pstate->costActive)
+        t_thrd.vacuum_cxt.VacuumSharedCost = &pstate->cost;
+
+    while ((pindex = lazy_parallel_next_index(pbuild, pstate)) != NULL) {
+        Relation parent = NULL;
+        Partition part = NULL;
+        Relation indrel;
+
+        IndexBuildWorkerCheckAbort(pbuild);
+
+        indrel = IndexBuildWorkerOpen(pindex->indexOid, pindex->parentOid, true, &parent, &part);
+        lazy_parallel_vacuum_one(pstate, pindex, indrel);
+        IndexBuildWorkerClose(indrel, parent, part, true);
+    }
+
+    t_thrd.vacuum_cxt.VacuumSharedCost = NULL;
+    t_thrd.vacuum_cxt.VacuumCostActive = false;
+    FreeAccessStrategy(vac_strategy);
+    vac_strategy = NULL;
+
+    return 0;
+}
+
+/*
+ *	lazy_parallel_end() -- hand the results of the parallel indexes back to
+ *		the caller of lazy_scan_heap, and free the parallel state.
+ */
+static void lazy_parallel_end(LVParallelState* pstate, IndexBulkDeleteResult** indstats)
+{
+    int i;
+
+    for (i = 0; i < pstate->nindexes; i++) {
+        LVParallelIndex* pindex = &pstate->indexes[i];
+
+        if (pindex->hasStats) {
+            indstats[pindex->irelIndex] = pindex->stats;
+        } else {
+            indstats[pindex->irelIndex] = NULL;
+            pfree(pindex->stats);
+        }
     }
 
+    pfree(pstate->indexes);
+    pfree(pstate->inParallel);
+    pfree(pstate);
+}
+
+/*
+ * lazy_space_alloc - space allocation decisions for lazy vacuum
+ *
+ * See the comments at the head of this file for rationale.
+ */
+static void lazy_space_alloc(LVRelStats* vacrelstats)
+{
     vacrelstats->num_dead_tuples = 0;
-    vacrelstats->max_dead_tuples = (int)maxtuples;
-    vacrelstats->dead_tuples = (ItemPointer)palloc(maxtuples * sizeof(ItemPointerData));
+    vacrelstats->num_page_dead = 0;
+
+    if (vacrelstats->hasindex)
+        vacrelstats->dead_tuples = TidStoreCreate((Size)u_sess->attr.attr_memory.maintenance_work_mem * 1024L);
+    else
+        vacrelstats->dead_tuples = NULL;
 }
 
 /*
- * lazy_record_dead_tuple - remember one deletable tuple
+ * lazy_record_dead_tuple - remember one deletable tuple of the page being scanned
  */
 static void lazy_record_dead_tuple(LVRelStats* vacrelstats, ItemPointer itemptr)
 {
-    /*
-     * The array shouldn't overflow under normal behavior, but perhaps it
-     * could if we are given a really small maintenance_work_mem. In that
-     * case, just forget the last few tuples (we'll get 'em next time).
-     */
-    if (vacrelstats->num_dead_tuples < vacrelstats->max_dead_tuples) {
-        vacrelstats->dead_tuples[vacrelstats->num_dead_tuples] = *itemptr;
-        vacrelstats->num_dead_tuples++;
+    /* A heap page can't have more, but stay safe on a corrupt one */
+    if (vacrelstats->num_page_dead < MaxHeapTuplesPerPage) {
+        vacrelstats->page_dead[vacrelstats->num_page_dead] = ItemPointerGetOffsetNumber(itemptr);
+        vacrelstats->num_page_dead++;
     }
 }
 
 /*
  * lazy_tid_reaped() -- is a particular tid deletable?
  *      This has the right signature to be an IndexBulkDeleteCallback.
- *      Assumes dead_tuples array is in sorted order.
  *      inputparam partOid is valid only when index is global partition index
  */
 static bool lazy_tid_reaped(ItemPointer itemptr, void* state, Oid partOid)
 {
     LVRelStats* vacrelstats = (LVRelStats*)state;
-    ItemPointer res;
 
     // global partition index tuple need to check the tuple's partOid is same to current partition
     if (partOid != InvalidOid && vacrelstats->currVacuumPartOid != partOid) {
         return false;
     }
-    res = (ItemPointer)bsearch((void*)itemptr,
-        (void*)vacrelstats->dead_tuples,
-        vacrelstats->num_dead_tuples,
-        sizeof(ItemPointerData),
-        vac_cmp_itemptr);
-
-    return (res != NULL);
-}
 
-/*
- * Comparator routines for use with qsort() and bsearch().
- */
-static int vac_cmp_itemptr(const void* left, const void* right)
-{
-    BlockNumber lblk, rblk;
-    OffsetNumber loff, roff;
-    lblk = ItemPointerGetBlockNumber((ItemPointer)left);
-    rblk = ItemPointerGetBlockNumber((ItemPointer)right);
-    if (lblk < rblk)
-        return -1;
-    if (lblk > rblk)
-        return 1;
-    loff = ItemPointerGetOffsetNumber((ItemPointer)left);
-    roff = ItemPointerGetOffsetNumber((ItemPointer)right);
-    if (loff < roff)
-        return -1;
-    if (loff > roff)
-        return 1;
-    return 0;
+    return TidStoreIsMember(vacrelstats->dead_tuples, itemptr);
 }
 
 void elogVacuumInfo(Relation rel, HeapTuple tuple, char* funcName, TransactionId oldestxmin)
@@ -1548,7 +1548,13 @@ void cost_bitmap_heap_scan(
 
     T = (baserel->pages > 1) ? (double)baserel->pages : 1.0;
 
-    if (loop_count > 1) {
+    if (IsA(bitmapqual, IndexPath) && ((IndexPath*)bitmapqual)->indexinfo->amblockranges) {
+        /*
+         * A block range index returns whole ranges of adjacent heap blocks,
+         * and its selectivity already is the fraction of the heap they cover.
+         */
+        pages_fetched = indexSelectivity * T;
+    } else if (loop_count > 1) {
         /*
          * For repeated bitmap scans, scale up the number of tuples fetched in
          * the Mackert and Lohman formula by the number of scans, so that we
@@ -331,6 +331,7 @@ void get_relation_info(PlannerInfo* root, Oid relationObjectId, bool inhparent,
             info->amsearchnulls = indexRelation->rd_am->amsearchnulls;
             info->amhasgettuple = OidIsValid(indexRelation->rd_am->amgettuple);
             info->amhasgetbitmap = OidIsValid(indexRelation->rd_am->amgetbitmap);
+            info->amblockranges = (info->relam == BRIN_AM_OID);
 
             /*
              * Fetch the ordering information for the index, if any.
@@ -0,0 +1,340 @@
+/*
+* Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+*
+* openGauss is licensed under Mulan PSL v2.
+* You can use this software according to the terms and conditions of the Mulan PSL v2.
+* You may obtain a copy of Mulan PSL v2 at:
+*
+*          http://license.coscl.org.cn/MulanPSL2
+*
+* THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+* EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+* MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+* See the Mulan PSL v2 for more details.
+* -------------------------------------------------------------------------
+*
+* globalplancache_autoparam.cpp
+*    automatic parameterization of simple-protocol queries
+*
+*    A simple query whose literals can be replaced by parameters is turned
+*    into an internal prepared statement named after its parameterized text,
+*    and executed through EXECUTE with the literals as parameter values. The
+*    prepared statement goes through the usual plancache path, so it gets the
+*    custom/generic plan choice and, with enable_global_plancache, is shared
+*    through the global plan cache keyed by the parameterized text.
+*
+* IDENTIFICATION
+*     src/gausskernel/process/globalplancache/globalplancache_autoparam.cpp
+*
+* -------------------------------------------------------------------------
+*/
+
+#include "postgres.h"
+#include "knl/knl_variable.h"
+
+#include "access/hash.h"
+#include "catalog/pg_type.h"
+#include "commands/prepare.h"
+#include "funcapi.h"
+#include "instruments/unique_query.h"
+#include "lib/stringinfo.h"
+#include "optimizer/pgxcplan.h"
+#include "parser/analyze.h"
+#include "parser/parser.h"
+#include "rewrite/rewriteHandler.h"
+#include "tcop/utility.h"
+#include "utils/builtins.h"
+#include "utils/globalplancache.h"
+#include "utils/memutils.h"
+#include "utils/plancache.h"
+
+#define AUTO_PARAM_STMT_PREFIX "__auto_param_"
+#define AUTO_PARAM_STAT_ATTR_NUM 8
+
+typedef struct AutoParamEntry {
+    char stmt_name[NAMEDATALEN]; /* hash key, must be first */
+    uint64 calls;                /* executions served through this statement */
+    uint64 last_used;            /* value of auto_param_clock at last use */
+} AutoParamEntry;
+
+static void AutoParamInitHash()
+{
+    HASHCTL hash_ctl;
+    errno_t rc = memset_s(&hash_ctl, sizeof(hash_ctl), 0, sizeof(hash_ctl));
+    securec_check(rc, "\0", "\0");
+
+    hash_ctl.keysize = NAMEDATALEN;
+    hash_ctl.entrysize = sizeof(AutoParamEntry);
+    hash_ctl.hcxt = u_sess->cache_mem_cxt;
+
+    u_sess->pcache_cxt.auto_param_htab = hash_create("Auto Parameterized Queries", 64, &hash_ctl,
+        HASH_ELEM | HASH_CONTEXT);
+}
+
+/*
+ * Drop the least recently used auto-parameterized statement to make room for
+ * a new one.
+ */
+static void AutoParamEvictOne()
+{
+    HASH_SEQ_STATUS seq;
+    AutoParamEntry* entry = NULL;
+    AutoParamEntry* victim = NULL;
+
+    hash_seq_init(&seq, u_sess->pcache_cxt.auto_param_htab);
+    while ((entry = (AutoParamEntry*)hash_seq_search(&seq)) != NULL) {
+        if (victim == NULL || entry->last_used < victim->last_used) {
+            victim = entry;
+        }
+    }
+
+    if (victim == NULL) {
+        return;
+    }
+
+    DropPreparedStatement(victim->stmt_name, false);
+    (void)hash_search(u_sess->pcache_cxt.auto_param_htab, victim->stmt_name, HASH_REMOVE, NULL);
+    u_sess->pcache_cxt.auto_param_stats.evictions++;
+}
+
+/*
+ * Build and store the prepared statement for a parameterized query text.
+ * Returns false if the text doesn't parse back into a single statement,
+ * in which case the caller plans the original query as usual.
+ */
+static bool AutoParamPrepare(const char* stmt_name, const char* query_string, List* param_consts)
+{
+    List* parsetree_list = NIL;
+    Node* raw_parse_tree = NULL;
+    CachedPlanSource* plansource = NULL;
+    Query* query = NULL;
+    List* query_list = NIL;
+    Oid* param_types = NULL;
+    int num_params = list_length(param_consts);
+    ListCell* lc = NULL;
+    int i = 0;
+
+    /*
+     * Only literals in positions where the grammar accepts a parameter are
+     * replaced (see const_is_parameterizable), so the parameterized text
+     * parses like the original query did.
+     */
+    parsetree_list = raw_parser(query_string);
+    if (list_length(parsetree_list) != 1) {
+        return false;
+    }
+    raw_parse_tree = (Node*)linitial(parsetree_list);
+
+    if (num_params > 0) {
+        param_types = (Oid*)palloc(num_params * sizeof(Oid));
+        foreach (lc, param_consts) {
+            param_types[i++] = ((Const*)lfirst(lc))->consttype;
+        }
+    }
+
+    plansource = CreateCachedPlan(raw_parse_tree,
+        query_string,
+#ifdef PGXC
+        stmt_name,
+#endif
+        CreateCommandTag(raw_parse_tree));
+
+    query = parse_analyze((Node*)copyObject(raw_parse_tree), query_string, param_types, num_params);
+
+    if (ENABLE_CN_GPC && plansource->gpc.status.IsSharePlan() && contains_temp_tables(query->rtable)) {
+        /* temp table unsupport shared */
+        plansource->gpc.status.SetKind(GPC_UNSHARED);
+    }
+
+    query_list = QueryRewrite(query);
+
+    CompleteCachedPlan(plansource,
+        query_list,
+        NULL,
+        param_types,
+        num_params,
+        NULL,
+        NULL,
+        0,    /* default cursor options */
+        true, /* fixed result */
+        stmt_name);
+
+    StorePreparedStatement(stmt_name, plansource, false);
+    return true;
+}
+
+/*
+ * Build the text that names and keys the statement of a parameterized query.
+ *
+ * The statement is prepared with the types of the extracted literals as its
+ * parameter types, and EXECUTE coerces later values to them by assignment.
+ * A literal of another type (1.5 where 1 was seen before) therefore needs a
+ * statement of its own, so the types lead the text as a comment. This keeps
+ * them in the session statement name and in the global plan cache key alike.
+ */
+static char* AutoParamKeyText(const char* param_query, List* param_consts)
+{
+    StringInfoData buf;
+    ListCell* lc = NULL;
+    bool first = true;
+
+    initStringInfo(&buf);
+    appendStringInfoString(&buf, "/* auto_param(");
+    foreach (lc, param_consts) {
+        appendStringInfo(&buf, first ? "%u" : ",%u", ((Const*)lfirst(lc))->consttype);
+        first = false;
+    }
+    appendStringInfo(&buf, ") */ %s", param_query);
+    return buf.data;
+}
+
+/*
+ * Try to serve an analyzed simple query through the plan cache of its
+ * parameterized form.
+ *
+ * On success returns a one-element list holding the EXECUTE statement to run
+ * in place of the planned query; returns NIL when the query has to be planned
+ * as usual.
+ */
+List* AutoParamGetExecutePlan(Query* query, const char* query_string)
+{
+    AutoParamEntry* entry = NULL;
+    PreparedStatement* pstmt = NULL;
+    ExecuteStmt* stmt = NULL;
+    List* param_consts = NIL;
+    char stmt_name[NAMEDATALEN];
+    char* param_query = NULL;
+    int num_params = 0;
+    bool found = false;
+    errno_t rc;
+
+    if (query->utilityStmt != NULL) {
+        return NIL;
+    }
+
+    switch (query->commandType) {
+        case CMD_SELECT:
+        case CMD_INSERT:
+        case CMD_UPDATE:
+        case CMD_DELETE:
+            break;
+        default:
+            return NIL;
+    }
+
+    u_sess->pcache_cxt.auto_param_stats.calls++;
+
+    param_query = parameterize_unique_querystring(query, query_string, &num_params, &param_consts);
+    if (param_query == NULL) {
+        u_sess->pcache_cxt.auto_param_stats.rejected++;
+        return NIL;
+    }
+    param_query = AutoParamKeyText(param_query, param_consts);
+
+    uint32 query_len = (uint32)strlen(param_query);
+    uint32 query_hash = DatumGetUInt32(hash_any((const unsigned char*)param_query, query_len));
+    rc = snprintf_s(stmt_name, NAMEDATALEN, NAMEDATALEN - 1, "%s%08x_%x", AUTO_PARAM_STMT_PREFIX,
+        query_hash, query_len);
+    securec_check_ss(rc, "\0", "\0");
+
+    if (u_sess->pcache_cxt.auto_param_htab == NULL) {
+        AutoParamInitHash();
+    }
+    entry = (AutoParamEntry*)hash_search(u_sess->pcache_cxt.auto_param_htab, stmt_name, HASH_FIND, NULL);
+
+    /* The statement may be gone through DEALLOCATE ALL; then just rebuild it */
+    pstmt = FetchPreparedStatement(stmt_name, false, false);
+    if (pstmt != NULL) {
+        /* a hash collision with another query text or parameter types, don't touch it */
+        if (strcmp(pstmt->plansource->query_string, param_query) != 0) {
+            u_sess->pcache_cxt.auto_param_stats.rejected++;
+            return NIL;
+        }
+        u_sess->pcache_cxt.auto_param_stats.hits++;
+    } else {
+        if (entry == NULL &&
+            hash_get_num_entries(u_sess->pcache_cxt.auto_param_htab) >=
+            u_sess->attr.attr_sql.auto_parameterize_max_statements) {
+            AutoParamEvictOne();
+        }
+
+        CachedPlanSource* plansource = NULL;
+        if (ENABLE_CN_GPC) {
+            plansource = g_instance.plan_cache->Fetch(param_query, query_len, num_params, NULL);
+        }
+
+        if (plansource != NULL) {
+            StorePreparedStatementCNGPC(stmt_name, plansource, false, true);
+            u_sess->pcache_cxt.auto_param_stats.gpc_hits++;
+        } else {
+            if (!AutoParamPrepare(stmt_name, param_query, param_consts)) {
+                u_sess->pcache_cxt.auto_param_stats.rejected++;
+                return NIL;
+            }
+            u_sess->pcache_cxt.auto_param_stats.misses++;
+        }
+    }
+
+    if (entry == NULL) {
+        entry = (AutoParamEntry*)hash_search(u_sess->pcache_cxt.auto_param_htab, stmt_name, HASH_ENTER, &found);
+        if (!found) {
+            entry->calls = 0;
+        }
+    }
+    entry->calls++;
+    entry->last_used = ++u_sess->pcache_cxt.auto_param_clock;
+
+    stmt = makeNode(ExecuteStmt);
+    stmt->name = pstrdup(stmt_name);
+    stmt->params = param_consts;
+
+    return list_make1(stmt);
+}
+
+/*
+ * gs_auto_param_stat
+ *    hit statistics of automatic parameterization in the current session
+ */
+Datum gs_auto_param_stat(PG_FUNCTION_ARGS)
+{
+    TupleDesc tupdesc;
+    Datum values[AUTO_PARAM_STAT_ATTR_NUM];
+    bool nulls[AUTO_PARAM_STAT_ATTR_NUM];
+    AutoParamStats* stats = &u_sess->pcache_cxt.auto_param_stats;
+    uint64 served = stats->hits + stats->gpc_hits + stats->misses;
+    int64 cached = 0;
+    errno_t rc;
+
+    tupdesc = CreateTemplateTupleDesc(AUTO_PARAM_STAT_ATTR_NUM, false, TAM_HEAP);
+    TupleDescInitEntry(tupdesc, (AttrNumber)1, "calls", INT8OID, -1, 0);
+    TupleDescInitEntry(tupdesc, (AttrNumber)2, "rejected", INT8OID, -1, 0);
+    TupleDescInitEntry(tupdesc, (AttrNumber)3, "hits", INT8OID, -1, 0);
+    TupleDescInitEntry(tupdesc, (AttrNumber)4, "gpc_hits", INT8OID, -1, 0);
+    TupleDescInitEntry(tupdesc, (AttrNumber)5, "misses", INT8OID, -1, 0);
+    TupleDescInitEntry(tupdesc, (AttrNumber)6, "evictions", INT8OID, -1, 0);
+    TupleDescInitEntry(tupdesc, (AttrNumber)7, "cached_statements", INT8OID, -1, 0);
+    TupleDescInitEntry(tupdesc, (AttrNumber)8, "hit_ratio", FLOAT8OID, -1, 0);
+    tupdesc = BlessTupleDesc(tupdesc);
+
+    rc = memset_s(nulls, sizeof(nulls), 0, sizeof(nulls));
+    securec_check(rc, "\0", "\0");
+
+    if (u_sess->pcache_cxt.auto_param_htab != NULL) {
+        cached = hash_get_num_entries(u_sess->pcache_cxt.auto_param_htab);
+    }
+
+    values[0] = Int64GetDatum((int64)stats->calls);
+    values[1] = Int64GetDatum((int64)stats->rejected);
+    values[2] = Int64GetDatum((int64)stats->hits);
+    values[3] = Int64GetDatum((int64)stats->gpc_hits);
+    values[4] = Int64GetDatum((int64)stats->misses);
+    values[5] = Int64GetDatum((int64)stats->evictions);
+    values[6] = Int64GetDatum(cached);
+    if (served > 0) {
+        values[7] = Float8GetDatum((float8)(stats->hits + stats->gpc_hits) / (float8)served);
+    } else {
+        nulls[7] = true;
+    }
+
+    PG_RETURN_DATUM(HeapTupleGetDatum(heap_form_tuple(tupdesc, values, nulls)));
+}
@@ -73,6 +73,7 @@
 #include <sys/stat.h>
 #endif
 
+#include "access/brin.h"
 #include "access/hash.h"
 #include "access/gtm.h"
 #include "access/heapam.h"
@@ -252,6 +253,21 @@ typedef enum {
     AutoVacNumSignals  /* must be last */
 } AutoVacuumSignal;
 
+/*
+ * A work item requested by a backend, done by the next worker that processes
+ * its database.  avw_active is set while a worker performs it.
+ */
+typedef struct AutoVacuumWorkItem {
+    AutoVacuumWorkItemType avw_type;
+    bool avw_used; /* the fields below are valid */
+    bool avw_active;
+    Oid avw_database;
+    Oid avw_relation;
+    BlockNumber avw_blockNumber;
+} AutoVacuumWorkItem;
+
+#define NUM_WORKITEMS 256
+
 /* -------------
  * The main autovacuum shmem struct.  On shared memory we store this main
  * struct and the array of WorkerInfo structs.	This struct keeps:
@@ -262,6 +278,7 @@ typedef enum {
  * av_runningWorkers the WorkerInfo non-free queue
  * av_startingWorker pointer to WorkerInfo currently being started (cleared by
  *					the worker itself as soon as it's up and running)
+ * av_workItems		work item array
  *
  * This struct is protected by AutovacuumLock, except for av_signal and parts
  * of the worker list (see above).
@@ -273,6 +290,7 @@ typedef struct AutoVacuumShmemStruct {
     WorkerInfo av_freeWorkers;
     SHM_QUEUE av_runningWorkers;
     WorkerInfo av_startingWorker;
+    AutoVacuumWorkItem av_workItems[NUM_WORKITEMS];
 } AutoVacuumShmemStruct;
 
 NON_EXEC_STATIC void AutoVacWorkerMain();
@@ -287,6 +305,8 @@ static int db_comparator(const void* a, const void* b);
 static void autovac_balance_cost(void);
 
 static void do_autovacuum(void);
+static void perform_work_items(void);
+static void perform_work_item(AutoVacuumWorkItem* workitem);
 static void FreeWorkerInfo(int code, Datum arg);
 
 /* add parameter toast_table_map by data partition. */
@@ -2741,6 +2761,8 @@ static void do_autovacuum(void)
      * going away soon, it's not a problem.
      */
 
+    perform_work_items();
+
     /*
      * Update pg_database.datfrozenxid, and truncate pg_clog if possible. We
      * only need to do this once, not after each table.
@@ -2753,6 +2775,123 @@ static void do_autovacuum(void)
     CommitTransactionCommand();
 }
 
+/*
+ * Perform the work items backends requested for our database.
+ */
+static void perform_work_items(void)
+{
+    LWLockAcquire(AutovacuumLock, LW_EXCLUSIVE);
+    for (int i = 0; i < NUM_WORKITEMS; i++) {
+        AutoVacuumWorkItem* workitem = &t_thrd.autovacuum_cxt.AutoVacuumShmem->av_workItems[i];
+
+        if (!workitem->avw_used || workitem->avw_active ||
+            workitem->avw_database != u_sess->proc_cxt.MyDatabaseId)
+            continue;
+
+        /* claim this one, and release the lock while performing it */
+        workitem->avw_active = true;
+        LWLockRelease(AutovacuumLock);
+
+        perform_work_item(workitem);
+        CHECK_FOR_INTERRUPTS();
+
+        LWLockAcquire(AutovacuumLock, LW_EXCLUSIVE);
+        workitem->avw_active = false;
+        workitem->avw_used = false;
+    }
+    LWLockRelease(AutovacuumLock);
+}
+
+/*
+ * Perform one work item in a transaction of its own.  Errors are reported
+ * and do not stop the worker, as for tables.
+ */
+static void perform_work_item(AutoVacuumWorkItem* workitem)
+{
+    char* relname = NULL;
+    char* nspname = NULL;
+
+    MemoryContextResetAndDeleteChildren(t_thrd.mem_cxt.portal_mem_cxt);
+    (void)MemoryContextSwitchTo(t_thrd.mem_cxt.portal_mem_cxt);
+
+    /* the relation may have been dropped since the request */
+    relname = get_rel_name(workitem->avw_relation);
+    if (relname == NULL)
+        return;
+    nspname = get_namespace_name(get_rel_namespace(workitem->avw_relation));
+
+    PG_TRY();
+    {
+        if (ActiveSnapshotSet())
+            PopActiveSnapshot();
+        CommitTransactionCommand();
+
+        StartTransactionCommand();
+        PushActiveSnapshot(GetTransactionSnapshot());
+        (void)MemoryContextSwitchTo(t_thrd.mem_cxt.portal_mem_cxt);
+
+        switch (workitem->avw_type) {
+            case AVW_BRINSummarizeRange:
+                SetCurrentStatementStartTimestamp();
+                pgstat_report_activity(STATE_RUNNING, "autovacuum: BRIN summarize");
+                brin_summarize_range_work(workitem->avw_relation, workitem->avw_blockNumber);
+                break;
+            default:
+                ereport(WARNING, (errmsg("unrecognized work item found: type %d", (int)workitem->avw_type)));
+                break;
+        }
+
+        t_thrd.int_cxt.QueryCancelPending = false;
+    }
+    PG_CATCH();
+    {
+        HOLD_INTERRUPTS();
+        t_thrd.int_cxt.QueryCancelPending = false;
+        errcontext("processing work entry for relation \"%s.%s\"", nspname != NULL ? nspname : "?", relname);
+        EmitErrorReport();
+
+        AbortCurrentTransaction();
+        FlushErrorState();
+        MemoryContextResetAndDeleteChildren(t_thrd.mem_cxt.msg_mem_cxt);
+        MemoryContextResetAndDeleteChildren(t_thrd.mem_cxt.portal_mem_cxt);
+
+        StartTransactionCommand();
+        RESUME_INTERRUPTS();
+    }
+    PG_END_TRY();
+
+    MemoryContextResetAndDeleteChildren(t_thrd.mem_cxt.portal_mem_cxt);
+}
+
+/*
+ * Queue a work item for the autovacuum workers of the current database.
+ * Returns false if the array of work items is full.
+ */
+bool AutoVacuumRequestWork(AutoVacuumWorkItemType type, Oid relationId, BlockNumber blkno)
+{
+    bool result = false;
+
+    LWLockAcquire(AutovacuumLock, LW_EXCLUSIVE);
+    for (int i = 0; i < NUM_WORKITEMS; i++) {
+        AutoVacuumWorkItem* workitem = &t_thrd.autovacuum_cxt.AutoVacuumShmem->av_workItems[i];
+
+        if (workitem->avw_used)
+            continue;
+
+        workitem->avw_used = true;
+        workitem->avw_active = false;
+        workitem->avw_type = type;
+        workitem->avw_database = u_sess->proc_cxt.MyDatabaseId;
+        workitem->avw_relation = relationId;
+        workitem->avw_blockNumber = blkno;
+        result = true;
+        break;
+    }
+    LWLockRelease(AutovacuumLock);
+
+    return result;
+}
+
 /*
  * extract_autovac_opts
  *
@@ -3372,6 +3511,7 @@ void AutoVacuumShmemInit(void)
     if (!IsUnderPostmaster) {
         WorkerInfo worker = NULL;
         int i = 0;
+        errno_t rc;
 
         if (unlikely(found)) {
             ereport(PANIC, (errmsg("AutoVacuum Data share mem is already init")));
@@ -3381,6 +3521,9 @@ void AutoVacuumShmemInit(void)
         t_thrd.autovacuum_cxt.AutoVacuumShmem->av_freeWorkers = NULL;
         SHMQueueInit(&t_thrd.autovacuum_cxt.AutoVacuumShmem->av_runningWorkers);
         t_thrd.autovacuum_cxt.AutoVacuumShmem->av_startingWorker = NULL;
+        rc = memset_s(t_thrd.autovacuum_cxt.AutoVacuumShmem->av_workItems, sizeof(AutoVacuumWorkItem) * NUM_WORKITEMS,
+            0, sizeof(AutoVacuumWorkItem) * NUM_WORKITEMS);
+        securec_check(rc, "\0", "\0");
 
         worker = (WorkerInfo)((char*)t_thrd.autovacuum_cxt.AutoVacuumShmem + MAXALIGN(sizeof(AutoVacuumShmemStruct)));
 
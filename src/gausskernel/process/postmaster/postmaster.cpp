@@ -81,6 +81,7 @@
 
 #include "access/cbmparsexlog.h"
 #include "access/obs/obs_am.h"
+#include "access/parallelbuild.h"
 #include "access/transam.h"
 #include "access/xlog.h"
 #include "access/xact.h"
@@ -10486,6 +10487,13 @@ int GaussDbThreadMain(knl_thread_arg* arg)
             }
        } break;
 
+        case INDEX_BUILD_WORKER: {
+            /* the leader assigned our child slot before launching us */
+            t_thrd.proc_cxt.MyPMChildSlot = IndexBuildWorkerAttach(arg->payload);
+            InitProcessAndShareMemory();
+            proc_exit(IndexBuildWorkerMain(arg->payload));
+        } break;
+
 #ifdef ENABLE_MULTIPLE_NODES
         case COMM_POOLER_CLEAN: {
             InitProcessAndShareMemory();
@@ -10578,6 +10586,7 @@ static ThreadMetaData GaussdbThreadGate[] = {
     { GaussDbThreadMain<COMM_POOLER_CLEAN>, COMM_POOLER_CLEAN, "COMMpoolcleaner", "communicator pooler auto cleaner" },
     { GaussDbThreadMain<CSNMIN_SYNC>, CSNMIN_SYNC, "csnminsync", "csnmin sync" },
     { GaussDbThreadMain<BARRIER_CREATOR>, BARRIER_CREATOR, "barriercreator", "barrier creator" },
+    { GaussDbThreadMain<INDEX_BUILD_WORKER>, INDEX_BUILD_WORKER, "idxbuildworker", "index build worker" },
 
 	/* Keep the block in the end if it may be absent !!! */
 #ifdef ENABLE_MULTIPLE_NODES
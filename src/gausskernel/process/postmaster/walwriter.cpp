@@ -354,6 +354,10 @@ static void wal_quickdie(SIGNAL_ARGS)
     pg_memory_barrier();
     /* Stop WalWriterAuxiliary from waiting. */
     WakeupWalSemaphore(&g_instance.wal_cxt.walInitSegLock->l.sem);
+    Latch* auxLatch = ((volatile PROC_HDR*)g_instance.proc_base)->walwriterauxiliaryLatch;
+    if (auxLatch != NULL) {
+        SetLatch(auxLatch);
+    }
 
     /*
      * We DO NOT want to run proc_exit() callbacks -- we're here because
@@ -405,6 +409,10 @@ static void WalShutdownHandler(SIGNAL_ARGS)
     pg_memory_barrier();
     /* Stop WalWriterAuxiliary from waiting. */
     WakeupWalSemaphore(&g_instance.wal_cxt.walInitSegLock->l.sem);
+    Latch* auxLatch = ((volatile PROC_HDR*)g_instance.proc_base)->walwriterauxiliaryLatch;
+    if (auxLatch != NULL) {
+        SetLatch(auxLatch);
+    }
     
 }
 
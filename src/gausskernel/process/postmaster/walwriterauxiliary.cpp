@@ -222,12 +222,26 @@ void WalWriterAuxiliaryMain(void)
 
         if (t_thrd.walwriterauxiliary_cxt.shutdown_requested) {
             /* Normal exit from the walwriterauxiliary is here. */
+            g_instance.proc_base->walwriterauxiliaryLatch = NULL;
             proc_exit(0); /* done */
         }
 
         if (g_instance.wal_cxt.isWalWriterUp) {
-            PGSemaphoreLock(&g_instance.wal_cxt.walInitSegLock->l.sem, true);
-            PreInitXlogFileForPrimary(g_instance.attr.attr_storage.wal_file_init_num);
+            /*
+             * Keep the WAL buffer pages flushed by the WAL writer zeroed and
+             * header-initialized ahead of the inserters. The WAL writer sets our
+             * latch after every flush, inserters set it when they find no free
+             * page, and so does whoever asks for a new segment. Buffers always
+             * go first: segment creation is slow and checks on them in between,
+             * and we look at them again before going to sleep.
+             */
+            if (XLogPreInitWalBuffers()) {
+                continue;
+            }
+            if (PGSemaphoreTryLock(&g_instance.wal_cxt.walInitSegLock->l.sem)) {
+                PreInitXlogFileForPrimary(g_instance.attr.attr_storage.wal_file_init_num);
+                continue;
+            }
         } else {
             if (g_instance.attr.attr_storage.advance_xlog_file_num > 0 &&
                 t_thrd.postmaster_cxt.HaShmData->current_mode == STANDBY_MODE &&
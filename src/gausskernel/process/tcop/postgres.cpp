@@ -166,6 +166,7 @@ extern int optreset; /* might not be declared by system headers */
 #include "utils/syscache.h"
 #include "access/heapam.h"
 #include "utils/plancache.h"
+#include "utils/globalplancache.h"
 #include "commands/tablecmds.h"
 #include "catalog/gs_matview.h"
 #include "streaming/dictcache.h"
@@ -2221,6 +2222,10 @@ static void exec_simple_query(const char* query_string, MessageType messageType,
     bool runOpfusionCheck = (msg != NULL) && IS_PGXC_DATANODE && u_sess->attr.attr_sql.enable_opfusion &&
         (list_length(parsetree_list) == 1) && (query_string_len < SECUREC_MEM_MAX_LEN);
 
+    /* Auto-parameterization is only tried for single query from 'Q' message */
+    bool runAutoParamCheck = (msg != NULL) && u_sess->attr.attr_sql.enable_auto_parameterize &&
+        (list_length(parsetree_list) == 1) && (query_string_len < SECUREC_MEM_MAX_LEN);
+
     /*
      * Switch back to transaction context to enter the loop.
      */
@@ -2444,7 +2449,23 @@ static void exec_simple_query(const char* query_string, MessageType messageType,
             break;
         }
 
-        plantree_list = pg_plan_queries(querytree_list, 0, NULL);
+        /*
+         * Try to serve the query through the cached plan of its parameterized
+         * form. MOT queries are left to the MOT JIT path.
+         */
+        bool autoParameterized = false;
+        if (runAutoParamCheck && HYBRID_MESSAGE != messageType && list_length(querytree_list) == 1
+#ifdef ENABLE_MOT
+            && storageEngineType != SE_TYPE_MOT && storageEngineType != SE_TYPE_MIXED
+#endif
+            ) {
+            plantree_list = AutoParamGetExecutePlan((Query*)linitial(querytree_list), query_string);
+            autoParameterized = (plantree_list != NIL);
+        }
+
+        if (!autoParameterized) {
+            plantree_list = pg_plan_queries(querytree_list, 0, NULL);
+        }
 
         randomPlanInfo = get_random_plan_string();
         if (was_logged != false && randomPlanInfo != NULL) {
@@ -2499,7 +2520,7 @@ static void exec_simple_query(const char* query_string, MessageType messageType,
             SetForceXidFromGTM(true);
 #endif
         /* SQL bypass */
-        if (runOpfusionCheck) {
+        if (runOpfusionCheck && !autoParameterized) {
             (void)MemoryContextSwitchTo(oldcontext);
             void* opFusionObj = OpFusion::FusionFactory(
                 OpFusion::getFusionType(NULL, NULL, plantree_list), oldcontext, NULL, plantree_list, NULL);
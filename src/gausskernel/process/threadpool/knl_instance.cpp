@@ -121,6 +121,9 @@ static void knl_g_wal_init(knl_g_wal_context *const wal_cxt)
     wal_cxt->lastLRCScanned = WAL_SCANNED_LRC_INIT;
     wal_cxt->lastLRCFlushed = WAL_SCANNED_LRC_INIT;
     wal_cxt->num_locks_in_group = 0;
+    for (int i = 0; i < WAL_INSERT_LATENCY_BUCKETS; i++) {
+        wal_cxt->insertLatencyHist[i].count = 0;
+    }
 }
 
 static void knl_g_bgwriter_init(knl_g_bgwriter_context *bgwriter_cxt)
@@ -367,6 +370,10 @@ static void knl_g_stat_init(knl_g_stat_context* stat_cxt)
     securec_check(rc, "\0", "\0");
 
     stat_cxt->snapshot_thread_counter = 0;
+    stat_cxt->btBottomupPasses = 0;
+    stat_cxt->btBottomupHeapBlocks = 0;
+    stat_cxt->btBottomupDeletedTids = 0;
+    stat_cxt->btBottomupSplitsAvoided = 0;
 
     stat_cxt->fileIOStat = (FileIOStat*)MemoryContextAllocZero(
         INSTANCE_GET_MEM_CXT_GROUP(MEMORY_CONTEXT_DFX), sizeof(FileIOStat));
@@ -435,6 +435,11 @@ static void knl_u_plancache_init(knl_u_plancache_context* pcache_cxt)
     pcache_cxt->gpc_remote_msg = false;
     pcache_cxt->gpc_first_send = true;
     pcache_cxt->gpc_in_try_store = false;
+
+    pcache_cxt->auto_param_htab = NULL;
+    pcache_cxt->auto_param_clock = 0;
+    errno_t rc = memset_s(&pcache_cxt->auto_param_stats, sizeof(AutoParamStats), 0, sizeof(AutoParamStats));
+    securec_check(rc, "\0", "\0");
 }
 
 static void knl_u_typecache_init(knl_u_typecache_context* tycache_cxt)
@@ -1168,6 +1173,7 @@ void knl_session_init(knl_session_context* sess_cxt)
     DLInitElem(&sess_cxt->elem, sess_cxt);
 
     sess_cxt->attachPid = InvalidTid;
+    sess_cxt->numa_affinity = -1;
     sess_cxt->top_transaction_mem_cxt = NULL;
     sess_cxt->self_mem_cxt = NULL;
     sess_cxt->temp_mem_cxt = NULL;
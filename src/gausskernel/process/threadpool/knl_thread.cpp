@@ -611,6 +611,8 @@ static void knl_t_vacuum_init(knl_t_vacuum_context* vacuum_cxt)
     vacuum_cxt->VacuumPageDirty = 0;
     vacuum_cxt->VacuumCostBalance = 0;
     vacuum_cxt->VacuumCostActive = false;
+    vacuum_cxt->VacuumSharedCost = NULL;
+    vacuum_cxt->VacuumCostBalanceLocal = 0;
     vacuum_cxt->vacuum_full_compact = false;
     vacuum_cxt->vac_context = NULL;
     vacuum_cxt->in_vacuum = false;
@@ -108,6 +108,7 @@ void ThreadPoolControler::Init(bool enableNumaDistribute)
     int expectThreadNum = 0;
     int maxStreamNum = 0;
     int numaId = 0;
+    int groupNumaId = -1;
     int cpuNum = 0;
     int *cpuArr = NULL;
 
@@ -135,17 +136,18 @@ void ThreadPoolControler::Init(bool enableNumaDistribute)
                 (double)m_maxPoolSize * ((double)m_cpuInfo.cpuArrSize[numaId] / (double)m_cpuInfo.activeCpuNum));
             cpuNum = m_cpuInfo.cpuArrSize[numaId];
             cpuArr = m_cpuInfo.cpuArr[numaId];
+            groupNumaId = numaId;
 
             numaId++;
         } else {
             expectThreadNum = m_threadNum / m_groupNum;
             maxThreadNum = m_maxPoolSize / m_groupNum;
             maxStreamNum = m_maxPoolSize / m_groupNum;
-            numaId = -1;
+            groupNumaId = -1;
         }
 
         m_groups[i] = New(CurrentMemoryContext)ThreadPoolGroup(maxThreadNum, expectThreadNum,
-                                                    maxStreamNum, i, numaId, cpuNum, cpuArr);
+                                                    maxStreamNum, i, groupNumaId, cpuNum, cpuArr);
         m_groups[i]->Init(enableNumaDistribute);
     }
 
@@ -692,6 +694,30 @@ bool ThreadPoolControler::StayInAttachMode()
     return m_sessCtrl->GetActiveSessionCount() < m_threadNum;
 }
 
+/*
+ * Find the group with the least sessions among the groups bound to a NUMA node,
+ * or NULL if no group is bound to it.
+ */
+ThreadPoolGroup* ThreadPoolControler::FindThreadGroupOnNuma(int numaId)
+{
+    ThreadPoolGroup* grp = NULL;
+    float4 least_session = 0.0;
+    float4 session_per_thread = 0.0;
+
+    for (int i = 0; i < m_groupNum; i++) {
+        if (m_groups[i]->GetNumaId() != numaId) {
+            continue;
+        }
+        session_per_thread = m_groups[i]->GetSessionPerThread();
+        if (grp == NULL || session_per_thread < least_session) {
+            least_session = session_per_thread;
+            grp = m_groups[i];
+        }
+    }
+
+    return grp;
+}
+
 int ThreadPoolControler::DispatchSession(Port* port)
 {
     ThreadPoolGroup* grp = NULL;
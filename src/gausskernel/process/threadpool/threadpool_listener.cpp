@@ -155,6 +155,21 @@ void ThreadPoolListener::CreateEpoll()
 }
 
 void ThreadPoolListener::AddEpoll(knl_session_context* session)
+{
+    RegisterSession(session, (session->status != KNL_SESS_UNINIT) ? EPOLL_CTL_MOD : EPOLL_CTL_ADD);
+}
+
+/*
+ * Take over an established session from the listener of another group,
+ * which has already removed the session from its epoll.
+ */
+void ThreadPoolListener::TakeOverSession(knl_session_context* session)
+{
+    RegisterSession(session, EPOLL_CTL_ADD);
+    (void)pg_atomic_fetch_add_u32((volatile uint32*)&m_group->m_sessionCount, 1);
+}
+
+void ThreadPoolListener::RegisterSession(knl_session_context* session, int op)
 {
     struct epoll_event ev = {0};
 
@@ -169,11 +184,7 @@ void ThreadPoolListener::AddEpoll(knl_session_context* session)
      */
     ev.events = EPOLLRDHUP | EPOLLIN | EPOLLET | EPOLLONESHOT;
     ev.data.ptr = (void*)session;
-    if (session->status != KNL_SESS_UNINIT) {
-        epoll_ctl(m_epollFd, EPOLL_CTL_MOD, session->proc_cxt.MyProcPort->sock, &ev);
-    } else {
-        epoll_ctl(m_epollFd, EPOLL_CTL_ADD, session->proc_cxt.MyProcPort->sock, &ev);
-    }
+    epoll_ctl(m_epollFd, op, session->proc_cxt.MyProcPort->sock, &ev);
 }
 
 bool ThreadPoolListener::TryFeedWorker(ThreadPoolWorker* worker)
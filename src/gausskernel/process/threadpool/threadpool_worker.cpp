@@ -471,7 +471,20 @@ void ThreadPoolWorker::DetachSessionFromThread()
     m_currentSession->attachPid = (ThreadId)-1;
 
     /* should restore the data before return to listener. */
-    m_group->GetListener()->AddEpoll(m_currentSession);
+    ThreadPoolGroup* numaGroup = NULL;
+    int numaAffinity = m_currentSession->numa_affinity;
+    /* the affinity is set again by the next command that works on placed data */
+    m_currentSession->numa_affinity = -1;
+    if (numaAffinity >= 0 && numaAffinity != m_group->GetNumaId()) {
+        numaGroup = g_threadPoolControler->FindThreadGroupOnNuma(numaAffinity);
+    }
+    if (numaGroup != NULL) {
+        /* hand the session to a group on the NUMA node holding the data it works on */
+        m_group->GetListener()->DelSessionFromEpoll(m_currentSession);
+        numaGroup->GetListener()->TakeOverSession(m_currentSession);
+    } else {
+        m_group->GetListener()->AddEpoll(m_currentSession);
+    }
     m_currentSession = NULL;
     u_sess = NULL;
 }
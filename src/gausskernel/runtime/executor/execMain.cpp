@@ -75,6 +75,7 @@
 #endif
 #include "vecexecutor/vectorbatch.h"
 #include "vecexecutor/vecexecutor.h"
+#include "vecexecutor/vecnodevectorow.h"
 #include "utils/anls_opt.h"
 #include "utils/memprot.h"
 #include "utils/memtrack.h"
@@ -120,6 +121,9 @@ static void ExecutePlan(EState *estate, PlanState *planstate, CmdType operation,
 #endif
 static void ExecuteVectorizedPlan(EState *estate, PlanState *planstate, CmdType operation, bool sendTuples,
     long numberTuples, ScanDirection direction, DestReceiver *dest);
+static bool CanExecuteVecToRowPlan(EState *estate, PlanState *planstate, CmdType operation, long numberTuples,
+    ScanDirection direction, DestReceiver *dest);
+static void ExecuteVecToRowPlan(EState *estate, VecToRowState *planstate, DestReceiver *dest);
 static bool ExecCheckRTEPerms(RangeTblEntry *rte);
 static bool ExecCheckRTEPermsModified(Oid relOid, Oid userid, Bitmapset *modifiedCols, AclMode requiredPerms);
 void ExecCheckXactReadOnly(PlannedStmt *plannedstmt);
@@ -604,6 +608,9 @@ void standard_ExecutorRun(QueryDesc *queryDesc, ScanDirection direction, long co
     if (!ScanDirectionIsNoMovement(direction)) {
         if (queryDesc->planstate->vectorized) {
             ExecuteVectorizedPlan(estate, queryDesc->planstate, operation, send_tuples, count, direction, dest);
+        } else if (send_tuples &&
+            CanExecuteVecToRowPlan(estate, queryDesc->planstate, operation, count, direction, dest)) {
+            ExecuteVecToRowPlan(estate, (VecToRowState *)queryDesc->planstate, dest);
         } else {
 #ifdef ENABLE_MOT
             ExecutePlan(estate, queryDesc->planstate, operation, send_tuples,
@@ -2361,6 +2368,75 @@ static void ExecuteVectorizedPlan(EState *estate, PlanState *planstate, CmdType
     }
 }
 
+/*
+ * Check whether the result of a vectorized plan can be handed to the
+ * DestReceiver a whole batch at a time instead of through VecToRow one row
+ * at a time. This needs a receiver that takes row batches, a plain forward
+ * run to completion and nothing between the VecToRow node and the receiver.
+ * A run may start on a batch that earlier fetches of the portal have partly
+ * consumed, ExecVecToRowBatch hands out the rest of it first.
+ */
+static bool CanExecuteVecToRowPlan(EState *estate, PlanState *planstate, CmdType operation, long numberTuples,
+    ScanDirection direction, DestReceiver *dest)
+{
+    if (!u_sess->attr.attr_sql.enable_vector_output || dest->receiveRowBatch == NULL ||
+        dest->forAnalyzeSampleTuple) {
+        return false;
+    }
+
+    if (!IsA(planstate, VecToRowState) || operation != CMD_SELECT) {
+        return false;
+    }
+
+    /* a batch can't be split between fetches of a portal */
+    if (numberTuples != 0 || !ScanDirectionIsForward(direction)) {
+        return false;
+    }
+
+    return estate->es_junkFilter == NULL && estate->es_instrument == INSTRUMENT_NONE &&
+           !NeedSyncUpProducerStep(planstate->plan);
+}
+
+/* ----------------------------------------------------------------
+ * 		ExecuteVecToRowPlan
+ *
+ * 		Runs a plan topped by VecToRow to completion, sending each batch of
+ * 		the vectorized subplan to the DestReceiver as a whole.
+ * ----------------------------------------------------------------
+ */
+static void ExecuteVecToRowPlan(EState *estate, VecToRowState *planstate, DestReceiver *dest)
+{
+    TupleDesc typeinfo = planstate->ps.ps_ResultTupleSlot->tts_tupleDescriptor;
+    int rows;
+    int first_row = 0;
+
+    estate->es_direction = ForwardScanDirection;
+
+    if (IS_PGXC_DATANODE) {
+        /* Collect Material for Subplan first */
+        ExecCollectMaterialForSubplan(estate);
+    }
+
+    /* The receiver formats a whole batch in the per-tuple context */
+    dest->tmpContext = GetPerTupleMemoryContext(estate);
+
+    for (;;) {
+        ResetPerTupleExprContext(estate);
+
+        rows = ExecVecToRowBatch(planstate, &first_row);
+        if (rows == 0) {
+            break;
+        }
+
+        if (!u_sess->exec_cxt.executorStopFlag) {
+            (*dest->receiveRowBatch)(typeinfo, planstate->m_ttsvalues + first_row * planstate->nattrs,
+                planstate->m_ttsisnull + first_row * planstate->nattrs, rows, dest);
+        }
+
+        estate->es_processed += rows;
+    }
+}
+
 /*
  * ExecRelCheck --- check that tuple meets constraints for result relation
  */
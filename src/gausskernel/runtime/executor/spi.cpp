@@ -44,6 +44,10 @@
 #include "utils/syscache.h"
 #include "utils/typcache.h"
 #include "utils/elog.h"
+#ifdef ENABLE_MOT
+#include "parser/analyze.h"
+#include "storage/mot/jit_exec.h"
+#endif
 
 THR_LOCAL uint32 SPI_processed = 0;
 THR_LOCAL SPITupleTable *SPI_tuptable = NULL;
@@ -58,6 +62,12 @@ static void _SPI_pgxc_prepare_plan(const char *src, List *src_parsetree, SPIPlan
 
 static void _SPI_prepare_oneshot_plan(const char *src, SPIPlanPtr plan);
 
+#ifdef ENABLE_MOT
+static void _SPI_mot_jit_codegen(CachedPlanSource *plansource, List *stmt_list);
+static void _SPI_fetch_lazy_params(ParamListInfo paramLI);
+static int _SPI_mot_jit_pquery(PlannedStmt *stmt, ParamListInfo paramLI, JitExec::JitContext *mot_jit_context);
+#endif
+
 static int _SPI_execute_plan(SPIPlanPtr plan, ParamListInfo paramLI, Snapshot snapshot, Snapshot crosscheck_snapshot,
     bool read_only, bool fire_triggers, long tcount, bool from_lock = false);
 
@@ -2023,6 +2033,13 @@ static void _SPI_pgxc_prepare_plan(const char *src, List *src_parsetree, SPIPlan
             plan->parserSetupArg, plan->cursor_options, false, /* not fixed result */
             "");
 
+#ifdef ENABLE_MOT
+        /* statements of PL/pgSQL functions accessing MOT tables are jitted, if possible */
+        if (plan->parserSetup != NULL) {
+            _SPI_mot_jit_codegen(plansource, stmt_list);
+        }
+#endif
+
         if (enable_spi_gpc && plansource->gpc.status.IsSharePlan()) {
             /* for needRecompilePlan, plansource need recreate each time, no need to global it.
              * for temp table, only one session can use it, no need to global it */
@@ -2080,6 +2097,105 @@ static void SPIParseOneShotPlan(CachedPlanSource* plansource, SPIPlanPtr plan)
                        plan->parserSetupArg, plan->cursor_options, false, ""); /* not fixed result */
 }
 
+#ifdef ENABLE_MOT
+/*
+ * Try to generate MOT jitted code for a statement of a PL/pgSQL function.
+ *
+ * The jitted code is attached to the plan source and used by _SPI_execute_plan;
+ * statements that cannot be jitted are executed by the regular executor.
+ */
+static void _SPI_mot_jit_codegen(CachedPlanSource *plansource, List *stmt_list)
+{
+    StorageEngineType storageEngineType = SE_TYPE_UNSPECIFIED;
+    Oid func_oid = u_sess->SPI_cxt._current->func_oid;
+    Query *query = NULL;
+
+    if (IS_PGXC_COORDINATOR || func_oid == InvalidOid || list_length(stmt_list) != 1) {
+        return;
+    }
+
+    query = (Query *)linitial(stmt_list);
+    if (query->commandType == CMD_UTILITY) {
+        return;
+    }
+    CheckTablesStorageEngine(query, &storageEngineType);
+    if (storageEngineType != SE_TYPE_MOT) {
+        return;
+    }
+    plansource->storageEngineType = storageEngineType;
+
+    if (!JitExec::IsMotCodegenEnabled()) {
+        return;
+    }
+
+    if (JitExec::IsMotCodegenPrintEnabled()) {
+        elog(LOG, "Attempting to generate MOT jitted code for function %u query: %s\n", func_oid,
+            plansource->query_string);
+    }
+
+    plansource->mot_jit_context = JitExec::JitCodegenFunctionQuery(query, plansource->query_string, func_oid);
+    if (plansource->mot_jit_context == NULL) {
+        if (JitExec::IsMotCodegenPrintEnabled()) {
+            elog(LOG, "Failed to generate jitted MOT function for query %s\n", plansource->query_string);
+        }
+    } else if (plansource->gpc.status.IsSharePlan()) {
+        /* JIT contexts belong to the session, so the plan cannot be shared */
+        plansource->gpc.status.SetKind(GPC_UNSHARED);
+    }
+}
+
+/*
+ * Fetch all the parameter values that PL/pgSQL provides lazily through the
+ * paramFetch hook, so that jitted code can access them directly.
+ */
+static void _SPI_fetch_lazy_params(ParamListInfo paramLI)
+{
+    if (paramLI == NULL || paramLI->paramFetch == NULL) {
+        return;
+    }
+
+    for (int i = 0; i < paramLI->numParams; i++) {
+        if (!OidIsValid(paramLI->params[i].ptype)) {
+            (*paramLI->paramFetch)(paramLI, i + 1);
+        }
+    }
+}
+
+/*
+ * Execute a jitted INSERT, UPDATE or DELETE of a PL/pgSQL function.
+ *
+ * Like top-level jitted DML, the statement runs without the executor; the number
+ * of affected rows is passed back through SPI_processed. Errors are reported by
+ * the jitted code.
+ */
+static int _SPI_mot_jit_pquery(PlannedStmt *stmt, ParamListInfo paramLI, JitExec::JitContext *mot_jit_context)
+{
+    uint64 tuplesProcessed = 0;
+    int scanEnded = 0;
+    int res;
+
+    switch (stmt->commandType) {
+        case CMD_INSERT:
+            res = SPI_OK_INSERT;
+            break;
+        case CMD_UPDATE:
+            res = SPI_OK_UPDATE;
+            break;
+        case CMD_DELETE:
+            res = SPI_OK_DELETE;
+            break;
+        default:
+            return SPI_ERROR_OPUNKNOWN;
+    }
+
+    (void)JitExec::JitExecQuery(mot_jit_context, paramLI, NULL, &tuplesProcessed, &scanEnded);
+
+    u_sess->SPI_cxt._current->processed = tuplesProcessed;
+    u_sess->SPI_cxt._current->lastoid = InvalidOid;
+    return res;
+}
+#endif
+
 /*
  * Parse, but don't analyze, a querystring.
  *
@@ -2333,10 +2449,32 @@ static int _SPI_execute_plan(SPIPlanPtr plan, ParamListInfo paramLI, Snapshot sn
                     snap = InvalidSnapshot;
                 }
 
+#ifdef ENABLE_MOT
+                JitExec::JitContext *mot_jit_context = NULL;
+                if (cplan->storageEngineType == SE_TYPE_MOT && u_sess->SPI_cxt._current->func_oid != InvalidOid) {
+                    if (cplan->mot_jit_context != NULL && !IS_PGXC_COORDINATOR && JitExec::IsMotCodegenEnabled()) {
+                        /* jitted code reads parameter values directly, so they must all be in place */
+                        _SPI_fetch_lazy_params(paramLI);
+                        mot_jit_context = cplan->mot_jit_context;
+                        /* a jitted scan continues from its last iteration, so each execution must start a new one */
+                        JitExec::JitResetScan(mot_jit_context);
+                    }
+                    JitExec::JitReportFunctionQueryExec(u_sess->SPI_cxt._current->func_oid, mot_jit_context != NULL);
+                }
+                if (mot_jit_context != NULL && ((PlannedStmt *)stmt)->commandType != CMD_SELECT) {
+                    res = _SPI_mot_jit_pquery((PlannedStmt *)stmt, paramLI, mot_jit_context);
+                } else {
+                    qdesc = CreateQueryDesc((PlannedStmt *)stmt, plansource->query_string, snap, crosscheck_snapshot,
+                        dest, paramLI, 0, mot_jit_context);
+                    res = _SPI_pquery(qdesc, fire_triggers, canSetTag ? tcount : 0, from_lock);
+                    FreeQueryDesc(qdesc);
+                }
+#else
                 qdesc = CreateQueryDesc((PlannedStmt *)stmt, plansource->query_string, snap, crosscheck_snapshot, dest,
                     paramLI, 0);
                 res = _SPI_pquery(qdesc, fire_triggers, canSetTag ? tcount : 0, from_lock);
                 FreeQueryDesc(qdesc);
+#endif
             } else {
                 char completionTag[COMPLETION_TAG_BUFSIZE];
 
@@ -175,6 +175,38 @@ TupleTableSlot* ExecVecToRow(VecToRowState* state) /* return: a tuple or NULL */
     return tuple;
 }
 
+/*
+ * Devectorize the next batch as a whole for a consumer taking rows a batch at
+ * a time, see ExecuteVecToRowPlan. The rows are left in m_ttsvalues/m_ttsisnull
+ * starting at row *first_row and stay valid until the next call. Returns the
+ * number of rows, 0 at end.
+ */
+int ExecVecToRowBatch(VecToRowState* state, int* first_row)
+{
+    VectorBatch* current_batch = state->m_pCurrentBatch;
+    int rows;
+
+    if (BatchIsNull(current_batch)) {
+        current_batch = VectorEngine(outerPlanState(state));
+        if (BatchIsNull(current_batch))
+            return 0;
+
+        state->m_pCurrentBatch = current_batch;
+        state->m_currentRow = 0;
+        DevectorizeOneBatch(state);
+    }
+
+    // an earlier fetch through ExecVecToRow may have taken part of the batch
+    *first_row = state->m_currentRow;
+    rows = current_batch->m_rows - state->m_currentRow;
+
+    // the rest of the batch is handed out at once
+    current_batch->m_rows = 0;
+    state->m_currentRow = 0;
+
+    return rows;
+}
+
 void RecordCstorePartNum(VecToRowState* state, const VecToRow* node)
 {
     // record partition num.If there is no partition table, it is set to 0
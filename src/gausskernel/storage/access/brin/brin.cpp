@@ -0,0 +1,1015 @@
+/* -------------------------------------------------------------------------
+ *
+ * brin.cpp
+ *	  Implementation of the block range index (BRIN) access method.
+ *
+ * A BRIN index keeps one summary tuple per range of pagesPerRange heap
+ * blocks.  What the summary holds is up to the opclass: the minimum and
+ * maximum value for the minmax opclasses, a bloom filter for the bloom ones.
+ * A bitmap scan returns all blocks of every range whose summary is consistent
+ * with the scan keys, as lossy bitmap pages, and the heap scan rechecks them.
+ *
+ * Ranges are summarized by the index build, by vacuum (complete ranges only)
+ * and by brin_summarize_new_values(); with autosummarize set, the first insert
+ * into a range asks autovacuum to summarize the range before it.  Until a
+ * range is summarized it matches every scan.  Once it is, inserts widen its
+ * summary as needed; deletes never narrow it, so a range that lost its
+ * extreme values keeps matching them until the index is rebuilt.
+ *
+ * Portions Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ *
+ * IDENTIFICATION
+ *	  src/gausskernel/storage/access/brin/brin.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+#include "postgres.h"
+#include "knl/knl_variable.h"
+
+#include "access/brin_private.h"
+#include "access/heapam.h"
+#include "access/reloptions.h"
+#include "access/relscan.h"
+#include "access/tableam.h"
+#include "access/xlog.h"
+#include "catalog/index.h"
+#include "catalog/pg_am.h"
+#include "executor/executor.h"
+#include "miscadmin.h"
+#include "nodes/tidbitmap.h"
+#include "postmaster/autovacuum.h"
+#include "storage/procarray.h"
+#include "utils/acl.h"
+#include "utils/builtins.h"
+#include "utils/datum.h"
+#include "utils/memutils.h"
+#include "utils/rel.h"
+#include "utils/rel_gs.h"
+
+/* pageRange of brin_summarize_ranges asking for all ranges */
+#define BRIN_ALL_BLOCKRANGES InvalidBlockNumber
+
+/*
+ * State of a build or of a summarization of one or more ranges.
+ */
+typedef struct BrinBuildState {
+    Relation bs_irel;
+    int bs_numtuples;
+    BlockNumber bs_pagesPerRange;
+    BlockNumber bs_currRangeStart;
+    BrinRevmap *bs_rmAccess;
+    BrinDesc *bs_bdesc;
+    BrinMemTuple *bs_dtuple;
+} BrinBuildState;
+
+/*
+ * Private state of an index scan.
+ */
+typedef struct BrinOpaque {
+    BlockNumber bo_pagesPerRange;
+    BrinRevmap *bo_rmAccess;
+    BrinDesc *bo_bdesc;
+} BrinOpaque;
+
+/*
+ * Build the descriptor of a BRIN index: the opclass info of each column and
+ * the tuple descriptor of the on-disk summaries.  It lives in a context of its
+ * own, which brin_free_desc deletes.
+ */
+BrinDesc *brin_build_desc(Relation rel)
+{
+    TupleDesc tupdesc = RelationGetDescr(rel);
+    MemoryContext cxt;
+    MemoryContext oldcxt;
+    BrinOpcInfo **opcinfo = NULL;
+    BrinDesc *bdesc = NULL;
+    int totalstored = 0;
+    int attno = 1;
+
+    cxt = AllocSetContextCreate(CurrentMemoryContext, "brin desc", ALLOCSET_SMALL_MINSIZE, ALLOCSET_SMALL_INITSIZE,
+                                ALLOCSET_SMALL_MAXSIZE);
+    oldcxt = MemoryContextSwitchTo(cxt);
+
+    opcinfo = (BrinOpcInfo **)palloc(sizeof(BrinOpcInfo *) * tupdesc->natts);
+    for (int keyno = 0; keyno < tupdesc->natts; keyno++) {
+        FmgrInfo *opcInfoFn = index_getprocinfo(rel, keyno + 1, BRIN_PROCNUM_OPCINFO);
+
+        opcinfo[keyno] = (BrinOpcInfo *)DatumGetPointer(
+            FunctionCall1(opcInfoFn, ObjectIdGetDatum(tupdesc->attrs[keyno]->atttypid)));
+        totalstored += opcinfo[keyno]->oi_nstored;
+    }
+
+    bdesc = (BrinDesc *)palloc(offsetof(BrinDesc, bd_info) + sizeof(BrinOpcInfo *) * tupdesc->natts);
+    bdesc->bd_context = cxt;
+    bdesc->bd_index = rel;
+    bdesc->bd_tupdesc = tupdesc;
+    bdesc->bd_totalstored = totalstored;
+
+    /* each column stores its allnulls and hasnulls flags, then its values */
+    bdesc->bd_disktdesc = CreateTemplateTupleDesc(tupdesc->natts * 2 + totalstored, false);
+    for (int keyno = 0; keyno < tupdesc->natts; keyno++) {
+        bdesc->bd_info[keyno] = opcinfo[keyno];
+
+        TupleDescInitEntry(bdesc->bd_disktdesc, attno++, NULL, BOOLOID, -1, 0);
+        TupleDescInitEntry(bdesc->bd_disktdesc, attno++, NULL, BOOLOID, -1, 0);
+        for (int i = 0; i < opcinfo[keyno]->oi_nstored; i++)
+            TupleDescInitEntry(bdesc->bd_disktdesc, attno++, NULL, opcinfo[keyno]->oi_typcache[i]->type_id, -1, 0);
+    }
+    pfree(opcinfo);
+
+    (void)MemoryContextSwitchTo(oldcxt);
+    return bdesc;
+}
+
+void brin_free_desc(BrinDesc *bdesc)
+{
+    MemoryContextDelete(bdesc->bd_context);
+}
+
+/*
+ * Add the values of one heap tuple to an in-memory summary.  Returns true if
+ * the summary changed.
+ */
+bool brin_add_values(BrinDesc *bdesc, BrinMemTuple *dtup, const Datum *values, const bool *nulls)
+{
+    Relation idxRel = bdesc->bd_index;
+    MemoryContext oldcxt = MemoryContextSwitchTo(dtup->bt_context);
+    bool modified = false;
+
+    for (int keyno = 0; keyno < bdesc->bd_tupdesc->natts; keyno++) {
+        BrinValues *column = &dtup->bt_columns[keyno];
+        FmgrInfo *addValue = NULL;
+
+        if (nulls[keyno]) {
+            if (!column->bv_hasnulls) {
+                column->bv_hasnulls = true;
+                modified = true;
+            }
+            continue;
+        }
+
+        addValue = index_getprocinfo(idxRel, keyno + 1, BRIN_PROCNUM_ADDVALUE);
+        modified |= DatumGetBool(FunctionCall3Coll(addValue, idxRel->rd_indcollation[keyno], PointerGetDatum(bdesc),
+                                                   PointerGetDatum(column), values[keyno]));
+    }
+
+    (void)MemoryContextSwitchTo(oldcxt);
+    return modified;
+}
+
+/*
+ * Widen summary a to also cover summary b.
+ */
+void brin_union_tuples(BrinDesc *bdesc, BrinMemTuple *a, BrinMemTuple *b)
+{
+    Relation idxRel = bdesc->bd_index;
+    MemoryContext oldcxt = MemoryContextSwitchTo(a->bt_context);
+
+    for (int keyno = 0; keyno < bdesc->bd_tupdesc->natts; keyno++) {
+        BrinValues *col_a = &a->bt_columns[keyno];
+        BrinValues *col_b = &b->bt_columns[keyno];
+        BrinOpcInfo *opcinfo = bdesc->bd_info[keyno];
+        FmgrInfo *unionFn = NULL;
+
+        if (col_b->bv_hasnulls)
+            col_a->bv_hasnulls = true;
+
+        if (col_b->bv_allnulls)
+            continue;
+
+        if (col_a->bv_allnulls) {
+            for (int i = 0; i < opcinfo->oi_nstored; i++)
+                col_a->bv_values[i] = datumCopy(col_b->bv_values[i], opcinfo->oi_typcache[i]->typbyval,
+                                                opcinfo->oi_typcache[i]->typlen);
+            col_a->bv_allnulls = false;
+            continue;
+        }
+
+        unionFn = index_getprocinfo(idxRel, keyno + 1, BRIN_PROCNUM_UNION);
+        (void)FunctionCall3Coll(unionFn, idxRel->rd_indcollation[keyno], PointerGetDatum(bdesc),
+                                PointerGetDatum(col_a), PointerGetDatum(col_b));
+    }
+
+    (void)MemoryContextSwitchTo(oldcxt);
+}
+
+/*
+ * Can a range with the given summary hold tuples satisfying all scan keys?
+ */
+static bool brin_range_consistent(BrinDesc *bdesc, BrinMemTuple *dtup, ScanKey keys, int nkeys)
+{
+    Relation idxRel = bdesc->bd_index;
+
+    for (int keyno = 0; keyno < nkeys; keyno++) {
+        ScanKey key = &keys[keyno];
+        BrinValues *column = &dtup->bt_columns[key->sk_attno - 1];
+        FmgrInfo *consistentFn = NULL;
+
+        if (key->sk_flags & SK_ISNULL) {
+            if (key->sk_flags & SK_SEARCHNULL) {
+                if (!column->bv_hasnulls)
+                    return false;
+            } else if (key->sk_flags & SK_SEARCHNOTNULL) {
+                if (column->bv_allnulls)
+                    return false;
+            } else {
+                /* an ordinary comparison with a null never matches */
+                return false;
+            }
+            continue;
+        }
+
+        if (column->bv_allnulls)
+            return false;
+
+        consistentFn = index_getprocinfo(idxRel, key->sk_attno, BRIN_PROCNUM_CONSISTENT);
+        if (!DatumGetBool(FunctionCall3Coll(consistentFn, key->sk_collation, PointerGetDatum(bdesc),
+                                            PointerGetDatum(column), PointerGetDatum(key))))
+            return false;
+    }
+
+    return true;
+}
+
+static BrinBuildState *initialize_brin_buildstate(Relation idxRel, BrinRevmap *revmap, BlockNumber pagesPerRange)
+{
+    BrinBuildState *state = (BrinBuildState *)palloc(sizeof(BrinBuildState));
+
+    state->bs_irel = idxRel;
+    state->bs_numtuples = 0;
+    state->bs_pagesPerRange = pagesPerRange;
+    state->bs_currRangeStart = 0;
+    state->bs_rmAccess = revmap;
+    state->bs_bdesc = brin_build_desc(idxRel);
+    state->bs_dtuple = brin_new_memtuple(state->bs_bdesc);
+
+    return state;
+}
+
+static void terminate_brin_buildstate(BrinBuildState *state)
+{
+    brin_free_memtuple(state->bs_dtuple);
+    brin_free_desc(state->bs_bdesc);
+    pfree(state);
+}
+
+/*
+ * Insert the summary of the current range, during an index build.
+ */
+static void form_and_insert_tuple(BrinBuildState *state)
+{
+    BrinTuple *tup = NULL;
+    Size size;
+
+    tup = brin_form_tuple(state->bs_bdesc, state->bs_currRangeStart, state->bs_dtuple, &size);
+    (void)brin_doinsert(state->bs_irel, state->bs_pagesPerRange, state->bs_rmAccess, state->bs_currRangeStart, tup,
+                        size);
+    state->bs_numtuples++;
+    pfree(tup);
+}
+
+/*
+ * Heap scan callback of the index build.  The scan is done in physical order,
+ * so a tuple beyond the current range means that range is complete; ranges
+ * without any tuples get an empty summary.
+ */
+static void brinbuildCallback(Relation index, HeapTuple htup, Datum *values, const bool *isnull, bool tupleIsAlive,
+                              void *brstate)
+{
+    BrinBuildState *state = (BrinBuildState *)brstate;
+    BlockNumber thisblock = ItemPointerGetBlockNumber(&htup->t_self);
+
+    while (thisblock >= state->bs_currRangeStart + state->bs_pagesPerRange) {
+        form_and_insert_tuple(state);
+        state->bs_currRangeStart += state->bs_pagesPerRange;
+        brin_memtuple_initialize(state->bs_dtuple, state->bs_bdesc);
+    }
+
+    (void)brin_add_values(state->bs_bdesc, state->bs_dtuple, values, isnull);
+}
+
+/*
+ * Add the index values of the live and recently dead tuples of a range of
+ * heap blocks to state->bs_dtuple.  Each page is share-locked only while its
+ * tuples are copied out.
+ */
+static void brin_scan_range(BrinBuildState *state, Relation heapRel, IndexInfo *indexInfo, BlockNumber startBlk,
+                            BlockNumber numBlks)
+{
+    TupleDesc heapDesc = RelationGetDescr(heapRel);
+    EState *estate = CreateExecutorState();
+    ExprContext *econtext = GetPerTupleExprContext(estate);
+    TupleTableSlot *slot = MakeSingleTupleTableSlot(heapDesc);
+    TransactionId OldestXmin = GetOldestXmin(heapRel);
+    HeapTuple *tuples = (HeapTuple *)palloc(sizeof(HeapTuple) * MaxHeapTuplesPerPage);
+    Datum values[INDEX_MAX_KEYS];
+    bool isnull[INDEX_MAX_KEYS];
+    List *predicate = NIL;
+
+    econtext->ecxt_scantuple = slot;
+    predicate = (List *)ExecPrepareExpr((Expr *)indexInfo->ii_Predicate, estate);
+
+    for (BlockNumber blkno = startBlk; blkno < startBlk + numBlks; blkno++) {
+        Buffer buf;
+        Page page;
+        OffsetNumber maxoff;
+        int ntuples = 0;
+
+        CHECK_FOR_INTERRUPTS();
+
+        buf = ReadBuffer(heapRel, blkno);
+        LockBuffer(buf, BUFFER_LOCK_SHARE);
+        page = BufferGetPage(buf);
+        maxoff = PageIsNew(page) ? InvalidOffsetNumber : PageGetMaxOffsetNumber(page);
+
+        for (OffsetNumber off = FirstOffsetNumber; off <= maxoff; off++) {
+            ItemId lp = PageGetItemId(page, off);
+            HeapTupleData tuple;
+            errno_t rc;
+
+            if (!ItemIdIsNormal(lp))
+                continue;
+
+            rc = memset_s(&tuple, sizeof(HeapTupleData), 0, sizeof(HeapTupleData));
+            securec_check(rc, "", "");
+            tuple.t_data = (HeapTupleHeader)PageGetItem(page, lp);
+            tuple.t_len = ItemIdGetLength(lp);
+            tuple.t_tableOid = RelationGetRelid(heapRel);
+            tuple.t_bucketId = RelationGetBktid(heapRel);
+            HeapTupleCopyBaseFromPage(&tuple, page);
+            ItemPointerSet(&tuple.t_self, blkno, off);
+
+            /* like an index build, keep everything somebody may still see */
+            if (HeapTupleSatisfiesVacuum(&tuple, OldestXmin, buf) == HEAPTUPLE_DEAD)
+                continue;
+
+            tuples[ntuples++] = heapCopyTuple(&tuple, heapDesc, page);
+        }
+        UnlockReleaseBuffer(buf);
+
+        for (int i = 0; i < ntuples; i++) {
+            MemoryContextReset(econtext->ecxt_per_tuple_memory);
+            (void)ExecStoreTuple(tuples[i], slot, InvalidBuffer, false);
+
+            if (predicate == NIL || ExecQual(predicate, econtext, false)) {
+                FormIndexDatum(indexInfo, slot, estate, values, isnull);
+                (void)brin_add_values(state->bs_bdesc, state->bs_dtuple, values, isnull);
+            }
+
+            (void)ExecClearTuple(slot);
+            heap_freetuple(tuples[i]);
+        }
+    }
+
+    pfree(tuples);
+    ExecDropSingleTupleTableSlot(slot);
+    FreeExecutorState(estate);
+}
+
+/*
+ * Summarize the range starting at heapBlk of a heap with heapNumBlks blocks.
+ *
+ * Unless the caller found a placeholder for the range already, one is
+ * inserted first, so that concurrent inserts into the range add their values
+ * to it rather than being missed; if somebody else summarized the range
+ * meanwhile, we return false.  Then the heap range is scanned, and the
+ * placeholder is replaced by the result merged with whatever the placeholder
+ * holds by then.
+ */
+static bool summarize_range(IndexInfo *indexInfo, BrinBuildState *state, Relation heapRel, BlockNumber heapBlk,
+                            BlockNumber heapNumBlks, bool havePlaceholder)
+{
+    Relation idxRel = state->bs_irel;
+    BrinDesc *bdesc = state->bs_bdesc;
+    BrinRevmap *revmap = state->bs_rmAccess;
+    BlockNumber pagesPerRange = state->bs_pagesPerRange;
+    Buffer phbuf = InvalidBuffer;
+
+    if (!havePlaceholder) {
+        Size phsz;
+        BrinTuple *phtup = brin_form_placeholder_tuple(bdesc, heapBlk, &phsz);
+        bool inserted = brin_doinsert(idxRel, pagesPerRange, revmap, heapBlk, phtup, phsz);
+
+        pfree(phtup);
+        if (!inserted)
+            return false;
+    }
+
+    state->bs_currRangeStart = heapBlk;
+    brin_memtuple_initialize(state->bs_dtuple, bdesc);
+    brin_scan_range(state, heapRel, indexInfo, heapBlk, Min(pagesPerRange, heapNumBlks - heapBlk));
+
+    for (;;) {
+        BrinTuple *phtup = NULL;
+        BrinTuple *newtup = NULL;
+        BrinMemTuple *phdtup = NULL;
+        OffsetNumber off;
+        Size phsz;
+        Size newsz;
+        bool samepage = false;
+        bool done = false;
+
+        CHECK_FOR_INTERRUPTS();
+
+        phtup = brinGetTupleForHeapBlock(revmap, heapBlk, &phbuf, &off, &phsz, BUFFER_LOCK_SHARE);
+        if (phtup == NULL)
+            ereport(ERROR, (errcode(ERRCODE_INDEX_CORRUPTED),
+                            errmsg("missing placeholder tuple for heap block %u in BRIN index \"%s\"", heapBlk,
+                                   RelationGetRelationName(idxRel))));
+        phtup = brin_copy_tuple(phtup, phsz);
+        LockBuffer(phbuf, BUFFER_LOCK_UNLOCK);
+
+        phdtup = brin_deform_tuple(bdesc, phtup, phsz);
+        brin_union_tuples(bdesc, state->bs_dtuple, phdtup);
+        brin_free_memtuple(phdtup);
+
+        newtup = brin_form_tuple(bdesc, heapBlk, state->bs_dtuple, &newsz);
+        samepage = brin_can_do_samepage_update(phbuf, phsz, newsz);
+        done = brin_doupdate(idxRel, pagesPerRange, revmap, heapBlk, phbuf, off, phtup, phsz, newtup, newsz,
+                             samepage);
+        pfree(phtup);
+        pfree(newtup);
+        if (done)
+            break;
+    }
+
+    ReleaseBuffer(phbuf);
+    return true;
+}
+
+/*
+ * Summarize every range of the heap that has no summary yet, or only a
+ * placeholder left behind by a summarization that did not finish; or only
+ * the range of pageRange, unless it is BRIN_ALL_BLOCKRANGES.  The last range
+ * is skipped if it is incomplete, unless includePartial is set.  Returns the
+ * number of ranges summarized.
+ */
+static double brin_summarize_ranges(Relation idxRel, Relation heapRel, BlockNumber pageRange, bool includePartial)
+{
+    BlockNumber pagesPerRange;
+    BrinRevmap *revmap = brinRevmapInitialize(idxRel, &pagesPerRange, true);
+    BlockNumber heapNumBlocks = RelationGetNumberOfBlocks(heapRel);
+    BlockNumber firstBlk = 0;
+    BlockNumber endBlk = heapNumBlocks;
+    BrinBuildState *state = NULL;
+    IndexInfo *indexInfo = NULL;
+    Buffer buf = InvalidBuffer;
+    double numSummarized = 0;
+
+    if (pageRange != BRIN_ALL_BLOCKRANGES) {
+        firstBlk = (pageRange / pagesPerRange) * pagesPerRange;
+        endBlk = Min(heapNumBlocks, firstBlk + 1);
+    }
+
+    for (BlockNumber startBlk = firstBlk; startBlk < endBlk; startBlk += pagesPerRange) {
+        BrinTuple *tup = NULL;
+        OffsetNumber off;
+        bool placeholder = false;
+
+        CHECK_FOR_INTERRUPTS();
+
+        if (!includePartial && heapNumBlocks - startBlk < pagesPerRange)
+            break;
+
+        tup = brinGetTupleForHeapBlock(revmap, startBlk, &buf, &off, NULL, BUFFER_LOCK_SHARE);
+        if (tup != NULL) {
+            placeholder = BrinTupleIsPlaceholder(tup);
+            LockBuffer(buf, BUFFER_LOCK_UNLOCK);
+            if (!placeholder)
+                continue;
+        }
+
+        if (state == NULL) {
+            indexInfo = BuildIndexInfo(idxRel);
+            state = initialize_brin_buildstate(idxRel, revmap, pagesPerRange);
+        }
+        if (summarize_range(indexInfo, state, heapRel, startBlk, heapNumBlocks, placeholder))
+            numSummarized++;
+    }
+
+    if (BufferIsValid(buf))
+        ReleaseBuffer(buf);
+    if (state != NULL) {
+        terminate_brin_buildstate(state);
+        pfree(indexInfo);
+    }
+    brinRevmapTerminate(revmap);
+
+    return numSummarized;
+}
+
+/*
+ * Open the heap of a BRIN index.  BRIN is not supported on partitioned
+ * tables, so this is always the relation named in pg_index.
+ */
+static Relation brin_open_heap(Relation idxRel, LOCKMODE lockmode)
+{
+    return heap_open(IndexGetRelation(RelationGetRelid(idxRel), false), lockmode);
+}
+
+void brinGetStats(Relation index, BrinStatsData *stats)
+{
+    Buffer metabuffer = ReadBuffer(index, BRIN_METAPAGE_BLKNO);
+    Page metapage;
+
+    LockBuffer(metabuffer, BUFFER_LOCK_SHARE);
+    metapage = BufferGetPage(metabuffer);
+    if (!PageIsNew(metapage) && BRIN_IS_META_PAGE(metapage))
+        stats->pagesPerRange = BrinPageGetMeta(metapage)->pagesPerRange;
+    else
+        stats->pagesPerRange = BrinGetPagesPerRange(index);
+    UnlockReleaseBuffer(metabuffer);
+}
+
+Datum brinbuild(PG_FUNCTION_ARGS)
+{
+    Relation heap = (Relation)PG_GETARG_POINTER(0);
+    Relation index = (Relation)PG_GETARG_POINTER(1);
+    IndexInfo *indexInfo = (IndexInfo *)PG_GETARG_POINTER(2);
+
+    if (heap == NULL || index == NULL || indexInfo == NULL)
+        ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE), errmsg("Invalid arguments for function brinbuild")));
+
+    IndexBuildResult *result = NULL;
+    BrinBuildState *state = NULL;
+    BrinRevmap *revmap = NULL;
+    BlockNumber pagesPerRange;
+    BlockNumber heapNumBlocks;
+    Buffer meta;
+    double reltuples;
+
+    if (RelationIsPartition(index) || RelationIsGlobalIndex(index) || RELATION_IS_PARTITIONED(heap))
+        ereport(ERROR, (errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+                        errmsg("BRIN indexes are not supported on partitioned tables")));
+    if (heap->rd_tam_type != TAM_HEAP)
+        ereport(ERROR, (errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+                        errmsg("BRIN indexes are only supported on astore tables")));
+    if (RelationGetNumberOfBlocks(index) != 0)
+        ereport(ERROR, (errcode(ERRCODE_INDEX_CORRUPTED),
+                        errmsg("index \"%s\" already contains data", RelationGetRelationName(index))));
+
+    meta = brin_extend_relation(index);
+    Assert(BufferGetBlockNumber(meta) == BRIN_METAPAGE_BLKNO);
+    START_CRIT_SECTION();
+    brin_metapage_init(BufferGetPage(meta), BrinGetPagesPerRange(index));
+    MarkBufferDirty(meta);
+    END_CRIT_SECTION();
+    UnlockReleaseBuffer(meta);
+
+    /* nobody else can see the index yet, so log it as a whole at the end */
+    revmap = brinRevmapInitialize(index, &pagesPerRange, false);
+    state = initialize_brin_buildstate(index, revmap, pagesPerRange);
+
+    /* the callback relies on physical order, so no syncscan */
+    reltuples = tableam_index_build_scan(heap, index, indexInfo, false, brinbuildCallback, (void *)state);
+
+    /* the last range with tuples, then empty summaries up to the end */
+    heapNumBlocks = RelationGetNumberOfBlocks(heap);
+    do {
+        form_and_insert_tuple(state);
+        state->bs_currRangeStart += pagesPerRange;
+        brin_memtuple_initialize(state->bs_dtuple, state->bs_bdesc);
+    } while (state->bs_currRangeStart < heapNumBlocks);
+
+    result = (IndexBuildResult *)palloc(sizeof(IndexBuildResult));
+    result->heap_tuples = reltuples;
+    result->index_tuples = state->bs_numtuples;
+
+    terminate_brin_buildstate(state);
+    brinRevmapTerminate(revmap);
+    brin_log_newpages(index);
+
+    PG_RETURN_POINTER(result);
+}
+
+Datum brinbuildempty(PG_FUNCTION_ARGS)
+{
+    Relation index = (Relation)PG_GETARG_POINTER(0);
+    if (index == NULL)
+        ereport(ERROR,
+                (errcode(ERRCODE_INVALID_PARAMETER_VALUE), errmsg("Invalid arguments for function brinbuildempty")));
+
+    Buffer metabuf;
+
+    /* An empty BRIN index has just the metapage. */
+    metabuf = ReadBufferExtended(index, INIT_FORKNUM, P_NEW, RBM_NORMAL, NULL);
+    LockBuffer(metabuf, BUFFER_LOCK_EXCLUSIVE);
+
+    START_CRIT_SECTION();
+    brin_metapage_init(BufferGetPage(metabuf), BrinGetPagesPerRange(index));
+    MarkBufferDirty(metabuf);
+    log_newpage_buffer(metabuf, true);
+    END_CRIT_SECTION();
+
+    UnlockReleaseBuffer(metabuf);
+
+    PG_RETURN_VOID();
+}
+
+/*
+ * Widen the summary of the new tuple's range, if the range is summarized.
+ * When autosummarize is on, the first insert into a range also asks
+ * autovacuum to summarize the range before it, which is likely complete by
+ * then; doing it here would make the insert scan the whole range.
+ */
+Datum brininsert(PG_FUNCTION_ARGS)
+{
+    Relation idxRel = (Relation)PG_GETARG_POINTER(0);
+    Datum *values = (Datum *)PG_GETARG_POINTER(1);
+    bool *nulls = (bool *)PG_GETARG_POINTER(2);
+    ItemPointer heaptid = (ItemPointer)PG_GETARG_POINTER(3);
+
+    if (idxRel == NULL || values == NULL || nulls == NULL || heaptid == NULL)
+        ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE), errmsg("Invalid arguments for function brininsert")));
+
+    BlockNumber heapBlk = ItemPointerGetBlockNumber(heaptid);
+    BlockNumber pagesPerRange;
+    BrinRevmap *revmap = NULL;
+    BrinDesc *bdesc = NULL;
+    Buffer buf = InvalidBuffer;
+    MemoryContext tupcxt;
+    MemoryContext oldcxt;
+
+    tupcxt = AllocSetContextCreate(CurrentMemoryContext, "brininsert cxt", ALLOCSET_DEFAULT_MINSIZE,
+                                   ALLOCSET_DEFAULT_INITSIZE, ALLOCSET_DEFAULT_MAXSIZE);
+    oldcxt = MemoryContextSwitchTo(tupcxt);
+
+    revmap = brinRevmapInitialize(idxRel, &pagesPerRange, true);
+
+    if (BrinGetAutoSummarize(idxRel) && heapBlk > 0 && heapBlk % pagesPerRange == 0 &&
+        ItemPointerGetOffsetNumber(heaptid) == FirstOffsetNumber) {
+        BlockNumber lastRange = heapBlk - pagesPerRange;
+        ItemPointerData tid;
+
+        if (!brinRevmapGetTid(revmap, lastRange, &tid) &&
+            !AutoVacuumRequestWork(AVW_BRINSummarizeRange, RelationGetRelid(idxRel), lastRange))
+            ereport(LOG, (errcode(ERRCODE_PROGRAM_LIMIT_EXCEEDED),
+                          errmsg("request for BRIN range summarization for index \"%s\" page %u was not recorded",
+                                 RelationGetRelationName(idxRel), lastRange)));
+    }
+
+    heapBlk = (heapBlk / pagesPerRange) * pagesPerRange;
+    for (;;) {
+        BrinTuple *brtup = NULL;
+        BrinTuple *origtup = NULL;
+        BrinTuple *newtup = NULL;
+        BrinMemTuple *dtup = NULL;
+        OffsetNumber off;
+        Size origsz;
+        Size newsz;
+        bool samepage = false;
+
+        CHECK_FOR_INTERRUPTS();
+
+        brtup = brinGetTupleForHeapBlock(revmap, heapBlk, &buf, &off, &origsz, BUFFER_LOCK_SHARE);
+
+        /* an unsummarized range matches everything already */
+        if (brtup == NULL)
+            break;
+
+        if (bdesc == NULL)
+            bdesc = brin_build_desc(idxRel);
+
+        dtup = brin_deform_tuple(bdesc, brtup, origsz);
+        if (!brin_add_values(bdesc, dtup, values, nulls)) {
+            LockBuffer(buf, BUFFER_LOCK_UNLOCK);
+            break;
+        }
+
+        origtup = brin_copy_tuple(brtup, origsz);
+        LockBuffer(buf, BUFFER_LOCK_UNLOCK);
+
+        newtup = brin_form_tuple(bdesc, heapBlk, dtup, &newsz);
+        samepage = brin_can_do_samepage_update(buf, origsz, newsz);
+        if (brin_doupdate(idxRel, pagesPerRange, revmap, heapBlk, buf, off, origtup, origsz, newtup, newsz, samepage))
+            break;
+
+        /* somebody changed the summary under us; start over */
+        brin_free_memtuple(dtup);
+        pfree(origtup);
+        pfree(newtup);
+    }
+
+    if (BufferIsValid(buf))
+        ReleaseBuffer(buf);
+    brinRevmapTerminate(revmap);
+
+    (void)MemoryContextSwitchTo(oldcxt);
+    MemoryContextDelete(tupcxt);
+
+    PG_RETURN_BOOL(false);
+}
+
+Datum brinbeginscan(PG_FUNCTION_ARGS)
+{
+    Relation rel = (Relation)PG_GETARG_POINTER(0);
+    int nkeys = PG_GETARG_INT32(1);
+    int norderbys = PG_GETARG_INT32(2);
+
+    if (rel == NULL)
+        ereport(ERROR,
+                (errcode(ERRCODE_INVALID_PARAMETER_VALUE), errmsg("Invalid arguments for function brinbeginscan")));
+
+    IndexScanDesc scan;
+    BrinOpaque *opaque = NULL;
+
+    scan = RelationGetIndexScan(rel, nkeys, norderbys);
+
+    opaque = (BrinOpaque *)palloc(sizeof(BrinOpaque));
+    opaque->bo_rmAccess = brinRevmapInitialize(rel, &opaque->bo_pagesPerRange, false);
+    opaque->bo_bdesc = brin_build_desc(rel);
+    scan->opaque = opaque;
+
+    PG_RETURN_POINTER(scan);
+}
+
+/*
+ * Return all heap blocks of the ranges that may hold matching tuples, as
+ * lossy pages.  The result is the number of pages times an arbitrary factor,
+ * as there is no telling how many tuples they hold.
+ */
+Datum bringetbitmap(PG_FUNCTION_ARGS)
+{
+    IndexScanDesc scan = (IndexScanDesc)PG_GETARG_POINTER(0);
+    TIDBitmap *tbm = (TIDBitmap *)PG_GETARG_POINTER(1);
+
+    if (scan == NULL || tbm == NULL)
+        ereport(ERROR,
+                (errcode(ERRCODE_INVALID_PARAMETER_VALUE), errmsg("Invalid arguments for function bringetbitmap")));
+
+    Relation idxRel = scan->indexRelation;
+    BrinOpaque *opaque = (BrinOpaque *)scan->opaque;
+    BrinDesc *bdesc = opaque->bo_bdesc;
+    BlockNumber pagesPerRange = opaque->bo_pagesPerRange;
+    Oid partHeapOid = IndexScanGetPartHeapOid(scan);
+    Buffer buf = InvalidBuffer;
+    MemoryContext perRangeCxt;
+    MemoryContext oldcxt;
+    Relation heapRel;
+    BlockNumber nblocks;
+    int64 totalpages = 0;
+
+    heapRel = brin_open_heap(idxRel, AccessShareLock);
+    nblocks = RelationGetNumberOfBlocks(heapRel);
+    heap_close(heapRel, AccessShareLock);
+
+    perRangeCxt = AllocSetContextCreate(CurrentMemoryContext, "bringetbitmap cxt", ALLOCSET_DEFAULT_MINSIZE,
+                                        ALLOCSET_DEFAULT_INITSIZE, ALLOCSET_DEFAULT_MAXSIZE);
+    oldcxt = MemoryContextSwitchTo(perRangeCxt);
+
+    for (BlockNumber heapBlk = 0; heapBlk < nblocks; heapBlk += pagesPerRange) {
+        BrinTuple *tup = NULL;
+        OffsetNumber off;
+        Size size;
+        bool addrange = true;
+
+        CHECK_FOR_INTERRUPTS();
+
+        MemoryContextResetAndDeleteChildren(perRangeCxt);
+
+        tup = brinGetTupleForHeapBlock(opaque->bo_rmAccess, heapBlk, &buf, &off, &size, BUFFER_LOCK_SHARE);
+        if (tup != NULL) {
+            BrinTuple *tupcopy = brin_copy_tuple(tup, size);
+
+            LockBuffer(buf, BUFFER_LOCK_UNLOCK);
+
+            /* a placeholder stands for a range being summarized, which matches */
+            if (!BrinTupleIsPlaceholder(tupcopy)) {
+                BrinMemTuple *dtup = brin_deform_tuple(bdesc, tupcopy, size);
+
+                addrange = brin_range_consistent(bdesc, dtup, scan->keyData, scan->numberOfKeys);
+            }
+        }
+
+        if (addrange) {
+            BlockNumber endBlk = Min(nblocks, heapBlk + pagesPerRange);
+
+            for (BlockNumber pageno = heapBlk; pageno < endBlk; pageno++) {
+                tbm_add_page(tbm, pageno, partHeapOid);
+                totalpages++;
+            }
+        }
+    }
+
+    (void)MemoryContextSwitchTo(oldcxt);
+    MemoryContextDelete(perRangeCxt);
+
+    if (BufferIsValid(buf))
+        ReleaseBuffer(buf);
+
+    PG_RETURN_INT64(totalpages * 10);
+}
+
+Datum brinrescan(PG_FUNCTION_ARGS)
+{
+    IndexScanDesc scan = (IndexScanDesc)PG_GETARG_POINTER(0);
+    ScanKey scankey = (ScanKey)PG_GETARG_POINTER(1);
+
+    if (scan == NULL)
+        ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE), errmsg("Invalid arguments for function brinrescan")));
+
+    /* remaining arguments are ignored */
+    if (scankey && scan->numberOfKeys > 0) {
+        errno_t ret = memmove_s(scan->keyData, scan->numberOfKeys * sizeof(ScanKeyData), scankey,
+                                scan->numberOfKeys * sizeof(ScanKeyData));
+        securec_check(ret, "", "");
+    }
+
+    PG_RETURN_VOID();
+}
+
+Datum brinendscan(PG_FUNCTION_ARGS)
+{
+    IndexScanDesc scan = (IndexScanDesc)PG_GETARG_POINTER(0);
+    if (scan == NULL)
+        ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE), errmsg("Invalid arguments for function brinendscan")));
+
+    BrinOpaque *opaque = (BrinOpaque *)scan->opaque;
+
+    brinRevmapTerminate(opaque->bo_rmAccess);
+    brin_free_desc(opaque->bo_bdesc);
+    pfree(opaque);
+
+    PG_RETURN_VOID();
+}
+
+Datum brinmarkpos(PG_FUNCTION_ARGS)
+{
+    ereport(ERROR, (errcode(ERRCODE_FEATURE_NOT_SUPPORTED), errmsg("BRIN does not support mark/restore")));
+    PG_RETURN_VOID();
+}
+
+Datum brinrestrpos(PG_FUNCTION_ARGS)
+{
+    ereport(ERROR, (errcode(ERRCODE_FEATURE_NOT_SUPPORTED), errmsg("BRIN does not support mark/restore")));
+    PG_RETURN_VOID();
+}
+
+Datum brinmerge(PG_FUNCTION_ARGS)
+{
+    IndexBuildResult *result = NULL;
+
+    ereport(ERROR, (errcode(ERRCODE_FEATURE_NOT_SUPPORTED), errmsg("brinmerge: unimplemented")));
+
+    PG_RETURN_POINTER(result);
+}
+
+/*
+ * Summaries do not point at heap tuples, so there is nothing to delete; a
+ * range keeps covering values that are gone until it is summarized anew.
+ */
+Datum brinbulkdelete(PG_FUNCTION_ARGS)
+{
+    IndexBulkDeleteResult *stats = (IndexBulkDeleteResult *)PG_GETARG_POINTER(1);
+
+    if (stats == NULL)
+        stats = (IndexBulkDeleteResult *)palloc0(sizeof(IndexBulkDeleteResult));
+
+    PG_RETURN_POINTER(stats);
+}
+
+/*
+ * Summarize the complete ranges that have no summary yet, then clean up the
+ * index pages.
+ */
+Datum brinvacuumcleanup(PG_FUNCTION_ARGS)
+{
+    IndexVacuumInfo *info = (IndexVacuumInfo *)PG_GETARG_POINTER(0);
+    IndexBulkDeleteResult *stats = (IndexBulkDeleteResult *)PG_GETARG_POINTER(1);
+
+    if (info == NULL)
+        ereport(ERROR,
+                (errcode(ERRCODE_INVALID_PARAMETER_VALUE), errmsg("Invalid arguments for function brinvacuumcleanup")));
+
+    Relation index = info->index;
+    Relation heapRel;
+    BrinRevmap *revmap = NULL;
+    BlockNumber pagesPerRange;
+
+    /* No-op in ANALYZE ONLY mode */
+    if (info->analyze_only)
+        PG_RETURN_POINTER(stats);
+
+    if (stats == NULL)
+        stats = (IndexBulkDeleteResult *)palloc0(sizeof(IndexBulkDeleteResult));
+
+    heapRel = brin_open_heap(index, AccessShareLock);
+    (void)brin_summarize_ranges(index, heapRel, BRIN_ALL_BLOCKRANGES, false);
+    heap_close(heapRel, AccessShareLock);
+
+    revmap = brinRevmapInitialize(index, &pagesPerRange, true);
+    brin_vacuum_scan(index, revmap, info->strategy);
+    brinRevmapTerminate(revmap);
+
+    stats->num_pages = RelationGetNumberOfBlocks(index);
+
+    PG_RETURN_POINTER(stats);
+}
+
+Datum brinoptions(PG_FUNCTION_ARGS)
+{
+    Datum reloptions = PG_GETARG_DATUM(0);
+    bool validate = PG_GETARG_BOOL(1);
+    relopt_value *options = NULL;
+    BrinOptions *rdopts = NULL;
+    int numoptions;
+    static const relopt_parse_elt tab[] = {
+        { "pages_per_range", RELOPT_TYPE_INT, offsetof(BrinOptions, pagesPerRange) },
+        { "autosummarize", RELOPT_TYPE_BOOL, offsetof(BrinOptions, autosummarize) }
+    };
+    options = parseRelOptions(reloptions, validate, RELOPT_KIND_BRIN, &numoptions);
+
+    /* if none set, we're done */
+    if (numoptions == 0)
+        PG_RETURN_NULL();
+    rdopts = (BrinOptions *)allocateReloptStruct(sizeof(BrinOptions), options, numoptions);
+    fillRelOptions((void *)rdopts, sizeof(BrinOptions), options, numoptions, validate, tab, lengthof(tab));
+    pfree(options);
+    options = NULL;
+    PG_RETURN_BYTEA_P(rdopts);
+}
+
+/*
+ * SQL-callable function to summarize the ranges of a BRIN index that have no
+ * summary yet, including the last one even if it is incomplete.  Returns the
+ * number of ranges summarized.
+ */
+Datum brin_summarize_new_values(PG_FUNCTION_ARGS)
+{
+    Oid indexoid = PG_GETARG_OID(0);
+    Oid heapoid;
+    Relation heapRel = NULL;
+    Relation indexRel;
+    double numSummarized;
+
+    if (RecoveryInProgress())
+        ereport(ERROR, (errcode(ERRCODE_OBJECT_NOT_IN_PREREQUISITE_STATE), errmsg("recovery is in progress"),
+                        errhint("BRIN control functions cannot be executed during recovery.")));
+
+    /*
+     * Lock the table before the index, in the order vacuum uses, to avoid
+     * deadlocks.  If indexoid is not an index the check below complains.
+     */
+    heapoid = IndexGetRelation(indexoid, true);
+    if (OidIsValid(heapoid))
+        heapRel = heap_open(heapoid, ShareUpdateExclusiveLock);
+    indexRel = index_open(indexoid, ShareUpdateExclusiveLock);
+
+    /* Must be a BRIN index */
+    if (indexRel->rd_rel->relkind != RELKIND_INDEX || indexRel->rd_rel->relam != BRIN_AM_OID)
+        ereport(ERROR, (errcode(ERRCODE_WRONG_OBJECT_TYPE),
+                        errmsg("\"%s\" is not a BRIN index", RelationGetRelationName(indexRel))));
+
+    if (RELATION_IS_OTHER_TEMP(indexRel))
+        ereport(ERROR,
+                (errcode(ERRCODE_FEATURE_NOT_SUPPORTED), errmsg("cannot access temporary indexes of other sessions")));
+
+    /* User must own the index (comparable to privileges needed for VACUUM) */
+    if (!pg_class_ownercheck(indexoid, GetUserId()))
+        aclcheck_error(ACLCHECK_NOT_OWNER, ACL_KIND_CLASS, RelationGetRelationName(indexRel));
+
+    /* the index may have been dropped and its OID reused meanwhile */
+    if (heapRel == NULL || heapoid != IndexGetRelation(indexoid, false))
+        ereport(ERROR, (errcode(ERRCODE_UNDEFINED_TABLE),
+                        errmsg("could not open parent table of index \"%s\"", RelationGetRelationName(indexRel))));
+
+    numSummarized = brin_summarize_ranges(indexRel, heapRel, BRIN_ALL_BLOCKRANGES, true);
+
+    index_close(indexRel, ShareUpdateExclusiveLock);
+    heap_close(heapRel, ShareUpdateExclusiveLock);
+
+    PG_RETURN_INT32((int32)numSummarized);
+}
+
+/*
+ * Summarize the range of heapBlk, if it has no summary yet.  This is the
+ * autovacuum work item brininsert queues when autosummarize is set; the
+ * index may have been dropped meanwhile, in which case nothing is done.
+ */
+void brin_summarize_range_work(Oid indexoid, BlockNumber heapBlk)
+{
+    Oid heapoid = IndexGetRelation(indexoid, true);
+    Relation heapRel;
+    Relation indexRel;
+
+    if (!OidIsValid(heapoid))
+        return;
+
+    /* same lock order and strength as brin_summarize_new_values */
+    heapRel = try_relation_open(heapoid, ShareUpdateExclusiveLock);
+    if (heapRel == NULL)
+        return;
+    indexRel = try_relation_open(indexoid, ShareUpdateExclusiveLock);
+    if (indexRel == NULL) {
+        heap_close(heapRel, ShareUpdateExclusiveLock);
+        return;
+    }
+
+    if (indexRel->rd_rel->relkind == RELKIND_INDEX && indexRel->rd_rel->relam == BRIN_AM_OID &&
+        heapoid == IndexGetRelation(indexoid, true))
+        (void)brin_summarize_ranges(indexRel, heapRel, heapBlk, true);
+
+    relation_close(indexRel, ShareUpdateExclusiveLock);
+    heap_close(heapRel, ShareUpdateExclusiveLock);
+}
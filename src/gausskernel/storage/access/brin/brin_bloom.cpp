@@ -0,0 +1,204 @@
+/* -------------------------------------------------------------------------
+ *
+ * brin_bloom.cpp
+ *	  BRIN opclass procedures keeping a bloom filter of the values of each
+ *	  range.
+ *
+ * Unlike minmax, a bloom filter does not need the values of a range to be
+ * clustered, only to be few compared with the size of the filter, and it
+ * supports equality searches only.  Values are hashed with the hash
+ * procedure of the opclass (support procedure 5), which the opfamily also
+ * provides for its other types, so cross-type searches hash compatibly.
+ *
+ * The filter is sized from pages_per_range when a range gets its first
+ * value.  Filters of different sizes cannot be merged; should that ever be
+ * needed, because pages_per_range was changed after the fact, the result is
+ * a filter with all bits set, which matches everything.
+ *
+ * Portions Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ *
+ * IDENTIFICATION
+ *	  src/gausskernel/storage/access/brin/brin_bloom.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+#include "postgres.h"
+#include "knl/knl_variable.h"
+
+#include "access/brin_private.h"
+#include "access/hash.h"
+#include "access/skey.h"
+#include "catalog/pg_type.h"
+#include "utils/lsyscache.h"
+#include "utils/rel.h"
+
+/* bits per heap page of the range, and bounds for the whole filter */
+#define BLOOM_BITS_PER_PAGE 128
+#define BLOOM_MIN_BITS 1024
+#define BLOOM_MAX_BITS 16384
+#define BLOOM_NHASHES 4
+
+typedef struct BloomFilter {
+    int32 vl_len_; /* varlena header (do not touch directly!) */
+    uint16 nhashes;
+    uint16 flags; /* currently unused */
+    uint32 nbits; /* a multiple of 8 */
+    uint8 bitmap[FLEXIBLE_ARRAY_MEMBER];
+} BloomFilter;
+
+#define SizeOfBloomFilter(nbits) (offsetof(BloomFilter, bitmap) + (nbits) / 8)
+
+typedef struct BloomOpaque {
+    Oid cached_subtype; /* subtype subtype_hashproc is for */
+    FmgrInfo subtype_hashproc;
+} BloomOpaque;
+
+static BloomFilter *bloom_create(BlockNumber pagesPerRange)
+{
+    uint32 nbits = (uint32)Min((uint64)pagesPerRange * BLOOM_BITS_PER_PAGE, (uint64)BLOOM_MAX_BITS);
+    BloomFilter *filter = NULL;
+
+    nbits = Max(nbits, BLOOM_MIN_BITS);
+    nbits = TYPEALIGN(8, nbits);
+
+    filter = (BloomFilter *)palloc0(SizeOfBloomFilter(nbits));
+    SET_VARSIZE(filter, SizeOfBloomFilter(nbits));
+    filter->nhashes = BLOOM_NHASHES;
+    filter->nbits = nbits;
+    return filter;
+}
+
+/*
+ * Visit the bits of a hash value, deriving the bit positions by double
+ * hashing.  With set true the bits are set and the result tells whether any
+ * of them changed; otherwise the result tells whether all of them are set.
+ */
+static bool bloom_probe(BloomFilter *filter, uint32 hash, bool set)
+{
+    uint32 h1 = hash;
+    uint32 h2 = DatumGetUInt32(hash_uint32(hash)) | 1;
+    bool result = !set;
+
+    for (uint16 i = 0; i < filter->nhashes; i++) {
+        uint32 bit = (uint32)(((uint64)h1 + (uint64)i * h2) % filter->nbits);
+        uint8 mask = (uint8)(1 << (bit % 8));
+
+        if (set) {
+            if ((filter->bitmap[bit / 8] & mask) == 0) {
+                filter->bitmap[bit / 8] |= mask;
+                result = true;
+            }
+        } else if ((filter->bitmap[bit / 8] & mask) == 0) {
+            return false;
+        }
+    }
+    return result;
+}
+
+/*
+ * Hash a value of the given subtype with the opfamily's hash procedure.
+ */
+static uint32 bloom_hash_value(BrinDesc *bdesc, AttrNumber attno, Oid subtype, Oid colloid, Datum value)
+{
+    Relation rel = bdesc->bd_index;
+    Oid opcintype = rel->rd_opcintype[attno - 1];
+    BloomOpaque *opaque = (BloomOpaque *)bdesc->bd_info[attno - 1]->oi_opaque;
+    FmgrInfo *hashproc = NULL;
+
+    if (!OidIsValid(subtype) || subtype == opcintype) {
+        hashproc = index_getprocinfo(rel, attno, BRIN_PROCNUM_HASH);
+    } else {
+        if (opaque->cached_subtype != subtype) {
+            Oid opfamily = rel->rd_opfamily[attno - 1];
+            Oid procid = get_opfamily_proc(opfamily, subtype, subtype, BRIN_PROCNUM_HASH);
+
+            if (!OidIsValid(procid))
+                ereport(ERROR, (errcode(ERRCODE_UNDEFINED_FUNCTION),
+                                errmsg("missing hash procedure for type %u in opfamily %u", subtype, opfamily)));
+            fmgr_info_cxt(procid, &opaque->subtype_hashproc, bdesc->bd_context);
+            opaque->cached_subtype = subtype;
+        }
+        hashproc = &opaque->subtype_hashproc;
+    }
+
+    return DatumGetUInt32(FunctionCall1Coll(hashproc, colloid, value));
+}
+
+Datum brin_bloom_opcinfo(PG_FUNCTION_ARGS)
+{
+    BrinOpcInfo *result = NULL;
+
+    result = (BrinOpcInfo *)palloc0(MAXALIGN(SizeofBrinOpcInfo(1)) + sizeof(BloomOpaque));
+    result->oi_nstored = 1;
+    result->oi_opaque = (BloomOpaque *)MAXALIGN((char *)result + SizeofBrinOpcInfo(1));
+    result->oi_typcache[0] = lookup_type_cache(BYTEAOID, 0);
+
+    PG_RETURN_POINTER(result);
+}
+
+Datum brin_bloom_add_value(PG_FUNCTION_ARGS)
+{
+    BrinDesc *bdesc = (BrinDesc *)PG_GETARG_POINTER(0);
+    BrinValues *column = (BrinValues *)PG_GETARG_POINTER(1);
+    Datum newval = PG_GETARG_DATUM(2);
+    Oid colloid = PG_GET_COLLATION();
+    BloomFilter *filter = NULL;
+    bool updated = false;
+    uint32 hash;
+
+    if (column->bv_allnulls) {
+        filter = bloom_create(BrinGetPagesPerRange(bdesc->bd_index));
+        column->bv_values[0] = PointerGetDatum(filter);
+        column->bv_allnulls = false;
+        updated = true;
+    } else {
+        filter = (BloomFilter *)DatumGetPointer(column->bv_values[0]);
+    }
+
+    hash = bloom_hash_value(bdesc, column->bv_attno, InvalidOid, colloid, newval);
+    updated |= bloom_probe(filter, hash, true);
+
+    PG_RETURN_BOOL(updated);
+}
+
+Datum brin_bloom_consistent(PG_FUNCTION_ARGS)
+{
+    BrinDesc *bdesc = (BrinDesc *)PG_GETARG_POINTER(0);
+    BrinValues *column = (BrinValues *)PG_GETARG_POINTER(1);
+    ScanKey key = (ScanKey)PG_GETARG_POINTER(2);
+    Oid colloid = PG_GET_COLLATION();
+    BloomFilter *filter = (BloomFilter *)DatumGetPointer(column->bv_values[0]);
+    uint32 hash;
+
+    Assert(!column->bv_allnulls && !(key->sk_flags & SK_ISNULL));
+
+    if (key->sk_strategy != BTEqualStrategyNumber)
+        ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+                        errmsg("invalid strategy number %d for BRIN bloom opclass", key->sk_strategy)));
+
+    hash = bloom_hash_value(bdesc, key->sk_attno, key->sk_subtype, colloid, key->sk_argument);
+    PG_RETURN_BOOL(bloom_probe(filter, hash, false));
+}
+
+Datum brin_bloom_union(PG_FUNCTION_ARGS)
+{
+    BrinValues *col_a = (BrinValues *)PG_GETARG_POINTER(1);
+    BrinValues *col_b = (BrinValues *)PG_GETARG_POINTER(2);
+    BloomFilter *filter_a = (BloomFilter *)DatumGetPointer(col_a->bv_values[0]);
+    BloomFilter *filter_b = (BloomFilter *)DatumGetPointer(col_b->bv_values[0]);
+    uint32 nbytes = filter_a->nbits / 8;
+
+    Assert(!col_a->bv_allnulls && !col_b->bv_allnulls);
+
+    if (filter_a->nbits != filter_b->nbits || filter_a->nhashes != filter_b->nhashes) {
+        errno_t rc = memset_s(filter_a->bitmap, nbytes, 0xFF, nbytes);
+        securec_check(rc, "", "");
+        PG_RETURN_VOID();
+    }
+
+    for (uint32 i = 0; i < nbytes; i++)
+        filter_a->bitmap[i] |= filter_b->bitmap[i];
+
+    PG_RETURN_VOID();
+}
@@ -0,0 +1,203 @@
+/* -------------------------------------------------------------------------
+ *
+ * brin_minmax.cpp
+ *	  BRIN opclass procedures keeping the minimum and maximum value of each
+ *	  range, for types with a btree-style total order.
+ *
+ * The comparison operators are taken from the opfamily, using the same
+ * strategy numbers as btree.  Null handling is done by the generic code, so
+ * these procedures only ever see non-null values.
+ *
+ * Portions Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ *
+ * IDENTIFICATION
+ *	  src/gausskernel/storage/access/brin/brin_minmax.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+#include "postgres.h"
+#include "knl/knl_variable.h"
+
+#include "access/brin_private.h"
+#include "access/skey.h"
+#include "utils/datum.h"
+#include "utils/lsyscache.h"
+#include "utils/rel.h"
+
+typedef struct MinmaxOpaque {
+    Oid cached_subtype;                              /* subtype the procinfos below are for */
+    FmgrInfo strategy_procinfos[BTMaxStrategyNumber]; /* fn_oid is InvalidOid until looked up */
+} MinmaxOpaque;
+
+#define MINMAX_MIN 0
+#define MINMAX_MAX 1
+
+/*
+ * Return the comparison procedure of the given strategy for comparing the
+ * column's values against a value of the given subtype.
+ */
+static FmgrInfo *minmax_get_strategy_procinfo(BrinDesc *bdesc, AttrNumber attno, Oid subtype, uint16 strategynum)
+{
+    MinmaxOpaque *opaque = (MinmaxOpaque *)bdesc->bd_info[attno - 1]->oi_opaque;
+    Relation rel = bdesc->bd_index;
+    Oid opcintype = rel->rd_opcintype[attno - 1];
+    FmgrInfo *finfo = NULL;
+
+    Assert(strategynum >= 1 && strategynum <= BTMaxStrategyNumber);
+
+    if (!OidIsValid(subtype))
+        subtype = opcintype;
+
+    if (opaque->cached_subtype != subtype) {
+        for (int i = 0; i < BTMaxStrategyNumber; i++)
+            opaque->strategy_procinfos[i].fn_oid = InvalidOid;
+        opaque->cached_subtype = subtype;
+    }
+
+    finfo = &opaque->strategy_procinfos[strategynum - 1];
+    if (!OidIsValid(finfo->fn_oid)) {
+        Oid opfamily = rel->rd_opfamily[attno - 1];
+        Oid oprid = get_opfamily_member(opfamily, opcintype, subtype, strategynum);
+
+        if (!OidIsValid(oprid))
+            ereport(ERROR, (errcode(ERRCODE_UNDEFINED_OBJECT),
+                            errmsg("missing operator %d(%u,%u) in opfamily %u", strategynum, opcintype, subtype,
+                                   opfamily)));
+        fmgr_info_cxt(get_opcode(oprid), finfo, bdesc->bd_context);
+    }
+
+    return finfo;
+}
+
+/*
+ * Replace one of the stored values by a copy of newval.
+ */
+static void minmax_store(BrinValues *column, int which, Datum newval, Form_pg_attribute attr)
+{
+    if (!attr->attbyval && !column->bv_allnulls)
+        pfree(DatumGetPointer(column->bv_values[which]));
+    column->bv_values[which] = datumCopy(newval, attr->attbyval, attr->attlen);
+}
+
+Datum brin_minmax_opcinfo(PG_FUNCTION_ARGS)
+{
+    Oid typoid = PG_GETARG_OID(0);
+    BrinOpcInfo *result = NULL;
+
+    /* the opaque area goes right after the typcache array */
+    result = (BrinOpcInfo *)palloc0(MAXALIGN(SizeofBrinOpcInfo(2)) + sizeof(MinmaxOpaque));
+    result->oi_nstored = 2;
+    result->oi_opaque = (MinmaxOpaque *)MAXALIGN((char *)result + SizeofBrinOpcInfo(2));
+    result->oi_typcache[MINMAX_MIN] = result->oi_typcache[MINMAX_MAX] = lookup_type_cache(typoid, 0);
+
+    PG_RETURN_POINTER(result);
+}
+
+/*
+ * Widen the range's summary to include newval.  Returns true if the summary
+ * changed.
+ */
+Datum brin_minmax_add_value(PG_FUNCTION_ARGS)
+{
+    BrinDesc *bdesc = (BrinDesc *)PG_GETARG_POINTER(0);
+    BrinValues *column = (BrinValues *)PG_GETARG_POINTER(1);
+    Datum newval = PG_GETARG_DATUM(2);
+    Oid colloid = PG_GET_COLLATION();
+    AttrNumber attno = column->bv_attno;
+    Form_pg_attribute attr = bdesc->bd_tupdesc->attrs[attno - 1];
+    FmgrInfo *cmpFn = NULL;
+    bool updated = false;
+
+    if (column->bv_allnulls) {
+        minmax_store(column, MINMAX_MIN, newval, attr);
+        minmax_store(column, MINMAX_MAX, newval, attr);
+        column->bv_allnulls = false;
+        PG_RETURN_BOOL(true);
+    }
+
+    cmpFn = minmax_get_strategy_procinfo(bdesc, attno, InvalidOid, BTLessStrategyNumber);
+    if (DatumGetBool(FunctionCall2Coll(cmpFn, colloid, newval, column->bv_values[MINMAX_MIN]))) {
+        minmax_store(column, MINMAX_MIN, newval, attr);
+        updated = true;
+    }
+
+    cmpFn = minmax_get_strategy_procinfo(bdesc, attno, InvalidOid, BTGreaterStrategyNumber);
+    if (DatumGetBool(FunctionCall2Coll(cmpFn, colloid, newval, column->bv_values[MINMAX_MAX]))) {
+        minmax_store(column, MINMAX_MAX, newval, attr);
+        updated = true;
+    }
+
+    PG_RETURN_BOOL(updated);
+}
+
+/*
+ * Can the range contain values satisfying the scan key?
+ */
+Datum brin_minmax_consistent(PG_FUNCTION_ARGS)
+{
+    BrinDesc *bdesc = (BrinDesc *)PG_GETARG_POINTER(0);
+    BrinValues *column = (BrinValues *)PG_GETARG_POINTER(1);
+    ScanKey key = (ScanKey)PG_GETARG_POINTER(2);
+    Oid colloid = PG_GET_COLLATION();
+    AttrNumber attno = key->sk_attno;
+    Oid subtype = key->sk_subtype;
+    Datum value = key->sk_argument;
+    FmgrInfo *finfo = NULL;
+    bool matches = false;
+
+    Assert(!column->bv_allnulls && !(key->sk_flags & SK_ISNULL));
+
+    switch (key->sk_strategy) {
+        case BTLessStrategyNumber:
+        case BTLessEqualStrategyNumber:
+            finfo = minmax_get_strategy_procinfo(bdesc, attno, subtype, key->sk_strategy);
+            matches = DatumGetBool(FunctionCall2Coll(finfo, colloid, column->bv_values[MINMAX_MIN], value));
+            break;
+        case BTEqualStrategyNumber:
+            finfo = minmax_get_strategy_procinfo(bdesc, attno, subtype, BTLessEqualStrategyNumber);
+            matches = DatumGetBool(FunctionCall2Coll(finfo, colloid, column->bv_values[MINMAX_MIN], value));
+            if (!matches)
+                break;
+            finfo = minmax_get_strategy_procinfo(bdesc, attno, subtype, BTGreaterEqualStrategyNumber);
+            matches = DatumGetBool(FunctionCall2Coll(finfo, colloid, column->bv_values[MINMAX_MAX], value));
+            break;
+        case BTGreaterEqualStrategyNumber:
+        case BTGreaterStrategyNumber:
+            finfo = minmax_get_strategy_procinfo(bdesc, attno, subtype, key->sk_strategy);
+            matches = DatumGetBool(FunctionCall2Coll(finfo, colloid, column->bv_values[MINMAX_MAX], value));
+            break;
+        default:
+            ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+                            errmsg("invalid strategy number %d for BRIN minmax opclass", key->sk_strategy)));
+            break;
+    }
+
+    PG_RETURN_BOOL(matches);
+}
+
+/*
+ * Widen the summary in column a to cover the one in column b.
+ */
+Datum brin_minmax_union(PG_FUNCTION_ARGS)
+{
+    BrinDesc *bdesc = (BrinDesc *)PG_GETARG_POINTER(0);
+    BrinValues *col_a = (BrinValues *)PG_GETARG_POINTER(1);
+    BrinValues *col_b = (BrinValues *)PG_GETARG_POINTER(2);
+    Oid colloid = PG_GET_COLLATION();
+    AttrNumber attno = col_a->bv_attno;
+    Form_pg_attribute attr = bdesc->bd_tupdesc->attrs[attno - 1];
+    FmgrInfo *finfo = NULL;
+
+    Assert(!col_a->bv_allnulls && !col_b->bv_allnulls);
+
+    finfo = minmax_get_strategy_procinfo(bdesc, attno, InvalidOid, BTLessStrategyNumber);
+    if (DatumGetBool(FunctionCall2Coll(finfo, colloid, col_b->bv_values[MINMAX_MIN], col_a->bv_values[MINMAX_MIN])))
+        minmax_store(col_a, MINMAX_MIN, col_b->bv_values[MINMAX_MIN], attr);
+
+    finfo = minmax_get_strategy_procinfo(bdesc, attno, InvalidOid, BTGreaterStrategyNumber);
+    if (DatumGetBool(FunctionCall2Coll(finfo, colloid, col_b->bv_values[MINMAX_MAX], col_a->bv_values[MINMAX_MAX])))
+        minmax_store(col_a, MINMAX_MAX, col_b->bv_values[MINMAX_MAX], attr);
+
+    PG_RETURN_VOID();
+}
@@ -0,0 +1,510 @@
+/* -------------------------------------------------------------------------
+ *
+ * brin_pageops.cpp
+ *	  Page-level operations of the BRIN index: inserting and updating
+ *	  summary tuples, and cleaning up regular pages during vacuum.
+ *
+ * Inserting and moving a summary tuple log the tuple and the map entry it
+ * gets, see brin_xlog.cpp for their replay; cleanup during vacuum is logged
+ * as full-page images.  Locks are always taken on regular pages before the
+ * revmap page, and two regular pages in block number order, except for a
+ * freshly extended page that nobody else can know about yet.
+ *
+ * Portions Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ *
+ * IDENTIFICATION
+ *	  src/gausskernel/storage/access/brin/brin_pageops.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+#include "postgres.h"
+#include "knl/knl_variable.h"
+
+#include "access/brin_private.h"
+#include "access/heapam.h"
+#include "access/itup.h"
+#include "access/xloginsert.h"
+#include "commands/vacuum.h"
+#include "miscadmin.h"
+#include "storage/freespace.h"
+#include "storage/lmgr.h"
+#include "utils/rel.h"
+
+/*
+ * Add a new page at the end of the index and return it exclusively locked.
+ * The page is left uninitialized.
+ */
+Buffer brin_extend_relation(Relation idxrel)
+{
+    bool needLock = !RELATION_IS_LOCAL(idxrel);
+    Buffer buf;
+
+    if (needLock)
+        LockRelationForExtension(idxrel, ExclusiveLock);
+    buf = ReadBuffer(idxrel, P_NEW);
+    LockBuffer(buf, BUFFER_LOCK_EXCLUSIVE);
+    if (needLock)
+        UnlockRelationForExtension(idxrel, ExclusiveLock);
+
+    return buf;
+}
+
+/*
+ * Initialize a page of the given type.  Directory and revmap pages keep
+ * pd_lower past their array, so that full-page images do not drop it.
+ */
+void brin_page_init(Page page, uint16 type)
+{
+    PageInit(page, BLCKSZ, sizeof(BrinSpecialSpace));
+    BrinPageGetSpecial(page)->type = type;
+
+    if (type == BRIN_PAGETYPE_DIR || type == BRIN_PAGETYPE_REVMAP) {
+        ((PageHeader)page)->pd_lower = (LocationIndex)(PageGetContents(page) + BrinPageContentSize - (char *)page);
+
+        if (type == BRIN_PAGETYPE_DIR) {
+            errno_t rc = memset_s(BrinDirPageGetItems(page), BrinPageContentSize, 0xFF, BrinPageContentSize);
+            securec_check(rc, "", "");
+        }
+    }
+}
+
+void brin_metapage_init(Page page, BlockNumber pagesPerRange)
+{
+    BrinMetaPageData *metadata = NULL;
+    errno_t rc;
+
+    brin_page_init(page, BRIN_PAGETYPE_META);
+    metadata = BrinPageGetMeta(page);
+    metadata->brinMagic = BRIN_META_MAGIC;
+    metadata->brinVersion = BRIN_CURRENT_VERSION;
+    metadata->pagesPerRange = pagesPerRange;
+    rc = memset_s(metadata->dirPages, sizeof(BlockNumber) * BRIN_META_MAX_DIRS, 0xFF,
+                  sizeof(BlockNumber) * BRIN_META_MAX_DIRS);
+    securec_check(rc, "", "");
+
+    ((PageHeader)page)->pd_lower = (LocationIndex)((char *)&metadata->dirPages[BRIN_META_MAX_DIRS] - (char *)page);
+}
+
+/*
+ * Free space of a regular page as recorded in the FSM.
+ */
+static Size brin_page_freespace(Page page)
+{
+    if (PageIsNew(page) || !BRIN_IS_REGULAR_PAGE(page))
+        return 0;
+    return PageGetFreeSpace(page);
+}
+
+/*
+ * Can a tuple of origsz bytes on the page be replaced in place by one of
+ * newsz bytes?
+ */
+bool brin_can_do_samepage_update(Buffer buffer, Size origsz, Size newsz)
+{
+    return newsz <= origsz || PageGetExactFreeSpace(BufferGetPage(buffer)) >= (MAXALIGN(newsz) - MAXALIGN(origsz));
+}
+
+/*
+ * Return an exclusively locked regular page with room for a tuple of itemsz
+ * bytes.  If oldbuf is valid it is the page the tuple currently lives on and
+ * did not fit into; it is locked too on return, avoiding deadlocks with other
+ * backends doing the same.
+ *
+ * *initialized is set if the page was new and has just been initialized, in
+ * which case the caller must log the initialization along with its change,
+ * or by brin_log_empty_new_page if it ends up changing nothing.
+ */
+static Buffer brin_getinsertbuffer(Relation idxrel, Buffer oldbuf, Size itemsz, bool *initialized)
+{
+    BlockNumber oldblk = BufferIsValid(oldbuf) ? BufferGetBlockNumber(oldbuf) : InvalidBlockNumber;
+    BlockNumber newblk = GetPageWithFreeSpace(idxrel, itemsz);
+
+    for (;;) {
+        Buffer buf;
+        Page page;
+        Size freespace;
+
+        CHECK_FOR_INTERRUPTS();
+
+        if (newblk != InvalidBlockNumber && newblk == oldblk) {
+            newblk = RecordAndGetPageWithFreeSpace(idxrel, newblk, 0, itemsz);
+            continue;
+        }
+
+        if (newblk == InvalidBlockNumber) {
+            /* nobody else knows the new page, so we may wait for oldbuf */
+            buf = brin_extend_relation(idxrel);
+            if (BufferIsValid(oldbuf))
+                LockBuffer(oldbuf, BUFFER_LOCK_EXCLUSIVE);
+        } else {
+            buf = ReadBuffer(idxrel, newblk);
+            if (BufferIsValid(oldbuf) && oldblk < newblk) {
+                LockBuffer(oldbuf, BUFFER_LOCK_EXCLUSIVE);
+                LockBuffer(buf, BUFFER_LOCK_EXCLUSIVE);
+            } else {
+                LockBuffer(buf, BUFFER_LOCK_EXCLUSIVE);
+                if (BufferIsValid(oldbuf))
+                    LockBuffer(oldbuf, BUFFER_LOCK_EXCLUSIVE);
+            }
+        }
+
+        page = BufferGetPage(buf);
+        *initialized = PageIsNew(page);
+        if (*initialized)
+            brin_page_init(page, BRIN_PAGETYPE_REGULAR);
+
+        freespace = brin_page_freespace(page);
+        if (freespace >= MAXALIGN(itemsz))
+            return buf;
+
+        /* the FSM was out of date; tell it and try another page */
+        newblk = BufferGetBlockNumber(buf);
+        if (BufferIsValid(oldbuf))
+            LockBuffer(oldbuf, BUFFER_LOCK_UNLOCK);
+        UnlockReleaseBuffer(buf);
+        newblk = RecordAndGetPageWithFreeSpace(idxrel, newblk, freespace, itemsz);
+    }
+}
+
+/*
+ * Make the initialization of a page from brin_getinsertbuffer durable when no
+ * tuple went to it after all.  Later changes of the page only log their delta,
+ * which cannot be replayed on a page that is still zeroed on disk.
+ */
+static void brin_log_empty_new_page(Buffer buf, bool logged)
+{
+    START_CRIT_SECTION();
+    MarkBufferDirty(buf);
+    if (logged)
+        (void)log_newpage_buffer(buf, true);
+    END_CRIT_SECTION();
+}
+
+static void brin_check_item_size(Relation idxrel, Size itemsz)
+{
+    if (MAXALIGN(itemsz) > BrinMaxItemSize)
+        ereport(ERROR, (errcode(ERRCODE_PROGRAM_LIMIT_EXCEEDED),
+                        errmsg("index row size %lu exceeds maximum %lu for index \"%s\"", (unsigned long)itemsz,
+                               (unsigned long)BrinMaxItemSize, RelationGetRelationName(idxrel))));
+}
+
+static OffsetNumber brin_add_item(Relation idxrel, Page page, const BrinTuple *tup, Size itemsz, OffsetNumber off)
+{
+    OffsetNumber newoff = PageAddItem(page, (Item)tup, itemsz, off, off != InvalidOffsetNumber, false);
+
+    if (newoff == InvalidOffsetNumber)
+        ereport(PANIC, (errcode(ERRCODE_INDEX_CORRUPTED),
+                        errmsg("failed to add BRIN tuple to index page in \"%s\"", RelationGetRelationName(idxrel))));
+    return newoff;
+}
+
+/*
+ * Insert the first summary tuple of heapBlk's range and point the range map
+ * at it.  Returns false, changing nothing, if somebody else summarized the
+ * range first.
+ */
+bool brin_doinsert(Relation idxrel, BlockNumber pagesPerRange, BrinRevmap *revmap, BlockNumber heapBlk,
+                   BrinTuple *tup, Size itemsz)
+{
+    bool logged = brinRevmapLogChanges(revmap);
+    ItemPointerData tid;
+    BlockNumber blk;
+    OffsetNumber off;
+    Buffer buf;
+    Buffer rmbuf;
+    Page page;
+    bool initialized = false;
+    bool inserted = false;
+
+    brin_check_item_size(idxrel, itemsz);
+
+    /* must be done before locking anything, it may extend the index */
+    brinRevmapExtend(revmap, heapBlk);
+
+    buf = brin_getinsertbuffer(idxrel, InvalidBuffer, itemsz, &initialized);
+    page = BufferGetPage(buf);
+    blk = BufferGetBlockNumber(buf);
+    rmbuf = brinLockRevmapPageForUpdate(revmap, heapBlk);
+
+    if (!brinRevmapGetItem(rmbuf, pagesPerRange, heapBlk, &tid)) {
+        START_CRIT_SECTION();
+        off = brin_add_item(idxrel, page, tup, itemsz, InvalidOffsetNumber);
+        MarkBufferDirty(buf);
+        ItemPointerSet(&tid, blk, off);
+        brinSetHeapBlockItemptr(rmbuf, pagesPerRange, heapBlk, tid);
+        MarkBufferDirty(rmbuf);
+        if (logged) {
+            xl_brin_insert xlrec;
+            XLogRecPtr recptr;
+
+            xlrec.heapBlk = heapBlk;
+            xlrec.pagesPerRange = pagesPerRange;
+            xlrec.offnum = off;
+
+            XLogBeginInsert();
+            XLogRegisterData((char *)&xlrec, SizeOfBrinInsert);
+            XLogRegisterBuffer(0, buf, REGBUF_STANDARD | (initialized ? REGBUF_WILL_INIT : 0));
+            XLogRegisterBufData(0, (char *)tup, (int)itemsz);
+            XLogRegisterBuffer(1, rmbuf, REGBUF_STANDARD);
+
+            recptr = XLogInsert(RM_BRIN_ID, XLOG_BRIN_INSERT | (initialized ? XLOG_BRIN_INIT_PAGE : 0));
+            PageSetLSN(page, recptr);
+            PageSetLSN(BufferGetPage(rmbuf), recptr);
+        }
+        END_CRIT_SECTION();
+        inserted = true;
+    } else if (initialized) {
+        brin_log_empty_new_page(buf, logged);
+    }
+
+    LockBuffer(rmbuf, BUFFER_LOCK_UNLOCK);
+    UnlockReleaseBuffer(buf);
+    RecordPageWithFreeSpace(idxrel, blk, brin_page_freespace(page));
+
+    return inserted;
+}
+
+/*
+ * Replace the summary tuple origtup of heapBlk's range, found at oldoff of
+ * oldbuf, by newtup.  The caller holds a pin on oldbuf but no lock.  If
+ * samepage is true the caller has checked that newtup fits in place, and the
+ * old item is overwritten; otherwise the new tuple goes to another page and
+ * the range map is repointed to it.
+ *
+ * Returns false, changing nothing, if the old tuple changed since the caller
+ * read it; the caller must then read it again and retry.
+ */
+bool brin_doupdate(Relation idxrel, BlockNumber pagesPerRange, BrinRevmap *revmap, BlockNumber heapBlk,
+                   Buffer oldbuf, OffsetNumber oldoff, const BrinTuple *origtup, Size origsz,
+                   const BrinTuple *newtup, Size newsz, bool samepage)
+{
+    bool logged = brinRevmapLogChanges(revmap);
+    Page oldpage = BufferGetPage(oldbuf);
+    Buffer newbuf = InvalidBuffer;
+    Page newpage = NULL;
+    BlockNumber newblk = InvalidBlockNumber;
+    ItemId oldlp;
+    Buffer rmbuf;
+    ItemPointerData tid;
+    OffsetNumber newoff;
+    bool initialized = false;
+    XLogRecPtr recptr;
+
+    brin_check_item_size(idxrel, newsz);
+
+    if (samepage) {
+        LockBuffer(oldbuf, BUFFER_LOCK_EXCLUSIVE);
+    } else {
+        newbuf = brin_getinsertbuffer(idxrel, oldbuf, newsz, &initialized);
+        newpage = BufferGetPage(newbuf);
+        newblk = BufferGetBlockNumber(newbuf);
+    }
+
+    /* check that the old tuple is still what the caller saw */
+    oldlp = (PageIsNew(oldpage) || !BRIN_IS_REGULAR_PAGE(oldpage) || oldoff > PageGetMaxOffsetNumber(oldpage))
+                ? NULL
+                : PageGetItemId(oldpage, oldoff);
+    if (oldlp == NULL || !ItemIdIsNormal(oldlp) ||
+        !brin_tuples_equal((BrinTuple *)PageGetItem(oldpage, oldlp), ItemIdGetLength(oldlp), origtup, origsz) ||
+        (samepage && !brin_can_do_samepage_update(oldbuf, origsz, newsz))) {
+        LockBuffer(oldbuf, BUFFER_LOCK_UNLOCK);
+        if (BufferIsValid(newbuf)) {
+            if (initialized)
+                brin_log_empty_new_page(newbuf, logged);
+            UnlockReleaseBuffer(newbuf);
+            RecordPageWithFreeSpace(idxrel, newblk, brin_page_freespace(newpage));
+        }
+        return false;
+    }
+
+    if (samepage) {
+        START_CRIT_SECTION();
+        ItemIdSetUnused(oldlp);
+        PageRepairFragmentation(oldpage);
+        (void)brin_add_item(idxrel, oldpage, newtup, newsz, oldoff);
+        MarkBufferDirty(oldbuf);
+        if (logged) {
+            xl_brin_samepage_update xlrec;
+
+            xlrec.offnum = oldoff;
+
+            XLogBeginInsert();
+            XLogRegisterData((char *)&xlrec, SizeOfBrinSamepageUpdate);
+            XLogRegisterBuffer(0, oldbuf, REGBUF_STANDARD);
+            XLogRegisterBufData(0, (char *)newtup, (int)newsz);
+
+            recptr = XLogInsert(RM_BRIN_ID, XLOG_BRIN_SAMEPAGE_UPDATE);
+            PageSetLSN(oldpage, recptr);
+        }
+        END_CRIT_SECTION();
+
+        LockBuffer(oldbuf, BUFFER_LOCK_UNLOCK);
+        return true;
+    }
+
+    rmbuf = brinLockRevmapPageForUpdate(revmap, heapBlk);
+
+    START_CRIT_SECTION();
+    newoff = brin_add_item(idxrel, newpage, newtup, newsz, InvalidOffsetNumber);
+    MarkBufferDirty(newbuf);
+    ItemPointerSet(&tid, newblk, newoff);
+    brinSetHeapBlockItemptr(rmbuf, pagesPerRange, heapBlk, tid);
+    MarkBufferDirty(rmbuf);
+    ItemIdSetUnused(oldlp);
+    PageRepairFragmentation(oldpage);
+    MarkBufferDirty(oldbuf);
+    if (logged) {
+        xl_brin_update xlrec;
+
+        xlrec.oldOffnum = oldoff;
+        xlrec.insert.heapBlk = heapBlk;
+        xlrec.insert.pagesPerRange = pagesPerRange;
+        xlrec.insert.offnum = newoff;
+
+        XLogBeginInsert();
+        XLogRegisterData((char *)&xlrec, SizeOfBrinUpdate);
+        XLogRegisterBuffer(0, newbuf, REGBUF_STANDARD | (initialized ? REGBUF_WILL_INIT : 0));
+        XLogRegisterBufData(0, (char *)newtup, (int)newsz);
+        XLogRegisterBuffer(1, rmbuf, REGBUF_STANDARD);
+        XLogRegisterBuffer(2, oldbuf, REGBUF_STANDARD);
+
+        recptr = XLogInsert(RM_BRIN_ID, XLOG_BRIN_UPDATE | (initialized ? XLOG_BRIN_INIT_PAGE : 0));
+        PageSetLSN(newpage, recptr);
+        PageSetLSN(BufferGetPage(rmbuf), recptr);
+        PageSetLSN(oldpage, recptr);
+    }
+    END_CRIT_SECTION();
+
+    LockBuffer(rmbuf, BUFFER_LOCK_UNLOCK);
+    LockBuffer(oldbuf, BUFFER_LOCK_UNLOCK);
+    UnlockReleaseBuffer(newbuf);
+
+    RecordPageWithFreeSpace(idxrel, BufferGetBlockNumber(oldbuf), brin_page_freespace(oldpage));
+    RecordPageWithFreeSpace(idxrel, newblk, brin_page_freespace(newpage));
+
+    return true;
+}
+
+/*
+ * Remove the tuples of a locked regular page that the range map does not
+ * point to.  Indexes written before insertions and moves were logged as one
+ * record each may have them, from a crash between logging the new tuple and
+ * the repointed map.
+ */
+static void brin_remove_orphans(Relation idxrel, BrinRevmap *revmap, Buffer buf)
+{
+    Page page = BufferGetPage(buf);
+    BlockNumber blkno = BufferGetBlockNumber(buf);
+    OffsetNumber maxoff = PageGetMaxOffsetNumber(page);
+    OffsetNumber orphans[MaxIndexTuplesPerPage];
+    int norphans = 0;
+
+    for (OffsetNumber off = FirstOffsetNumber; off <= maxoff; off++) {
+        ItemId lp = PageGetItemId(page, off);
+        BrinTuple *tup = NULL;
+        ItemPointerData tid;
+
+        if (!ItemIdIsUsed(lp))
+            continue;
+
+        tup = (BrinTuple *)PageGetItem(page, lp);
+        if (brinRevmapGetTid(revmap, tup->bt_blkno, &tid) && ItemPointerGetBlockNumber(&tid) == blkno &&
+            ItemPointerGetOffsetNumber(&tid) == off)
+            continue;
+
+        Assert(norphans < MaxIndexTuplesPerPage);
+        orphans[norphans++] = off;
+    }
+
+    if (norphans == 0)
+        return;
+
+    START_CRIT_SECTION();
+    for (int i = 0; i < norphans; i++)
+        ItemIdSetUnused(PageGetItemId(page, orphans[i]));
+    PageRepairFragmentation(page);
+    MarkBufferDirty(buf);
+    if (brinRevmapLogChanges(revmap))
+        (void)log_newpage_buffer(buf, true);
+    END_CRIT_SECTION();
+
+    ereport(DEBUG2, (errmsg("removed %d orphan tuples from block %u of BRIN index \"%s\"", norphans, blkno,
+                            RelationGetRelationName(idxrel))));
+}
+
+/*
+ * Vacuum pass over the regular pages of the index: initialize pages left
+ * zeroed by a crash during extension, remove orphan tuples, and bring the
+ * FSM up to date.
+ */
+void brin_vacuum_scan(Relation idxrel, BrinRevmap *revmap, BufferAccessStrategy strategy)
+{
+    BlockNumber nblocks = RelationGetNumberOfBlocks(idxrel);
+
+    for (BlockNumber blkno = BRIN_METAPAGE_BLKNO + 1; blkno < nblocks; blkno++) {
+        Buffer buf;
+        Page page;
+        Size freespace = 0;
+
+        vacuum_delay_point();
+
+        buf = ReadBufferExtended(idxrel, MAIN_FORKNUM, blkno, RBM_NORMAL, strategy);
+        page = BufferGetPage(buf);
+
+        /*
+         * A new page may belong to a backend that just extended the index and
+         * has not initialized it yet.  Such a backend takes the page lock
+         * before it lets go of the extension lock, so cycling the extension
+         * lock is enough to be sure we wait for it below.
+         */
+        if (PageIsNew(page) && !RELATION_IS_LOCAL(idxrel)) {
+            LockRelationForExtension(idxrel, ShareLock);
+            UnlockRelationForExtension(idxrel, ShareLock);
+        }
+
+        LockBuffer(buf, BUFFER_LOCK_EXCLUSIVE);
+        if (PageIsNew(page)) {
+            START_CRIT_SECTION();
+            brin_page_init(page, BRIN_PAGETYPE_REGULAR);
+            MarkBufferDirty(buf);
+            if (brinRevmapLogChanges(revmap))
+                (void)log_newpage_buffer(buf, true);
+            END_CRIT_SECTION();
+        }
+
+        if (BRIN_IS_REGULAR_PAGE(page)) {
+            brin_remove_orphans(idxrel, revmap, buf);
+            freespace = brin_page_freespace(page);
+        }
+        UnlockReleaseBuffer(buf);
+
+        if (freespace > 0)
+            RecordPageWithFreeSpace(idxrel, blkno, freespace);
+    }
+
+    FreeSpaceMapVacuum(idxrel);
+}
+
+/*
+ * WAL-log every page of the index, at the end of a build that did not log
+ * its changes as it went.
+ */
+void brin_log_newpages(Relation idxrel)
+{
+    BlockNumber nblocks = RelationGetNumberOfBlocks(idxrel);
+
+    if (!RelationNeedsWAL(idxrel))
+        return;
+
+    for (BlockNumber blkno = 0; blkno < nblocks; blkno++) {
+        Buffer buf = ReadBuffer(idxrel, blkno);
+
+        LockBuffer(buf, BUFFER_LOCK_EXCLUSIVE);
+        START_CRIT_SECTION();
+        MarkBufferDirty(buf);
+        (void)log_newpage_buffer(buf, !PageIsNew(BufferGetPage(buf)));
+        END_CRIT_SECTION();
+        UnlockReleaseBuffer(buf);
+    }
+}
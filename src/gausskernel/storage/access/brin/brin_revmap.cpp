@@ -0,0 +1,365 @@
+/* -------------------------------------------------------------------------
+ *
+ * brin_revmap.cpp
+ *	  Range map of a BRIN index: from a heap block to the TID of the summary
+ *	  tuple of its range.
+ *
+ * The map is an array of TIDs, one per range, spread over revmap pages.  The
+ * revmap pages are found through directory pages, whose block numbers are
+ * kept on the metapage.  Both kinds of pages are allocated on demand at the
+ * end of the index and never move or go away afterwards, which lets us cache
+ * the block number of the revmap page used last.
+ *
+ * A zeroed TID means the range has not been summarized.
+ *
+ * Portions Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ *
+ * IDENTIFICATION
+ *	  src/gausskernel/storage/access/brin/brin_revmap.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+#include "postgres.h"
+#include "knl/knl_variable.h"
+
+#include "access/brin_private.h"
+#include "access/heapam.h"
+#include "miscadmin.h"
+#include "utils/rel.h"
+
+struct BrinRevmap {
+    Relation rm_irel;
+    BlockNumber rm_pagesPerRange;
+    bool rm_logged;            /* WAL-log changes to the map */
+    Buffer rm_metaBuf;         /* pinned for the life of the revmap */
+    Buffer rm_currBuf;         /* revmap page used last, pinned */
+    BlockNumber rm_lastMapIdx; /* logical index of that revmap page ... */
+    BlockNumber rm_lastMapBlk; /* ... and its block number */
+};
+
+#define REVMAP_RANGE_NO(revmap, heapBlk) ((heapBlk) / (revmap)->rm_pagesPerRange)
+
+static void revmap_check_page_type(Relation irel, Page page, BlockNumber blkno, uint16 type)
+{
+    if (PageIsNew(page) || BrinPageType(page) != type)
+        ereport(ERROR, (errcode(ERRCODE_INDEX_CORRUPTED),
+                        errmsg("unexpected page type 0x%04X in BRIN index \"%s\" block %u",
+                               PageIsNew(page) ? 0 : BrinPageType(page), RelationGetRelationName(irel), blkno)));
+}
+
+/*
+ * Return the block number of the revmap page covering heapBlk, or
+ * InvalidBlockNumber if it has not been allocated yet.
+ */
+static BlockNumber revmap_get_blkno(BrinRevmap *revmap, BlockNumber heapBlk)
+{
+    BlockNumber mapIdx = REVMAP_RANGE_NO(revmap, heapBlk) / BRIN_REVMAP_PAGE_MAXITEMS;
+    BlockNumber dirIdx = mapIdx / BRIN_DIR_PAGE_MAXITEMS;
+    BlockNumber dirBlk;
+    BlockNumber mapBlk;
+    Buffer dirBuf;
+    Page page;
+
+    if (mapIdx == revmap->rm_lastMapIdx)
+        return revmap->rm_lastMapBlk;
+
+    Assert(dirIdx < BRIN_META_MAX_DIRS);
+
+    LockBuffer(revmap->rm_metaBuf, BUFFER_LOCK_SHARE);
+    dirBlk = BrinPageGetMeta(BufferGetPage(revmap->rm_metaBuf))->dirPages[dirIdx];
+    LockBuffer(revmap->rm_metaBuf, BUFFER_LOCK_UNLOCK);
+
+    if (dirBlk == InvalidBlockNumber)
+        return InvalidBlockNumber;
+
+    dirBuf = ReadBuffer(revmap->rm_irel, dirBlk);
+    LockBuffer(dirBuf, BUFFER_LOCK_SHARE);
+    page = BufferGetPage(dirBuf);
+    revmap_check_page_type(revmap->rm_irel, page, dirBlk, BRIN_PAGETYPE_DIR);
+    mapBlk = BrinDirPageGetItems(page)[mapIdx % BRIN_DIR_PAGE_MAXITEMS];
+    UnlockReleaseBuffer(dirBuf);
+
+    if (mapBlk != InvalidBlockNumber) {
+        revmap->rm_lastMapIdx = mapIdx;
+        revmap->rm_lastMapBlk = mapBlk;
+    }
+    return mapBlk;
+}
+
+/*
+ * Pin the given revmap page, keeping the pin in rm_currBuf.
+ */
+static Buffer revmap_pin_page(BrinRevmap *revmap, BlockNumber mapBlk)
+{
+    if (BufferIsValid(revmap->rm_currBuf)) {
+        if (BufferGetBlockNumber(revmap->rm_currBuf) == mapBlk)
+            return revmap->rm_currBuf;
+        ReleaseBuffer(revmap->rm_currBuf);
+    }
+    revmap->rm_currBuf = ReadBuffer(revmap->rm_irel, mapBlk);
+    return revmap->rm_currBuf;
+}
+
+/*
+ * Prepare to access the range map of a BRIN index.  The pages-per-range
+ * setting stored on the metapage is returned in *pagesPerRange.  Changes
+ * are WAL-logged only if logChanges is true; an index build passes false
+ * and logs all pages once it is done.
+ */
+BrinRevmap *brinRevmapInitialize(Relation idxrel, BlockNumber *pagesPerRange, bool logChanges)
+{
+    BrinRevmap *revmap = NULL;
+    BrinMetaPageData *metadata = NULL;
+    Buffer meta;
+    Page page;
+
+    meta = ReadBuffer(idxrel, BRIN_METAPAGE_BLKNO);
+    LockBuffer(meta, BUFFER_LOCK_SHARE);
+    page = BufferGetPage(meta);
+    metadata = BrinPageGetMeta(page);
+
+    if (PageIsNew(page) || !BRIN_IS_META_PAGE(page) || metadata->brinMagic != BRIN_META_MAGIC)
+        ereport(ERROR, (errcode(ERRCODE_INDEX_CORRUPTED),
+                        errmsg("index \"%s\" is not a BRIN index", RelationGetRelationName(idxrel))));
+    if (metadata->brinVersion != BRIN_CURRENT_VERSION)
+        ereport(ERROR, (errcode(ERRCODE_INDEX_CORRUPTED),
+                        errmsg("BRIN index \"%s\" has version %u, expected %d", RelationGetRelationName(idxrel),
+                               metadata->brinVersion, BRIN_CURRENT_VERSION)));
+
+    revmap = (BrinRevmap *)palloc(sizeof(BrinRevmap));
+    revmap->rm_irel = idxrel;
+    revmap->rm_pagesPerRange = metadata->pagesPerRange;
+    revmap->rm_logged = logChanges && RelationNeedsWAL(idxrel);
+    revmap->rm_metaBuf = meta;
+    revmap->rm_currBuf = InvalidBuffer;
+    revmap->rm_lastMapIdx = InvalidBlockNumber;
+    revmap->rm_lastMapBlk = InvalidBlockNumber;
+
+    LockBuffer(meta, BUFFER_LOCK_UNLOCK);
+
+    *pagesPerRange = revmap->rm_pagesPerRange;
+    return revmap;
+}
+
+void brinRevmapTerminate(BrinRevmap *revmap)
+{
+    ReleaseBuffer(revmap->rm_metaBuf);
+    if (BufferIsValid(revmap->rm_currBuf))
+        ReleaseBuffer(revmap->rm_currBuf);
+    pfree(revmap);
+}
+
+bool brinRevmapLogChanges(const BrinRevmap *revmap)
+{
+    return revmap->rm_logged;
+}
+
+/*
+ * Make sure the revmap page covering heapBlk exists, allocating it (and its
+ * directory page) if necessary.  Must be called without any buffer lock of
+ * the index held, as it may have to extend the relation.
+ */
+void brinRevmapExtend(BrinRevmap *revmap, BlockNumber heapBlk)
+{
+    Relation irel = revmap->rm_irel;
+    BlockNumber mapIdx = REVMAP_RANGE_NO(revmap, heapBlk) / BRIN_REVMAP_PAGE_MAXITEMS;
+    BlockNumber dirIdx = mapIdx / BRIN_DIR_PAGE_MAXITEMS;
+    BlockNumber dirSlot = mapIdx % BRIN_DIR_PAGE_MAXITEMS;
+    Buffer metaBuf = revmap->rm_metaBuf;
+    BrinMetaPageData *metadata = NULL;
+    BlockNumber *dirItems = NULL;
+    BlockNumber dirBlk;
+    Buffer dirBuf;
+
+    if (revmap_get_blkno(revmap, heapBlk) != InvalidBlockNumber)
+        return;
+
+    if (dirIdx >= BRIN_META_MAX_DIRS)
+        ereport(ERROR, (errcode(ERRCODE_PROGRAM_LIMIT_EXCEEDED),
+                        errmsg("heap block %u is out of range for BRIN index \"%s\"", heapBlk,
+                               RelationGetRelationName(irel))));
+
+    /*
+     * The metapage lock serializes allocation of directory pages, and the
+     * directory page lock that of the revmap pages it points to.
+     */
+    LockBuffer(metaBuf, BUFFER_LOCK_EXCLUSIVE);
+    metadata = BrinPageGetMeta(BufferGetPage(metaBuf));
+    dirBlk = metadata->dirPages[dirIdx];
+    if (dirBlk == InvalidBlockNumber) {
+        dirBuf = brin_extend_relation(irel);
+        dirBlk = BufferGetBlockNumber(dirBuf);
+
+        START_CRIT_SECTION();
+        brin_page_init(BufferGetPage(dirBuf), BRIN_PAGETYPE_DIR);
+        metadata->dirPages[dirIdx] = dirBlk;
+        MarkBufferDirty(dirBuf);
+        MarkBufferDirty(metaBuf);
+        if (revmap->rm_logged) {
+            (void)log_newpage_buffer(dirBuf, true);
+            (void)log_newpage_buffer(metaBuf, true);
+        }
+        END_CRIT_SECTION();
+    } else {
+        dirBuf = ReadBuffer(irel, dirBlk);
+        LockBuffer(dirBuf, BUFFER_LOCK_EXCLUSIVE);
+    }
+    LockBuffer(metaBuf, BUFFER_LOCK_UNLOCK);
+
+    revmap_check_page_type(irel, BufferGetPage(dirBuf), dirBlk, BRIN_PAGETYPE_DIR);
+    dirItems = BrinDirPageGetItems(BufferGetPage(dirBuf));
+    if (dirItems[dirSlot] == InvalidBlockNumber) {
+        Buffer mapBuf = brin_extend_relation(irel);
+
+        START_CRIT_SECTION();
+        brin_page_init(BufferGetPage(mapBuf), BRIN_PAGETYPE_REVMAP);
+        dirItems[dirSlot] = BufferGetBlockNumber(mapBuf);
+        MarkBufferDirty(mapBuf);
+        MarkBufferDirty(dirBuf);
+        if (revmap->rm_logged) {
+            (void)log_newpage_buffer(mapBuf, true);
+            (void)log_newpage_buffer(dirBuf, true);
+        }
+        END_CRIT_SECTION();
+
+        UnlockReleaseBuffer(mapBuf);
+    }
+    UnlockReleaseBuffer(dirBuf);
+}
+
+/*
+ * Lock the revmap page covering heapBlk in exclusive mode and return it.  The
+ * page must exist already, see brinRevmapExtend.  The caller unlocks it, but
+ * must not release it: the pin belongs to the revmap.
+ */
+Buffer brinLockRevmapPageForUpdate(BrinRevmap *revmap, BlockNumber heapBlk)
+{
+    BlockNumber mapBlk = revmap_get_blkno(revmap, heapBlk);
+    Buffer rmbuf;
+
+    if (mapBlk == InvalidBlockNumber)
+        ereport(ERROR, (errcode(ERRCODE_INDEX_CORRUPTED),
+                        errmsg("revmap page for heap block %u of BRIN index \"%s\" does not exist", heapBlk,
+                               RelationGetRelationName(revmap->rm_irel))));
+
+    rmbuf = revmap_pin_page(revmap, mapBlk);
+    LockBuffer(rmbuf, BUFFER_LOCK_EXCLUSIVE);
+    revmap_check_page_type(revmap->rm_irel, BufferGetPage(rmbuf), mapBlk, BRIN_PAGETYPE_REVMAP);
+    return rmbuf;
+}
+
+/*
+ * Read the map entry of heapBlk's range from a locked revmap page.  Returns
+ * false if the range is not summarized.
+ */
+bool brinRevmapGetItem(Buffer rmbuf, BlockNumber pagesPerRange, BlockNumber heapBlk, ItemPointer tid)
+{
+    ItemPointerData *items = BrinRevmapPageGetItems(BufferGetPage(rmbuf));
+
+    *tid = items[(heapBlk / pagesPerRange) % BRIN_REVMAP_PAGE_MAXITEMS];
+    return ItemPointerIsValid(tid);
+}
+
+/*
+ * Set the map entry of heapBlk's range on an exclusively locked revmap page.
+ * The caller marks the buffer dirty and logs it.
+ */
+void brinSetHeapBlockItemptr(Buffer rmbuf, BlockNumber pagesPerRange, BlockNumber heapBlk, ItemPointerData tid)
+{
+    ItemPointerData *items = BrinRevmapPageGetItems(BufferGetPage(rmbuf));
+
+    items[(heapBlk / pagesPerRange) % BRIN_REVMAP_PAGE_MAXITEMS] = tid;
+}
+
+/*
+ * Look up the TID of the summary tuple of heapBlk's range.  Returns false if
+ * the range is not summarized.  Only the revmap page is locked, and only for
+ * the duration of the call.
+ */
+bool brinRevmapGetTid(BrinRevmap *revmap, BlockNumber heapBlk, ItemPointer tid)
+{
+    BlockNumber mapBlk = revmap_get_blkno(revmap, heapBlk);
+    Buffer rmbuf;
+    bool found = false;
+
+    if (mapBlk == InvalidBlockNumber) {
+        ItemPointerSetInvalid(tid);
+        return false;
+    }
+
+    rmbuf = revmap_pin_page(revmap, mapBlk);
+    LockBuffer(rmbuf, BUFFER_LOCK_SHARE);
+    revmap_check_page_type(revmap->rm_irel, BufferGetPage(rmbuf), mapBlk, BRIN_PAGETYPE_REVMAP);
+    found = brinRevmapGetItem(rmbuf, revmap->rm_pagesPerRange, heapBlk, tid);
+    LockBuffer(rmbuf, BUFFER_LOCK_UNLOCK);
+
+    return found;
+}
+
+/*
+ * Fetch the summary tuple of heapBlk's range.  On success the tuple is
+ * returned pointing into *buf, which is left locked in the given mode; its
+ * offset and length are returned in *off and *size.  Returns NULL, with no
+ * lock held, if the range is not summarized.
+ *
+ * *buf may hold a pinned buffer on entry, which is reused if it is the right
+ * one and released otherwise.  The caller releases the final buffer.
+ *
+ * The summary may move between reading the map and locking the data page, in
+ * which case we simply look it up again.
+ */
+BrinTuple *brinGetTupleForHeapBlock(BrinRevmap *revmap, BlockNumber heapBlk, Buffer *buf, OffsetNumber *off,
+                                    Size *size, int mode)
+{
+    Relation irel = revmap->rm_irel;
+    ItemPointerData previptr;
+    ItemPointerData iptr;
+
+    heapBlk = REVMAP_RANGE_NO(revmap, heapBlk) * revmap->rm_pagesPerRange;
+    ItemPointerSetInvalid(&previptr);
+
+    for (;;) {
+        BlockNumber blk;
+        Page page;
+
+        CHECK_FOR_INTERRUPTS();
+
+        if (!brinRevmapGetTid(revmap, heapBlk, &iptr))
+            return NULL;
+
+        /* the map cannot keep pointing at a tuple that is not there */
+        if (ItemPointerEquals(&previptr, &iptr))
+            ereport(ERROR, (errcode(ERRCODE_INDEX_CORRUPTED),
+                            errmsg("corrupted BRIN index \"%s\": inconsistent range map for heap block %u",
+                                   RelationGetRelationName(irel), heapBlk)));
+        previptr = iptr;
+
+        blk = ItemPointerGetBlockNumber(&iptr);
+        *off = ItemPointerGetOffsetNumber(&iptr);
+
+        if (!BufferIsValid(*buf) || BufferGetBlockNumber(*buf) != blk) {
+            if (BufferIsValid(*buf))
+                ReleaseBuffer(*buf);
+            *buf = ReadBuffer(irel, blk);
+        }
+        LockBuffer(*buf, mode);
+        page = BufferGetPage(*buf);
+
+        if (!PageIsNew(page) && BRIN_IS_REGULAR_PAGE(page) && *off <= PageGetMaxOffsetNumber(page)) {
+            ItemId lp = PageGetItemId(page, *off);
+
+            if (ItemIdIsUsed(lp)) {
+                BrinTuple *tup = (BrinTuple *)PageGetItem(page, lp);
+
+                if (tup->bt_blkno == heapBlk) {
+                    if (size != NULL)
+                        *size = ItemIdGetLength(lp);
+                    return tup;
+                }
+            }
+        }
+
+        LockBuffer(*buf, BUFFER_LOCK_UNLOCK);
+    }
+}
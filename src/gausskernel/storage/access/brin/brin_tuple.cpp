@@ -0,0 +1,210 @@
+/* -------------------------------------------------------------------------
+ *
+ * brin_tuple.cpp
+ *	  Conversion between on-disk BRIN summary tuples and their in-memory form.
+ *
+ * The on-disk tuple is a small header followed by a heap tuple image over
+ * BrinDesc->bd_disktdesc.  Varlena values are detoasted before they are
+ * stored, so that the summary never points into TOAST.
+ *
+ * Portions Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ *
+ * IDENTIFICATION
+ *	  src/gausskernel/storage/access/brin/brin_tuple.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+#include "postgres.h"
+#include "knl/knl_variable.h"
+
+#include "access/brin_private.h"
+#include "access/tuptoaster.h"
+#include "utils/datum.h"
+#include "utils/memutils.h"
+
+/*
+ * Build an on-disk tuple from the in-memory summary.  The tuple is palloc'd
+ * in the caller's context and its length returned in *size.
+ */
+BrinTuple *brin_form_tuple(BrinDesc *bdesc, BlockNumber blkno, BrinMemTuple *dtup, Size *size)
+{
+    int natts = bdesc->bd_disktdesc->natts;
+    Datum *values = (Datum *)palloc(sizeof(Datum) * natts);
+    bool *nulls = (bool *)palloc(sizeof(bool) * natts);
+    int keyno = 0;
+    HeapTuple htup;
+    BrinTuple *result = NULL;
+    Size len;
+    errno_t rc;
+
+    for (int i = 0; i < bdesc->bd_tupdesc->natts; i++) {
+        BrinOpcInfo *info = bdesc->bd_info[i];
+        BrinValues *column = &dtup->bt_columns[i];
+
+        values[keyno] = BoolGetDatum(column->bv_allnulls);
+        nulls[keyno++] = false;
+        values[keyno] = BoolGetDatum(column->bv_hasnulls);
+        nulls[keyno++] = false;
+
+        for (int datumno = 0; datumno < info->oi_nstored; datumno++) {
+            Datum value = column->bv_values[datumno];
+
+            if (column->bv_allnulls) {
+                values[keyno] = (Datum)0;
+                nulls[keyno++] = true;
+                continue;
+            }
+
+            if (info->oi_typcache[datumno]->typlen == -1)
+                value = PointerGetDatum(PG_DETOAST_DATUM(value));
+            values[keyno] = value;
+            nulls[keyno++] = false;
+        }
+    }
+    Assert(keyno == natts);
+
+    htup = heap_form_tuple(bdesc->bd_disktdesc, values, nulls);
+
+    len = SizeOfBrinTuple + htup->t_len;
+    result = (BrinTuple *)palloc0(len);
+    result->bt_blkno = blkno;
+    if (dtup->bt_placeholder)
+        result->bt_flags |= BRIN_PLACEHOLDER_MASK;
+    rc = memcpy_s(BrinTupleGetData(result), htup->t_len, htup->t_data, htup->t_len);
+    securec_check(rc, "", "");
+
+    heap_freetuple(htup);
+    pfree(values);
+    pfree(nulls);
+
+    *size = len;
+    return result;
+}
+
+/*
+ * Build the placeholder tuple a summarization inserts before it scans the
+ * heap range.
+ */
+BrinTuple *brin_form_placeholder_tuple(BrinDesc *bdesc, BlockNumber blkno, Size *size)
+{
+    BrinMemTuple *dtup = brin_new_memtuple(bdesc);
+    BrinTuple *result = NULL;
+
+    dtup->bt_placeholder = true;
+    result = brin_form_tuple(bdesc, blkno, dtup, size);
+    brin_free_memtuple(dtup);
+
+    return result;
+}
+
+BrinTuple *brin_copy_tuple(const BrinTuple *tuple, Size len)
+{
+    BrinTuple *result = (BrinTuple *)palloc(len);
+    errno_t rc = memcpy_s(result, len, tuple, len);
+    securec_check(rc, "", "");
+    return result;
+}
+
+bool brin_tuples_equal(const BrinTuple *a, Size alen, const BrinTuple *b, Size blen)
+{
+    if (alen != blen)
+        return false;
+    return memcmp(a, b, alen) == 0;
+}
+
+/*
+ * Create an empty in-memory summary.  Column values live in their own
+ * context, so that resetting the tuple does not leak.
+ */
+BrinMemTuple *brin_new_memtuple(BrinDesc *bdesc)
+{
+    Size basesize = MAXALIGN(offsetof(BrinMemTuple, bt_columns) + sizeof(BrinValues) * bdesc->bd_tupdesc->natts);
+    BrinMemTuple *dtup = (BrinMemTuple *)palloc0(basesize + sizeof(Datum) * bdesc->bd_totalstored);
+    Datum *currdatum = (Datum *)((char *)dtup + basesize);
+
+    for (int i = 0; i < bdesc->bd_tupdesc->natts; i++) {
+        dtup->bt_columns[i].bv_attno = i + 1;
+        dtup->bt_columns[i].bv_values = currdatum;
+        currdatum += bdesc->bd_info[i]->oi_nstored;
+    }
+
+    dtup->bt_context = AllocSetContextCreate(CurrentMemoryContext, "brin dtuple", ALLOCSET_SMALL_MINSIZE,
+                                             ALLOCSET_SMALL_INITSIZE, ALLOCSET_SMALL_MAXSIZE);
+    brin_memtuple_initialize(dtup, bdesc);
+    return dtup;
+}
+
+/*
+ * Reset an in-memory summary to the state of a range with no tuples.
+ */
+void brin_memtuple_initialize(BrinMemTuple *dtup, BrinDesc *bdesc)
+{
+    MemoryContextReset(dtup->bt_context);
+
+    dtup->bt_placeholder = false;
+    dtup->bt_blkno = InvalidBlockNumber;
+    for (int i = 0; i < bdesc->bd_tupdesc->natts; i++) {
+        dtup->bt_columns[i].bv_allnulls = true;
+        dtup->bt_columns[i].bv_hasnulls = false;
+    }
+}
+
+/*
+ * Convert an on-disk tuple, which may point into a locked buffer, into an
+ * in-memory summary.  The values are copied, so the buffer may be released
+ * afterwards.
+ */
+BrinMemTuple *brin_deform_tuple(BrinDesc *bdesc, const BrinTuple *tuple, Size len)
+{
+    BrinMemTuple *dtup = brin_new_memtuple(bdesc);
+    int natts = bdesc->bd_disktdesc->natts;
+    Datum *values = (Datum *)palloc(sizeof(Datum) * natts);
+    bool *nulls = (bool *)palloc(sizeof(bool) * natts);
+    HeapTupleData htup;
+    MemoryContext oldcxt;
+    int keyno = 0;
+    errno_t rc;
+
+    Assert(len > SizeOfBrinTuple);
+
+    rc = memset_s(&htup, sizeof(HeapTupleData), 0, sizeof(HeapTupleData));
+    securec_check(rc, "", "");
+    htup.t_len = (uint32)(len - SizeOfBrinTuple);
+    htup.t_data = BrinTupleGetData(tuple);
+    heap_deform_tuple(&htup, bdesc->bd_disktdesc, values, nulls);
+
+    dtup->bt_placeholder = BrinTupleIsPlaceholder(tuple);
+    dtup->bt_blkno = tuple->bt_blkno;
+
+    oldcxt = MemoryContextSwitchTo(dtup->bt_context);
+    for (int i = 0; i < bdesc->bd_tupdesc->natts; i++) {
+        BrinOpcInfo *info = bdesc->bd_info[i];
+        BrinValues *column = &dtup->bt_columns[i];
+
+        column->bv_allnulls = DatumGetBool(values[keyno++]);
+        column->bv_hasnulls = DatumGetBool(values[keyno++]);
+
+        for (int datumno = 0; datumno < info->oi_nstored; datumno++) {
+            TypeCacheEntry *typcache = info->oi_typcache[datumno];
+
+            if (!column->bv_allnulls) {
+                Assert(!nulls[keyno]);
+                column->bv_values[datumno] = datumCopy(values[keyno], typcache->typbyval, typcache->typlen);
+            }
+            keyno++;
+        }
+    }
+    (void)MemoryContextSwitchTo(oldcxt);
+
+    pfree(values);
+    pfree(nulls);
+
+    return dtup;
+}
+
+void brin_free_memtuple(BrinMemTuple *dtup)
+{
+    MemoryContextDelete(dtup->bt_context);
+    pfree(dtup);
+}
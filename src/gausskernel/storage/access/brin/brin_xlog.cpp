@@ -0,0 +1,132 @@
+/* -------------------------------------------------------------------------
+ *
+ * brin_xlog.cpp
+ *	  WAL replay logic for BRIN indexes
+ *
+ * Portions Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ *
+ * IDENTIFICATION
+ *	  src/gausskernel/storage/access/brin/brin_xlog.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+#include "postgres.h"
+#include "knl/knl_variable.h"
+
+#include "access/brin_private.h"
+#include "access/xlogutils.h"
+#include "access/xlogproc.h"
+
+static void brin_redo_add_tuple(RedoBufferInfo *buffer, OffsetNumber offnum, Item tuple, Size size)
+{
+    Page page = buffer->pageinfo.page;
+
+    if (PageAddItem(page, tuple, size, offnum, true, false) != offnum)
+        ereport(PANIC, (errcode(ERRCODE_INDEX_CORRUPTED),
+                        errmsg("brin_redo: failed to add tuple at offset %u of block %u", (uint32)offnum,
+                               buffer->blockinfo.blkno)));
+}
+
+/*
+ * Common part of the replay of an insertion and of a move: add the tuple to
+ * block 0 and point the range map on block 1 at it.
+ */
+static void brin_redo_insert_update(XLogReaderState *record, const xl_brin_insert *xlrec)
+{
+    uint8 info = XLogRecGetInfo(record) & ~XLR_INFO_MASK;
+    RedoBufferInfo buffer;
+    XLogRedoAction action;
+    BlockNumber blkno = InvalidBlockNumber;
+
+    if (info & XLOG_BRIN_INIT_PAGE) {
+        XLogInitBufferForRedo(record, 0, &buffer);
+        brin_page_init(buffer.pageinfo.page, BRIN_PAGETYPE_REGULAR);
+        action = BLK_NEEDS_REDO;
+    } else {
+        action = XLogReadBufferForRedo(record, 0, &buffer);
+    }
+
+    if (action == BLK_NEEDS_REDO) {
+        Size len;
+        char *tuple = XLogRecGetBlockData(record, 0, &len);
+
+        brin_redo_add_tuple(&buffer, xlrec->offnum, (Item)tuple, len);
+        PageSetLSN(buffer.pageinfo.page, buffer.lsn);
+        MarkBufferDirty(buffer.buf);
+    }
+    if (BufferIsValid(buffer.buf))
+        UnlockReleaseBuffer(buffer.buf);
+
+    (void)XLogRecGetBlockTag(record, 0, NULL, NULL, &blkno);
+
+    if (XLogReadBufferForRedo(record, 1, &buffer) == BLK_NEEDS_REDO) {
+        ItemPointerData *items = BrinRevmapPageGetItems(buffer.pageinfo.page);
+
+        ItemPointerSet(&items[(xlrec->heapBlk / xlrec->pagesPerRange) % BRIN_REVMAP_PAGE_MAXITEMS], blkno,
+                       xlrec->offnum);
+        PageSetLSN(buffer.pageinfo.page, buffer.lsn);
+        MarkBufferDirty(buffer.buf);
+    }
+    if (BufferIsValid(buffer.buf))
+        UnlockReleaseBuffer(buffer.buf);
+}
+
+static void brin_redo_update(XLogReaderState *record)
+{
+    xl_brin_update *xlrec = (xl_brin_update *)XLogRecGetData(record);
+    RedoBufferInfo buffer;
+
+    /* the old tuple is removed the same way brin_doupdate does */
+    if (XLogReadBufferForRedo(record, 2, &buffer) == BLK_NEEDS_REDO) {
+        Page page = buffer.pageinfo.page;
+
+        ItemIdSetUnused(PageGetItemId(page, xlrec->oldOffnum));
+        PageRepairFragmentation(page);
+        PageSetLSN(page, buffer.lsn);
+        MarkBufferDirty(buffer.buf);
+    }
+    if (BufferIsValid(buffer.buf))
+        UnlockReleaseBuffer(buffer.buf);
+
+    brin_redo_insert_update(record, &xlrec->insert);
+}
+
+static void brin_redo_samepage_update(XLogReaderState *record)
+{
+    xl_brin_samepage_update *xlrec = (xl_brin_samepage_update *)XLogRecGetData(record);
+    RedoBufferInfo buffer;
+
+    if (XLogReadBufferForRedo(record, 0, &buffer) == BLK_NEEDS_REDO) {
+        Page page = buffer.pageinfo.page;
+        Size len;
+        char *tuple = XLogRecGetBlockData(record, 0, &len);
+
+        ItemIdSetUnused(PageGetItemId(page, xlrec->offnum));
+        PageRepairFragmentation(page);
+        brin_redo_add_tuple(&buffer, xlrec->offnum, (Item)tuple, len);
+        PageSetLSN(page, buffer.lsn);
+        MarkBufferDirty(buffer.buf);
+    }
+    if (BufferIsValid(buffer.buf))
+        UnlockReleaseBuffer(buffer.buf);
+}
+
+void brin_redo(XLogReaderState *record)
+{
+    uint8 info = XLogRecGetInfo(record) & ~XLR_INFO_MASK;
+
+    switch (info & XLOG_BRIN_OPMASK) {
+        case XLOG_BRIN_INSERT:
+            brin_redo_insert_update(record, (xl_brin_insert *)XLogRecGetData(record));
+            break;
+        case XLOG_BRIN_UPDATE:
+            brin_redo_update(record);
+            break;
+        case XLOG_BRIN_SAMEPAGE_UPDATE:
+            brin_redo_samepage_update(record);
+            break;
+        default:
+            ereport(PANIC, (errmsg("brin_redo: unknown op code %u", (uint32)info)));
+    }
+}
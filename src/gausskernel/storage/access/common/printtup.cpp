@@ -34,10 +34,13 @@
 #include "distributelayer/streamProducer.h"
 #include "executor/execStream.h"
 #include "access/heapam.h"
+#include "utils/date.h"
+#include "utils/datetime.h"
 
 static void printtup_startup(DestReceiver *self, int operation, TupleDesc typeinfo);
 static void printtup_20(TupleTableSlot *slot, DestReceiver *self);
 static void printtup_internal_20(TupleTableSlot *slot, DestReceiver *self);
+static void printtupRowBatch(TupleDesc typeinfo, Datum *values, bool *isnull, int nrows, DestReceiver *self);
 static void printtup_shutdown(DestReceiver *self);
 static void printtup_destroy(DestReceiver *self);
 
@@ -387,10 +390,13 @@ DestReceiver *printtup_create_DR(CommandDest dest)
 {
     DR_printtup *self = (DR_printtup *)palloc0(sizeof(DR_printtup));
 
-    if (StreamTopConsumerAmI() == true)
+    if (StreamTopConsumerAmI() == true) {
         self->pub.receiveSlot = printtupStream;
-    else
+        self->pub.receiveRowBatch = NULL;
+    } else {
         self->pub.receiveSlot = printtup; /* might get changed later */
+        self->pub.receiveRowBatch = printtupRowBatch;
+    }
 
     self->pub.sendBatch = printBatch;
     self->pub.rStartup = printtup_startup;
@@ -435,6 +441,7 @@ void SetRemoteDestReceiverParams(DestReceiver *self, Portal portal)
             myState->pub.receiveSlot = printtup_internal_20;
         else
             myState->pub.receiveSlot = printtup_20;
+        myState->pub.receiveRowBatch = NULL;
     }
 }
 
@@ -1092,6 +1099,241 @@ void printtup(TupleTableSlot *slot, DestReceiver *self)
     pq_endmessage_reuse(buf);
 }
 
+/*
+ * How a column of a row batch is put into the DataRow messages
+ */
+typedef enum {
+    BATCH_COL_TEXT,  /* counted text, converted to the client encoding */
+    BATCH_COL_BYTES, /* counted bytes sent as is */
+    BATCH_COL_INT2,  /* binary int2 taken from the Datum */
+    BATCH_COL_INT4,  /* binary int4 or date taken from the Datum */
+    BATCH_COL_INT8   /* binary int8 taken from the Datum */
+} BatchColKind;
+
+typedef struct {
+    BatchColKind kind;
+    char **data; /* formatted value of each row, unused for binary ints */
+    int *len;
+} PrinttupBatchCol;
+
+/* MAXINT8LEN plus sign and terminator */
+#define BATCH_INT_TEXT_LEN 32
+
+/*
+ * Format one column of a row batch. values/isnull point at the column's entry
+ * of the first row and advance by natts per row.
+ */
+static void printtup_format_batch_col(PrinttupAttrInfo *thisState, Form_pg_attribute attr, const Datum *values,
+                                      const bool *isnull, int natts, int nrows, PrinttupBatchCol *col)
+{
+    Oid typid = attr->atttypid;
+    int row;
+
+    col->data = (char **)palloc0(nrows * sizeof(char *));
+    col->len = (int *)palloc0(nrows * sizeof(int));
+
+    if (thisState->format != 0) {
+        switch (typid) {
+            case INT2OID:
+                col->kind = BATCH_COL_INT2;
+                return;
+            case INT4OID:
+            case DATEOID:
+                col->kind = BATCH_COL_INT4;
+                return;
+            case INT8OID:
+                col->kind = BATCH_COL_INT8;
+                return;
+            default:
+                break;
+        }
+    }
+
+    switch (typid) {
+        case INT2OID:
+        case INT4OID:
+        case INT8OID: {
+            char *area = (char *)palloc(nrows * BATCH_INT_TEXT_LEN);
+
+            col->kind = BATCH_COL_BYTES;
+            for (row = 0; row < nrows; row++) {
+                Datum val = values[row * natts];
+                char *str = area + row * BATCH_INT_TEXT_LEN;
+
+                if (isnull[row * natts])
+                    continue;
+                if (typid == INT8OID)
+                    pg_lltoa(DatumGetInt64(val), str);
+                else if (typid == INT4OID)
+                    pg_ltoa(DatumGetInt32(val), str);
+                else
+                    pg_itoa(DatumGetInt16(val), str);
+                col->data[row] = str;
+                col->len[row] = strlen(str);
+            }
+            return;
+        }
+        case DATEOID: {
+            char *area = (char *)palloc(nrows * (MAXDATELEN + 1));
+            struct pg_tm tt, *tm = &tt;
+
+            col->kind = BATCH_COL_BYTES;
+            for (row = 0; row < nrows; row++) {
+                DateADT date = DatumGetDateADT(values[row * natts]);
+                char *str = area + row * (MAXDATELEN + 1);
+
+                if (isnull[row * natts])
+                    continue;
+                if (DATE_NOT_FINITE(date) || (date > 0 && (INT_MAX - date < POSTGRES_EPOCH_JDATE))) {
+                    /* let date_out deal with infinity and report overflow */
+                    str = OutputFunctionCall(&thisState->finfo, DateADTGetDatum(date));
+                } else {
+                    j2date(date + POSTGRES_EPOCH_JDATE, &(tm->tm_year), &(tm->tm_mon), &(tm->tm_mday));
+                    EncodeDateOnly(tm, u_sess->time_cxt.DateStyle, str);
+                }
+                col->data[row] = str;
+                col->len[row] = strlen(str);
+            }
+            return;
+        }
+        case TEXTOID:
+        case VARCHAROID:
+        case BPCHAROID: {
+            /* the text and binary forms of these are both the raw string */
+            col->kind = BATCH_COL_TEXT;
+            for (row = 0; row < nrows; row++) {
+                struct varlena *v = NULL;
+
+                if (isnull[row * natts])
+                    continue;
+                v = pg_detoast_datum_packed((struct varlena *)DatumGetPointer(values[row * natts]));
+                col->data[row] = VARDATA_ANY(v);
+                col->len[row] = VARSIZE_ANY_EXHDR(v);
+            }
+            return;
+        }
+        case NUMERICOID:
+            if (thisState->format == 0) {
+                /* numeric_out prints the big-integer form of vector numerics directly */
+                col->kind = BATCH_COL_BYTES;
+                for (row = 0; row < nrows; row++) {
+                    if (isnull[row * natts])
+                        continue;
+                    col->data[row] = DatumGetCString(DirectFunctionCall1(numeric_out, values[row * natts]));
+                    col->len[row] = strlen(col->data[row]);
+                }
+                return;
+            }
+            break;
+        default:
+            break;
+    }
+
+    /* everything else goes through the type's output function */
+    col->kind = (thisState->format == 0) ? BATCH_COL_TEXT : BATCH_COL_BYTES;
+    for (row = 0; row < nrows; row++) {
+        Datum attrval = values[row * natts];
+
+        if (isnull[row * natts])
+            continue;
+        if (thisState->typisvarlena)
+            attrval = PointerGetDatum(PG_DETOAST_DATUM(attrval));
+
+        if (thisState->format == 0) {
+            col->data[row] = OutputFunctionCall(&thisState->finfo, attrval);
+            col->len[row] = strlen(col->data[row]);
+        } else {
+            bytea *outputbytes = SendFunctionCall(&thisState->finfo, attrval);
+
+            col->data[row] = VARDATA(outputbytes);
+            col->len[row] = VARSIZE(outputbytes) - VARHDRSZ;
+        }
+    }
+}
+
+/* ----------------
+ *		printtupRowBatch --- print a batch of devectorized rows in protocol 3.0
+ *
+ * Each column is formatted for the whole batch first, so the type dispatch
+ * and output function lookups are paid once per batch, and then the DataRow
+ * messages are assembled from the formatted columns. Everything formatted
+ * lives in the per-tuple context, which the executor resets per batch.
+ * ----------------
+ */
+static void printtupRowBatch(TupleDesc typeinfo, Datum *values, bool *isnull, int nrows, DestReceiver *self)
+{
+    DR_printtup *myState = (DR_printtup *)self;
+    StringInfo buf = &myState->buf;
+    int natts = typeinfo->natts;
+    PrinttupBatchCol *cols = NULL;
+    int i;
+    int row;
+
+    StreamTimeSerilizeStart(t_thrd.pgxc_cxt.GlobalNetInstr);
+    /* Set or update my derived attribute info, if needed */
+    if (myState->attrinfo != typeinfo || myState->nattrs != natts)
+        printtup_prepare_info(myState, typeinfo, natts);
+
+    MemoryContext old_context = changeToTmpContext(self);
+
+    cols = (PrinttupBatchCol *)palloc(natts * sizeof(PrinttupBatchCol));
+    for (i = 0; i < natts; ++i) {
+        if (typeinfo->attrs[i]->attisdropped) {
+            cols[i].kind = BATCH_COL_BYTES;
+            cols[i].data = (char **)palloc0(nrows * sizeof(char *));
+            cols[i].len = NULL;
+            continue;
+        }
+        printtup_format_batch_col(myState->myinfo + i, typeinfo->attrs[i], values + i, isnull + i, natts, nrows,
+                                  cols + i);
+    }
+
+    for (row = 0; row < nrows; row++) {
+        pq_beginmessage_reuse(buf, 'D');
+        pq_sendint16(buf, natts);
+
+        for (i = 0; i < natts; ++i) {
+            PrinttupBatchCol *col = cols + i;
+            Datum val = values[row * natts + i];
+
+            if (isnull[row * natts + i] || typeinfo->attrs[i]->attisdropped) {
+                pq_sendint32(buf, (uint32)-1);
+                continue;
+            }
+
+            switch (col->kind) {
+                case BATCH_COL_TEXT:
+                    pq_sendcountedtext(buf, col->data[row], col->len[row], false);
+                    break;
+                case BATCH_COL_BYTES:
+                    pq_sendint32(buf, col->len[row]);
+                    pq_sendbytes(buf, col->data[row], col->len[row]);
+                    break;
+                case BATCH_COL_INT2:
+                    pq_sendint32(buf, sizeof(int16));
+                    pq_sendint16(buf, DatumGetInt16(val));
+                    break;
+                case BATCH_COL_INT4:
+                    pq_sendint32(buf, sizeof(int32));
+                    pq_sendint32(buf, DatumGetInt32(val));
+                    break;
+                case BATCH_COL_INT8:
+                    pq_sendint32(buf, sizeof(int64));
+                    pq_sendint64(buf, DatumGetInt64(val));
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        AddCheckInfo(buf);
+        pq_endmessage_reuse(buf);
+    }
+
+    (void)MemoryContextSwitchTo(old_context);
+    StreamTimeSerilizeEnd(t_thrd.pgxc_cxt.GlobalNetInstr);
+}
+
 /* ----------------
  *		printtup_20 --- print a tuple in protocol 2.0
  * ----------------
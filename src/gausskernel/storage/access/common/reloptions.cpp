@@ -21,6 +21,7 @@
 #include "access/nbtree.h"
 #include "access/reloptions.h"
 #include "access/spgist.h"
+#include "access/toast_compression.h"
 #include "catalog/pg_ts_parser.h"
 #include "catalog/pg_type.h"
 #include "commands/defrem.h"
@@ -82,6 +83,8 @@ static relopt_bool boolRelOpts[] = {
        RELOPT_KIND_HEAP },
      false },
     {{ "fastupdate", "Enables \"fast update\" feature for this GIN index", RELOPT_KIND_GIN }, true },
+    {{ "deduplicate_items", "Enables \"deduplicate items\" feature for this btree index", RELOPT_KIND_BTREE }, false },
+    {{ "autosummarize", "Enables automatic summarization on this BRIN index", RELOPT_KIND_BRIN }, false },
     {{ "security_barrier", "View acts as a row security barrier", RELOPT_KIND_VIEW }, false },
     {{ "enable_rowsecurity", "Enable row level security or not", RELOPT_KIND_HEAP }, false },
     {{ "force_rowsecurity", "Row security forced for owners or not", RELOPT_KIND_HEAP }, false },
@@ -118,6 +121,14 @@ static relopt_int intRelOpts[] = {
      BTREE_DEFAULT_FILLFACTOR,
      BTREE_MIN_FILLFACTOR,
      100 },
+    {{ "parallel_workers", "Number of worker threads used to build this btree index", RELOPT_KIND_BTREE },
+     -1,
+     0,
+     64 },
+    {{ "parallel_workers", "Number of worker threads used to vacuum the indexes of this table", RELOPT_KIND_HEAP },
+     -1,
+     0,
+     64 },
     {{ "fillfactor", "Packs hash index pages only to this percentage", RELOPT_KIND_HASH },
      HASH_DEFAULT_FILLFACTOR,
      HASH_MIN_FILLFACTOR,
@@ -191,6 +202,10 @@ static relopt_int intRelOpts[] = {
      -1,
      64,
      MAX_KILOBYTES },
+    {{ "pages_per_range", "Number of pages that each page range covers in a BRIN index", RELOPT_KIND_BRIN },
+     128,
+     1,
+     131072 },
     {{ "gram_size", "Gram size for N-gram text search praser.", RELOPT_KIND_NPARSER }, 2, 1, 4 },
 
     /* COMPRESSLEVEL option */
@@ -286,6 +301,11 @@ static relopt_string stringRelOpts[] = {
      false,
      gistValidateBufferingOption,
      "auto" },
+    {{ "toast_compression", "Compression method for new values of the column", RELOPT_KIND_ATTRIBUTE },
+     0,
+     true,
+     ValidateToastCompressionOption,
+     NULL },
 
     {
         { "orientation", "row-store, col-store, orc-store or timeseries", RELOPT_KIND_HEAP },
@@ -1470,6 +1490,7 @@ void ForbidToSetOptionsForColTbl(List *options)
         "autovacuum_freeze_table_age",
         "autovacuum_vacuum_scale_factor",
         "security_barrier",
+        "parallel_workers",
         "enable_tsdb_delta",
         "tsdb_deltamerge_interval",
         "tsdb_deltamerge_threshold",
@@ -1592,6 +1613,8 @@ bytea *default_reloptions(Datum reloptions, bool validate, relopt_kind kind)
         { "sw_interval", RELOPT_TYPE_STRING, offsetof(StdRdOptions, sw_interval) },
         { "version", RELOPT_TYPE_STRING, offsetof(StdRdOptions, version) },
         { "compresslevel", RELOPT_TYPE_INT, offsetof(StdRdOptions, compresslevel) },
+        { "parallel_workers", RELOPT_TYPE_INT, offsetof(StdRdOptions, parallel_workers) },
+        { "deduplicate_items", RELOPT_TYPE_BOOL, offsetof(StdRdOptions, deduplicate_items) },
         { "ignore_enable_hadoop_env", RELOPT_TYPE_BOOL, offsetof(StdRdOptions, ignore_enable_hadoop_env) },
         { "append_mode", RELOPT_TYPE_STRING, offsetof(StdRdOptions, append_mode) },
         { "merge_list", RELOPT_TYPE_STRING, offsetof(StdRdOptions, merge_list) },
@@ -1713,7 +1736,8 @@ bytea *attribute_reloptions(Datum reloptions, bool validate)
     int numoptions;
     static const relopt_parse_elt tab[] = {
         { "n_distinct", RELOPT_TYPE_REAL, offsetof(AttributeOpts, n_distinct) },
-        { "n_distinct_inherited", RELOPT_TYPE_REAL, offsetof(AttributeOpts, n_distinct_inherited) }
+        { "n_distinct_inherited", RELOPT_TYPE_REAL, offsetof(AttributeOpts, n_distinct_inherited) },
+        { "toast_compression", RELOPT_TYPE_STRING, offsetof(AttributeOpts, toast_compression) }
     };
 
     options = parseRelOptions(reloptions, validate, RELOPT_KIND_ATTRIBUTE, &numoptions);
@@ -2132,6 +2156,22 @@ void heaprel_set_compressing_modes(Relation rel, int16 *modes_ptr)
     opt[IDX_COMPRESSLEVEL_IN_MODES] = (int8)relation_get_compresslevel(rel);
 }
 
+/*
+ * @Description: combine given COMPRESSION and COMPRESSLEVEL into compressing-modes,
+ *    for compressing data that doesn't belong to a relation
+ * @IN compression: COMPRESSION value
+ * @IN compresslevel: COMPRESSLEVEL value
+ * @OUT modes: compressing-modes value
+ * @Return:
+ * @See also:
+ */
+void heaprel_make_compressing_modes(int8 compression, int8 compresslevel, int16 *modes_ptr)
+{
+    int8 *opt = (int8 *)modes_ptr;
+    opt[IDX_COMPRESSION_IN_MODES] = compression;
+    opt[IDX_COMPRESSLEVEL_IN_MODES] = compresslevel;
+}
+
 /*
  * @Description: get COMPRESSION value
  * @IN modes: compressing-modes value
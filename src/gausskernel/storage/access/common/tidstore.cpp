@@ -0,0 +1,572 @@
+/* -------------------------------------------------------------------------
+ *
+ * tidstore.cpp
+ *	  Compact set of heap TIDs, for the dead tuples found by vacuum.
+ *
+ * The TIDs of each block are kept as a bitmap of their offsets, or as a
+ * sorted array of them when that is smaller, which is the case for blocks
+ * with only a few dead tuples.  The blocks are found through a radix tree
+ * keyed by block number.  The tree
+ * has a fixed four levels of one byte of the block number each; its inner
+ * nodes grow from 4 to 16 to 256 children, so the sparse upper levels cost
+ * little while a lookup never looks at more than 16 keys per level.
+ *
+ * The whole offset set of a block is added at once, which is how vacuum
+ * finds them.  Nodes and bitmaps are carved out of large chunks, and are
+ * only ever given back all at once by TidStoreReset or TidStoreDestroy;
+ * the nodes left behind when a node grows are counted as used.  The store
+ * is full once a block with the largest possible bitmap might not fit into
+ * maxBytes any more.
+ *
+ * Lookups do not change the store, so any number of threads can test
+ * membership at the same time as long as nobody adds to it.
+ *
+ * Portions Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ *
+ * IDENTIFICATION
+ *	  src/gausskernel/storage/access/common/tidstore.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+#include "postgres.h"
+#include "knl/knl_variable.h"
+
+#include "access/tidstore.h"
+#include "utils/memutils.h"
+
+#define TIDSTORE_LEVELS 4
+#define TIDSTORE_FANOUT 256
+#define TIDSTORE_CHUNK_SIZE ((Size)64 * 1024)
+
+#define TIDSTORE_NODE4 0
+#define TIDSTORE_NODE16 1
+#define TIDSTORE_NODE256 2
+
+/* key byte of blkno at the given tree level, most significant first */
+#define TidStoreKeyByte(blkno, level) ((uint8)((blkno) >> (8 * (TIDSTORE_LEVELS - 1 - (level)))))
+
+#define TIDSTORE_BITS_PER_WORD 64
+#define TidStoreWordsFor(maxoff) (((maxoff) - 1) / TIDSTORE_BITS_PER_WORD + 1)
+
+typedef struct TidStoreNode {
+    uint8 kind;
+    uint16 count;
+} TidStoreNode;
+
+/* children are kept in ascending order of their key byte */
+typedef struct TidStoreNode4 {
+    TidStoreNode hdr;
+    uint8 chunks[4];
+    void* children[4];
+} TidStoreNode4;
+
+typedef struct TidStoreNode16 {
+    TidStoreNode hdr;
+    uint8 chunks[16];
+    void* children[16];
+} TidStoreNode16;
+
+typedef struct TidStoreNode256 {
+    TidStoreNode hdr;
+    void* children[TIDSTORE_FANOUT];
+} TidStoreNode256;
+
+/*
+ * offsets of one block: a bitmap in which bit n - 1 stands for offset n, or,
+ * if nwords is 0, an ascending array of noffsets offsets
+ */
+typedef struct TidStoreBlock {
+    uint16 nwords;
+    uint16 noffsets;
+    uint64 words[FLEXIBLE_ARRAY_MEMBER];
+} TidStoreBlock;
+
+#define TidStoreBlockSize(nwords) (offsetof(TidStoreBlock, words) + (nwords) * sizeof(uint64))
+#define TidStoreArraySize(noffsets) (offsetof(TidStoreBlock, words) + (noffsets) * sizeof(OffsetNumber))
+#define TidStoreBlockOffsets(block) ((OffsetNumber*)(block)->words)
+
+/*
+ * Most a single TidStoreSetBlockOffsets can take: the biggest bitmap, new
+ * nodes on every level below the root, and one node growing to 256.
+ */
+#define TIDSTORE_MAX_BLOCK_BYTES                                                \
+    (MAXALIGN(TidStoreBlockSize(TidStoreWordsFor(MaxOffsetNumber))) +           \
+        (TIDSTORE_LEVELS - 1) * MAXALIGN(sizeof(TidStoreNode4)) + MAXALIGN(sizeof(TidStoreNode256)))
+
+struct TidStore {
+    MemoryContext context; /* holds the chunks */
+    Size maxBytes;
+    Size usedBytes;        /* carved out of the chunks so far */
+    char* chunkFree;       /* free space left in the current chunk */
+    Size chunkLeft;
+    TidStoreNode* root;
+    int64 numTids;
+};
+
+struct TidStoreIter {
+    TidStore* ts;
+    int level;                            /* of the node being walked, -1 when done */
+    TidStoreNode* nodes[TIDSTORE_LEVELS]; /* path from the root */
+    int pos[TIDSTORE_LEVELS];             /* next child slot to look at in each node */
+    uint8 key[TIDSTORE_LEVELS];
+    TidStoreIterResult result;
+    OffsetNumber offsets[MaxOffsetNumber];
+};
+
+static void* TidStoreAlloc(TidStore* ts, Size size);
+static TidStoreNode* TidStoreNewNode(TidStore* ts, uint8 kind);
+static void* TidStoreFindChild(const TidStoreNode* node, uint8 chunk);
+static TidStoreNode* TidStoreAddChild(TidStore* ts, TidStoreNode* node, uint8 chunk, void* child);
+static void* TidStoreNextChild(const TidStoreNode* node, int* pos, uint8* chunk);
+
+/*
+ * TidStoreCreate
+ *		Create an empty store taking up to about maxBytes.
+ */
+TidStore* TidStoreCreate(Size maxBytes)
+{
+    TidStore* ts = (TidStore*)palloc0(sizeof(TidStore));
+
+    ts->context = AllocSetContextCreate(CurrentMemoryContext, "TidStore", ALLOCSET_DEFAULT_MINSIZE,
+        ALLOCSET_DEFAULT_INITSIZE, ALLOCSET_DEFAULT_MAXSIZE);
+    /* room for at least one block, or vacuum could never make progress */
+    ts->maxBytes = Max(maxBytes, TIDSTORE_MAX_BLOCK_BYTES + MAXALIGN(sizeof(TidStoreNode4)));
+    return ts;
+}
+
+/*
+ * TidStoreDestroy
+ *		Free the store and everything in it.
+ */
+void TidStoreDestroy(TidStore* ts)
+{
+    MemoryContextDelete(ts->context);
+    pfree(ts);
+}
+
+/*
+ * TidStoreReset
+ *		Forget all TIDs, keeping the store.
+ */
+void TidStoreReset(TidStore* ts)
+{
+    MemoryContextReset(ts->context);
+    ts->usedBytes = 0;
+    ts->chunkFree = NULL;
+    ts->chunkLeft = 0;
+    ts->root = NULL;
+    ts->numTids = 0;
+}
+
+/*
+ * TidStoreSetBlockOffsets
+ *		Add the TIDs of one block, which must not be in the store yet.
+ *
+ * The caller checks TidStoreIsFull first.
+ */
+void TidStoreSetBlockOffsets(TidStore* ts, BlockNumber blkno, const OffsetNumber* offsets, int noffsets)
+{
+    TidStoreNode* node = NULL;
+    TidStoreNode** link = &ts->root;
+    TidStoreBlock* block = NULL;
+    OffsetNumber maxoff = InvalidOffsetNumber;
+    bool ascending = true;
+    int level;
+    int i;
+
+    if (noffsets <= 0)
+        return;
+
+    for (i = 0; i < noffsets; i++) {
+        Assert(OffsetNumberIsValid(offsets[i]));
+        if (offsets[i] <= maxoff)
+            ascending = false;
+        maxoff = Max(maxoff, offsets[i]);
+    }
+
+    if (ascending && TidStoreArraySize(noffsets) < TidStoreBlockSize(TidStoreWordsFor(maxoff))) {
+        /* few offsets: keep them as they are, vacuum hands them over in order */
+        block = (TidStoreBlock*)TidStoreAlloc(ts, TidStoreArraySize(noffsets));
+        block->noffsets = (uint16)noffsets;
+        for (i = 0; i < noffsets; i++)
+            TidStoreBlockOffsets(block)[i] = offsets[i];
+    } else {
+        block = (TidStoreBlock*)TidStoreAlloc(ts, TidStoreBlockSize(TidStoreWordsFor(maxoff)));
+        block->nwords = (uint16)TidStoreWordsFor(maxoff);
+        for (i = 0; i < noffsets; i++) {
+            int bit = offsets[i] - 1;
+
+            block->words[bit / TIDSTORE_BITS_PER_WORD] |= UINT64CONST(1) << (bit % TIDSTORE_BITS_PER_WORD);
+        }
+    }
+
+    if (ts->root == NULL)
+        ts->root = TidStoreNewNode(ts, TIDSTORE_NODE4);
+
+    /*
+     * Walk down the levels, adding nodes where needed.  link points at the
+     * pointer to the current node, so that a node that grows can be
+     * replaced in its parent.
+     */
+    for (level = 0; level < TIDSTORE_LEVELS; level++) {
+        uint8 chunk = TidStoreKeyByte(blkno, level);
+        void* child = NULL;
+
+        node = *link;
+        child = TidStoreFindChild(node, chunk);
+
+        if (level == TIDSTORE_LEVELS - 1) {
+            if (child != NULL)
+                ereport(ERROR,
+                    (errcode(ERRCODE_INTERNAL_ERROR), errmsg("block %u is already in the TID store", blkno)));
+            *link = TidStoreAddChild(ts, node, chunk, block);
+            break;
+        }
+
+        if (child == NULL) {
+            child = TidStoreNewNode(ts, TIDSTORE_NODE4);
+            node = TidStoreAddChild(ts, node, chunk, child);
+            *link = node;
+        }
+
+        /* find the slot of child in node, so that it can be replaced if it grows */
+        switch (node->kind) {
+            case TIDSTORE_NODE4: {
+                TidStoreNode4* n4 = (TidStoreNode4*)node;
+
+                for (i = 0; n4->chunks[i] != chunk; i++) {
+                }
+                link = (TidStoreNode**)&n4->children[i];
+                break;
+            }
+            case TIDSTORE_NODE16: {
+                TidStoreNode16* n16 = (TidStoreNode16*)node;
+
+                for (i = 0; n16->chunks[i] != chunk; i++) {
+                }
+                link = (TidStoreNode**)&n16->children[i];
+                break;
+            }
+            default:
+                link = (TidStoreNode**)&((TidStoreNode256*)node)->children[chunk];
+                break;
+        }
+    }
+
+    ts->numTids += noffsets;
+}
+
+/*
+ * TidStoreIsMember
+ *		Whether tid is in the store.
+ */
+bool TidStoreIsMember(const TidStore* ts, ItemPointer tid)
+{
+    BlockNumber blkno = ItemPointerGetBlockNumber(tid);
+    OffsetNumber off = ItemPointerGetOffsetNumber(tid);
+    void* node = ts->root;
+    const TidStoreBlock* block = NULL;
+    int level;
+    int bit;
+
+    for (level = 0; level < TIDSTORE_LEVELS && node != NULL; level++)
+        node = TidStoreFindChild((const TidStoreNode*)node, TidStoreKeyByte(blkno, level));
+    if (node == NULL || !OffsetNumberIsValid(off))
+        return false;
+
+    block = (const TidStoreBlock*)node;
+    if (block->nwords == 0) {
+        const OffsetNumber* offsets = TidStoreBlockOffsets(block);
+        int low = 0;
+        int high = block->noffsets - 1;
+
+        while (low <= high) {
+            int mid = (low + high) / 2;
+
+            if (offsets[mid] == off)
+                return true;
+            if (offsets[mid] < off)
+                low = mid + 1;
+            else
+                high = mid - 1;
+        }
+        return false;
+    }
+
+    bit = off - 1;
+    if ((uint32)(bit / TIDSTORE_BITS_PER_WORD) >= block->nwords)
+        return false;
+
+    return (block->words[bit / TIDSTORE_BITS_PER_WORD] & (UINT64CONST(1) << (bit % TIDSTORE_BITS_PER_WORD))) != 0;
+}
+
+/*
+ * TidStoreIsFull
+ *		Whether adding another block might take the store over its limit.
+ */
+bool TidStoreIsFull(const TidStore* ts)
+{
+    return ts->usedBytes + TIDSTORE_MAX_BLOCK_BYTES > ts->maxBytes;
+}
+
+/*
+ * TidStoreNumTids
+ *		Number of TIDs in the store.
+ */
+int64 TidStoreNumTids(const TidStore* ts)
+{
+    return ts->numTids;
+}
+
+/*
+ * TidStoreMemoryUsage
+ *		Bytes taken by the TIDs and the tree.
+ */
+Size TidStoreMemoryUsage(const TidStore* ts)
+{
+    return ts->usedBytes;
+}
+
+/*
+ * TidStoreBeginIterate
+ *		Start returning the blocks of the store in ascending order.
+ *
+ * The store must not change until TidStoreEndIterate.
+ */
+TidStoreIter* TidStoreBeginIterate(TidStore* ts)
+{
+    TidStoreIter* iter = (TidStoreIter*)palloc0(sizeof(TidStoreIter));
+
+    iter->ts = ts;
+    iter->result.offsets = iter->offsets;
+    if (ts->root != NULL) {
+        iter->level = 0;
+        iter->nodes[0] = ts->root;
+    } else {
+        iter->level = -1;
+    }
+    return iter;
+}
+
+/*
+ * TidStoreIterateNext
+ *		Next block and its offsets, or NULL once all were returned.
+ *
+ * The result is overwritten by the next call.
+ */
+TidStoreIterResult* TidStoreIterateNext(TidStoreIter* iter)
+{
+    while (iter->level >= 0) {
+        int level = iter->level;
+        uint8 chunk = 0;
+        void* child = TidStoreNextChild(iter->nodes[level], &iter->pos[level], &chunk);
+
+        if (child == NULL) {
+            /* this node is done, go back up */
+            iter->level--;
+            continue;
+        }
+        iter->key[level] = chunk;
+
+        if (level < TIDSTORE_LEVELS - 1) {
+            iter->level++;
+            iter->nodes[level + 1] = (TidStoreNode*)child;
+            iter->pos[level + 1] = 0;
+            continue;
+        }
+
+        /* a leaf: copy the array or decode the bitmap */
+        const TidStoreBlock* block = (const TidStoreBlock*)child;
+        BlockNumber blkno = 0;
+        int n = 0;
+        uint32 w;
+        int i;
+
+        for (i = 0; i < TIDSTORE_LEVELS; i++)
+            blkno = (blkno << 8) | iter->key[i];
+
+        for (n = 0; block->nwords == 0 && n < block->noffsets; n++)
+            iter->offsets[n] = TidStoreBlockOffsets(block)[n];
+
+        for (w = 0; w < block->nwords; w++) {
+            uint64 word = block->words[w];
+            int bit;
+
+            for (bit = 0; word != 0; bit++, word >>= 1) {
+                if (word & 1)
+                    iter->offsets[n++] = (OffsetNumber)(w * TIDSTORE_BITS_PER_WORD + bit + 1);
+            }
+        }
+
+        iter->result.blkno = blkno;
+        iter->result.noffsets = n;
+        return &iter->result;
+    }
+
+    return NULL;
+}
+
+/*
+ * TidStoreEndIterate
+ *		Release the iterator.
+ */
+void TidStoreEndIterate(TidStoreIter* iter)
+{
+    pfree(iter);
+}
+
+/*
+ * Carve size bytes out of the current chunk, starting a new one if needed.
+ * The memory comes zeroed.
+ */
+static void* TidStoreAlloc(TidStore* ts, Size size)
+{
+    void* ptr = NULL;
+
+    size = MAXALIGN(size);
+    if (size > ts->chunkLeft) {
+        Size chunkSize = Max(size, TIDSTORE_CHUNK_SIZE);
+
+        ts->chunkFree = (char*)MemoryContextAllocZero(ts->context, chunkSize);
+        ts->chunkLeft = chunkSize;
+    }
+
+    ptr = ts->chunkFree;
+    ts->chunkFree += size;
+    ts->chunkLeft -= size;
+    ts->usedBytes += size;
+    return ptr;
+}
+
+static TidStoreNode* TidStoreNewNode(TidStore* ts, uint8 kind)
+{
+    TidStoreNode* node = NULL;
+
+    switch (kind) {
+        case TIDSTORE_NODE4:
+            node = (TidStoreNode*)TidStoreAlloc(ts, sizeof(TidStoreNode4));
+            break;
+        case TIDSTORE_NODE16:
+            node = (TidStoreNode*)TidStoreAlloc(ts, sizeof(TidStoreNode16));
+            break;
+        default:
+            node = (TidStoreNode*)TidStoreAlloc(ts, sizeof(TidStoreNode256));
+            break;
+    }
+    node->kind = kind;
+    return node;
+}
+
+static void* TidStoreFindChild(const TidStoreNode* node, uint8 chunk)
+{
+    int i;
+
+    switch (node->kind) {
+        case TIDSTORE_NODE4: {
+            const TidStoreNode4* n4 = (const TidStoreNode4*)node;
+
+            for (i = 0; i < node->count; i++) {
+                if (n4->chunks[i] == chunk)
+                    return n4->children[i];
+            }
+            return NULL;
+        }
+        case TIDSTORE_NODE16: {
+            const TidStoreNode16* n16 = (const TidStoreNode16*)node;
+
+            for (i = 0; i < node->count; i++) {
+                if (n16->chunks[i] == chunk)
+                    return n16->children[i];
+            }
+            return NULL;
+        }
+        default:
+            return ((const TidStoreNode256*)node)->children[chunk];
+    }
+}
+
+/*
+ * Add child under chunk, which node does not have yet.  Returns the node
+ * to use from now on, which is a bigger copy if node was full.
+ */
+static TidStoreNode* TidStoreAddChild(TidStore* ts, TidStoreNode* node, uint8 chunk, void* child)
+{
+    uint8* chunks = NULL;
+    void** children = NULL;
+    int capacity;
+    int i;
+
+    switch (node->kind) {
+        case TIDSTORE_NODE4:
+            chunks = ((TidStoreNode4*)node)->chunks;
+            children = ((TidStoreNode4*)node)->children;
+            capacity = 4;
+            break;
+        case TIDSTORE_NODE16:
+            chunks = ((TidStoreNode16*)node)->chunks;
+            children = ((TidStoreNode16*)node)->children;
+            capacity = 16;
+            break;
+        default:
+            ((TidStoreNode256*)node)->children[chunk] = child;
+            node->count++;
+            return node;
+    }
+
+    if (node->count == capacity) {
+        /* grow; the old node stays behind in its chunk */
+        TidStoreNode* bigger = TidStoreNewNode(ts, (node->kind == TIDSTORE_NODE4) ? TIDSTORE_NODE16 : TIDSTORE_NODE256);
+
+        for (i = 0; i < node->count; i++)
+            (void)TidStoreAddChild(ts, bigger, chunks[i], children[i]);
+        return TidStoreAddChild(ts, bigger, chunk, child);
+    }
+
+    /* keep the children sorted; vacuum adds blocks in order, so this is normally an append */
+    for (i = node->count; i > 0 && chunks[i - 1] > chunk; i--) {
+        chunks[i] = chunks[i - 1];
+        children[i] = children[i - 1];
+    }
+    chunks[i] = chunk;
+    children[i] = child;
+    node->count++;
+    return node;
+}
+
+/*
+ * Child of node at or after slot *pos, in ascending key order.  Sets
+ * *chunk to its key byte and moves *pos past it; NULL if there is none.
+ */
+static void* TidStoreNextChild(const TidStoreNode* node, int* pos, uint8* chunk)
+{
+    switch (node->kind) {
+        case TIDSTORE_NODE4: {
+            const TidStoreNode4* n4 = (const TidStoreNode4*)node;
+
+            if (*pos >= node->count)
+                return NULL;
+            *chunk = n4->chunks[*pos];
+            return n4->children[(*pos)++];
+        }
+        case TIDSTORE_NODE16: {
+            const TidStoreNode16* n16 = (const TidStoreNode16*)node;
+
+            if (*pos >= node->count)
+                return NULL;
+            *chunk = n16->chunks[*pos];
+            return n16->children[(*pos)++];
+        }
+        default: {
+            const TidStoreNode256* n256 = (const TidStoreNode256*)node;
+
+            for (; *pos < TIDSTORE_FANOUT; (*pos)++) {
+                if (n256->children[*pos] != NULL) {
+                    *chunk = (uint8)*pos;
+                    return n256->children[(*pos)++];
+                }
+            }
+            return NULL;
+        }
+    }
+}
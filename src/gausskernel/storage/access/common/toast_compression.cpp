@@ -0,0 +1,228 @@
+/* -------------------------------------------------------------------------
+ *
+ * toast_compression.cpp
+ *	  Compression methods for compressed varlena datums.
+ *
+ * A compressed datum has the usual compressed varlena header: the total
+ * size, then the raw size with the id of the method in its top two bits.
+ * pglz is the original method and still the default; lz4 compresses and,
+ * above all, decompresses several times faster at a similar ratio, and zstd
+ * compresses better than both at a speed between the two.  Which one is used
+ * is decided per column, by the column's toast_compression option, or else
+ * by default_toast_compression; whatever a datum was compressed with, it is
+ * always read back with that.
+ *
+ * Portions Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ *
+ * IDENTIFICATION
+ *	  src/gausskernel/storage/access/common/toast_compression.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+#include "postgres.h"
+#include "knl/knl_variable.h"
+
+#include "lz4.h"
+#include "zstd.h"
+
+#include "access/toast_compression.h"
+#include "miscadmin.h"
+#include "storage/proc.h"
+#include "utils/pg_lzcompress.h"
+
+#define TOAST_COMPRESS_HDRSZ ((int32)offsetof(varattrib_4b, va_compressed.va_data))
+#define TOAST_COMPRESS_DATA(ptr) ((char *)(ptr) + TOAST_COMPRESS_HDRSZ)
+
+/* higher levels cost a lot more CPU for a few percent of space */
+#define TOAST_ZSTD_LEVEL 1
+
+static const char *const toast_compression_names[] = {"pglz", "lz4", "zstd"};
+
+static struct varlena *pglz_compress_varlena(const struct varlena *value, int32 valsize)
+{
+    struct varlena *tmp = NULL;
+
+    if (valsize > PGLZ_strategy_default->max_input_size)
+        return NULL;
+
+    tmp = (struct varlena *)palloc(PGLZ_MAX_OUTPUT(valsize));
+    if (!pglz_compress(VARDATA_ANY(value), valsize, (PGLZ_Header *)tmp, PGLZ_strategy_default)) {
+        pfree(tmp);
+        return NULL;
+    }
+    return tmp;
+}
+
+static struct varlena *lz4_compress_varlena(const struct varlena *value, int32 valsize)
+{
+    int32 maxsize = LZ4_compressBound(valsize);
+    struct varlena *tmp = (struct varlena *)palloc(maxsize + TOAST_COMPRESS_HDRSZ);
+    int len = LZ4_compress_default(VARDATA_ANY(value), TOAST_COMPRESS_DATA(tmp), valsize, maxsize);
+
+    if (len <= 0) {
+        pfree(tmp);
+        return NULL;
+    }
+    SET_VARSIZE_COMPRESSED(tmp, len + TOAST_COMPRESS_HDRSZ);
+    return tmp;
+}
+
+static struct varlena *zstd_compress_varlena(const struct varlena *value, int32 valsize)
+{
+    size_t maxsize = ZSTD_compressBound(valsize);
+    struct varlena *tmp = (struct varlena *)palloc(maxsize + TOAST_COMPRESS_HDRSZ);
+    size_t len = ZSTD_compress(TOAST_COMPRESS_DATA(tmp), maxsize, VARDATA_ANY(value), valsize, TOAST_ZSTD_LEVEL);
+
+    if (ZSTD_isError(len)) {
+        pfree(tmp);
+        return NULL;
+    }
+    SET_VARSIZE_COMPRESSED(tmp, len + TOAST_COMPRESS_HDRSZ);
+    return tmp;
+}
+
+/*
+ * Compress a varlena with the given method.  Returns NULL if the value is
+ * too short to bother or does not compress well enough to be worth it.
+ *
+ * Short varlenas are fine, but external or compressed ones are not.  Until
+ * the whole cluster runs a version that can read lz4 and zstd datums, pglz
+ * is used whatever method was asked for.
+ */
+struct varlena *toast_compress_varlena(const struct varlena *value, ToastCompressionId cmid)
+{
+    int32 valsize = VARSIZE_ANY_EXHDR(value);
+    struct varlena *tmp = NULL;
+
+    Assert(!VARATT_IS_EXTERNAL(value));
+    Assert(!VARATT_IS_COMPRESSED(value));
+
+    if (valsize < TOAST_MIN_COMPRESS_SIZE)
+        return NULL;
+
+    if (t_thrd.proc == NULL || t_thrd.proc->workingVersionNum < TOAST_COMPRESSION_VERSION_NUM)
+        cmid = TOAST_PGLZ_COMPRESSION_ID;
+
+    switch (cmid) {
+        case TOAST_PGLZ_COMPRESSION_ID:
+            tmp = pglz_compress_varlena(value, valsize);
+            break;
+        case TOAST_LZ4_COMPRESSION_ID:
+            tmp = lz4_compress_varlena(value, valsize);
+            break;
+        case TOAST_ZSTD_COMPRESSION_ID:
+            tmp = zstd_compress_varlena(value, valsize);
+            break;
+        default:
+            ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+                            errmsg("invalid compression method id %d", (int)cmid)));
+            break;
+    }
+
+    if (tmp == NULL)
+        return NULL;
+
+    /*
+     * Even a successful compression may have saved as little as one byte,
+     * which could turn into a net loss once you consider header and alignment
+     * padding.  Worst case, the compressed format might require three padding
+     * bytes (plus header, which is included in VARSIZE(tmp)), whereas the
+     * uncompressed format would take only one header byte and no padding if
+     * the value is short enough.  So we insist on a savings of more than 2
+     * bytes to ensure we have a gain.
+     */
+    if (VARSIZE(tmp) >= (uint32)(valsize - 2)) {
+        pfree(tmp);
+        return NULL;
+    }
+
+    SET_VARRAWSIZE_4B_C(tmp, valsize, cmid);
+    return tmp;
+}
+
+/*
+ * Decompress a compressed varlena, with whatever method it was compressed.
+ */
+struct varlena *toast_decompress_varlena(const struct varlena *attr)
+{
+    int32 rawsize = VARRAWSIZE_4B_C(attr);
+    int32 srclen = VARSIZE(attr) - TOAST_COMPRESS_HDRSZ;
+    uint32 cmid = VARCOMPRESSID_4B_C(attr);
+    struct varlena *result = (struct varlena *)palloc(rawsize + VARHDRSZ);
+
+    Assert(VARATT_IS_COMPRESSED(attr));
+
+    switch (cmid) {
+        case TOAST_PGLZ_COMPRESSION_ID:
+            pglz_decompress((const PGLZ_Header *)attr, VARDATA(result));
+            break;
+        case TOAST_LZ4_COMPRESSION_ID:
+            if (LZ4_decompress_safe(TOAST_COMPRESS_DATA(attr), VARDATA(result), srclen, rawsize) != rawsize)
+                ereport(ERROR, (errcode(ERRCODE_DATA_CORRUPTED), errmsg_internal("compressed lz4 data is corrupt")));
+            break;
+        case TOAST_ZSTD_COMPRESSION_ID: {
+            size_t len = ZSTD_decompress(VARDATA(result), rawsize, TOAST_COMPRESS_DATA(attr), srclen);
+
+            if (ZSTD_isError(len) || len != (size_t)rawsize)
+                ereport(ERROR, (errcode(ERRCODE_DATA_CORRUPTED), errmsg_internal("compressed zstd data is corrupt")));
+            break;
+        }
+        default:
+            ereport(ERROR, (errcode(ERRCODE_DATA_CORRUPTED), errmsg_internal("invalid compression method id %u", cmid)));
+            break;
+    }
+
+    SET_VARSIZE(result, rawsize + VARHDRSZ);
+    return result;
+}
+
+/*
+ * Decompress at least the first slicelength bytes of a compressed varlena.
+ * Only lz4 can stop early; the other methods decompress the whole value.
+ */
+struct varlena *toast_decompress_varlena_slice(const struct varlena *attr, int32 slicelength)
+{
+    struct varlena *result = NULL;
+    int len;
+
+    Assert(VARATT_IS_COMPRESSED(attr));
+
+    if (VARCOMPRESSID_4B_C(attr) != TOAST_LZ4_COMPRESSION_ID || slicelength >= (int32)VARRAWSIZE_4B_C(attr))
+        return toast_decompress_varlena(attr);
+
+    result = (struct varlena *)palloc(slicelength + VARHDRSZ);
+    len = LZ4_decompress_safe_partial(TOAST_COMPRESS_DATA(attr), VARDATA(result), VARSIZE(attr) - TOAST_COMPRESS_HDRSZ,
+                                      slicelength, slicelength);
+    if (len < 0)
+        ereport(ERROR, (errcode(ERRCODE_DATA_CORRUPTED), errmsg_internal("compressed lz4 data is corrupt")));
+
+    SET_VARSIZE(result, len + VARHDRSZ);
+    return result;
+}
+
+ToastCompressionId CompressionNameToId(const char *name)
+{
+    for (int i = 0; i < (int)lengthof(toast_compression_names); i++) {
+        if (pg_strcasecmp(name, toast_compression_names[i]) == 0)
+            return (ToastCompressionId)i;
+    }
+    return TOAST_INVALID_COMPRESSION_ID;
+}
+
+const char *CompressionIdToName(ToastCompressionId cmid)
+{
+    if (cmid < TOAST_PGLZ_COMPRESSION_ID || cmid >= TOAST_INVALID_COMPRESSION_ID)
+        ereport(ERROR, (errcode(ERRCODE_DATA_CORRUPTED), errmsg_internal("invalid compression method id %d", (int)cmid)));
+    return toast_compression_names[cmid];
+}
+
+/*
+ * Validator of the toast_compression column option.
+ */
+void ValidateToastCompressionOption(const char *value)
+{
+    if (value == NULL || CompressionNameToId(value) == TOAST_INVALID_COMPRESSION_ID)
+        ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE), errmsg("invalid value for \"toast_compression\" option"),
+                        errdetail("Valid values are \"pglz\", \"lz4\" and \"zstd\".")));
+}
@@ -94,6 +94,7 @@ TupleDesc CreateTemplateTupleDesc(int natts, bool hasoid, TableAmType tam)
     desc->tdhasoid = hasoid;
     desc->tdrefcount = -1;    /* assume not reference-counted */
     desc->initdefvals = NULL; /* initialize the attrinitdefvals */
+    desc->attcompression = NULL;
     desc->tdisredistable = false;
     desc->tdTableAmType = tam;
 
@@ -129,6 +130,7 @@ TupleDesc CreateTupleDesc(int natts, bool hasoid, Form_pg_attribute* attrs, Tabl
     desc->tdhasoid = hasoid;
     desc->tdrefcount = -1;    /* assume not reference-counted */
     desc->initdefvals = NULL; /* initialize the attrinitdefvals */
+    desc->attcompression = NULL;
     desc->tdisredistable = false;
     desc->tdTableAmType = tam;
 
@@ -157,6 +159,14 @@ static TupInitDefVal *tupInitDefValCopy(TupInitDefVal *pInitDefVal, int nAttr)
     return dvals;
 }
 
+static uint8 *attCompressionCopy(const uint8 *attcompression, int nAttr)
+{
+    uint8 *copy = (uint8 *)palloc(nAttr * sizeof(uint8));
+    errno_t rc = memcpy_s(copy, nAttr * sizeof(uint8), attcompression, nAttr * sizeof(uint8));
+    securec_check(rc, "\0", "\0");
+    return copy;
+}
+
 /*
  * CreateTupleDescCopy
  *		This function creates a new TupleDesc by copying from an existing
@@ -187,6 +197,9 @@ TupleDesc CreateTupleDescCopy(TupleDesc tupdesc)
     if (tupdesc->initdefvals) {
         desc->initdefvals = tupInitDefValCopy(tupdesc->initdefvals, tupdesc->natts);
     }
+    if (tupdesc->attcompression) {
+        desc->attcompression = attCompressionCopy(tupdesc->attcompression, tupdesc->natts);
+    }
 
     return desc;
 }
@@ -251,6 +264,9 @@ TupleDesc CreateTupleDescCopyConstr(TupleDesc tupdesc)
     if (tupdesc->initdefvals) {
         desc->initdefvals = tupInitDefValCopy(tupdesc->initdefvals, tupdesc->natts);
     }
+    if (tupdesc->attcompression) {
+        desc->attcompression = attCompressionCopy(tupdesc->attcompression, tupdesc->natts);
+    }
 
     desc->tdtypeid = tupdesc->tdtypeid;
     desc->tdtypmod = tupdesc->tdtypmod;
@@ -305,6 +321,9 @@ void FreeTupleDesc(TupleDesc tupdesc)
         }
         pfree_ext(tupdesc->initdefvals);
     }
+    if (tupdesc->attcompression) {
+        pfree_ext(tupdesc->attcompression);
+    }
 
     pfree(tupdesc);
 }
@@ -386,6 +405,17 @@ static bool compareInitdefvals(TupleDesc tupdesc1, TupleDesc tupdesc2)
     }
 }
 
+/* compare the toast_compression options, NULL meaning none is set */
+static bool compareAttCompression(TupleDesc tupdesc1, TupleDesc tupdesc2)
+{
+    Assert(tupdesc1->natts == tupdesc2->natts);
+
+    if (tupdesc1->attcompression == NULL || tupdesc2->attcompression == NULL) {
+        return tupdesc1->attcompression == tupdesc2->attcompression;
+    }
+    return memcmp(tupdesc1->attcompression, tupdesc2->attcompression, tupdesc1->natts * sizeof(uint8)) == 0;
+}
+
 /*
  * @Description: check whether one relation has Partial Cluster Key.
  * @IN constr: all tuple constraints info about this relation.
@@ -529,6 +559,11 @@ bool equalTupleDescs(TupleDesc tupdesc1, TupleDesc tupdesc2)
         /* attacl, attoptions and attfdwoptions are not even present... */
     }
 
+    /* ... except for the toast_compression option */
+    if (!compareAttCompression(tupdesc1, tupdesc2)) {
+        return false;
+    }
+
     if (tupdesc1->constr != NULL) {
         TupleConstr *constr1 = tupdesc1->constr;
         TupleConstr *constr2 = tupdesc2->constr;
@@ -179,7 +179,7 @@ ItemPointer ginReadTuple(GinState *ginstate, OffsetNumber attnum, IndexTuple itu
  * Any posting list in the source tuple is not copied.  The specified child
  * block number is inserted into t_tid.
  */
-static IndexTuple GinFormInteriorTuple(IndexTuple itup, Page page, BlockNumber childblk)
+IndexTuple GinFormInteriorTuple(IndexTuple itup, Page page, BlockNumber childblk)
 {
     IndexTuple nitup;
     errno_t ret = EOK;
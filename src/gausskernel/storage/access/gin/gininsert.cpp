@@ -16,6 +16,8 @@
 #include "knl/knl_variable.h"
 
 #include "access/gin_private.h"
+#include "access/heapam.h"
+#include "access/parallelbuild.h"
 #include "access/xloginsert.h"
 #include "access/cbtree.h"
 #include "access/cstore_am.h"
@@ -23,10 +25,12 @@
 #include "access/sysattr.h"
 #include "access/tableam.h"
 #include "catalog/index.h"
+#include "lib/binaryheap.h"
 #include "miscadmin.h"
 #include "storage/buf/bufmgr.h"
 #include "storage/indexfsm.h"
 #include "storage/smgr.h"
+#include "storage/buf/buffile.h"
 #include "utils/memutils.h"
 #include "utils/rel.h"
 #include "utils/rel_gs.h"
@@ -43,6 +47,8 @@ typedef struct {
     BuildAccumulator accum;
 } GinBuildState;
 
+static void initBuildAccumulator(GinBuildState *buildstate);
+
 /*
  * Adds array of item pointers to tuple's posting list, or
  * creates posting tree and tuple pointing to tree in case
@@ -345,6 +351,15 @@ static void buildInitialize(Relation index, GinBuildState *buildstate)
     /* count the root as first entry page */
     buildstate->buildStats.nEntryPages++;
 
+    initBuildAccumulator(buildstate);
+}
+
+/*
+ * Set up the memory contexts and the accumulator of a build, in the leader
+ * or in a parallel build worker.
+ */
+static void initBuildAccumulator(GinBuildState *buildstate)
+{
     /*
      * create a temporary memory context that is used to hold data not yet
      * dumped out to the index
@@ -366,6 +381,831 @@ static void buildInitialize(Relation index, GinBuildState *buildstate)
     ginInitBA(&buildstate->accum);
 }
 
+/*
+ * Parallel build
+ *
+ * Each worker scans its stripes of the heap into an accumulator of its own.
+ * Whenever the accumulator fills, its entries are written out in key order,
+ * as a run, to a temporary file.  At the end of its scan the worker merges
+ * its runs with what is still in memory and streams the entries to the
+ * leader through a queue of its own, as items holding a key and a chunk of
+ * its TIDs.  A worker scans its stripes in block order, so the TIDs of a key
+ * ascend from one run to the next; the merge takes equal keys in run order.
+ *
+ * The leader merges the streams of the workers, gathers the TIDs of each
+ * key, and appends the entry tuples to the entry tree bottom-up, a page at
+ * a time, the way a btree build loads its leaves, so no entry page is ever
+ * split.  A key whose TIDs do not fit in a posting list gets a posting tree,
+ * which createPostingTree fills in TID order.  The TIDs of a key that would
+ * take more than maintenance_work_mem go to its posting tree in batches.
+ */
+
+/*
+ * An item of a run or a queue: the header, the key data of a by-reference
+ * key, and the TIDs, each MAXALIGN'd.
+ */
+typedef struct GinBuildItem {
+    uint32 len; /* size of the item; 0 in a queue if the next item is at the buffer start */
+    OffsetNumber attnum;
+    GinNullCategory category;
+    uint32 keylen; /* bytes of key data, 0 for a by-value or null key */
+    uint32 ntids;
+    Datum keyval; /* a by-value key */
+} GinBuildItem;
+
+#define GINBUILD_ITEM_HDRSZ MAXALIGN(sizeof(GinBuildItem))
+#define GinBuildItemSize(keylen, ntids) \
+    (GINBUILD_ITEM_HDRSZ + MAXALIGN(keylen) + MAXALIGN((ntids) * sizeof(ItemPointerData)))
+#define GinBuildItemKeyData(item) ((char *)(item) + GINBUILD_ITEM_HDRSZ)
+#define GinBuildItemTids(item) ((ItemPointerData *)(GinBuildItemKeyData(item) + MAXALIGN((item)->keylen)))
+
+/* TIDs in one item, and the largest item there can be */
+#define GINBUILD_ITEM_MAXTIDS 8192
+#define GINBUILD_ITEM_MAXSIZE GinBuildItemSize(GinMaxItemSize, GINBUILD_ITEM_MAXTIDS)
+
+/*
+ * The queue of a worker, a ring buffer in the leader's memory.  An item
+ * never wraps around the end of the buffer.  head and tail only grow; their
+ * difference is the buffer space in use.
+ */
+#define GINBUILD_QUEUE_SIZE (1024 * 1024)
+#define GINBUILD_QUEUE_BATCH (GINBUILD_QUEUE_SIZE / 8)
+
+/* entry leaves are filled to this percentage, as a btree build fills its leaves */
+#define GINBUILD_LEAF_FILLFACTOR 90
+
+typedef struct GinBuildQueue {
+    char *buf;
+    uint64 head; /* bytes the leader is done with, under pbuild->mutex */
+    uint64 tail; /* bytes the worker has published, under pbuild->mutex */
+    bool done;   /* worker published its last item */
+} GinBuildQueue;
+
+/* State shared by the leader and the workers, amstate of the IndexBuildParallel */
+typedef struct GinBuildShared {
+    GinBuildQueue *queues;
+    double indtuples; /* entries the workers extracted, under pbuild->mutex */
+} GinBuildShared;
+
+/* Worker side of a queue */
+typedef struct GinQueueWriter {
+    IndexBuildParallel *pbuild;
+    GinBuildQueue *queue;
+    uint64 writepos;  /* end of what we have written */
+    uint64 published; /* what the leader may read */
+    uint64 head;      /* the leader's head when we last looked */
+} GinQueueWriter;
+
+/* Leader side of a queue */
+typedef struct GinQueueReader {
+    GinBuildQueue *queue;
+    uint64 readpos;     /* start of the current item */
+    uint64 tail;        /* the worker's tail when we last looked */
+    GinBuildItem *item; /* current item, NULL once the queue is drained */
+} GinQueueReader;
+
+/* A run of a worker, in a temporary file or still in the accumulator */
+typedef struct GinBuildRun {
+    BufFile *file;      /* NULL for the accumulator */
+    GinBuildItem *item; /* current item read from the file */
+    OffsetNumber attnum;
+    Datum key;
+    GinNullCategory category;
+    ItemPointerData *tids;
+    uint32 ntids;
+} GinBuildRun;
+
+/* Worker state for the heap scan callback */
+typedef struct GinParallelScanState {
+    GinBuildState build;
+    IndexBuildParallel *pbuild;
+    MemoryContext runCtx; /* holds the run files, outlives build.tmpCtx */
+    List *runfiles;       /* temporary files of the runs written so far */
+} GinParallelScanState;
+
+typedef struct GinBuildMerge {
+    GinState *ginstate;
+    GinBuildRun *runs;       /* worker merging its runs */
+    GinQueueReader *readers; /* leader merging the worker queues */
+} GinBuildMerge;
+
+/* One level of the entry tree being loaded by the leader */
+typedef struct GinBuildPageState {
+    Page page;         /* page being filled, in local memory */
+    BlockNumber blkno; /* its block, InvalidBlockNumber while it could still be the root */
+    Size freeTarget;   /* space to leave free on the page */
+    struct GinBuildPageState *parent; /* the level above, NULL until there is one */
+} GinBuildPageState;
+
+typedef struct GinBuildLoadState {
+    Relation index;
+    GinStatsData *buildStats;
+    GinBuildPageState *leaf; /* lowest level, NULL until the first entry */
+} GinBuildLoadState;
+
+/*
+ * Bytes of key data an item needs for the key.
+ */
+static uint32 ginBuildKeyLen(GinState *ginstate, OffsetNumber attnum, Datum key, GinNullCategory category)
+{
+    Form_pg_attribute attr = ginstate->origTupdesc->attrs[attnum - 1];
+    Size keylen;
+
+    if (category != GIN_CAT_NORM_KEY || attr->attbyval)
+        return 0;
+
+    /* a key this long could never be stored, fail the way GinFormTuple would */
+    keylen = datumGetSize(key, false, attr->attlen);
+    if (MAXALIGN(keylen) > GinMaxItemSize)
+        ereport(ERROR, (errcode(ERRCODE_PROGRAM_LIMIT_EXCEEDED),
+                        errmsg("index row size %zu exceeds maximum %zu for index \"%s\"", (Size)MAXALIGN(keylen),
+                               (Size)GinMaxItemSize, RelationGetRelationName(ginstate->index))));
+    return (uint32)keylen;
+}
+
+static void ginBuildFillItem(GinBuildItem *item, OffsetNumber attnum, Datum key, GinNullCategory category,
+                             uint32 keylen, ItemPointerData *tids, uint32 ntids)
+{
+    errno_t rc;
+
+    item->len = (uint32)GinBuildItemSize(keylen, ntids);
+    item->attnum = attnum;
+    item->category = category;
+    item->keylen = keylen;
+    item->ntids = ntids;
+    item->keyval = (keylen == 0 && category == GIN_CAT_NORM_KEY) ? key : (Datum)0;
+    if (keylen > 0) {
+        rc = memcpy_s(GinBuildItemKeyData(item), keylen, DatumGetPointer(key), keylen);
+        securec_check(rc, "\0", "\0");
+    }
+    rc = memcpy_s(GinBuildItemTids(item), ntids * sizeof(ItemPointerData), tids, ntids * sizeof(ItemPointerData));
+    securec_check(rc, "\0", "\0");
+}
+
+static inline Datum ginBuildItemKey(GinBuildItem *item)
+{
+    return (item->keylen > 0) ? PointerGetDatum(GinBuildItemKeyData(item)) : item->keyval;
+}
+
+static int ginBuildCompareTids(const void *a, const void *b)
+{
+    return ginCompareItemPointers((ItemPointer)a, (ItemPointer)b);
+}
+
+/*
+ * Worker: write the accumulator out as a run, and empty it.  Called in
+ * build.tmpCtx.
+ */
+static void ginBuildDumpRun(GinParallelScanState *scanstate)
+{
+    GinBuildState *buildstate = &scanstate->build;
+    GinBuildItem *item = (GinBuildItem *)palloc(GINBUILD_ITEM_MAXSIZE);
+    ItemPointerData *list = NULL;
+    Datum key;
+    GinNullCategory category;
+    uint32 nlist;
+    OffsetNumber attnum;
+    BufFile *file = NULL;
+    MemoryContext oldCtx;
+
+    oldCtx = MemoryContextSwitchTo(scanstate->runCtx);
+    file = BufFileCreateTemp(false);
+    scanstate->runfiles = lappend(scanstate->runfiles, file);
+    (void)MemoryContextSwitchTo(oldCtx);
+
+    ginBeginBAScan(&buildstate->accum);
+    while ((list = ginGetBAEntry(&buildstate->accum, &attnum, &key, &category, &nlist)) != NULL) {
+        uint32 keylen = ginBuildKeyLen(&buildstate->ginstate, attnum, key, category);
+
+        IndexBuildWorkerCheckAbort(scanstate->pbuild);
+
+        for (uint32 off = 0; off < nlist; off += GINBUILD_ITEM_MAXTIDS) {
+            ginBuildFillItem(item, attnum, key, category, keylen, list + off, Min(nlist - off, GINBUILD_ITEM_MAXTIDS));
+            if (BufFileWrite(file, item, item->len) != item->len)
+                ereport(ERROR, (errcode_for_file_access(), errmsg("could not write to GIN build temporary file: %m")));
+        }
+    }
+
+    MemoryContextReset(buildstate->tmpCtx);
+    ginInitBA(&buildstate->accum);
+}
+
+/*
+ * Worker: step to the next chunk of a run.  Returns false at its end.
+ */
+static bool ginBuildRunNext(GinBuildRun *run, BuildAccumulator *accum)
+{
+    GinBuildItem *item = run->item;
+    size_t nread;
+
+    if (run->file == NULL) {
+        run->tids = ginGetBAEntry(accum, &run->attnum, &run->key, &run->category, &run->ntids);
+        return run->tids != NULL;
+    }
+
+    nread = BufFileRead(run->file, item, GINBUILD_ITEM_HDRSZ);
+    if (nread == 0)
+        return false;
+    if (nread != GINBUILD_ITEM_HDRSZ ||
+        BufFileRead(run->file, (char *)item + GINBUILD_ITEM_HDRSZ, item->len - GINBUILD_ITEM_HDRSZ) !=
+            item->len - GINBUILD_ITEM_HDRSZ)
+        ereport(ERROR, (errcode_for_file_access(), errmsg("could not read from GIN build temporary file: %m")));
+
+    run->attnum = item->attnum;
+    run->key = ginBuildItemKey(item);
+    run->category = item->category;
+    run->tids = GinBuildItemTids(item);
+    run->ntids = item->ntids;
+    return true;
+}
+
+/*
+ * binaryheap comparator for the runs of a worker: smallest key first, and
+ * for equal keys the earlier run first.
+ */
+static int ginBuildRunCompare(Datum a, Datum b, void *arg)
+{
+    GinBuildMerge *merge = (GinBuildMerge *)arg;
+    int ia = DatumGetInt32(a);
+    int ib = DatumGetInt32(b);
+    GinBuildRun *ra = &merge->runs[ia];
+    GinBuildRun *rb = &merge->runs[ib];
+    int res;
+
+    res = ginCompareAttEntries(merge->ginstate, ra->attnum, ra->key, ra->category, rb->attnum, rb->key, rb->category);
+    if (res == 0)
+        res = (ia < ib) ? -1 : ((ia > ib) ? 1 : 0);
+
+    /* binaryheap keeps the largest on top */
+    return -res;
+}
+
+/*
+ * binaryheap comparator for the worker queues: smallest key first.
+ */
+static int ginBuildReaderCompare(Datum a, Datum b, void *arg)
+{
+    GinBuildMerge *merge = (GinBuildMerge *)arg;
+    GinBuildItem *ia = merge->readers[DatumGetInt32(a)].item;
+    GinBuildItem *ib = merge->readers[DatumGetInt32(b)].item;
+
+    return -ginCompareAttEntries(merge->ginstate, ia->attnum, ginBuildItemKey(ia), ia->category, ib->attnum,
+                                 ginBuildItemKey(ib), ib->category);
+}
+
+/*
+ * Worker: let the leader read everything written so far.
+ */
+static void ginQueuePublish(GinQueueWriter *writer, bool done)
+{
+    IndexBuildParallel *pbuild = writer->pbuild;
+
+    (void)pthread_mutex_lock(&pbuild->mutex);
+    writer->queue->tail = writer->writepos;
+    if (done)
+        writer->queue->done = true;
+    writer->head = writer->queue->head;
+    (void)pthread_cond_broadcast(&pbuild->cond);
+    (void)pthread_mutex_unlock(&pbuild->mutex);
+
+    writer->published = writer->writepos;
+}
+
+/*
+ * Worker: append the TIDs of a key to our queue, in as many items as it
+ * takes, waiting for the leader to make room if need be.
+ */
+static void ginQueuePut(GinQueueWriter *writer, GinState *ginstate, OffsetNumber attnum, Datum key,
+                        GinNullCategory category, ItemPointerData *tids, uint32 ntids)
+{
+    IndexBuildParallel *pbuild = writer->pbuild;
+    GinBuildQueue *queue = writer->queue;
+    uint32 keylen = ginBuildKeyLen(ginstate, attnum, key, category);
+
+    while (ntids > 0) {
+        uint32 n = Min(ntids, GINBUILD_ITEM_MAXTIDS);
+        Size itemsz = GinBuildItemSize(keylen, n);
+        Size offset = writer->writepos % GINBUILD_QUEUE_SIZE;
+        Size skip = (GINBUILD_QUEUE_SIZE - offset < itemsz) ? GINBUILD_QUEUE_SIZE - offset : 0;
+
+        if (writer->writepos + skip + itemsz - writer->head > GINBUILD_QUEUE_SIZE) {
+            /* hand over what we have before we sleep, the leader may be waiting for it */
+            (void)pthread_mutex_lock(&pbuild->mutex);
+            queue->tail = writer->writepos;
+            writer->published = writer->writepos;
+            (void)pthread_cond_broadcast(&pbuild->cond);
+            while (writer->writepos + skip + itemsz - queue->head > GINBUILD_QUEUE_SIZE)
+                IndexBuildWorkerWait(pbuild);
+            writer->head = queue->head;
+            (void)pthread_mutex_unlock(&pbuild->mutex);
+        }
+
+        if (skip > 0) {
+            ((GinBuildItem *)(queue->buf + offset))->len = 0;
+            writer->writepos += skip;
+            offset = 0;
+        }
+
+        ginBuildFillItem((GinBuildItem *)(queue->buf + offset), attnum, key, category, keylen, tids, n);
+        writer->writepos += itemsz;
+        tids += n;
+        ntids -= n;
+
+        if (writer->writepos - writer->published >= GINBUILD_QUEUE_BATCH)
+            ginQueuePublish(writer, false);
+    }
+}
+
+/*
+ * Leader: step to the next item of a queue, waiting for its worker if need
+ * be.  Leaves reader->item NULL once the worker is done.
+ *
+ * The current item of every queue stays where it is until we step past it;
+ * everything before it is given back to the workers whenever we have to
+ * look at the shared positions anyway.
+ */
+static void ginQueueNext(IndexBuildParallel *pbuild, GinQueueReader *readers, int nreaders, GinQueueReader *reader)
+{
+    GinBuildQueue *queue = reader->queue;
+    int i;
+
+    if (reader->item != NULL) {
+        reader->readpos += reader->item->len;
+        reader->item = NULL;
+    }
+
+    for (;;) {
+        GinBuildItem *item = NULL;
+        Size offset;
+
+        if (reader->readpos == reader->tail) {
+            bool done = false;
+
+            (void)pthread_mutex_lock(&pbuild->mutex);
+            for (i = 0; i < nreaders; i++)
+                readers[i].queue->head = readers[i].readpos;
+            (void)pthread_cond_broadcast(&pbuild->cond);
+            while (queue->tail == reader->readpos && !queue->done)
+                IndexBuildParallelWait(pbuild);
+            reader->tail = queue->tail;
+            done = queue->done;
+            (void)pthread_mutex_unlock(&pbuild->mutex);
+
+            if (reader->readpos == reader->tail) {
+                Assert(done);
+                return;
+            }
+        }
+
+        offset = reader->readpos % GINBUILD_QUEUE_SIZE;
+        item = (GinBuildItem *)(queue->buf + offset);
+        if (item->len == 0) {
+            /* the worker continued at the buffer start */
+            reader->readpos += GINBUILD_QUEUE_SIZE - offset;
+            continue;
+        }
+
+        reader->item = item;
+        return;
+    }
+}
+
+/*
+ * Per-tuple callback from IndexBuildHeapScan in a worker
+ */
+static void ginParallelBuildCallback(Relation index, HeapTuple htup, Datum *values, const bool *isnull,
+                                     bool tupleIsAlive, void *state)
+{
+    GinParallelScanState *scanstate = (GinParallelScanState *)state;
+    GinBuildState *buildstate = &scanstate->build;
+    MemoryContext oldCtx;
+    int i;
+
+    IndexBuildWorkerCheckAbort(scanstate->pbuild);
+
+    oldCtx = MemoryContextSwitchTo(buildstate->tmpCtx);
+
+    for (i = 0; i < buildstate->ginstate.origTupdesc->natts; i++)
+        ginHeapTupleBulkInsert(buildstate, (OffsetNumber)(i + 1), values[i], isnull[i], &htup->t_self);
+
+    /* maintenance_work_mem is already our share of the leader's */
+    if (buildstate->accum.allocatedMemory >= (uint)u_sess->attr.attr_memory.maintenance_work_mem * 1024UL)
+        ginBuildDumpRun(scanstate);
+
+    MemoryContextSwitchTo(oldCtx);
+}
+
+/*
+ * Worker function: scan our stripes of the heap into runs, merge them, and
+ * stream the entries to the leader.
+ */
+static double ginParallelScan(IndexBuildParallel *pbuild, int workerId, Relation heap, Relation index,
+                              IndexInfo *indexInfo)
+{
+    GinBuildShared *shared = (GinBuildShared *)pbuild->amstate;
+    GinParallelScanState scanstate;
+    GinBuildState *buildstate = &scanstate.build;
+    GinQueueWriter writer;
+    GinBuildMerge merge;
+    GinBuildRun *runs = NULL;
+    binaryheap *runheap = NULL;
+    ListCell *lc = NULL;
+    double reltuples;
+    int nruns;
+    int i;
+    errno_t rc;
+
+    initGinState(&buildstate->ginstate, index);
+    buildstate->indtuples = 0;
+    rc = memset_s(&buildstate->buildStats, sizeof(GinStatsData), 0, sizeof(GinStatsData));
+    securec_check(rc, "\0", "\0");
+    initBuildAccumulator(buildstate);
+    scanstate.pbuild = pbuild;
+    scanstate.runCtx = CurrentMemoryContext;
+    scanstate.runfiles = NIL;
+
+    reltuples = tableam_index_build_scan(heap, index, indexInfo, false, ginParallelBuildCallback, (void *)&scanstate);
+
+    /* the accumulator holds the highest TIDs, so it is the last run */
+    nruns = list_length(scanstate.runfiles) + 1;
+    runs = (GinBuildRun *)palloc0(nruns * sizeof(GinBuildRun));
+    i = 0;
+    foreach (lc, scanstate.runfiles) {
+        runs[i].file = (BufFile *)lfirst(lc);
+        runs[i].item = (GinBuildItem *)palloc(GINBUILD_ITEM_MAXSIZE);
+        if (BufFileSeek(runs[i].file, 0, 0L, SEEK_SET) != 0)
+            ereport(ERROR, (errcode_for_file_access(), errmsg("could not rewind GIN build temporary file: %m")));
+        i++;
+    }
+    ginBeginBAScan(&buildstate->accum);
+
+    merge.ginstate = &buildstate->ginstate;
+    merge.runs = runs;
+    merge.readers = NULL;
+    runheap = binaryheap_allocate(nruns, ginBuildRunCompare, &merge);
+    for (i = 0; i < nruns; i++) {
+        if (ginBuildRunNext(&runs[i], &buildstate->accum))
+            binaryheap_add_unordered(runheap, Int32GetDatum(i));
+    }
+    binaryheap_build(runheap);
+
+    writer.pbuild = pbuild;
+    writer.queue = &shared->queues[workerId];
+    writer.writepos = 0;
+    writer.published = 0;
+    writer.head = 0;
+
+    while (!binaryheap_empty(runheap)) {
+        GinBuildRun *run = NULL;
+
+        i = DatumGetInt32(binaryheap_first(runheap));
+        run = &runs[i];
+        ginQueuePut(&writer, &buildstate->ginstate, run->attnum, run->key, run->category, run->tids, run->ntids);
+
+        if (ginBuildRunNext(run, &buildstate->accum))
+            binaryheap_replace_first(runheap, Int32GetDatum(i));
+        else
+            (void)binaryheap_remove_first(runheap);
+    }
+    ginQueuePublish(&writer, true);
+
+    for (i = 0; i < nruns - 1; i++)
+        BufFileClose(runs[i].file);
+    binaryheap_free(runheap);
+    MemoryContextDelete(buildstate->funcCtx);
+    MemoryContextDelete(buildstate->tmpCtx);
+
+    (void)pthread_mutex_lock(&pbuild->mutex);
+    shared->indtuples += buildstate->indtuples;
+    (void)pthread_mutex_unlock(&pbuild->mutex);
+
+    return reltuples;
+}
+
+/*
+ * Leader: reserve a block for an entry page, to be written once it is full.
+ */
+static BlockNumber ginBuildNewBlock(Relation index)
+{
+    Buffer buffer = GinNewBuffer(index);
+    BlockNumber blkno = BufferGetBlockNumber(buffer);
+
+    UnlockReleaseBuffer(buffer);
+    return blkno;
+}
+
+static GinBuildPageState *ginBuildNewPageState(bool isLeaf)
+{
+    GinBuildPageState *state = (GinBuildPageState *)palloc0(sizeof(GinBuildPageState));
+
+    state->page = (Page)palloc(BLCKSZ);
+    GinInitPage(state->page, isLeaf ? GIN_LEAF : 0, BLCKSZ);
+    state->blkno = InvalidBlockNumber;
+    state->freeTarget = isLeaf ? BLCKSZ * (100 - GINBUILD_LEAF_FILLFACTOR) / 100 : 0;
+    state->parent = NULL;
+    return state;
+}
+
+/*
+ * Leader: write out a finished entry page.
+ */
+static void ginBuildWritePage(GinBuildLoadState *lstate, Page page, BlockNumber blkno)
+{
+    Buffer buffer = ReadBuffer(lstate->index, blkno);
+    errno_t rc;
+
+    LockBuffer(buffer, GIN_EXCLUSIVE);
+
+    START_CRIT_SECTION();
+
+    rc = memcpy_s(BufferGetPage(buffer), BLCKSZ, page, BLCKSZ);
+    securec_check(rc, "\0", "\0");
+    MarkBufferDirty(buffer);
+
+    if (RelationNeedsWAL(lstate->index))
+        (void)log_newpage_buffer(buffer, true);
+
+    END_CRIT_SECTION();
+
+    UnlockReleaseBuffer(buffer);
+
+    /* the root was counted when the index was initialized */
+    if (blkno != GIN_ROOT_BLKNO)
+        lstate->buildStats->nEntryPages++;
+}
+
+/*
+ * Leader: add a tuple to a level of the entry tree.  When the page is full,
+ * it is written out, its downlink goes to the level above, and a right
+ * sibling takes its place.
+ */
+static void ginBuildAddTuple(GinBuildLoadState *lstate, GinBuildPageState *state, IndexTuple itup)
+{
+    Page page = state->page;
+
+    if (PageGetMaxOffsetNumber(page) >= FirstOffsetNumber &&
+        PageGetFreeSpace(page) < MAXALIGN(IndexTupleSize(itup)) + state->freeTarget) {
+        IndexTuple rightmost = (IndexTuple)PageGetItem(page, PageGetItemId(page, PageGetMaxOffsetNumber(page)));
+        IndexTuple downlink = NULL;
+        BlockNumber nblkno;
+
+        /* with a right sibling the page cannot be the root, give it a block in key order */
+        if (state->blkno == InvalidBlockNumber)
+            state->blkno = ginBuildNewBlock(lstate->index);
+        nblkno = ginBuildNewBlock(lstate->index);
+        GinPageGetOpaque(page)->rightlink = nblkno;
+
+        downlink = GinFormInteriorTuple(rightmost, page, state->blkno);
+        ginBuildWritePage(lstate, page, state->blkno);
+
+        if (state->parent == NULL)
+            state->parent = ginBuildNewPageState(false);
+        ginBuildAddTuple(lstate, state->parent, downlink);
+        pfree(downlink);
+
+        GinInitPage(page, GinPageGetOpaque(page)->flags, BLCKSZ);
+        state->blkno = nblkno;
+    }
+
+    if (PageAddItem(page, (Item)itup, IndexTupleSize(itup), InvalidOffsetNumber, false, false) == InvalidOffsetNumber)
+        ereport(ERROR, (errcode(ERRCODE_INDEX_CORRUPTED),
+                        errmsg("failed to add item to index page in \"%s\"", RelationGetRelationName(lstate->index))));
+}
+
+/*
+ * Leader: write out the last page of every level; the only page of the top
+ * level is the root.
+ */
+static void ginBuildFinishLoad(GinBuildLoadState *lstate)
+{
+    GinBuildPageState *state = lstate->leaf;
+
+    while (state != NULL) {
+        Page page = state->page;
+
+        if (state->parent == NULL) {
+            Assert(state->blkno == InvalidBlockNumber);
+            ginBuildWritePage(lstate, page, GIN_ROOT_BLKNO);
+        } else {
+            IndexTuple rightmost = (IndexTuple)PageGetItem(page, PageGetItemId(page, PageGetMaxOffsetNumber(page)));
+            IndexTuple downlink = GinFormInteriorTuple(rightmost, page, state->blkno);
+
+            ginBuildWritePage(lstate, page, state->blkno);
+            ginBuildAddTuple(lstate, state->parent, downlink);
+            pfree(downlink);
+        }
+
+        state = state->parent;
+    }
+}
+
+/*
+ * Leader: put a batch of sorted TIDs of a key into its posting tree, which
+ * is created with the first batch.
+ */
+static BlockNumber ginBuildFlushTids(GinBuildState *buildstate, BlockNumber postingRoot, ItemPointerData *tids,
+                                     uint32 ntids)
+{
+    Relation index = buildstate->ginstate.index;
+
+    if (postingRoot == InvalidBlockNumber)
+        return createPostingTree(index, tids, ntids, &buildstate->buildStats);
+
+    ginInsertItemPointers(index, postingRoot, tids, ntids, &buildstate->buildStats);
+    return postingRoot;
+}
+
+/*
+ * Leader: merge the worker queues and load the entry tree.
+ */
+static void ginParallelLoad(IndexBuildParallel *pbuild, GinBuildState *buildstate)
+{
+    GinBuildShared *shared = (GinBuildShared *)pbuild->amstate;
+    GinState *ginstate = &buildstate->ginstate;
+    int nreaders = pbuild->nworkers;
+    GinQueueReader *readers = (GinQueueReader *)palloc0(nreaders * sizeof(GinQueueReader));
+    uint32 flushtids = (uint32)Max((Size)u_sess->attr.attr_memory.maintenance_work_mem * 1024L /
+                                       sizeof(ItemPointerData), (Size)GINBUILD_ITEM_MAXTIDS);
+    GinBuildLoadState lstate;
+    GinBuildMerge merge;
+    binaryheap *readerheap = NULL;
+    MemoryContext entryCtx;
+    MemoryContext oldCtx;
+    int i;
+
+    lstate.index = ginstate->index;
+    lstate.buildStats = &buildstate->buildStats;
+    lstate.leaf = NULL;
+
+    for (i = 0; i < nreaders; i++) {
+        readers[i].queue = &shared->queues[i];
+        ginQueueNext(pbuild, readers, nreaders, &readers[i]);
+    }
+
+    merge.ginstate = ginstate;
+    merge.runs = NULL;
+    merge.readers = readers;
+    readerheap = binaryheap_allocate(nreaders, ginBuildReaderCompare, &merge);
+    for (i = 0; i < nreaders; i++) {
+        if (readers[i].item != NULL)
+            binaryheap_add_unordered(readerheap, Int32GetDatum(i));
+    }
+    binaryheap_build(readerheap);
+
+    /* holds the key and TIDs of one entry at a time */
+    entryCtx = AllocSetContextCreate(CurrentMemoryContext, "Gin parallel build entry context",
+                                     ALLOCSET_DEFAULT_MINSIZE, ALLOCSET_DEFAULT_INITSIZE, ALLOCSET_DEFAULT_MAXSIZE);
+
+    while (!binaryheap_empty(readerheap)) {
+        GinQueueReader *reader = &readers[DatumGetInt32(binaryheap_first(readerheap))];
+        GinBuildItem *item = reader->item;
+        OffsetNumber attnum = item->attnum;
+        GinNullCategory category = item->category;
+        Datum key = item->keyval;
+        BlockNumber postingRoot = InvalidBlockNumber;
+        ItemPointerData *tids = NULL;
+        uint32 ntids = 0;
+        uint32 maxtids = 0;
+        bool sorted = true;
+        IndexTuple itup = NULL;
+        errno_t rc;
+
+        /* there could be many entries, so be willing to abort here */
+        CHECK_FOR_INTERRUPTS();
+
+        oldCtx = MemoryContextSwitchTo(entryCtx);
+
+        /* the item goes back to its worker once we step past it */
+        if (item->keylen > 0) {
+            char *keycopy = (char *)palloc(item->keylen);
+
+            rc = memcpy_s(keycopy, item->keylen, GinBuildItemKeyData(item), item->keylen);
+            securec_check(rc, "\0", "\0");
+            key = PointerGetDatum(keycopy);
+        }
+
+        /* gather the TIDs of the key from all workers */
+        for (;;) {
+            ItemPointerData *itemtids = GinBuildItemTids(item);
+
+            if (ntids + item->ntids > maxtids) {
+                maxtids = Max(maxtids * 2, ntids + item->ntids);
+                if (tids == NULL)
+                    tids = (ItemPointerData *)palloc(maxtids * sizeof(ItemPointerData));
+                else
+                    tids = (ItemPointerData *)repalloc(tids, maxtids * sizeof(ItemPointerData));
+            }
+            /* a worker's TIDs ascend, but those of different workers interleave */
+            if (ntids > 0 && ginCompareItemPointers(&tids[ntids - 1], &itemtids[0]) > 0)
+                sorted = false;
+            rc = memcpy_s(tids + ntids, (maxtids - ntids) * sizeof(ItemPointerData), itemtids,
+                          item->ntids * sizeof(ItemPointerData));
+            securec_check(rc, "\0", "\0");
+            ntids += item->ntids;
+
+            if (ntids >= flushtids) {
+                if (!sorted)
+                    qsort(tids, ntids, sizeof(ItemPointerData), ginBuildCompareTids);
+                postingRoot = ginBuildFlushTids(buildstate, postingRoot, tids, ntids);
+                ntids = 0;
+                sorted = true;
+            }
+
+            ginQueueNext(pbuild, readers, nreaders, reader);
+            if (reader->item != NULL)
+                binaryheap_replace_first(readerheap, binaryheap_first(readerheap));
+            else
+                (void)binaryheap_remove_first(readerheap);
+
+            if (binaryheap_empty(readerheap))
+                break;
+            reader = &readers[DatumGetInt32(binaryheap_first(readerheap))];
+            item = reader->item;
+            if (ginCompareAttEntries(ginstate, attnum, key, category, item->attnum, ginBuildItemKey(item),
+                                     item->category) != 0)
+                break;
+        }
+
+        if (!sorted)
+            qsort(tids, ntids, sizeof(ItemPointerData), ginBuildCompareTids);
+
+        if (postingRoot == InvalidBlockNumber) {
+            itup = buildFreshLeafTuple(ginstate, attnum, key, category, tids, ntids, &buildstate->buildStats);
+        } else {
+            if (ntids > 0)
+                ginInsertItemPointers(ginstate->index, postingRoot, tids, ntids, &buildstate->buildStats);
+            itup = GinFormTuple(ginstate, attnum, key, category, NULL, 0, 0, true);
+            GinSetPostingTree(itup, postingRoot);
+        }
+        buildstate->buildStats.nEntries++;
+
+        (void)MemoryContextSwitchTo(oldCtx);
+
+        if (lstate.leaf == NULL)
+            lstate.leaf = ginBuildNewPageState(true);
+        ginBuildAddTuple(&lstate, lstate.leaf, itup);
+
+        MemoryContextReset(entryCtx);
+    }
+
+    ginBuildFinishLoad(&lstate);
+
+    MemoryContextDelete(entryCtx);
+    binaryheap_free(readerheap);
+    pfree(readers);
+}
+
+/*
+ * Build the index with worker threads.  Returns false, having done nothing,
+ * if it should or could not be built in parallel; the caller then runs the
+ * serial build.
+ */
+static bool ginParallelBuild(Relation heap, Relation index, IndexInfo *indexInfo, GinBuildState *buildstate,
+                             double *reltuples)
+{
+    int nworkers = IndexBuildParallelDegree(heap, index, indexInfo);
+    IndexBuildParallel *pbuild = NULL;
+    GinBuildShared shared;
+    int i;
+
+    if (nworkers < 2)
+        return false;
+
+    shared.queues = (GinBuildQueue *)palloc0(nworkers * sizeof(GinBuildQueue));
+    shared.indtuples = 0;
+    for (i = 0; i < nworkers; i++)
+        shared.queues[i].buf = (char *)palloc(GINBUILD_QUEUE_SIZE);
+
+    pbuild = IndexBuildParallelBegin(heap, index, indexInfo, nworkers, ginParallelScan, &shared);
+    if (pbuild == NULL) {
+        for (i = 0; i < nworkers; i++)
+            pfree(shared.queues[i].buf);
+        pfree(shared.queues);
+        return false;
+    }
+
+    /* the workers write into our memory, so never leave before they are gone */
+    PG_TRY();
+    {
+        ginParallelLoad(pbuild, buildstate);
+        *reltuples = IndexBuildParallelEnd(pbuild, indexInfo);
+    }
+    PG_CATCH();
+    {
+        IndexBuildParallelAbort(pbuild);
+        PG_RE_THROW();
+    }
+    PG_END_TRY();
+
+    buildstate->indtuples = shared.indtuples;
+
+    for (i = 0; i < nworkers; i++)
+        pfree(shared.queues[i].buf);
+    pfree(shared.queues);
+
+    return true;
+}
+
 Datum ginbuild(PG_FUNCTION_ARGS)
 {
     Relation heap = (Relation)PG_GETARG_POINTER(0);
@@ -387,21 +1227,24 @@ Datum ginbuild(PG_FUNCTION_ARGS)
 
     buildInitialize(index, &buildstate);
 
-    /*
-     * Do the heap scan.  We disallow sync scan here because dataPlaceToPage
-     * prefers to receive tuples in TID order.
-     */
-    reltuples = tableam_index_build_scan(heap, index, indexInfo, false, ginBuildCallback, (void*)&buildstate);
+    /* hand the heap scan to worker threads if the index asks for them */
+    if (!ginParallelBuild(heap, index, indexInfo, &buildstate, &reltuples)) {
+        /*
+         * Do the heap scan.  We disallow sync scan here because dataPlaceToPage
+         * prefers to receive tuples in TID order.
+         */
+        reltuples = tableam_index_build_scan(heap, index, indexInfo, false, ginBuildCallback, (void*)&buildstate);
 
-    /* dump remaining entries to the index */
-    oldCtx = MemoryContextSwitchTo(buildstate.tmpCtx);
-    ginBeginBAScan(&buildstate.accum);
-    while ((list = ginGetBAEntry(&buildstate.accum, &attnum, &key, &category, &nlist)) != NULL) {
-        /* there could be many entries, so be willing to abort here */
-        CHECK_FOR_INTERRUPTS();
-        ginEntryInsert(&buildstate.ginstate, attnum, key, category, list, nlist, &buildstate.buildStats);
+        /* dump remaining entries to the index */
+        oldCtx = MemoryContextSwitchTo(buildstate.tmpCtx);
+        ginBeginBAScan(&buildstate.accum);
+        while ((list = ginGetBAEntry(&buildstate.accum, &attnum, &key, &category, &nlist)) != NULL) {
+            /* there could be many entries, so be willing to abort here */
+            CHECK_FOR_INTERRUPTS();
+            ginEntryInsert(&buildstate.ginstate, attnum, key, category, list, nlist, &buildstate.buildStats);
+        }
+        MemoryContextSwitchTo(oldCtx);
     }
-    MemoryContextSwitchTo(oldCtx);
 
     MemoryContextDelete(buildstate.funcCtx);
     MemoryContextDelete(buildstate.tmpCtx);
@@ -20,6 +20,7 @@
 
 #include "access/genam.h"
 #include "access/gist_private.h"
+#include "access/heapam.h"
 #include "access/tableam.h"
 #include "access/xloginsert.h"
 #include "catalog/index.h"
@@ -30,6 +31,7 @@
 #include "utils/memutils.h"
 #include "utils/rel.h"
 #include "utils/rel_gs.h"
+#include "utils/tuplesort.h"
 
 /* Step of index tuples for check whether to switch to buffering build mode */
 #define BUFFERING_MODE_SWITCH_CHECK_STEP 256
@@ -50,7 +52,9 @@ typedef enum {
     /* gathering statistics of index tuple size before switching to the buffering build mode */
     GIST_BUFFERING_STATS,
     /* in buffering build mode */
-    GIST_BUFFERING_ACTIVE
+    GIST_BUFFERING_ACTIVE,
+    /* sorting the tuples on the opclass sort key, then packing the pages bottom-up */
+    GIST_SORTED_BUILD
 } GistBufferingMode;
 
 /* Working state for gistbuild and its callback */
@@ -72,8 +76,16 @@ typedef struct {
     HTAB *parentMap;
 
     GistBufferingMode bufferingMode;
+
+    Tuplesortstate *sortstate; /* used in sorted build mode */
 } GISTBuildState;
 
+/* One level of the tree being packed by a sorted build */
+typedef struct GistSortedBuildLevel {
+    Page page; /* page being filled, in local memory */
+    struct GistSortedBuildLevel *parent; /* the level above, NULL until there is one */
+} GistSortedBuildLevel;
+
 /* prototypes for private functions */
 static void gistInitBuffering(GISTBuildState *buildstate);
 static int calculatePagesPerBuffer(const GISTBuildState *buildstate, int levelStep);
@@ -95,10 +107,18 @@ static void gistMemorizeParent(GISTBuildState *buildstate, BlockNumber child, Bl
 static void gistMemorizeAllDownlinks(GISTBuildState *buildstate, Buffer parent);
 static BlockNumber gistGetParent(GISTBuildState *buildstate, BlockNumber child);
 
+static bool gistSortedBuildSupported(Relation index);
+static void gistSortedBuildCallback(Relation index, HeapTuple htup, Datum *values, const bool *isnull,
+                                    bool tupleIsAlive, void *state);
+static void gistSortedBuildLoad(GISTBuildState *buildstate);
+
 /*
  * Main entry point to GiST index build. Initially calls insert over and over,
  * but switches to more efficient buffering build algorithm after a certain
  * number of tuples (unless buffering mode is disabled).
+ *
+ * If the opclass provides a sort key, and buffering is not explicitly turned
+ * on, the tuples are sorted on it instead and the pages are packed bottom-up.
  */
 Datum gistbuild(PG_FUNCTION_ARGS)
 {
@@ -138,6 +158,10 @@ Datum gistbuild(PG_FUNCTION_ARGS)
     /* Calculate target amount of free space to leave on pages */
     buildstate.freespace = (Size)(BLCKSZ * (100 - fillfactor) / 100);
 
+    if (buildstate.bufferingMode != GIST_BUFFERING_STATS && gistSortedBuildSupported(index))
+        buildstate.bufferingMode = GIST_SORTED_BUILD;
+    buildstate.sortstate = NULL;
+
     /*
      * We expect to be called exactly once for any index relation. If that's
      * not the case, big trouble's what we have.
@@ -194,10 +218,28 @@ Datum gistbuild(PG_FUNCTION_ARGS)
     buildstate.indtuples = 0;
     buildstate.indtuplesSize = 0;
 
-    /*
-     * Do the heap scan.
-     */
-    reltuples = tableam_index_build_scan(heap, index, indexInfo, true, gistBuildCallback, (void *)&buildstate);
+    if (buildstate.bufferingMode == GIST_SORTED_BUILD) {
+        UtilityDesc *desc = &indexInfo->ii_desc;
+        int workMem = (desc->query_mem[0] > 0) ? desc->query_mem[0] : u_sess->attr.attr_memory.maintenance_work_mem;
+        int maxMem = (desc->query_mem[1] > 0) ? desc->query_mem[1] : 0;
+
+        buildstate.sortstate = tuplesort_begin_index_sortkey(index, index_getprocinfo(index, 1, GIST_SORTKEY_PROC),
+                                                             workMem, false, maxMem);
+
+        /*
+         * Do the heap scan, then load the sorted tuples.
+         */
+        reltuples = tableam_index_build_scan(heap, index, indexInfo, true, gistSortedBuildCallback,
+                                             (void *)&buildstate);
+        gistSortedBuildLoad(&buildstate);
+
+        tuplesort_end(buildstate.sortstate);
+    } else {
+        /*
+         * Do the heap scan.
+         */
+        reltuples = tableam_index_build_scan(heap, index, indexInfo, true, gistBuildCallback, (void *)&buildstate);
+    }
 
     /*
      * If buffering was used, flush out all the tuples that are still in the
@@ -1079,6 +1121,176 @@ static BlockNumber gistGetParent(GISTBuildState *buildstate, BlockNumber child)
     return entry->parentblkno;
 }
 
+/*
+ * Sorted build
+ *
+ * With an opclass sort key that keeps nearby keys close in the sort order,
+ * such as the position of a geometric key on a space-filling curve, the
+ * index tuples are sorted on it, and the leaf pages are filled one after the
+ * other in that order.  Whenever a page is full, it is written out and the
+ * union of its keys goes to the level above as its downlink, up to a single
+ * root.  This avoids all the descending and page splitting of the regular
+ * build, and the pages end up covering compact areas.
+ *
+ * Only single-column indexes are built this way, so the sort order is that
+ * of all the keys.  A cluster upgraded from a version without the sort key
+ * support function may still have the old support count in pg_am, so the
+ * procedure number is checked against it before the lookup.
+ */
+static bool gistSortedBuildSupported(Relation index)
+{
+    return IndexRelationGetNumberOfKeyAttributes(index) == 1 && GIST_SORTKEY_PROC <= index->rd_am->amsupport &&
+           OidIsValid(index_getprocid(index, 1, GIST_SORTKEY_PROC));
+}
+
+/*
+ * Per-tuple callback from IndexBuildHeapScan in sorted build mode.
+ */
+static void gistSortedBuildCallback(Relation index, HeapTuple htup, Datum *values, const bool *isnull,
+                                    bool tupleIsAlive, void *state)
+{
+    GISTBuildState *buildstate = (GISTBuildState *)state;
+    IndexTuple itup;
+    MemoryContext oldCtx;
+
+    oldCtx = MemoryContextSwitchTo(buildstate->giststate->tempCxt);
+
+    /* form an index tuple and point it at the heap tuple */
+    itup = gistFormTuple(buildstate->giststate, index, values, isnull, true);
+    itup->t_tid = htup->t_self;
+
+    tuplesort_putindextuple(buildstate->sortstate, itup);
+
+    /* Update tuple count and total size. */
+    buildstate->indtuples += 1;
+    buildstate->indtuplesSize += IndexTupleSize(itup);
+
+    (void)MemoryContextSwitchTo(oldCtx);
+    MemoryContextReset(buildstate->giststate->tempCxt);
+}
+
+static GistSortedBuildLevel *gistSortedBuildNewLevel(bool isLeaf)
+{
+    GistSortedBuildLevel *level = (GistSortedBuildLevel *)palloc(sizeof(GistSortedBuildLevel));
+
+    level->page = (Page)palloc(BLCKSZ);
+    GISTInitPage(level->page, isLeaf ? F_LEAF : 0, BLCKSZ);
+    level->parent = NULL;
+    return level;
+}
+
+/*
+ * Write out a finished page, to a new block or to the root.  Returns its
+ * block number.
+ */
+static BlockNumber gistSortedBuildWritePage(Relation index, Page page, bool isRoot)
+{
+    Buffer buffer;
+    BlockNumber blkno;
+    errno_t rc;
+
+    if (isRoot) {
+        buffer = ReadBuffer(index, GIST_ROOT_BLKNO);
+        LockBuffer(buffer, GIST_EXCLUSIVE);
+    } else {
+        buffer = gistNewBuffer(index);
+    }
+    blkno = BufferGetBlockNumber(buffer);
+
+    START_CRIT_SECTION();
+
+    rc = memcpy_s(BufferGetPage(buffer), BLCKSZ, page, BLCKSZ);
+    securec_check(rc, "\0", "\0");
+    MarkBufferDirty(buffer);
+
+    if (RelationNeedsWAL(index))
+        (void)log_newpage_buffer(buffer, true);
+    else
+        PageSetLSN(BufferGetPage(buffer), GetXLogRecPtrForTemp());
+
+    END_CRIT_SECTION();
+
+    UnlockReleaseBuffer(buffer);
+
+    return blkno;
+}
+
+static void gistSortedBuildAddTuple(GISTBuildState *buildstate, GistSortedBuildLevel *level, IndexTuple itup);
+
+/*
+ * Write out a full page that is not the root, and pass its downlink to the
+ * level above.  The downlink is made in the caller's memory context.
+ */
+static void gistSortedBuildFlushPage(GISTBuildState *buildstate, GistSortedBuildLevel *level)
+{
+    Relation index = buildstate->indexrel;
+    IndexTuple *itvec = NULL;
+    IndexTuple downlink;
+    BlockNumber blkno;
+    int len;
+
+    itvec = gistextractpage(level->page, &len);
+    downlink = gistunion(index, itvec, len, buildstate->giststate);
+
+    blkno = gistSortedBuildWritePage(index, level->page, false);
+    ItemPointerSetBlockNumber(&(downlink->t_tid), blkno);
+    GistTupleSetValid(downlink);
+
+    if (level->parent == NULL)
+        level->parent = gistSortedBuildNewLevel(false);
+    gistSortedBuildAddTuple(buildstate, level->parent, downlink);
+
+    GISTInitPage(level->page, GistPageGetOpaque(level->page)->flags, BLCKSZ);
+}
+
+static void gistSortedBuildAddTuple(GISTBuildState *buildstate, GistSortedBuildLevel *level, IndexTuple itup)
+{
+    Page page = level->page;
+
+    if (!PageIsEmpty(page) && gistnospace(page, &itup, 1, InvalidOffsetNumber, buildstate->freespace))
+        gistSortedBuildFlushPage(buildstate, level);
+
+    if (PageAddItem(page, (Item)itup, IndexTupleSize(itup), InvalidOffsetNumber, false, false) == InvalidOffsetNumber)
+        ereport(ERROR, (errcode(ERRCODE_INDEX_CORRUPTED), errmsg("failed to add item to index page in \"%s\"",
+                                                                 RelationGetRelationName(buildstate->indexrel))));
+}
+
+/*
+ * Pack the sorted tuples into the index.
+ */
+static void gistSortedBuildLoad(GISTBuildState *buildstate)
+{
+    GistSortedBuildLevel *leaf = NULL;
+    GistSortedBuildLevel *level = NULL;
+    IndexTuple itup;
+    bool should_free = false;
+    MemoryContext oldCtx;
+
+    tuplesort_performsort(buildstate->sortstate);
+
+    leaf = gistSortedBuildNewLevel(true);
+
+    /* downlinks are made in tempCxt, which we reset once per tuple */
+    oldCtx = MemoryContextSwitchTo(buildstate->giststate->tempCxt);
+    while ((itup = tuplesort_getindextuple(buildstate->sortstate, true, &should_free)) != NULL) {
+        CHECK_FOR_INTERRUPTS();
+
+        gistSortedBuildAddTuple(buildstate, leaf, itup);
+        if (should_free)
+            pfree(itup);
+        MemoryContextReset(buildstate->giststate->tempCxt);
+    }
+
+    /* write out the last page of every level; the only page of the top level is the root */
+    for (level = leaf; level != NULL; level = level->parent) {
+        if (level->parent == NULL)
+            (void)gistSortedBuildWritePage(buildstate->indexrel, level->page, true);
+        else
+            gistSortedBuildFlushPage(buildstate, level);
+    }
+    (void)MemoryContextSwitchTo(oldCtx);
+}
+
 Datum gistmerge(PG_FUNCTION_ARGS)
 {
     IndexBuildResult *result = NULL;
@@ -1225,6 +1225,17 @@ Datum gist_point_consistent(PG_FUNCTION_ARGS)
     PG_RETURN_BOOL(result);
 }
 
+/*
+ * Sort key for the sorted build: the Z-order position of the center of the
+ * key.  Polygons, circles and points are all stored as boxes.
+ */
+Datum gist_box_sortkey(PG_FUNCTION_ARGS)
+{
+    BOX *box = PG_GETARG_BOX_P(0);
+
+    PG_RETURN_INT64((int64)point_zorder(box->low.x / 2.0 + box->high.x / 2.0, box->low.y / 2.0 + box->high.y / 2.0));
+}
+
 Datum gist_point_distance(PG_FUNCTION_ARGS)
 {
     GISTENTRY *entry = (GISTENTRY *)PG_GETARG_POINTER(0);
@@ -26,6 +26,15 @@
 #include "storage/lmgr.h"
 #include "storage/smgr.h"
 #include "utils/snapmgr.h"
+#include "utils/timestamp.h"
+
+/*
+ * A backend that used up its last reserved extent within HEAP_EXTENT_FAST_MS
+ * reserves twice as many blocks next time, one that needed more than
+ * HEAP_EXTENT_SLOW_MS reserves half as many.
+ */
+#define HEAP_EXTENT_FAST_MS 100
+#define HEAP_EXTENT_SLOW_MS 1000
 
 /*
  * RelationPutHeapTuple - place tuple at specified page
@@ -196,6 +205,94 @@ void RelationAddExtraBlocks(Relation relation, BulkInsertState bistate)
     UpdateFreeSpaceMap(relation, first_block, block_num, freespace);
 }
 
+/*
+ * Take the next unused block of the extent this backend reserved, or
+ * InvalidBlockNumber if there is none left.
+ */
+static BlockNumber RelationTakeExtentBlock(Relation relation)
+{
+    SMgrRelation smgr;
+
+    RelationOpenSmgr(relation);
+    smgr = relation->rd_smgr;
+    if (smgr->smgr_extent_next == InvalidBlockNumber || smgr->smgr_extent_next >= smgr->smgr_extent_end) {
+        return InvalidBlockNumber;
+    }
+    return smgr->smgr_extent_next++;
+}
+
+/*
+ * Reserve an extent of new blocks for this backend's own inserts.  The
+ * caller holds the relation extension lock and adds one more block for the
+ * current tuple afterwards.
+ *
+ * The backend fills the blocks one after another without going back to the
+ * extension lock, which is what makes many sessions appending to the same
+ * table scale.  The extent size follows the rate at which this backend used
+ * up the previous one, capped by heap_extent_max_blocks.  As in
+ * RelationAddExtraBlocks, the blocks are also entered into the FSM, so that
+ * blocks left over when the backend stops inserting are not lost until the
+ * next VACUUM.
+ */
+static void RelationReserveExtent(Relation relation, BulkInsertState bistate)
+{
+    SMgrRelation smgr;
+    TimestampTz now = GetCurrentTimestamp();
+    int max_blocks = u_sess->attr.attr_storage.heap_extent_max_blocks;
+    int extent_size;
+    BlockNumber block_num = InvalidBlockNumber;
+    BlockNumber first_block = InvalidBlockNumber;
+    Size freespace = 0;
+    Buffer buffer;
+    Page page;
+    HeapPageHeader phdr;
+
+    RelationOpenSmgr(relation);
+    smgr = relation->rd_smgr;
+    extent_size = smgr->smgr_extent_size;
+    if (extent_size <= 0) {
+        extent_size = 1;
+    } else if (TimestampDifferenceExceeds(smgr->smgr_extent_time, now, HEAP_EXTENT_SLOW_MS)) {
+        extent_size /= 2;
+    } else if (!TimestampDifferenceExceeds(smgr->smgr_extent_time, now, HEAP_EXTENT_FAST_MS)) {
+        extent_size *= 2;
+    }
+    extent_size = Max(1, Min(extent_size, max_blocks));
+    smgr->smgr_extent_size = extent_size;
+    smgr->smgr_extent_time = now;
+
+    /* The caller's own block counts as the first block of the extent */
+    for (int i = 1; i < extent_size; i++) {
+        buffer = ReadBufferBI(relation, P_NEW, bistate);
+
+        LockBuffer(buffer, BUFFER_LOCK_EXCLUSIVE);
+        page = BufferGetPage(buffer);
+        phdr = (HeapPageHeader)page;
+        PageInit(page, BufferGetPageSize(buffer), 0, true);
+        phdr->pd_xid_base = u_sess->utils_cxt.RecentXmin - FirstNormalTransactionId;
+        phdr->pd_multi_base = 0;
+        MarkBufferDirty(buffer);
+        block_num = BufferGetBlockNumber(buffer);
+        freespace = PageGetHeapFreeSpace(page);
+        UnlockReleaseBuffer(buffer);
+
+        if (first_block == InvalidBlockNumber) {
+            first_block = block_num;
+        }
+
+        RecordPageWithFreeSpace(relation, block_num, freespace);
+    }
+
+    /* The relation extension lock keeps the blocks contiguous */
+    if (first_block != InvalidBlockNumber) {
+        UpdateFreeSpaceMap(relation, first_block, block_num, freespace);
+
+        RelationOpenSmgr(relation);
+        relation->rd_smgr->smgr_extent_next = first_block;
+        relation->rd_smgr->smgr_extent_end = block_num + 1;
+    }
+}
+
 /*
  * For each heap page which is all-visible, acquire a pin on the appropriate
  * visibility map page, if we haven't already got one.
@@ -336,7 +433,8 @@ Buffer RelationGetBufferForTuple(Relation relation, Size len, Buffer other_buffe
     Size page_free_space = 0;
     Size save_free_space = 0;
     BlockNumber target_block, other_block;
-    bool need_lock = false;
+    bool need_lock = !RELATION_IS_LOCAL(relation);
+    bool use_extent = false;
     Size extralen = 0;
     HeapPageHeader phdr;
 
@@ -418,6 +516,13 @@ Buffer RelationGetBufferForTuple(Relation relation, Size len, Buffer other_buffe
         target_block = InvalidBlockNumber;
     }
 
+    /*
+     * Shared relations filled through the FSM may reserve extents of new
+     * blocks for this backend, see RelationReserveExtent.
+     */
+    use_extent = need_lock && use_fsm && end_rel_block == InvalidBlockNumber &&
+                 u_sess->attr.attr_storage.heap_extent_max_blocks > 0;
+
 loop:
     while (target_block != InvalidBlockNumber) {
         /*
@@ -544,6 +649,14 @@ loop:
                                                      len + save_free_space + extralen);
     }
 
+    /* Move on to the next block of our own extent before extending again */
+    if (use_extent) {
+        target_block = RelationTakeExtentBlock(relation);
+        if (target_block != InvalidBlockNumber) {
+            goto loop;
+        }
+    }
+
     /*
      * Have to extend the relation.
      *
@@ -552,7 +665,6 @@ loop:
      * can skip locking for new or temp relations, however, since no one else
      * could be accessing them.
      */
-    need_lock = !RELATION_IS_LOCAL(relation);
     /*
      * If we need the lock but are not able to acquire it immediately, we'll
      * consider extending the relation by multiple blocks at a time to manage
@@ -582,6 +694,10 @@ loop:
             /* Time to bulk-extend. */
             RelationAddExtraBlocks(relation, bistate);
         }
+
+        if (use_extent) {
+            RelationReserveExtent(relation, bistate);
+        }
     }
 
     /*
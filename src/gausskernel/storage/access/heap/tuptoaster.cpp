@@ -32,11 +32,11 @@
 
 #include "access/genam.h"
 #include "access/heapam.h"
+#include "access/toast_compression.h"
 #include "access/tuptoaster.h"
 #include "access/xact.h"
 #include "catalog/catalog.h"
 #include "utils/fmgroids.h"
-#include "utils/pg_lzcompress.h"
 #include "utils/rel.h"
 #include "utils/rel_gs.h"
 #include "utils/typcache.h"
@@ -121,11 +121,9 @@ struct varlena *heap_tuple_untoast_attr(struct varlena *attr)
         attr = toast_fetch_datum(attr);
         /* If it's compressed, decompress it */
         if (VARATT_IS_COMPRESSED(attr)) {
-            PGLZ_Header *tmp = (PGLZ_Header *)attr;
+            struct varlena *tmp = attr;
 
-            attr = (struct varlena *)palloc(PGLZ_RAW_SIZE(tmp) + VARHDRSZ);
-            SET_VARSIZE(attr, PGLZ_RAW_SIZE(tmp) + VARHDRSZ);
-            pglz_decompress(tmp, VARDATA(attr));
+            attr = toast_decompress_varlena(tmp);
             pfree(tmp);
         }
     } else if (VARATT_IS_EXTERNAL_INDIRECT(attr)) {
@@ -141,11 +139,7 @@ struct varlena *heap_tuple_untoast_attr(struct varlena *attr)
         /*
          * This is a compressed value inside of the main tuple
          */
-        PGLZ_Header *tmp = (PGLZ_Header *)attr;
-
-        attr = (struct varlena *)palloc(PGLZ_RAW_SIZE(tmp) + VARHDRSZ);
-        SET_VARSIZE(attr, PGLZ_RAW_SIZE(tmp) + VARHDRSZ);
-        pglz_decompress(tmp, VARDATA(attr));
+        attr = toast_decompress_varlena(attr);
     } else if (VARATT_IS_SHORT(attr)) {
         /*
          * This is a short-header varlena --- convert to 4-byte header format
@@ -203,14 +197,15 @@ struct varlena *heap_tuple_untoast_attr_slice(struct varlena *attr, int32 slice_
         preslice = attr;
 
     if (VARATT_IS_COMPRESSED(preslice)) {
-        PGLZ_Header *tmp = (PGLZ_Header *)preslice;
-        Size size = PGLZ_RAW_SIZE(tmp) + VARHDRSZ;
+        struct varlena *tmp = preslice;
 
-        preslice = (struct varlena *)palloc(size);
-        SET_VARSIZE(preslice, size);
-        pglz_decompress(tmp, VARDATA(preslice));
+        /* no need to decompress beyond the end of the slice */
+        if (slice_offset >= 0 && slice_length >= 0 && (int64)slice_offset + slice_length <= PG_INT32_MAX)
+            preslice = toast_decompress_varlena_slice(tmp, slice_offset + slice_length);
+        else
+            preslice = toast_decompress_varlena(tmp);
 
-        if (tmp != (PGLZ_Header *)attr)
+        if (tmp != attr)
             pfree(tmp);
     }
 
@@ -304,7 +299,7 @@ Size toast_datum_size(Datum value)
         struct varatt_external toast_pointer;
 
         VARATT_EXTERNAL_GET_POINTER(toast_pointer, attr);
-        result = toast_pointer.va_extsize;
+        result = VARATT_EXTERNAL_GET_EXTSIZE(toast_pointer);
     } else if (VARATT_IS_EXTERNAL_INDIRECT(attr)) {
         struct varatt_indirect toast_pointer;
 
@@ -636,7 +631,7 @@ HeapTuple toast_insert_or_update(Relation rel, HeapTuple newtup, HeapTuple oldtu
         i = biggest_attno;
         if (att[i]->attstorage == 'x') {
             old_value = toast_values[i];
-            new_value = toast_compress_datum(old_value);
+            new_value = toast_compress_datum(old_value, toast_get_column_compression(rel, i + 1));
             if (DatumGetPointer(new_value) != NULL) {
                 /* successful compression */
                 if (toast_free[i]) {
@@ -770,7 +765,7 @@ HeapTuple toast_insert_or_update(Relation rel, HeapTuple newtup, HeapTuple oldtu
          */
         i = biggest_attno;
         old_value = toast_values[i];
-        new_value = toast_compress_datum(old_value);
+        new_value = toast_compress_datum(old_value, toast_get_column_compression(rel, i + 1));
         if (DatumGetPointer(new_value) != NULL) {
             /* successful compression */
             if (toast_free[i]) {
@@ -1149,7 +1144,8 @@ Datum toast_flatten_tuple_attribute(Datum value, Oid typeId, int32 typeMod)
 /* ----------
  * toast_compress_datum -
  *
- *	Create a compressed version of a varlena datum
+ *	Create a compressed version of a varlena datum, using the given
+ *	compression method
  *
  *	If we fail (ie, compressed result is actually bigger than original)
  *	then return NULL.  We must not use compressed data if it'd expand
@@ -1159,41 +1155,57 @@ Datum toast_flatten_tuple_attribute(Datum value, Oid typeId, int32 typeMod)
  *	copying them.  But we can't handle external or compressed datums.
  * ----------
  */
-Datum toast_compress_datum(Datum value)
+Datum toast_compress_datum(Datum value, ToastCompressionId cmid)
 {
-    struct varlena *tmp = NULL;
-    int32 valsize = VARSIZE_ANY_EXHDR(DatumGetPointer(value));
+    return PointerGetDatum(toast_compress_varlena((struct varlena *)DatumGetPointer(value), cmid));
+}
 
-    Assert(!VARATT_IS_EXTERNAL(DatumGetPointer(value)));
-    Assert(!VARATT_IS_COMPRESSED(DatumGetPointer(value)));
+/* ----------
+ * toast_get_column_compression -
+ *
+ *	Return the compression method for new values of a column: its
+ *	toast_compression option if set, else default_toast_compression.
+ *	The relcache keeps the options in the tuple descriptor, which
+ *	partitions share with their table.
+ * ----------
+ */
+ToastCompressionId toast_get_column_compression(Relation rel, int attnum)
+{
+    uint8 *attcompression = rel->rd_att->attcompression;
 
-    /*
-     * No point in wasting a palloc cycle if value size is out of the allowed
-     * range for compression
-     */
-    if (valsize < PGLZ_strategy_default->min_input_size || valsize > PGLZ_strategy_default->max_input_size)
-        return PointerGetDatum(NULL);
+    if (attcompression != NULL && attcompression[attnum - 1] != TOAST_INVALID_COMPRESSION_ID)
+        return (ToastCompressionId)attcompression[attnum - 1];
+    return (ToastCompressionId)u_sess->attr.attr_storage.default_toast_compression;
+}
 
-    tmp = (struct varlena *)palloc(PGLZ_MAX_OUTPUT(valsize));
-    /*
-     * We recheck the actual size even if pglz_compress() reports success,
-     * because it might be satisfied with having saved as little as one byte
-     * in the compressed data --- which could turn into a net loss once you
-     * consider header and alignment padding.  Worst case, the compressed
-     * format might require three padding bytes (plus header, which is
-     * included in VARSIZE(tmp)), whereas the uncompressed format would take
-     * only one header byte and no padding if the value is short enough.  So
-     * we insist on a savings of more than 2 bytes to ensure we have a gain.
-     */
-    if (pglz_compress(VARDATA_ANY(DatumGetPointer(value)), valsize, (PGLZ_Header *)tmp, PGLZ_strategy_default) &&
-        VARSIZE(tmp) < (uint32)(valsize - 2)) {
-        /* successful compression */
-        return PointerGetDatum(tmp);
-    } else {
-        /* incompressible data */
-        pfree(tmp);
-        return PointerGetDatum(NULL);
+/* ----------
+ * toast_get_compression_id -
+ *
+ *	Return the compression method of a varlena datum, or
+ *	TOAST_INVALID_COMPRESSION_ID if it is not compressed.  Only the
+ *	header or the toast pointer is looked at.
+ * ----------
+ */
+ToastCompressionId toast_get_compression_id(struct varlena *attr)
+{
+    ToastCompressionId cmid = TOAST_INVALID_COMPRESSION_ID;
+
+    if (VARATT_IS_EXTERNAL_ONDISK_B(attr)) {
+        struct varatt_external toast_pointer;
+
+        VARATT_EXTERNAL_GET_POINTER(toast_pointer, attr);
+        if (VARATT_EXTERNAL_IS_COMPRESSED(toast_pointer))
+            cmid = (ToastCompressionId)VARATT_EXTERNAL_GET_COMPRESSID(toast_pointer);
+    } else if (VARATT_IS_EXTERNAL_INDIRECT(attr)) {
+        struct varatt_indirect redirect;
+
+        VARATT_EXTERNAL_GET_POINTER(redirect, attr);
+        cmid = toast_get_compression_id(redirect.pointer);
+    } else if (VARATT_IS_COMPRESSED(attr)) {
+        cmid = (ToastCompressionId)VARCOMPRESSID_4B_C(attr);
     }
+
+    return cmid;
 }
 
 /* ----------
@@ -1248,31 +1260,32 @@ static Datum toast_save_datum(Relation rel, Datum value, struct varlena *oldexte
     toastidx = index_open(toastrel->rd_rel->reltoastidxid, RowExclusiveLock, bucketid);
 
     /*
-     * Get the data pointer and length, and compute va_rawsize and va_extsize.
+     * Get the data pointer and length, and compute va_rawsize and va_extinfo.
      *
      * va_rawsize is the size of the equivalent fully uncompressed datum, so
      * we have to adjust for short headers.
      *
-     * va_extsize is the actual size of the data payload in the toast records.
+     * va_extinfo is the actual size of the data payload in the toast records,
+     * plus the compression method of compressed data.
      */
     if (VARATT_IS_SHORT(dval)) {
         data_p = VARDATA_SHORT(dval);
         data_todo = VARSIZE_SHORT(dval) - VARHDRSZ_SHORT;
         toast_pointer.va_rawsize = data_todo + VARHDRSZ; /* as if not short */
-        toast_pointer.va_extsize = data_todo;
+        VARATT_EXTERNAL_SET_SIZE_AND_COMPRESSID(toast_pointer, data_todo, 0);
     } else if (VARATT_IS_COMPRESSED(dval)) {
         data_p = VARDATA(dval);
         data_todo = VARSIZE(dval) - VARHDRSZ;
         /* rawsize in a compressed datum is just the size of the payload */
         toast_pointer.va_rawsize = VARRAWSIZE_4B_C(dval) + VARHDRSZ;
-        toast_pointer.va_extsize = data_todo;
+        VARATT_EXTERNAL_SET_SIZE_AND_COMPRESSID(toast_pointer, data_todo, VARCOMPRESSID_4B_C(dval));
         /* Assert that the numbers look like it's compressed */
         Assert(VARATT_EXTERNAL_IS_COMPRESSED(toast_pointer));
     } else {
         data_p = VARDATA(dval);
         data_todo = VARSIZE(dval) - VARHDRSZ;
         toast_pointer.va_rawsize = VARSIZE(dval);
-        toast_pointer.va_extsize = data_todo;
+        VARATT_EXTERNAL_SET_SIZE_AND_COMPRESSID(toast_pointer, data_todo, 0);
     }
 
     /*
@@ -1579,7 +1592,7 @@ static struct varlena *toast_fetch_datum(struct varlena *attr)
     /* Must copy to access aligned fields */
     VARATT_EXTERNAL_GET_POINTER_B(toast_pointer, attr, bucketid);
 
-    ressize = toast_pointer.va_extsize;
+    ressize = VARATT_EXTERNAL_GET_EXTSIZE(toast_pointer);
     numchunks = ((ressize - 1) / TOAST_MAX_CHUNK_SIZE) + 1;
 
     result = (struct varlena *)palloc(ressize + VARHDRSZ);
@@ -1745,7 +1758,7 @@ static struct varlena *toast_fetch_datum_slice(struct varlena *attr, int32 slice
      */
     Assert(!VARATT_EXTERNAL_IS_COMPRESSED(toast_pointer));
 
-    attrsize = toast_pointer.va_extsize;
+    attrsize = VARATT_EXTERNAL_GET_EXTSIZE(toast_pointer);
     totalchunks = ((attrsize - 1) / TOAST_MAX_CHUNK_SIZE) + 1;
 
     if (sliceoffset >= attrsize) {
@@ -0,0 +1,687 @@
+/* -------------------------------------------------------------------------
+ *
+ * parallelbuild.cpp
+ *	  Worker threads that share the heap scan of an index build.
+ *
+ * The same workers also vacuum the indexes of a table in parallel; such a
+ * worker opens only the heap, and the vacuum code hands it indexes one at
+ * a time through its shared state (see IndexVacuumParallelBegin).
+ *
+ * The leader launches nworkers INDEX_BUILD_WORKER threads.  Each worker
+ * attaches to the leader's transaction the way an SMP stream thread does
+ * (same xid, command id, combo cids and snapshot), opens the heap and the
+ * index without taking locks of its own, and runs the access method's
+ * worker function over its stripes of the heap.  The access method moves
+ * the results back to the leader through its own shared state, protected
+ * by pbuild->mutex.  Workers never commit or abort the leader's xid; they
+ * drop it before ending their local transaction.
+ *
+ * Portions Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ *
+ * IDENTIFICATION
+ *	  src/gausskernel/storage/access/index/parallelbuild.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+#include "postgres.h"
+#include "knl/knl_variable.h"
+
+#include "access/heapam.h"
+#include "access/parallelbuild.h"
+#include "access/relscan.h"
+#include "access/xact.h"
+#include "catalog/catalog.h"
+#include "catalog/index.h"
+#include "catalog/pg_class.h"
+#include "commands/dbcommands.h"
+#include "miscadmin.h"
+#include "postmaster/postmaster.h"
+#include "storage/ipc.h"
+#include "storage/pmsignal.h"
+#include "storage/procarray.h"
+#include "tcop/tcopprot.h"
+#include "utils/lsyscache.h"
+#include "utils/memutils.h"
+#include "utils/partcache.h"
+#include "utils/postinit.h"
+#include "utils/rel.h"
+#include "utils/rel_gs.h"
+#include "utils/resowner.h"
+#include "utils/snapmgr.h"
+
+/* defined in execStream.cpp */
+extern void StreamSaveTxnContext(StreamTxnContext* stc);
+extern void StreamRestoreTxnContext(StreamTxnContext* stc);
+
+/* how long the leader sleeps before it rechecks for interrupts and failed workers */
+#define INDEX_BUILD_WAIT_MS 100
+
+static IndexBuildParallel* IndexBuildParallelCreate(Relation heap, int nworkers, IndexBuildWorkerFunc workerFunc,
+    void* amstate);
+static bool IndexBuildParallelLaunch(IndexBuildParallel* pbuild);
+static void IndexBuildWorkerQuit(int code, Datum arg);
+static void IndexBuildWorkerRun(IndexBuildWorkerSlot* slot);
+static void IndexBuildWorkerSaveError(IndexBuildWorkerSlot* slot);
+static void IndexBuildTimedWait(IndexBuildParallel* pbuild);
+static void IndexBuildParallelWaitFinished(IndexBuildParallel* pbuild);
+static void IndexBuildParallelFree(IndexBuildParallel* pbuild);
+
+/*
+ * IndexBuildParallelDegree
+ *		Number of workers to build this index with, or 0 to build serially.
+ *
+ * The index's parallel_workers storage parameter wins over the
+ * max_parallel_maintenance_workers GUC.  Each worker scans stripes of
+ * PARALLEL_SCAN_GAP blocks, so small heaps get fewer workers.
+ */
+int IndexBuildParallelDegree(Relation heap, Relation index, IndexInfo* indexInfo)
+{
+    int nworkers = RelationGetParallelWorkers(index, -1);
+    BlockNumber nblocks;
+
+    if (nworkers < 0)
+        nworkers = u_sess->attr.attr_storage.max_parallel_maintenance_workers;
+    /* the leader only merges, so a single worker would buy nothing */
+    if (nworkers < 2)
+        return 0;
+
+    if (!IsUnderPostmaster || IsBootstrapProcessingMode() || RecoveryInProgress() || IsSubTransaction())
+        return 0;
+
+    /*
+     * Workers run with their own session settings, so leave out anything
+     * that evaluates user expressions, and relations only this session can
+     * see or that need the catalog-specific handling of IndexBuildHeapScan.
+     */
+    if (indexInfo->ii_Expressions != NIL || indexInfo->ii_Predicate != NIL)
+        return 0;
+    if (IsSystemRelation(heap) || RelationUsesLocalBuffers(heap) || RelationIsGlobalIndex(index) ||
+        RELATION_OWN_BUCKET(heap) || heap->rd_tam_type != TAM_HEAP)
+        return 0;
+
+    /* workers can reopen a partition of a plain table, but not a subpartition */
+    if (OidIsValid(heap->parentId) && get_rel_relkind(heap->parentId) != RELKIND_RELATION)
+        return 0;
+    if (OidIsValid(index->parentId) && get_rel_relkind(index->parentId) != RELKIND_INDEX)
+        return 0;
+
+    nblocks = RelationGetNumberOfBlocks(heap);
+    if ((BlockNumber)nworkers > nblocks / PARALLEL_SCAN_GAP)
+        nworkers = (int)(nblocks / PARALLEL_SCAN_GAP);
+
+    return (nworkers >= 2) ? nworkers : 0;
+}
+
+/*
+ * IndexBuildParallelBegin
+ *		Launch nworkers threads running workerFunc.
+ *
+ * Returns NULL if not all of them could be started; every worker owns a
+ * fixed share of the heap, so the caller then builds serially instead.
+ */
+IndexBuildParallel* IndexBuildParallelBegin(Relation heap, Relation index, IndexInfo* indexInfo, int nworkers,
+    IndexBuildWorkerFunc workerFunc, void* amstate)
+{
+    IndexBuildParallel* pbuild = IndexBuildParallelCreate(heap, nworkers, workerFunc, amstate);
+    int sortMem;
+
+    pbuild->indexOid = RelationGetRelid(index);
+    pbuild->indexParentOid = index->parentId;
+    pbuild->isConcurrent = indexInfo->ii_Concurrent;
+
+    /* split the memory the serial build would have sorted in */
+    sortMem = (indexInfo->ii_desc.query_mem[0] > 0) ? indexInfo->ii_desc.query_mem[0]
+                                                     : u_sess->attr.attr_memory.maintenance_work_mem;
+    pbuild->sortMem = Max(sortMem / nworkers, 64);
+
+    if (pbuild->isConcurrent && pbuild->txnCxt.snapshot == NULL) {
+        IndexBuildParallelFree(pbuild);
+        return NULL;
+    }
+
+    if (!IndexBuildParallelLaunch(pbuild)) {
+        ereport(LOG,
+            (errmsg("could only start %d of %d workers to build index \"%s\", building it serially",
+                pbuild->nlaunched, nworkers, RelationGetRelationName(index))));
+        IndexBuildParallelAbort(pbuild);
+        return NULL;
+    }
+
+    ereport(DEBUG1, (errmsg("building index \"%s\" with %d workers", RelationGetRelationName(index), nworkers)));
+    return pbuild;
+}
+
+/*
+ * IndexVacuumParallelBegin
+ *		Launch nworkers threads running workerFunc for a vacuum of heap's
+ *		indexes.
+ *
+ * The workers get no index of their own; workerFunc opens the indexes it
+ * hands out through amstate.  Returns NULL if not all of them could be
+ * started, in which case the caller vacuums the indexes itself.
+ */
+IndexBuildParallel* IndexVacuumParallelBegin(Relation heap, int nworkers, IndexBuildWorkerFunc workerFunc,
+    void* amstate)
+{
+    IndexBuildParallel* pbuild = IndexBuildParallelCreate(heap, nworkers, workerFunc, amstate);
+
+    pbuild->isVacuum = true;
+    /* the leader vacuums indexes too, so split maintenance_work_mem one way more */
+    pbuild->sortMem = Max(u_sess->attr.attr_memory.maintenance_work_mem / (nworkers + 1), 64);
+
+    if (!IndexBuildParallelLaunch(pbuild)) {
+        ereport(LOG,
+            (errmsg("could only start %d of %d workers to vacuum the indexes of \"%s\", vacuuming them serially",
+                pbuild->nlaunched, nworkers, RelationGetRelationName(heap))));
+        IndexBuildParallelAbort(pbuild);
+        return NULL;
+    }
+
+    ereport(DEBUG1,
+        (errmsg("vacuuming the indexes of \"%s\" with %d workers", RelationGetRelationName(heap), nworkers)));
+    return pbuild;
+}
+
+/*
+ * Set up the state shared with the workers, from the leader's session.
+ */
+static IndexBuildParallel* IndexBuildParallelCreate(Relation heap, int nworkers, IndexBuildWorkerFunc workerFunc,
+    void* amstate)
+{
+    IndexBuildParallel* pbuild = (IndexBuildParallel*)palloc0(sizeof(IndexBuildParallel));
+
+    pbuild->nworkers = nworkers;
+    pbuild->workerFunc = workerFunc;
+    pbuild->amstate = amstate;
+    pbuild->heapOid = RelationGetRelid(heap);
+    pbuild->heapParentOid = heap->parentId;
+    pbuild->indexOid = InvalidOid;
+    pbuild->indexParentOid = InvalidOid;
+    pbuild->dbName = get_database_name(u_sess->proc_cxt.MyDatabaseId);
+    pbuild->userName = GetUserNameFromId(GetSessionUserId());
+    pbuild->workMem = u_sess->attr.attr_memory.work_mem;
+
+    pbuild->txnCxt.txnId = GetCurrentTransactionIdIfAny();
+    pbuild->txnCxt.snapshot = ActiveSnapshotSet() ? GetActiveSnapshot() : NULL;
+    StreamSaveTxnContext(&pbuild->txnCxt);
+
+    return pbuild;
+}
+
+/*
+ * Start the workers.  Returns false if not all of them could be started.
+ */
+static bool IndexBuildParallelLaunch(IndexBuildParallel* pbuild)
+{
+    int i;
+
+    (void)pthread_mutex_init(&pbuild->mutex, NULL);
+    (void)pthread_cond_init(&pbuild->cond, NULL);
+
+    pbuild->workers = (IndexBuildWorkerSlot*)palloc0(pbuild->nworkers * sizeof(IndexBuildWorkerSlot));
+    for (i = 0; i < pbuild->nworkers; i++) {
+        IndexBuildWorkerSlot* slot = &pbuild->workers[i];
+        ThreadId tid;
+
+        slot->pbuild = pbuild;
+        slot->workerId = i;
+        slot->childSlot = AssignPostmasterChildSlot();
+        if (slot->childSlot == -1)
+            break;
+
+        tid = initialize_util_thread(INDEX_BUILD_WORKER, slot);
+        if (tid == 0) {
+            (void)ReleasePostmasterChildSlot(slot->childSlot);
+            break;
+        }
+        pbuild->nlaunched++;
+    }
+
+    return pbuild->nlaunched == pbuild->nworkers;
+}
+
+/*
+ * IndexBuildParallelWait
+ *		Leader sleeps on pbuild->cond; the caller holds pbuild->mutex.
+ *
+ * Wakes up at least every INDEX_BUILD_WAIT_MS.  A pending interrupt or a
+ * failed worker is raised with the mutex released.
+ */
+void IndexBuildParallelWait(IndexBuildParallel* pbuild)
+{
+    bool failed = false;
+    int i;
+
+    IndexBuildTimedWait(pbuild);
+
+    for (i = 0; i < pbuild->nlaunched; i++) {
+        if (pbuild->workers[i].failed) {
+            failed = true;
+            break;
+        }
+    }
+
+    if (failed || InterruptPending) {
+        (void)pthread_mutex_unlock(&pbuild->mutex);
+        IndexBuildParallelCheck(pbuild);
+        (void)pthread_mutex_lock(&pbuild->mutex);
+    }
+}
+
+/*
+ * IndexBuildParallelCheck
+ *		Leader re-raises the first worker error, if any.
+ */
+void IndexBuildParallelCheck(IndexBuildParallel* pbuild)
+{
+    IndexBuildWorkerSlot* failed = NULL;
+    int i;
+
+    CHECK_FOR_INTERRUPTS();
+
+    (void)pthread_mutex_lock(&pbuild->mutex);
+    for (i = 0; i < pbuild->nlaunched; i++) {
+        if (pbuild->workers[i].failed) {
+            failed = &pbuild->workers[i];
+            break;
+        }
+    }
+    (void)pthread_mutex_unlock(&pbuild->mutex);
+
+    if (failed != NULL) {
+        ereport(ERROR,
+            (errcode(failed->sqlerrcode),
+                errmsg("%s", failed->message),
+                failed->detail[0] != '\0' ? errdetail("%s", failed->detail) : 0,
+                errcontext(pbuild->isVacuum ? "parallel index vacuum worker %d" : "parallel index build worker %d",
+                    failed->workerId)));
+    }
+}
+
+/*
+ * IndexBuildParallelEnd
+ *		Wait for all workers, raise the first worker error, and fold the
+ *		workers' scan results into the leader's indexInfo, if any.
+ *
+ * Returns the number of heap tuples scanned.
+ */
+double IndexBuildParallelEnd(IndexBuildParallel* pbuild, IndexInfo* indexInfo)
+{
+    double reltuples = 0;
+    int i;
+
+    IndexBuildParallelWaitFinished(pbuild);
+    IndexBuildParallelCheck(pbuild);
+
+    for (i = 0; i < pbuild->nlaunched; i++) {
+        reltuples += pbuild->workers[i].reltuples;
+        if (pbuild->workers[i].brokenHotChain && indexInfo != NULL)
+            indexInfo->ii_BrokenHotChain = true;
+    }
+
+    (void)pthread_mutex_destroy(&pbuild->mutex);
+    (void)pthread_cond_destroy(&pbuild->cond);
+    IndexBuildParallelFree(pbuild);
+
+    return reltuples;
+}
+
+/*
+ * IndexBuildParallelAbort
+ *		Stop all workers and wait until they are gone.
+ *
+ * Used when the leader errors out; the workers reference the leader's
+ * memory and transaction state, so it must not unwind before they exit.
+ * pbuild is freed.
+ */
+void IndexBuildParallelAbort(IndexBuildParallel* pbuild)
+{
+    int i;
+
+    HOLD_INTERRUPTS();
+
+    (void)pthread_mutex_lock(&pbuild->mutex);
+    pbuild->aborting = true;
+    (void)pthread_cond_broadcast(&pbuild->cond);
+    (void)pthread_mutex_unlock(&pbuild->mutex);
+
+    IndexBuildParallelWaitFinished(pbuild);
+
+    (void)pthread_mutex_destroy(&pbuild->mutex);
+    (void)pthread_cond_destroy(&pbuild->cond);
+
+    RESUME_INTERRUPTS();
+    for (i = 0; i < pbuild->nlaunched; i++)
+        Assert(pbuild->workers[i].finished);
+
+    IndexBuildParallelFree(pbuild);
+}
+
+/*
+ * IndexBuildWorkerWait
+ *		Worker sleeps on pbuild->cond; the caller holds pbuild->mutex.
+ *
+ * Raises an error, with the mutex released, once the leader gave up or
+ * we are told to cancel.
+ */
+void IndexBuildWorkerWait(IndexBuildParallel* pbuild)
+{
+    IndexBuildTimedWait(pbuild);
+
+    if (pbuild->aborting || InterruptPending) {
+        (void)pthread_mutex_unlock(&pbuild->mutex);
+        IndexBuildWorkerCheckAbort(pbuild);
+        (void)pthread_mutex_lock(&pbuild->mutex);
+    }
+}
+
+/*
+ * IndexBuildWorkerCheckAbort
+ *		Worker raises an error once its leader gave up.
+ */
+void IndexBuildWorkerCheckAbort(IndexBuildParallel* pbuild)
+{
+    CHECK_FOR_INTERRUPTS();
+
+    if (pbuild->aborting && pbuild->isVacuum)
+        ereport(ERROR, (errcode(ERRCODE_QUERY_CANCELED), errmsg("index vacuum canceled by its leader")));
+    if (pbuild->aborting)
+        ereport(ERROR, (errcode(ERRCODE_QUERY_CANCELED), errmsg("index build canceled by its leader")));
+}
+
+/*
+ * Sleep on pbuild->cond for at most INDEX_BUILD_WAIT_MS.
+ */
+static void IndexBuildTimedWait(IndexBuildParallel* pbuild)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_REALTIME, &ts);
+    ts.tv_nsec += INDEX_BUILD_WAIT_MS * 1000000L;
+    if (ts.tv_nsec >= 1000000000L) {
+        ts.tv_sec++;
+        ts.tv_nsec -= 1000000000L;
+    }
+    (void)pthread_cond_timedwait(&pbuild->cond, &pbuild->mutex, &ts);
+}
+
+/*
+ * Wait until every launched worker has exited.  Workers blocked outside
+ * of our own queues (a lock wait, say) are woken with a cancel request.
+ */
+static void IndexBuildParallelWaitFinished(IndexBuildParallel* pbuild)
+{
+    struct timespec ts;
+    int i;
+
+    (void)pthread_mutex_lock(&pbuild->mutex);
+    for (;;) {
+        bool alldone = true;
+
+        for (i = 0; i < pbuild->nlaunched; i++) {
+            if (!pbuild->workers[i].finished) {
+                alldone = false;
+                break;
+            }
+        }
+        if (alldone)
+            break;
+
+        (void)clock_gettime(CLOCK_REALTIME, &ts);
+        ts.tv_sec += 1;
+        if (pthread_cond_timedwait(&pbuild->cond, &pbuild->mutex, &ts) == ETIMEDOUT && pbuild->aborting) {
+            for (i = 0; i < pbuild->nlaunched; i++) {
+                if (!pbuild->workers[i].finished && pbuild->workers[i].tid != 0)
+                    (void)gs_signal_send(pbuild->workers[i].tid, SIGINT);
+            }
+        }
+    }
+    (void)pthread_mutex_unlock(&pbuild->mutex);
+}
+
+/*
+ * Free pbuild and what it owns.  Workers connect with the database and user
+ * names, so they are only freed once no worker is running any more.
+ */
+static void IndexBuildParallelFree(IndexBuildParallel* pbuild)
+{
+    if (pbuild->workers != NULL)
+        pfree(pbuild->workers);
+    pfree(pbuild->dbName);
+    pfree(pbuild->userName);
+    pfree(pbuild);
+}
+
+/*
+ * IndexBuildWorkerAttach
+ *		First thing a worker thread does, before it has a PGPROC.
+ *
+ * Arranges for the leader to hear about our exit however we leave, and
+ * returns the postmaster child slot the leader assigned us.
+ */
+int IndexBuildWorkerAttach(void* payload)
+{
+    IndexBuildWorkerSlot* slot = (IndexBuildWorkerSlot*)payload;
+
+    (void)pthread_mutex_lock(&slot->pbuild->mutex);
+    slot->tid = gs_thread_self();
+    (void)pthread_mutex_unlock(&slot->pbuild->mutex);
+
+    on_proc_exit(IndexBuildWorkerQuit, PointerGetDatum(slot));
+    return slot->childSlot;
+}
+
+/*
+ * IndexBuildWorkerMain
+ *		Main entry point for an index build worker thread.
+ */
+int IndexBuildWorkerMain(void* payload)
+{
+    IndexBuildWorkerSlot* slot = (IndexBuildWorkerSlot*)payload;
+    IndexBuildParallel* pbuild = slot->pbuild;
+    sigjmp_buf local_sigjmp_buf;
+
+    t_thrd.proc_cxt.MyProgName = "IndexBuildWorker";
+    u_sess->attr.attr_common.application_name = pstrdup("IndexBuildWorker");
+
+    (void)gspqsignal(SIGINT, StatementCancelHandler);
+    (void)gspqsignal(SIGTERM, die);
+    (void)gspqsignal(SIGALRM, handle_sig_alarm);
+    (void)gspqsignal(SIGUSR1, procsignal_sigusr1_handler);
+    (void)gs_signal_unblock_sigusr2();
+    /* We allow SIGQUIT (quickdie) at all times */
+    (void)sigdelset(&t_thrd.libpq_cxt.BlockSig, SIGQUIT);
+
+    /* Early initialization */
+    BaseInit();
+
+    gs_signal_setmask(&t_thrd.libpq_cxt.UnBlockSig, NULL);
+
+    t_thrd.proc_cxt.PostInit->SetDatabaseAndUser(pbuild->dbName, InvalidOid, pbuild->userName);
+    t_thrd.proc_cxt.PostInit->InitStreamWorker();
+
+    SetProcessingMode(NormalProcessing);
+
+    t_thrd.utils_cxt.CurrentResourceOwner = ResourceOwnerCreate(NULL, "index build worker", MEMORY_CONTEXT_STORAGE);
+
+    if (sigsetjmp(local_sigjmp_buf, 1) != 0) {
+        /* Since not using PG_TRY, must reset error stack by hand */
+        t_thrd.log_cxt.error_context_stack = NULL;
+
+        /* Prevent interrupts while cleaning up */
+        HOLD_INTERRUPTS();
+
+        /* the leader reports the error, we only hand it over */
+        IndexBuildWorkerSaveError(slot);
+
+        /* the xid is the leader's, never let our abort touch it */
+        ResetTransactionInfo();
+        AbortOutOfAnyTransaction();
+        return 0;
+    }
+
+    /* We can now handle ereport(ERROR) */
+    t_thrd.log_cxt.PG_exception_stack = &local_sigjmp_buf;
+
+    /* take our share of the heap and of the leader's sort memory */
+    u_sess->stream_cxt.smp_id = (uint32)slot->workerId;
+    u_sess->attr.attr_memory.maintenance_work_mem = pbuild->sortMem;
+    u_sess->attr.attr_memory.work_mem = pbuild->workMem;
+
+    StartTransactionCommand();
+    IndexBuildWorkerRun(slot);
+
+    ResetTransactionInfo();
+    AbortOutOfAnyTransaction();
+    return 0;
+}
+
+/*
+ * Restore the leader's transaction, open the relations, and run the
+ * access method's worker function.
+ */
+static void IndexBuildWorkerRun(IndexBuildWorkerSlot* slot)
+{
+    IndexBuildParallel* pbuild = slot->pbuild;
+    StreamTxnContext* stc = &pbuild->txnCxt;
+    Relation heapParent = NULL;
+    Relation indexParent = NULL;
+    Partition heapPart = NULL;
+    Partition indexPart = NULL;
+    Relation heap;
+    Relation index = NULL;
+    IndexInfo* indexInfo = NULL;
+    Oid save_userid;
+    int save_sec_context;
+
+    StreamRestoreTxnContext(stc);
+    StreamTxnContextSetTransactionState(stc);
+    if (stc->snapshot != NULL) {
+        Snapshot snapshot = CopySnapshotByCurrentMcxt(stc->snapshot);
+
+        SetGlobalSnapshotData(snapshot->xmin, snapshot->xmax, snapshot->snapshotcsn, snapshot->timeline, false);
+        StreamTxnContextSetSnapShot(snapshot);
+        StreamTxnContextSetMyPgXactXmin(snapshot->xmin);
+        PushActiveSnapshot(snapshot);
+    }
+
+    heap = IndexBuildWorkerOpen(pbuild->heapOid, pbuild->heapParentOid, false, &heapParent, &heapPart);
+    if (!pbuild->isVacuum)
+        index = IndexBuildWorkerOpen(pbuild->indexOid, pbuild->indexParentOid, true, &indexParent, &indexPart);
+
+    /* index_build and vacuum run the access method as the table owner */
+    GetUserIdAndSecContext(&save_userid, &save_sec_context);
+    SetUserIdAndSecContext(heap->rd_rel->relowner, save_sec_context | SECURITY_RESTRICTED_OPERATION);
+
+    if (index != NULL) {
+        indexInfo = BuildIndexInfo((indexParent != NULL) ? indexParent : index);
+        indexInfo->ii_Concurrent = pbuild->isConcurrent;
+        indexInfo->ii_ParallelWorkers = pbuild->nworkers;
+    }
+
+    slot->reltuples = pbuild->workerFunc(pbuild, slot->workerId, heap, index, indexInfo);
+    if (indexInfo != NULL)
+        slot->brokenHotChain = indexInfo->ii_BrokenHotChain;
+
+    SetUserIdAndSecContext(save_userid, save_sec_context);
+
+    if (index != NULL)
+        IndexBuildWorkerClose(index, indexParent, indexPart, true);
+    IndexBuildWorkerClose(heap, heapParent, heapPart, false);
+
+    if (stc->snapshot != NULL)
+        PopActiveSnapshot();
+}
+
+/*
+ * IndexBuildWorkerOpen
+ *		Open a relation, or a partition of parentOid, in a worker.
+ *
+ * Takes no lock: the leader holds the locks until the workers are done.
+ * *parent and *part are set for a partition, NULL otherwise, and are
+ * passed back to IndexBuildWorkerClose.
+ */
+Relation IndexBuildWorkerOpen(Oid relOid, Oid parentOid, bool isIndex, Relation* parent, Partition* part)
+{
+    *parent = NULL;
+    *part = NULL;
+
+    if (!OidIsValid(parentOid))
+        return isIndex ? index_open(relOid, NoLock) : heap_open(relOid, NoLock);
+
+    *parent = isIndex ? index_open(parentOid, NoLock) : heap_open(parentOid, NoLock);
+    *part = partitionOpen(*parent, relOid, NoLock);
+    return partitionGetRelation(*parent, *part);
+}
+
+/*
+ * IndexBuildWorkerClose
+ *		Close a relation opened by IndexBuildWorkerOpen.
+ */
+void IndexBuildWorkerClose(Relation rel, Relation parent, Partition part, bool isIndex)
+{
+    if (parent != NULL) {
+        releaseDummyRelation(&rel);
+        partitionClose(parent, part, NoLock);
+        rel = parent;
+    }
+
+    if (isIndex)
+        index_close(rel, NoLock);
+    else
+        heap_close(rel, NoLock);
+}
+
+/*
+ * Copy the pending error into our slot for the leader to re-raise.
+ */
+static void IndexBuildWorkerSaveError(IndexBuildWorkerSlot* slot)
+{
+    MemoryContext oldcontext = MemoryContextSwitchTo(t_thrd.top_mem_cxt);
+    ErrorData* edata = CopyErrorData();
+    errno_t rc;
+
+    FlushErrorState();
+    (void)MemoryContextSwitchTo(oldcontext);
+
+    slot->sqlerrcode = edata->sqlerrcode;
+    rc = strncpy_s(slot->message, INDEX_BUILD_ERRMSG_LEN,
+        (edata->message != NULL) ? edata->message : "unknown error", INDEX_BUILD_ERRMSG_LEN - 1);
+    securec_check(rc, "\0", "\0");
+    if (edata->detail != NULL) {
+        rc = strncpy_s(slot->detail, INDEX_BUILD_ERRMSG_LEN, edata->detail, INDEX_BUILD_ERRMSG_LEN - 1);
+        securec_check(rc, "\0", "\0");
+    }
+    FreeErrorData(edata);
+
+    (void)pthread_mutex_lock(&slot->pbuild->mutex);
+    slot->failed = true;
+    (void)pthread_cond_broadcast(&slot->pbuild->cond);
+    (void)pthread_mutex_unlock(&slot->pbuild->mutex);
+}
+
+/*
+ * on_proc_exit callback: give back our child slot and tell the leader we
+ * are gone.  A worker that exits before finishing its share counts as
+ * failed.  The leader may free pbuild as soon as we let go of the mutex.
+ */
+static void IndexBuildWorkerQuit(int code, Datum arg)
+{
+    IndexBuildWorkerSlot* slot = (IndexBuildWorkerSlot*)DatumGetPointer(arg);
+    IndexBuildParallel* pbuild = slot->pbuild;
+
+    if (t_thrd.shemem_ptr_cxt.PMSignalState != NULL)
+        MarkPostmasterChildUnuseForStreamWorker();
+
+    (void)pthread_mutex_lock(&pbuild->mutex);
+    if (code != 0 && !slot->failed) {
+        slot->failed = true;
+        slot->sqlerrcode = ERRCODE_INTERNAL_ERROR;
+        (void)snprintf_s(slot->message, INDEX_BUILD_ERRMSG_LEN, INDEX_BUILD_ERRMSG_LEN - 1,
+            "index build worker exited with code %d", code);
+    }
+    slot->finished = true;
+    (void)pthread_cond_broadcast(&pbuild->cond);
+    (void)pthread_mutex_unlock(&pbuild->mutex);
+}
@@ -0,0 +1,696 @@
+/* -------------------------------------------------------------------------
+ *
+ * nbtdedup.cpp
+ *	  Deduplicate items in Postgres btrees.
+ *
+ * Portions Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ *
+ * IDENTIFICATION
+ *	  src/gausskernel/storage/access/nbtree/nbtdedup.cpp
+ *
+ *	NOTES
+ *	   When an index has the deduplicate_items storage parameter set and an
+ *	   insertion finds its leaf page full, runs of adjacent items whose keys
+ *	   are byte-for-byte identical are merged into posting list tuples before
+ *	   we give up and split the page.  A posting list tuple stores the key
+ *	   once, followed by the heap TIDs of all the merged items (see the
+ *	   BTreeTupleIsPosting() comments in nbtree.h).
+ *
+ *	   Comparing the key images rather than calling the opclass keeps the
+ *	   merge safe for index-only scans: every TID of a posting list returns
+ *	   exactly the key that was inserted for it.
+ *
+ *	   Duplicates on a full page are also what bottom-up deletion looks at:
+ *	   they are mostly old versions of rows whose indexed columns were not
+ *	   changed by an UPDATE, so before splitting we check their heap tuples,
+ *	   a few heap blocks at a time, and remove the entries of dead ones.
+ *
+ * -------------------------------------------------------------------------
+ */
+#include "postgres.h"
+#include "knl/knl_variable.h"
+
+#include "access/heapam.h"
+#include "access/nbtree.h"
+#include "access/xlog.h"
+#include "access/xloginsert.h"
+#include "catalog/pg_type.h"
+#include "funcapi.h"
+#include "miscadmin.h"
+#include "storage/buf/bufmgr.h"
+#include "storage/proc.h"
+#include "utils/rel.h"
+#include "utils/rel_gs.h"
+#include "utils/snapmgr.h"
+
+/*
+ * Bottom-up deletion visits at most this many heap blocks per page, the ones
+ * with the most candidate TIDs first.
+ */
+#define BTREE_BOTTOMUP_MAX_HEAP_BLOCKS 8
+
+#define BTREE_BOTTOMUP_STAT_ATTR_NUM 4
+
+/* A heap TID referenced by a candidate leaf item */
+typedef struct BTBottomupTid {
+    ItemPointerData htid;
+    OffsetNumber offnum; /* leaf item it belongs to */
+    bool dead;           /* heap tuple is dead to everyone */
+} BTBottomupTid;
+
+/* The candidate TIDs that point to one heap block */
+typedef struct BTBottomupBlock {
+    BlockNumber blkno;
+    int first; /* index of its first TID in the sorted array */
+    int ntids;
+} BTBottomupBlock;
+
+static Size _bt_dedup_keysize(IndexTuple itup);
+static int _bt_dedup_ntids(IndexTuple itup);
+static bool _bt_dedup_equal(IndexTuple a, IndexTuple b);
+static int _bt_tid_cmp(const void *a, const void *b);
+static int _bt_bottomup_tid_cmp(const void *a, const void *b);
+static int _bt_bottomup_block_cmp(const void *a, const void *b);
+
+/*
+ * _bt_dedup_enabled() -- may insertions into rel create posting lists?
+ *
+ * Unique indexes are left alone since _bt_check_unique() reads each item's
+ * single heap TID, and so are global partitioned indexes, whose items carry
+ * the partition OID that the TID belongs to.  The feature must also wait
+ * until every node understands the posting list WAL records.
+ */
+bool _bt_dedup_enabled(Relation rel)
+{
+    if (!RelationGetDeduplicateItems(rel)) {
+        return false;
+    }
+    if (t_thrd.proc == NULL || t_thrd.proc->workingVersionNum < BTREE_DEDUP_VERSION_NUM) {
+        return false;
+    }
+    if (rel->rd_index->indisunique || RelationIsGlobalIndex(rel)) {
+        return false;
+    }
+    return true;
+}
+
+/*
+ * _bt_dedup_one_page() -- try to make room on a full leaf page
+ *
+ * Called by _bt_findinsertloc() with an exclusive lock on buf, after any
+ * LP_DEAD items have been removed, when the page still has no room for an
+ * item of newitemsz bytes.  Merges every run of adjacent items with equal
+ * keys into a posting list tuple, as far as BTMaxItemSize allows, and
+ * WAL-logs the run boundaries so that replay can redo the same merge.
+ *
+ * Returns true if the page was changed.  The caller must recompute its
+ * insert location in that case, since item offsets have moved.
+ */
+bool _bt_dedup_one_page(Relation rel, Buffer buf, Size newitemsz)
+{
+    Page page = BufferGetPage(buf);
+    BTPageOpaqueInternal opaque = (BTPageOpaqueInternal)PageGetSpecialPointer(page);
+    OffsetNumber minoff = P_FIRSTDATAKEY(opaque);
+    OffsetNumber maxoff = PageGetMaxOffsetNumber(page);
+    Size maxpostingsz = BTMaxItemSize(page);
+    BTDedupInterval intervals[MaxIndexTuplesPerPage];
+    int nintervals = 0;
+    OffsetNumber offnum;
+    Page newpage;
+
+    Assert(P_ISLEAF(opaque));
+
+    offnum = minoff;
+    while (offnum <= maxoff) {
+        ItemId itemid = PageGetItemId(page, offnum);
+        IndexTuple base;
+        Size keysz;
+        int ntids;
+        int nitems = 1;
+        OffsetNumber next = OffsetNumberNext(offnum);
+
+        /* LP_DEAD items are left for _bt_vacuum_one_page() to remove */
+        if (ItemIdIsDead(itemid)) {
+            offnum = next;
+            continue;
+        }
+
+        base = (IndexTuple)PageGetItem(page, itemid);
+        keysz = _bt_dedup_keysize(base);
+        ntids = _bt_dedup_ntids(base);
+
+        while (next <= maxoff) {
+            ItemId nextid = PageGetItemId(page, next);
+            IndexTuple itup;
+            int nexttids;
+
+            if (ItemIdIsDead(nextid)) {
+                break;
+            }
+            itup = (IndexTuple)PageGetItem(page, nextid);
+            if (!_bt_dedup_equal(base, itup)) {
+                break;
+            }
+            nexttids = _bt_dedup_ntids(itup);
+            if (MAXALIGN(keysz + (ntids + nexttids) * sizeof(ItemPointerData)) > maxpostingsz ||
+                ntids + nexttids > BT_N_KEYS_OFFSET_MASK) {
+                break;
+            }
+            ntids += nexttids;
+            nitems++;
+            next = OffsetNumberNext(next);
+        }
+
+        if (nitems > 1) {
+            intervals[nintervals].baseoff = offnum;
+            intervals[nintervals].nitems = (uint16)nitems;
+            nintervals++;
+        }
+        offnum = next;
+    }
+
+    if (nintervals == 0) {
+        return false;
+    }
+
+    /* Build the new page image before entering the critical section */
+    newpage = _bt_dedup_page(page, intervals, nintervals);
+
+    /* No ereport(ERROR) until changes are logged */
+    START_CRIT_SECTION();
+
+    PageRestoreTempPage(newpage, page);
+    MarkBufferDirty(buf);
+
+    /* XLOG stuff */
+    if (RelationNeedsWAL(rel)) {
+        XLogRecPtr recptr;
+        xl_btree_dedup xlrec;
+
+        xlrec.nintervals = (uint16)nintervals;
+
+        XLogBeginInsert();
+        XLogRegisterBuffer(0, buf, REGBUF_STANDARD);
+        XLogRegisterData((char *)&xlrec, SizeOfBtreeDedup);
+
+        /*
+         * The intervals array is not in the buffer, but pretend that it is.
+         * When XLogInsert stores the whole buffer, the array need not be
+         * stored too.
+         */
+        XLogRegisterBufData(0, (char *)intervals, nintervals * sizeof(BTDedupInterval));
+
+        recptr = XLogInsert(RM_BTREE_ID, XLOG_BTREE_DEDUP);
+
+        PageSetLSN(page, recptr);
+    }
+
+    END_CRIT_SECTION();
+
+    ereport(DEBUG2, (errmsg("merged %d runs of duplicates into posting lists in block %u of index \"%s\" "
+                            "to make room for an item of %lu bytes",
+                            nintervals, BufferGetBlockNumber(buf), RelationGetRelationName(rel),
+                            (unsigned long)newitemsz)));
+
+    return true;
+}
+
+/*
+ * _bt_dedup_page() -- build a copy of a leaf page with runs merged
+ *
+ * Returns a palloc'd page, to be installed with PageRestoreTempPage(), in
+ * which each interval's items are replaced by one posting list tuple.  All
+ * other items, including LP_DEAD ones and their dead state, are copied
+ * as-is.  Used both by _bt_dedup_one_page() and by WAL replay, so the result
+ * depends only on the page and the intervals.
+ */
+Page _bt_dedup_page(Page page, const BTDedupInterval *intervals, int nintervals)
+{
+    BTPageOpaqueInternal opaque = (BTPageOpaqueInternal)PageGetSpecialPointer(page);
+    OffsetNumber minoff = P_FIRSTDATAKEY(opaque);
+    OffsetNumber maxoff = PageGetMaxOffsetNumber(page);
+    OffsetNumber offnum;
+    OffsetNumber newoff = P_HIKEY;
+    Page newpage;
+    PageHeader phdr;
+    ItemPointer htids;
+    int curinterval = 0;
+
+    /* Keep the page header and special space, drop all items */
+    newpage = PageGetTempPageCopy(page);
+    phdr = (PageHeader)newpage;
+    phdr->pd_lower = SizeOfPageHeaderData;
+    phdr->pd_upper = phdr->pd_special;
+    PageClearHasFreeLinePointers(newpage);
+
+    htids = (ItemPointer)palloc(MaxTIDsPerBTreePage * sizeof(ItemPointerData));
+
+    /* The high key does not take part in deduplication */
+    if (!P_RIGHTMOST(opaque)) {
+        ItemId hitemid = PageGetItemId(page, P_HIKEY);
+
+        if (PageAddItem(newpage, PageGetItem(page, hitemid), ItemIdGetLength(hitemid), newoff, false, false) ==
+            InvalidOffsetNumber) {
+            ereport(ERROR, (errcode(ERRCODE_INDEX_CORRUPTED), errmsg("failed to copy high key during deduplication")));
+        }
+        newoff = OffsetNumberNext(newoff);
+    }
+
+    for (offnum = minoff; offnum <= maxoff; offnum = OffsetNumberNext(offnum)) {
+        ItemId itemid = PageGetItemId(page, offnum);
+        IndexTuple itup = (IndexTuple)PageGetItem(page, itemid);
+
+        if (curinterval < nintervals && intervals[curinterval].baseoff == offnum) {
+            int nitems = intervals[curinterval].nitems;
+            int ntids = 0;
+            int nunique = 0;
+            int i;
+            IndexTuple posting;
+
+            if (offnum + nitems - 1 > maxoff) {
+                ereport(ERROR, (errcode(ERRCODE_INDEX_CORRUPTED),
+                                errmsg("deduplication interval at offset %u exceeds the page", offnum)));
+            }
+
+            for (i = 0; i < nitems; i++) {
+                IndexTuple cur = (IndexTuple)PageGetItem(page, PageGetItemId(page, offnum + i));
+
+                if (BTreeTupleIsPosting(cur)) {
+                    int nposting = BTreeTupleGetNPosting(cur);
+                    errno_t rc = memcpy_s(htids + ntids, (MaxTIDsPerBTreePage - ntids) * sizeof(ItemPointerData),
+                                          BTreeTupleGetPosting(cur), nposting * sizeof(ItemPointerData));
+                    securec_check(rc, "", "");
+                    ntids += nposting;
+                } else {
+                    htids[ntids++] = cur->t_tid;
+                }
+            }
+
+            /* Posting lists are kept in TID order, without repeats */
+            qsort(htids, ntids, sizeof(ItemPointerData), _bt_tid_cmp);
+            for (i = 0; i < ntids; i++) {
+                if (nunique == 0 || !ItemPointerEquals(&htids[nunique - 1], &htids[i])) {
+                    htids[nunique++] = htids[i];
+                }
+            }
+
+            posting = _bt_form_posting(itup, htids, nunique);
+            if (PageAddItem(newpage, (Item)posting, IndexTupleSize(posting), newoff, false, false) ==
+                InvalidOffsetNumber) {
+                ereport(ERROR, (errcode(ERRCODE_INDEX_CORRUPTED),
+                                errmsg("failed to add posting list tuple during deduplication")));
+            }
+            pfree(posting);
+
+            offnum += nitems - 1;
+            curinterval++;
+        } else {
+            if (PageAddItem(newpage, (Item)itup, ItemIdGetLength(itemid), newoff, false, false) ==
+                InvalidOffsetNumber) {
+                ereport(ERROR, (errcode(ERRCODE_INDEX_CORRUPTED),
+                                errmsg("failed to copy item during deduplication")));
+            }
+            if (ItemIdIsDead(itemid)) {
+                ItemIdMarkDead(PageGetItemId(newpage, newoff));
+            }
+        }
+        newoff = OffsetNumberNext(newoff);
+    }
+
+    pfree(htids);
+
+    return newpage;
+}
+
+/*
+ * _bt_form_posting() -- form a leaf tuple with base's key and given TIDs
+ *
+ * base may be a plain tuple or a posting list tuple.  With a single TID the
+ * result is a plain tuple, so this also serves to strip a posting list down
+ * to its key (see _bt_posting_key()).  The result is palloc'd.
+ */
+IndexTuple _bt_form_posting(IndexTuple base, ItemPointer htids, int nhtids)
+{
+    Size keysz = _bt_dedup_keysize(base);
+    Size newsz;
+    IndexTuple itup;
+    errno_t rc;
+
+    Assert(nhtids > 0 && nhtids <= BT_N_KEYS_OFFSET_MASK);
+
+    newsz = (nhtids > 1) ? MAXALIGN(keysz + nhtids * sizeof(ItemPointerData)) : keysz;
+    itup = (IndexTuple)palloc0(newsz);
+    rc = memcpy_s(itup, newsz, base, keysz);
+    securec_check(rc, "", "");
+
+    itup->t_info &= ~(INDEX_SIZE_MASK | INDEX_ALT_TID_MASK);
+    itup->t_info |= newsz;
+
+    if (nhtids > 1) {
+        itup->t_info |= INDEX_ALT_TID_MASK;
+        ItemPointerSetBlockNumber(&itup->t_tid, (BlockNumber)keysz);
+        ItemPointerSetOffsetNumber(&itup->t_tid, (OffsetNumber)(nhtids | BT_IS_POSTING));
+        rc = memcpy_s(BTreeTupleGetPosting(itup), newsz - keysz, htids, nhtids * sizeof(ItemPointerData));
+        securec_check(rc, "", "");
+    } else {
+        itup->t_tid = htids[0];
+    }
+
+    return itup;
+}
+
+/*
+ * _bt_posting_key() -- plain copy of a leaf tuple's key
+ *
+ * Used wherever a key is needed apart from its heap TIDs, such as the high
+ * key of a split page.  The copy points at the tuple's first heap TID.
+ */
+IndexTuple _bt_posting_key(IndexTuple itup)
+{
+    return _bt_form_posting(itup, BTreeTupleGetHeapTID(itup), 1);
+}
+
+/*
+ * _bt_update_posting_page() -- replace items with smaller versions of themselves
+ *
+ * Each itups[i] replaces the item at itemnos[i], keeping its offset.  Used by
+ * _bt_update_posting() and its WAL replay.
+ */
+void _bt_update_posting_page(Page page, const OffsetNumber *itemnos, IndexTuple *itups, int nitems)
+{
+    int i;
+
+    for (i = 0; i < nitems; i++) {
+        Size itemsz = MAXALIGN(IndexTupleSize(itups[i]));
+
+        PageIndexTupleDelete(page, itemnos[i]);
+        if (PageAddItem(page, (Item)itups[i], itemsz, itemnos[i], false, false) == InvalidOffsetNumber) {
+            ereport(ERROR, (errcode(ERRCODE_INDEX_CORRUPTED),
+                            errmsg("failed to replace posting list tuple at offset %u", itemnos[i])));
+        }
+    }
+}
+
+/* Add every heap TID of a leaf item to the bottom-up deletion candidates */
+static void _bt_bottomup_add_item(BTBottomupTid *tids, int *ntids, IndexTuple itup, OffsetNumber offnum)
+{
+    int n = _bt_dedup_ntids(itup);
+
+    for (int i = 0; i < n; i++) {
+        BTBottomupTid *tid = &tids[(*ntids)++];
+
+        tid->htid = BTreeTupleIsPosting(itup) ? *BTreeTupleGetPostingN(itup, i) : itup->t_tid;
+        tid->offnum = offnum;
+        tid->dead = false;
+    }
+}
+
+/*
+ * _bt_bottomup_delete() -- remove the entries of dead duplicates from a leaf page
+ *
+ * Called by _bt_findinsertloc() with an exclusive lock on buf, after any
+ * LP_DEAD items have been removed, when the page still has no room for an
+ * item of newitemsz bytes.  Nothing is done unless the new item, described by
+ * keysz and scankey, duplicates a key already on the page: that is what a
+ * non-HOT UPDATE leaving the indexed columns alone produces, and the heap
+ * reads are not worth it otherwise.  The candidates are the heap TIDs of
+ * items that have an equal neighbour and of posting list tuples.  They are grouped by
+ * heap block, and the blocks with the most candidates are read first, until
+ * enough space is known to be freed, a block turns out to have nothing dead,
+ * or BTREE_BOTTOMUP_MAX_HEAP_BLOCKS blocks were read.  As in
+ * _bt_check_unique(), the heap is read while we hold the leaf page lock, and
+ * as for kill_prior_tuple, only heap tuples dead to everyone count.
+ *
+ * Items whose TIDs are all dead are deleted the way LP_DEAD items are.
+ * Posting lists that still have live TIDs are left alone: shrinking them in
+ * place would need a cleanup lock, which we can't wait for here.  Returns
+ * true if the page was changed.  The caller must recompute its insert
+ * location in that case, since item offsets have moved.
+ */
+bool _bt_bottomup_delete(Relation rel, Buffer buf, Relation heapRel, int keysz, ScanKey scankey, Size newitemsz)
+{
+    Page page = BufferGetPage(buf);
+    BTPageOpaqueInternal opaque = (BTPageOpaqueInternal)PageGetSpecialPointer(page);
+    OffsetNumber minoff = P_FIRSTDATAKEY(opaque);
+    OffsetNumber maxoff = PageGetMaxOffsetNumber(page);
+    Size target = Max(newitemsz, (Size)(BLCKSZ / 16));
+    Size freed = 0;
+    BTBottomupTid *tids = NULL;
+    BTBottomupTid **sorted = NULL;
+    BTBottomupBlock *blocks = NULL;
+    int ntids = 0;
+    int nblocks = 0;
+    int nvisited = 0;
+    int ndeadtids = 0;
+    int ndeletedtids = 0;
+    uint16 itemndead[MaxIndexTuplesPerPage + 1];
+    OffsetNumber deletable[MaxIndexTuplesPerPage];
+    int ndeletable = 0;
+    IndexTuple prev = NULL;
+    OffsetNumber prevoff = InvalidOffsetNumber;
+    bool prevadded = false;
+    SnapshotData SnapshotDirty;
+    OffsetNumber offnum;
+    int i;
+
+    Assert(P_ISLEAF(opaque));
+
+    /* Global partitioned index items may point into any partition */
+    if (!RelationIsValid(heapRel) || RelationIsGlobalIndex(rel)) {
+        return false;
+    }
+
+    offnum = _bt_binsrch(rel, buf, keysz, scankey, false);
+    if (offnum > maxoff || _bt_compare(rel, keysz, scankey, page, offnum) != 0) {
+        return false;
+    }
+
+    /* Collect the candidates, in page order */
+    tids = (BTBottomupTid *)palloc(MaxTIDsPerBTreePage * sizeof(BTBottomupTid));
+    for (offnum = minoff; offnum <= maxoff; offnum = OffsetNumberNext(offnum)) {
+        ItemId itemid = PageGetItemId(page, offnum);
+        IndexTuple itup;
+        bool isdup = false;
+
+        if (ItemIdIsDead(itemid)) {
+            prev = NULL;
+            continue;
+        }
+
+        itup = (IndexTuple)PageGetItem(page, itemid);
+        isdup = (prev != NULL && _bt_dedup_equal(prev, itup));
+        if (isdup && !prevadded) {
+            _bt_bottomup_add_item(tids, &ntids, prev, prevoff);
+        }
+        prevadded = (isdup || BTreeTupleIsPosting(itup));
+        if (prevadded) {
+            _bt_bottomup_add_item(tids, &ntids, itup, offnum);
+        }
+        prev = itup;
+        prevoff = offnum;
+    }
+
+    if (ntids == 0) {
+        pfree(tids);
+        return false;
+    }
+
+    /* Group them by heap block, most promising blocks first */
+    sorted = (BTBottomupTid **)palloc(ntids * sizeof(BTBottomupTid *));
+    for (i = 0; i < ntids; i++) {
+        sorted[i] = &tids[i];
+    }
+    qsort(sorted, ntids, sizeof(BTBottomupTid *), _bt_bottomup_tid_cmp);
+
+    blocks = (BTBottomupBlock *)palloc(ntids * sizeof(BTBottomupBlock));
+    for (i = 0; i < ntids; i++) {
+        BlockNumber blkno = ItemPointerGetBlockNumber(&sorted[i]->htid);
+
+        if (nblocks == 0 || blocks[nblocks - 1].blkno != blkno) {
+            blocks[nblocks].blkno = blkno;
+            blocks[nblocks].first = i;
+            blocks[nblocks].ntids = 0;
+            nblocks++;
+        }
+        blocks[nblocks - 1].ntids++;
+    }
+    qsort(blocks, nblocks, sizeof(BTBottomupBlock), _bt_bottomup_block_cmp);
+
+    errno_t rc = memset_s(itemndead, sizeof(itemndead), 0, sizeof(itemndead));
+    securec_check(rc, "\0", "\0");
+
+    InitDirtySnapshot(SnapshotDirty);
+    while (nvisited < nblocks && nvisited < BTREE_BOTTOMUP_MAX_HEAP_BLOCKS && freed < target) {
+        BTBottomupBlock *block = &blocks[nvisited++];
+        Buffer hbuf = ReadBuffer(heapRel, block->blkno);
+        int nblockdead = 0;
+
+        LockBuffer(hbuf, BUFFER_LOCK_SHARE);
+        for (i = block->first; i < block->first + block->ntids; i++) {
+            BTBottomupTid *tid = sorted[i];
+            ItemPointerData htid = tid->htid;
+            HeapTupleData heapTuple;
+            bool all_dead = false;
+
+            if (heap_hot_search_buffer(&htid, heapRel, hbuf, &SnapshotDirty, &heapTuple, NULL, &all_dead, true) ||
+                !all_dead) {
+                continue;
+            }
+
+            ItemId itemid = PageGetItemId(page, tid->offnum);
+            IndexTuple itup = (IndexTuple)PageGetItem(page, itemid);
+
+            tid->dead = true;
+            nblockdead++;
+            /* only items whose TIDs are all dead free any space */
+            if (++itemndead[tid->offnum] == _bt_dedup_ntids(itup)) {
+                freed += ItemIdGetLength(itemid) + sizeof(ItemIdData);
+            }
+        }
+        UnlockReleaseBuffer(hbuf);
+        ndeadtids += nblockdead;
+
+        /* the less promising blocks are unlikely to do better */
+        if (nblockdead == 0) {
+            break;
+        }
+    }
+
+    (void)pg_atomic_fetch_add_u64(&g_instance.stat_cxt.btBottomupPasses, 1);
+    (void)pg_atomic_fetch_add_u64(&g_instance.stat_cxt.btBottomupHeapBlocks, (uint64)nvisited);
+
+    /* Decide what to do with each candidate item */
+    i = 0;
+    while (ndeadtids > 0 && i < ntids) {
+        OffsetNumber itemoff = tids[i].offnum;
+        int first = i;
+        int ndead = 0;
+
+        for (; i < ntids && tids[i].offnum == itemoff; i++) {
+            if (tids[i].dead) {
+                ndead++;
+            }
+        }
+
+        if (ndead == i - first) {
+            deletable[ndeletable++] = itemoff;
+            ndeletedtids += ndead;
+        }
+    }
+
+    if (ndeletable > 0) {
+        _bt_delitems_delete(rel, buf, deletable, ndeletable, heapRel);
+    }
+
+    pfree(blocks);
+    pfree(sorted);
+    pfree(tids);
+
+    if (ndeletable == 0) {
+        return false;
+    }
+
+    (void)pg_atomic_fetch_add_u64(&g_instance.stat_cxt.btBottomupDeletedTids, (uint64)ndeletedtids);
+
+    ereport(DEBUG2, (errmsg("removed %d dead duplicate heap TIDs from block %u of index \"%s\" after reading %d heap "
+                            "blocks, to make room for an item of %lu bytes",
+                            ndeletedtids, BufferGetBlockNumber(buf), RelationGetRelationName(rel), nvisited,
+                            (unsigned long)newitemsz)));
+
+    return true;
+}
+
+/*
+ * gs_btree_bottomup_stat
+ *    instance-wide counters of bottom-up deletion on B-tree leaf pages
+ */
+Datum gs_btree_bottomup_stat(PG_FUNCTION_ARGS)
+{
+    TupleDesc tupdesc;
+    Datum values[BTREE_BOTTOMUP_STAT_ATTR_NUM];
+    bool nulls[BTREE_BOTTOMUP_STAT_ATTR_NUM];
+    knl_g_stat_context *stat = &g_instance.stat_cxt;
+    errno_t rc;
+
+    tupdesc = CreateTemplateTupleDesc(BTREE_BOTTOMUP_STAT_ATTR_NUM, false, TAM_HEAP);
+    TupleDescInitEntry(tupdesc, (AttrNumber)1, "passes", INT8OID, -1, 0);
+    TupleDescInitEntry(tupdesc, (AttrNumber)2, "heap_blocks", INT8OID, -1, 0);
+    TupleDescInitEntry(tupdesc, (AttrNumber)3, "deleted_tids", INT8OID, -1, 0);
+    TupleDescInitEntry(tupdesc, (AttrNumber)4, "splits_avoided", INT8OID, -1, 0);
+    tupdesc = BlessTupleDesc(tupdesc);
+
+    rc = memset_s(nulls, sizeof(nulls), 0, sizeof(nulls));
+    securec_check(rc, "\0", "\0");
+
+    values[0] = Int64GetDatum((int64)pg_atomic_read_u64(&stat->btBottomupPasses));
+    values[1] = Int64GetDatum((int64)pg_atomic_read_u64(&stat->btBottomupHeapBlocks));
+    values[2] = Int64GetDatum((int64)pg_atomic_read_u64(&stat->btBottomupDeletedTids));
+    values[3] = Int64GetDatum((int64)pg_atomic_read_u64(&stat->btBottomupSplitsAvoided));
+
+    PG_RETURN_DATUM(HeapTupleGetDatum(heap_form_tuple(tupdesc, values, nulls)));
+}
+
+/* Size of a leaf tuple's key part, MAXALIGN'd */
+static Size _bt_dedup_keysize(IndexTuple itup)
+{
+    if (BTreeTupleIsPosting(itup)) {
+        return BTreeTupleGetPostingOffset(itup);
+    }
+    return MAXALIGN(IndexTupleSize(itup));
+}
+
+/* Number of heap TIDs a leaf tuple references */
+static int _bt_dedup_ntids(IndexTuple itup)
+{
+    return BTreeTupleIsPosting(itup) ? BTreeTupleGetNPosting(itup) : 1;
+}
+
+/*
+ * Do two leaf tuples have the same key image?  The null and varwidth flags
+ * must match, as well as everything between the tuple header and the end of
+ * the key part (the null bitmap and the attribute data).
+ */
+static bool _bt_dedup_equal(IndexTuple a, IndexTuple b)
+{
+    Size keysz = _bt_dedup_keysize(a);
+    const unsigned short flagmask = INDEX_NULL_MASK | INDEX_VAR_MASK;
+
+    if (keysz != _bt_dedup_keysize(b)) {
+        return false;
+    }
+    if ((a->t_info & flagmask) != (b->t_info & flagmask)) {
+        return false;
+    }
+    return memcmp((char *)a + sizeof(IndexTupleData), (char *)b + sizeof(IndexTupleData),
+                  keysz - sizeof(IndexTupleData)) == 0;
+}
+
+static int _bt_tid_cmp(const void *a, const void *b)
+{
+    return ItemPointerCompare((ItemPointer)a, (ItemPointer)b);
+}
+
+/* Order bottom-up deletion candidates by heap TID */
+static int _bt_bottomup_tid_cmp(const void *a, const void *b)
+{
+    const BTBottomupTid *ta = *(BTBottomupTid *const *)a;
+    const BTBottomupTid *tb = *(BTBottomupTid *const *)b;
+
+    return ItemPointerCompare((ItemPointer)&ta->htid, (ItemPointer)&tb->htid);
+}
+
+/* Order heap blocks by number of candidates, most first, then by number */
+static int _bt_bottomup_block_cmp(const void *a, const void *b)
+{
+    const BTBottomupBlock *ba = (const BTBottomupBlock *)a;
+    const BTBottomupBlock *bb = (const BTBottomupBlock *)b;
+
+    if (ba->ntids != bb->ntids) {
+        return (ba->ntids > bb->ntids) ? -1 : 1;
+    }
+    if (ba->blkno != bb->blkno) {
+        return (ba->blkno < bb->blkno) ? -1 : 1;
+    }
+    return 0;
+}
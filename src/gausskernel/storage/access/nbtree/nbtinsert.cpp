@@ -484,7 +484,9 @@ next:
  *		any existing equal keys because of the way _bt_binsrch() works.
  *
  *		If there's not enough room in the space, we try to make room by
- *		removing any LP_DEAD tuples.
+ *		removing any LP_DEAD tuples, then by removing duplicates whose heap
+ *		tuples are dead (bottom-up deletion), and then, if the index allows
+ *		it, by merging duplicates into posting list tuples.
  *
  *		On entry, *buf and *offsetptr point to the first legal position
  *		where the new tuple could be inserted.	The caller should hold an
@@ -507,6 +509,8 @@ static void _bt_findinsertloc(Relation rel, Buffer *bufptr, OffsetNumber *offset
     BTPageOpaqueInternal lpageop;
     bool movedright = false;
     bool vacuumed = false;
+    bool dedup = false;
+    bool bottomup = u_sess->attr.attr_storage.enable_btree_bottomup_delete;
     OffsetNumber newitemoff;
     OffsetNumber firstlegaloff = *offsetptr;
 
@@ -549,6 +553,7 @@ static void _bt_findinsertloc(Relation rel, Buffer *bufptr, OffsetNumber *offset
      */
     movedright = false;
     vacuumed = false;
+    dedup = _bt_dedup_enabled(rel);
     while (PageGetFreeSpace(page) < itemsz) {
         Buffer rbuf;
         BlockNumber rblkno;
@@ -569,6 +574,36 @@ static void _bt_findinsertloc(Relation rel, Buffer *bufptr, OffsetNumber *offset
                 break; /* OK, now we have enough space */
         }
 
+        /*
+         * still not enough, so if the new item is a duplicate, check whether
+         * the page's duplicates point to heap tuples that are already dead to
+         * everyone, and delete them.  Try that only once per insertion, and
+         * only when enable_btree_bottomup_delete is on, since it reads heap
+         * pages while we hold the leaf lock.
+         */
+        if (bottomup && P_ISLEAF(lpageop)) {
+            bottomup = false;
+            if (_bt_bottomup_delete(rel, buf, heapRel, keysz, scankey, itemsz)) {
+                vacuumed = true;
+
+                if (PageGetFreeSpace(page) >= itemsz) {
+                    (void)pg_atomic_fetch_add_u64(&g_instance.stat_cxt.btBottomupSplitsAvoided, 1);
+                    break; /* OK, now we have enough space */
+                }
+            }
+        }
+
+        /*
+         * still not enough, so see if merging duplicates into posting lists
+         * frees enough space.  This moves tuples around too.
+         */
+        if (dedup && P_ISLEAF(lpageop) && _bt_dedup_one_page(rel, buf, itemsz)) {
+            vacuumed = true;
+
+            if (PageGetFreeSpace(page) >= itemsz)
+                break; /* OK, now we have enough space */
+        }
+
         /*
          * nope, so check conditions (b) and (c) enumerated above
          */
@@ -1003,12 +1038,17 @@ static Buffer _bt_split(Relation rel, Buffer buf, Buffer cbuf, OffsetNumber firs
      * We must truncate included attributes of the "high key" item, before
      * insert it onto the leaf page.  It's the only point in insertion
      * process, where we perform truncation.  All other functions work with
-     * this high key and do not change it.
+     * this high key and do not change it.  A posting list never becomes a
+     * high key either, only its key does.
      */
     if (indnatts != indnkeyatts && isleaf) {
         lefthikey = _bt_nonkey_truncate(rel, item);
         itemsz = IndexTupleSize(lefthikey);
         itemsz = MAXALIGN(itemsz);
+    } else if (isleaf && BTreeTupleIsPosting(item)) {
+        lefthikey = _bt_posting_key(item);
+        itemsz = IndexTupleSize(lefthikey);
+        itemsz = MAXALIGN(itemsz);
     } else {
         lefthikey = item;
     }
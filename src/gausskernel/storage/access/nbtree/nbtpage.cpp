@@ -741,6 +741,79 @@ void _bt_delitems_vacuum(const Relation rel, Buffer buf, OffsetNumber *itemnos,
     END_CRIT_SECTION();
 }
 
+/*
+ * Replace posting list tuples on a btree leaf page with smaller ones.
+ *
+ * VACUUM uses this when only some heap TIDs of a posting list are dead:
+ * itups[i] is the surviving part of the item at itemnos[i], and keeps its
+ * offset.  The caller must hold a cleanup lock, as for _bt_delitems_vacuum.
+ */
+void _bt_update_posting(const Relation rel, Buffer buf, OffsetNumber *itemnos, IndexTuple *itups, int nitems)
+{
+    Page page = BufferGetPage(buf);
+    char *updatedbuf = NULL;
+    Size updatedbuflen = 0;
+
+    /* Shouldn't be called unless there's something to do */
+    Assert(nitems > 0);
+
+    /*
+     * Flatten the offsets and new tuples into one chunk of WAL data, before
+     * entering the critical section.
+     */
+    if (RelationNeedsWAL(rel)) {
+        Size offset;
+        int i;
+
+        updatedbuflen = nitems * sizeof(OffsetNumber);
+        for (i = 0; i < nitems; i++) {
+            updatedbuflen += MAXALIGN(IndexTupleSize(itups[i]));
+        }
+        updatedbuf = (char *)palloc0(updatedbuflen);
+
+        offset = nitems * sizeof(OffsetNumber);
+        errno_t rc = memcpy_s(updatedbuf, updatedbuflen, itemnos, offset);
+        securec_check(rc, "", "");
+        for (i = 0; i < nitems; i++) {
+            Size itemsz = IndexTupleSize(itups[i]);
+
+            rc = memcpy_s(updatedbuf + offset, updatedbuflen - offset, itups[i], itemsz);
+            securec_check(rc, "", "");
+            offset += MAXALIGN(itemsz);
+        }
+    }
+
+    /* No ereport(ERROR) until changes are logged */
+    START_CRIT_SECTION();
+
+    _bt_update_posting_page(page, itemnos, itups, nitems);
+
+    MarkBufferDirty(buf);
+
+    /* XLOG stuff */
+    if (RelationNeedsWAL(rel)) {
+        XLogRecPtr recptr;
+        xl_btree_update_posting xlrec;
+
+        xlrec.nupdated = (uint16)nitems;
+
+        XLogBeginInsert();
+        XLogRegisterBuffer(0, buf, REGBUF_STANDARD);
+        XLogRegisterData((char *)&xlrec, SizeOfBtreeUpdatePosting);
+        XLogRegisterBufData(0, updatedbuf, updatedbuflen);
+
+        recptr = XLogInsert(RM_BTREE_ID, XLOG_BTREE_UPDATE_POSTING);
+
+        PageSetLSN(page, recptr);
+    }
+
+    END_CRIT_SECTION();
+
+    if (updatedbuf != NULL) {
+        pfree(updatedbuf);
+    }
+}
+
 /*
  * Delete item(s) from a btree page during single-page cleanup.
  *
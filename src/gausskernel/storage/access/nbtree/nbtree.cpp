@@ -88,6 +88,15 @@ Datum btbuild(PG_FUNCTION_ARGS)
                         errmsg("index \"%s\" already contains data", RelationGetRelationName(index))));
     }
 
+    /* hand the heap scan and the sort to worker threads if the index asks for them */
+    if (_bt_parallel_build(heap, index, indexInfo, &reltuples, &buildstate.indtuples)) {
+        result = (IndexBuildResult *)palloc(sizeof(IndexBuildResult));
+        result->heap_tuples = reltuples;
+        result->index_tuples = buildstate.indtuples;
+        result->all_part_tuples = NULL;
+        PG_RETURN_POINTER(result);
+    }
+
     // If building a unique index, put dead tuples in a second spool to keep
     // them out of the uniqueness check.
     if (indexInfo->ii_Unique) {
@@ -901,6 +910,10 @@ restart:
     } else if (P_ISLEAF(opaque)) {
         OffsetNumber deletable[MaxOffsetNumber];
         int ndeletable;
+        OffsetNumber updatable[MaxIndexTuplesPerPage];
+        IndexTuple updated[MaxIndexTuplesPerPage];
+        int nupdatable;
+        double ndeadtids;
         OffsetNumber offnum, minoff, maxoff;
 
         /*
@@ -937,6 +950,8 @@ restart:
          * callback function.
          */
         ndeletable = 0;
+        nupdatable = 0;
+        ndeadtids = 0;
         minoff = P_FIRSTDATAKEY(opaque);
         maxoff = PageGetMaxOffsetNumber(page);
         if (callback) {
@@ -973,17 +988,53 @@ restart:
                     partOid = DatumGetUInt32(index_getattr(itup, partitionOidAttr, tupdesc, &isnull));
                     Assert(!isnull);
                 }
-                if (callback(htup, callback_state, partOid)) {
+                if (BTreeTupleIsPosting(itup)) {
+                    /*
+                     * Check each heap TID of a posting list.  If only some
+                     * are dead, the tuple is replaced by one holding the rest.
+                     */
+                    int nposting = BTreeTupleGetNPosting(itup);
+                    ItemPointerData live[MaxTIDsPerBTreePage];
+                    int nlive = 0;
+
+                    for (int i = 0; i < nposting; i++) {
+                        htup = BTreeTupleGetPostingN(itup, i);
+                        if (!callback(htup, callback_state, partOid)) {
+                            live[nlive++] = *htup;
+                        }
+                    }
+                    if (nlive == 0) {
+                        deletable[ndeletable++] = offnum;
+                    } else if (nlive < nposting) {
+                        updated[nupdatable] = _bt_form_posting(itup, live, nlive);
+                        updatable[nupdatable++] = offnum;
+                    }
+                    ndeadtids += nposting - nlive;
+                } else if (callback(htup, callback_state, partOid)) {
                     deletable[ndeletable++] = offnum;
+                    ndeadtids++;
                 }
             }
         }
 
+        /*
+         * Shrink posting lists that lost some of their TIDs.  This keeps item
+         * offsets, so the deletions below are unaffected.
+         */
+        if (nupdatable > 0) {
+            _bt_update_posting(rel, buf, updatable, updated, nupdatable);
+            for (int i = 0; i < nupdatable; i++) {
+                pfree(updated[i]);
+            }
+        }
+
         /*
          * Apply any needed deletes.  We issue just one _bt_delitems_vacuum()
-         * call per page, so as to minimize WAL traffic.
+         * call per page, so as to minimize WAL traffic.  It is issued for
+         * shrunk posting lists too, since their dead TIDs need the same
+         * interlock with concurrent index scans.
          */
-        if (ndeletable > 0) {
+        if (ndeletable > 0 || nupdatable > 0) {
             /*
              * Notice that the issued XLOG_BTREE_VACUUM WAL record includes an
              * instruction to the replay code to get cleanup lock on all pages
@@ -1005,7 +1056,7 @@ restart:
                 vstate->lastBlockVacuumed = blkno;
             }
 
-            stats->tuples_removed += ndeletable;
+            stats->tuples_removed += ndeadtids;
             /* must recompute maxoff */
             maxoff = PageGetMaxOffsetNumber(page);
         } else {
@@ -1032,7 +1083,11 @@ restart:
         if (minoff > maxoff) {
             delete_now = (blkno == orig_blkno);
         } else {
-            stats->num_index_tuples += maxoff - minoff + 1;
+            for (offnum = minoff; offnum <= maxoff; offnum = OffsetNumberNext(offnum)) {
+                IndexTuple itup = (IndexTuple)PageGetItem(page, PageGetItemId(page, offnum));
+
+                stats->num_index_tuples += BTreeTupleIsPosting(itup) ? BTreeTupleGetNPosting(itup) : 1;
+            }
         }
     }
 
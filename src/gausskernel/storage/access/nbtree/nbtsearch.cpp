@@ -30,7 +30,8 @@
 #include "catalog/pg_proc.h"
 
 static bool _bt_readpage(IndexScanDesc scan, ScanDirection dir, OffsetNumber offnum);
-static void _bt_saveitem(BTScanOpaque so, int itemIndex, OffsetNumber offnum, IndexTuple itup, Oid partOid);
+static int _bt_saveitem(BTScanOpaque so, int itemIndex, OffsetNumber offnum, IndexTuple itup, Oid partOid,
+    ScanDirection dir);
 static bool _bt_steppage(IndexScanDesc scan, ScanDirection dir);
 static Buffer _bt_walk_left(Relation rel, Buffer buf);
 static bool _bt_endpoint(IndexScanDesc scan, ScanDirection dir);
@@ -927,6 +928,7 @@ bool _bt_first(IndexScanDesc scan, ScanDirection dir)
     scan->xs_ctup.t_self = currItem->heapTid;
     if (scan->xs_want_itup) {
         scan->xs_itup = (IndexTuple)(so->currTuples + currItem->tupleOffset);
+        scan->xs_itup->t_tid = currItem->heapTid;
     }
     if (scan->xs_want_ext_oid && GPIScanCheckPartOid(scan->xs_gpi_scan, currItem->partitionOid)) {
         GPISetCurrPartOid(scan->xs_gpi_scan, currItem->partitionOid);
@@ -983,8 +985,10 @@ bool _bt_next(IndexScanDesc scan, ScanDirection dir)
     /* OK, itemIndex says what to return */
     currItem = &so->currPos.items[so->currPos.itemIndex];
     scan->xs_ctup.t_self = currItem->heapTid;
-    if (scan->xs_want_itup)
+    if (scan->xs_want_itup) {
         scan->xs_itup = (IndexTuple)(so->currTuples + currItem->tupleOffset);
+        scan->xs_itup->t_tid = currItem->heapTid;
+    }
 
     if (scan->xs_want_ext_oid && GPIScanCheckPartOid(scan->xs_gpi_scan, currItem->partitionOid)) {
         GPISetCurrPartOid(scan->xs_gpi_scan, currItem->partitionOid);
@@ -1063,8 +1067,7 @@ static bool _bt_readpage(IndexScanDesc scan, ScanDirection dir, OffsetNumber off
                               : heapOid;
                 Assert(!isnull);
                 /* tuple passes all scan key conditions, so remember it */
-                _bt_saveitem(so, itemIndex, offnum, itup, partOid);
-                itemIndex++;
+                itemIndex = _bt_saveitem(so, itemIndex, offnum, itup, partOid, dir);
             }
             if (!continuescan) {
                 /* there can't be any more matches, so stop */
@@ -1075,13 +1078,13 @@ static bool _bt_readpage(IndexScanDesc scan, ScanDirection dir, OffsetNumber off
             offnum = OffsetNumberNext(offnum);
         }
 
-        Assert(itemIndex <= MaxIndexTuplesPerPage);
+        Assert(itemIndex <= MaxTIDsPerBTreePage);
         so->currPos.firstItem = 0;
         so->currPos.lastItem = itemIndex - 1;
         so->currPos.itemIndex = 0;
     } else {
         /* load items[] in descending order */
-        itemIndex = MaxIndexTuplesPerPage;
+        itemIndex = MaxTIDsPerBTreePage;
 
         offnum = Min(offnum, maxoff);
 
@@ -1094,8 +1097,7 @@ static bool _bt_readpage(IndexScanDesc scan, ScanDirection dir, OffsetNumber off
                               : heapOid;
                 Assert(!isnull);
                 /* tuple passes all scan key conditions, so remember it */
-                itemIndex--;
-                _bt_saveitem(so, itemIndex, offnum, itup, partOid);
+                itemIndex = _bt_saveitem(so, itemIndex, offnum, itup, partOid, dir);
             }
             if (!continuescan) {
                 /* there can't be any more matches, so stop */
@@ -1108,29 +1110,62 @@ static bool _bt_readpage(IndexScanDesc scan, ScanDirection dir, OffsetNumber off
 
         Assert(itemIndex >= 0);
         so->currPos.firstItem = itemIndex;
-        so->currPos.lastItem = MaxIndexTuplesPerPage - 1;
-        so->currPos.itemIndex = MaxIndexTuplesPerPage - 1;
+        so->currPos.lastItem = MaxTIDsPerBTreePage - 1;
+        so->currPos.itemIndex = MaxTIDsPerBTreePage - 1;
     }
 
     return (so->currPos.firstItem <= so->currPos.lastItem);
 }
 
-/* Save an index item into so->currPos.items[itemIndex] */
-static void _bt_saveitem(BTScanOpaque so, int itemIndex, OffsetNumber offnum, const IndexTuple itup, Oid partOid)
+/*
+ * Save an index item into so->currPos.items, one entry per heap TID, and
+ * return the next itemIndex.  A forward scan fills upwards from itemIndex, a
+ * backward scan downwards from itemIndex - 1, so that items[] stays in index
+ * order (a posting list's TIDs in ascending order) either way.
+ *
+ * For index-only scans the workspace gets a single plain copy of the key,
+ * shared by all TIDs of a posting list; the caller sets its t_tid to the
+ * TID being returned.
+ */
+static int _bt_saveitem(BTScanOpaque so, int itemIndex, OffsetNumber offnum, const IndexTuple itup, Oid partOid,
+                        ScanDirection dir)
 {
-    BTScanPosItem *currItem = &so->currPos.items[itemIndex];
+    bool isposting = BTreeTupleIsPosting(itup);
+    int ntids = isposting ? BTreeTupleGetNPosting(itup) : 1;
+    ItemPointer htids = isposting ? BTreeTupleGetPosting(itup) : &itup->t_tid;
+    LocationIndex tupleOffset = 0;
+    int i;
 
-    currItem->heapTid = itup->t_tid;
-    currItem->indexOffset = offnum;
-    currItem->partitionOid = partOid;
     if (so->currTuples) {
-        Size itupsz = IndexTupleSize(itup);
+        Size itupsz = isposting ? BTreeTupleGetPostingOffset(itup) : IndexTupleSize(itup);
+        IndexTuple copy = (IndexTuple)(so->currTuples + so->currPos.nextTupleOffset);
 
-        currItem->tupleOffset = (uint16)so->currPos.nextTupleOffset;
-        errno_t rc = memcpy_s(so->currTuples + so->currPos.nextTupleOffset, itupsz, itup, itupsz);
+        tupleOffset = (LocationIndex)so->currPos.nextTupleOffset;
+        errno_t rc = memcpy_s(copy, itupsz, itup, itupsz);
         securec_check(rc, "", "");
+        if (isposting) {
+            copy->t_info &= ~(INDEX_SIZE_MASK | INDEX_ALT_TID_MASK);
+            copy->t_info |= itupsz;
+            copy->t_tid = htids[0];
+        }
         so->currPos.nextTupleOffset += MAXALIGN(itupsz);
     }
+
+    for (i = 0; i < ntids; i++) {
+        BTScanPosItem *currItem = NULL;
+
+        if (ScanDirectionIsForward(dir)) {
+            currItem = &so->currPos.items[itemIndex++];
+        } else {
+            currItem = &so->currPos.items[--itemIndex];
+        }
+        currItem->heapTid = ScanDirectionIsForward(dir) ? htids[i] : htids[ntids - 1 - i];
+        currItem->indexOffset = offnum;
+        currItem->tupleOffset = tupleOffset;
+        currItem->partitionOid = partOid;
+    }
+
+    return itemIndex;
 }
 
 /*
@@ -1529,8 +1564,10 @@ static bool _bt_endpoint(IndexScanDesc scan, ScanDirection dir)
     /* OK, itemIndex says what to return */
     currItem = &so->currPos.items[so->currPos.itemIndex];
     scan->xs_ctup.t_self = currItem->heapTid;
-    if (scan->xs_want_itup)
+    if (scan->xs_want_itup) {
         scan->xs_itup = (IndexTuple)(so->currTuples + currItem->tupleOffset);
+        scan->xs_itup->t_tid = currItem->heapTid;
+    }
 
     if (scan->xs_want_ext_oid && GPIScanCheckPartOid(scan->xs_gpi_scan, currItem->partitionOid)) {
         GPISetCurrPartOid(scan->xs_gpi_scan, currItem->partitionOid);
@@ -1585,8 +1622,8 @@ bool _bt_gettuple_internal(IndexScanDesc scan, ScanDirection dir)
                  * just forget any excess entries.
                  */
                 if (so->killedItems == NULL)
-                    so->killedItems = (int *)palloc(MaxIndexTuplesPerPage * sizeof(int));
-                if (so->numKilled < MaxIndexTuplesPerPage)
+                    so->killedItems = (int *)palloc(MaxTIDsPerBTreePage * sizeof(int));
+                if (so->numKilled < MaxTIDsPerBTreePage)
                     so->killedItems[so->numKilled++] = so->currPos.itemIndex;
             }
 
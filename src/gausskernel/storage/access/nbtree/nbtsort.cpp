@@ -67,7 +67,10 @@
 #include "postgres.h"
 #include "knl/knl_variable.h"
 
+#include "access/genam.h"
 #include "access/nbtree.h"
+#include "access/parallelbuild.h"
+#include "access/tableam.h"
 #include "access/xlog.h"
 #include "access/xloginsert.h"
 #include "miscadmin.h"
@@ -913,3 +916,450 @@ List *insert_ordered_index(List *list, TupleDesc tupdes, ScanKey indexScanKey, i
     lappend_cell(list, prev, ele);
     return list;
 }
+
+/*
+ * Parallel build.
+ *
+ * Each worker scans its stripes of the heap into its own spools, sorts
+ * them and streams the sorted tuples to the leader through a ring buffer
+ * in the leader's memory.  The leader merges the worker streams and loads
+ * the leaves exactly as _bt_load does.  Uniqueness among the tuples of one
+ * worker is checked by its tuplesort; the leader checks neighbours that
+ * came from different workers.
+ *
+ * A queue item is a BTBuildQueueItem header followed by the tuple, both
+ * MAXALIGN'd.  An item never wraps around the end of the buffer: the
+ * worker writes a header with len 0 and continues at the start instead.
+ * head and tail only grow; their difference is the buffer space in use.
+ */
+#define BTBUILD_QUEUE_SIZE (1024 * 1024)
+#define BTBUILD_QUEUE_BATCH (BTBUILD_QUEUE_SIZE / 8)
+#define BTBUILD_ITEM_HDRSZ MAXALIGN(sizeof(BTBuildQueueItem))
+
+typedef struct BTBuildQueue {
+    char *buf;
+    uint64 head; /* bytes the leader is done with, under pbuild->mutex */
+    uint64 tail; /* bytes the worker has published, under pbuild->mutex */
+    bool done;   /* worker published its last tuple */
+} BTBuildQueue;
+
+typedef struct BTBuildQueueItem {
+    uint32 len; /* tuple length, 0 if the next item is at the buffer start */
+    bool isdead;
+} BTBuildQueueItem;
+
+/* Worker side of a queue */
+typedef struct BTQueueWriter {
+    IndexBuildParallel *pbuild;
+    BTBuildQueue *queue;
+    uint64 writepos;  /* end of what we have written */
+    uint64 published; /* what the leader may read */
+    uint64 head;      /* the leader's head when we last looked */
+} BTQueueWriter;
+
+/* Leader side of a queue */
+typedef struct BTQueueReader {
+    BTBuildQueue *queue;
+    uint64 readpos; /* start of the current item */
+    uint64 tail;    /* the worker's tail when we last looked */
+    IndexTuple itup; /* current item, NULL once the queue is drained */
+    bool isdead;
+} BTQueueReader;
+
+/* Worker state for the heap scan callback */
+typedef struct BTParallelScanState {
+    BTBuildState build;
+    IndexBuildParallel *pbuild;
+} BTParallelScanState;
+
+static void _bt_parallel_callback(Relation index, HeapTuple htup, Datum *values, const bool *isnull,
+                                  bool tupleIsAlive, void *state);
+static double _bt_parallel_scan(IndexBuildParallel *pbuild, int workerId, Relation heap, Relation index,
+                                IndexInfo *indexInfo);
+static double _bt_parallel_load(IndexBuildParallel *pbuild, Relation index, bool isunique);
+static void _bt_queue_put(BTQueueWriter *writer, IndexTuple itup, bool isdead);
+static void _bt_queue_publish(BTQueueWriter *writer, bool done);
+static void _bt_queue_next(IndexBuildParallel *pbuild, BTQueueReader *readers, int nreaders, BTQueueReader *reader);
+static bool _bt_parallel_isdup(TupleDesc tupdes, ScanKey indexScanKey, int keysz, IndexTuple itup,
+                               IndexTuple itup2);
+
+/*
+ * _bt_parallel_build() -- build the index with worker threads.
+ *
+ * Returns false, having done nothing, if the index should or could not be
+ * built in parallel; the caller then runs the serial build.
+ */
+bool _bt_parallel_build(Relation heap, Relation index, IndexInfo *indexInfo, double *heapTuples,
+                        double *indexTuples)
+{
+    int nworkers = IndexBuildParallelDegree(heap, index, indexInfo);
+    IndexBuildParallel *pbuild = NULL;
+    BTBuildQueue *queues = NULL;
+    int i;
+
+    if (nworkers < 2)
+        return false;
+
+    queues = (BTBuildQueue *)palloc0(nworkers * sizeof(BTBuildQueue));
+    for (i = 0; i < nworkers; i++)
+        queues[i].buf = (char *)palloc(BTBUILD_QUEUE_SIZE);
+
+    pbuild = IndexBuildParallelBegin(heap, index, indexInfo, nworkers, _bt_parallel_scan, queues);
+    if (pbuild == NULL) {
+        for (i = 0; i < nworkers; i++)
+            pfree(queues[i].buf);
+        pfree(queues);
+        return false;
+    }
+
+    /* the workers write into our memory, so never leave before they are gone */
+    PG_TRY();
+    {
+        *indexTuples = _bt_parallel_load(pbuild, index, indexInfo->ii_Unique);
+        *heapTuples = IndexBuildParallelEnd(pbuild, indexInfo);
+    }
+    PG_CATCH();
+    {
+        IndexBuildParallelAbort(pbuild);
+        PG_RE_THROW();
+    }
+    PG_END_TRY();
+
+    for (i = 0; i < nworkers; i++)
+        pfree(queues[i].buf);
+    pfree(queues);
+
+    return true;
+}
+
+/*
+ * Per-tuple callback from IndexBuildHeapScan in a worker
+ */
+static void _bt_parallel_callback(Relation index, HeapTuple htup, Datum *values, const bool *isnull,
+                                  bool tupleIsAlive, void *state)
+{
+    BTParallelScanState *scanstate = (BTParallelScanState *)state;
+    BTBuildState *buildstate = &scanstate->build;
+
+    IndexBuildWorkerCheckAbort(scanstate->pbuild);
+
+    if (tupleIsAlive || buildstate->spool2 == NULL) {
+        _bt_spool(buildstate->spool, &htup->t_self, values, isnull);
+    } else {
+        /* dead tuples are put into spool2 */
+        buildstate->haveDead = true;
+        _bt_spool(buildstate->spool2, &htup->t_self, values, isnull);
+    }
+
+    buildstate->indtuples += 1;
+}
+
+/*
+ * Worker function: scan our stripes of the heap, sort them, and stream
+ * the sorted tuples to the leader.
+ */
+static double _bt_parallel_scan(IndexBuildParallel *pbuild, int workerId, Relation heap, Relation index,
+                                IndexInfo *indexInfo)
+{
+    BTParallelScanState scanstate;
+    BTBuildState *buildstate = &scanstate.build;
+    BTQueueWriter writer;
+    UtilityDesc desc;
+    IndexTuple itup = NULL;
+    IndexTuple itup2 = NULL;
+    bool should_free = false;
+    bool should_free2 = false;
+    double reltuples;
+    errno_t rc;
+
+    /* maintenance_work_mem is already our share of the leader's */
+    rc = memset_s(&desc, sizeof(desc), 0, sizeof(desc));
+    securec_check(rc, "\0", "\0");
+
+    buildstate->isUnique = indexInfo->ii_Unique;
+    buildstate->haveDead = false;
+    buildstate->heapRel = heap;
+    buildstate->spool = NULL;
+    buildstate->spool2 = NULL;
+    buildstate->indtuples = 0;
+    scanstate.pbuild = pbuild;
+
+    if (indexInfo->ii_Unique)
+        buildstate->spool2 = _bt_spoolinit(index, false, true, &desc);
+    buildstate->spool = _bt_spoolinit(index, indexInfo->ii_Unique, false, &desc);
+
+    reltuples = tableam_index_build_scan(heap, index, indexInfo, false, _bt_parallel_callback, (void *)&scanstate);
+
+    tuplesort_performsort(buildstate->spool->sortstate);
+    if (buildstate->haveDead)
+        tuplesort_performsort(buildstate->spool2->sortstate);
+
+    writer.pbuild = pbuild;
+    writer.queue = &((BTBuildQueue *)pbuild->amstate)[workerId];
+    writer.writepos = 0;
+    writer.published = 0;
+    writer.head = 0;
+
+    if (buildstate->haveDead) {
+        /* merge the two spools the way _bt_load does */
+        TupleDesc tupdes = RelationGetDescr(index);
+        int keysz = IndexRelationGetNumberOfKeyAttributes(index);
+        ScanKey indexScanKey = _bt_mkscankey_nodata(index);
+
+        itup = tuplesort_getindextuple(buildstate->spool->sortstate, true, &should_free);
+        itup2 = tuplesort_getindextuple(buildstate->spool2->sortstate, true, &should_free2);
+        while (itup != NULL || itup2 != NULL) {
+            if (_index_tuple_compare(tupdes, indexScanKey, keysz, itup, itup2)) {
+                _bt_queue_put(&writer, itup, false);
+                if (should_free)
+                    pfree(itup);
+                itup = tuplesort_getindextuple(buildstate->spool->sortstate, true, &should_free);
+            } else {
+                _bt_queue_put(&writer, itup2, true);
+                if (should_free2)
+                    pfree(itup2);
+                itup2 = tuplesort_getindextuple(buildstate->spool2->sortstate, true, &should_free2);
+            }
+        }
+        _bt_freeskey(indexScanKey);
+    } else {
+        while ((itup = tuplesort_getindextuple(buildstate->spool->sortstate, true, &should_free)) != NULL) {
+            _bt_queue_put(&writer, itup, false);
+            if (should_free)
+                pfree(itup);
+        }
+    }
+    _bt_queue_publish(&writer, true);
+
+    _bt_spooldestroy(buildstate->spool);
+    if (buildstate->spool2 != NULL)
+        _bt_spooldestroy(buildstate->spool2);
+
+    return reltuples;
+}
+
+/*
+ * Leader: merge the worker streams into btree leaves, then build the
+ * upper levels.  Returns the number of index tuples loaded.
+ */
+static double _bt_parallel_load(IndexBuildParallel *pbuild, Relation index, bool isunique)
+{
+    BTBuildQueue *queues = (BTBuildQueue *)pbuild->amstate;
+    int nreaders = pbuild->nworkers;
+    BTQueueReader *readers = (BTQueueReader *)palloc0(nreaders * sizeof(BTQueueReader));
+    BTWriteState wstate;
+    BTPageState *state = NULL;
+    TupleDesc tupdes = RelationGetDescr(index);
+    int keysz = IndexRelationGetNumberOfKeyAttributes(index);
+    ScanKey indexScanKey = _bt_mkscankey_nodata(index);
+    IndexTuple lastAlive = NULL;
+    double indtuples = 0;
+    int i;
+
+    wstate.index = index;
+    wstate.btws_use_wal = XLogIsNeeded() && RelationNeedsWAL(wstate.index);
+    /* reserve the metapage */
+    wstate.btws_pages_alloced = BTREE_METAPAGE + 1;
+    wstate.btws_pages_written = 0;
+    wstate.btws_zeropage = NULL; /* until needed */
+
+    for (i = 0; i < nreaders; i++) {
+        readers[i].queue = &queues[i];
+        _bt_queue_next(pbuild, readers, nreaders, &readers[i]);
+    }
+
+    for (;;) {
+        BTQueueReader *next = NULL;
+
+        for (i = 0; i < nreaders; i++) {
+            if (readers[i].itup == NULL)
+                continue;
+            if (next == NULL || !_index_tuple_compare(tupdes, indexScanKey, keysz, next->itup, readers[i].itup))
+                next = &readers[i];
+        }
+        if (next == NULL)
+            break;
+
+        if (isunique && !next->isdead) {
+            if (lastAlive != NULL && _bt_parallel_isdup(tupdes, indexScanKey, keysz, lastAlive, next->itup)) {
+                Datum values[INDEX_MAX_KEYS];
+                bool isnull[INDEX_MAX_KEYS];
+                char *key_desc = NULL;
+
+                index_deform_tuple(next->itup, tupdes, values, isnull);
+                key_desc = BuildIndexValueDescription(index, values, isnull);
+                ereport(ERROR,
+                    (errcode(ERRCODE_UNIQUE_VIOLATION),
+                        errmsg("could not create unique index \"%s\"", RelationGetRelationName(index)),
+                        key_desc ? errdetail("Key %s is duplicated.", key_desc) : errdetail("Duplicate keys exist.")));
+            }
+            if (lastAlive != NULL)
+                pfree(lastAlive);
+            lastAlive = CopyIndexTuple(next->itup);
+        }
+
+        /* When we see first tuple, create first index page */
+        if (state == NULL)
+            state = _bt_pagestate(&wstate, 0);
+
+        _bt_buildadd(&wstate, state, next->itup);
+        indtuples += 1;
+
+        _bt_queue_next(pbuild, readers, nreaders, next);
+    }
+
+    if (lastAlive != NULL)
+        pfree(lastAlive);
+    _bt_freeskey(indexScanKey);
+    pfree(readers);
+
+    /* Close down final pages and write the metapage */
+    _bt_uppershutdown(&wstate, state);
+
+    /* fsync the index for the reasons given in _bt_load */
+    if (RelationNeedsWAL(wstate.index)) {
+        RelationOpenSmgr(wstate.index);
+        smgrimmedsync(wstate.index->rd_smgr, MAIN_FORKNUM);
+    }
+
+    return indtuples;
+}
+
+/*
+ * Worker: append a tuple to our queue, waiting for the leader to make
+ * room if need be.
+ */
+static void _bt_queue_put(BTQueueWriter *writer, IndexTuple itup, bool isdead)
+{
+    IndexBuildParallel *pbuild = writer->pbuild;
+    BTBuildQueue *queue = writer->queue;
+    Size tuplen = IndexTupleSize(itup);
+    Size itemsz = BTBUILD_ITEM_HDRSZ + MAXALIGN(tuplen);
+    Size offset = writer->writepos % BTBUILD_QUEUE_SIZE;
+    Size skip = (BTBUILD_QUEUE_SIZE - offset < itemsz) ? BTBUILD_QUEUE_SIZE - offset : 0;
+    BTBuildQueueItem *item = NULL;
+    errno_t rc;
+
+    if (writer->writepos + skip + itemsz - writer->head > BTBUILD_QUEUE_SIZE) {
+        /* hand over what we have before we sleep, the leader may be waiting for it */
+        (void)pthread_mutex_lock(&pbuild->mutex);
+        queue->tail = writer->writepos;
+        writer->published = writer->writepos;
+        (void)pthread_cond_broadcast(&pbuild->cond);
+        while (writer->writepos + skip + itemsz - queue->head > BTBUILD_QUEUE_SIZE)
+            IndexBuildWorkerWait(pbuild);
+        writer->head = queue->head;
+        (void)pthread_mutex_unlock(&pbuild->mutex);
+    }
+
+    if (skip > 0) {
+        ((BTBuildQueueItem *)(queue->buf + offset))->len = 0;
+        writer->writepos += skip;
+        offset = 0;
+    }
+
+    item = (BTBuildQueueItem *)(queue->buf + offset);
+    item->len = (uint32)tuplen;
+    item->isdead = isdead;
+    rc = memcpy_s(queue->buf + offset + BTBUILD_ITEM_HDRSZ, BTBUILD_QUEUE_SIZE - offset - BTBUILD_ITEM_HDRSZ, itup,
+                  tuplen);
+    securec_check(rc, "\0", "\0");
+    writer->writepos += itemsz;
+
+    if (writer->writepos - writer->published >= BTBUILD_QUEUE_BATCH)
+        _bt_queue_publish(writer, false);
+}
+
+/*
+ * Worker: let the leader read everything written so far.
+ */
+static void _bt_queue_publish(BTQueueWriter *writer, bool done)
+{
+    IndexBuildParallel *pbuild = writer->pbuild;
+
+    (void)pthread_mutex_lock(&pbuild->mutex);
+    writer->queue->tail = writer->writepos;
+    if (done)
+        writer->queue->done = true;
+    writer->head = writer->queue->head;
+    (void)pthread_cond_broadcast(&pbuild->cond);
+    (void)pthread_mutex_unlock(&pbuild->mutex);
+
+    writer->published = writer->writepos;
+}
+
+/*
+ * Leader: step to the next item of a queue, waiting for its worker if
+ * need be.  Leaves reader->itup NULL once the worker is done.
+ *
+ * The current item of every queue stays where it is until we step past
+ * it; everything before it is given back to the workers whenever we have
+ * to look at the shared positions anyway.
+ */
+static void _bt_queue_next(IndexBuildParallel *pbuild, BTQueueReader *readers, int nreaders, BTQueueReader *reader)
+{
+    BTBuildQueue *queue = reader->queue;
+    int i;
+
+    if (reader->itup != NULL) {
+        reader->readpos += BTBUILD_ITEM_HDRSZ + MAXALIGN(IndexTupleSize(reader->itup));
+        reader->itup = NULL;
+    }
+
+    for (;;) {
+        BTBuildQueueItem *item = NULL;
+        Size offset;
+
+        if (reader->readpos == reader->tail) {
+            bool done = false;
+
+            (void)pthread_mutex_lock(&pbuild->mutex);
+            for (i = 0; i < nreaders; i++)
+                readers[i].queue->head = readers[i].readpos;
+            (void)pthread_cond_broadcast(&pbuild->cond);
+            while (queue->tail == reader->readpos && !queue->done)
+                IndexBuildParallelWait(pbuild);
+            reader->tail = queue->tail;
+            done = queue->done;
+            (void)pthread_mutex_unlock(&pbuild->mutex);
+
+            if (reader->readpos == reader->tail) {
+                Assert(done);
+                return;
+            }
+        }
+
+        offset = reader->readpos % BTBUILD_QUEUE_SIZE;
+        item = (BTBuildQueueItem *)(queue->buf + offset);
+        if (item->len == 0) {
+            /* the worker continued at the buffer start */
+            reader->readpos += BTBUILD_QUEUE_SIZE - offset;
+            continue;
+        }
+
+        reader->itup = (IndexTuple)(queue->buf + offset + BTBUILD_ITEM_HDRSZ);
+        reader->isdead = item->isdead;
+        return;
+    }
+}
+
+/*
+ * Do two tuples have equal keys that violate uniqueness?  Like tuplesort,
+ * we never treat keys containing a NULL as equal.
+ */
+static bool _bt_parallel_isdup(TupleDesc tupdes, ScanKey indexScanKey, int keysz, IndexTuple itup,
+                               IndexTuple itup2)
+{
+    int i;
+
+    for (i = 1; i <= keysz; i++) {
+        bool isnull = false;
+
+        (void)index_getattr(itup, i, tupdes, &isnull);
+        if (isnull)
+            return false;
+    }
+
+    return _index_tuple_compare(tupdes, indexScanKey, keysz, itup, itup2) &&
+           _index_tuple_compare(tupdes, indexScanKey, keysz, itup2, itup);
+}
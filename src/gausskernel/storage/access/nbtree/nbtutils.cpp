@@ -40,6 +40,8 @@ static bool _bt_fix_scankey_strategy(ScanKey skey, const int16 *indoption);
 static void _bt_mark_scankey_required(ScanKey skey);
 static bool _bt_check_rowcompare(ScanKey skey, IndexTuple tuple, TupleDesc tupdesc, ScanDirection dir,
                                  bool *continuescan);
+static bool _bt_posting_contains(IndexTuple itup, ItemPointer htid);
+static bool _bt_posting_killed(BTScanOpaque so, IndexTuple itup, OffsetNumber indexOffset);
 
 /*
  * _bt_mkscankey
@@ -1536,6 +1538,57 @@ static bool _bt_check_rowcompare(ScanKey skey, IndexTuple tuple, TupleDesc tupde
     return result;
 }
 
+/* Does posting list tuple itup reference heap TID htid? */
+static bool _bt_posting_contains(IndexTuple itup, ItemPointer htid)
+{
+    ItemPointer posting = BTreeTupleGetPosting(itup);
+    int low = 0;
+    int high = BTreeTupleGetNPosting(itup) - 1;
+
+    while (low <= high) {
+        int mid = low + (high - low) / 2;
+        int32 cmp = ItemPointerCompare(&posting[mid], htid);
+
+        if (cmp == 0) {
+            return true;
+        } else if (cmp < 0) {
+            low = mid + 1;
+        } else {
+            high = mid - 1;
+        }
+    }
+    return false;
+}
+
+/*
+ * Has the scan killed every heap TID of posting list tuple itup?  The scan
+ * saved all of them from the item at indexOffset.
+ */
+static bool _bt_posting_killed(BTScanOpaque so, IndexTuple itup, OffsetNumber indexOffset)
+{
+    int nposting = BTreeTupleGetNPosting(itup);
+    int i;
+    int j;
+
+    for (i = 0; i < nposting; i++) {
+        ItemPointer htid = BTreeTupleGetPostingN(itup, i);
+        bool found = false;
+
+        for (j = 0; j < so->numKilled; j++) {
+            BTScanPosItem *kitem = &so->currPos.items[so->killedItems[j]];
+
+            if (kitem->indexOffset == indexOffset && ItemPointerEquals(&kitem->heapTid, htid)) {
+                found = true;
+                break;
+            }
+        }
+        if (!found) {
+            return false;
+        }
+    }
+    return true;
+}
+
 /*
  * _bt_killitems - set LP_DEAD state for items an indexscan caller has
  * told us were killed
@@ -1558,6 +1611,10 @@ static bool _bt_check_rowcompare(ScanKey skey, IndexTuple tuple, TupleDesc tupde
  * (This observation also guarantees that the item is still the right one
  * to delete, which might otherwise be questionable since heap TIDs can get
  * recycled.)
+ *
+ * A posting list tuple is only marked when every one of its heap TIDs has
+ * been killed.  Deduplication can move items left, or merge in TIDs the scan
+ * never saw; we then just fail to find or to kill the item.
  */
 void _bt_killitems(IndexScanDesc scan, bool haveLock)
 {
@@ -1603,7 +1660,16 @@ void _bt_killitems(IndexScanDesc scan, bool haveLock)
                                   ? DatumGetUInt32(index_getattr(ituple, partitionOidAttr, tupdesc, &isNull))
                                   : heapOid;
             Assert(!isNull);
-            if (ItemPointerEquals(&ituple->t_tid, &kitem->heapTid) && currPartOid == partOid) {
+            if (BTreeTupleIsPosting(ituple)) {
+                if (currPartOid == partOid && _bt_posting_contains(ituple, &kitem->heapTid)) {
+                    /* found the item, but the rest of its TIDs must be dead too */
+                    if (_bt_posting_killed(so, ituple, kitem->indexOffset)) {
+                        ItemIdMarkDead(iid);
+                        killedsomething = true;
+                    }
+                    break; /* out of inner search loop */
+                }
+            } else if (ItemPointerEquals(&ituple->t_tid, &kitem->heapTid) && currPartOid == partOid) {
                 /* found the item */
                 ItemIdMarkDead(iid);
                 killedsomething = true;
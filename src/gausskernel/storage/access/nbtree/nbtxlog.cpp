@@ -630,6 +630,43 @@ static void btree_xlog_delete(XLogReaderState *record)
     }
 }
 
+static void btree_xlog_dedup(XLogReaderState *record)
+{
+    RedoBufferInfo buffer;
+
+    if (XLogReadBufferForRedo(record, BTREE_DEDUP_ORIG_BLOCK_NUM, &buffer) == BLK_NEEDS_REDO) {
+        Size len;
+        char *ptr = XLogRecGetBlockData(record, BTREE_DEDUP_ORIG_BLOCK_NUM, &len);
+
+        BtreeXlogDedupOperatorPage(&buffer, (void *)XLogRecGetData(record), (void *)ptr, len);
+        MarkBufferDirty(buffer.buf);
+    }
+    if (BufferIsValid(buffer.buf)) {
+        UnlockReleaseBuffer(buffer.buf);
+    }
+}
+
+static void btree_xlog_update_posting(XLogReaderState *record)
+{
+    RedoBufferInfo buffer;
+
+    /*
+     * Like btree_xlog_vacuum(), take a cleanup lock: the record removes heap
+     * TIDs that a scan pinning the page could still be about to visit.
+     */
+    if (XLogReadBufferForRedoExtended(record, BTREE_UPDATE_POSTING_ORIG_BLOCK_NUM, RBM_NORMAL, true, &buffer) ==
+        BLK_NEEDS_REDO) {
+        Size len;
+        char *ptr = XLogRecGetBlockData(record, BTREE_UPDATE_POSTING_ORIG_BLOCK_NUM, &len);
+
+        BtreeXlogUpdatePostingOperatorPage(&buffer, (void *)XLogRecGetData(record), (void *)ptr, len);
+        MarkBufferDirty(buffer.buf);
+    }
+    if (BufferIsValid(buffer.buf)) {
+        UnlockReleaseBuffer(buffer.buf);
+    }
+}
+
 static void btree_xlog_delete_page(uint8 info, XLogReaderState *record)
 {
     XLogRecPtr lsn = record->EndRecPtr;
@@ -1024,6 +1061,12 @@ void btree_redo(XLogReaderState *record)
         case XLOG_BTREE_REUSE_PAGE:
             btree_xlog_reuse_page(record);
             break;
+        case XLOG_BTREE_DEDUP:
+            btree_xlog_dedup(record);
+            break;
+        case XLOG_BTREE_UPDATE_POSTING:
+            btree_xlog_update_posting(record);
+            break;
         default:
             ereport(PANIC, (errmsg("btree_redo: unknown op code %hhu", info)));
     }
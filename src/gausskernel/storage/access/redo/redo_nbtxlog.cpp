@@ -295,6 +295,48 @@ void BtreeXlogVacuumOperatorPage(RedoBufferInfo *redobuffer, void *recorddata, v
     }
 }
 
+void BtreeXlogDedupOperatorPage(RedoBufferInfo *redobuffer, void *recorddata, void *blkdata, Size len)
+{
+    xl_btree_dedup *xlrec = (xl_btree_dedup *)recorddata;
+    Page page = redobuffer->pageinfo.page;
+    Page newpage;
+
+    Assert(len == xlrec->nintervals * sizeof(BTDedupInterval));
+
+    newpage = _bt_dedup_page(page, (BTDedupInterval *)blkdata, xlrec->nintervals);
+    PageRestoreTempPage(newpage, page);
+
+    PageSetLSN(page, redobuffer->lsn);
+    if (module_logging_is_on(MOD_REDO)) {
+        DumpPageInfo(page, redobuffer->lsn);
+    }
+}
+
+void BtreeXlogUpdatePostingOperatorPage(RedoBufferInfo *redobuffer, void *recorddata, void *blkdata, Size len)
+{
+    xl_btree_update_posting *xlrec = (xl_btree_update_posting *)recorddata;
+    Page page = redobuffer->pageinfo.page;
+    OffsetNumber *itemnos = (OffsetNumber *)blkdata;
+    IndexTuple *itups = NULL;
+    char *ptr = (char *)blkdata + xlrec->nupdated * sizeof(OffsetNumber);
+    int i;
+
+    itups = (IndexTuple *)palloc(xlrec->nupdated * sizeof(IndexTuple));
+    for (i = 0; i < xlrec->nupdated; i++) {
+        itups[i] = (IndexTuple)ptr;
+        ptr += MAXALIGN(IndexTupleSize(itups[i]));
+    }
+    Assert(ptr == (char *)blkdata + len);
+
+    _bt_update_posting_page(page, itemnos, itups, xlrec->nupdated);
+    pfree(itups);
+
+    PageSetLSN(page, redobuffer->lsn);
+    if (module_logging_is_on(MOD_REDO)) {
+        DumpPageInfo(page, redobuffer->lsn);
+    }
+}
+
 void BtreeXlogDeleteOperatorPage(RedoBufferInfo *buffer, void *recorddata, Size recorddatalen)
 {
     xl_btree_delete *xlrec = (xl_btree_delete *)recorddata;
@@ -667,6 +709,34 @@ static XLogRecParseState *BtreeXlogDeleteParseBlock(XLogReaderState *record, uin
     return recordstatehead;
 }
 
+static XLogRecParseState *BtreeXlogDedupParseBlock(XLogReaderState *record, uint32 *blocknum)
+{
+    XLogRecParseState *recordstatehead = NULL;
+
+    *blocknum = 1;
+    XLogParseBufferAllocListFunc(record, &recordstatehead, NULL);
+    if (recordstatehead == NULL) {
+        return NULL;
+    }
+
+    XLogRecSetBlockDataState(record, BTREE_DEDUP_ORIG_BLOCK_NUM, recordstatehead);
+    return recordstatehead;
+}
+
+static XLogRecParseState *BtreeXlogUpdatePostingParseBlock(XLogReaderState *record, uint32 *blocknum)
+{
+    XLogRecParseState *recordstatehead = NULL;
+
+    *blocknum = 1;
+    XLogParseBufferAllocListFunc(record, &recordstatehead, NULL);
+    if (recordstatehead == NULL) {
+        return NULL;
+    }
+
+    XLogRecSetBlockDataState(record, BTREE_UPDATE_POSTING_ORIG_BLOCK_NUM, recordstatehead);
+    return recordstatehead;
+}
+
 static XLogRecParseState *BtreeXlogMarkHalfdeadParseBlock(XLogReaderState *record, uint32 *blocknum)
 {
     XLogRecParseState *recordstatehead = NULL;
@@ -834,6 +904,12 @@ XLogRecParseState *BtreeRedoParseToBlock(XLogReaderState *record, uint32 *blockn
         case XLOG_BTREE_REUSE_PAGE:
             recordblockstate = BtreeXlogReusePageParseBlock(record, blocknum);
             break;
+        case XLOG_BTREE_DEDUP:
+            recordblockstate = BtreeXlogDedupParseBlock(record, blocknum);
+            break;
+        case XLOG_BTREE_UPDATE_POSTING:
+            recordblockstate = BtreeXlogUpdatePostingParseBlock(record, blocknum);
+            break;
         default:
             ereport(PANIC, (errmsg("BtreeRedoParseToBlock: unknown op code %u", info)));
     }
@@ -953,6 +1029,39 @@ static void BtreeXlogDeleteBlock(XLogBlockHead *blockhead, XLogBlockDataParse *b
     }
 }
 
+static void BtreeXlogDedupBlock(XLogBlockHead *blockhead, XLogBlockDataParse *blockdatarec, RedoBufferInfo *bufferinfo)
+{
+    XLogBlockDataParse *datadecode = blockdatarec;
+    XLogRedoAction action;
+    action = XLogCheckBlockDataRedoAction(datadecode, bufferinfo);
+    if (action == BLK_NEEDS_REDO) {
+        char *maindata = XLogBlockDataGetMainData(datadecode, NULL);
+        Size blkdatalen = 0;
+        char *blkdata = XLogBlockDataGetBlockData(datadecode, &blkdatalen);
+
+        BtreeXlogDedupOperatorPage(bufferinfo, (void *)maindata, (void *)blkdata, blkdatalen);
+
+        MakeRedoBufferDirty(bufferinfo);
+    }
+}
+
+static void BtreeXlogUpdatePostingBlock(XLogBlockHead *blockhead, XLogBlockDataParse *blockdatarec,
+                                        RedoBufferInfo *bufferinfo)
+{
+    XLogBlockDataParse *datadecode = blockdatarec;
+    XLogRedoAction action;
+    action = XLogCheckBlockDataRedoAction(datadecode, bufferinfo);
+    if (action == BLK_NEEDS_REDO) {
+        char *maindata = XLogBlockDataGetMainData(datadecode, NULL);
+        Size blkdatalen = 0;
+        char *blkdata = XLogBlockDataGetBlockData(datadecode, &blkdatalen);
+
+        BtreeXlogUpdatePostingOperatorPage(bufferinfo, (void *)maindata, (void *)blkdata, blkdatalen);
+
+        MakeRedoBufferDirty(bufferinfo);
+    }
+}
+
 static void BtreeXlogMarkPageHalfdeadBlock(XLogBlockHead *blockhead, XLogBlockDataParse *blockdatarec,
                                            RedoBufferInfo *bufferinfo)
 {
@@ -1067,6 +1176,12 @@ void BtreeRedoDataBlock(XLogBlockHead *blockhead, XLogBlockDataParse *blockdatar
         case XLOG_BTREE_NEWROOT:
             BtreeXlogNewrootBlock(blockhead, blockdatarec, bufferinfo);
             break;
+        case XLOG_BTREE_DEDUP:
+            BtreeXlogDedupBlock(blockhead, blockdatarec, bufferinfo);
+            break;
+        case XLOG_BTREE_UPDATE_POSTING:
+            BtreeXlogUpdatePostingBlock(blockhead, blockdatarec, bufferinfo);
+            break;
         default:
             ereport(PANIC, (errmsg("btree_redo_block: unknown op code %u", info)));
     }
@@ -1196,6 +1196,10 @@ static const XLogParseBlock g_xlogParseBlockTable[RM_MAX_ID + 1] = {
     { slot_redo_parse_to_block, RM_SLOT_ID },
     { Heap3RedoParseToBlock, RM_HEAP3_ID },
     { barrier_redo_parse_to_block, RM_BARRIER_ID },
+#ifdef ENABLE_MOT
+    { NULL, RM_MOT_ID },
+#endif
+    { NULL, RM_BRIN_ID },
 };
 inline XLogRecParseState *XLogParseToBlockCommonFunc(XLogReaderState *record, uint32 *blocknum)
 {
@@ -0,0 +1,47 @@
+/* -------------------------------------------------------------------------
+ *
+ * brindesc.cpp
+ *	  rmgr descriptor routines for access/brin/brin_xlog.cpp
+ *
+ * Portions Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ *
+ * IDENTIFICATION
+ *	  src/gausskernel/storage/access/rmgrdesc/brindesc.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+#include "postgres.h"
+#include "knl/knl_variable.h"
+
+#include "access/brin_private.h"
+
+void brin_desc(StringInfo buf, XLogReaderState *record)
+{
+    char *rec = XLogRecGetData(record);
+    uint8 info = XLogRecGetInfo(record) & ~XLR_INFO_MASK;
+
+    switch (info & XLOG_BRIN_OPMASK) {
+        case XLOG_BRIN_INSERT: {
+            xl_brin_insert *xlrec = (xl_brin_insert *)rec;
+
+            appendStringInfo(buf, "insert: heapBlk %u pagesPerRange %u offnum %u", xlrec->heapBlk,
+                             xlrec->pagesPerRange, (uint32)xlrec->offnum);
+        } break;
+        case XLOG_BRIN_UPDATE: {
+            xl_brin_update *xlrec = (xl_brin_update *)rec;
+
+            appendStringInfo(buf, "update: heapBlk %u pagesPerRange %u old offnum %u, new offnum %u",
+                             xlrec->insert.heapBlk, xlrec->insert.pagesPerRange, (uint32)xlrec->oldOffnum,
+                             (uint32)xlrec->insert.offnum);
+        } break;
+        case XLOG_BRIN_SAMEPAGE_UPDATE:
+            appendStringInfo(buf, "samepage update: offnum %u", (uint32)((xl_brin_samepage_update *)rec)->offnum);
+            break;
+        default:
+            appendStringInfo(buf, "unknown brin op code %u", (uint32)info);
+            return;
+    }
+    if (info & XLOG_BRIN_INIT_PAGE)
+        appendStringInfo(buf, " (init page)");
+}
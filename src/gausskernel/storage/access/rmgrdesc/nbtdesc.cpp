@@ -135,6 +135,18 @@ void btree_desc(StringInfo buf, XLogReaderState *record)
             }
             break;
         }
+        case XLOG_BTREE_DEDUP: {
+            xl_btree_dedup *xlrec = (xl_btree_dedup *)rec;
+
+            appendStringInfo(buf, "dedup: %u intervals", (uint32)xlrec->nintervals);
+            break;
+        }
+        case XLOG_BTREE_UPDATE_POSTING: {
+            xl_btree_update_posting *xlrec = (xl_btree_update_posting *)rec;
+
+            appendStringInfo(buf, "update posting: %u items", (uint32)xlrec->nupdated);
+            break;
+        }
         default:
             appendStringInfo(buf, "UNKNOWN");
             break;
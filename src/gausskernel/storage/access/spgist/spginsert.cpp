@@ -29,10 +29,12 @@
 #include "storage/smgr.h"
 #include "utils/aiomem.h"
 #include "utils/memutils.h"
+#include "utils/tuplesort.h"
 
 typedef struct {
-    SpGistState spgstate; /* SPGiST's working state */
-    MemoryContext tmpCtx; /* per-tuple temporary context */
+    SpGistState spgstate;      /* SPGiST's working state */
+    MemoryContext tmpCtx;      /* per-tuple temporary context */
+    Tuplesortstate *sortstate; /* tuples to insert in sort key order, or NULL */
 } SpGistBuildState;
 
 /* Callback to process one heap tuple during IndexBuildHeapScan */
@@ -51,6 +53,54 @@ static void spgistBuildCallback(Relation index, HeapTuple htup, Datum *values, c
     MemoryContextReset(buildstate->tmpCtx);
 }
 
+/*
+ * Callback to spool one heap tuple during IndexBuildHeapScan, when the
+ * opclass provides a sort key
+ */
+static void spgistSortedBuildCallback(Relation index, HeapTuple htup, Datum *values, const bool *isnull,
+                                      bool tupleIsAlive, void *state)
+{
+    SpGistBuildState *buildstate = (SpGistBuildState *)state;
+
+    tuplesort_putindextuplevalues(buildstate->sortstate, index, &htup->t_self, values, isnull);
+}
+
+/*
+ * Insert the spooled tuples in sort key order.  A sort key that keeps nearby
+ * values close, such as the position of a point on a space-filling curve,
+ * makes consecutive insertions descend the same paths and fill the same
+ * leaf pages, so the tree is built with far fewer page accesses and its
+ * pages end up covering compact areas.
+ */
+static void spgistSortedBuildLoad(Relation index, SpGistBuildState *buildstate)
+{
+    TupleDesc tupdesc = RelationGetDescr(index);
+    IndexTuple itup;
+    bool should_free = false;
+    MemoryContext oldCtx;
+
+    tuplesort_performsort(buildstate->sortstate);
+
+    while ((itup = tuplesort_getindextuple(buildstate->sortstate, true, &should_free)) != NULL) {
+        Datum value;
+        bool isnull = false;
+
+        CHECK_FOR_INTERRUPTS();
+
+        /* Work in temp context, and reset it after each tuple */
+        oldCtx = MemoryContextSwitchTo(buildstate->tmpCtx);
+
+        value = index_getattr(itup, 1, tupdesc, &isnull);
+        spgdoinsert(index, &buildstate->spgstate, &itup->t_tid, value, isnull);
+
+        (void)MemoryContextSwitchTo(oldCtx);
+        MemoryContextReset(buildstate->tmpCtx);
+
+        if (should_free)
+            pfree(itup);
+    }
+}
+
 /*
  * Build an SP-GiST index.
  */
@@ -124,7 +174,22 @@ Datum spgbuild(PG_FUNCTION_ARGS)
                                               ALLOCSET_DEFAULT_MINSIZE, ALLOCSET_DEFAULT_INITSIZE,
                                               ALLOCSET_DEFAULT_MAXSIZE);
 
-    reltuples = tableam_index_build_scan(heap, index, indexInfo, true, spgistBuildCallback, (void*)&buildstate);
+    /* pg_am of an upgraded cluster may not count the sort key support function yet */
+    if (SPGIST_SORTKEY_PROC <= index->rd_am->amsupport && OidIsValid(index_getprocid(index, 1, SPGIST_SORTKEY_PROC))) {
+        UtilityDesc *desc = &indexInfo->ii_desc;
+        int workMem = (desc->query_mem[0] > 0) ? desc->query_mem[0] : u_sess->attr.attr_memory.maintenance_work_mem;
+        int maxMem = (desc->query_mem[1] > 0) ? desc->query_mem[1] : 0;
+
+        buildstate.sortstate = tuplesort_begin_index_sortkey(index, index_getprocinfo(index, 1, SPGIST_SORTKEY_PROC),
+                                                             workMem, false, maxMem);
+        reltuples = tableam_index_build_scan(heap, index, indexInfo, true, spgistSortedBuildCallback,
+                                             (void*)&buildstate);
+        spgistSortedBuildLoad(index, &buildstate);
+        tuplesort_end(buildstate.sortstate);
+    } else {
+        buildstate.sortstate = NULL;
+        reltuples = tableam_index_build_scan(heap, index, indexInfo, true, spgistBuildCallback, (void*)&buildstate);
+    }
 
     MemoryContextDelete(buildstate.tmpCtx);
 
@@ -324,3 +324,14 @@ Datum spg_quad_leaf_consistent(PG_FUNCTION_ARGS)
 
     PG_RETURN_BOOL(res);
 }
+
+/*
+ * Sort key for the sorted build, shared with the kd-tree opclass: the
+ * Z-order position of the point.
+ */
+Datum spg_point_sortkey(PG_FUNCTION_ARGS)
+{
+    Point *pt = PG_GETARG_POINT_P(0);
+
+    PG_RETURN_INT64((int64)point_zorder(pt->x, pt->y));
+}
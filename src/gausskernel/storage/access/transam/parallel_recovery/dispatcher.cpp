@@ -120,6 +120,7 @@ static bool DispatchXactRecord(XLogReaderState *record, List *expectedTLIs, Time
 static bool DispatchSmgrRecord(XLogReaderState *record, List *expectedTLIs, TimestampTz recordXTime);
 static bool DispatchCLogRecord(XLogReaderState *record, List *expectedTLIs, TimestampTz recordXTime);
 static bool DispatchHashRecord(XLogReaderState *record, List *expectedTLIs, TimestampTz recordXTime);
+static bool DispatchBrinRecord(XLogReaderState *record, List *expectedTLIs, TimestampTz recordXTime);
 static bool DispatchDataBaseRecord(XLogReaderState *record, List *expectedTLIs, TimestampTz recordXTime);
 static bool DispatchTableSpaceRecord(XLogReaderState *record, List *expectedTLIs, TimestampTz recordXTime);
 static bool DispatchMultiXactRecord(XLogReaderState *record, List *expectedTLIs, TimestampTz recordXTime);
@@ -164,7 +165,7 @@ static const RmgrDispatchData g_dispatchTable[RM_MAX_ID + 1] = {
 #endif
     { DispatchHeap2Record, RmgrRecordInfoValid, RM_HEAP2_ID, XLOG_HEAP2_FREEZE, XLOG_HEAP2_LOGICAL_NEWPAGE },
     { DispatchHeapRecord, RmgrRecordInfoValid, RM_HEAP_ID, XLOG_HEAP_INSERT, XLOG_HEAP_INPLACE },
-    { DispatchBtreeRecord, RmgrRecordInfoValid, RM_BTREE_ID, XLOG_BTREE_INSERT_LEAF, XLOG_BTREE_REUSE_PAGE },
+    { DispatchBtreeRecord, RmgrRecordInfoValid, RM_BTREE_ID, XLOG_BTREE_INSERT_LEAF, XLOG_BTREE_UPDATE_POSTING },
     { DispatchHashRecord, NULL, RM_HASH_ID, 0, 0 },
     { DispatchGinRecord, RmgrRecordInfoValid, RM_GIN_ID, XLOG_GIN_CREATE_INDEX, XLOG_GIN_VACUUM_DATA_LEAF_PAGE },
     /* XLOG_GIST_PAGE_DELETE is not used and info isn't continus  */
@@ -177,6 +178,7 @@ static const RmgrDispatchData g_dispatchTable[RM_MAX_ID + 1] = {
 #ifdef ENABLE_MOT
     {DispatchMotRecord, NULL, RM_MOT_ID, 0, 0},
 #endif
+    { DispatchBrinRecord, NULL, RM_BRIN_ID, 0, 0 },
 };
 
 /* Run from the dispatcher and txn worker thread. */
@@ -929,6 +931,14 @@ static bool DispatchHashRecord(XLogReaderState *record, List *expectedTLIs, Time
     return true;
 }
 
+/* Run from the dispatcher thread. */
+static bool DispatchBrinRecord(XLogReaderState *record, List *expectedTLIs, TimestampTz recordXTime)
+{
+    /* BRIN records touch up to three pages, replay them as a whole like hash ones */
+    DispatchTxnRecord(record, expectedTLIs, recordXTime, false);
+    return true;
+}
+
 static bool DispatchBtreeRecord(XLogReaderState *record, List *expectedTLIs, TimestampTz recordXTime)
 {
     uint8 info = (XLogRecGetInfo(record) & (~XLR_INFO_MASK));
@@ -34,6 +34,9 @@
 #include "instruments/instr_waitevent.h"
 #include "access/parallel_recovery/spsc_blocking_queue.h"
 #include "storage/copydir.h"
+#ifdef ENABLE_MOT
+#include "storage/mot/mot_xlog.h"
+#endif
 
 static const uint32 MAX_REALPATH_LEN = 4096;
 Datum redo_get_node_name()
@@ -186,28 +189,57 @@ char *redo_get_name_by_wait_type(uint32 type)
     }
 }
 
-void redo_get_worker_info_text(char *info, uint32 max_info_len)
+#ifdef ENABLE_MOT
+/* MOT redo workers are listed after the page redo workers, as long as the buffer has room for them */
+static void redo_get_mot_worker_info_text(char *info, uint32 max_info_len)
 {
+    const uint32 line_len = 48;
     RedoWorkerStatsData worker[MAX_RECOVERY_THREAD_NUM] = {0};
     uint32 worker_num = 0;
     errno_t errorno = EOK;
-    GetRedoWrokerStatistic(&worker_num, worker, MAX_RECOVERY_THREAD_NUM);
+    MOTGetRedoWorkerStatistic(&worker_num, worker, MAX_RECOVERY_THREAD_NUM);
 
-    if (worker_num == 0) {
-        errorno = snprintf_s(info, max_info_len, max_info_len - 1, "%-16s", "no redo worker");
-        securec_check_ss(errorno, "\0", "\0");
+    if (worker_num == 0 || strlen(info) + 2 * line_len >= max_info_len) {
         return;
     }
-    errorno = snprintf_s(info, max_info_len, max_info_len - 1, "%-4s%-8s%-11s%-21s", "id", "q_use", "q_max_use",
-                         "rec_cnt");
+    errorno = snprintf_s(info + strlen(info), max_info_len - strlen(info), max_info_len - strlen(info) - 1,
+                         "\n%-16s\n%-4s%-8s%-11s%-21s", "mot redo worker", "id", "q_use", "q_max_use", "rec_cnt");
     securec_check_ss(errorno, "\0", "\0");
-    for (uint32 i = 0; i < worker_num; ++i) {
+    for (uint32 i = 0; i < worker_num && strlen(info) + line_len < max_info_len; ++i) {
         errorno = snprintf_s(info + strlen(info), max_info_len - strlen(info), max_info_len - strlen(info) - 1,
                              "\n%-4u%-8u%-11u%-21lu", worker[i].id, worker[i].queue_usage, worker[i].queue_max_usage,
                              worker[i].redo_rec_count);
         securec_check_ss(errorno, "\0", "\0");
     }
 }
+#endif
+
+void redo_get_worker_info_text(char *info, uint32 max_info_len)
+{
+    RedoWorkerStatsData worker[MAX_RECOVERY_THREAD_NUM] = {0};
+    uint32 worker_num = 0;
+    errno_t errorno = EOK;
+    GetRedoWrokerStatistic(&worker_num, worker, MAX_RECOVERY_THREAD_NUM);
+
+    if (worker_num == 0) {
+        errorno = snprintf_s(info, max_info_len, max_info_len - 1, "%-16s", "no redo worker");
+        securec_check_ss(errorno, "\0", "\0");
+    } else {
+        errorno = snprintf_s(info, max_info_len, max_info_len - 1, "%-4s%-8s%-11s%-21s", "id", "q_use", "q_max_use",
+                             "rec_cnt");
+        securec_check_ss(errorno, "\0", "\0");
+        for (uint32 i = 0; i < worker_num; ++i) {
+            errorno = snprintf_s(info + strlen(info), max_info_len - strlen(info), max_info_len - strlen(info) - 1,
+                                 "\n%-4u%-8u%-11u%-21lu", worker[i].id, worker[i].queue_usage,
+                                 worker[i].queue_max_usage, worker[i].redo_rec_count);
+            securec_check_ss(errorno, "\0", "\0");
+        }
+    }
+
+#ifdef ENABLE_MOT
+    redo_get_mot_worker_info_text(info, max_info_len);
+#endif
+}
 
 Datum redo_get_worker_info()
 {
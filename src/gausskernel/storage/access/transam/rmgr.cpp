@@ -25,6 +25,7 @@
 #include "postgres.h"
 #include "knl/knl_variable.h"
 
+#include "access/brin_private.h"
 #include "access/clog.h"
 #include "access/gin.h"
 #include "access/gist_private.h"
@@ -623,6 +623,9 @@ static XLogRecPtr XLogBytePosToEndRecPtr(uint64 bytepos);
 static uint64 XLogRecPtrToBytePos(XLogRecPtr ptr);
 
 static XLogRecPtr XLogInsertRecordSingle(XLogRecData *rdata, XLogRecPtr fpw_lsn, bool isupgrade);
+static void XLogCountInsertLatency(instr_time startTime);
+static void XLogAdvanceSentResult(XLogRecPtr initializedTo);
+static inline Latch *XLogWalBufferPreInitializerLatch(void);
 
 void ArchiveXlogForForceFinishRedo(XLogReaderState *xlogreader, TermFileData *term_file);
 TermFileData GetTermFileDataAndClear(void);
@@ -1528,6 +1531,14 @@ static XLogRecPtr XLogInsertRecordSingle(XLogRecData *rdata, XLogRecPtr fpw_lsn,
  */
 XLogRecPtr XLogInsertRecord(XLogRecData *rdata, XLogRecPtr fpw_lsn, bool isupgrade)
 {
+    XLogRecPtr EndPos;
+    instr_time startTime;
+    bool trackLatency = u_sess->attr.attr_common.track_wal_insert_latency;
+
+    if (trackLatency) {
+        INSTR_TIME_SET_CURRENT(startTime);
+    }
+
 #ifdef __aarch64__
     /*
      * In ARM architecture, insert an XLOG record represented by an already-constructed chain of data
@@ -1539,13 +1550,42 @@ XLogRecPtr XLogInsertRecord(XLogRecData *rdata, XLogRecPtr fpw_lsn, bool isupgra
         ((isupgrade ? ((XLogRecordOld *)rechdr)->xl_rmid : ((XLogRecord *)rechdr)->xl_rmid) == RM_XLOG_ID &&
          (isupgrade ? ((XLogRecordOld *)rechdr)->xl_info : ((XLogRecord *)rechdr)->xl_info) == XLOG_SWITCH);
     if (isLogSwitch || isupgrade) {
-        return XLogInsertRecordSingle(rdata, fpw_lsn, isupgrade);
+        EndPos = XLogInsertRecordSingle(rdata, fpw_lsn, isupgrade);
     } else {
-        return XLogInsertRecordGroup(rdata, fpw_lsn);
+        EndPos = XLogInsertRecordGroup(rdata, fpw_lsn);
     }
 #else
-    return XLogInsertRecordSingle(rdata, fpw_lsn, isupgrade);
+    EndPos = XLogInsertRecordSingle(rdata, fpw_lsn, isupgrade);
 #endif /* __aarch64__ */
+
+    if (trackLatency) {
+        XLogCountInsertLatency(startTime);
+    }
+
+    return EndPos;
+}
+
+/*
+ * Account one WAL insert, started at startTime, in the instance-wide latency
+ * histogram exposed by gs_wal_insert_latency(). Each bucket has a cache line
+ * of its own, so concurrent inserters only contend when they hit the same one.
+ */
+static void XLogCountInsertLatency(instr_time startTime)
+{
+    instr_time duration;
+    uint64 usecs;
+    int bucket = 0;
+
+    INSTR_TIME_SET_CURRENT(duration);
+    INSTR_TIME_SUBTRACT(duration, startTime);
+    usecs = INSTR_TIME_GET_MICROSEC(duration);
+
+    while (usecs > 0 && bucket < WAL_INSERT_LATENCY_BUCKETS - 1) {
+        usecs >>= 1;
+        bucket++;
+    }
+
+    (void)pg_atomic_fetch_add_u64(&g_instance.wal_cxt.insertLatencyHist[bucket].count, 1);
 }
 
 /*
@@ -2803,6 +2843,10 @@ static void XLogWrite(const XLogwrtRqst &WriteRqst, bool flexible)
             if (!use_existent) {
                 g_instance.wal_cxt.globalEndPosSegNo = t_thrd.xlog_cxt.openLogSegNo;
                 WakeupWalSemaphore(&g_instance.wal_cxt.walInitSegLock->l.sem);
+                Latch *auxLatch = XLogWalBufferPreInitializerLatch();
+                if (auxLatch != NULL) {
+                    SetLatch(auxLatch);
+                }
             }
         }
 
@@ -3316,15 +3360,79 @@ void XLogWaitFlush(XLogRecPtr recptr)
     return;
 }
 
+/*
+ * Publish that the WAL buffer pages before initializedTo are ready for use and
+ * wake up inserters waiting in XLogWaitBufferInit. The WAL writer, its auxiliary
+ * and self-flushing agents may race here, so sentResult is only moved forward.
+ */
+static void XLogAdvanceSentResult(XLogRecPtr initializedTo)
+{
+    uint64 sentTo = pg_atomic_read_u64((uint64 *)&g_instance.wal_cxt.sentResult);
+
+    while (XLByteLT(sentTo, initializedTo)) {
+        if (pg_atomic_compare_exchange_u64((uint64 *)&g_instance.wal_cxt.sentResult, &sentTo, initializedTo)) {
+            break;
+        }
+    }
+
+    WakeupWalSemaphore(&g_instance.wal_cxt.walBufferInitWaitLock->l.sem);
+}
+
+/*
+ * Zero and header-initialize the WAL buffer pages the WAL writer has flushed so
+ * that inserters find them ready. Called by the WAL writer auxiliary thread after
+ * each flush; returns true if any page was initialized.
+ */
+bool XLogPreInitWalBuffers(void)
+{
+    XLogRecPtr flushTo = pg_atomic_read_u64((uint64 *)&g_instance.wal_cxt.flushResult);
+    XLogRecPtr initializeRqstPtr = flushTo - flushTo % XLOG_BLCKSZ;
+
+    if (XLogRecPtrIsInvalid(initializeRqstPtr) ||
+        !XLByteLT(pg_atomic_read_u64((uint64 *)&g_instance.wal_cxt.sentResult), initializeRqstPtr)) {
+        return false;
+    }
+
+    t_thrd.xlog_cxt.ThisTimeLineID = t_thrd.shemem_ptr_cxt.XLogCtl->ThisTimeLineID;
+    AdvanceXLInsertBuffer<false>(initializeRqstPtr, false);
+    XLogAdvanceSentResult(initializeRqstPtr);
+
+    return true;
+}
+
+/*
+ * Returns the latch of the WAL writer auxiliary thread when it is running and
+ * takes over the initialization of flushed WAL buffer pages from the WAL
+ * writer, otherwise NULL. The shared pointer is cleared when the auxiliary
+ * exits, so callers must test and use the returned value only.
+ */
+static inline Latch *XLogWalBufferPreInitializerLatch(void)
+{
+    if (g_instance.pid_cxt.WalWriterAuxiliaryPID == 0) {
+        return NULL;
+    }
+    return ((volatile PROC_HDR *)g_instance.proc_base)->walwriterauxiliaryLatch;
+}
+
 void XLogWaitBufferInit(XLogRecPtr recptr)
 {
     volatile XLogRecPtr sentTo = gs_compare_and_swap_u64(&g_instance.wal_cxt.sentResult, 0, 0);
     while (XLByteLT(sentTo, recptr)) {
         if (!g_instance.wal_cxt.isWalWriterUp) {
             XLogSelfFlush();
-        } else if (LWLockAcquireOrWait(g_instance.wal_cxt.walBufferInitWaitLock->l.lock, LW_EXCLUSIVE)) {
-            PGSemaphoreLock(&g_instance.wal_cxt.walBufferInitWaitLock->l.sem, true);
-            LWLockRelease(g_instance.wal_cxt.walBufferInitWaitLock->l.lock);
+        } else {
+            /*
+             * Buffer pre-initialization is behind us; make sure the auxiliary
+             * is not sleeping out its timeout before going to sleep ourselves.
+             */
+            Latch *auxLatch = XLogWalBufferPreInitializerLatch();
+            if (auxLatch != NULL) {
+                SetLatch(auxLatch);
+            }
+            if (LWLockAcquireOrWait(g_instance.wal_cxt.walBufferInitWaitLock->l.lock, LW_EXCLUSIVE)) {
+                PGSemaphoreLock(&g_instance.wal_cxt.walBufferInitWaitLock->l.sem, true);
+                LWLockRelease(g_instance.wal_cxt.walBufferInitWaitLock->l.lock);
+            }
         }
         sentTo = gs_compare_and_swap_u64(&g_instance.wal_cxt.sentResult, 0, 0);
     }
@@ -3500,11 +3608,17 @@ bool XLogBackgroundFlush(void)
     InitializeRqstPtr = g_instance.wal_cxt.flushResult - g_instance.wal_cxt.flushResult % XLOG_BLCKSZ;
 
     if (InitializeRqstPtr != InvalidXLogRecPtr && XLByteLT(g_instance.wal_cxt.sentResult, InitializeRqstPtr)) {
-        AdvanceXLInsertBuffer<false>(InitializeRqstPtr, false);
-
-        (void)pg_atomic_exchange_u64((uint64 *)&g_instance.wal_cxt.sentResult, InitializeRqstPtr);
-
-        WakeupWalSemaphore(&g_instance.wal_cxt.walBufferInitWaitLock->l.sem);
+        /*
+         * Let the WAL writer auxiliary zero the flushed pages while we go on
+         * flushing; only initialize them here when it's not around.
+         */
+        Latch *auxLatch = g_instance.wal_cxt.isWalWriterUp ? XLogWalBufferPreInitializerLatch() : NULL;
+        if (auxLatch != NULL) {
+            SetLatch(auxLatch);
+        } else {
+            AdvanceXLInsertBuffer<false>(InitializeRqstPtr, false);
+            XLogAdvanceSentResult(InitializeRqstPtr);
+        }
     }
 
     return true;
@@ -3589,8 +3703,7 @@ static void XLogSelfFlushWithoutStatus(int numHitsOnStartPage,
     
     XLogRecPtr initializeRqstPtr = currPos - currPos % XLOG_BLCKSZ;
     AdvanceXLInsertBuffer<false>(initializeRqstPtr, false);
-    (void)pg_atomic_exchange_u64((uint64 *)&g_instance.wal_cxt.sentResult, initializeRqstPtr);
-    WakeupWalSemaphore(&g_instance.wal_cxt.walBufferInitWaitLock->l.sem);
+    XLogAdvanceSentResult(initializeRqstPtr);
 }
 
 /*
@@ -3890,6 +4003,12 @@ void PreInitXlogFileForPrimary(int advance_xlog_file_num)
     startSegNo = g_instance.wal_cxt.globalEndPosSegNo + 1;
     target = startSegNo + advance_xlog_file_num - 1;
     for (nextSegNo = startSegNo; nextSegNo <= target; nextSegNo++) {
+        /*
+         * Creating a segment takes a while; keep the flushed WAL buffer pages
+         * initialized in between so that inserters don't wait on us.
+         */
+        (void)XLogPreInitWalBuffers();
+
         use_existent = true;
         lf = XLogFileInit(nextSegNo, &use_existent, true);
         if (lf >= 0) {
@@ -6715,6 +6834,18 @@ void XLOGShmemInit(void)
      */
     allocptr = (char *)TYPEALIGN(XLOG_BLCKSZ, allocptr);
     t_thrd.shemem_ptr_cxt.XLogCtl->pages = allocptr;
+#ifdef __USE_NUMA
+    /*
+     * A WAL record lands in the buffer page its LSN maps to, whichever NUMA group
+     * the inserter belongs to, so no node can own a stripe of the ring. Spread the
+     * pages over all nodes before they are first touched instead of leaving the
+     * whole ring on the node of the postmaster.
+     */
+    if (nNumaNodes > 1) {
+        numa_interleave_memory(t_thrd.shemem_ptr_cxt.XLogCtl->pages,
+                               (Size)XLOG_BLCKSZ * g_instance.attr.attr_storage.XLOGbuffers, numa_all_nodes_ptr);
+    }
+#endif
     errorno = memset_s(t_thrd.shemem_ptr_cxt.XLogCtl->pages,
                        (Size)XLOG_BLCKSZ * g_instance.attr.attr_storage.XLOGbuffers, 0,
                        (Size)XLOG_BLCKSZ * g_instance.attr.attr_storage.XLOGbuffers);
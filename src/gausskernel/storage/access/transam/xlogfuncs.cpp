@@ -1296,3 +1296,62 @@ Datum gs_get_local_barrier_status(PG_FUNCTION_ARGS)
     PG_RETURN_TEXT_P(cstring_to_text(flushLocation));
 }
 
+
+/*
+ * gs_wal_insert_latency: report the WAL insert latency histogram
+ *
+ * One row per bucket, upper_us is NULL for the open-ended last bucket. Inserts
+ * are only counted while track_wal_insert_latency is on.
+ */
+Datum gs_wal_insert_latency(PG_FUNCTION_ARGS)
+{
+#define GS_WAL_INSERT_LATENCY_COLS 3
+    ReturnSetInfo *rsinfo = (ReturnSetInfo *)fcinfo->resultinfo;
+    TupleDesc tupdesc;
+    Tuplestorestate *tupstore;
+    MemoryContext oldcontext;
+    Datum values[GS_WAL_INSERT_LATENCY_COLS];
+    bool nulls[GS_WAL_INSERT_LATENCY_COLS];
+    errno_t rc;
+
+    /* check to see if caller supports us returning a tuplestore */
+    if (rsinfo == NULL || !IsA(rsinfo, ReturnSetInfo))
+        ereport(ERROR, (errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+                errmsg("set-valued function called in context that cannot accept a set")));
+    if (!(rsinfo->allowedModes & SFRM_Materialize))
+        ereport(ERROR, (errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+                errmsg("materialize mode required, but it is not allowed in this context")));
+
+    /* Build a tuple descriptor for our result type */
+    if (get_call_result_type(fcinfo, NULL, &tupdesc) != TYPEFUNC_COMPOSITE)
+        ereport(ERROR, (errcode(ERRCODE_DATATYPE_MISMATCH), errmsg("return type must be a row type")));
+
+    oldcontext = MemoryContextSwitchTo(rsinfo->econtext->ecxt_per_query_memory);
+
+    tupstore = tuplestore_begin_heap(true, false, u_sess->attr.attr_memory.work_mem);
+    rsinfo->returnMode = SFRM_Materialize;
+    rsinfo->setResult = tupstore;
+    rsinfo->setDesc = tupdesc;
+
+    MemoryContextSwitchTo(oldcontext);
+
+    for (int bucket = 0; bucket < WAL_INSERT_LATENCY_BUCKETS; bucket++) {
+        rc = memset_s(nulls, sizeof(nulls), false, sizeof(nulls));
+        securec_check(rc, "\0", "\0");
+
+        values[0] = Int64GetDatum(bucket == 0 ? 0 : (int64)1 << (bucket - 1));
+        if (bucket == WAL_INSERT_LATENCY_BUCKETS - 1) {
+            values[1] = (Datum)0;
+            nulls[1] = true;
+        } else {
+            values[1] = Int64GetDatum((int64)1 << bucket);
+        }
+        values[2] = Int64GetDatum((int64)pg_atomic_read_u64(&g_instance.wal_cxt.insertLatencyHist[bucket].count));
+
+        tuplestore_putvalues(tupstore, tupdesc, values, nulls);
+    }
+
+    tuplestore_donestoring(tupstore);
+
+    return (Datum)0;
+}
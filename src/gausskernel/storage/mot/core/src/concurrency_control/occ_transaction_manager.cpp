@@ -28,6 +28,8 @@
 #include "mot_engine.h"
 #include "row.h"
 #include "row_header.h"
+#include "sentinel.h"
+#include "table.h"
 #include "txn.h"
 #include "txn_access.h"
 #include "checkpoint_manager.h"
@@ -45,10 +47,15 @@ OccTransactionManager::OccTransactionManager()
       m_rowsSetSize(0),
       m_deleteSetSize(0),
       m_insertSetSize(0),
+      m_numPreLocks(0),
+      m_hotRowThreshold(0),
+      m_hotRowCoolDown(0),
+      m_conflictAccess(nullptr),
       m_dynamicSleep(100),
       m_rowsLocked(false),
       m_preAbort(true),
-      m_validationNoWait(true)
+      m_validationNoWait(true),
+      m_hotRowLocking(false)
 {}
 
 OccTransactionManager::~OccTransactionManager()
@@ -129,7 +136,7 @@ bool OccTransactionManager::ValidateWriteSet(TxnManager* txMan)
             continue;
         }
 
-        if (!QuickHeaderValidation(ac)) {
+        if (!CheckHeader(ac)) {
             return false;
         }
     }
@@ -162,40 +169,48 @@ bool OccTransactionManager::LockHeadersNoWait(TxnManager* txMan, uint32_t& numSe
     uint64_t sleepTime = 1;
     uint64_t thdId = txMan->GetThdId();
     TxnOrderedSet_t& orderedSet = txMan->m_accessMgr->GetOrderedRowSet();
+    // pre-locked rows are already locked by this transaction
+    uint32_t numHeaderLocks = m_writeSetSize - m_numPreLocks;
+    const Access* lockedAccess = nullptr;
     numSentinelsLock = 0;
-    while (numSentinelsLock != m_writeSetSize) {
+    while (numSentinelsLock != numHeaderLocks) {
         for (const auto& raPair : orderedSet) {
             const Access* ac = raPair.second;
             if (ac->m_type == RD) {
                 continue;
             }
-            Sentinel* sent = ac->m_origSentinel;
-            if (!sent->TryLock(thdId)) {
-                break;
+            if (!ac->m_params.IsPreLocked()) {
+                Sentinel* sent = ac->m_origSentinel;
+                if (!sent->TryLock(thdId)) {
+                    lockedAccess = ac;
+                    break;
+                }
+                numSentinelsLock++;
             }
-            numSentinelsLock++;
             if (ac->m_params.IsPrimaryUpgrade()) {
                 ac->m_auxRow->m_rowHeader.Lock();
             }
             // New insert row is already committed!
             // Check if row has changed in sentinel
-            if (!QuickHeaderValidation(ac)) {
+            if (!CheckHeader(ac)) {
                 return false;
             }
         }
 
-        if (numSentinelsLock != m_writeSetSize) {
+        if (numSentinelsLock != numHeaderLocks) {
             ReleaseHeaderLocks(txMan, numSentinelsLock);
             numSentinelsLock = 0;
             if (m_preAbort) {
                 for (const auto& acPair : orderedSet) {
                     const Access* ac = acPair.second;
-                    if (!QuickHeaderValidation(ac)) {
+                    if (!CheckHeader(ac)) {
                         return false;
                     }
                 }
             }
             if (sleepTime > LOCK_TIME_OUT) {
+                // the row that could not be locked is contended as well
+                m_conflictAccess = lockedAccess;
                 return false;
             } else {
                 if (IsHighContention() == false) {
@@ -217,7 +232,8 @@ RC OccTransactionManager::LockHeaders(TxnManager* txMan, uint32_t& numSentinelsL
     uint64_t thdId = txMan->GetThdId();
     TxnOrderedSet_t& orderedSet = txMan->m_accessMgr->GetOrderedRowSet();
     numSentinelsLock = 0;
-    if (m_validationNoWait) {
+    // waiting for header locks while holding pre-locked rows might deadlock
+    if (m_validationNoWait || m_numPreLocks > 0) {
         if (!LockHeadersNoWait(txMan, numSentinelsLock)) {
             rc = RC_ABORT;
             goto final;
@@ -236,7 +252,7 @@ RC OccTransactionManager::LockHeaders(TxnManager* txMan, uint32_t& numSentinelsL
             }
             // New insert row is already committed!
             // Check if row has chained in sentinel
-            if (!QuickHeaderValidation(ac)) {
+            if (!CheckHeader(ac)) {
                 rc = RC_ABORT;
                 goto final;
             }
@@ -304,7 +320,7 @@ bool OccTransactionManager::QuickVersionCheck(TxnManager* txMan, uint32_t& readS
         }
 
         if (m_preAbort) {
-            if (!QuickHeaderValidation(ac)) {
+            if (!CheckHeader(ac)) {
                 return false;
             }
         }
@@ -324,6 +340,7 @@ RC OccTransactionManager::ValidateOcc(TxnManager* txMan)
     m_rowsSetSize = 0;
     m_deleteSetSize = 0;
     m_insertSetSize = 0;
+    m_conflictAccess = nullptr;
     m_txnCounter++;
 
     if (rowCount == 0) {
@@ -368,14 +385,19 @@ RC OccTransactionManager::ValidateOcc(TxnManager* txMan)
 
 final:
     if (likely(rc == RC_OK)) {
-        MOT_ASSERT(numSentinelLock == m_writeSetSize);
+        MOT_ASSERT(numSentinelLock + m_numPreLocks == m_writeSetSize);
+        if (m_numPreLocks > 0) {
+            TakeOverPreLocks(txMan);
+        }
         m_rowsLocked = true;
     } else {
         ReleaseHeaderLocks(txMan, numSentinelLock);
         if (likely(rc == RC_ABORT)) {
             m_abortsCounter++;
+            RecordConflict();
         }
     }
+    m_conflictAccess = nullptr;
 
     return rc;
 }
@@ -421,6 +443,11 @@ void OccTransactionManager::WriteChanges(TxnManager* txMan)
     for (const auto& raPair : orderedSet) {
         const Access* access = raPair.second;
         access->GetRowFromHeader()->m_rowHeader.WriteChangesToRow(access, txMan->GetCommitSequenceNumber());
+        // a committed write decays the conflict count of the row, and ends the hot period eventually
+        if (m_hotRowLocking && access->m_type != RD && access->m_type != INS &&
+            access->m_params.IsPrimarySentinel()) {
+            access->m_origSentinel->RecordWrite(m_hotRowThreshold);
+        }
     }
 
     // Treat Inserts
@@ -524,7 +551,7 @@ void OccTransactionManager::ReleaseHeaderLocks(TxnManager* txMan, uint32_t numOf
     // use local counter to optimize
     for (const auto& raPair : orderedSet) {
         const Access* access = raPair.second;
-        if (access->m_type == RD) {
+        if (access->m_type == RD || access->m_params.IsPreLocked()) {
             continue;
         } else {
             numOfLocks--;
@@ -567,6 +594,91 @@ void OccTransactionManager::ReleaseRowsLocks(TxnManager* txMan, uint32_t numOfLo
     }
 }
 
+bool OccTransactionManager::PreLockHotRow(TxnManager* txMan, Sentinel* sentinel)
+{
+    if (!m_hotRowLocking || !sentinel->IsHot(m_hotRowThreshold)) {
+        return false;
+    }
+
+    uint64_t thdId = txMan->GetThdId();
+    uint64_t sleepTime = 1;
+    uint32_t retries = 0;
+    while (!sentinel->TryLock(thdId)) {
+        if (sleepTime <= LOCK_TIME_OUT) {
+            CpuCyclesLevelTime::Sleep(sleepTime);
+            sleepTime = sleepTime << 1;
+        } else if (retries < HOT_ROW_LOCK_RETRIES) {
+            (void)usleep(HOT_ROW_LOCK_SLEEP_USEC);
+            retries++;
+        } else {
+            // the row is held for long by another transaction, fall back to optimistic access
+            sentinel->GetIndex()->GetTable()->RecordHotRowLock(false);
+            return false;
+        }
+    }
+
+    sentinel->GetIndex()->GetTable()->RecordHotRowLock(true);
+    m_numPreLocks++;
+    return true;
+}
+
+void OccTransactionManager::ReleasePreLock(Sentinel* sentinel)
+{
+    MOT_ASSERT(m_numPreLocks > 0);
+    sentinel->Release();
+    m_numPreLocks--;
+}
+
+void OccTransactionManager::ReleasePreLocks(TxnManager* txMan)
+{
+    if (m_numPreLocks == 0) {
+        return;
+    }
+
+    TxnOrderedSet_t& orderedSet = txMan->m_accessMgr->GetOrderedRowSet();
+    for (const auto& raPair : orderedSet) {
+        Access* access = raPair.second;
+        if (access->m_params.IsPreLocked()) {
+            access->m_params.UnsetPreLocked();
+            access->m_origSentinel->Release();
+            if (--m_numPreLocks == 0) {
+                break;
+            }
+        }
+    }
+    MOT_ASSERT(m_numPreLocks == 0);
+}
+
+void OccTransactionManager::TakeOverPreLocks(TxnManager* txMan)
+{
+    TxnOrderedSet_t& orderedSet = txMan->m_accessMgr->GetOrderedRowSet();
+    for (const auto& raPair : orderedSet) {
+        Access* access = raPair.second;
+        if (access->m_params.IsPreLocked()) {
+            access->m_params.UnsetPreLocked();
+            if (--m_numPreLocks == 0) {
+                break;
+            }
+        }
+    }
+    MOT_ASSERT(m_numPreLocks == 0);
+}
+
+void OccTransactionManager::RecordConflict()
+{
+    const Access* access = m_conflictAccess;
+    if (access == nullptr || access->m_type == RD || access->m_type == INS || !access->m_params.IsPrimarySentinel()) {
+        return;
+    }
+
+    Sentinel* sentinel = access->m_origSentinel;
+    bool becameHot = false;
+    if (m_hotRowLocking) {
+        becameHot = sentinel->RecordConflict(m_hotRowThreshold, m_hotRowCoolDown);
+    }
+    sentinel->GetIndex()->GetTable()->RecordConflict(becameHot);
+}
+
 void OccTransactionManager::CleanUp()
 {
     m_writeSetSize = 0;
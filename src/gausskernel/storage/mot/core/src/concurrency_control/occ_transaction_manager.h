@@ -31,8 +31,15 @@ namespace MOT {
 // forward declaration
 class Access;
 class TxnManager;
+class Sentinel;
 
 constexpr uint64_t LOCK_TIME_OUT = 1 << 16;
+
+/** @var The number of sleeps while waiting for a hot row lock, after spinning for LOCK_TIME_OUT cycles. */
+constexpr uint32_t HOT_ROW_LOCK_RETRIES = 100;
+
+/** @var The sleep time in microseconds while waiting for a hot row lock. */
+constexpr uint32_t HOT_ROW_LOCK_SLEEP_USEC = 10;
 /**
  * @class OccTransactionManager
  * @brief Optimistic concurrency control implementation.
@@ -73,6 +80,50 @@ public:
         m_validationNoWait = b;
     }
 
+    /**
+     * @brief Sets or clears the hot-row-locking flag.
+     * @detail Determines whether hot rows are detected and locked at first write.
+     * @param b The new hot-row-locking flag state.
+     */
+    void SetHotRowLocking(bool b)
+    {
+        m_hotRowLocking = b;
+    }
+
+    /**
+     * @brief Configures when a row is considered hot.
+     * @param threshold The number of commit-time conflicts after which a row is considered hot.
+     * @param coolDown The number of committed writes after which a hot row is no longer hot.
+     */
+    void SetHotRowThresholds(uint32_t threshold, uint32_t coolDown)
+    {
+        m_hotRowThreshold = threshold;
+        m_hotRowCoolDown = coolDown;
+    }
+
+    /**
+     * @brief Locks a hot row before it is first accessed for update, so the transaction will not fail
+     * commit-time validation on it. The lock is held until the transaction ends.
+     * @param txMan The accessing transaction.
+     * @param sentinel The primary sentinel of the row.
+     * @return True if the row was locked. In this case the caller must either mark the row access as pre-locked,
+     * or release the lock with ReleasePreLock().
+     */
+    bool PreLockHotRow(TxnManager* txMan, Sentinel* sentinel);
+
+    /**
+     * @brief Releases a lock taken by PreLockHotRow() on a row that was not accessed eventually.
+     * @param sentinel The primary sentinel of the row.
+     */
+    void ReleasePreLock(Sentinel* sentinel);
+
+    /**
+     * @brief Releases the locks of the pre-locked rows of a transaction that did not pass validation.
+     * After a successful validation these locks are released along with the rest of the header locks.
+     * @param txMan The ending transaction.
+     */
+    void ReleasePreLocks(TxnManager* txMan);
+
     /**
      * @brief Performs OCC validation for a transaction commit.
      * @param tx The committed transaction.
@@ -154,6 +205,22 @@ private:
     /** @brief Validate Header for insert */
     bool QuickHeaderValidation(const Access* access);
 
+    /** @brief Validates the header of an access, and remembers the access as the conflict cause on failure. */
+    inline bool CheckHeader(const Access* access)
+    {
+        if (!QuickHeaderValidation(access)) {
+            m_conflictAccess = access;
+            return false;
+        }
+        return true;
+    }
+
+    /** @brief Updates the contention statistics of the row that caused the current transaction to abort. */
+    void RecordConflict();
+
+    /** @brief Hands the pre-locked rows over to the header locks of a validated transaction. */
+    void TakeOverPreLocks(TxnManager* txMan);
+
     bool QuickVersionCheck(TxnManager* txMan, uint32_t& readSetSize);
 
     bool LockHeadersNoWait(TxnManager* txMan, uint32_t& numSentinelsLock);
@@ -193,6 +260,18 @@ private:
     /** @var Write set size. */
     uint32_t m_insertSetSize;
 
+    /** @var Number of rows locked at first write by PreLockHotRow(). */
+    uint32_t m_numPreLocks;
+
+    /** @var The number of commit-time conflicts after which a row is considered hot. */
+    uint32_t m_hotRowThreshold;
+
+    /** @var The number of committed writes after which a hot row is no longer hot. */
+    uint32_t m_hotRowCoolDown;
+
+    /** @var The access that failed validation, if known. */
+    const Access* m_conflictAccess;
+
     uint16_t m_dynamicSleep;
 
     /** @var flag indicating whether we locked the rows   */
@@ -203,6 +282,9 @@ private:
 
     /** @var Validate-no-wait configuration. */
     bool m_validationNoWait;
+
+    /** @var Hot row locking configuration. */
+    bool m_hotRowLocking;
 };
 }  // namespace MOT
 
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * histogram_statistic_variable.cpp
+ *    A statistic variable for integral types that counts samples in power of two buckets.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/src/infra/stats/histogram_statistic_variable.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include <stdio.h>
+
+#include "histogram_statistic_variable.h"
+
+namespace MOT {
+constexpr uint32_t HistogramStatisticVariable::BUCKET_COUNT;
+
+HistogramStatisticVariable::HistogramStatisticVariable(const char* name, const char* units /* = "" */)
+    : StatisticVariable(name), m_countSaved(0)
+{
+    errno_t erc = snprintf_s(m_units, STAT_VAR_MAX_NAME_LEN, STAT_VAR_MAX_NAME_LEN - 1, "%s", units);
+    securec_check_ss(erc, "\0", "\0");
+    erc = memset_s(m_buckets, sizeof(m_buckets), 0, sizeof(m_buckets));
+    securec_check(erc, "\0", "\0");
+    erc = memset_s(m_bucketsSaved, sizeof(m_bucketsSaved), 0, sizeof(m_bucketsSaved));
+    securec_check(erc, "\0", "\0");
+}
+
+void HistogramStatisticVariable::Summarize(bool updateTstamp)
+{
+    (void)updateTstamp;
+    m_countSaved = m_count;
+    for (uint32_t i = 0; i < BUCKET_COUNT; ++i) {
+        m_bucketsSaved[i] = m_buckets[i];
+    }
+}
+
+void HistogramStatisticVariable::Print(LogLevel logLevel) const
+{
+    constexpr size_t maxLineLen = 1024;
+    char line[maxLineLen];
+    size_t pos = 0;
+    for (uint32_t i = 0; i < BUCKET_COUNT; ++i) {
+        if (m_bucketsSaved[i] == 0) {
+            continue;
+        }
+        uint64_t lowBound = (i == 0) ? 0 : (1ULL << (i - 1));
+        int erc;
+        if (i == BUCKET_COUNT - 1) {
+            erc = snprintf_s(line + pos,
+                maxLineLen - pos,
+                maxLineLen - pos - 1,
+                ", >=%" PRIu64 ": %" PRIu64,
+                lowBound,
+                m_bucketsSaved[i]);
+        } else {
+            erc = snprintf_s(line + pos,
+                maxLineLen - pos,
+                maxLineLen - pos - 1,
+                ", <%" PRIu64 ": %" PRIu64,
+                (uint64_t)(1ULL << i),
+                m_bucketsSaved[i]);
+        }
+        securec_check_ss(erc, "\0", "\0");
+        pos += (size_t)erc;
+    }
+    line[pos] = 0;
+    MOT_LOG(logLevel, "%s={ samples: %" PRIu64 " (%s)%s }", m_name, m_countSaved, m_units, line);
+}
+
+void HistogramStatisticVariable::Assign(const StatisticVariable& rhs)
+{
+    const HistogramStatisticVariable& histRhs = static_cast<const HistogramStatisticVariable&>(rhs);
+    for (uint32_t i = 0; i < BUCKET_COUNT; ++i) {
+        m_buckets[i] = histRhs.m_buckets[i];
+    }
+    m_count = histRhs.m_count;
+}
+
+void HistogramStatisticVariable::Add(const StatisticVariable& rhs)
+{
+    const HistogramStatisticVariable& histRhs = static_cast<const HistogramStatisticVariable&>(rhs);
+    for (uint32_t i = 0; i < BUCKET_COUNT; ++i) {
+        m_buckets[i] += histRhs.m_buckets[i];
+    }
+    m_count += histRhs.m_count;
+}
+
+void HistogramStatisticVariable::Subtract(const StatisticVariable& rhs)
+{
+    const HistogramStatisticVariable& histRhs = static_cast<const HistogramStatisticVariable&>(rhs);
+    for (uint32_t i = 0; i < BUCKET_COUNT; ++i) {
+        m_buckets[i] -= histRhs.m_buckets[i];
+    }
+    m_count -= histRhs.m_count;
+}
+
+void HistogramStatisticVariable::Divide(uint32_t factor)
+{
+    if (factor > 0) {
+        for (uint32_t i = 0; i < BUCKET_COUNT; ++i) {
+            m_buckets[i] /= factor;
+        }
+        m_count /= factor;
+    }
+}
+
+void HistogramStatisticVariable::Reset()
+{
+    for (uint32_t i = 0; i < BUCKET_COUNT; ++i) {
+        m_buckets[i] = 0;
+    }
+    m_count = 0;
+}
+}  // namespace MOT
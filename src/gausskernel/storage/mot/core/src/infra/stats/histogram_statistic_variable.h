@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * histogram_statistic_variable.h
+ *    A statistic variable for integral types that counts samples in power of two buckets.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/src/infra/stats/histogram_statistic_variable.h
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef HISTOGRAM_STATISTIC_VARIABLE_H
+#define HISTOGRAM_STATISTIC_VARIABLE_H
+
+#include "statistic_variable.h"
+
+namespace MOT {
+/**
+ * @class HistogramStatisticVariable
+ * @brief A statistic variable for integral types. Samples are counted in power of two buckets, such that bucket
+ * zero counts the value zero, and bucket i counts values in the range [2^(i-1), 2^i). The last bucket also counts
+ * all larger values.
+ */
+class HistogramStatisticVariable : public StatisticVariable {
+public:
+    /** @var The number of buckets. */
+    static constexpr uint32_t BUCKET_COUNT = 24;
+
+    /**
+     * @brief Constructor.
+     * @param name Name used for printing.
+     * @param units The unit name to use in display.
+     */
+    explicit HistogramStatisticVariable(const char* name, const char* units = "");
+
+    /** @brief Destructor. */
+    ~HistogramStatisticVariable() override
+    {}
+
+    /**
+     * @brief Summarizes statistics for printing.
+     * @param updateTstamp Ignored.
+     */
+    void Summarize(bool updateTstamp) override;
+
+    /**
+     * @brief Prints statistics to log file using the given log level. Only non-empty buckets are printed.
+     * @param log_levelThe log level to use.
+     */
+    void Print(LogLevel logLevel) const override;
+
+    /**
+     * @brief Copies statistics from another object into this object.
+     * @param rhs The right-hand-side object to copy from.
+     */
+    void Assign(const StatisticVariable& rhs) override;
+
+    /**
+     * @brief Adds statistics of another object to this object.
+     * @param rhs The right-hand-side object to add from.
+     */
+    void Add(const StatisticVariable& rhs) override;
+
+    /**
+     * @brief Subtracts statistics of another object from this object.
+     * @param rhs The right-hand-side subtrahend object.
+     */
+    void Subtract(const StatisticVariable& rhs) override;
+
+    /**
+     * @brief Divides the statistics of this object by a given factor.
+     * @param factor The division factor.
+     */
+    void Divide(uint32_t factor) override;
+
+    /**
+     * @brief Resets all statistic values to zero.
+     */
+    void Reset() override;
+
+    /**
+     * @brief Adds a sample to the statistics.
+     * @param value The sample value
+     */
+    inline void AddSample(uint64_t value)
+    {
+        uint32_t bucket = (value == 0) ? 0 : (64 - __builtin_clzll(value));
+        if (bucket >= BUCKET_COUNT) {
+            bucket = BUCKET_COUNT - 1;
+        }
+        ++m_buckets[bucket];
+        ++m_count;
+    }
+
+private:
+    /** @var The unit name to use in display. */
+    char m_units[STAT_VAR_MAX_NAME_LEN];
+
+    /** @var Sample count per bucket. */
+    uint64_t m_buckets[BUCKET_COUNT];
+
+    /** @var Sample count per bucket saved for printing. */
+    uint64_t m_bucketsSaved[BUCKET_COUNT];
+
+    /** @var Sample count saved for printing. */
+    uint64_t m_countSaved;
+};
+}  // namespace MOT
+
+#endif /* HISTOGRAM_STATISTIC_VARIABLE_H */
@@ -23,7 +23,10 @@
  */
 
 #include "mm_gc_manager.h"
+#include "mm_gc_reclaimer.h"
+#include "mm_global_api.h"
 #include "mot_configuration.h"
+#include "session_context.h"
 
 namespace MOT {
 IMPLEMENT_CLASS_LOGGER(GcManager, GC);
@@ -40,6 +43,15 @@ GcLock g_gcGlobalEpochLock;
 
 GcManager* GcManager::allGcManagers = nullptr;
 
+/** @var Segments of published epochs of all GC managers in the global list */
+GcEpochSlot* g_gcEpochSlotSegments[GC_MAX_EPOCH_SLOT_SEGMENTS];
+
+/** @var Number of epoch slots ever allocated (all of them are scanned when computing the active epoch) */
+volatile uint32_t g_gcEpochSlotCount = 0;
+
+/** @var List of released epoch slots, protected by the global epoch lock */
+static GcEpochSlot* g_gcEpochSlotFreeList = nullptr;
+
 inline GcManager::GcManager(GC_TYPE purpose, int getThreadId, int rcuMaxFreeCount)
     : m_rcuFreeCount(rcuMaxFreeCount), m_tid(getThreadId), m_purpose(purpose)
 {}
@@ -49,19 +61,15 @@ bool GcManager::Initialize()
     bool result = true;
 
     if (m_purpose == GC_MAIN) {
-#ifdef MEM_SESSION_ACTIVE
-        void* limboSpace = MemSessionAlloc(sizeof(LimboGroup));
-#else
-        void* limboSpace = calloc(1, sizeof(LimboGroup));
-#endif
-        if (limboSpace == nullptr) {
+        LimboGroup* limboGroup = AllocLimboGroup();
+        if (limboGroup == nullptr) {
             MOT_REPORT_ERROR(MOT_ERROR_OOM,
                 "Create GC Context",
                 "Failed to allocate %u bytes for limbo group",
                 (unsigned)sizeof(LimboGroup));
             result = false;
         } else {
-            m_limboHead = m_limboTail = new (limboSpace) LimboGroup;
+            m_limboHead = m_limboTail = limboGroup;
             m_limboGroupAllocations = 1;
         }
     } else {
@@ -100,6 +108,10 @@ GcManager* GcManager::Make(GC_TYPE purpose, int threadId, int rcuMaxFreeCount)
         errno_t erc = memset_s(gcBuffer, sizeof(GcManager), 0, sizeof(GcManager));
         securec_check(erc, "\0", "\0");
         gc = new (gcBuffer) GcManager(purpose, threadId, rcuMaxFreeCount);
+        MOTConfiguration& cfg = GetGlobalConfiguration();
+        // limbo groups handed off to a reclamation thread are freed by that thread
+        gc->m_isGlobalLimbo = (cfg.m_gcReclaimThreadsPerNode > 0);
+        gc->m_isHandOffEnabled = (gc->m_isGlobalLimbo && purpose == GC_MAIN);
         if (!gc->Initialize()) {
             MOT_REPORT_ERROR(MOT_ERROR_INTERNAL, "Create GC Context", "Failed to initialize GC context object");
             gc->~GcManager();
@@ -110,18 +122,19 @@ GcManager* GcManager::Make(GC_TYPE purpose, int threadId, int rcuMaxFreeCount)
             free(gcBuffer);
 #endif
         } else {
-            MOTConfiguration& cfg = GetGlobalConfiguration();
             gc->m_isGcEnabled = cfg.m_gcEnable;
             gc->m_limboSizeLimit = (uint32_t)cfg.m_gcReclaimThresholdBytes;
             gc->m_limboSizeLimitHigh = (uint32_t)cfg.m_gcHighReclaimThresholdBytes;
             gc->m_rcuFreeCount = cfg.m_gcReclaimBatchSize;
             if (threadId == 0) {
                 MOT_LOG_INFO(
-                    "GC PARAMS: isGcEnabled = %s, limboSizeLimit = %d, limboSizeLimitHigh = %d, rcuFreeCount = %d",
+                    "GC PARAMS: isGcEnabled = %s, limboSizeLimit = %d, limboSizeLimitHigh = %d, rcuFreeCount = %d, "
+                    "reclaimThreadsPerNode = %u",
                     gc->m_isGcEnabled ? "true" : "false",
                     gc->m_limboSizeLimit,
                     gc->m_limboSizeLimitHigh,
-                    gc->m_rcuFreeCount);
+                    gc->m_rcuFreeCount,
+                    cfg.m_gcReclaimThreadsPerNode);
             }
         }
     }
@@ -258,13 +271,9 @@ void GcManager::CleanIndexItems(uint32_t indexId, bool dropIndex)
 bool GcManager::RefillLimboGroup()
 {
     if (!m_limboTail->m_next) {
-#ifdef MEM_SESSION_ACTIVE
-        void* limboSpace = MemSessionAlloc(sizeof(LimboGroup));
-#else
-        void* limboSpace = calloc(1, sizeof(LimboGroup));
-#endif
-        if (limboSpace != nullptr) {
-            m_limboTail->m_next = new (limboSpace) LimboGroup;
+        LimboGroup* limboGroup = AllocLimboGroup();
+        if (limboGroup != nullptr) {
+            m_limboTail->m_next = limboGroup;
         } else {
             MOT_REPORT_ERROR(MOT_ERROR_OOM,
                 "GC Refill Limbo Group",
@@ -280,6 +289,197 @@ bool GcManager::RefillLimboGroup()
     return true;
 }
 
+LimboGroup* GcManager::AllocLimboGroup()
+{
+    void* limboSpace = nullptr;
+#ifdef MEM_SESSION_ACTIVE
+    if (m_isGlobalLimbo) {
+        limboSpace = MemGlobalAlloc(sizeof(LimboGroup));
+    } else {
+        limboSpace = MemSessionAlloc(sizeof(LimboGroup));
+    }
+#else
+    limboSpace = calloc(1, sizeof(LimboGroup));
+#endif
+    if (limboSpace == nullptr) {
+        return nullptr;
+    }
+    return new (limboSpace) LimboGroup;
+}
+
+void GcManager::FreeLimboGroup(LimboGroup* group)
+{
+#ifdef MEM_SESSION_ACTIVE
+    if (m_isGlobalLimbo) {
+        MemGlobalFree(group);
+    } else {
+        MemSessionFree(group);
+    }
+#else
+    free(group);
+#endif
+}
+
+void GcManager::ApplyCleanIndexBytes()
+{
+    if (m_totalLimboSizeInBytesByCleanIndex) {
+        m_totalLimboSizeInBytes -= m_totalLimboSizeInBytesByCleanIndex;
+        m_totalLimboReclaimedSizeInBytes += m_totalLimboSizeInBytesByCleanIndex;
+        m_totalLimboSizeInBytesByCleanIndex = 0;
+    }
+}
+
+bool GcManager::HandOffLimboGroups()
+{
+    ApplyCleanIndexBytes();
+    if (m_limboHead == m_limboTail && m_limboHead->m_head == m_limboHead->m_tail) {
+        return true;  // nothing to hand off
+    }
+
+    GcReclaimer* reclaimer = GcReclaimer::GetReclaimer(MOTCurrentNumaNodeId, m_tid);
+    if (reclaimer == nullptr) {
+        return false;
+    }
+
+    // make sure a new limbo group is ready before detaching the current ones
+    LimboGroup* spare = m_limboTail->m_next;
+    if (spare == nullptr) {
+        spare = AllocLimboGroup();
+        if (spare == nullptr) {
+            return false;  // reclaim inline instead
+        }
+        m_limboGroupAllocations++;
+    }
+
+    // empty groups are never kept between head and tail
+    uint32_t groups = 1;
+    for (LimboGroup* group = m_limboHead; group != m_limboTail; group = group->m_next) {
+        groups++;
+    }
+
+    LimboGroup* head = m_limboHead;
+    LimboGroup* tail = m_limboTail;
+    tail->m_next = nullptr;
+    if (!reclaimer->HandOff(head, tail, groups, m_totalLimboInuseElements, m_totalLimboSizeInBytes)) {
+        tail->m_next = spare;
+        return false;
+    }
+
+    m_limboHead = m_limboTail = spare;
+    m_limboGroupAllocations -= groups;
+    m_totalLimboInuseElements = 0;
+    m_totalLimboSizeInBytes = 0;
+    m_performGcEpoch = 0;
+    return true;
+}
+
+void GcManager::AdoptLimboGroups(LimboGroup* head, LimboGroup* tail, uint32_t groups, uint32_t elements, uint32_t bytes)
+{
+    m_managerLock.lock();
+    if (m_limboHead == m_limboTail && m_limboHead->m_head == m_limboHead->m_tail) {
+        // keep the empty group (and any spare groups after it) after the adopted ones
+        tail->m_next = m_limboHead;
+        m_limboHead = head;
+    } else {
+        tail->m_next = m_limboTail->m_next;
+        m_limboTail->m_next = head;
+    }
+    m_limboTail = tail;
+    m_limboGroupAllocations += groups;
+    m_totalLimboInuseElements += elements;
+    m_totalLimboSizeInBytes += bytes;
+    m_managerLock.unlock();
+}
+
+uint32_t GcManager::ReclaimAdopted()
+{
+    if (m_totalLimboInuseElements == 0) {
+        return 0;
+    }
+
+    // nobody else advances the epoch when sessions are idle
+    SetGlobalEpoch(GetGlobalEpoch() + 1);
+
+    // objects are reclaimed inside an epoch, since some callbacks access shared structures
+    m_managerLock.lock();
+    ApplyCleanIndexBytes();
+    SetEpoch(GetGlobalEpoch());
+    HardQuiesce(m_totalLimboInuseElements);
+    SetEpoch(0);
+    uint32_t remaining = m_totalLimboInuseElements;
+    if (remaining == 0) {
+        ShrinkMem();
+    }
+    m_managerLock.unlock();
+    return remaining;
+}
+
+bool GcManager::ClearIndexElements(uint32_t indexId, bool dropIndex)
+{
+    g_gcGlobalEpochLock.lock();
+    for (GcManager* gcManager = allGcManagers; gcManager; gcManager = gcManager->Next()) {
+        Prefetch((const void*)gcManager->Next());
+        gcManager->CleanIndexItems(indexId, dropIndex);
+    }
+    g_gcGlobalEpochLock.unlock();
+
+    // limbo groups handed off while the managers were scanned are waiting for the reclamation threads
+    GcReclaimer::ClearIndexElements(indexId, dropIndex);
+    return true;
+}
+
+GcEpochSlot* GcManager::AllocEpochSlot()
+{
+    GcEpochSlot* slot = g_gcEpochSlotFreeList;
+    if (slot != nullptr) {
+        g_gcEpochSlotFreeList = slot->m_nextFree;
+    } else {
+        uint32_t slotId = g_gcEpochSlotCount;
+        uint32_t segmentId = slotId / GC_EPOCH_SLOTS_PER_SEGMENT;
+        if (segmentId >= GC_MAX_EPOCH_SLOT_SEGMENTS) {
+            return nullptr;
+        }
+        if (g_gcEpochSlotSegments[segmentId] == nullptr) {
+            GcEpochSlot* segment = (GcEpochSlot*)calloc(GC_EPOCH_SLOTS_PER_SEGMENT, sizeof(GcEpochSlot));
+            if (segment == nullptr) {
+                MOT_REPORT_ERROR(MOT_ERROR_OOM,
+                    "GC Epoch Slot",
+                    "Failed to allocate %u bytes for epoch slots",
+                    (unsigned)(GC_EPOCH_SLOTS_PER_SEGMENT * sizeof(GcEpochSlot)));
+                return nullptr;
+            }
+            g_gcEpochSlotSegments[segmentId] = segment;
+        }
+        slot = &g_gcEpochSlotSegments[segmentId][slotId % GC_EPOCH_SLOTS_PER_SEGMENT];
+        // the segment must be visible before the slot count that makes it reachable
+        COMPILER_BARRIER;
+        g_gcEpochSlotCount = slotId + 1;
+    }
+    slot->m_epoch = 0;
+    slot->m_nextFree = nullptr;
+    return slot;
+}
+
+void GcManager::FreeEpochSlot(GcEpochSlot* slot)
+{
+    slot->m_epoch = 0;
+    slot->m_nextFree = g_gcEpochSlotFreeList;
+    g_gcEpochSlotFreeList = slot;
+}
+
+void GcManager::DestroyEpochSlots()
+{
+    g_gcGlobalEpochLock.lock();
+    uint32_t segmentCount = (g_gcEpochSlotCount + GC_EPOCH_SLOTS_PER_SEGMENT - 1) / GC_EPOCH_SLOTS_PER_SEGMENT;
+    g_gcEpochSlotCount = 0;
+    g_gcEpochSlotFreeList = nullptr;
+    for (uint32_t i = 0; i < segmentCount; ++i) {
+        free(g_gcEpochSlotSegments[i]);
+        g_gcEpochSlotSegments[i] = nullptr;
+    }
+    g_gcGlobalEpochLock.unlock();
+}
+
 void GcManager::RemoveFromGcList(GcManager* n)
 {
     // When node to be deleted is head node
@@ -289,6 +489,11 @@ void GcManager::RemoveFromGcList(GcManager* n)
     MOT_ASSERT(n != nullptr);
     g_gcGlobalEpochLock.lock();
 
+    if (n->m_epochSlot != nullptr) {
+        FreeEpochSlot(n->m_epochSlot);
+        n->m_epochSlot = nullptr;
+    }
+
     GcManager* head = allGcManagers;
 
     if (head == n) {
@@ -30,9 +30,11 @@
 #include "utilities.h"
 #include "memory_statistics.h"
 #include "mm_session_api.h"
+#include "mot_atomic_ops.h"
 
 namespace MOT {
 class GcManager;
+class GcReclaimer;
 
 typedef uint64_t GcEpochType;
 typedef int64_t GcSignedEpochType;
@@ -49,6 +51,20 @@ inline uint64_t GetGlobalEpoch()
     return g_gcGlobalEpoch;
 }
 
+/**
+ * @struct GcEpochSlot
+ * @brief The published epoch of a single GC manager. Slots are padded to a cache line, so that sessions publishing
+ * their epoch do not interfere with each other, and are never freed while the engine is up, so that the minimum
+ * active epoch can be computed without locking the GC manager list.
+ */
+struct GcEpochSlot {
+    volatile GcEpochType m_epoch;
+
+    GcEpochSlot* m_nextFree;
+
+    uint8_t m_padding[64 - sizeof(GcEpochType) - sizeof(GcEpochSlot*)];
+};
+
 /**
  * @struct LimboGroup
  * @brief Contains capacity elements and handle push/pop operations
@@ -149,11 +165,7 @@ public:
         LimboGroup* next = nullptr;
         while (temp) {
             next = temp->m_next;
-#ifdef MEM_SESSION_ACTIVE
-            MemSessionFree(temp);
-#else
-            free(temp);
-#endif
+            FreeLimboGroup(temp);
             temp = next;
         }
     }
@@ -194,8 +206,16 @@ public:
             return;
         }
         g_gcGlobalEpochLock.lock();
-        m_next = allGcManagers;
-        allGcManagers = this;
+        m_epochSlot = AllocEpochSlot();
+        if (m_epochSlot != nullptr) {
+            m_epochSlot->m_epoch = m_gcEpoch;
+            m_next = allGcManagers;
+            allGcManagers = this;
+        } else {
+            // without a published epoch other sessions might reclaim objects still in use by this session
+            MOT_LOG_WARN("Disabling garbage collection for thread %u: no free epoch slot", (unsigned)m_tid);
+            m_isGcEnabled = false;
+        }
         g_gcGlobalEpochLock.unlock();
     }
 
@@ -231,7 +251,7 @@ public:
     void GcStartTxnMTtests()
     {
         if (m_gcEpoch != GetGlobalEpoch())
-            m_gcEpoch = GetGlobalEpoch();
+            SetEpoch(GetGlobalEpoch());
     }
 
     void GcEndTxnMTtests()
@@ -245,7 +265,7 @@ public:
         if (m_isGcEnabled == true and m_isTxnStarted == false) {
             m_isTxnStarted = true;
             if (m_gcEpoch != GetGlobalEpoch())
-                m_gcEpoch = GetGlobalEpoch();
+                SetEpoch(GetGlobalEpoch());
         }
     }
 
@@ -282,12 +302,21 @@ public:
 
         // Increase Local epoch when the threashold is reached
         if (m_totalLimboSizeInBytes > m_limboSizeLimit) {
-            m_gcEpoch++;
+            SetEpoch(m_gcEpoch + 1);
         }
         // if local epoch is greater then global set the global and calculate minimum
         if (m_gcEpoch > g_gcGlobalEpoch) {
             SetGlobalEpoch(m_gcEpoch);
         }
+
+        // In background mode the limbo groups are handed off to a reclamation thread when the threshold is reached
+        if (m_isHandOffEnabled) {
+            if (m_totalLimboSizeInBytes <= m_limboSizeLimit || HandOffLimboGroups()) {
+                SetEpoch(0);
+                return;
+            }
+        }
+
         // Perform reclamation if possible
         Quiesce();
 
@@ -303,7 +332,7 @@ public:
     {
         if (m_performGcEpoch != g_gcActiveEpoch)
             HardQuiesce(m_rcuFreeCount);
-        m_gcEpoch = 0;
+        SetEpoch(0);
     }
 
     /** @brief Clean all object at the end of the session */
@@ -313,6 +342,17 @@ public:
             return;
         }
         uint32_t inuseElements = m_totalLimboInuseElements;
+        if (m_isHandOffEnabled) {
+            m_managerLock.lock();
+            bool handedOff = HandOffLimboGroups();
+            m_managerLock.unlock();
+            if (handedOff) {
+                MOT_LOG_DEBUG("Entity:%s THD_ID:%d closed session handed off %u elements from limbo!\n",
+                    enGcTypes[m_purpose],
+                    m_tid,
+                    inuseElements);
+            }
+        }
         // Increase the global epoch to insure all elements are from a lower epoch
         while (m_totalLimboSizeInBytes > 0) {
             SetGlobalEpoch(GetGlobalEpoch() + 1);
@@ -339,7 +379,7 @@ public:
         }
 
         // End CP Txn
-        m_gcEpoch = 0;
+        SetEpoch(0);
         m_isTxnStarted = false;
 
         // Increase the global epoch to insure all elements are from a lower epoch
@@ -386,16 +426,15 @@ public:
         MemoryStatisticsProvider::m_provider->AddGCRetiredBytes(objSize);
     }
 
-    /** @brief Try to upgrade the global epoch or let other thread do it   */
+    /**
+     * @brief Try to upgrade the global epoch or let other thread do it. Only the thread that upgraded the global
+     * epoch computes the active epoch. A stale computation can only publish a lower active epoch, which is safe.
+     */
     void SetGlobalEpoch(GcEpochType e)
     {
-        bool rc = g_gcGlobalEpochLock.try_lock();
-        if (rc == true) {
-            if (GcSignedEpochType(e - g_gcGlobalEpoch) > 0) {
-                g_gcGlobalEpoch = e;
-                g_gcActiveEpoch = GcManager::MinActiveEpoch();
-            }
-            g_gcGlobalEpochLock.unlock();
+        GcEpochType globalEpoch = g_gcGlobalEpoch;
+        if (GcSignedEpochType(e - globalEpoch) > 0 && __sync_bool_compare_and_swap(&g_gcGlobalEpoch, globalEpoch, e)) {
+            g_gcActiveEpoch = GcManager::MinActiveEpoch();
         }
     }
 
@@ -412,11 +451,7 @@ public:
             LimboGroup* next = nullptr;
             while (temp) {
                 next = temp->m_next;
-#ifdef MEM_SESSION_ACTIVE
-                MemSessionFree(temp);
-#else
-                free(temp);
-#endif
+                FreeLimboGroup(temp);
                 temp = next;
                 m_limboGroupAllocations--;
             }
@@ -439,13 +474,16 @@ public:
      *  @param indexId Index identifier
      *  @return True for success
      */
-    static inline bool ClearIndexElements(uint32_t indexId, bool dropIndex = true);
+    static bool ClearIndexElements(uint32_t indexId, bool dropIndex = true);
 
     int GetFreeCount() const
     {
         return m_rcuFreeCount;
     }
 
+    /** @brief Frees the epoch slots of all GC managers. Called once during engine shutdown. */
+    static void DestroyEpochSlots();
+
 private:
     /** @var Current snapshot of the global epoch   */
     GcEpochType m_gcEpoch;
@@ -468,6 +506,15 @@ private:
     /** @var Flag to signal if we started a transaction   */
     bool m_isTxnStarted = false;
 
+    /** @var Limbo groups are allocated from global memory, so they can be reclaimed by another thread   */
+    bool m_isGlobalLimbo = false;
+
+    /** @var Flag to signal that limbo groups are handed off to a background reclamation thread   */
+    bool m_isHandOffEnabled = false;
+
+    /** @var The slot in which the current epoch is published (null if not in the global list)   */
+    GcEpochSlot* m_epochSlot = nullptr;
+
     /** @var Next manager in the global list */
     GcManager* m_next = nullptr;
 
@@ -509,6 +556,51 @@ private:
      */
     static inline GcEpochType MinActiveEpoch();
 
+    /** @brief Sets the current epoch and publishes it to other threads   */
+    inline void SetEpoch(GcEpochType epoch)
+    {
+        m_gcEpoch = epoch;
+        if (m_epochSlot != nullptr) {
+            m_epochSlot->m_epoch = epoch;
+        }
+    }
+
+    /** @brief Allocates an epoch slot. Must be called while holding the global epoch lock.   */
+    static GcEpochSlot* AllocEpochSlot();
+
+    /** @brief Releases an epoch slot. Must be called while holding the global epoch lock.   */
+    static void FreeEpochSlot(GcEpochSlot* slot);
+
+    LimboGroup* AllocLimboGroup();
+
+    void FreeLimboGroup(LimboGroup* group);
+
+    /**
+     * @brief Hands off all the limbo groups to the background reclamation thread of the current NUMA node, and
+     * starts a new limbo group. Must be called while holding the manager lock.
+     * @return True if the limbo groups were handed off, or false if there is no reclamation thread to take them.
+     */
+    bool HandOffLimboGroups();
+
+    /** @brief Accounts for the objects reclaimed by index cleanup. Must be called while holding the manager lock. */
+    void ApplyCleanIndexBytes();
+
+    /**
+     * @brief Appends limbo groups handed off by another manager to this manager. Used by reclamation threads.
+     * @param head The first limbo group.
+     * @param tail The last limbo group.
+     * @param groups The number of limbo groups.
+     * @param elements The number of elements in the limbo groups.
+     * @param bytes The total size of the objects in the limbo groups.
+     */
+    void AdoptLimboGroups(LimboGroup* head, LimboGroup* tail, uint32_t groups, uint32_t elements, uint32_t bytes);
+
+    /**
+     * @brief Reclaims all the elements whose epoch allows it. Used by reclamation threads.
+     * @return The number of elements still waiting in limbo.
+     */
+    uint32_t ReclaimAdopted();
+
     inline uint32_t GetOccupiedElements() const
     {
         return m_totalLimboInuseElements;
@@ -528,31 +620,31 @@ private:
     /** @brief Remove all elements of elements of a specific index from all Limbo groups and reclaim them */
     void CleanIndexItems(uint32_t indexId, bool dropIndex);
     friend struct LimboGroup;
+    friend class GcReclaimer;
 
     DECLARE_CLASS_LOGGER()
 };
 
+/** @var The number of epoch slots in a segment. */
+constexpr uint32_t GC_EPOCH_SLOTS_PER_SEGMENT = 256;
+
+/** @var The maximum number of epoch slot segments. */
+constexpr uint32_t GC_MAX_EPOCH_SLOT_SEGMENTS = 512;
+
+extern GcEpochSlot* g_gcEpochSlotSegments[GC_MAX_EPOCH_SLOT_SEGMENTS];
+extern volatile uint32_t g_gcEpochSlotCount;
+
 inline GcEpochType GcManager::MinActiveEpoch()
 {
     GcEpochType ae = g_gcGlobalEpoch;
-    for (GcManager* ti = allGcManagers; ti; ti = ti->Next()) {
-        Prefetch((const void*)ti->Next());
-        GcEpochType te = ti->m_gcEpoch;
+    uint32_t slotCount = g_gcEpochSlotCount;
+    COMPILER_BARRIER;
+    for (uint32_t i = 0; i < slotCount; ++i) {
+        GcEpochType te = g_gcEpochSlotSegments[i / GC_EPOCH_SLOTS_PER_SEGMENT][i % GC_EPOCH_SLOTS_PER_SEGMENT].m_epoch;
         if (te && GcSignedEpochType(te - ae) < 0)
             ae = te;
     }
     return ae;
 }
-
-inline bool GcManager::ClearIndexElements(uint32_t indexId, bool dropIndex)
-{
-    g_gcGlobalEpochLock.lock();
-    for (GcManager* gcManager = allGcManagers; gcManager; gcManager = gcManager->Next()) {
-        Prefetch((const void*)gcManager->Next());
-        gcManager->CleanIndexItems(indexId, dropIndex);
-    }
-    g_gcGlobalEpochLock.unlock();
-    return true;
-}
 }  // namespace MOT
 #endif /* MM_GC_MANAGER */
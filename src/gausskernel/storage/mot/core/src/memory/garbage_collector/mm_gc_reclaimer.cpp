@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * mm_gc_reclaimer.cpp
+ *    Background threads that reclaim the limbo groups handed off by session garbage collectors.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/src/memory/garbage_collector/mm_gc_reclaimer.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include <chrono>
+#include "mm_gc_reclaimer.h"
+#include "affinity.h"
+#include "mot_configuration.h"
+#include "mot_engine.h"
+#include "session_context.h"
+#include "session_manager.h"
+#include "thread_id.h"
+
+namespace MOT {
+IMPLEMENT_CLASS_LOGGER(GcReclaimer, GC);
+
+std::vector<GcReclaimer*> GcReclaimer::m_reclaimers;
+uint32_t GcReclaimer::m_reclaimersPerNode = 0;
+
+GcReclaimer::GcReclaimer(int nodeId, uint32_t reclaimerId)
+    : m_nodeId(nodeId),
+      m_reclaimerId(reclaimerId),
+      m_gcManager(nullptr),
+      m_stop(false),
+      m_accepting(false),
+      m_inboxHead(nullptr),
+      m_inboxTail(nullptr),
+      m_inboxGroups(0),
+      m_inboxElements(0),
+      m_inboxBytes(0)
+{}
+
+bool GcReclaimer::StartAll()
+{
+    MOTConfiguration& cfg = GetGlobalConfiguration();
+    uint32_t nodeCount = cfg.m_numaNodes;
+    uint32_t reclaimersPerNode = cfg.m_gcReclaimThreadsPerNode;
+    if (!m_reclaimers.empty()) {
+        MOT_LOG_WARN("Garbage collection reclaimers already started");
+        return true;
+    }
+
+    m_reclaimers.reserve(nodeCount * reclaimersPerNode);
+    for (uint32_t nodeId = 0; nodeId < nodeCount; ++nodeId) {
+        for (uint32_t i = 0; i < reclaimersPerNode; ++i) {
+            GcReclaimer* reclaimer = new (std::nothrow) GcReclaimer((int)nodeId, (uint32_t)m_reclaimers.size());
+            if (reclaimer == nullptr) {
+                MOT_REPORT_ERROR(MOT_ERROR_OOM,
+                    "Start GC Reclaimers",
+                    "Failed to allocate %u bytes for garbage collection reclaimer",
+                    (unsigned)sizeof(GcReclaimer));
+                StopAll();
+                return false;
+            }
+            m_reclaimers.push_back(reclaimer);
+            reclaimer->m_thread = std::thread(ReclaimerFunc, reclaimer);
+        }
+    }
+    m_reclaimersPerNode = reclaimersPerNode;
+    MOT_LOG_INFO("Started %u garbage collection reclaimers on %u NUMA nodes",
+        (unsigned)m_reclaimers.size(),
+        nodeCount);
+    return true;
+}
+
+void GcReclaimer::StopAll()
+{
+    // reclaimers are not deleted here, since sessions may still hold a pointer to them
+    for (GcReclaimer* reclaimer : m_reclaimers) {
+        reclaimer->Stop();
+    }
+}
+
+void GcReclaimer::DestroyAll()
+{
+    StopAll();
+    m_reclaimersPerNode = 0;
+    for (GcReclaimer* reclaimer : m_reclaimers) {
+        delete reclaimer;
+    }
+    m_reclaimers.clear();
+}
+
+GcReclaimer* GcReclaimer::GetReclaimer(int nodeId, uint32_t ordinal)
+{
+    uint32_t reclaimersPerNode = m_reclaimersPerNode;
+    if (reclaimersPerNode == 0) {
+        return nullptr;
+    }
+    uint32_t nodeCount = (uint32_t)m_reclaimers.size() / reclaimersPerNode;
+    if (nodeId < 0 || (uint32_t)nodeId >= nodeCount) {
+        nodeId = 0;
+    }
+    return m_reclaimers[nodeId * reclaimersPerNode + ordinal % reclaimersPerNode];
+}
+
+void GcReclaimer::ClearIndexElements(uint32_t indexId, bool dropIndex)
+{
+    for (GcReclaimer* reclaimer : m_reclaimers) {
+        std::lock_guard<std::mutex> lock(reclaimer->m_adoptLock);
+        if (reclaimer->m_gcManager != nullptr) {
+            (void)reclaimer->AdoptInbox();
+            reclaimer->m_gcManager->CleanIndexItems(indexId, dropIndex);
+        }
+    }
+}
+
+bool GcReclaimer::HandOff(LimboGroup* head, LimboGroup* tail, uint32_t groups, uint32_t elements, uint32_t bytes)
+{
+    m_inboxLock.lock();
+    if (!m_accepting) {
+        m_inboxLock.unlock();
+        return false;
+    }
+    if (m_inboxHead == nullptr) {
+        m_inboxHead = head;
+    } else {
+        m_inboxTail->m_next = head;
+    }
+    m_inboxTail = tail;
+    m_inboxGroups += groups;
+    m_inboxElements += elements;
+    m_inboxBytes += bytes;
+    m_inboxLock.unlock();
+    return true;
+}
+
+bool GcReclaimer::AdoptInbox()
+{
+    m_inboxLock.lock();
+    LimboGroup* head = m_inboxHead;
+    LimboGroup* tail = m_inboxTail;
+    uint32_t groups = m_inboxGroups;
+    uint32_t elements = m_inboxElements;
+    uint32_t bytes = m_inboxBytes;
+    m_inboxHead = m_inboxTail = nullptr;
+    m_inboxGroups = m_inboxElements = m_inboxBytes = 0;
+    m_inboxLock.unlock();
+
+    if (head == nullptr) {
+        return false;
+    }
+    m_gcManager->AdoptLimboGroups(head, tail, groups, elements, bytes);
+    return true;
+}
+
+void GcReclaimer::Stop()
+{
+    // both flags change together, so no limbo group is handed off after the reclaimer observed the stop request
+    m_inboxLock.lock();
+    m_accepting = false;
+    m_stop = true;
+    m_inboxLock.unlock();
+    {
+        std::lock_guard<std::mutex> lock(m_waitLock);
+    }
+    m_waitCond.notify_one();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+void GcReclaimer::ReclaimerFunc(GcReclaimer* reclaimer)
+{
+    // since this is a non-kernel thread we must set-up our own u_sess struct for the current thread
+    MOT_DECLARE_NON_KERNEL_THREAD();
+
+    MOTEngine* engine = MOTEngine::GetInstance();
+    if (AllocThreadIdNumaHighest(reclaimer->m_nodeId) == INVALID_THREAD_ID) {
+        MOT_LOG_WARN("Failed to allocate thread id on NUMA node %d for garbage collection reclaimer %u",
+            reclaimer->m_nodeId,
+            reclaimer->m_reclaimerId);
+    }
+    SessionContext* sessionContext = GetSessionManager()->CreateSessionContext();
+    if (sessionContext == nullptr) {
+        MOT_LOG_ERROR("Failed to create session context for garbage collection reclaimer %u, limbo groups will be "
+                      "reclaimed by sessions",
+            reclaimer->m_reclaimerId);
+        engine->OnCurrentThreadEnding();
+        return;
+    }
+    if (GetGlobalConfiguration().m_enableNuma && !GetTaskAffinity().SetNodeAffinity(reclaimer->m_nodeId)) {
+        MOT_LOG_WARN("Failed to set affinity of garbage collection reclaimer %u", reclaimer->m_reclaimerId);
+    }
+
+    GcManager* gcManager = sessionContext->GetTxnManager()->GetGcSession();
+    gcManager->m_isHandOffEnabled = false;
+    {
+        std::lock_guard<std::mutex> lock(reclaimer->m_adoptLock);
+        reclaimer->m_gcManager = gcManager;
+    }
+    reclaimer->m_inboxLock.lock();
+    reclaimer->m_accepting = !reclaimer->m_stop;
+    reclaimer->m_inboxLock.unlock();
+    MOT_LOG_DEBUG(
+        "Garbage collection reclaimer %u started on NUMA node %d", reclaimer->m_reclaimerId, reclaimer->m_nodeId);
+
+    bool stop = false;
+    while (!stop) {
+        // one more round after stop, since hand-off is declined from now on
+        reclaimer->m_inboxLock.lock();
+        stop = reclaimer->m_stop;
+        reclaimer->m_inboxLock.unlock();
+        uint32_t pending = 0;
+        {
+            std::lock_guard<std::mutex> lock(reclaimer->m_adoptLock);
+            (void)reclaimer->AdoptInbox();
+            pending = gcManager->ReclaimAdopted();
+        }
+        if (!stop) {
+            std::unique_lock<std::mutex> lock(reclaimer->m_waitLock);
+            (void)reclaimer->m_waitCond.wait_for(lock,
+                std::chrono::microseconds(RECLAIM_INTERVAL_MICROS),
+                [reclaimer]() { return reclaimer->m_stop; });
+        }
+        if (pending > 0) {
+            MOT_LOG_DEBUG("Garbage collection reclaimer %u has %u elements pending", reclaimer->m_reclaimerId, pending);
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(reclaimer->m_adoptLock);
+        reclaimer->m_gcManager = nullptr;
+    }
+
+    // remaining elements are reclaimed inline when the session ends
+    GetSessionManager()->DestroySessionContext(sessionContext);
+    engine->OnCurrentThreadEnding();
+    MOT_LOG_DEBUG("Garbage collection reclaimer %u stopped", reclaimer->m_reclaimerId);
+}
+}  // namespace MOT
@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * mm_gc_reclaimer.h
+ *    Background threads that reclaim the limbo groups handed off by session garbage collectors.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/src/memory/garbage_collector/mm_gc_reclaimer.h
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef MM_GC_RECLAIMER_H
+#define MM_GC_RECLAIMER_H
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "mm_gc_manager.h"
+
+namespace MOT {
+/**
+ * @class GcReclaimer
+ * @brief A background thread that reclaims limbo groups on behalf of sessions. When a session garbage collector
+ * crosses its reclamation threshold, it detaches its limbo groups and hands them off to a reclaimer of its NUMA
+ * node, instead of waiting for the active epoch to advance and invoking the reclamation callbacks inline. The
+ * reclaimer adopts the handed off groups into its own garbage collector, and reclaims them as soon as the epoch
+ * allows it.
+ */
+class GcReclaimer {
+public:
+    /**
+     * @brief Starts the configured number of reclamation threads on each NUMA node.
+     * @return True if all threads were started.
+     */
+    static bool StartAll();
+
+    /**
+     * @brief Stops all reclamation threads. Limbo groups handed off before the call are reclaimed, and further
+     * hand-off requests are declined, so sessions fall back to inline reclamation.
+     */
+    static void StopAll();
+
+    /** @brief Releases all reclaimer objects. Called during engine shutdown, after all sessions ended. */
+    static void DestroyAll();
+
+    /**
+     * @brief Retrieves the reclaimer serving a session.
+     * @param nodeId The NUMA node of the session.
+     * @param ordinal A value used to spread sessions among the reclaimers of a node.
+     * @return The reclaimer, or null if no reclaimer is accepting limbo groups.
+     */
+    static GcReclaimer* GetReclaimer(int nodeId, uint32_t ordinal);
+
+    /**
+     * @brief Removes all the elements of an index from the limbo groups handed off to all reclaimers.
+     * @param indexId The index identifier.
+     * @param dropIndex Specifies whether the index is being dropped.
+     */
+    static void ClearIndexElements(uint32_t indexId, bool dropIndex);
+
+    /**
+     * @brief Hands off a chain of limbo groups.
+     * @param head The first limbo group.
+     * @param tail The last limbo group.
+     * @param groups The number of limbo groups.
+     * @param elements The number of elements in the limbo groups.
+     * @param bytes The total size of the objects in the limbo groups.
+     * @return True if the limbo groups were accepted, or false if the reclaimer is stopping.
+     */
+    bool HandOff(LimboGroup* head, LimboGroup* tail, uint32_t groups, uint32_t elements, uint32_t bytes);
+
+private:
+    GcReclaimer(int nodeId, uint32_t reclaimerId);
+
+    ~GcReclaimer()
+    {}
+
+    /**
+     * @brief Moves the limbo groups in the inbox to the garbage collector of the reclaimer.
+     * @return True if any limbo groups were moved.
+     */
+    bool AdoptInbox();
+
+    void Stop();
+
+    static void ReclaimerFunc(GcReclaimer* reclaimer);
+
+    /** @var The interval between reclamation rounds in microseconds. */
+    static constexpr uint64_t RECLAIM_INTERVAL_MICROS = 1000;
+
+    /** @var All reclaimers, ordered by node. */
+    static std::vector<GcReclaimer*> m_reclaimers;
+
+    /** @var The number of reclaimers per NUMA node. */
+    static uint32_t m_reclaimersPerNode;
+
+    int m_nodeId;
+
+    uint32_t m_reclaimerId;
+
+    std::thread m_thread;
+
+    /** @var The garbage collector of the reclaimer session. Valid only while the thread is running. */
+    GcManager* m_gcManager;
+
+    /** @var Serializes index cleanup by session threads with adoption by the reclaimer thread. */
+    std::mutex m_adoptLock;
+
+    std::mutex m_waitLock;
+
+    std::condition_variable m_waitCond;
+
+    volatile bool m_stop;
+
+    /** @var Protects the inbox. Taken by sessions, so it must be short. */
+    GcLock m_inboxLock;
+
+    bool m_accepting;
+
+    LimboGroup* m_inboxHead;
+
+    LimboGroup* m_inboxTail;
+
+    uint32_t m_inboxGroups;
+
+    uint32_t m_inboxElements;
+
+    uint32_t m_inboxBytes;
+
+    DECLARE_CLASS_LOGGER()
+};
+}  // namespace MOT
+
+#endif /* MM_GC_RECLAIMER_H */
@@ -39,6 +39,8 @@
 namespace MOT {
 DECLARE_LOGGER(MemoryStatistics, Memory)
 
+constexpr uint64_t MemoryThreadStatistics::PERCENT;
+
 DetailedMemoryThreadStatistics::DetailedMemoryThreadStatistics(uint64_t threadId, void* inplaceBuffer)
     : ThreadStatistics(threadId, inplaceBuffer),
       m_globalBytesRequested(MakeName("global-bytes-requested", threadId).c_str(), MEGA_BYTE, "MB"),
@@ -141,7 +143,8 @@ MemoryThreadStatistics::MemoryThreadStatistics(uint64_t threadId, void* inplaceB
       m_freeTime(MakeName("free-time", threadId).c_str(), 1, "nanos"),
       m_gcRetiredBytes(MakeName("gc-retired-bytes", threadId).c_str(), MEGA_BYTE, "MB"),
       m_gcReclaimedBytes(MakeName("gc-reclaimed-bytes", threadId).c_str(), MEGA_BYTE, "MB"),
-      m_masstreeBytesUsed(MakeName("masstree-bytes-used", threadId).c_str(), MEGA_BYTE, "MB")
+      m_masstreeBytesUsed(MakeName("masstree-bytes-used", threadId).c_str(), MEGA_BYTE, "MB"),
+      m_remoteRowAccess(MakeName("remote-row-access", threadId).c_str(), 1, "%")
 {
     // register all statistic variables
     RegisterStatistics(&m_globalChunksUsed);
@@ -155,6 +158,7 @@ MemoryThreadStatistics::MemoryThreadStatistics(uint64_t threadId, void* inplaceB
     RegisterStatistics(&m_gcRetiredBytes);
     RegisterStatistics(&m_gcReclaimedBytes);
     RegisterStatistics(&m_masstreeBytesUsed);
+    RegisterStatistics(&m_remoteRowAccess);
 }
 
 MemoryGlobalStatistics::MemoryGlobalStatistics(GlobalStatistics::NamingScheme namingScheme)
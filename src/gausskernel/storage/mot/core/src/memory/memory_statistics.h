@@ -223,7 +223,16 @@ public:
         m_masstreeBytesUsed.AddSample(bytes);
     }
 
+    /** @brief Updates the statistics for accesses to rows of tables placed on a NUMA node. */
+    inline void AddPlacedRowAccess(bool remote)
+    {
+        m_remoteRowAccess.AddSample(remote ? PERCENT : 0);
+    }
+
 private:
+    /** @var Sample value of a remote access, so the average is the percentage of remote accesses. */
+    static constexpr uint64_t PERCENT = 100;
+
     // global/local chunks
     MemoryStatisticVariable m_globalChunksUsed;
     MemoryStatisticVariable m_localChunksUsed;
@@ -248,6 +257,9 @@ private:
 
     // masstree statistics
     MemoryStatisticVariable m_masstreeBytesUsed;
+
+    // accesses from another NUMA node to rows of placed tables
+    NumericStatisticVariable m_remoteRowAccess;
 };
 
 class MemoryGlobalStatistics : public GlobalStatistics {
@@ -618,6 +630,18 @@ public:
         }
     }
 
+    /**
+     * @brief Updates the statistics for accesses to rows of tables placed on a NUMA node.
+     * @param remote Specifies whether the row is placed on another NUMA node than the accessing thread.
+     */
+    inline void AddPlacedRowAccess(bool remote)
+    {
+        MemoryThreadStatistics* mts = GetCurrentThreadStatistics<MemoryThreadStatistics>();
+        if (mts) {
+            mts->AddPlacedRowAccess(remote);
+        }
+    }
+
     /**
      * @brief Derives classes should react to a notification that configuration changed. New
      * configuration is accessible via the ConfigManager.
@@ -138,7 +138,7 @@ class GlobalObjPool : public ObjAllocInterface {
 public:
     ThreadAOP m_threadAOP[MAX_THREAD_COUNT];
 
-    GlobalObjPool(uint16_t sz, uint8_t align) : ObjAllocInterface(true)
+    GlobalObjPool(uint16_t sz, uint8_t align, int node = -1) : ObjAllocInterface(true, node)
     {
         m_objList = nullptr;
         m_nextFree = nullptr;
@@ -296,6 +296,124 @@ public:
     }
 };
 
+/**
+ * @class PartitionedObjPool
+ * @brief Global object pool that keeps a separate global pool on each NUMA node. Objects are released to the
+ * pool of the node from which they were allocated.
+ */
+class PartitionedObjPool : public ObjAllocInterface {
+public:
+    PartitionedObjPool(uint16_t sz, uint8_t align, int nodeCount)
+        : ObjAllocInterface(true), m_sz(sz), m_align(align), m_nodeCount(nodeCount)
+    {
+        m_objList = nullptr;
+        m_nextFree = nullptr;
+        m_size = ALIGN_N(sz + OBJ_INDEX_SIZE, align);
+        m_oixOffset = m_size - 1;
+        m_type = ObjAllocInterface::CalcBufferClass(sz);
+        errno_t erc = memset_s(m_nodePools, sizeof(m_nodePools), 0, sizeof(m_nodePools));
+        securec_check(erc, "\0", "\0");
+    };
+
+    ~PartitionedObjPool() override
+    {
+        for (int i = 0; i < m_nodeCount; i++) {
+            ObjAllocInterface* pool = m_nodePools[i];
+            ObjAllocInterface::FreeObjPool(&pool);
+        }
+    };
+
+    bool Initialize() override
+    {
+        for (int i = 0; i < m_nodeCount; i++) {
+            m_nodePools[i] = new (std::nothrow) GlobalObjPool(m_sz, m_align, i);
+            if (m_nodePools[i] == nullptr) {
+                MOT_REPORT_ERROR(MOT_ERROR_OOM, "N/A", "Failed to allocate object pool of NUMA node %d", i);
+                return false;
+            }
+            // memory de-allocated when object is destroyed (see ~PartitionedObjPool())
+            if (!m_nodePools[i]->Initialize()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /** @brief Allocates an object on the NUMA node of the current thread. */
+    inline void* Alloc() override
+    {
+        int node = MOTCurrentNumaNodeId;
+        if (node < 0 || node >= m_nodeCount) {
+            node = 0;
+        }
+        return m_nodePools[node]->Alloc();
+    }
+
+    /** @brief Allocates an object on the specified NUMA node. */
+    inline void* AllocOnNode(int node)
+    {
+        MOT_ASSERT(node >= 0 && node < m_nodeCount);
+        return m_nodePools[node]->Alloc();
+    }
+
+    inline void Release(void* ptr) override
+    {
+        GetOwner(ptr)->Release(ptr);
+    }
+
+    /** @brief Retrieves the NUMA node on which an object of this pool was allocated. */
+    inline int GetNode(void* ptr) const
+    {
+        return GetOwner(ptr)->m_node;
+    }
+
+    inline int GetNodeCount() const
+    {
+        return m_nodeCount;
+    }
+
+    void ClearThreadCache() override
+    {
+        for (int i = 0; i < m_nodeCount; i++) {
+            m_nodePools[i]->ClearThreadCache();
+        }
+    }
+
+    void ClearFreeCache() override
+    {
+        for (int i = 0; i < m_nodeCount; i++) {
+            m_nodePools[i]->ClearFreeCache();
+        }
+    }
+
+    /** @brief Accumulates the statistics of the pools of all the nodes, this pool holds no objects itself. */
+    void GetStats(PoolStatsSt& stats) override
+    {
+        for (int i = 0; i < m_nodeCount; i++) {
+            m_nodePools[i]->GetStats(stats);
+        }
+    }
+
+private:
+    /** @brief Retrieves the per-node pool owning an object, by the same lookup used to release it. */
+    inline ObjAllocInterface* GetOwner(void* ptr) const
+    {
+        uint8_t* p = (uint8_t*)ptr;
+        uint8_t oix = p[m_oixOffset];
+        if (oix == NOT_VALID) {
+            // let the owner of any node report the double free
+            return m_nodePools[0];
+        }
+        ObjPool* op = (ObjPool*)(p - sizeof(ObjPool) - oix * m_size);
+        return op->m_parent;
+    }
+
+    uint16_t m_sz;
+    uint8_t m_align;
+    int m_nodeCount;
+    GlobalObjPool* m_nodePools[MEM_MAX_NUMA_NODES];
+};
+
 #define SLUB_MAX_BIN 15  // up to 32KB
 #define SLUB_MIN_BIN 3
 
@@ -24,6 +24,7 @@
 
 #include "object_pool_impl.h"
 #include "object_pool.h"
+#include "mm_cfg.h"
 
 namespace MOT {
 IMPLEMENT_CLASS_LOGGER(ObjAllocInterface, Memory)
@@ -44,13 +45,13 @@ ObjPoolPtr& ObjPoolPtr::operator=(ObjPool* right)
     return *this;
 }
 
-ObjAllocInterface* ObjAllocInterface::GetObjPool(uint16_t size, bool local, uint8_t align)
+ObjAllocInterface* ObjAllocInterface::GetObjPool(uint16_t size, bool local, uint8_t align, int node)
 {
     ObjAllocInterface* result = NULL;
     if (local) {
         result = new (std::nothrow) LocalObjPool(size, align);
     } else {
-        result = new (std::nothrow) GlobalObjPool(size, align);
+        result = new (std::nothrow) GlobalObjPool(size, align, node);
     }
 
     if (result == NULL) {
@@ -69,6 +70,21 @@ ObjAllocInterface* ObjAllocInterface::GetObjPool(uint16_t size, bool local, uint
     return result;
 }
 
+ObjAllocInterface* ObjAllocInterface::GetPartitionedObjPool(uint16_t size, uint8_t align)
+{
+    ObjAllocInterface* result = new (std::nothrow) PartitionedObjPool(size, align, (int)g_memGlobalCfg.m_nodeCount);
+    if (result == NULL) {
+        MOT_REPORT_ERROR(
+            MOT_ERROR_OOM, "Allocate Object Pool", "Failed to allocate memory for partitioned object pool");
+    } else if (!result->Initialize()) {
+        MOT_REPORT_ERROR(
+            MOT_ERROR_INTERNAL, "Allocate Object Pool", "Failed to pre-allocate memory for partitioned object pool");
+        delete result;
+        result = NULL;
+    }
+    return result;
+}
+
 void ObjAllocInterface::FreeObjPool(ObjAllocInterface** pool)
 {
     if (pool != NULL && *pool != NULL) {
@@ -312,10 +312,14 @@ public:
     MemBufferClass m_type;
     bool m_global;
 
-    static ObjAllocInterface* GetObjPool(uint16_t size, bool local, uint8_t align = 8);
+    /** @var The NUMA node from which global pool buffers are allocated, or -1 for the node of the current thread. */
+    int m_node;
+
+    static ObjAllocInterface* GetObjPool(uint16_t size, bool local, uint8_t align = 8, int node = -1);
+    static ObjAllocInterface* GetPartitionedObjPool(uint16_t size, uint8_t align = 8);
     static void FreeObjPool(ObjAllocInterface** pool);
 
-    explicit ObjAllocInterface(bool isGlobal) : m_global(isGlobal)
+    explicit ObjAllocInterface(bool isGlobal, int node = -1) : m_global(isGlobal), m_node(node)
     {}
 
     virtual ~ObjAllocInterface();
@@ -348,7 +352,7 @@ public:
     virtual void ClearThreadCache() = 0;
     virtual void ClearFreeCache() = 0;
 
-    void GetStats(PoolStatsSt& stats);
+    virtual void GetStats(PoolStatsSt& stats);
     void PrintStats(PoolStatsSt& stats, const char* prefix = "", LogLevel level = LogLevel::LL_DEBUG);
     void Print(const char* prefix, LogLevel level = LogLevel::LL_DEBUG);
 
@@ -468,7 +472,7 @@ public:
         void* p;
 
         if (global == true) {
-            p = MemBufferAllocGlobal(type);
+            p = (app->m_node < 0) ? MemBufferAllocGlobal(type) : MemBufferAllocGlobalOnNode(type, app->m_node);
         } else {
 #ifdef MEM_SESSION_ACTIVE
             uint32_t bufferSize = 1024 * MemBufferClassToSizeKb(type);
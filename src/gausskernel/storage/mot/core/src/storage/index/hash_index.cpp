@@ -0,0 +1,765 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * hash_index.cpp
+ *    Concurrent resizable hash index implementation.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/src/storage/index/hash_index.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include <algorithm>
+
+#include "hash_index.h"
+#include "mot_engine.h"
+
+namespace MOT {
+IMPLEMENT_CLASS_LOGGER(HashPrimaryIndex, Storage);
+
+/** @struct Unaligned 64 bit word, key buffers are not necessarily aligned. */
+struct __attribute__((__packed__)) UnalignedWord {
+    uint64_t m_value;
+};
+
+static inline uint64_t MixHash(uint64_t value)
+{
+    // 64 bit finalizer of MurmurHash3
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdULL;
+    value ^= value >> 33;
+    value *= 0xc4ceb9fe1a85ec53ULL;
+    value ^= value >> 33;
+    return value;
+}
+
+uint64_t HashPrimaryIndex::HashKey(const uint8_t* buf, uint32_t len)
+{
+    const uint64_t multiplier = 0x9e3779b97f4a7c15ULL;
+    uint64_t hash = len * multiplier;
+    uint32_t pos = 0;
+
+    for (; pos + sizeof(uint64_t) <= len; pos += sizeof(uint64_t)) {
+        hash = (hash ^ MixHash(reinterpret_cast<const UnalignedWord*>(buf + pos)->m_value)) * multiplier;
+    }
+
+    if (pos < len) {
+        uint64_t tail = 0;
+        for (uint32_t i = 0; pos + i < len; i++) {
+            tail |= ((uint64_t)buf[pos + i]) << (i * 8);
+        }
+        hash = (hash ^ MixHash(tail)) * multiplier;
+    }
+
+    return MixHash(hash);
+}
+
+bool HashPrimaryIndex::InitPools()
+{
+    m_nodeSize = sizeof(HashNode) + ALIGN8(m_keyLength);
+    m_nodePool = ObjAllocInterface::GetObjPool(m_nodeSize, false, CACHE_LINE_SIZE);
+    if (!m_nodePool) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Initialize Index", "Failed to create hash entry pool");
+        return false;
+    }
+
+    return true;
+}
+
+void HashPrimaryIndex::DestroyPools()
+{
+    if (m_nodePool) {
+        ObjAllocInterface::FreeObjPool(&m_nodePool);
+        m_nodePool = NULL;
+    }
+}
+
+void HashPrimaryIndex::DestroyGroupTables(HashTable* table)
+{
+    // a group moved to a newer array shares its nested array with its copy, so moved buckets are skipped
+    for (uint64_t i = 0; i < table->m_bucketCount; i++) {
+        HashNode* node = table->m_buckets[i].m_head.load(std::memory_order_relaxed);
+        if (IsMoved(node)) {
+            continue;
+        }
+        for (; node != nullptr; node = node->m_next.load(std::memory_order_relaxed)) {
+            MemGlobalFree(node->m_group.load(std::memory_order_relaxed));
+        }
+    }
+}
+
+void HashPrimaryIndex::DestroyTables()
+{
+    // entries are released with their pool, only the bucket arrays are left
+    HashTable* table = m_table.load(std::memory_order_relaxed);
+    while (table != nullptr) {
+        HashTable* next = table->m_next.load(std::memory_order_relaxed);
+        if (!m_unique) {
+            DestroyGroupTables(table);
+        }
+        MemGlobalFree(table);
+        table = next;
+    }
+    m_table.store(nullptr, std::memory_order_relaxed);
+    m_count.store(0, std::memory_order_relaxed);
+    m_chainCount.store(0, std::memory_order_relaxed);
+    m_groupTableSize.store(0, std::memory_order_relaxed);
+    m_migrated = 0;
+}
+
+HashPrimaryIndex::HashTable* HashPrimaryIndex::AllocTable(uint64_t bucketCount)
+{
+    HashTable* table = (HashTable*)MemGlobalAllocAligned(GetTableSize(bucketCount), CACHE_LINE_SIZE);
+    if (table == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM,
+            "Hash Index",
+            "Failed to allocate %" PRIu64 " buckets for index %s",
+            bucketCount,
+            m_name.c_str());
+        return nullptr;
+    }
+
+    table->m_bucketCount = bucketCount;
+    table->m_next.store(nullptr, std::memory_order_relaxed);
+    table->m_entryCount = 0;
+    for (uint64_t i = 0; i < bucketCount; i++) {
+        HashBucket* bucket = new (&table->m_buckets[i]) HashBucket();
+        bucket->m_head.store(nullptr, std::memory_order_relaxed);
+    }
+
+    return table;
+}
+
+RC HashPrimaryIndex::IndexInitImpl(void** args)
+{
+    if (!InitPools()) {
+        DestroyPools();
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Initialize Index", "Failed to initialize hash index pools");
+        return RC_MEMORY_ALLOCATION_ERROR;
+    }
+
+    HashTable* table = AllocTable(INITIAL_BUCKET_COUNT);
+    if (table == nullptr) {
+        DestroyPools();
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Initialize Index", "Failed to initialize hash index buckets");
+        return RC_MEMORY_ALLOCATION_ERROR;
+    }
+
+    m_table.store(table, std::memory_order_release);
+    m_count.store(0, std::memory_order_relaxed);
+    m_chainCount.store(0, std::memory_order_relaxed);
+    m_groupTableSize.store(0, std::memory_order_relaxed);
+    m_migrated = 0;
+    m_initialized = true;
+    return RC_OK;
+}
+
+HashPrimaryIndex::HashNode* HashPrimaryIndex::GetChain(HashTable* table, uint64_t hash) const
+{
+    for (;;) {
+        HashNode* head = table->m_buckets[hash & (table->m_bucketCount - 1)].m_head.load(std::memory_order_acquire);
+        if (!IsMoved(head)) {
+            return head;
+        }
+        // a bucket is marked as moved only after the next array is published
+        table = table->m_next.load(std::memory_order_acquire);
+    }
+}
+
+HashPrimaryIndex::HashBucket* HashPrimaryIndex::LockBucket(uint64_t hash)
+{
+    HashTable* table = m_table.load(std::memory_order_acquire);
+    for (;;) {
+        HashBucket* bucket = &table->m_buckets[hash & (table->m_bucketCount - 1)];
+        bucket->m_lock.lock();
+        if (!IsMoved(bucket->m_head.load(std::memory_order_relaxed))) {
+            return bucket;
+        }
+        bucket->m_lock.unlock();
+        table = table->m_next.load(std::memory_order_acquire);
+    }
+}
+
+void HashPrimaryIndex::RetireNode(HashNode* node)
+{
+    GcManager* gcSession = MOTEngine::GetInstance()->GetCurrentGcSession();
+    MOT_ASSERT(gcSession != nullptr);
+    gcSession->GcRecordObject(GetIndexId(), (void*)m_nodePool, node, DeallocateNodeCallBack, m_nodePool->m_size);
+}
+
+void HashPrimaryIndex::RetireTable(HashTable* table)
+{
+    GcManager* gcSession = MOTEngine::GetInstance()->GetCurrentGcSession();
+    MOT_ASSERT(gcSession != nullptr);
+    gcSession->GcRecordObject(
+        GetIndexId(), nullptr, table, DeallocateTableCallBack, GetTableGcSize(table->m_bucketCount));
+}
+
+HashPrimaryIndex::HashNode* HashPrimaryIndex::AllocNode(const uint8_t* keyBuf, Sentinel* sentinel, uint64_t hash)
+{
+    HashNode* node = (HashNode*)m_nodePool->Alloc();
+    if (node == nullptr) {
+        return nullptr;
+    }
+
+    node->m_next.store(nullptr, std::memory_order_relaxed);
+    node->m_sentinel = sentinel;
+    node->m_hash = hash;
+    node->m_group.store(nullptr, std::memory_order_relaxed);
+    errno_t erc = memcpy_s(node->m_keyBuf, ALIGN8(m_keyLength), keyBuf, m_keyLength);
+    securec_check(erc, "\0", "\0");
+    return node;
+}
+
+HashPrimaryIndex::HashNode* HashPrimaryIndex::FindChainNode(
+    HashNode* head, uint64_t hash, const uint8_t* keyBuf) const
+{
+    for (HashNode* node = head; node != nullptr; node = node->m_next.load(std::memory_order_acquire)) {
+        if (node->m_hash == hash && KeyPrefixEquals(node, keyBuf)) {
+            return node;
+        }
+    }
+    return nullptr;
+}
+
+HashPrimaryIndex::HashNode* HashPrimaryIndex::FindGroupEntry(
+    HashTable* groupTable, uint64_t hash, const uint8_t* keyBuf) const
+{
+    HashNode* node = groupTable->m_buckets[hash & (groupTable->m_bucketCount - 1)].m_head.load(
+        std::memory_order_acquire);
+    for (; node != nullptr; node = node->m_next.load(std::memory_order_acquire)) {
+        if (node->m_hash == hash && KeyEquals(node, keyBuf)) {
+            return node;
+        }
+    }
+    return nullptr;
+}
+
+void HashPrimaryIndex::AddGroupEntry(HashNode* group, HashNode* node)
+{
+    HashTable* groupTable = group->m_group.load(std::memory_order_relaxed);
+    HashBucket* bucket = &groupTable->m_buckets[node->m_hash & (groupTable->m_bucketCount - 1)];
+    node->m_next.store(bucket->m_head.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    bucket->m_head.store(node, std::memory_order_release);
+    if (++groupTable->m_entryCount > groupTable->m_bucketCount * MAX_LOAD_FACTOR) {
+        GrowGroup(group);
+    }
+}
+
+void HashPrimaryIndex::GrowGroup(HashNode* group)
+{
+    HashTable* groupTable = group->m_group.load(std::memory_order_relaxed);
+    HashTable* next = AllocTable(groupTable->m_bucketCount * 2);
+    if (next == nullptr) {
+        // keep going with longer chains, the next insert into the group retries
+        return;
+    }
+
+    // Readers may still walk the old array, so its entries are copied and the old ones retired afterwards.
+    // Copying a whole group at once costs as much as the inserts that filled it, so inserts stay constant time.
+    for (uint64_t i = 0; i < groupTable->m_bucketCount; i++) {
+        HashNode* node = groupTable->m_buckets[i].m_head.load(std::memory_order_relaxed);
+        for (; node != nullptr; node = node->m_next.load(std::memory_order_relaxed)) {
+            HashNode* copy = (HashNode*)m_nodePool->Alloc();
+            if (copy == nullptr) {
+                for (uint64_t j = 0; j < next->m_bucketCount; j++) {
+                    HashNode* done = next->m_buckets[j].m_head.load(std::memory_order_relaxed);
+                    while (done != nullptr) {
+                        HashNode* released = done;
+                        done = done->m_next.load(std::memory_order_relaxed);
+                        m_nodePool->Release(released);
+                    }
+                }
+                MemGlobalFree(next);
+                MOT_LOG_WARN("Failed to resize hash index %s group: out of memory, will retry later", m_name.c_str());
+                return;
+            }
+            errno_t erc = memcpy_s(copy, m_nodeSize, node, m_nodeSize);
+            securec_check(erc, "\0", "\0");
+            HashBucket* bucket = &next->m_buckets[copy->m_hash & (next->m_bucketCount - 1)];
+            copy->m_next.store(bucket->m_head.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            bucket->m_head.store(copy, std::memory_order_relaxed);
+        }
+    }
+    next->m_entryCount = groupTable->m_entryCount;
+    group->m_group.store(next, std::memory_order_release);
+    m_groupTableSize.fetch_add(
+        GetTableSize(next->m_bucketCount) - GetTableSize(groupTable->m_bucketCount), std::memory_order_relaxed);
+
+    for (uint64_t i = 0; i < groupTable->m_bucketCount; i++) {
+        HashNode* node = groupTable->m_buckets[i].m_head.load(std::memory_order_relaxed);
+        while (node != nullptr) {
+            HashNode* retired = node;
+            node = node->m_next.load(std::memory_order_relaxed);
+            RetireNode(retired);
+        }
+    }
+    RetireTable(groupTable);
+}
+
+bool HashPrimaryIndex::MigrateBucket(HashTable* table, uint64_t bucket)
+{
+    HashTable* next = table->m_next.load(std::memory_order_relaxed);
+    HashBucket* oldBucket = &table->m_buckets[bucket];
+    HashNode* copies[2] = {nullptr, nullptr};
+    bool result = true;
+
+    // Writers of the old bucket wait here until it is marked as moved, after which they go to the next array.
+    // Readers may still walk the old chain, so it is left untouched and only retired afterwards.
+    oldBucket->m_lock.lock();
+    HashNode* head = oldBucket->m_head.load(std::memory_order_relaxed);
+    for (HashNode* node = head; node != nullptr; node = node->m_next.load(std::memory_order_relaxed)) {
+        HashNode* copy = (HashNode*)m_nodePool->Alloc();
+        if (copy == nullptr) {
+            result = false;
+            break;
+        }
+        errno_t erc = memcpy_s(copy, m_nodeSize, node, m_nodeSize);
+        securec_check(erc, "\0", "\0");
+        // an old bucket splits into the buckets of the same index and of the index plus the old bucket count
+        int half = ((node->m_hash & table->m_bucketCount) != 0) ? 1 : 0;
+        copy->m_next.store(copies[half], std::memory_order_relaxed);
+        copies[half] = copy;
+    }
+
+    if (!result) {
+        oldBucket->m_lock.unlock();
+        for (int half = 0; half < 2; half++) {
+            while (copies[half] != nullptr) {
+                HashNode* copy = copies[half];
+                copies[half] = copy->m_next.load(std::memory_order_relaxed);
+                m_nodePool->Release(copy);
+            }
+        }
+        MOT_LOG_WARN("Failed to resize hash index %s: out of memory, will retry later", m_name.c_str());
+        return false;
+    }
+
+    for (int half = 0; half < 2; half++) {
+        if (copies[half] != nullptr) {
+            // nobody writes to the new bucket before the old one is marked as moved
+            HashBucket* newBucket = &next->m_buckets[bucket + half * table->m_bucketCount];
+            MOT_ASSERT(newBucket->m_head.load(std::memory_order_relaxed) == nullptr);
+            newBucket->m_head.store(copies[half], std::memory_order_release);
+        }
+    }
+    oldBucket->m_head.store((HashNode*)((uintptr_t)head | BUCKET_MOVED), std::memory_order_release);
+    oldBucket->m_lock.unlock();
+
+    while (head != nullptr) {
+        HashNode* node = head;
+        head = node->m_next.load(std::memory_order_relaxed);
+        RetireNode(node);
+    }
+
+    return true;
+}
+
+void HashPrimaryIndex::Grow()
+{
+    if (!m_resizeLock.try_lock()) {
+        return;  // somebody else is resizing
+    }
+
+    HashTable* table = m_table.load(std::memory_order_acquire);
+    HashTable* next = table->m_next.load(std::memory_order_relaxed);
+    if (next == nullptr) {
+        if (m_chainCount.load(std::memory_order_relaxed) <= table->m_bucketCount * MAX_LOAD_FACTOR) {
+            m_resizeLock.unlock();
+            return;
+        }
+
+        next = AllocTable(table->m_bucketCount * 2);
+        if (next == nullptr) {
+            // keep going with longer chains, the next insert retries
+            m_resizeLock.unlock();
+            return;
+        }
+        MOT_LOG_DEBUG("Resizing hash index %s to %" PRIu64 " buckets", m_name.c_str(), next->m_bucketCount);
+        m_migrated = 0;
+        table->m_next.store(next, std::memory_order_release);
+    }
+
+    uint64_t end = std::min(m_migrated + MIGRATE_BATCH_SIZE, table->m_bucketCount);
+    while (m_migrated < end && MigrateBucket(table, m_migrated)) {
+        m_migrated++;
+    }
+
+    if (m_migrated == table->m_bucketCount) {
+        // all buckets moved, nobody can get to the old array any more once its epoch is over
+        m_table.store(next, std::memory_order_release);
+        m_migrated = 0;
+        RetireTable(table);
+    }
+
+    m_resizeLock.unlock();
+}
+
+Sentinel* HashPrimaryIndex::IndexInsertImpl(const Key* key, Sentinel* sentinel, bool& inserted, uint32_t pid)
+{
+    const uint8_t* keyBuf = key->GetKeyBuf();
+    uint64_t hash = HashKey(keyBuf, GetKeySizeNoSuffix());
+    inserted = false;
+
+    // allocate before locking, the entry is released if the key already exists
+    HashNode* newNode = AllocNode(keyBuf, sentinel, m_unique ? hash : HashKey(keyBuf, m_keyLength));
+    if (newNode == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Index Insert", "Failed to allocate hash entry for index %s", m_name.c_str());
+        return nullptr;
+    }
+
+    HashBucket* bucket = LockBucket(hash);
+    HashNode* head = bucket->m_head.load(std::memory_order_relaxed);
+    HashNode* node = FindChainNode(head, hash, keyBuf);
+    if (!m_unique && node != nullptr) {
+        HashNode* group = node;
+        node = FindGroupEntry(group->m_group.load(std::memory_order_relaxed), newNode->m_hash, keyBuf);
+        if (node == nullptr) {
+            AddGroupEntry(group, newNode);
+            bucket->m_lock.unlock();
+            inserted = true;
+            m_count.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+    }
+    if (node != nullptr) {
+        bucket->m_lock.unlock();
+        m_nodePool->Release(newNode);
+        return node->m_sentinel;
+    }
+
+    HashNode* chainNode = newNode;
+    if (!m_unique) {
+        // first entry of the key, its group is filled before being published to readers
+        chainNode = AllocNode(keyBuf, nullptr, hash);
+        HashTable* groupTable = (chainNode != nullptr) ? AllocTable(GROUP_INITIAL_BUCKET_COUNT) : nullptr;
+        if (groupTable == nullptr) {
+            bucket->m_lock.unlock();
+            if (chainNode != nullptr) {
+                m_nodePool->Release(chainNode);
+            }
+            m_nodePool->Release(newNode);
+            MOT_REPORT_ERROR(
+                MOT_ERROR_OOM, "Index Insert", "Failed to allocate hash entry group for index %s", m_name.c_str());
+            return nullptr;
+        }
+        chainNode->m_group.store(groupTable, std::memory_order_relaxed);
+        AddGroupEntry(chainNode, newNode);
+        m_groupTableSize.fetch_add(GetTableSize(GROUP_INITIAL_BUCKET_COUNT), std::memory_order_relaxed);
+    }
+    chainNode->m_next.store(head, std::memory_order_relaxed);
+    bucket->m_head.store(chainNode, std::memory_order_release);
+    bucket->m_lock.unlock();
+    inserted = true;
+    m_count.fetch_add(1, std::memory_order_relaxed);
+
+    uint64_t chainCount = m_chainCount.fetch_add(1, std::memory_order_relaxed) + 1;
+    HashTable* table = m_table.load(std::memory_order_acquire);
+    if (table->m_next.load(std::memory_order_relaxed) != nullptr ||
+        chainCount > table->m_bucketCount * MAX_LOAD_FACTOR) {
+        Grow();
+    }
+
+    return nullptr;
+}
+
+Sentinel* HashPrimaryIndex::IndexReadImpl(const Key* key, uint32_t pid) const
+{
+    const uint8_t* keyBuf = key->GetKeyBuf();
+    uint64_t hash = HashKey(keyBuf, GetKeySizeNoSuffix());
+
+    HashNode* node = FindChainNode(GetChain(m_table.load(std::memory_order_acquire), hash), hash, keyBuf);
+    if (!m_unique && node != nullptr) {
+        node = FindGroupEntry(node->m_group.load(std::memory_order_acquire), HashKey(keyBuf, m_keyLength), keyBuf);
+    }
+
+    return (node != nullptr) ? node->m_sentinel : nullptr;
+}
+
+Sentinel* HashPrimaryIndex::IndexRemoveImpl(const Key* key, uint32_t pid)
+{
+    const uint8_t* keyBuf = key->GetKeyBuf();
+    uint64_t hash = HashKey(keyBuf, GetKeySizeNoSuffix());
+    uint64_t entryHash = m_unique ? hash : HashKey(keyBuf, m_keyLength);
+    Sentinel* sentinel = nullptr;
+    HashNode* node = nullptr;
+    HashNode* group = nullptr;
+    HashTable* groupTable = nullptr;
+
+    HashBucket* bucket = LockBucket(hash);
+    std::atomic<HashNode*>* link = &bucket->m_head;
+    std::atomic<HashNode*>* chainLink = link;
+    if (!m_unique) {
+        // find the group of the key, then look for the entry in the nested array of the group
+        group = chainLink->load(std::memory_order_relaxed);
+        while (group != nullptr && (group->m_hash != hash || !KeyPrefixEquals(group, keyBuf))) {
+            chainLink = &group->m_next;
+            group = chainLink->load(std::memory_order_relaxed);
+        }
+        if (group != nullptr) {
+            groupTable = group->m_group.load(std::memory_order_relaxed);
+            link = &groupTable->m_buckets[entryHash & (groupTable->m_bucketCount - 1)].m_head;
+        }
+    }
+
+    node = (m_unique || group != nullptr) ? link->load(std::memory_order_relaxed) : nullptr;
+    while (node != nullptr) {
+        if (node->m_hash == entryHash && KeyEquals(node, keyBuf)) {
+            // readers on the removed entry can still follow its next pointer
+            link->store(node->m_next.load(std::memory_order_relaxed), std::memory_order_release);
+            sentinel = node->m_sentinel;
+            break;
+        }
+        link = &node->m_next;
+        node = link->load(std::memory_order_relaxed);
+    }
+
+    bool groupEmptied = (sentinel != nullptr && group != nullptr && --groupTable->m_entryCount == 0);
+    if (groupEmptied) {
+        chainLink->store(group->m_next.load(std::memory_order_relaxed), std::memory_order_release);
+    }
+    bucket->m_lock.unlock();
+
+    if (sentinel != nullptr) {
+        m_count.fetch_sub(1, std::memory_order_relaxed);
+        RetireNode(node);
+        if (m_unique) {
+            m_chainCount.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+    if (groupEmptied) {
+        m_chainCount.fetch_sub(1, std::memory_order_relaxed);
+        m_groupTableSize.fetch_sub(GetTableSize(groupTable->m_bucketCount), std::memory_order_relaxed);
+        RetireNode(group);
+        RetireTable(groupTable);
+    }
+
+    return sentinel;
+}
+
+uint64_t HashPrimaryIndex::GetIndexSize()
+{
+    PoolStatsSt stats;
+
+    errno_t erc = memset_s(&stats, sizeof(PoolStatsSt), 0, sizeof(PoolStatsSt));
+    securec_check(erc, "\0", "\0");
+    stats.m_type = PoolStatsT::POOL_STATS_ALL;
+    m_keyPool->GetStats(stats);
+    uint64_t res = stats.m_poolCount * stats.m_poolGrossSize;
+    uint64_t netto = (stats.m_totalObjCount - stats.m_freeObjCount) * stats.m_objSize;
+
+    erc = memset_s(&stats, sizeof(PoolStatsSt), 0, sizeof(PoolStatsSt));
+    securec_check(erc, "\0", "\0");
+    stats.m_type = PoolStatsT::POOL_STATS_ALL;
+    m_sentinelPool->GetStats(stats);
+    res += stats.m_poolCount * stats.m_poolGrossSize;
+    netto += (stats.m_totalObjCount - stats.m_freeObjCount) * stats.m_objSize;
+
+    erc = memset_s(&stats, sizeof(PoolStatsSt), 0, sizeof(PoolStatsSt));
+    securec_check(erc, "\0", "\0");
+    stats.m_type = PoolStatsT::POOL_STATS_ALL;
+    m_nodePool->GetStats(stats);
+    res += stats.m_poolCount * stats.m_poolGrossSize;
+    netto += (stats.m_totalObjCount - stats.m_freeObjCount) * stats.m_objSize;
+
+    for (HashTable* table = m_table.load(std::memory_order_acquire); table != nullptr;
+         table = table->m_next.load(std::memory_order_acquire)) {
+        res += GetTableSize(table->m_bucketCount);
+        netto += GetTableSize(table->m_bucketCount);
+    }
+    res += m_groupTableSize.load(std::memory_order_relaxed);
+    netto += m_groupTableSize.load(std::memory_order_relaxed);
+
+    MOT_LOG_INFO("Index %s memory size: gross: %lu, netto: %lu", m_name.c_str(), res, netto);
+    return res;
+}
+
+// Iterator API
+IndexIterator* HashPrimaryIndex::Begin(uint32_t pid, bool passive) const
+{
+    IndexIterator* itr = new (std::nothrow) HashIterator(this);
+    if (!itr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Index Begin", "Failed to create hash iterator");
+    }
+
+    return itr;
+}
+
+IndexIterator* HashPrimaryIndex::Search(
+    const Key* key, bool matchKey, bool forward, uint32_t pid, bool& found, bool passive) const
+{
+    HashIterator* itr = new (std::nothrow) HashIterator(this, key);
+    if (!itr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Index Search", "Failed to create hash iterator");
+        found = false;
+        return nullptr;
+    }
+
+    found = itr->m_found;
+    return itr;
+}
+
+HashPrimaryIndex::HashIterator::HashIterator(const HashPrimaryIndex* index, const Key* key)
+    : IndexIterator(IteratorType::ITERATOR_TYPE_FORWARD, false),
+      m_found(false),
+      m_index(index),
+      m_node(nullptr),
+      m_chainNode(nullptr),
+      m_groupTable(nullptr),
+      m_groupSlot(0),
+      m_fullScan(false),
+      m_root(nullptr),
+      m_slotCount(0),
+      m_slot(0),
+      m_subBucket(0),
+      m_liveBucketCount(0)
+{
+    m_searchKey.CpKey(key->GetKeyBuf(), index->GetKeySizeNoSuffix());
+    m_hash = HashKey(m_searchKey.GetKeyBuf(), index->GetKeySizeNoSuffix());
+    m_node = index->GetChain(index->m_table.load(std::memory_order_acquire), m_hash);
+    SkipToMatch();
+    if (!index->m_unique && m_node != nullptr) {
+        // all the entries of a non-unique key are in its group
+        m_chainNode = m_node;
+        EnterGroup();
+    }
+    m_found = (m_node != nullptr);
+}
+
+HashPrimaryIndex::HashIterator::HashIterator(const HashPrimaryIndex* index)
+    : IndexIterator(IteratorType::ITERATOR_TYPE_FORWARD, false),
+      m_found(false),
+      m_index(index),
+      m_node(nullptr),
+      m_chainNode(nullptr),
+      m_groupTable(nullptr),
+      m_groupSlot(0),
+      m_fullScan(true),
+      m_hash(0),
+      m_slot(0),
+      m_subBucket(0)
+{
+    // A full scan goes through the buckets of the array it started with. Arrays only grow, so if that array is
+    // replaced during the scan, the entries of a bucket are split over several buckets of the newer array.
+    m_root = index->m_table.load(std::memory_order_acquire);
+    m_slotCount = m_root->m_bucketCount;
+    LoadSlotBucket();
+    SkipToSlotEntry();
+    m_found = (m_node != nullptr);
+}
+
+void HashPrimaryIndex::HashIterator::SkipToMatch()
+{
+    while (m_node != nullptr &&
+           (m_node->m_hash != m_hash || !m_index->KeyPrefixEquals(m_node, m_searchKey.GetKeyBuf()))) {
+        m_node = m_node->m_next.load(std::memory_order_acquire);
+    }
+}
+
+void HashPrimaryIndex::HashIterator::EnterGroup()
+{
+    // a nested array is replaced as a whole when it grows, so the iterated one stays consistent
+    m_groupTable = m_chainNode->m_group.load(std::memory_order_acquire);
+    m_groupSlot = 0;
+    m_node = m_groupTable->m_buckets[0].m_head.load(std::memory_order_acquire);
+    SkipToGroupEntry();
+}
+
+void HashPrimaryIndex::HashIterator::SkipToGroupEntry()
+{
+    while (m_node == nullptr && ++m_groupSlot < m_groupTable->m_bucketCount) {
+        m_node = m_groupTable->m_buckets[m_groupSlot].m_head.load(std::memory_order_acquire);
+    }
+}
+
+void HashPrimaryIndex::HashIterator::LoadSlotBucket()
+{
+    uint64_t bucket = m_slot + m_subBucket * m_slotCount;
+    HashTable* table = m_root;
+    HashNode* head = table->m_buckets[bucket & (table->m_bucketCount - 1)].m_head.load(std::memory_order_acquire);
+    while (IsMoved(head)) {
+        table = table->m_next.load(std::memory_order_acquire);
+        head = table->m_buckets[bucket & (table->m_bucketCount - 1)].m_head.load(std::memory_order_acquire);
+    }
+    m_liveBucketCount = table->m_bucketCount;
+    m_chainNode = head;
+    m_node = nullptr;
+}
+
+void HashPrimaryIndex::HashIterator::SkipToSlotEntry()
+{
+    for (;;) {
+        // a group of a non-unique index may be found empty while its last entry is being removed
+        while (m_node == nullptr && m_chainNode != nullptr) {
+            if (m_index->m_unique) {
+                m_node = m_chainNode;
+            } else {
+                EnterGroup();
+            }
+            if (m_node == nullptr) {
+                m_chainNode = m_chainNode->m_next.load(std::memory_order_acquire);
+            }
+        }
+        if (m_node != nullptr) {
+            return;
+        }
+
+        // current chain is exhausted, go to the next bucket of this slot, or to the next slot
+        if (m_slot + (m_subBucket + 1) * m_slotCount < m_liveBucketCount) {
+            m_subBucket++;
+        } else if (++m_slot < m_slotCount) {
+            m_subBucket = 0;
+        } else {
+            return;  // end of scan
+        }
+        LoadSlotBucket();
+    }
+}
+
+const void* HashPrimaryIndex::HashIterator::GetKey() const
+{
+    if (m_node == nullptr) {
+        return nullptr;
+    }
+    m_currKey.CpKey(m_node->m_keyBuf, m_index->GetKeyLength());
+    return &m_currKey;
+}
+
+void HashPrimaryIndex::HashIterator::Next()
+{
+    if (m_node == nullptr) {
+        return;
+    }
+
+    m_node = m_node->m_next.load(std::memory_order_acquire);
+    if (m_index->m_unique) {
+        if (m_fullScan) {
+            m_chainNode = m_node;
+            SkipToSlotEntry();
+        } else {
+            SkipToMatch();
+        }
+        return;
+    }
+
+    SkipToGroupEntry();
+    if (m_node == nullptr && m_fullScan) {
+        // current group is exhausted, go to the next one
+        m_chainNode = m_chainNode->m_next.load(std::memory_order_acquire);
+        SkipToSlotEntry();
+    }
+}
+}  // namespace MOT
@@ -0,0 +1,521 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * hash_index.h
+ *    Concurrent resizable hash index implementation.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/src/storage/index/hash_index.h
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef HASH_PRIMARY_INDEX_H
+#define HASH_PRIMARY_INDEX_H
+
+#include <atomic>
+
+#include "index.h"
+#include "mm_global_api.h"
+#include "spin_lock.h"
+#include "utilities.h"
+
+namespace MOT {
+/**
+ * @class HashPrimaryIndex.
+ * @brief Concurrent hash index, for workloads that only look keys up by equality.
+ * @detail The index is an array of buckets, each holding a singly linked chain of entries. Readers
+ * never lock: they walk the chain of a bucket while concurrent writers, which do lock the bucket,
+ * publish new chain heads with release semantics. Removed entries are handed to the GC and freed only
+ * when no transaction of an older epoch can still reach them.
+ *
+ * The bucket array doubles when the index gets too loaded. The new array is filled incrementally, a
+ * batch of buckets by each insert that runs into the resize: the entries of an old bucket are copied
+ * to the new array and the old bucket is then marked as moved, which redirects readers and writers to
+ * the new array. The old array is retired once all its buckets moved.
+ *
+ * In a non-unique index the chain holds one group entry per distinct key, hashed without the row
+ * identifier suffix, so that a prefix search finds all the entries of a key in one place. The group
+ * owns a nested bucket array of its entries, hashed with the suffix, so inserting or removing one of
+ * many duplicates stays a constant time operation. A nested array grows all at once, under the lock
+ * of the bucket holding its group, and the old array with its entries is retired to the GC.
+ *
+ * Entries are kept in no particular order, so the index serves point and prefix lookups only, never
+ * ranges or ordered scans.
+ */
+class HashPrimaryIndex : public Index {
+private:
+    struct HashTable;
+
+    /** @struct A single index entry, or a group of entries of a non-unique key, followed by the key bytes. */
+    struct HashNode {
+        /** @var The next entry in the bucket chain. */
+        std::atomic<HashNode*> m_next;
+
+        /** @var The sentinel mapped to the key, null for a group. */
+        Sentinel* m_sentinel;
+
+        /** @var The hash value of the key (of the key without its suffix for a group). */
+        uint64_t m_hash;
+
+        /** @var The nested bucket array holding the entries of a group, null for an entry. */
+        std::atomic<HashTable*> m_group;
+
+        /** @var The key bytes. */
+        uint8_t m_keyBuf[0];
+    };
+
+    /** @struct A bucket of the hash table. */
+    struct HashBucket {
+        /** @var The head of the entry chain. The lowest bit is set once the bucket moved. */
+        std::atomic<HashNode*> m_head;
+
+        /** @var Serializes writers of the bucket. */
+        spin_lock m_lock;
+    };
+
+    /** @struct A bucket array. */
+    struct HashTable {
+        /** @var Number of buckets, always a power of two. */
+        uint64_t m_bucketCount;
+
+        /** @var The array this one is being resized into, or null if no resize is in progress. */
+        std::atomic<HashTable*> m_next;
+
+        /** @var Number of entries in a nested array of a group, guarded by the lock of the group bucket. */
+        uint64_t m_entryCount;
+
+        /** @var The buckets. */
+        HashBucket m_buckets[0];
+    };
+
+    /**
+     * @class HashIterator
+     * @brief An index iterator over the entries of a hash index. It either iterates the entries that
+     * match a key prefix, or all the entries of the index.
+     */
+    class HashIterator : public IndexIterator {
+    public:
+        /**
+         * @brief Constructs an iterator over the entries matching the given key prefix.
+         * @param index The iterated index.
+         * @param key The searched key. Only its first @ref GetKeySizeNoSuffix() bytes are matched.
+         */
+        HashIterator(const HashPrimaryIndex* index, const Key* key);
+
+        /**
+         * @brief Constructs an iterator over all the entries of the index.
+         * @param index The iterated index.
+         */
+        explicit HashIterator(const HashPrimaryIndex* index);
+
+        /**
+         * @brief Destructor.
+         */
+        virtual ~HashIterator()
+        {
+            m_index = nullptr;
+            m_node = nullptr;
+            m_chainNode = nullptr;
+            m_groupTable = nullptr;
+            m_root = nullptr;
+        }
+
+        /**
+         * @brief Queries whether this iterator is valid, that is, whether it still points to an entry.
+         * @return True if the iterator is valid.
+         */
+        virtual bool IsValid() const
+        {
+            return (m_node != nullptr);
+        }
+
+        /**
+         * @brief Invalidates the iterator such that subsequent calls to isValid() return false.
+         */
+        virtual void Invalidate()
+        {
+            m_node = nullptr;
+        }
+
+        /**
+         * @brief Retrieves the key of the currently iterated item.
+         * @return A pointer to the key of the currently iterated item.
+         */
+        virtual const void* GetKey() const;
+
+        /**
+         * @brief Retrieves the row of the currently iterated item.
+         * @return A pointer to the row of the currently iterated item.
+         */
+        virtual Row* GetRow() const
+        {
+            return m_node->m_sentinel->GetData();
+        }
+
+        /**
+         * @brief Retrieves the currently iterated primary sentinel.
+         * @return The primary sentinel.
+         */
+        virtual Sentinel* GetPrimarySentinel() const
+        {
+            return m_node->m_sentinel;
+        }
+
+        /**
+         * @brief Moves forwards the iterator to the next item.
+         */
+        virtual void Next();
+
+        /**
+         * @brief Moves backwards the iterator to the previous item.
+         * @detail Not supported, hash index iterators are forward only.
+         */
+        virtual void Prev()
+        {
+            MOT_ASSERT(false);
+        }
+
+        /**
+         * @brief Queries whether this index iterator equals to another index iterator.
+         * @param rhs The index iterator with which to compare this iterator.
+         * @return True if iterators point to the same index item, otherwise false.
+         */
+        virtual bool Equals(const IndexIterator* rhs) const
+        {
+            return m_node == static_cast<const HashIterator*>(rhs)->m_node;
+        }
+
+        /**
+         * Serializes the iterator into a buffer.
+         * @detail Not implemented
+         * @param serializeFunc The serialization function.
+         * @param buff The buffer into which the iterator is to be serialized.
+         */
+        virtual void Serialize(serialize_func_t serializeFunc, unsigned char* buff) const
+        {}
+
+        /**
+         * Deserializes the iterator from a buffer.
+         * @detail Not implemented
+         * @param deserializeFunc The deserialization function.
+         * @param buff The buffer from which the iterator is to be deserialized.
+         */
+        virtual void Deserialize(deserialize_func_t deserializeFunc, unsigned char* buff)
+        {}
+
+        /** @var Whether the key prefix was found. */
+        bool m_found;
+
+    private:
+        /** @brief Skips to the first entry that matches the iterated key prefix, starting at m_node. */
+        void SkipToMatch();
+
+        /** @brief Positions the iterator at the first entry of the group at m_chainNode, if any. */
+        void EnterGroup();
+
+        /** @brief Skips empty buckets of the current group until an entry is found. */
+        void SkipToGroupEntry();
+
+        /** @brief Positions a full scan at the head of the current bucket of the current slot. */
+        void LoadSlotBucket();
+
+        /** @brief Skips empty buckets until an entry is found, for full scans. */
+        void SkipToSlotEntry();
+
+        /** @var The iterated index. */
+        const HashPrimaryIndex* m_index;
+
+        /** @var The current entry, null once the iterator is exhausted. */
+        HashNode* m_node;
+
+        /** @var The current node of the bucket chain, the group of m_node in a non-unique index. */
+        HashNode* m_chainNode;
+
+        /** @var The nested bucket array of the current group. */
+        HashTable* m_groupTable;
+
+        /** @var The current bucket of the nested array of the current group. */
+        uint64_t m_groupSlot;
+
+        /** @var Whether this iterator scans the whole index. */
+        bool m_fullScan;
+
+        /** @var The hash of the searched key prefix. */
+        uint64_t m_hash;
+
+        /** @var The bucket array at which a full scan started. */
+        HashTable* m_root;
+
+        /** @var The number of slots a full scan goes through, the bucket count of the array it started with. */
+        uint64_t m_slotCount;
+
+        /** @var The current slot of a full scan. */
+        uint64_t m_slot;
+
+        /** @var The current bucket of a slot, when the slot is split over several buckets of a newer array. */
+        uint64_t m_subBucket;
+
+        /** @var The bucket count of the array holding the current slot. */
+        uint64_t m_liveBucketCount;
+
+        /** @var The searched key prefix. */
+        MaxKey m_searchKey;
+
+        /** @var The key of the current entry, filled on demand. */
+        mutable MaxKey m_currKey;
+    };
+
+public:
+    /**
+     * @brief Default constructor.
+     */
+    HashPrimaryIndex()
+        : Index(MOT::IndexOrder::INDEX_ORDER_PRIMARY, IndexingMethod::INDEXING_METHOD_HASH),
+          m_table(nullptr),
+          m_count(0),
+          m_chainCount(0),
+          m_groupTableSize(0),
+          m_nodePool(nullptr),
+          m_nodeSize(0),
+          m_migrated(0),
+          m_initialized(false)
+    {}
+
+    /**
+     * @brief Destructor.
+     */
+    virtual ~HashPrimaryIndex()
+    {
+        if (m_initialized) {
+            m_initialized = false;
+            DestroyTables();
+            DestroyPools();
+        }
+    }
+
+    /**
+     * @brief Calculate the Index memory consumption.
+     * @return The amount of memory the Index consumes.
+     */
+    virtual uint64_t GetIndexSize() override;
+
+    /**
+     * @brief Retrieves the number of entries stored in the index.
+     * @return The number of entries stored in the index.
+     */
+    virtual uint64_t GetSize() const
+    {
+        return m_count.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Destroy all memory pools and init index again.
+     */
+    virtual RC ReInitIndex()
+    {
+        m_initialized = false;
+        DestroyTables();
+        DestroyPools();
+
+        return IndexInitImpl(NULL);
+    }
+
+    // Iterator API
+    virtual IndexIterator* Begin(uint32_t pid, bool passive = false) const;
+
+    /**
+     * @brief Searches for the entries whose key matches the given key. Only the first
+     * @ref GetKeySizeNoSuffix() bytes of the key are matched, so for a non-unique index this returns
+     * all the entries of the key. The entries have no order, so matchKey and forward are ignored.
+     */
+    virtual IndexIterator* Search(
+        const Key* key, bool matchKey, bool forward, uint32_t pid, bool& found, bool passive = false) const;
+
+    /**
+     * @brief Static callback function for deallocating a removed entry.
+     * @param pool Pool to deallocate from.
+     * @param ptr Pointer to the entry.
+     * @param dropIndex Indicates if this callback is part of drop index process.
+     * @return Size of memory that was deallocated.
+     */
+    static uint32_t DeallocateNodeCallBack(void* pool, void* ptr, bool dropIndex)
+    {
+        // If dropIndex == true, all index's pools are going to be cleaned, so we skip the release here
+        ObjAllocInterface* localPoolPtr = (ObjAllocInterface*)pool;
+
+        if (dropIndex == false) {
+            localPoolPtr->Release(ptr);
+        }
+        return localPoolPtr->m_size;
+    }
+
+    /**
+     * @brief Static callback function for deallocating a retired bucket array.
+     * @param unused Not used, bucket arrays are not pooled.
+     * @param ptr Pointer to the bucket array.
+     * @param dropIndex Indicates if this callback is part of drop index process.
+     * @return Size of memory that was deallocated.
+     */
+    static uint32_t DeallocateTableCallBack(void* unused, void* ptr, bool dropIndex)
+    {
+        // Bucket arrays are not pooled, so they must be released even when the index is dropped
+        HashTable* table = (HashTable*)ptr;
+        uint32_t size = GetTableGcSize(table->m_bucketCount);
+        MemGlobalFree(table);
+        return size;
+    }
+
+    /**
+     * @brief Computes the hash value of a key buffer.
+     * @param buf The key buffer.
+     * @param len The number of bytes of the key to hash.
+     * @return The hash value.
+     */
+    static uint64_t HashKey(const uint8_t* buf, uint32_t len);
+
+protected:
+    /**
+     * @brief Implements index initialization.
+     * @param args Null-terminated list of any additional arguments.
+     * @return Return code denoting success or error.
+     */
+    virtual RC IndexInitImpl(void** args);
+
+    virtual Sentinel* IndexInsertImpl(const Key* key, Sentinel* sentinel, bool& inserted, uint32_t pid);
+
+    virtual Sentinel* IndexReadImpl(const Key* key, uint32_t pid) const;
+
+    virtual Sentinel* IndexRemoveImpl(const Key* key, uint32_t pid);
+
+private:
+    /** @var Initial number of buckets. */
+    static constexpr uint64_t INITIAL_BUCKET_COUNT = 1024;
+
+    /** @var Average chain length above which the bucket array is doubled. */
+    static constexpr uint64_t MAX_LOAD_FACTOR = 2;
+
+    /** @var Initial number of buckets of the nested array of a group. */
+    static constexpr uint64_t GROUP_INITIAL_BUCKET_COUNT = 4;
+
+    /** @var Size accounted to the GC for a retired bucket array at most, so that GC counters do not wrap. */
+    static constexpr uint64_t MAX_GC_TABLE_SIZE = 512 * 1024 * 1024;
+
+    /** @var Number of buckets moved to the new array by each insert while resizing. */
+    static constexpr uint64_t MIGRATE_BATCH_SIZE = 256;
+
+    /** @var Marks the head of a bucket whose entries moved to the next array. */
+    static constexpr uintptr_t BUCKET_MOVED = 1;
+
+    static inline bool IsMoved(HashNode* head)
+    {
+        return ((uintptr_t)head & BUCKET_MOVED) != 0;
+    }
+
+    static inline uint64_t GetTableSize(uint64_t bucketCount)
+    {
+        return sizeof(HashTable) + bucketCount * sizeof(HashBucket);
+    }
+
+    /** @brief Retrieves the size accounted to the GC for a retired bucket array, both when retired and freed. */
+    static inline uint32_t GetTableGcSize(uint64_t bucketCount)
+    {
+        uint64_t size = GetTableSize(bucketCount);
+        return (uint32_t)((size < MAX_GC_TABLE_SIZE) ? size : MAX_GC_TABLE_SIZE);
+    }
+
+    bool InitPools();
+    void DestroyPools();
+    void DestroyTables();
+    HashTable* AllocTable(uint64_t bucketCount);
+
+    /** @brief Retrieves the head of the chain that currently holds the given hash. */
+    HashNode* GetChain(HashTable* table, uint64_t hash) const;
+
+    /** @brief Locks and retrieves the bucket that currently holds the given hash. */
+    HashBucket* LockBucket(uint64_t hash);
+
+    /** @brief Moves a batch of buckets to the next array, starting a resize if the index is too loaded. */
+    void Grow();
+
+    /** @brief Copies the entries of an old bucket to the next array and marks it as moved. */
+    bool MigrateBucket(HashTable* table, uint64_t bucket);
+
+    /** @brief Hands an entry that is no longer reachable to the GC. */
+    void RetireNode(HashNode* node);
+
+    /** @brief Hands a bucket array that is no longer reachable to the GC. */
+    void RetireTable(HashTable* table);
+
+    /** @brief Allocates an entry for the given key, not linked anywhere yet. */
+    HashNode* AllocNode(const uint8_t* keyBuf, Sentinel* sentinel, uint64_t hash);
+
+    /** @brief Finds the node of a bucket chain whose key matches the given key without its suffix. */
+    HashNode* FindChainNode(HashNode* head, uint64_t hash, const uint8_t* keyBuf) const;
+
+    /** @brief Finds the entry of a group whose key matches the given full key. */
+    HashNode* FindGroupEntry(HashTable* groupTable, uint64_t hash, const uint8_t* keyBuf) const;
+
+    /** @brief Links an entry into a group, whose bucket is locked, growing the group when too loaded. */
+    void AddGroupEntry(HashNode* group, HashNode* node);
+
+    /** @brief Doubles the nested array of a group, whose bucket is locked. */
+    void GrowGroup(HashNode* group);
+
+    /** @brief Frees the nested arrays of all the groups still linked in the given array. */
+    void DestroyGroupTables(HashTable* table);
+
+    inline bool KeyPrefixEquals(const HashNode* node, const uint8_t* keyBuf) const
+    {
+        return memcmp(node->m_keyBuf, keyBuf, GetKeySizeNoSuffix()) == 0;
+    }
+
+    inline bool KeyEquals(const HashNode* node, const uint8_t* keyBuf) const
+    {
+        return memcmp(node->m_keyBuf, keyBuf, m_keyLength) == 0;
+    }
+
+    /** @var The current bucket array. */
+    std::atomic<HashTable*> m_table;
+
+    /** @var Number of entries in the index. */
+    std::atomic<uint64_t> m_count;
+
+    /** @var Number of nodes in the bucket chains, which is the number of distinct keys of a non-unique index. */
+    std::atomic<uint64_t> m_chainCount;
+
+    /** @var Memory held by the nested arrays of the groups of a non-unique index. */
+    std::atomic<uint64_t> m_groupTableSize;
+
+    /** @var Memory pool for entries. */
+    ObjAllocInterface* m_nodePool;
+
+    /** @var Size of an entry, key included. */
+    uint32_t m_nodeSize;
+
+    /** @var Serializes resizes. */
+    spin_lock m_resizeLock;
+
+    /** @var Number of buckets of the current array already moved to the next one. */
+    uint64_t m_migrated;
+
+    /** @var Determine if object is initialized or not. */
+    bool m_initialized;
+
+    DECLARE_CLASS_LOGGER()
+};
+}  // namespace MOT
+
+#endif /* HASH_PRIMARY_INDEX_H */
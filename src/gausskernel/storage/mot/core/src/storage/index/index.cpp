@@ -256,6 +256,12 @@ bool Index::IndexInsert(Sentinel*& outputSentinel, const Key* key, uint32_t pid,
 
     while (retryInsert) {
         outputSentinel = IndexInsertImpl(key, sentinel, inserted, pid);
+        if (unlikely(inserted == false && outputSentinel == nullptr)) {
+            // the index could not allocate memory for the new entry
+            m_sentinelPool->Release<Sentinel>(sentinel);
+            rc = RC_MEMORY_ALLOCATION_ERROR;
+            return false;
+        }
         // sync between rollback/delete and insert
         if (inserted == false) {
             // Spin if the counter is 0 - aborting in parallel or sentinel is marks for commit
@@ -296,7 +302,11 @@ Sentinel* Index::IndexInsert(const Key* key, Row* row, uint32_t pid)
     sentinel->Init(this, nullptr);
     sentinel->UnSetDirty();
     currSentinel = IndexInsertImpl(key, sentinel, inserted, pid);
-    if (currSentinel != nullptr) {
+    if (unlikely(!inserted && currSentinel == nullptr)) {
+        // the index could not allocate memory for the new entry, error already reported
+        m_sentinelPool->Release<Sentinel>(sentinel);
+        return nullptr;
+    } else if (currSentinel != nullptr) {
         // no need to report to full error stack
         SetLastError(MOT_ERROR_UNIQUE_VIOLATION, MOT_SEVERITY_NORMAL);
         m_sentinelPool->Release<Sentinel>(sentinel);
@@ -372,7 +382,8 @@ void Index::Compact(Table* table, uint32_t pid)
             return;
         }
 
-        if (m_indexOrder == IndexOrder::INDEX_ORDER_PRIMARY) {
+        // rows placed by primary key hash must stay in the pool of their NUMA node
+        if (m_indexOrder == IndexOrder::INDEX_ORDER_PRIMARY && table->GetPlacementNode() != Table::HASH_PLACEMENT) {
             char tabPrefix[256];
             erc = snprintf_s(
                 tabPrefix, sizeof(tabPrefix), sizeof(tabPrefix) - 1, "%s(row pool)", table->GetTableName().c_str());
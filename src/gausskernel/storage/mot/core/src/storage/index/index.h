@@ -708,7 +708,7 @@ protected:
      * @param pid The logical identifier of the requesting thread.
      * @return The sentinel object that is mapped to the given key. If the sentinel was inserted, then
      * null pointer is returned, otherwise the sentinel that was already mapped to the key is
-     * returned.
+     * returned. A null pointer with inserted set to false denotes an out-of-memory failure.
      */
     virtual Sentinel* IndexInsertImpl(const Key* key, Sentinel* sentinel, bool& inserted, uint32_t pid) = 0;
 
@@ -64,7 +64,12 @@ public:
         S_STATUS_MASK = ~S_STATUS_BITS
     };
 
-    enum StableRowFlags : uint64_t { STABLE_BIT = 1UL << 63, PRE_ALLOC_BIT = 1UL << 62 };
+    enum StableRowFlags : uint64_t {
+        STABLE_BIT = 1UL << 63,
+        PRE_ALLOC_BIT = 1UL << 62,
+        DELTA_BIT_0 = 1UL << 61,  // row changed since the last checkpoint of an even delta epoch
+        DELTA_BIT_1 = 1UL << 60   // row changed since the last checkpoint of an odd delta epoch
+    };
 
     inline bool IsCommited() const
     {
@@ -233,6 +238,7 @@ public:
         InitCounter();
         SetNextPtr(row);
         m_stable = 0;
+        m_contention = 0;
     }
     /**
      * @brief Set the object pointer for the sentinel
@@ -322,6 +328,74 @@ public:
         }
     }
 
+    /**
+     * @brief Queries whether the row was changed in the given delta checkpoint epoch.
+     * @param epoch The parity of the checkpoint which should capture the change.
+     */
+    inline bool GetDeltaStatus(bool epoch) const
+    {
+        uint64_t bit = epoch ? DELTA_BIT_1 : DELTA_BIT_0;
+        return (m_stable & bit) == bit;
+    }
+
+    inline void SetDeltaStatus(bool epoch, bool val)
+    {
+        uint64_t bit = epoch ? DELTA_BIT_1 : DELTA_BIT_0;
+        if (val == true) {
+            m_stable |= bit;
+        } else {
+            m_stable &= ~bit;
+        }
+    }
+
+    /**
+     * @brief Queries whether the row is hot, i.e. should be locked at first write instead of being validated
+     * at commit time.
+     * @param threshold The number of conflicts after which a row is considered hot.
+     */
+    inline bool IsHot(uint32_t threshold) const
+    {
+        return m_contention >= threshold;
+    }
+
+    /**
+     * @brief Records a commit-time conflict on the row. A row that reaches the conflict threshold becomes hot
+     * for the given number of committed writes, and a conflict on a hot row restarts its cool-down period.
+     * @param threshold The number of conflicts after which a row is considered hot.
+     * @param coolDown The number of committed writes after which a hot row is no longer hot.
+     * @return True if the row became hot.
+     */
+    inline bool RecordConflict(uint32_t threshold, uint32_t coolDown)
+    {
+        uint32_t hot = threshold + coolDown;
+        uint32_t v = m_contention;
+        uint32_t next = (v + 1 >= threshold) ? hot : (v + 1);
+        while (v != next && !__sync_bool_compare_and_swap(&m_contention, v, next)) {
+            PAUSE
+            v = m_contention;
+            next = (v + 1 >= threshold) ? hot : (v + 1);
+        }
+        return (v < threshold && next >= threshold);
+    }
+
+    /**
+     * @brief Records a committed write of the row, which decays its conflict count. A hot row that completed
+     * its cool-down period is no longer hot.
+     * @param threshold The number of conflicts after which a row is considered hot.
+     */
+    inline void RecordWrite(uint32_t threshold)
+    {
+        uint32_t v = m_contention;
+        while (v != 0) {
+            uint32_t next = (v == threshold) ? 0 : (v - 1);
+            if (__sync_bool_compare_and_swap(&m_contention, v, next)) {
+                break;
+            }
+            PAUSE
+            v = m_contention;
+        }
+    }
+
     void SetLockOwner(uint64_t tid)
     {
         MOT_ASSERT(m_status & S_LOCK_BIT);
@@ -342,6 +416,9 @@ private:
     /** @var m_refCount A counter of concurrent inserters of the same key  */
     volatile uint32_t m_refCount = 0;
 
+    /** @var m_contention The commit-time conflicts count of the row, used to detect hot rows */
+    volatile uint32_t m_contention = 0;
+
     inline void DecCounter()
     {
         MOT_ASSERT(GetCounter() > 0);
@@ -33,6 +33,8 @@
 #include "txn_insert_action.h"
 #include "redo_log_writer.h"
 #include "recovery_manager.h"
+#include "mm_cfg.h"
+#include "hash_index.h"
 
 namespace MOT {
 IMPLEMENT_CLASS_LOGGER(Table, Storage);
@@ -115,7 +117,17 @@ bool Table::Init(const char* tableName, const char* longName, unsigned int field
 bool Table::InitRowPool(bool local)
 {
     bool result = true;
-    m_rowPool = ObjAllocInterface::GetObjPool(sizeof(Row) + m_tupleSize, local);
+    if (m_placementNode != -1 && !local && g_memGlobalCfg.m_chunkAllocPolicy != MEM_ALLOC_POLICY_LOCAL) {
+        MOT_LOG_WARN("Rows of table %s are placed on NUMA nodes, but chunk allocation policy %s does not keep them "
+                     "on those nodes",
+            m_longTableName.c_str(),
+            MemAllocPolicyToString(g_memGlobalCfg.m_chunkAllocPolicy));
+    }
+    if (m_placementNode == HASH_PLACEMENT && !local) {
+        m_rowPool = ObjAllocInterface::GetPartitionedObjPool(sizeof(Row) + m_tupleSize);
+    } else {
+        m_rowPool = ObjAllocInterface::GetObjPool(sizeof(Row) + m_tupleSize, local, 8, local ? -1 : m_placementNode);
+    }
     if (!m_rowPool) {
         MOT_REPORT_ERROR(
             MOT_ERROR_OOM, "Initialize Table", "Failed to allocate row pool for table %s", m_longTableName.c_str());
@@ -476,6 +488,14 @@ RC Table::InsertRow(Row* row, TxnManager* txn)
         ix->BuildKey(this, row, key);
     }
 
+    if (m_placementNode == HASH_PLACEMENT) {
+        row = PlaceRow(row, key);
+        if (row == nullptr) {
+            MOTCurrTxn->DestroyTxnKey(key);
+            return RC_MEMORY_ALLOCATION_ERROR;
+        }
+    }
+
     txn->GetNextInsertItem()->SetItem(row, ix, key);
 
     // add secondary indexes
@@ -605,11 +625,69 @@ Row* Table::CreateNewRow()
     return row;
 }
 
+Row* Table::CreateNewRow(const uint8_t* keyBuf, uint16_t keyLen)
+{
+    if (m_placementNode != HASH_PLACEMENT) {
+        return CreateNewRow();
+    }
+
+    int node = GetKeyPlacementNode(keyBuf, keyLen);
+    void* buf = static_cast<PartitionedObjPool*>(m_rowPool)->AllocOnNode(node);
+    if (buf == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM,
+            "Create Row",
+            "Failed to create new row on NUMA node %d in table %s",
+            node,
+            m_longTableName.c_str());
+        return nullptr;
+    }
+    return new (buf) Row(this);
+}
+
 void Table::DestroyRow(Row* row)
 {
     m_rowPool->Release<Row>(row);
 }
 
+int Table::GetKeyPlacementNode(const uint8_t* keyBuf, uint16_t keyLen) const
+{
+    // the low bits of the hash select hash index buckets, so the node is taken from the high bits
+    uint64_t hash = HashPrimaryIndex::HashKey(keyBuf, keyLen) >> 32;
+    return (int)(hash % (uint64_t)static_cast<PartitionedObjPool*>(m_rowPool)->GetNodeCount());
+}
+
+int Table::GetRowPlacementNode(Row* row) const
+{
+    if (m_placementNode == HASH_PLACEMENT) {
+        return static_cast<PartitionedObjPool*>(m_rowPool)->GetNode(row);
+    }
+    return m_placementNode;
+}
+
+Row* Table::PlaceRow(Row* row, const Key* key)
+{
+    PartitionedObjPool* pool = static_cast<PartitionedObjPool*>(m_rowPool);
+    int node = GetKeyPlacementNode(key->GetKeyBuf(), key->GetKeyLength());
+    if (pool->GetNode(row) == node) {
+        return row;
+    }
+
+    // the key is known only after the row was packed, so the row is copied to the node of its key
+    Row* placedRow = nullptr;
+    void* buf = pool->AllocOnNode(node);
+    if (buf != nullptr) {
+        placedRow = new (buf) Row(*row);
+    } else {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM,
+            "Place Row",
+            "Failed to move new row to NUMA node %d in table %s",
+            node,
+            m_longTableName.c_str());
+    }
+    DestroyRow(row);
+    return placedRow;
+}
+
 bool Table::CreateMultipleRows(size_t numRows, Row* rows[])
 {
     size_t failed_row = 0;
@@ -771,8 +849,7 @@ void Table::Truncate(TxnManager* txn)
     GcManager::ClearIndexElements(m_indexes[0]->GetIndexId());
     m_indexes[0]->Truncate(false);
     ObjAllocInterface::FreeObjPool(&m_rowPool);
-    m_rowPool = ObjAllocInterface::GetObjPool(sizeof(Row) + m_tupleSize, false);
-    if (!m_rowPool) {
+    if (!InitRowPool()) {
         MOT_REPORT_ERROR(MOT_ERROR_OOM,
             "Truncate Table",
             "Failed to allocate row pool after truncate in table %s",
@@ -782,6 +859,19 @@ void Table::Truncate(TxnManager* txn)
     (void)pthread_rwlock_unlock(&m_rwLock);
 }
 
+void Table::AddDeltaDeletedKey(bool epoch, uint64_t csn, const uint8_t* keyBuf, uint16_t keyLength)
+{
+    std::lock_guard<std::mutex> guard(m_deltaDeletedKeysLock);
+    m_deltaDeletedKeys[epoch ? 1 : 0].emplace_back(csn, std::string((const char*)keyBuf, keyLength));
+}
+
+void Table::TakeDeltaDeletedKeys(bool epoch, DeltaDeletedKeyList& keys)
+{
+    keys.clear();
+    std::lock_guard<std::mutex> guard(m_deltaDeletedKeysLock);
+    keys.swap(m_deltaDeletedKeys[epoch ? 1 : 0]);
+}
+
 void Table::Compact(TxnManager* txn)
 {
     uint32_t pid = txn->GetThdId();
@@ -1041,7 +1131,7 @@ size_t Table::SerializeSize()
         SerializablePOD<uint64_t>::SerializeSize(m_tableExId) +
         SerializablePOD<bool>::SerializeSize(m_fixedLengthRows) + SerializablePOD<uint32_t>::SerializeSize(m_fieldCnt) +
         SerializablePOD<uint32_t>::SerializeSize(m_tupleSize) + SerializablePOD<uint32_t>::SerializeSize(m_maxFields) +
-        colsSize + idxsSize;
+        colsSize + idxsSize + SerializablePOD<int32_t>::SerializeSize(m_placementNode);
     return ret;
 }
 
@@ -1074,9 +1164,17 @@ void Table::Serialize(char* dataOut)
             dataOut = SerializeItem(dataOut, m_indexes[i]);
         }
     }
+
+    /* row placement, appended last so that older versions can still read the metadata */
+    dataOut = SerializablePOD<int32_t>::Serialize(dataOut, m_placementNode);
 }
 
 void Table::Deserialize(const char* in)
+{
+    Deserialize(in, 0);
+}
+
+void Table::Deserialize(const char* in, size_t len)
 {
     // m_numIndexes will be incremented during each index addition
     uint16_t savedNumIndexes = 0;
@@ -1121,11 +1219,6 @@ void Table::Deserialize(const char* in)
         }
     }
 
-    if (!InitRowPool()) {
-        MOT_LOG_ERROR("Table::deserialize - failed to create row pool");
-        return;
-    }
-
     if (savedNumIndexes > 0) {
         CommonIndexMeta idx;
         /* primary key */
@@ -1144,6 +1237,26 @@ void Table::Deserialize(const char* in)
             }
         }
     }
+
+    /* row placement is missing from metadata written by older versions */
+    int32_t placementNode = -1;
+    if (len >= (size_t)(dataIn - in) + SerializablePOD<int32_t>::SerializeSize(placementNode)) {
+        dataIn = SerializablePOD<int32_t>::Deserialize(dataIn, placementNode);
+    }
+    if (placementNode >= (int32_t)g_memGlobalCfg.m_nodeCount) {
+        MOT_LOG_WARN("Table::deserialize - rows of table %s were placed on NUMA node %d, which does not exist, "
+                     "rows are allocated on the node of the inserting session",
+            m_longTableName.c_str(),
+            placementNode);
+        placementNode = -1;
+    }
+    SetPlacementNode(placementNode);
+
+    /* the row pool is created once the row placement is known */
+    if (!InitRowPool()) {
+        MOT_LOG_ERROR("Table::deserialize - failed to create row pool");
+        return;
+    }
     MOT_ASSERT(m_numIndexes == savedNumIndexes);
     SetDeserialized(true);
 }
@@ -1242,7 +1355,7 @@ size_t Table::SerializeRedoSize()
         SerializablePOD<uint64_t>::SerializeSize(m_tableExId) +
         SerializablePOD<bool>::SerializeSize(m_fixedLengthRows) + SerializablePOD<uint32_t>::SerializeSize(m_fieldCnt) +
         SerializablePOD<uint32_t>::SerializeSize(m_tupleSize) + SerializablePOD<uint32_t>::SerializeSize(m_maxFields) +
-        colsSize;
+        colsSize + SerializablePOD<int32_t>::SerializeSize(m_placementNode);
     return ret;
 }
 
@@ -1269,5 +1382,8 @@ void Table::SerializeRedo(char* dataOut)
     for (uint32_t i = 0; i < m_fieldCnt; i++) {
         dataOut = SerializeItem(dataOut, GetField(i));
     }
+
+    /* row placement, appended last so that older versions can still read the redo entry */
+    dataOut = SerializablePOD<int32_t>::Serialize(dataOut, m_placementNode);
 }
 }  // namespace MOT
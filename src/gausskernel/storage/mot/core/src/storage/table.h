@@ -30,6 +30,8 @@
 #include <string>
 #include <iostream>
 #include <memory>
+#include <mutex>
+#include <vector>
 #include <pthread.h>
 #include "global.h"
 #include "sentinel.h"
@@ -82,7 +84,8 @@ public:
           m_tupleSize(0),
           m_maxFields(0),
           m_deserialized(false),
-          m_rowCount(0)
+          m_rowCount(0),
+          m_placementNode(-1)
     {}
 
     /** @brief Destructor. */
@@ -519,6 +522,37 @@ public:
         m_fixedLengthRows = fixedLength;
     }
 
+    /** @var Placement node of tables whose rows are spread over all NUMA nodes by primary key hash. */
+    static constexpr int HASH_PLACEMENT = -2;
+
+    /**
+     * @brief Retrieves the NUMA node on which the rows of the table are placed.
+     * @return The NUMA node identifier, @ref HASH_PLACEMENT if rows are placed by primary key hash, or -1 if rows
+     * are allocated on the node of the inserting session.
+     */
+    inline int GetPlacementNode() const
+    {
+        return m_placementNode;
+    }
+
+    /**
+     * @brief Sets the NUMA node on which the rows of the table are placed. Must be called before the row pool is
+     * initialized.
+     * @param node The NUMA node identifier, @ref HASH_PLACEMENT to place rows by primary key hash, or -1 to allocate
+     * rows on the node of the inserting session.
+     */
+    inline void SetPlacementNode(int node)
+    {
+        m_placementNode = node;
+    }
+
+    /**
+     * @brief Retrieves the NUMA node on which a row of the table is placed.
+     * @param row The row.
+     * @return The NUMA node identifier, or -1 if the table does not place its rows.
+     */
+    int GetRowPlacementNode(Row* row) const;
+
     /**
      * @brief returns unique ID of the table object.
      */
@@ -608,6 +642,15 @@ public:
      */
     Row* CreateNewRow();
 
+    /**
+     * @brief Create new row placeholder for a row whose primary key is known in advance. Tables placed by
+     * primary key hash allocate the row on the NUMA node of the key.
+     * @param keyBuf The primary key buffer.
+     * @param keyLen The primary key length.
+     * @return The newly created row.
+     */
+    Row* CreateNewRow(const uint8_t* keyBuf, uint16_t keyLen);
+
     /**
      * @brief Releases a row's memory.
      * @param row. row to be deleted
@@ -840,6 +883,94 @@ public:
         m_deserialized = val;
     }
 
+    /** @typedef List of the primary keys deleted since the last checkpoint, along with their deletion CSN. */
+    typedef std::vector<std::pair<uint64_t, std::string>> DeltaDeletedKeyList;
+
+    /**
+     * @brief Records the primary key of a deleted row, to be written by the next delta checkpoint.
+     * @param epoch The parity of the checkpoint which should capture the deletion.
+     * @param csn The commit sequence number of the deleting transaction.
+     * @param keyBuf The primary key buffer.
+     * @param keyLength The primary key length.
+     */
+    void AddDeltaDeletedKey(bool epoch, uint64_t csn, const uint8_t* keyBuf, uint16_t keyLength);
+
+    /**
+     * @brief Retrieves and clears the primary keys deleted in a delta checkpoint epoch.
+     * @param epoch The parity of the checkpoint in progress.
+     * @param[out] keys Receives the deleted keys.
+     */
+    void TakeDeltaDeletedKeys(bool epoch, DeltaDeletedKeyList& keys);
+
+    /**
+     * @brief Requests the next checkpoint to capture all the rows of the table, since changes were made to it
+     * that cannot be expressed as a delta (e.g. truncate).
+     */
+    inline void RequestFullCheckpoint()
+    {
+        m_fullCheckpointRequired = true;
+    }
+
+    /**
+     * @brief Consumes a pending full checkpoint request.
+     * @return True if a full checkpoint of the table was requested.
+     */
+    inline bool ConsumeFullCheckpointRequest()
+    {
+        return m_fullCheckpointRequired.exchange(false);
+    }
+
+    /**
+     * @struct ContentionStats
+     * @brief Concurrency control statistics of the table's rows.
+     */
+    struct ContentionStats {
+        /** @var Number of transactions aborted by a commit-time conflict on a row of the table. */
+        uint64_t m_conflicts;
+
+        /** @var Number of times a row of the table became hot. */
+        uint64_t m_hotRows;
+
+        /** @var Number of hot rows locked at first write. */
+        uint64_t m_hotRowLocks;
+
+        /** @var Number of hot rows that could not be locked at first write and were accessed optimistically. */
+        uint64_t m_hotRowLockTimeouts;
+    };
+
+    /**
+     * @brief Records a commit-time conflict on a row of the table.
+     * @param becameHot Specifies whether the row became hot due to the conflict.
+     */
+    inline void RecordConflict(bool becameHot)
+    {
+        (void)m_conflicts.fetch_add(1, std::memory_order_relaxed);
+        if (becameHot) {
+            (void)m_hotRows.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Records an attempt to lock a hot row of the table at first write.
+     * @param locked Specifies whether the row was locked.
+     */
+    inline void RecordHotRowLock(bool locked)
+    {
+        if (locked) {
+            (void)m_hotRowLocks.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            (void)m_hotRowLockTimeouts.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    inline void GetContentionStats(ContentionStats& stats) const
+    {
+        stats.m_conflicts = m_conflicts.load(std::memory_order_relaxed);
+        stats.m_hotRows = m_hotRows.load(std::memory_order_relaxed);
+        stats.m_hotRowLocks = m_hotRowLocks.load(std::memory_order_relaxed);
+        stats.m_hotRowLockTimeouts = m_hotRowLockTimeouts.load(std::memory_order_relaxed);
+    }
+
     /**
      * @brief Removes a row from the primary index.
      * @param row The row to be removed.
@@ -868,6 +999,17 @@ private:
         ObjAllocInterface::FreeObjPool(&rowPool);
     }
 
+    /** @brief Retrieves the NUMA node of a primary key in a table placed by primary key hash. */
+    int GetKeyPlacementNode(const uint8_t* keyBuf, uint16_t keyLen) const;
+
+    /**
+     * @brief Moves a new row of a table placed by primary key hash to the NUMA node of its primary key.
+     * @param row The row, which must not be referenced yet.
+     * @param key The primary key of the row.
+     * @return The row on its node, or null if allocation failed (the original row is released in any case).
+     */
+    Row* PlaceRow(Row* row, const Key* key);
+
     /** @var Global atomic table identifier. */
     static std::atomic<uint32_t> tableCounter;
 
@@ -932,6 +1074,27 @@ private:
 
     uint32_t m_rowCount = 0;
 
+    /** @var The NUMA node on which rows are placed, or -1 if none. */
+    int m_placementNode;
+
+    /** @var Guards the lists of keys deleted since the last checkpoint. */
+    std::mutex m_deltaDeletedKeysLock;
+
+    /** @var Keys deleted since the last checkpoint, per delta checkpoint epoch. */
+    DeltaDeletedKeyList m_deltaDeletedKeys[2];
+
+    /** @var Specifies whether the next checkpoint should capture all the rows of the table. */
+    std::atomic<bool> m_fullCheckpointRequired{false};
+
+    /** @var Concurrency control statistics (see ContentionStats). */
+    std::atomic<uint64_t> m_conflicts{0};
+
+    std::atomic<uint64_t> m_hotRows{0};
+
+    std::atomic<uint64_t> m_hotRowLocks{0};
+
+    std::atomic<uint64_t> m_hotRowLockTimeouts{0};
+
     DECLARE_CLASS_LOGGER();
 
 public:
@@ -1059,6 +1222,13 @@ public:
      */
     virtual void Deserialize(const char* dataIn);
 
+    /**
+     * @brief deserializes a table from a buffer of known size
+     * @param dataIn the input buffer
+     * @param len the size of the input buffer, used to detect fields missing from older formats
+     */
+    void Deserialize(const char* dataIn, size_t len);
+
     /**
      * @brief helper method to fetch names and ids from serialized data
      * @param dataIn the input buffer
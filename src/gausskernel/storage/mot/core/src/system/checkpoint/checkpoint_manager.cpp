@@ -47,6 +47,9 @@ CheckpointManager::CheckpointManager()
       m_availableBit(true),
       m_numCpTasks(0),
       m_numThreads(GetGlobalConfiguration().m_checkpointWorkers),
+      m_maxDeltas(GetGlobalConfiguration().m_checkpointMaxDeltas),
+      m_isDeltaCheckpoint(false),
+      m_fullCheckpointRequired(false),
       m_cpSegThreshold(GetGlobalConfiguration().m_checkpointSegThreshold),
       m_stopFlag(false),
       m_checkpointEnded(false),
@@ -77,6 +80,7 @@ void CheckpointManager::ResetFlags()
     m_stopFlag = false;
     m_errorSet = false;
     m_emptyCheckpoint = false;
+    m_isDeltaCheckpoint = false;
 }
 
 CheckpointManager::~CheckpointManager()
@@ -219,6 +223,9 @@ bool CheckpointManager::Abort()
         UnlockAndClearTables(m_finishedTasks);
         m_numCpTasks = 0;
 
+        // Changes tracked for this checkpoint were not captured, the next checkpoint must be a full one
+        m_fullCheckpointRequired = true;
+
         // Move to rest
         m_lock.WrLock();
         MoveToNextPhase();
@@ -435,6 +442,21 @@ void CheckpointManager::ApplyWrite(TxnManager* txnMan, Row* origRow, AccessType
             MOT_LOG_ERROR("Unknown transaction start phase: %s", CheckpointManager::PhaseToString(startPhase));
             MOT_ASSERT(false);
     }
+
+    if (m_maxDeltas > 0) {
+        // Track the change for the delta checkpoint. Deleted rows can not be found by the checkpoint workers,
+        // so their primary keys are kept by the table until they are captured.
+        bool epoch = GetDeltaEpoch(txnMan);
+        s->SetDeltaStatus(epoch, true);
+        if (type == DEL) {
+            MaxKey key;
+            Table* table = origRow->GetTable();
+            Index* index = table->GetPrimaryIndex();
+            key.InitKey(index->GetKeyLength());
+            index->BuildKey(table, origRow, &key);
+            table->AddDeltaDeletedKey(epoch, txnMan->GetCommitSequenceNumber(), key.GetKeyBuf(), key.GetKeyLength());
+        }
+    }
 }
 
 void CheckpointManager::FillTasksQueue()
@@ -447,6 +469,7 @@ void CheckpointManager::FillTasksQueue()
     GetTableManager()->AddTablesToList(m_tasksList);
     m_numCpTasks = m_tasksList.size();
     m_mapfileInfo.clear();
+    m_deltaInfo.clear();
     MOT_LOG_DEBUG("CheckpointManager::fillTasksQueue:: got %d tasks", m_tasksList.size());
 }
 
@@ -462,7 +485,7 @@ void CheckpointManager::UnlockAndClearTables(std::list<Table*>& tables)
     tables.clear();
 }
 
-void CheckpointManager::TaskDone(Table* table, uint32_t numSegs, bool success)
+void CheckpointManager::TaskDone(Table* table, uint32_t numSegs, bool success, bool isFull, uint64_t numDeletes)
 {
     MOT_ASSERT(table);
     if (success) { /* only successful tasks are added to the map file */
@@ -482,6 +505,19 @@ void CheckpointManager::TaskDone(Table* table, uint32_t numSegs, bool success)
             OnError(CheckpointWorkerPool::ErrCodes::MEMORY, "Failed to allocate map file entry");
             return;
         }
+
+        if (m_isDeltaCheckpoint) {
+            DeltaFileEntry* deltaEntry = new (std::nothrow) DeltaFileEntry();
+            if (deltaEntry == nullptr) {
+                OnError(CheckpointWorkerPool::ErrCodes::MEMORY, "Failed to allocate delta file entry");
+                return;
+            }
+            deltaEntry->m_tableId = table->GetTableId();
+            deltaEntry->m_isFull = isFull ? 1 : 0;
+            deltaEntry->m_numDeletes = numDeletes;
+            std::lock_guard<std::mutex> guard(m_tasksMutex);
+            m_deltaInfo.push_back(deltaEntry);
+        }
     }
 
     if (--m_numCpTasks == 0) {
@@ -512,6 +548,11 @@ void CheckpointManager::CompleteCheckpoint()
         return;
     }
 
+    if (m_isDeltaCheckpoint && !CreateDeltaFile()) {
+        OnError(CheckpointWorkerPool::ErrCodes::FILE_IO, "Failed to create delta file");
+        return;
+    }
+
     if (!ctrlFile->IsValid()) {
         OnError(CheckpointWorkerPool::ErrCodes::FILE_IO, "Invalid control file");
         return;
@@ -541,7 +582,7 @@ void CheckpointManager::CompleteCheckpoint()
     }
 
     RemoveOldCheckpoints(m_inProgressId);
-    MOT_LOG_INFO("Checkpoint [%lu] completed", m_inProgressId);
+    MOT_LOG_INFO("Checkpoint [%lu] completed%s", m_inProgressId, m_isDeltaCheckpoint ? " (delta)" : "");
 }
 
 void CheckpointManager::DestroyCheckpointers()
@@ -554,8 +595,25 @@ void CheckpointManager::DestroyCheckpointers()
 
 void CheckpointManager::CreateCheckpointers()
 {
-    m_checkpointers = new (std::nothrow)
-        CheckpointWorkerPool(m_numThreads, !m_availableBit, m_tasksList, m_cpSegThreshold, m_inProgressId, *this);
+    // A delta checkpoint is taken only on top of a valid checkpoint, and only as long as the chain of deltas
+    // leading to it is short enough. Otherwise (and after a failure) a full checkpoint compacts the chain.
+    m_isDeltaCheckpoint = false;
+    bool fullRequired = m_fullCheckpointRequired.exchange(false);
+    if (m_maxDeltas > 0 && !fullRequired && m_id != CheckpointControlFile::invalidId) {
+        std::vector<uint64_t> chain;
+        if (GetCheckpointChain(m_id, chain) && chain.size() <= m_maxDeltas) {
+            m_isDeltaCheckpoint = true;
+        }
+    }
+    MOT_LOG_DEBUG("Checkpoint %lu is a %s checkpoint", m_inProgressId, m_isDeltaCheckpoint ? "delta" : "full");
+
+    m_checkpointers = new (std::nothrow) CheckpointWorkerPool(m_numThreads,
+        !m_availableBit,
+        m_tasksList,
+        m_cpSegThreshold,
+        m_inProgressId,
+        m_isDeltaCheckpoint ? m_id : CheckpointControlFile::invalidId,
+        *this);
 }
 
 void CheckpointManager::Capture()
@@ -584,6 +642,13 @@ void CheckpointManager::RemoveOldCheckpoints(uint64_t curCheckcpointId)
         return;
     }
 
+    // a delta checkpoint can not be restored without the checkpoints it is based on
+    std::vector<uint64_t> chain;
+    if (!GetCheckpointChain(curCheckcpointId, chain)) {
+        MOT_LOG_ERROR("RemoveOldCheckpoints: failed to get the checkpoint chain of %lu", curCheckcpointId);
+        return;
+    }
+
     DIR* dir = opendir(workingDir.c_str());
     if (dir) {
         struct dirent* p;
@@ -601,7 +666,7 @@ void CheckpointManager::RemoveOldCheckpoints(uint64_t curCheckcpointId)
             }
 
             uint64_t chkptId = strtoll(p->d_name + strlen(CheckpointUtils::dirPrefix), NULL, 10);
-            if (chkptId == curCheckcpointId) {
+            if (std::find(chain.begin(), chain.end(), chkptId) != chain.end()) {
                 MOT_LOG_DEBUG("RemoveOldCheckpoints: exclude %lu", chkptId);
                 continue;
             }
@@ -732,6 +797,9 @@ void CheckpointManager::OnError(int errCode, const char* errMsg, const char* opt
         m_checkpointEnded = true;
     }
     m_errorReportLock.unlock();
+
+    // the changes tracking of a failed checkpoint was already (partially) reset by the workers
+    m_fullCheckpointRequired = true;
 }
 
 bool CheckpointManager::CreateEmptyCheckpoint()
@@ -970,4 +1038,158 @@ bool CheckpointManager::CreateEndFile()
 
     return ret;
 }
+
+bool CheckpointManager::CreateDeltaFile()
+{
+    int fd = -1;
+    std::string fileName;
+    std::string workingDir;
+    bool ret = false;
+
+    do {
+        if (!CheckpointUtils::SetWorkingDir(workingDir, m_inProgressId)) {
+            break;
+        }
+
+        CheckpointUtils::MakeDeltaFilename(fileName, workingDir, m_inProgressId);
+        if (!CheckpointUtils::OpenFileWrite(fileName, fd)) {
+            MOT_LOG_ERROR(
+                "CreateDeltaFile: failed to create file '%s' - %d - %s", fileName.c_str(), errno, gs_strerror(errno));
+            break;
+        }
+
+        CheckpointUtils::DeltaFileHeader deltaFileHeader{CP_MGR_MAGIC, m_id, m_deltaInfo.size()};
+        size_t wrStat =
+            CheckpointUtils::WriteFile(fd, (char*)&deltaFileHeader, sizeof(CheckpointUtils::DeltaFileHeader));
+        if (wrStat != sizeof(CheckpointUtils::DeltaFileHeader)) {
+            MOT_LOG_ERROR(
+                "CreateDeltaFile: failed to write delta file's header (%d) %d %s", wrStat, errno, gs_strerror(errno));
+            (void)CheckpointUtils::CloseFile(fd);
+            break;
+        }
+
+        bool entriesWritten = true;
+        for (std::list<DeltaFileEntry*>::iterator it = m_deltaInfo.begin(); it != m_deltaInfo.end(); ++it) {
+            DeltaFileEntry* entry = *it;
+            if (entriesWritten &&
+                CheckpointUtils::WriteFile(fd, (char*)entry, sizeof(DeltaFileEntry)) != sizeof(DeltaFileEntry)) {
+                MOT_LOG_ERROR("CreateDeltaFile: failed to write delta file entry");
+                entriesWritten = false;
+            }
+            delete entry;
+        }
+        m_deltaInfo.clear();
+        if (!entriesWritten) {
+            (void)CheckpointUtils::CloseFile(fd);
+            break;
+        }
+
+        if (CheckpointUtils::FlushFile(fd)) {
+            MOT_LOG_ERROR("CreateDeltaFile: failed to flush delta file");
+            (void)CheckpointUtils::CloseFile(fd);
+            break;
+        }
+
+        if (CheckpointUtils::CloseFile(fd)) {
+            MOT_LOG_ERROR("CreateDeltaFile: failed to close delta file");
+            break;
+        }
+        ret = true;
+    } while (0);
+
+    return ret;
+}
+
+int CheckpointManager::ReadDeltaFile(uint64_t checkpointId, uint64_t& prevId, std::list<DeltaFileEntry>* entries)
+{
+    int fd = -1;
+    std::string fileName;
+    std::string workingDir;
+
+    if (!CheckpointUtils::SetWorkingDir(workingDir, checkpointId)) {
+        MOT_LOG_ERROR("ReadDeltaFile: failed to set working directory");
+        return -1;
+    }
+
+    CheckpointUtils::MakeDeltaFilename(fileName, workingDir, checkpointId);
+    if (!CheckpointUtils::IsFileExists(fileName)) {
+        // only delta checkpoints have a descriptor file
+        return 0;
+    }
+
+    if (!CheckpointUtils::OpenFileRead(fileName, fd)) {
+        MOT_LOG_ERROR("ReadDeltaFile: failed to open file '%s' - %d - %s", fileName.c_str(), errno, gs_strerror(errno));
+        return -1;
+    }
+
+    int ret = -1;
+    do {
+        CheckpointUtils::DeltaFileHeader deltaFileHeader;
+        if (CheckpointUtils::ReadFile(fd, (char*)&deltaFileHeader, sizeof(CheckpointUtils::DeltaFileHeader)) !=
+            sizeof(CheckpointUtils::DeltaFileHeader)) {
+            MOT_LOG_ERROR("ReadDeltaFile: failed to read header of '%s'", fileName.c_str());
+            break;
+        }
+
+        if (deltaFileHeader.m_magic != CP_MGR_MAGIC) {
+            MOT_LOG_ERROR(
+                "ReadDeltaFile: file '%s' is corrupted (magic %lu)", fileName.c_str(), deltaFileHeader.m_magic);
+            break;
+        }
+
+        if (entries != nullptr) {
+            uint64_t i = 0;
+            for (; i < deltaFileHeader.m_numEntries; i++) {
+                DeltaFileEntry entry;
+                if (CheckpointUtils::ReadFile(fd, (char*)&entry, sizeof(DeltaFileEntry)) != sizeof(DeltaFileEntry)) {
+                    MOT_LOG_ERROR("ReadDeltaFile: failed to read entry %lu of '%s'", i, fileName.c_str());
+                    break;
+                }
+                entries->push_back(entry);
+            }
+            if (i < deltaFileHeader.m_numEntries) {
+                break;
+            }
+        }
+
+        prevId = deltaFileHeader.m_prevId;
+        ret = 1;
+    } while (0);
+
+    if (CheckpointUtils::CloseFile(fd)) {
+        MOT_LOG_ERROR("ReadDeltaFile: failed to close file '%s'", fileName.c_str());
+        ret = -1;
+    }
+    return ret;
+}
+
+bool CheckpointManager::GetCheckpointChain(uint64_t checkpointId, std::vector<uint64_t>& chain)
+{
+    // sanity limit, the chain can not be longer than the maximal number of deltas allowed by the configuration
+    static const size_t maxChainLength = 1024;
+
+    chain.clear();
+    uint64_t id = checkpointId;
+    while (chain.size() < maxChainLength) {
+        chain.push_back(id);
+        uint64_t prevId = CheckpointControlFile::invalidId;
+        int rc = ReadDeltaFile(id, prevId, nullptr);
+        if (rc < 0) {
+            return false;
+        }
+        if (rc == 0) {
+            // reached the full checkpoint at the base of the chain
+            return true;
+        }
+        if (prevId == CheckpointControlFile::invalidId ||
+            std::find(chain.begin(), chain.end(), prevId) != chain.end()) {
+            MOT_LOG_ERROR("GetCheckpointChain: checkpoint %lu has an invalid base checkpoint %lu", id, prevId);
+            return false;
+        }
+        id = prevId;
+    }
+
+    MOT_LOG_ERROR("GetCheckpointChain: the chain of checkpoint %lu is too long", checkpointId);
+    return false;
+}
 }  // namespace MOT
@@ -33,6 +33,7 @@
 #include "txn.h"
 #include "txn_access.h"
 #include <queue>
+#include <vector>
 #include "checkpoint_worker.h"
 #include "checkpoint_ctrlfile.h"
 #include "spin_lock.h"
@@ -115,8 +116,10 @@ public:
      * @param table The table's pointer.
      * @param numSegs number of segments written.
      * @param success Indicates a success or a failure.
+     * @param isFull Indicates that all the table's rows were written (as opposed to the changed rows only).
+     * @param numDeletes Number of deleted keys written (delta checkpoints only).
      */
-    virtual void TaskDone(Table* table, uint32_t numSegs, bool success);
+    virtual void TaskDone(Table* table, uint32_t numSegs, bool success, bool isFull, uint64_t numDeletes);
 
     virtual bool ShouldStop() const
     {
@@ -199,6 +202,30 @@ public:
         uint32_t m_maxSegId;
     };
 
+    struct DeltaFileEntry {
+        uint32_t m_tableId;
+        uint32_t m_isFull;
+        uint64_t m_numDeletes;
+    };
+
+    /**
+     * @brief Reads the descriptor file of a delta checkpoint
+     * @param checkpointId The checkpoint id.
+     * @param prevId The returned id of the checkpoint that the delta is based on.
+     * @param entries Optional list that receives the descriptor's per table entries.
+     * @return Int value where 1 denotes a delta checkpoint, 0 a full checkpoint and -1 an error.
+     */
+    static int ReadDeltaFile(uint64_t checkpointId, uint64_t& prevId, std::list<DeltaFileEntry>* entries);
+
+    /**
+     * @brief Retrieves the chain of checkpoints needed to restore a given checkpoint
+     * @param checkpointId The checkpoint id.
+     * @param chain The returned chain. The first element is the given checkpoint id and the last one is the
+     * full checkpoint that the chain is based on.
+     * @return Boolean value denoting success or failure.
+     */
+    static bool GetCheckpointChain(uint64_t checkpointId, std::vector<uint64_t>& chain);
+
 private:
     RwLock m_lock;
 
@@ -232,6 +259,17 @@ private:
 
     std::list<MapFileEntry*> m_mapfileInfo;
 
+    std::list<DeltaFileEntry*> m_deltaInfo;
+
+    // Maximal number of consecutive delta checkpoints, 0 disables delta checkpoints
+    uint32_t m_maxDeltas;
+
+    // Indicates that the current checkpoint captures only the rows changed since the last checkpoint
+    bool m_isDeltaCheckpoint;
+
+    // Set after a failed or aborted checkpoint, as its changes tracking can no longer be trusted
+    std::atomic_bool m_fullCheckpointRequired;
+
     // Checkpoint segments size threshold
     uint32_t m_cpSegThreshold;
 
@@ -385,6 +423,25 @@ private:
      */
     bool CreateEndFile();
 
+    /**
+     * @brief Creates the descriptor file of a delta checkpoint.
+     * @return Boolean value denoting success or failure.
+     */
+    bool CreateDeltaFile();
+
+    /**
+     * @brief Returns the changes tracking epoch of a committing transaction. Changes committed before the
+     * capture phase belong to the current checkpoint, later ones to the next checkpoint.
+     * @param txnMan Transaction's TxnManger pointer.
+     */
+    inline bool GetDeltaEpoch(TxnManager* txnMan) const
+    {
+        if (txnMan->m_checkpointPhase == CAPTURE || txnMan->m_checkpointPhase == COMPLETE) {
+            return txnMan->m_checkpointNABit;
+        }
+        return !txnMan->m_checkpointNABit;
+    }
+
     /**
      * @brief Serializes inProcess transactions to disk
      * @return RC value denoting the status of the operation.
@@ -26,6 +26,8 @@
 #include "checkpoint_utils.h"
 #include "utilities.h"
 #include "mot_error.h"
+#include "lz4.h"
+#include "port/pg_crc32c.h"
 
 namespace MOT {
 DECLARE_LOGGER(CheckpointUtils, Checkpoint);
@@ -141,6 +143,131 @@ bool SeekFile(int fd, uint64_t offset)
     return (rc != -1);
 }
 
+static bool ReadFull(int fd, char* data, size_t len)
+{
+    size_t total = 0;
+    while (total < len) {
+        ssize_t bytesRead = read(fd, (void*)(data + total), len - total);
+        if (bytesRead == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            MOT_REPORT_SYSTEM_ERROR(
+                read, "N/A", "Failed to read %u bytes into %p from file descriptor %d", (unsigned)len, data, fd);
+            return false;
+        }
+        if (bytesRead == 0) {
+            MOT_LOG_ERROR("ReadFull: unexpected end of file (fd: %d, read %u of %u bytes)",
+                fd,
+                (unsigned)total,
+                (unsigned)len);
+            return false;
+        }
+        total += (size_t)bytesRead;
+    }
+    return true;
+}
+
+static uint32_t ComputeBlockCrc(const char* data, uint32_t len)
+{
+    pg_crc32c crc;
+    INIT_CRC32C(crc);
+    COMP_CRC32C(crc, data, len);
+    FIN_CRC32C(crc);
+    return (uint32_t)crc;
+}
+
+uint32_t GetMaxStoredBlockSize(uint32_t rawLen)
+{
+    return (uint32_t)LZ4_compressBound((int)rawLen);
+}
+
+bool WriteBlock(int fd, const char* data, uint32_t len, bool compress)
+{
+    BlockHeader header = {blockFormatVersion, 0, len, len, 0};
+    const char* stored = data;
+    char* compressBuf = nullptr;
+
+    if (len > maxBlockSize) {
+        MOT_LOG_ERROR("WriteBlock: block size %u exceeds the maximum of %u", len, maxBlockSize);
+        return false;
+    }
+
+    if (compress && len > 0) {
+        int bound = LZ4_compressBound((int)len);
+        compressBuf = new (std::nothrow) char[bound];
+        if (compressBuf != nullptr) {
+            int compressedLen = LZ4_compress_default(data, compressBuf, (int)len, bound);
+            // keep the block uncompressed if compression does not save space
+            if (compressedLen > 0 && (uint32_t)compressedLen < len) {
+                header.m_flags |= blockFlagCompressed;
+                header.m_dataLen = (uint32_t)compressedLen;
+                stored = compressBuf;
+            }
+        } else {
+            MOT_LOG_WARN("WriteBlock: failed to allocate %d bytes for compression, writing uncompressed block", bound);
+        }
+    }
+
+    header.m_crc = ComputeBlockCrc(stored, header.m_dataLen);
+    bool ret = (WriteFile(fd, (char*)&header, sizeof(BlockHeader)) == sizeof(BlockHeader));
+    if (ret && header.m_dataLen > 0) {
+        ret = (WriteFile(fd, (char*)stored, header.m_dataLen) == header.m_dataLen);
+    }
+    if (!ret) {
+        MOT_LOG_ERROR("WriteBlock: failed to write block of %u bytes to [%d]", header.m_dataLen, fd);
+    }
+
+    if (compressBuf != nullptr) {
+        delete[] compressBuf;
+    }
+    return ret;
+}
+
+bool ReadBlock(int fd, char* storedBuf, char* data, uint32_t& len)
+{
+    BlockHeader header;
+    if (!ReadFull(fd, (char*)&header, sizeof(BlockHeader))) {
+        MOT_LOG_ERROR("ReadBlock: failed to read block header");
+        return false;
+    }
+
+    if (header.m_version != blockFormatVersion || header.m_rawLen > maxBlockSize ||
+        header.m_dataLen > GetMaxStoredBlockSize(maxBlockSize) ||
+        (!(header.m_flags & blockFlagCompressed) && header.m_dataLen != header.m_rawLen)) {
+        MOT_LOG_ERROR("ReadBlock: invalid block header (version: %u, flags: %u, rawLen: %u, dataLen: %u)",
+            header.m_version,
+            header.m_flags,
+            header.m_rawLen,
+            header.m_dataLen);
+        return false;
+    }
+
+    char* stored = (header.m_flags & blockFlagCompressed) ? storedBuf : data;
+    if (header.m_dataLen > 0 && !ReadFull(fd, stored, header.m_dataLen)) {
+        MOT_LOG_ERROR("ReadBlock: failed to read block data (%u bytes)", header.m_dataLen);
+        return false;
+    }
+
+    if (ComputeBlockCrc(stored, header.m_dataLen) != header.m_crc) {
+        MOT_LOG_ERROR("ReadBlock: block checksum mismatch (dataLen: %u)", header.m_dataLen);
+        return false;
+    }
+
+    if (header.m_flags & blockFlagCompressed) {
+        int rawLen = LZ4_decompress_safe(storedBuf, data, (int)header.m_dataLen, (int)maxBlockSize);
+        if (rawLen < 0 || (uint32_t)rawLen != header.m_rawLen) {
+            MOT_LOG_ERROR("ReadBlock: failed to decompress block (expected %u bytes, result %d)",
+                header.m_rawLen,
+                rawLen);
+            return false;
+        }
+    }
+
+    len = header.m_rawLen;
+    return true;
+}
+
 bool GetWorkingDir(std::string& dir)
 {
     dir.clear();
@@ -28,6 +28,7 @@
 #include "row.h"
 #include <thread>
 #include "mot_engine.h"
+#include "buffer.h"
 #include <unistd.h>
 #include <sys/types.h>
 #include <sys/stat.h>
@@ -35,6 +36,9 @@
 
 const uint64_t CP_MGR_MAGIC = 0xaabbccdd;
 
+// Data files whose rows are stored in checksummed (and optionally compressed) blocks
+const uint64_t CP_MGR_BLOCK_MAGIC = 0xaabbccde;
+
 namespace MOT {
 namespace CheckpointUtils {
 
@@ -180,9 +184,24 @@ static const char* tpcFileSuffix = ".tpc";
 // End file suffix
 static const char* validFileSuffix = ".end";
 
+// Delta descriptor file suffix
+static const char* deltaFileSuffix = ".delta";
+
+// Deleted keys file suffix
+static const char* delFileSuffix = ".del";
+
 // Max path len
 static const size_t maxPath = 1024;
 
+// Data file block format version
+static const uint16_t blockFormatVersion = 1;
+
+// Block flag denoting LZ4 compressed block data
+static const uint16_t blockFlagCompressed = 0x1;
+
+// Max size of the uncompressed data of a block
+static const uint32_t maxBlockSize = DEFAULT_BUFFER_SIZE;
+
 /**
  * @brief Returns the current working directory.
  * @param dir The returned directory string.
@@ -300,6 +319,33 @@ inline void MakeEndFilename(std::string& fileName, std::string& workingDir, uint
     fileName.append(validFileSuffix);
 }
 
+/**
+ * @brief Creates a delta checkpoint descriptor filename
+ * @param fileName The returned filename string.
+ * @param workingDir The directory in which the file should be located.
+ * @param cpId The checkpoint id.
+ */
+inline void MakeDeltaFilename(std::string& fileName, std::string& workingDir, uint64_t cpId)
+{
+    MakeFilename(fileName, workingDir);
+    fileName.append(std::to_string(cpId));
+    fileName.append(deltaFileSuffix);
+}
+
+/**
+ * @brief Creates a delta checkpoint deleted keys filename
+ * @param tableId The tabled id that this file contains.
+ * @param fileName The returned filename string.
+ * @param workingDir The directory in which the file should be located.
+ */
+inline void MakeDelFilename(uint64_t tableId, std::string& fileName, std::string& workingDir)
+{
+    MakeFilename(fileName, workingDir);
+    fileName.append("tab_");
+    fileName.append(std::to_string(tableId));
+    fileName.append(delFileSuffix);
+}
+
 /**
  * @brief Sets the cpu affinity for a given thread
  * @param cpu The cpu that the thread should run on.
@@ -338,6 +384,56 @@ struct MapFileHeader {
     uint64_t m_numEntries;
 };
 
+/**
+ * @struct DeltaFileHeader
+ * @brief Header of the descriptor file found in delta checkpoints only. A delta checkpoint holds the rows
+ * changed since the previous checkpoint, identified by m_prevId, which may be a delta checkpoint itself.
+ */
+struct DeltaFileHeader {
+    uint64_t m_magic;
+    uint64_t m_prevId;
+    uint64_t m_numEntries;
+};
+
+/**
+ * @struct BlockHeader
+ * @brief Header of a data file block. A block holds whole entries (entry header, key and row data), and its
+ * data is followed by the next block header. The checksum covers the data as stored in the file.
+ */
+struct BlockHeader {
+    uint16_t m_version;
+    uint16_t m_flags;
+    uint32_t m_rawLen;
+    uint32_t m_dataLen;
+    uint32_t m_crc;
+};
+
+/**
+ * @brief Returns the max size of a block's data as stored in the file
+ * @param rawLen The size of the uncompressed block data.
+ */
+uint32_t GetMaxStoredBlockSize(uint32_t rawLen);
+
+/**
+ * @brief Writes a data file block
+ * @param fd The file descriptor to write to.
+ * @param data The block's uncompressed data.
+ * @param len The block's uncompressed data length.
+ * @param compress Indicates that the block should be compressed.
+ * @return Boolean value denoting success or failure.
+ */
+bool WriteBlock(int fd, const char* data, uint32_t len, bool compress);
+
+/**
+ * @brief Reads the next data file block, verifies its checksum and decompresses it
+ * @param fd The file descriptor to read from.
+ * @param storedBuf A buffer of GetMaxStoredBlockSize(maxBlockSize) bytes for the stored data.
+ * @param data The returned uncompressed data, a buffer of maxBlockSize bytes.
+ * @param len The returned uncompressed data length.
+ * @return Boolean value denoting success or failure.
+ */
+bool ReadBlock(int fd, char* storedBuf, char* data, uint32_t& len);
+
 struct TpcFileHeader {
     uint64_t m_magic;
     uint64_t m_numEntries;
@@ -30,6 +30,7 @@
 #include "checkpoint_utils.h"
 #include "checkpoint_worker.h"
 #include "checkpoint_manager.h"
+#include "checkpoint_ctrlfile.h"
 #include "mot_engine.h"
 
 namespace MOT {
@@ -49,6 +50,10 @@ void CheckpointWorkerPool::Start()
     if (!CheckpointManager::CreateCheckpointDir(m_workingDir))
         m_cpManager.OnError(ErrCodes::FILE_IO, "failed to create working dir", m_workingDir.c_str());
 
+    if (m_prevCheckpointId != CheckpointControlFile::invalidId &&
+        !CheckpointUtils::SetWorkingDir(m_prevWorkingDir, m_prevCheckpointId))
+        m_cpManager.OnError(ErrCodes::FILE_IO, "failed to setup previous checkpoint working dir");
+
     WorkerThreads* threads = new (std::nothrow) WorkerThreads();
     if (threads == nullptr) {
         m_cpManager.OnError(ErrCodes::MEMORY, "failed to allocate checkpoint thread pool");
@@ -87,8 +92,10 @@ bool CheckpointWorkerPool::Write(Buffer* buffer, Row* row, int fd)
     if (buffer->Size() + primaryKey->GetKeyLength() + row->GetTupleSize() + sizeof(CheckpointUtils::EntryHeader) >
         buffer->MaxSize()) {
         // need to flush the buffer before serializing the next row
-        size_t wrSta = CheckpointUtils::WriteFile(fd, (char*)buffer->Data(), buffer->Size());
-        if (wrSta != buffer->Size()) {
+        if (!CheckpointUtils::WriteBlock(fd,
+                (const char*)buffer->Data(),
+                buffer->Size(),
+                GetGlobalConfiguration().m_enableCheckpointCompression)) {
             MOT_LOG_ERROR("CheckpointWorkerPool::write - failed to write %u bytes to [%d] (%d:%s)",
                 buffer->Size(),
                 fd,
@@ -124,7 +131,8 @@ bool CheckpointWorkerPool::Write(Buffer* buffer, Row* row, int fd)
     return true;
 }
 
-int CheckpointWorkerPool::Checkpoint(Buffer* buffer, Sentinel* sentinel, int fd, uint16_t threadId, bool& isDeleted)
+int CheckpointWorkerPool::Checkpoint(
+    Buffer* buffer, Sentinel* sentinel, int fd, uint16_t threadId, bool& isDeleted, bool fullCapture)
 {
     Row* mainRow = sentinel->GetData();
     Row* stableRow = nullptr;
@@ -159,20 +167,28 @@ int CheckpointWorkerPool::Checkpoint(Buffer* buffer, Sentinel* sentinel, int fd,
 
     MOT_ASSERT(sentinel->GetStablePreAllocStatus() == false);
 
+    /* reset the changes tracking of the captured epoch, and skip unchanged rows in a delta capture */
+    bool skipWrite = false;
+    if (sentinel->GetDeltaStatus(!m_na)) {
+        sentinel->SetDeltaStatus(!m_na, false);
+    } else {
+        skipWrite = !fullCapture;
+    }
+
     do {
         if (statusBit == !m_na) { /* has stable version */
             if (stableRow == nullptr) {
                 break;
             }
 
-            if (!Write(buffer, stableRow, fd)) {
+            if (!skipWrite && !Write(buffer, stableRow, fd)) {
                 wrote = -1;
             } else {
                 if (isDeleted == false) {
                     CheckpointUtils::DestroyStableRow(stableRow);
                     sentinel->SetStable(nullptr);
                 }
-                wrote = 1;
+                wrote = skipWrite ? 0 : 1;
             }
             break;
         } else { /* no stable version */
@@ -182,7 +198,9 @@ int CheckpointWorkerPool::Checkpoint(Buffer* buffer, Sentinel* sentinel, int fd,
                     break;
                 }
                 sentinel->SetStableStatus(!m_na);
-                if (!Write(buffer, mainRow, fd)) {
+                if (skipWrite) {
+                    wrote = 0;
+                } else if (!Write(buffer, mainRow, fd)) {
                     wrote = -1;  // we failed to write, set error
                 } else {
                     wrote = 1;
@@ -277,6 +295,8 @@ void CheckpointWorkerPool::WorkerFunc()
         uint64_t exId = 0;
         uint32_t maxSegId = 0;
         bool taskSucceeded = false;
+        bool fullCapture = true;
+        uint64_t numDeletes = 0;
 
         if (m_cpManager.ShouldStop()) {
             break;
@@ -288,6 +308,15 @@ void CheckpointWorkerPool::WorkerFunc()
                 tableId = table->GetTableId();
                 exId = table->GetTableExId();
 
+                // The deleted keys of the captured epoch are taken even in a full checkpoint, so they will not be
+                // written by the next delta checkpoint.
+                Table::DeltaDeletedKeyList deletedKeys;
+                table->TakeDeltaDeletedKeys(!m_na, deletedKeys);
+                bool fullRequested = table->ConsumeFullCheckpointRequest();
+                if (m_prevCheckpointId != CheckpointControlFile::invalidId) {
+                    fullCapture = fullRequested || IsFullCaptureRequired(table);
+                }
+
                 ErrCodes errCode = WriteTableMetadataFile(table);
                 if (errCode != ErrCodes::SUCCESS) {
                     MOT_LOG_ERROR(
@@ -301,7 +330,8 @@ void CheckpointWorkerPool::WorkerFunc()
                 uint64_t numOps = 0;
                 clock_gettime(CLOCK_MONOTONIC, &start);
 
-                errCode = WriteTableDataFile(table, &buffer, deletedList, gcSession, threadId, maxSegId, numOps);
+                errCode = WriteTableDataFile(
+                    table, &buffer, deletedList, gcSession, threadId, maxSegId, numOps, fullCapture);
                 if (errCode != ErrCodes::SUCCESS) {
                     MOT_LOG_ERROR(
                         "CheckpointWorkerPool::WorkerFunc: failed to write table data file for table %u", tableId);
@@ -310,6 +340,18 @@ void CheckpointWorkerPool::WorkerFunc()
                     break;
                 }
 
+                if (!fullCapture && !deletedKeys.empty()) {
+                    errCode = WriteTableDeletesFile(table, deletedKeys);
+                    if (errCode != ErrCodes::SUCCESS) {
+                        MOT_LOG_ERROR(
+                            "CheckpointWorkerPool::WorkerFunc: failed to write deletes file for table %u", tableId);
+                        m_cpManager.OnError(
+                            errCode, "Failed to write deletes file for table - ", std::to_string(tableId).c_str());
+                        break;
+                    }
+                    numDeletes = deletedKeys.size();
+                }
+
                 taskSucceeded = true;
                 clock_gettime(CLOCK_MONOTONIC, &end);
                 /*
@@ -324,7 +366,7 @@ void CheckpointWorkerPool::WorkerFunc()
                     numOps);
             } while (0);
 
-            m_cpManager.TaskDone(table, maxSegId, taskSucceeded);
+            m_cpManager.TaskDone(table, maxSegId, taskSucceeded, fullCapture, numDeletes);
 
             if (!taskSucceeded) {
                 break;
@@ -348,7 +390,7 @@ bool CheckpointWorkerPool::BeginFile(int& fd, uint32_t tableId, int seg, uint64_
         return false;
     }
     MOT_LOG_DEBUG("CheckpointWorkerPool::beginFile: %s", fileName.c_str());
-    CheckpointUtils::FileHeader fileHeader{CP_MGR_MAGIC, tableId, exId, 0};
+    CheckpointUtils::FileHeader fileHeader{CP_MGR_BLOCK_MAGIC, tableId, exId, 0};
     if (CheckpointUtils::WriteFile(fd, (char*)&fileHeader, sizeof(CheckpointUtils::FileHeader)) !=
         sizeof(CheckpointUtils::FileHeader)) {
         MOT_LOG_ERROR("CheckpointWorkerPool::BeginFile: failed to write file header: %s", fileName.c_str());
@@ -367,7 +409,7 @@ bool CheckpointWorkerPool::FinishFile(int& fd, uint32_t tableId, uint64_t numOps
             MOT_LOG_ERROR("CheckpointWorkerPool::FinishFile: failed to seek in file (id: %u)", tableId);
             break;
         }
-        CheckpointUtils::FileHeader fileHeader{CP_MGR_MAGIC, tableId, exId, numOps};
+        CheckpointUtils::FileHeader fileHeader{CP_MGR_BLOCK_MAGIC, tableId, exId, numOps};
         if (CheckpointUtils::WriteFile(fd, (char*)&fileHeader, sizeof(CheckpointUtils::FileHeader)) !=
             sizeof(CheckpointUtils::FileHeader)) {
             MOT_LOG_ERROR("CheckpointWorkerPool::FinishFile: failed to write to file (id: %u)", tableId);
@@ -458,7 +500,10 @@ CheckpointWorkerPool::ErrCodes CheckpointWorkerPool::WriteTableMetadataFile(Tabl
 bool CheckpointWorkerPool::FlushBuffer(int fd, Buffer* buffer)
 {
     if (buffer->Size() > 0) {  // there is data in the buffer that needs to be written
-        if (CheckpointUtils::WriteFile(fd, (char*)buffer->Data(), buffer->Size()) != buffer->Size()) {
+        if (!CheckpointUtils::WriteBlock(fd,
+                (const char*)buffer->Data(),
+                buffer->Size(),
+                GetGlobalConfiguration().m_enableCheckpointCompression)) {
             return false;
         }
         buffer->Reset();
@@ -467,7 +512,8 @@ bool CheckpointWorkerPool::FlushBuffer(int fd, Buffer* buffer)
 }
 
 CheckpointWorkerPool::ErrCodes CheckpointWorkerPool::WriteTableDataFile(Table* table, Buffer* buffer,
-    Sentinel** deletedList, GcManager* gcSession, uint16_t threadId, uint32_t& maxSegId, uint64_t& numOps)
+    Sentinel** deletedList, GcManager* gcSession, uint16_t threadId, uint32_t& maxSegId, uint64_t& numOps,
+    bool fullCapture)
 {
     uint32_t tableId = table->GetTableId();
     uint64_t exId = table->GetTableExId();
@@ -508,7 +554,7 @@ CheckpointWorkerPool::ErrCodes CheckpointWorkerPool::WriteTableDataFile(Table* t
             it->Next();
             continue;
         }
-        int ckptStatus = Checkpoint(buffer, sentinel, fd, threadId, isDeleted);
+        int ckptStatus = Checkpoint(buffer, sentinel, fd, threadId, isDeleted, fullCapture);
         if (isDeleted) {
             deletedList[deletedListLocation++] = sentinel;
             ExecuteMicroGcTransaction(deletedList, gcSession, table, deletedListLocation, DELETE_LIST_SIZE);
@@ -598,4 +644,91 @@ CheckpointWorkerPool::ErrCodes CheckpointWorkerPool::WriteTableDataFile(Table* t
     numOps += currFileOps;
     return ErrCodes::SUCCESS;
 }
+
+bool CheckpointWorkerPool::IsFullCaptureRequired(Table* table)
+{
+    uint32_t tableId = table->GetTableId();
+    int fd = -1;
+    std::string fileName;
+    CheckpointUtils::MakeMdFilename(tableId, fileName, m_prevWorkingDir);
+    if (!CheckpointUtils::IsFileExists(fileName)) {
+        MOT_LOG_DEBUG("CheckpointWorkerPool::IsFullCaptureRequired: table %u is new", tableId);
+        return true;
+    }
+
+    if (!CheckpointUtils::OpenFileRead(fileName, fd)) {
+        MOT_LOG_WARN("CheckpointWorkerPool::IsFullCaptureRequired: failed to open md file: %s", fileName.c_str());
+        return true;
+    }
+
+    bool ret = true;
+    CheckpointUtils::MetaFileHeader mFileHeader;
+    if (CheckpointUtils::ReadFile(fd, (char*)&mFileHeader, sizeof(CheckpointUtils::MetaFileHeader)) !=
+        sizeof(CheckpointUtils::MetaFileHeader)) {
+        MOT_LOG_WARN("CheckpointWorkerPool::IsFullCaptureRequired: failed to read md file: %s", fileName.c_str());
+    } else if (mFileHeader.m_fileHeader.m_magic == CP_MGR_MAGIC &&
+               mFileHeader.m_fileHeader.m_exId == table->GetTableExId()) {
+        ret = false;
+    }
+
+    (void)CheckpointUtils::CloseFile(fd);
+    return ret;
+}
+
+CheckpointWorkerPool::ErrCodes CheckpointWorkerPool::WriteTableDeletesFile(
+    Table* table, const Table::DeltaDeletedKeyList& keys)
+{
+    uint32_t tableId = table->GetTableId();
+    uint64_t exId = table->GetTableExId();
+    int fd = -1;
+
+    std::string fileName;
+    CheckpointUtils::MakeDelFilename(tableId, fileName, m_workingDir);
+    if (!CheckpointUtils::OpenFileWrite(fileName, fd)) {
+        MOT_LOG_ERROR("CheckpointWorkerPool::WriteTableDeletesFile: failed to create file: %s", fileName.c_str());
+        return ErrCodes::FILE_IO;
+    }
+
+    ErrCodes errCode = ErrCodes::FILE_IO;
+    do {
+        CheckpointUtils::FileHeader fileHeader{CP_MGR_MAGIC, tableId, exId, keys.size()};
+        if (CheckpointUtils::WriteFile(fd, (char*)&fileHeader, sizeof(CheckpointUtils::FileHeader)) !=
+            sizeof(CheckpointUtils::FileHeader)) {
+            MOT_LOG_ERROR("CheckpointWorkerPool::WriteTableDeletesFile: failed to write header: %s", fileName.c_str());
+            break;
+        }
+
+        bool entriesWritten = true;
+        for (const auto& key : keys) {
+            CheckpointUtils::EntryHeader entryHeader;
+            entryHeader.m_csn = key.first;
+            entryHeader.m_rowId = 0;
+            entryHeader.m_dataLen = 0;
+            entryHeader.m_keyLen = (uint16_t)key.second.size();
+            if (CheckpointUtils::WriteFile(fd, (char*)&entryHeader, sizeof(CheckpointUtils::EntryHeader)) !=
+                    sizeof(CheckpointUtils::EntryHeader) ||
+                CheckpointUtils::WriteFile(fd, (char*)key.second.data(), key.second.size()) != key.second.size()) {
+                MOT_LOG_ERROR(
+                    "CheckpointWorkerPool::WriteTableDeletesFile: failed to write entry: %s", fileName.c_str());
+                entriesWritten = false;
+                break;
+            }
+        }
+        if (!entriesWritten) {
+            break;
+        }
+
+        if (CheckpointUtils::FlushFile(fd)) {
+            MOT_LOG_ERROR("CheckpointWorkerPool::WriteTableDeletesFile: failed to flush file: %s", fileName.c_str());
+            break;
+        }
+        errCode = ErrCodes::SUCCESS;
+    } while (0);
+
+    if (CheckpointUtils::CloseFile(fd)) {
+        MOT_LOG_ERROR("CheckpointWorkerPool::WriteTableDeletesFile: failed to close file: %s", fileName.c_str());
+        errCode = ErrCodes::FILE_IO;
+    }
+    return errCode;
+}
 }  // namespace MOT
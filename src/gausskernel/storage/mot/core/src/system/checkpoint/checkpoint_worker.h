@@ -34,6 +34,7 @@
 #include "global.h"
 #include "buffer.h"
 #include "mm_gc_manager.h"
+#include "table.h"
 
 namespace MOT {
 const int CHECKPOINT_BUFFER_SIZE = 4096 * 1000;
@@ -51,8 +52,10 @@ public:
      * @param table The table's pointer.
      * @param numSegs number of segments written.
      * @param success Indicates a success or a failure.
+     * @param isFull Indicates that all the table's rows were written (as opposed to the changed rows only).
+     * @param numDeletes Number of deleted keys written (delta checkpoints only).
      */
-    virtual void TaskDone(Table* table, uint32_t numSegs, bool success) = 0;
+    virtual void TaskDone(Table* table, uint32_t numSegs, bool success, bool isFull, uint64_t numDeletes) = 0;
 
     /**
      * @brief Checks if the thread should terminate it work
@@ -78,8 +81,15 @@ public:
  */
 class CheckpointWorkerPool {
 public:
-    CheckpointWorkerPool(int n, bool b, std::list<Table*>& l, uint32_t s, uint64_t id, CheckpointManagerCallbacks& m)
-        : m_numWorkers(n), m_tasksList(l), m_checkpointId(id), m_na(b), m_cpManager(m), m_checkpointSegsize(s)
+    CheckpointWorkerPool(int n, bool b, std::list<Table*>& l, uint32_t s, uint64_t id, uint64_t prevId,
+        CheckpointManagerCallbacks& m)
+        : m_numWorkers(n),
+          m_tasksList(l),
+          m_checkpointId(id),
+          m_prevCheckpointId(prevId),
+          m_na(b),
+          m_cpManager(m),
+          m_checkpointSegsize(s)
     {
         Start();
     }
@@ -114,9 +124,10 @@ private:
      * @param fd The file descriptor to write to.
      * @param threadId The thread id.
      * @param isDeleted The row delete status.
+     * @param fullCapture Write the row even if it was not changed since the previous checkpoint.
      * @return -1 on error, 0 if nothing was written and 1 if the row was written.
      */
-    int Checkpoint(Buffer* buffer, Sentinel* sentinel, int fd, uint16_t threadId, bool& isDeleted);
+    int Checkpoint(Buffer* buffer, Sentinel* sentinel, int fd, uint16_t threadId, bool& isDeleted, bool fullCapture);
 
     /**
      * @brief Pops a task (table pointer) from the tasks queue.
@@ -169,10 +180,27 @@ private:
      * @param threadId The thread id.
      * @param maxSegId The maximum segment ID of the table.
      * @param numOps The number of rows written.
+     * @param fullCapture Write all the rows, or only the rows changed since the previous checkpoint.
      * @return Returns the error code of type ErrCodes.
      */
     ErrCodes WriteTableDataFile(Table* table, Buffer* buffer, Sentinel** deletedList, GcManager* gcSession,
-        uint16_t threadId, uint32_t& maxSegId, uint64_t& numOps);
+        uint16_t threadId, uint32_t& maxSegId, uint64_t& numOps, bool fullCapture);
+
+    /**
+     * @brief Writes the keys of the rows deleted since the previous checkpoint to the deletes file.
+     * @param table The table's pointer.
+     * @param keys The deleted keys and their deletion commit sequence numbers.
+     * @return Returns the error code of type ErrCodes.
+     */
+    ErrCodes WriteTableDeletesFile(Table* table, const Table::DeltaDeletedKeyList& keys);
+
+    /**
+     * @brief Checks whether a table must be fully written in a delta checkpoint, since the previous
+     * checkpoint does not hold the same table.
+     * @param table The table's pointer.
+     * @return True if all the table's rows should be written.
+     */
+    bool IsFullCaptureRequired(Table* table);
 
     bool FlushBuffer(int fd, Buffer* buffer);
 
@@ -193,6 +221,12 @@ private:
     // Checkpoint's id
     uint64_t m_checkpointId;
 
+    // The checkpoint that a delta checkpoint is based on, invalid for a full checkpoint
+    uint64_t m_prevCheckpointId;
+
+    // The directory of the checkpoint that a delta checkpoint is based on
+    std::string m_prevWorkingDir;
+
     // The current NotAvailable bit
     bool m_na;
 
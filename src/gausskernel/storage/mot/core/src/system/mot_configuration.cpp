@@ -58,6 +58,7 @@ constexpr const char* MOTConfiguration::DEFAULT_GROUP_COMMIT_TIMEOUT;
 constexpr uint64_t MOTConfiguration::DEFAULT_GROUP_COMMIT_TIMEOUT_USEC;
 constexpr uint64_t MOTConfiguration::MIN_GROUP_COMMIT_TIMEOUT_USEC;
 constexpr uint64_t MOTConfiguration::MAX_GROUP_COMMIT_TIMEOUT_USEC;
+constexpr bool MOTConfiguration::DEFAULT_ENABLE_ADAPTIVE_GROUP_COMMIT;
 // checkpoint configuration members
 constexpr bool MOTConfiguration::DEFAULT_ENABLE_CHECKPOINT;
 constexpr bool MOTConfiguration::DEFAULT_ENABLE_INCREMENTAL_CHECKPOINT;
@@ -69,10 +70,23 @@ constexpr uint64_t MOTConfiguration::MAX_CHECKPOINT_SEGSIZE_BYTES;
 constexpr uint32_t MOTConfiguration::DEFAULT_CHECKPOINT_WORKERS;
 constexpr uint32_t MOTConfiguration::MIN_CHECKPOINT_WORKERS;
 constexpr uint32_t MOTConfiguration::MAX_CHECKPOINT_WORKERS;
+constexpr uint32_t MOTConfiguration::DEFAULT_CHECKPOINT_MAX_DELTAS;
+constexpr uint32_t MOTConfiguration::MIN_CHECKPOINT_MAX_DELTAS;
+constexpr uint32_t MOTConfiguration::MAX_CHECKPOINT_MAX_DELTAS;
+constexpr bool MOTConfiguration::DEFAULT_ENABLE_CHECKPOINT_COMPRESSION;
 // recovery configuration members
 constexpr uint32_t MOTConfiguration::DEFAULT_CHECKPOINT_RECOVERY_WORKERS;
 constexpr uint32_t MOTConfiguration::MIN_CHECKPOINT_RECOVERY_WORKERS;
 constexpr uint32_t MOTConfiguration::MAX_CHECKPOINT_RECOVERY_WORKERS;
+constexpr uint32_t MOTConfiguration::DEFAULT_PARALLEL_REDO_WORKERS;
+constexpr uint32_t MOTConfiguration::MIN_PARALLEL_REDO_WORKERS;
+constexpr uint32_t MOTConfiguration::MAX_PARALLEL_REDO_WORKERS;
+constexpr uint32_t MOTConfiguration::DEFAULT_HOT_ROW_CONFLICT_THRESHOLD;
+constexpr uint32_t MOTConfiguration::MIN_HOT_ROW_CONFLICT_THRESHOLD;
+constexpr uint32_t MOTConfiguration::MAX_HOT_ROW_CONFLICT_THRESHOLD;
+constexpr uint32_t MOTConfiguration::DEFAULT_HOT_ROW_COOLDOWN;
+constexpr uint32_t MOTConfiguration::MIN_HOT_ROW_COOLDOWN;
+constexpr uint32_t MOTConfiguration::MAX_HOT_ROW_COOLDOWN;
 constexpr bool MOTConfiguration::DEFAULT_ENABLE_LOG_RECOVERY_STATS;
 // machine configuration members
 constexpr uint16_t MOTConfiguration::DEFAULT_NUMA_NODES;
@@ -169,6 +183,9 @@ constexpr const char* MOTConfiguration::DEFAULT_GC_HIGH_RECLAIM_THRESHOLD;
 constexpr uint64_t MOTConfiguration::DEFAULT_GC_HIGH_RECLAIM_THRESHOLD_BYTES;
 constexpr uint64_t MOTConfiguration::MIN_GC_HIGH_RECLAIM_THRESHOLD_BYTES;
 constexpr uint64_t MOTConfiguration::MAX_GC_HIGH_RECLAIM_THRESHOLD_BYTES;
+constexpr uint32_t MOTConfiguration::DEFAULT_GC_RECLAIM_THREADS_PER_NODE;
+constexpr uint32_t MOTConfiguration::MIN_GC_RECLAIM_THREADS_PER_NODE;
+constexpr uint32_t MOTConfiguration::MAX_GC_RECLAIM_THREADS_PER_NODE;
 // JIT configuration members
 constexpr bool MOTConfiguration::DEFAULT_ENABLE_MOT_CODEGEN;
 constexpr bool MOTConfiguration::DEFAULT_FORCE_MOT_PSEUDO_CODEGEN;
@@ -446,15 +463,21 @@ MOTConfiguration::MOTConfiguration()
       m_enableGroupCommit(DEFAULT_ENABLE_GROUP_COMMIT),
       m_groupCommitSize(DEFAULT_GROUP_COMMIT_SIZE),
       m_groupCommitTimeoutUSec(DEFAULT_GROUP_COMMIT_TIMEOUT_USEC),
+      m_enableAdaptiveGroupCommit(DEFAULT_ENABLE_ADAPTIVE_GROUP_COMMIT),
       m_enableCheckpoint(DEFAULT_ENABLE_CHECKPOINT),
       m_enableIncrementalCheckpoint(DEFAULT_ENABLE_INCREMENTAL_CHECKPOINT),
       m_checkpointDir(DEFAULT_CHECKPOINT_DIR),
       m_checkpointSegThreshold(DEFAULT_CHECKPOINT_SEGSIZE_BYTES),
       m_checkpointWorkers(DEFAULT_CHECKPOINT_WORKERS),
+      m_checkpointMaxDeltas(DEFAULT_CHECKPOINT_MAX_DELTAS),
+      m_enableCheckpointCompression(DEFAULT_ENABLE_CHECKPOINT_COMPRESSION),
       m_checkpointRecoveryWorkers(DEFAULT_CHECKPOINT_RECOVERY_WORKERS),
+      m_parallelRedoWorkers(DEFAULT_PARALLEL_REDO_WORKERS),
       m_abortBufferEnable(true),
       m_preAbort(true),
       m_validationLock(TxnValidation::TXN_VALIDATION_NO_WAIT),
+      m_hotRowConflictThreshold(DEFAULT_HOT_ROW_CONFLICT_THRESHOLD),
+      m_hotRowCooldown(DEFAULT_HOT_ROW_COOLDOWN),
       m_numaNodes(DEFAULT_NUMA_NODES),
       m_coresPerCpu(DEFAULT_CORES_PER_CPU),
       m_dataNodeId(DEFAULT_DATA_NODE_ID),
@@ -499,6 +522,7 @@ MOTConfiguration::MOTConfiguration()
       m_gcReclaimThresholdBytes(DEFAULT_GC_RECLAIM_THRESHOLD_BYTES),
       m_gcReclaimBatchSize(DEFAULT_GC_RECLAIM_BATCH_SIZE),
       m_gcHighReclaimThresholdBytes(DEFAULT_GC_HIGH_RECLAIM_THRESHOLD_BYTES),
+      m_gcReclaimThreadsPerNode(DEFAULT_GC_RECLAIM_THREADS_PER_NODE),
       m_enableCodegen(DEFAULT_ENABLE_MOT_CODEGEN),
       m_forcePseudoCodegen(DEFAULT_FORCE_MOT_PSEUDO_CODEGEN),
       m_enableCodegenPrint(DEFAULT_ENABLE_MOT_CODEGEN_PRINT),
@@ -551,15 +575,21 @@ bool MOTConfiguration::SetFlag(const std::string& name, const std::string& value
     } else if (ParseBool(name, "enable_group_commit", value, &m_enableGroupCommit)) {
     } else if (ParseUint64(name, "group_commit_size", value, &m_groupCommitSize)) {
     } else if (ParseUint64(name, "group_commit_timeout_usec", value, &m_groupCommitTimeoutUSec)) {
+    } else if (ParseBool(name, "enable_adaptive_group_commit", value, &m_enableAdaptiveGroupCommit)) {
     } else if (ParseBool(name, "enable_checkpoint", value, &m_enableCheckpoint)) {
     } else if (ParseBool(name, "enable_incremental_checkpoint", value, &m_enableIncrementalCheckpoint)) {
     } else if (ParseString(name, "checkpoint_dir", value, &m_checkpointDir)) {
     } else if (ParseUint64(name, "checkpoint_segsize", value, &m_checkpointSegThreshold)) {
     } else if (ParseUint32(name, "checkpoint_workers", value, &m_checkpointWorkers)) {
+    } else if (ParseUint32(name, "checkpoint_max_deltas", value, &m_checkpointMaxDeltas)) {
+    } else if (ParseBool(name, "checkpoint_compression", value, &m_enableCheckpointCompression)) {
     } else if (ParseUint32(name, "checkpoint_recovery_workers", value, &m_checkpointRecoveryWorkers)) {
+    } else if (ParseUint32(name, "parallel_redo_workers", value, &m_parallelRedoWorkers)) {
     } else if (ParseBool(name, "abort_buffer_enable", value, &m_abortBufferEnable)) {
     } else if (ParseBool(name, "pre_abort", value, &m_preAbort)) {
     } else if (ParseValidation(name, "validation_lock", value, &m_validationLock)) {
+    } else if (ParseUint32(name, "hot_row_conflict_threshold", value, &m_hotRowConflictThreshold)) {
+    } else if (ParseUint32(name, "hot_row_cooldown", value, &m_hotRowCooldown)) {
     } else if (ParseBool(name, "enable_stats", value, &m_enableStats)) {
     } else if (ParseUint64(name, "stats_period_seconds", value, &m_statPrintPeriodSeconds)) {
     } else if (ParseUint64(name, "full_stats_period_seconds", value, &m_statPrintFullPeriodSeconds)) {
@@ -911,6 +941,8 @@ void MOTConfiguration::LoadConfig()
         SCALE_MICROS,
         MIN_GROUP_COMMIT_TIMEOUT_USEC,
         MAX_GROUP_COMMIT_TIMEOUT_USEC);
+    UPDATE_BOOL_CFG(
+        m_enableAdaptiveGroupCommit, "enable_adaptive_group_commit", DEFAULT_ENABLE_ADAPTIVE_GROUP_COMMIT);
 
     // Checkpoint configuration
     if (m_loadExtraParams) {
@@ -936,6 +968,12 @@ void MOTConfiguration::LoadConfig()
         DEFAULT_CHECKPOINT_WORKERS,
         MIN_CHECKPOINT_WORKERS,
         MAX_CHECKPOINT_WORKERS);
+    UPDATE_INT_CFG(m_checkpointMaxDeltas,
+        "checkpoint_max_deltas",
+        DEFAULT_CHECKPOINT_MAX_DELTAS,
+        MIN_CHECKPOINT_MAX_DELTAS,
+        MAX_CHECKPOINT_MAX_DELTAS);
+    UPDATE_BOOL_CFG(m_enableCheckpointCompression, "checkpoint_compression", DEFAULT_ENABLE_CHECKPOINT_COMPRESSION);
 
     // Recovery configuration
     UPDATE_INT_CFG(m_checkpointRecoveryWorkers,
@@ -943,6 +981,11 @@ void MOTConfiguration::LoadConfig()
         DEFAULT_CHECKPOINT_RECOVERY_WORKERS,
         MIN_CHECKPOINT_RECOVERY_WORKERS,
         MAX_CHECKPOINT_RECOVERY_WORKERS);
+    UPDATE_INT_CFG(m_parallelRedoWorkers,
+        "parallel_redo_workers",
+        DEFAULT_PARALLEL_REDO_WORKERS,
+        MIN_PARALLEL_REDO_WORKERS,
+        MAX_PARALLEL_REDO_WORKERS);
 
     // Tx configuration - not configurable yet
     if (m_loadExtraParams) {
@@ -951,6 +994,18 @@ void MOTConfiguration::LoadConfig()
         m_validationLock = TxnValidation::TXN_VALIDATION_NO_WAIT;
     }
 
+    // hot row locking configuration
+    UPDATE_INT_CFG(m_hotRowConflictThreshold,
+        "hot_row_conflict_threshold",
+        DEFAULT_HOT_ROW_CONFLICT_THRESHOLD,
+        MIN_HOT_ROW_CONFLICT_THRESHOLD,
+        MAX_HOT_ROW_CONFLICT_THRESHOLD);
+    UPDATE_INT_CFG(m_hotRowCooldown,
+        "hot_row_cooldown",
+        DEFAULT_HOT_ROW_COOLDOWN,
+        MIN_HOT_ROW_COOLDOWN,
+        MAX_HOT_ROW_COOLDOWN);
+
     // statistics configuration
     UPDATE_BOOL_CFG(m_enableStats, "enable_stats", DEFAULT_ENABLE_STATS);
     UPDATE_TIME_CFG(m_statPrintPeriodSeconds,
@@ -1007,6 +1062,11 @@ void MOTConfiguration::LoadConfig()
         SCALE_BYTES,
         MIN_GC_HIGH_RECLAIM_THRESHOLD_BYTES,
         MAX_GC_HIGH_RECLAIM_THRESHOLD_BYTES);
+    UPDATE_INT_CFG(m_gcReclaimThreadsPerNode,
+        "reclaim_threads_per_node",
+        DEFAULT_GC_RECLAIM_THREADS_PER_NODE,
+        MIN_GC_RECLAIM_THREADS_PER_NODE,
+        MAX_GC_RECLAIM_THREADS_PER_NODE);
 
     // JIT configuration
     UPDATE_BOOL_CFG(m_enableCodegen, "enable_mot_codegen", DEFAULT_ENABLE_MOT_CODEGEN);
@@ -160,6 +160,9 @@ public:
     /** @var Timeout in micro-seconds of timed group commit flush policies. */
     uint64_t m_groupCommitTimeoutUSec;
 
+    /** @var Enables adaptive sizing of the group commit window (relevant only if group commit is enabled). */
+    bool m_enableAdaptiveGroupCommit;
+
     /**********************************************************************/
     // Checkpoint configuration
     /**********************************************************************/
@@ -178,6 +181,12 @@ public:
     /** @var number of worker threads to spawn to perform checkpoint. */
     uint32_t m_checkpointWorkers;
 
+    /** @var Maximum number of delta checkpoints taken on top of a full checkpoint (0 disables delta checkpoints). */
+    uint32_t m_checkpointMaxDeltas;
+
+    /** @var Compress checkpoint data blocks. */
+    bool m_enableCheckpointCompression;
+
     /**********************************************************************/
     // Recovery configuration
     /**********************************************************************/
@@ -185,6 +194,9 @@ public:
     /** @var Specifies the number of workers used to recover from checkpoint. */
     uint32_t m_checkpointRecoveryWorkers;
 
+    /** @var Specifies the number of workers used to replay redo log records (1 means serial replay). */
+    uint32_t m_parallelRedoWorkers;
+
     /**********************************************************************/
     // Transaction management variables (not configurable)
     /**********************************************************************/
@@ -193,6 +205,12 @@ public:
     bool m_preAbort;
     TxnValidation m_validationLock;
 
+    /** @var Specifies the number of commit-time conflicts after which a row is considered hot. */
+    uint32_t m_hotRowConflictThreshold;
+
+    /** @var Specifies the number of committed writes for which a hot row remains locked at first write. */
+    uint32_t m_hotRowCooldown;
+
     /**********************************************************************/
     // Machine configuration (not configurable, but loaded from system info)
     /**********************************************************************/
@@ -340,6 +358,9 @@ public:
     /** @var The high threshold in bytes for reclamation to be triggered (per-thread). */
     uint64_t m_gcHighReclaimThresholdBytes;
 
+    /** @var The number of background reclamation threads per NUMA node (zero means reclamation by sessions). */
+    uint32_t m_gcReclaimThreadsPerNode;
+
     /**********************************************************************/
     // JIT configuration
     /**********************************************************************/
@@ -444,6 +465,9 @@ public:
     static constexpr uint64_t MIN_GROUP_COMMIT_TIMEOUT_USEC = 100;
     static constexpr uint64_t MAX_GROUP_COMMIT_TIMEOUT_USEC = 200000;  // 200 ms
 
+    /** @var Default enable adaptive group commit. */
+    static constexpr bool DEFAULT_ENABLE_ADAPTIVE_GROUP_COMMIT = false;
+
     /** ------------------ Default Checkpoint Configuration ------------ */
     /** @var Default enable checkpoint. */
     static constexpr bool DEFAULT_ENABLE_CHECKPOINT = true;
@@ -465,15 +489,39 @@ public:
     static constexpr uint32_t MIN_CHECKPOINT_WORKERS = 1;
     static constexpr uint32_t MAX_CHECKPOINT_WORKERS = 1024;
 
+    /** @var Default maximum number of delta checkpoints between full checkpoints. */
+    static constexpr uint32_t DEFAULT_CHECKPOINT_MAX_DELTAS = 0;
+    static constexpr uint32_t MIN_CHECKPOINT_MAX_DELTAS = 0;
+    static constexpr uint32_t MAX_CHECKPOINT_MAX_DELTAS = 64;
+
+    /** @var Default enable checkpoint compression. */
+    static constexpr bool DEFAULT_ENABLE_CHECKPOINT_COMPRESSION = true;
+
     /** ------------------ Default Recovery Configuration ------------ */
     /** @var Default number of workers used in recovery from checkpoint. */
     static constexpr uint32_t DEFAULT_CHECKPOINT_RECOVERY_WORKERS = 3;
     static constexpr uint32_t MIN_CHECKPOINT_RECOVERY_WORKERS = 1;
     static constexpr uint32_t MAX_CHECKPOINT_RECOVERY_WORKERS = 1024;
 
+    /** @var Default number of workers used in redo log replay. */
+    static constexpr uint32_t DEFAULT_PARALLEL_REDO_WORKERS = 1;
+    static constexpr uint32_t MIN_PARALLEL_REDO_WORKERS = 1;
+    static constexpr uint32_t MAX_PARALLEL_REDO_WORKERS = 64;
+
     /** @var Default enable log recovery statistics. */
     static constexpr bool DEFAULT_ENABLE_LOG_RECOVERY_STATS = false;
 
+    /** ------------------ Default Transaction Configuration ------------ */
+    /** @var Default number of commit-time conflicts after which a row is considered hot. */
+    static constexpr uint32_t DEFAULT_HOT_ROW_CONFLICT_THRESHOLD = 16;
+    static constexpr uint32_t MIN_HOT_ROW_CONFLICT_THRESHOLD = 1;
+    static constexpr uint32_t MAX_HOT_ROW_CONFLICT_THRESHOLD = 1024;
+
+    /** @var Default number of committed writes for which a hot row remains locked at first write. */
+    static constexpr uint32_t DEFAULT_HOT_ROW_COOLDOWN = 1000;
+    static constexpr uint32_t MIN_HOT_ROW_COOLDOWN = 1;
+    static constexpr uint32_t MAX_HOT_ROW_COOLDOWN = 1000000;
+
     /** ------------------ Default Machine Configuration ------------ */
     /** @var Default number of NUMA nodes of the machine. */
     static constexpr uint16_t DEFAULT_NUMA_NODES = 1;
@@ -656,6 +704,11 @@ public:
     static constexpr uint64_t MIN_GC_HIGH_RECLAIM_THRESHOLD_BYTES = 1 * MEGA_BYTE;      // 1 MB
     static constexpr uint64_t MAX_GC_HIGH_RECLAIM_THRESHOLD_BYTES = 64 * MEGA_BYTE;     // 64 MB
 
+    /** @var The number of background reclamation threads per NUMA node. */
+    static constexpr uint32_t DEFAULT_GC_RECLAIM_THREADS_PER_NODE = 0;
+    static constexpr uint32_t MIN_GC_RECLAIM_THREADS_PER_NODE = 0;
+    static constexpr uint32_t MAX_GC_RECLAIM_THREADS_PER_NODE = 16;
+
     /** ------------------ Default JIT Configuration ------------ */
     /** @var Default enable JIT compilation and execution. */
     static constexpr bool DEFAULT_ENABLE_MOT_CODEGEN = true;
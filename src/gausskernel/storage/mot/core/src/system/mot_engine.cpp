@@ -45,6 +45,7 @@
 #include "cycles.h"
 #include "debug_utils.h"
 #include "recovery_manager_factory.h"
+#include "mm_gc_reclaimer.h"
 
 // For mtSessionThreadInfo thread local
 #include "kvthread.hh"
@@ -428,6 +429,14 @@ bool MOTEngine::StartBackgroundTasks()
             MOT_LOG_INFO("Startup: Statistics reporter started");
             m_startBgStack.push(START_STAT_PRINT_PHASE);
         }
+
+        MOTConfiguration& cfg = GetGlobalConfiguration();
+        if (cfg.m_gcEnable && cfg.m_gcReclaimThreadsPerNode > 0) {
+            result = GcReclaimer::StartAll();
+            CHECK_INIT_STATUS(result, "Failed to start the background garbage collection threads");
+            MOT_LOG_INFO("Startup: Background garbage collection started");
+            m_startBgStack.push(START_GC_RECLAIM_PHASE);
+        }
     } while (0);
 
     if (result) {
@@ -453,6 +462,7 @@ void MOTEngine::DestroyCoreServices()
                 break;
 
             case INIT_GC_PHASE:
+                GcReclaimer::DestroyAll();
                 break;
 
             case INIT_SURROGATE_KEY_MANAGER_PHASE:
@@ -465,6 +475,8 @@ void MOTEngine::DestroyCoreServices()
 
             case INIT_SESSION_MANAGER_PHASE:
                 DestroySessionManager();
+                // epoch slots are released by the garbage collectors of the destroyed sessions
+                GcManager::DestroyEpochSlots();
                 break;
 
             case INIT_MM_PHASE:
@@ -537,6 +549,10 @@ void MOTEngine::StopBackgroundTasks()
 
     while (!m_startBgStack.empty()) {
         switch (m_startBgStack.top()) {
+            case START_GC_RECLAIM_PHASE:
+                GcReclaimer::StopAll();
+                break;
+
             case START_STAT_PRINT_PHASE:
                 if (GetGlobalConfiguration().m_enableStats) {
                     StatisticsManager::GetInstance().Stop();
@@ -225,7 +225,15 @@ public:
     {
         bool result = true;
         if (GetGlobalConfiguration().m_enableCheckpoint) {
+            // on a standby, all the redo records replayed so far must be applied before the snapshot is taken
+            bool recovering = IsRecovering();
+            if (recovering) {
+                m_recoveryManager->SuspendRedoApply();
+            }
             result = m_checkpointManager->CreateSnapShot();
+            if (recovering) {
+                m_recoveryManager->ResumeRedoApply();
+            }
         }
         return result;
     }
@@ -576,7 +584,7 @@ private:
     };
     stack<InitAppPhase> m_initAppStack;
 
-    enum StartBgTaskPhase { START_STAT_PRINT_PHASE, START_BG_TASK_DONE };
+    enum StartBgTaskPhase { START_STAT_PRINT_PHASE, START_GC_RECLAIM_PHASE, START_BG_TASK_DONE };
     stack<StartBgTaskPhase> m_startBgStack;
 
     /**
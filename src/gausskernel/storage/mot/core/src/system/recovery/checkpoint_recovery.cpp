@@ -23,10 +23,12 @@
  */
 
 #include <thread>
+#include <algorithm>
 #include "mot_engine.h"
 #include "checkpoint_recovery.h"
 #include "checkpoint_utils.h"
 #include "irecovery_manager.h"
+#include "recovery_ops.h"
 #include "redo_log_transaction_iterator.h"
 
 namespace MOT {
@@ -41,6 +43,7 @@ bool CheckpointRecovery::Recover()
     }
 
     m_tasksList.clear();
+    m_taskRounds.clear();
     if (CheckpointControlFile::GetCtrlFile() == nullptr) {
         MOT_REPORT_ERROR(MOT_ERROR_OOM, "Checkpoint Recovery Initialization", "Failed to allocate ctrlfile object");
         return false;
@@ -86,7 +89,7 @@ bool CheckpointRecovery::Recover()
         return true;
     }
 
-    if (m_tasksList.size() > 0) {
+    if (!m_taskRounds.empty()) {
         if (GetGlobalConfiguration().m_enableIncrementalCheckpoint) {
             MOT_LOG_ERROR(
                 "CheckpointRecovery: recovery of MOT tables failed. MOT does not support incremental checkpoint");
@@ -137,20 +140,32 @@ bool CheckpointRecovery::PerformRecovery()
         }
     }
 
-    std::vector<std::thread> threadPool;
-    for (uint32_t i = 0; i < m_numWorkers; ++i) {
-        threadPool.push_back(std::thread(CheckpointRecoveryWorker, this));
-    }
+    // Each round must be fully recovered before the next one starts, as delta rounds modify the rows
+    // recovered by the previous rounds.
+    for (size_t round = 0; round < m_taskRounds.size() && !m_errorSet; ++round) {
+        if (m_taskRounds[round].empty()) {
+            continue;
+        }
 
-    MOT_LOG_DEBUG("CheckpointRecovery: waiting for all tasks to finish");
-    while (HaveTasks() && m_stopWorkers == false) {
-        sleep(1);
-    }
+        m_tasksLock.lock();
+        m_tasksList.swap(m_taskRounds[round]);
+        m_tasksLock.unlock();
+
+        std::vector<std::thread> threadPool;
+        for (uint32_t i = 0; i < m_numWorkers; ++i) {
+            threadPool.push_back(std::thread(CheckpointRecoveryWorker, this));
+        }
+
+        MOT_LOG_DEBUG("CheckpointRecovery: waiting for all tasks of round %lu to finish", round);
+        while (HaveTasks() && m_stopWorkers == false) {
+            sleep(1);
+        }
 
-    MOT_LOG_DEBUG("CheckpointRecovery: tasks finished (%s)", m_errorSet ? "error" : "ok");
-    for (auto& worker : threadPool) {
-        if (worker.joinable()) {
-            worker.join();
+        MOT_LOG_DEBUG("CheckpointRecovery: round %lu tasks finished (%s)", round, m_errorSet ? "error" : "ok");
+        for (auto& worker : threadPool) {
+            if (worker.joinable()) {
+                worker.join();
+            }
         }
     }
 
@@ -163,53 +178,147 @@ int CheckpointRecovery::FillTasksFromMapFile()
         return 0;  // fresh install probably. no error
     }
 
+    std::vector<uint64_t> chain;
+    if (!CheckpointManager::GetCheckpointChain(m_checkpointId, chain)) {
+        MOT_LOG_ERROR("CheckpointRecovery::fillTasksFromMapFile: failed to get the chain of checkpoint %lu",
+            m_checkpointId);
+        return -1;
+    }
+
+    // layers are ordered from the base (full) checkpoint up to the latest delta checkpoint
+    std::reverse(chain.begin(), chain.end());
+    size_t latest = chain.size() - 1;
+    std::vector<std::map<uint32_t, uint32_t>> layerSegs(chain.size());
+    std::vector<std::map<uint32_t, CheckpointManager::DeltaFileEntry>> layerDeltas(chain.size());
+    for (size_t i = 0; i < chain.size(); i++) {
+        if (!ReadMapFile(chain[i], layerSegs[i])) {
+            return -1;
+        }
+
+        if (i > 0) {
+            uint64_t prevId = CheckpointControlFile::invalidId;
+            std::list<CheckpointManager::DeltaFileEntry> entries;
+            if (CheckpointManager::ReadDeltaFile(chain[i], prevId, &entries) != 1) {
+                MOT_LOG_ERROR("CheckpointRecovery::fillTasksFromMapFile: failed to read delta file of checkpoint %lu",
+                    chain[i]);
+                return -1;
+            }
+            for (auto& entry : entries) {
+                layerDeltas[i][entry.m_tableId] = entry;
+            }
+        }
+    }
+
+    // every layer has a deletes round followed by a rows round
+    m_taskRounds.resize(chain.size() * 2);
+    for (auto& tableSegs : layerSegs[latest]) {
+        uint32_t tableId = tableSegs.first;
+        m_tableIds.insert(tableId);
+
+        // find the layer holding the full image of the table
+        size_t start = latest;
+        while (start > 0) {
+            auto deltaIt = layerDeltas[start].find(tableId);
+            if (deltaIt == layerDeltas[start].end()) {
+                MOT_LOG_ERROR("CheckpointRecovery::fillTasksFromMapFile: table %u is missing from checkpoint %lu",
+                    tableId,
+                    chain[start]);
+                return -1;
+            }
+            if (deltaIt->second.m_isFull) {
+                break;
+            }
+            start--;
+        }
+
+        for (size_t i = start; i <= latest; i++) {
+            auto segIt = layerSegs[i].find(tableId);
+            if (segIt == layerSegs[i].end()) {
+                MOT_LOG_ERROR("CheckpointRecovery::fillTasksFromMapFile: table %u is missing from checkpoint %lu",
+                    tableId,
+                    chain[i]);
+                return -1;
+            }
+
+            if (i > start && layerDeltas[i][tableId].m_numDeletes > 0 &&
+                !AddTask(m_taskRounds[i * 2], tableId, 0, chain[i], DELTA_DELETES)) {
+                return -1;
+            }
+
+            for (uint32_t seg = 0; seg <= segIt->second; seg++) {
+                if (!AddTask(m_taskRounds[i * 2 + 1], tableId, seg, chain[i], (i == start) ? TABLE_ROWS : DELTA_ROWS)) {
+                    return -1;
+                }
+            }
+        }
+    }
+
+    size_t numTasks = 0;
+    for (auto& round : m_taskRounds) {
+        numTasks += round.size();
+    }
+    MOT_LOG_INFO("CheckpointRecovery::fillTasksFromMapFile: filled %lu tasks from %lu checkpoints",
+        numTasks,
+        chain.size());
+    return 1;
+}
+
+bool CheckpointRecovery::ReadMapFile(uint64_t checkpointId, std::map<uint32_t, uint32_t>& tableSegs)
+{
+    std::string workingDir;
+    if (!CheckpointUtils::SetWorkingDir(workingDir, checkpointId)) {
+        MOT_LOG_ERROR("CheckpointRecovery::ReadMapFile: failed to obtain checkpoint's working dir");
+        return false;
+    }
+
     std::string mapFile;
-    CheckpointUtils::MakeMapFilename(mapFile, m_workingDir, m_checkpointId);
+    CheckpointUtils::MakeMapFilename(mapFile, workingDir, checkpointId);
     int fd = -1;
     if (!CheckpointUtils::OpenFileRead(mapFile, fd)) {
-        MOT_LOG_ERROR("CheckpointRecovery::fillTasksFromMapFile: failed to open map file '%s'", mapFile.c_str());
-        return -1;
+        MOT_LOG_ERROR("CheckpointRecovery::ReadMapFile: failed to open map file '%s'", mapFile.c_str());
+        return false;
     }
 
     CheckpointUtils::MapFileHeader mapFileHeader;
     if (CheckpointUtils::ReadFile(fd, (char*)&mapFileHeader, sizeof(CheckpointUtils::MapFileHeader)) !=
         sizeof(CheckpointUtils::MapFileHeader)) {
-        MOT_LOG_ERROR("CheckpointRecovery::fillTasksFromMapFile: failed to read map file '%s' header", mapFile.c_str());
+        MOT_LOG_ERROR("CheckpointRecovery::ReadMapFile: failed to read map file '%s' header", mapFile.c_str());
         CheckpointUtils::CloseFile(fd);
-        return -1;
+        return false;
     }
 
     if (mapFileHeader.m_magic != CP_MGR_MAGIC) {
-        MOT_LOG_ERROR("CheckpointRecovery::fillTasksFromMapFile: failed to verify map file'%s'", mapFile.c_str());
+        MOT_LOG_ERROR("CheckpointRecovery::ReadMapFile: failed to verify map file'%s'", mapFile.c_str());
         CheckpointUtils::CloseFile(fd);
-        return -1;
+        return false;
     }
 
     CheckpointManager::MapFileEntry entry;
     for (uint64_t i = 0; i < mapFileHeader.m_numEntries; i++) {
         if (CheckpointUtils::ReadFile(fd, (char*)&entry, sizeof(CheckpointManager::MapFileEntry)) !=
             sizeof(CheckpointManager::MapFileEntry)) {
-            MOT_LOG_ERROR("CheckpointRecovery::fillTasksFromMapFile: failed to read map file '%s' entry: %lu",
-                mapFile.c_str(),
-                i);
+            MOT_LOG_ERROR(
+                "CheckpointRecovery::ReadMapFile: failed to read map file '%s' entry: %lu", mapFile.c_str(), i);
             CheckpointUtils::CloseFile(fd);
-            return -1;
-        }
-        m_tableIds.insert(entry.m_tableId);
-        for (uint32_t i = 0; i <= entry.m_maxSegId; i++) {
-            Task* recoveryTask = new (std::nothrow) Task(entry.m_tableId, i);
-            if (recoveryTask == nullptr) {
-                CheckpointUtils::CloseFile(fd);
-                MOT_LOG_ERROR("CheckpointRecovery::fillTasksFromMapFile: failed to allocate task object");
-                return -1;
-            }
-            m_tasksList.push_back(recoveryTask);
+            return false;
         }
+        tableSegs[entry.m_tableId] = entry.m_maxSegId;
     }
 
     CheckpointUtils::CloseFile(fd);
-    MOT_LOG_INFO("CheckpointRecovery::fillTasksFromMapFile: filled %lu tasks", m_tasksList.size());
-    return 1;
+    return true;
+}
+
+bool CheckpointRecovery::AddTask(
+    std::list<Task*>& round, uint32_t tableId, uint32_t segId, uint64_t checkpointId, TaskType type)
+{
+    Task* recoveryTask = new (std::nothrow) Task(tableId, segId, checkpointId, type);
+    if (recoveryTask == nullptr) {
+        MOT_LOG_ERROR("CheckpointRecovery::AddTask: failed to allocate task object");
+        return false;
+    }
+    round.push_back(recoveryTask);
+    return true;
 }
 
 bool CheckpointRecovery::RecoverTableMetadata(uint32_t tableId)
@@ -254,12 +363,12 @@ bool CheckpointRecovery::RecoverTableMetadata(uint32_t tableId)
     }
 
     CheckpointUtils::CloseFile(fd);
-    bool status = CreateTable(dataBuf);
+    bool status = CreateTable(dataBuf, mFileHeader.m_entryHeader.m_dataLen);
     delete[] dataBuf;
     return status;
 }
 
-bool CheckpointRecovery::CreateTable(char* data)
+bool CheckpointRecovery::CreateTable(char* data, size_t len)
 {
     string name;
     string longName;
@@ -282,7 +391,7 @@ bool CheckpointRecovery::CreateTable(char* data)
         return false;
     }
 
-    table->Deserialize((const char*)data);
+    table->Deserialize((const char*)data, len);
     do {
         if (!table->IsDeserialized()) {
             MOT_LOG_ERROR("CheckpointRecovery::CreateTable: failed to de-serialize table");
@@ -360,12 +469,17 @@ void CheckpointRecovery::CheckpointRecoveryWorker(CheckpointRecovery* checkpoint
             RC_MEMORY_ALLOCATION_ERROR, "CheckpointRecovery::WorkerFunc failed to allocate row buffer");
     }
 
+    TxnManager* txn = (sessionContext != nullptr) ? sessionContext->GetTxnManager() : nullptr;
     RC status = RC_OK;
     while (checkpointRecovery->ShouldStopWorkers() == false) {
         CheckpointRecovery::Task* task = checkpointRecovery->GetTask();
         if (task != nullptr) {
             bool hadError = false;
-            if (!checkpointRecovery->RecoverTableRows(task, keyData, entryData, maxCsn, sState, status)) {
+            bool recovered = (task->m_type == DELTA_DELETES)
+                                 ? checkpointRecovery->RecoverDeltaDeletes(task, keyData, maxCsn, status, txn)
+                                 : checkpointRecovery->RecoverTableRows(
+                                       task, keyData, entryData, maxCsn, sState, status, txn);
+            if (!recovered) {
                 MOT_LOG_ERROR("CheckpointRecovery::WorkerFunc recovery of table %lu's data failed", task->m_tableId);
                 checkpointRecovery->OnError(status,
                     "CheckpointRecovery::WorkerFunc failed to recover table: ",
@@ -398,8 +512,8 @@ void CheckpointRecovery::CheckpointRecoveryWorker(CheckpointRecovery* checkpoint
     MOT_LOG_DEBUG("CheckpointRecovery::WorkerFunc end [%u] on cpu %lu", (unsigned)MOTCurrThreadId, sched_getcpu());
 }
 
-bool CheckpointRecovery::RecoverTableRows(
-    Task* task, char* keyData, char* entryData, uint64_t& maxCsn, SurrogateState& sState, RC& status)
+bool CheckpointRecovery::RecoverTableRows(Task* task, char* keyData, char* entryData, uint64_t& maxCsn,
+    SurrogateState& sState, RC& status, TxnManager* txn)
 {
     if (task == nullptr) {
         MOT_LOG_ERROR("CheckpointRecovery::RecoverTableRows: no task given");
@@ -417,8 +531,19 @@ bool CheckpointRecovery::RecoverTableRows(
         return false;
     }
 
+    if (task->m_type == DELTA_ROWS && txn == nullptr) {
+        MOT_LOG_ERROR("CheckpointRecovery::RecoverTableRows: no transaction for delta rows of table %u", tableId);
+        return false;
+    }
+
+    std::string workingDir;
+    if (!CheckpointUtils::SetWorkingDir(workingDir, task->m_checkpointId)) {
+        MOT_LOG_ERROR("CheckpointRecovery::RecoverTableRows: failed to obtain checkpoint's working dir");
+        return false;
+    }
+
     std::string fileName;
-    CheckpointUtils::MakeCpFilename(tableId, fileName, m_workingDir, seg);
+    CheckpointUtils::MakeCpFilename(tableId, fileName, workingDir, seg);
     if (!CheckpointUtils::OpenFileRead(fileName, fd)) {
         MOT_LOG_ERROR("CheckpointRecovery::RecoverTableRows: failed to open file: %s", fileName.c_str());
         return false;
@@ -432,7 +557,8 @@ bool CheckpointRecovery::RecoverTableRows(
         return false;
     }
 
-    if (fileHeader.m_magic != CP_MGR_MAGIC || fileHeader.m_tableId != tableId) {
+    bool blockFormat = (fileHeader.m_magic == CP_MGR_BLOCK_MAGIC);
+    if ((!blockFormat && fileHeader.m_magic != CP_MGR_MAGIC) || fileHeader.m_tableId != tableId) {
         MOT_LOG_ERROR("CheckpointRecovery::RecoverTableRows: file: %s is corrupted", fileName.c_str());
         CheckpointUtils::CloseFile(fd);
         return false;
@@ -450,17 +576,68 @@ bool CheckpointRecovery::RecoverTableRows(
         return false;
     }
 
+    // block format files are read a whole (possibly compressed) block at a time and the entries are parsed from
+    // memory, so each recovery worker decompresses the segments it is assigned
+    char* blockData = nullptr;
+    char* storedData = nullptr;
+    uint32_t blockLen = 0;
+    uint32_t blockOffset = 0;
+    if (blockFormat) {
+        (void)posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+        blockData = new (std::nothrow) char[CheckpointUtils::maxBlockSize];
+        storedData = new (std::nothrow) char[CheckpointUtils::GetMaxStoredBlockSize(CheckpointUtils::maxBlockSize)];
+        if (blockData == nullptr || storedData == nullptr) {
+            MOT_LOG_ERROR("CheckpointRecovery::RecoverTableRows: failed to allocate block buffers");
+            if (blockData != nullptr) {
+                delete[] blockData;
+            }
+            if (storedData != nullptr) {
+                delete[] storedData;
+            }
+            CheckpointUtils::CloseFile(fd);
+            return false;
+        }
+    }
+
     CheckpointUtils::EntryHeader entry;
     for (uint64_t i = 0; i < fileHeader.m_numOps; i++) {
-        reader = CheckpointUtils::ReadFile(fd, (char*)&entry, sizeof(CheckpointUtils::EntryHeader));
-        if (reader != sizeof(CheckpointUtils::EntryHeader)) {
-            MOT_LOG_ERROR(
-                "CheckpointRecovery::RecoverTableRows: failed to read entry header (elem: %lu / %lu), reader %lu",
-                i,
-                fileHeader.m_numOps,
-                reader);
-            status = RC_ERROR;
-            break;
+        char* key = keyData;
+        char* data = entryData;
+        if (blockFormat) {
+            if (blockOffset == blockLen) {
+                if (!CheckpointUtils::ReadBlock(fd, storedData, blockData, blockLen) || blockLen == 0) {
+                    MOT_LOG_ERROR("CheckpointRecovery::RecoverTableRows: failed to read block (elem: %lu / %lu)",
+                        i,
+                        fileHeader.m_numOps);
+                    status = RC_ERROR;
+                    break;
+                }
+                blockOffset = 0;
+            }
+            if (blockLen - blockOffset < sizeof(CheckpointUtils::EntryHeader)) {
+                MOT_LOG_ERROR("CheckpointRecovery::RecoverTableRows: truncated entry header (elem: %lu / %lu)",
+                    i,
+                    fileHeader.m_numOps);
+                status = RC_ERROR;
+                break;
+            }
+            errno_t erc = memcpy_s(&entry,
+                sizeof(CheckpointUtils::EntryHeader),
+                blockData + blockOffset,
+                sizeof(CheckpointUtils::EntryHeader));
+            securec_check(erc, "\0", "\0");
+            blockOffset += sizeof(CheckpointUtils::EntryHeader);
+        } else {
+            reader = CheckpointUtils::ReadFile(fd, (char*)&entry, sizeof(CheckpointUtils::EntryHeader));
+            if (reader != sizeof(CheckpointUtils::EntryHeader)) {
+                MOT_LOG_ERROR(
+                    "CheckpointRecovery::RecoverTableRows: failed to read entry header (elem: %lu / %lu), reader %lu",
+                    i,
+                    fileHeader.m_numOps,
+                    reader);
+                status = RC_ERROR;
+                break;
+            }
         }
 
         if (entry.m_keyLen > MAX_KEY_SIZE || entry.m_dataLen > MAX_TUPLE_SIZE) {
@@ -474,38 +651,66 @@ bool CheckpointRecovery::RecoverTableRows(
             break;
         }
 
-        reader = CheckpointUtils::ReadFile(fd, keyData, entry.m_keyLen);
-        if (reader != entry.m_keyLen) {
-            MOT_LOG_ERROR(
-                "CheckpointRecovery::RecoverTableRows: failed to read entry key (elem: %lu / %lu), reader %lu",
-                i,
-                fileHeader.m_numOps,
-                reader);
-            status = RC_ERROR;
-            break;
-        }
+        if (blockFormat) {
+            if (blockLen - blockOffset < (uint64_t)entry.m_keyLen + entry.m_dataLen) {
+                MOT_LOG_ERROR("CheckpointRecovery::RecoverTableRows: truncated entry (elem: %lu / %lu)",
+                    i,
+                    fileHeader.m_numOps);
+                status = RC_ERROR;
+                break;
+            }
+            key = blockData + blockOffset;
+            blockOffset += entry.m_keyLen;
+            data = blockData + blockOffset;
+            blockOffset += entry.m_dataLen;
+        } else {
+            reader = CheckpointUtils::ReadFile(fd, keyData, entry.m_keyLen);
+            if (reader != entry.m_keyLen) {
+                MOT_LOG_ERROR(
+                    "CheckpointRecovery::RecoverTableRows: failed to read entry key (elem: %lu / %lu), reader %lu",
+                    i,
+                    fileHeader.m_numOps,
+                    reader);
+                status = RC_ERROR;
+                break;
+            }
 
-        reader = CheckpointUtils::ReadFile(fd, entryData, entry.m_dataLen);
-        if (reader != entry.m_dataLen) {
-            MOT_LOG_ERROR(
-                "CheckpointRecovery::RecoverTableRows: failed to read entry data (elem: %lu / %lu), reader %lu",
-                i,
-                fileHeader.m_numOps,
-                reader);
-            status = RC_ERROR;
-            break;
+            reader = CheckpointUtils::ReadFile(fd, entryData, entry.m_dataLen);
+            if (reader != entry.m_dataLen) {
+                MOT_LOG_ERROR(
+                    "CheckpointRecovery::RecoverTableRows: failed to read entry data (elem: %lu / %lu), reader %lu",
+                    i,
+                    fileHeader.m_numOps,
+                    reader);
+                status = RC_ERROR;
+                break;
+            }
         }
 
-        InsertRow(table,
-            keyData,
-            entry.m_keyLen,
-            entryData,
-            entry.m_dataLen,
-            entry.m_csn,
-            MOTCurrThreadId,
-            sState,
-            status,
-            entry.m_rowId);
+        if (task->m_type == DELTA_ROWS) {
+            ApplyDeltaRow(txn,
+                table,
+                key,
+                entry.m_keyLen,
+                data,
+                entry.m_dataLen,
+                entry.m_csn,
+                MOTCurrThreadId,
+                sState,
+                status,
+                entry.m_rowId);
+        } else {
+            InsertRow(table,
+                key,
+                entry.m_keyLen,
+                data,
+                entry.m_dataLen,
+                entry.m_csn,
+                MOTCurrThreadId,
+                sState,
+                status,
+                entry.m_rowId);
+        }
 
         if (status != RC_OK) {
             MOT_LOG_ERROR(
@@ -517,6 +722,12 @@ bool CheckpointRecovery::RecoverTableRows(
             maxCsn = entry.m_csn;
     }
     CheckpointUtils::CloseFile(fd);
+    if (blockData != nullptr) {
+        delete[] blockData;
+    }
+    if (storedData != nullptr) {
+        delete[] storedData;
+    }
 
     MOT_LOG_DEBUG("[%u] CheckpointRecovery::RecoverTableRows table %u:%u, %lu rows recovered (%s)",
         MOTCurrThreadId,
@@ -570,7 +781,7 @@ void CheckpointRecovery::InsertRow(Table* table, char* keyData, uint16_t keyLen,
     uint64_t csn, uint32_t tid, SurrogateState& sState, RC& status, uint64_t rowId)
 {
     MaxKey key;
-    Row* row = table->CreateNewRow();
+    Row* row = table->CreateNewRow((const uint8_t*)keyData, keyLen);
     if (row == nullptr) {
         status = RC_ERROR;
         MOT_REPORT_ERROR(MOT_ERROR_OOM, "Recovery Manager Insert Row", "failed to create row");
@@ -593,6 +804,162 @@ void CheckpointRecovery::InsertRow(Table* table, char* keyData, uint16_t keyLen,
     }
 }
 
+void CheckpointRecovery::ApplyDeltaRow(TxnManager* txn, Table* table, char* keyData, uint16_t keyLen, char* rowData,
+    uint64_t rowLen, uint64_t csn, uint32_t tid, SurrogateState& sState, RC& status, uint64_t rowId)
+{
+    MaxKey key;
+    Row* row = nullptr;
+    key.CpKey((const uint8_t*)keyData, keyLen);
+    bool rowExists = (table->FindRow(&key, row, tid) == RC_OK);
+
+    status = RecoveryOps::BeginTransaction(txn);
+    if (status != RC_OK) {
+        return;
+    }
+
+    // a row changed since the previous checkpoint was either updated or inserted
+    if (rowExists) {
+        RecoveryOps::UpdateRow(txn,
+            table->GetTableId(),
+            table->GetTableExId(),
+            keyData,
+            keyLen,
+            rowData,
+            rowLen,
+            csn,
+            tid,
+            sState,
+            status);
+    } else {
+        RecoveryOps::InsertRow(txn,
+            table->GetTableId(),
+            table->GetTableExId(),
+            keyData,
+            keyLen,
+            rowData,
+            rowLen,
+            csn,
+            tid,
+            sState,
+            status,
+            rowId);
+    }
+
+    if (status != RC_OK) {
+        RecoveryOps::RollbackTransaction(txn);
+        return;
+    }
+    status = RecoveryOps::CommitTransaction(txn, csn);
+}
+
+bool CheckpointRecovery::RecoverDeltaDeletes(Task* task, char* keyData, uint64_t& maxCsn, RC& status, TxnManager* txn)
+{
+    if (task == nullptr || txn == nullptr) {
+        MOT_LOG_ERROR("CheckpointRecovery::RecoverDeltaDeletes: no task or transaction given");
+        return false;
+    }
+
+    int fd = -1;
+    uint32_t tableId = task->m_tableId;
+    Table* table = GetTableManager()->GetTable(tableId);
+    if (table == nullptr) {
+        MOT_REPORT_ERROR(
+            MOT_ERROR_INTERNAL, "CheckpointRecovery::RecoverDeltaDeletes", "Table %llu does not exist", tableId);
+        return false;
+    }
+
+    std::string workingDir;
+    if (!CheckpointUtils::SetWorkingDir(workingDir, task->m_checkpointId)) {
+        MOT_LOG_ERROR("CheckpointRecovery::RecoverDeltaDeletes: failed to obtain checkpoint's working dir");
+        return false;
+    }
+
+    std::string fileName;
+    CheckpointUtils::MakeDelFilename(tableId, fileName, workingDir);
+    if (!CheckpointUtils::OpenFileRead(fileName, fd)) {
+        MOT_LOG_ERROR("CheckpointRecovery::RecoverDeltaDeletes: failed to open file: %s", fileName.c_str());
+        return false;
+    }
+
+    CheckpointUtils::FileHeader fileHeader;
+    size_t reader = CheckpointUtils::ReadFile(fd, (char*)&fileHeader, sizeof(CheckpointUtils::FileHeader));
+    if (reader != sizeof(CheckpointUtils::FileHeader)) {
+        MOT_LOG_ERROR("CheckpointRecovery::RecoverDeltaDeletes: failed to read file header, reader %lu", reader);
+        CheckpointUtils::CloseFile(fd);
+        return false;
+    }
+
+    if (fileHeader.m_magic != CP_MGR_MAGIC || fileHeader.m_tableId != tableId ||
+        fileHeader.m_exId != table->GetTableExId()) {
+        MOT_LOG_ERROR("CheckpointRecovery::RecoverDeltaDeletes: file: %s is corrupted", fileName.c_str());
+        CheckpointUtils::CloseFile(fd);
+        return false;
+    }
+
+    uint64_t numDeleted = 0;
+    CheckpointUtils::EntryHeader entry;
+    for (uint64_t i = 0; i < fileHeader.m_numOps; i++) {
+        reader = CheckpointUtils::ReadFile(fd, (char*)&entry, sizeof(CheckpointUtils::EntryHeader));
+        if (reader != sizeof(CheckpointUtils::EntryHeader) || entry.m_keyLen > MAX_KEY_SIZE) {
+            MOT_LOG_ERROR("CheckpointRecovery::RecoverDeltaDeletes: failed to read entry header (elem: %lu / %lu)",
+                i,
+                fileHeader.m_numOps);
+            status = RC_ERROR;
+            break;
+        }
+
+        reader = CheckpointUtils::ReadFile(fd, keyData, entry.m_keyLen);
+        if (reader != entry.m_keyLen) {
+            MOT_LOG_ERROR("CheckpointRecovery::RecoverDeltaDeletes: failed to read entry key (elem: %lu / %lu)",
+                i,
+                fileHeader.m_numOps);
+            status = RC_ERROR;
+            break;
+        }
+
+        // The key may have been inserted again after the deletion, in which case the row recovered from the
+        // previous checkpoints is newer than the deletion and must be kept.
+        MaxKey key;
+        Row* row = nullptr;
+        key.CpKey((const uint8_t*)keyData, entry.m_keyLen);
+        if (table->FindRow(&key, row, MOTCurrThreadId) == RC_OK && row->GetCommitSequenceNumber() < entry.m_csn) {
+            status = RecoveryOps::BeginTransaction(txn);
+            if (status != RC_OK) {
+                break;
+            }
+            RecoveryOps::DeleteRow(txn,
+                tableId,
+                table->GetTableExId(),
+                keyData,
+                entry.m_keyLen,
+                entry.m_csn,
+                MOTCurrThreadId,
+                status);
+            if (status != RC_OK) {
+                RecoveryOps::RollbackTransaction(txn);
+                break;
+            }
+            status = RecoveryOps::CommitTransaction(txn, entry.m_csn);
+            if (status != RC_OK) {
+                break;
+            }
+            numDeleted++;
+        }
+
+        if (entry.m_csn > maxCsn)
+            maxCsn = entry.m_csn;
+    }
+    CheckpointUtils::CloseFile(fd);
+
+    MOT_LOG_DEBUG("[%u] CheckpointRecovery::RecoverDeltaDeletes table %u, %lu of %lu rows deleted (%s)",
+        MOTCurrThreadId,
+        tableId,
+        numDeleted,
+        fileHeader.m_numOps,
+        (status == RC_OK) ? "OK" : "Error");
+    return (status == RC_OK);
+}
+
 bool CheckpointRecovery::RecoverInProcessTxns()
 {
     int fd = -1;
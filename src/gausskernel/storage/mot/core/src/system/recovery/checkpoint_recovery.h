@@ -27,13 +27,17 @@
 
 #include <set>
 #include <list>
+#include <map>
 #include <mutex>
+#include <vector>
 #include "global.h"
 #include "spin_lock.h"
 #include "table.h"
 #include "surrogate_state.h"
 
 namespace MOT {
+class TxnManager;
+
 class CheckpointRecovery {
 public:
     CheckpointRecovery()
@@ -66,17 +70,27 @@ public:
         return m_stopWorkers;
     }
 
+    /**
+     * @enum TaskType
+     * @brief The kind of data a recovery task restores. Delta rows and deletes are applied on top of the rows
+     * recovered from the checkpoints preceding a delta checkpoint.
+     */
+    enum TaskType { TABLE_ROWS = 0, DELTA_ROWS = 1, DELTA_DELETES = 2 };
+
     /**
      * @struct Task
-     * @brief Describes a checkpoint recovery task by its table id and
-     * segment file number.
+     * @brief Describes a checkpoint recovery task by its table id,
+     * segment file number and the checkpoint holding the file.
      */
     struct Task {
-        explicit Task(uint32_t tableId = 0, uint32_t segId = 0) : m_tableId(tableId), m_segId(segId)
+        explicit Task(uint32_t tableId = 0, uint32_t segId = 0, uint64_t checkpointId = 0, TaskType type = TABLE_ROWS)
+            : m_tableId(tableId), m_segId(segId), m_checkpointId(checkpointId), m_type(type)
         {}
 
         uint32_t m_tableId;
         uint32_t m_segId;
+        uint64_t m_checkpointId;
+        TaskType m_type;
     };
 
     /**
@@ -94,10 +108,22 @@ public:
      * @param sState Surrogate key state structure that will be filled.
      * during the recovery.
      * @param status RC returned from the Insert function.
+     * @param txn The worker's transaction manager, used for applying delta rows.
+     * @return Boolean value denoting success or failure.
+     */
+    bool RecoverTableRows(Task* task, char* keyData, char* entryData, uint64_t& maxCsn, SurrogateState& sState,
+        RC& status, TxnManager* txn);
+
+    /**
+     * @brief Reads a delta checkpoint deletes file and removes the deleted rows
+     * @param task The task (tableid / checkpoint) to recover from.
+     * @param keyData A key buffer.
+     * @param maxCsn The returned maxCsn encountered during the recovery.
+     * @param status RC returned from the Delete function.
+     * @param txn The worker's transaction manager.
      * @return Boolean value denoting success or failure.
      */
-    bool RecoverTableRows(
-        Task* task, char* keyData, char* entryData, uint64_t& maxCsn, SurrogateState& sState, RC& status);
+    bool RecoverDeltaDeletes(Task* task, char* keyData, uint64_t& maxCsn, RC& status, TxnManager* txn);
 
     uint64_t GetLsn() const
     {
@@ -120,13 +146,27 @@ private:
     bool RecoverTableMetadata(uint32_t tableId);
 
     /**
-     * @brief Reads the checkpoint map file and fills the tasks queue
-     * with the relevant information.
+     * @brief Reads the map files of the checkpoint and the checkpoints it is
+     * based on, and fills the tasks rounds with the relevant information.
      * @return Int value where 0 indicates no tasks (empty checkpoint),
      * -1 denotes an error has occurred and 1 means a success.
      */
     int FillTasksFromMapFile();
 
+    /**
+     * @brief Reads a checkpoint map file.
+     * @param checkpointId The checkpoint id.
+     * @param tableSegs The returned max segment id of each table in the checkpoint.
+     * @return Boolean value denoting success or failure.
+     */
+    bool ReadMapFile(uint64_t checkpointId, std::map<uint32_t, uint32_t>& tableSegs);
+
+    /**
+     * @brief Queues a recovery task to a tasks round.
+     * @return Boolean value denoting success or failure.
+     */
+    bool AddTask(std::list<Task*>& round, uint32_t tableId, uint32_t segId, uint64_t checkpointId, TaskType type);
+
     /**
      * @brief Checks if there are any more tasks left in the queue
      * @return Int value where 0 means failure and 1 success
@@ -165,12 +205,30 @@ private:
     void InsertRow(Table* table, char* keyData, uint16_t keyLen, char* rowData, uint64_t rowLen, uint64_t csn,
         uint32_t tid, SurrogateState& sState, RC& status, uint64_t rowId);
 
+    /**
+     * @brief Inserts or updates a row of a delta checkpoint in a transactional manner.
+     * @param txn the transaction manager object.
+     * @param table the table's object pointer.
+     * @param keyData key's data buffer.
+     * @param keyLen key's data buffer len.
+     * @param rowData row's data buffer.
+     * @param rowLen row's data buffer len.
+     * @param csn the operation's csn.
+     * @param tid the thread id of the recovering thread.
+     * @param sState the returned surrogate state.
+     * @param status the returned status of the operation
+     * @param rowId the row's internal id
+     */
+    void ApplyDeltaRow(TxnManager* txn, Table* table, char* keyData, uint16_t keyLen, char* rowData, uint64_t rowLen,
+        uint64_t csn, uint32_t tid, SurrogateState& sState, RC& status, uint64_t rowId);
+
     /**
      * @brief performs table creation.
      * @param data the table's data
+     * @param len the size of the table's data
      * @return Boolean value that represents that status of the operation.
      */
-    bool CreateTable(char* data);
+    bool CreateTable(char* data, size_t len);
 
     /**
      * @brief returns if a checkpoint is valid by its id.
@@ -213,6 +271,9 @@ private:
     std::set<uint32_t> m_tableIds;
 
     std::list<Task*> m_tasksList;
+
+    // Tasks rounds, recovered one after the other from the base checkpoint up to the latest delta checkpoint
+    std::vector<std::list<Task*>> m_taskRounds;
 };
 }  // namespace MOT
 
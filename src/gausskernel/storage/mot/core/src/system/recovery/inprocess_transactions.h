@@ -42,6 +42,15 @@ public:
 
     bool FindTransactionId(uint64_t externalId, uint64_t& internalId);
 
+    /**
+     * @brief Removes a transaction from the map and hands its segments over to the caller, who becomes
+     * responsible for deleting them.
+     * @param internalId the internal transaction id.
+     * @param externalId the external transaction id.
+     * @return The transaction segments, or nullptr if the transaction was not found.
+     */
+    RedoLogTransactionSegments* DetachTransaction(uint64_t internalId, uint64_t externalId);
+
     template <typename T>
     RC ForUniqueTransaction(uint64_t internalId, uint64_t externalId, const T& func)
     {
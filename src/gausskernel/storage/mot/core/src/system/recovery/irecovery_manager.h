@@ -31,6 +31,24 @@
 namespace MOT {
 typedef TxnCommitStatus (*CommitLogStatusCallback)(uint64_t);
 
+/**
+ * @struct RedoWorkerStats
+ * @brief Progress report of a single parallel redo worker.
+ */
+struct RedoWorkerStats {
+    /** @var The worker identifier. */
+    uint32_t m_workerId;
+
+    /** @var The number of transaction fragments currently waiting in the worker queue. */
+    uint32_t m_queueUsage;
+
+    /** @var The highest number of transaction fragments ever waiting in the worker queue. */
+    uint32_t m_queueMaxUsage;
+
+    /** @var The number of row operations replayed by the worker. */
+    uint64_t m_appliedOperations;
+};
+
 class IRecoveryManager {
 public:
     // destructor
@@ -89,6 +107,25 @@ public:
     virtual void AddSurrogateArrayToList(SurrogateState& surrogate) = 0;
     virtual void SetCsn(uint64_t csn) = 0;
 
+    /**
+     * @brief Waits until all the dispatched redo records are replayed and blocks further dispatching
+     * until ResumeRedoApply() is called. Used to take a consistent checkpoint snapshot on a standby.
+     */
+    virtual void SuspendRedoApply() = 0;
+
+    /**
+     * @brief Resumes redo dispatching after SuspendRedoApply().
+     */
+    virtual void ResumeRedoApply() = 0;
+
+    /**
+     * @brief Retrieves the progress of the parallel redo workers.
+     * @param stats the output array.
+     * @param maxWorkers the number of entries in the output array.
+     * @return The number of entries filled.
+     */
+    virtual uint32_t GetRedoWorkerStats(RedoWorkerStats* stats, uint32_t maxWorkers) = 0;
+
 protected:
     // constructor
     IRecoveryManager()
@@ -0,0 +1,443 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * parallel_redo_applier.cpp
+ *    Replays committed redo transactions using multiple worker threads.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/src/system/recovery/parallel_redo_applier.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "mot_engine.h"
+#include "parallel_redo_applier.h"
+#include "recovery_manager.h"
+#include "recovery_ops.h"
+
+namespace MOT {
+DECLARE_LOGGER(ParallelRedoApplier, Recovery);
+
+// FNV-1a parameters used for routing row operations to workers
+static constexpr uint64_t ROUTE_HASH_OFFSET = 14695981039346656037ULL;
+static constexpr uint64_t ROUTE_HASH_PRIME = 1099511628211ULL;
+
+ParallelRedoApplier::ParallelRedoApplier(uint32_t numWorkers)
+    : m_numWorkers(numWorkers), m_started(false), m_errorSet(false), m_errorCode(RC_OK)
+{}
+
+ParallelRedoApplier::~ParallelRedoApplier()
+{
+    Stop();
+}
+
+bool ParallelRedoApplier::StartWorkers()
+{
+    std::lock_guard<std::mutex> lock(m_workersLock);
+    for (uint32_t i = 0; i < m_numWorkers; ++i) {
+        Worker* worker = new (std::nothrow) Worker();
+        if (worker == nullptr) {
+            MOT_REPORT_ERROR(MOT_ERROR_OOM, "Parallel Redo", "Failed to allocate redo worker %u", i);
+            break;
+        }
+        m_workers.push_back(worker);
+    }
+
+    if (m_workers.size() != m_numWorkers) {
+        for (Worker* worker : m_workers) {
+            delete worker;
+        }
+        m_workers.clear();
+        return false;
+    }
+
+    for (uint32_t i = 0; i < m_numWorkers; ++i) {
+        m_workers[i]->m_thread = std::thread(WorkerFunc, this, i);
+    }
+    m_started = true;
+    MOT_LOG_INFO("Started %u parallel redo workers", m_numWorkers);
+    return true;
+}
+
+RC ParallelRedoApplier::Dispatch(RedoLogTransactionSegments* segments, uint64_t transactionId, bool& dispatched)
+{
+    dispatched = false;
+    std::lock_guard<std::mutex> lock(m_dispatchLock);
+    if (m_errorSet) {
+        return m_errorCode;
+    }
+
+    std::vector<WorkItem*> items(m_numWorkers, nullptr);
+    auto cleanupItems = [&items]() {
+        for (WorkItem* item : items) {
+            if (item != nullptr) {
+                delete item;
+            }
+        }
+    };
+
+    // split the row operations of the transaction by worker, the end blocks are not replayed since the workers
+    // commit the shares of the transaction together
+    uint32_t numItems = 0;
+    for (uint32_t i = 0; i < segments->GetCount(); i++) {
+        LogSegment* segment = segments->GetSegment(i);
+        uint8_t* operationData = (uint8_t*)segment->m_data;
+        uint8_t* endPosition = (uint8_t*)(segment->m_data + segment->m_len);
+        while (operationData < endPosition) {
+            OperationCode opCode = *(OperationCode*)operationData;
+            if (opCode == PARTIAL_REDO_TX || opCode == PREPARE_TX || opCode == COMMIT_TX ||
+                opCode == COMMIT_PREPARED_TX) {
+                operationData += sizeof(EndSegmentBlock);
+                continue;
+            }
+
+            Table* table = nullptr;
+            uint8_t* keyData = nullptr;
+            uint16_t keyLength = 0;
+            uint32_t operationLength = RecoveryOps::ParseRowOperation(operationData, table, keyData, keyLength);
+            if (operationLength == 0) {
+                // not a row operation, the transaction must be replayed serially
+                cleanupItems();
+                return RC_OK;
+            }
+
+            uint32_t workerId = GetWorkerId(table, keyData, keyLength);
+            if (items[workerId] == nullptr) {
+                items[workerId] = new (std::nothrow) WorkItem();
+                if (items[workerId] == nullptr) {
+                    MOT_REPORT_ERROR(MOT_ERROR_OOM, "Parallel Redo", "Failed to allocate redo work item");
+                    cleanupItems();
+                    return RC_MEMORY_ALLOCATION_ERROR;
+                }
+                ++numItems;
+            }
+            items[workerId]->m_operations.push_back(operationData);
+            operationData += operationLength;
+        }
+    }
+
+    if (numItems == 0) {
+        return RC_OK;
+    }
+
+    if (!m_started && !StartWorkers()) {
+        cleanupItems();
+        return RC_ERROR;
+    }
+
+    TxnTask* task = new (std::nothrow) TxnTask();
+    if (task == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Parallel Redo", "Failed to allocate redo transaction task");
+        cleanupItems();
+        return RC_MEMORY_ALLOCATION_ERROR;
+    }
+    LogSegment* lastSegment = segments->GetSegment(segments->GetCount() - 1);
+    task->m_segments = segments;
+    task->m_transactionId = transactionId;
+    task->m_csn = lastSegment->m_controlBlock.m_csn;
+    task->m_replayLsn = lastSegment->m_replayLsn;
+    task->m_pendingWorkers = numItems;
+    task->m_pendingSlices = numItems;
+    task->m_failed = false;
+
+    dispatched = true;
+    for (uint32_t i = 0; i < m_numWorkers; i++) {
+        if (items[i] != nullptr) {
+            items[i]->m_task = task;
+            Enqueue(i, items[i]);
+        }
+    }
+    return RC_OK;
+}
+
+uint32_t ParallelRedoApplier::GetWorkerId(Table* table, const uint8_t* keyData, uint16_t keyLength) const
+{
+    uint64_t hash = ROUTE_HASH_OFFSET ^ table->GetTableId();
+    hash *= ROUTE_HASH_PRIME;
+    for (uint16_t i = 1; i < table->GetNumIndexes(); i++) {
+        if (table->GetSecondaryIndex(i)->GetUnique()) {
+            return (uint32_t)(hash % m_numWorkers);
+        }
+    }
+
+    for (uint16_t i = 0; i < keyLength; i++) {
+        hash ^= keyData[i];
+        hash *= ROUTE_HASH_PRIME;
+    }
+    return (uint32_t)(hash % m_numWorkers);
+}
+
+void ParallelRedoApplier::Enqueue(uint32_t workerId, WorkItem* item)
+{
+    Worker* worker = m_workers[workerId];
+    std::unique_lock<std::mutex> lock(worker->m_lock);
+    worker->m_cond.wait(lock, [worker]() { return worker->m_queue.size() < MAX_QUEUE_SIZE; });
+    worker->m_queue.push_back(item);
+    uint32_t queueUsage = (uint32_t)worker->m_queue.size();
+    if (queueUsage > worker->m_queueMaxUsage) {
+        worker->m_queueMaxUsage = queueUsage;
+    }
+    lock.unlock();
+    worker->m_cond.notify_all();
+}
+
+void ParallelRedoApplier::Drain()
+{
+    std::lock_guard<std::mutex> lock(m_dispatchLock);
+    DrainInternal();
+}
+
+void ParallelRedoApplier::DrainInternal()
+{
+    if (!m_started) {
+        return;
+    }
+
+    for (Worker* worker : m_workers) {
+        std::unique_lock<std::mutex> lock(worker->m_lock);
+        worker->m_cond.wait(lock, [worker]() { return worker->m_queue.empty() && !worker->m_busy; });
+    }
+}
+
+void ParallelRedoApplier::Suspend()
+{
+    m_dispatchLock.lock();
+    DrainInternal();
+}
+
+void ParallelRedoApplier::Resume()
+{
+    m_dispatchLock.unlock();
+}
+
+void ParallelRedoApplier::Stop()
+{
+    std::lock_guard<std::mutex> lock(m_dispatchLock);
+    if (!m_started) {
+        return;
+    }
+
+    DrainInternal();
+    for (Worker* worker : m_workers) {
+        {
+            std::lock_guard<std::mutex> workerLock(worker->m_lock);
+            worker->m_stop = true;
+        }
+        worker->m_cond.notify_all();
+    }
+
+    std::lock_guard<std::mutex> workersLock(m_workersLock);
+    for (Worker* worker : m_workers) {
+        if (worker->m_thread.joinable()) {
+            worker->m_thread.join();
+        }
+        delete worker;
+    }
+    m_workers.clear();
+    m_started = false;
+    MOT_LOG_INFO("Stopped parallel redo workers");
+}
+
+uint32_t ParallelRedoApplier::GetWorkerStats(RedoWorkerStats* stats, uint32_t maxWorkers) const
+{
+    std::lock_guard<std::mutex> lock(m_workersLock);
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < m_workers.size() && count < maxWorkers; i++) {
+        Worker* worker = m_workers[i];
+        stats[count].m_workerId = i;
+        {
+            std::lock_guard<std::mutex> workerLock(worker->m_lock);
+            stats[count].m_queueUsage = (uint32_t)worker->m_queue.size();
+        }
+        stats[count].m_queueMaxUsage = worker->m_queueMaxUsage;
+        stats[count].m_appliedOperations = worker->m_appliedOperations;
+        ++count;
+    }
+    return count;
+}
+
+void ParallelRedoApplier::CompleteTask(TxnTask* task)
+{
+    if (--task->m_pendingWorkers > 0) {
+        return;
+    }
+
+    // last worker to finish its share of the transaction
+    RecoveryManager* recoveryManager = (RecoveryManager*)GetRecoveryManager();
+    recoveryManager->SetCsn(task->m_csn);
+    if (recoveryManager->m_logStats != nullptr) {
+        recoveryManager->m_logStats->IncCommit();
+    }
+    delete task->m_segments;
+    delete task;
+}
+
+void ParallelRedoApplier::OnError(RC errorCode)
+{
+    std::lock_guard<std::mutex> lock(m_errorLock);
+    if (!m_errorSet) {
+        m_errorCode = errorCode;
+        m_errorSet = true;
+    }
+}
+
+bool ParallelRedoApplier::WaitForSlices(TxnTask* task, bool applied)
+{
+    std::unique_lock<std::mutex> lock(task->m_lock);
+    if (!applied) {
+        task->m_failed = true;
+    }
+
+    if (--task->m_pendingSlices == 0) {
+        task->m_cond.notify_all();
+    } else {
+        task->m_cond.wait(lock, [task]() { return task->m_pendingSlices == 0; });
+    }
+    return !task->m_failed;
+}
+
+RC ParallelRedoApplier::ApplyOperations(Worker* worker, TxnManager* txn, WorkItem* item, SurrogateState& sState)
+{
+    TxnTask* task = item->m_task;
+    RecoveryManager* recoveryManager = (RecoveryManager*)GetRecoveryManager();
+    RC status = RC_OK;
+    bool wasCommit = false;
+
+    for (uint8_t* operationData : item->m_operations) {
+        if (recoveryManager->IsRecoveryMemoryLimitReached(m_numWorkers)) {
+            MOT_LOG_ERROR("Memory hard limit reached. Cannot recover datanode");
+            return RC_ERROR;
+        }
+
+        (void)RecoveryOps::RecoverLogOperation(
+            txn, operationData, task->m_csn, task->m_transactionId, MOTCurrThreadId, sState, status, wasCommit);
+        if (status != RC_OK) {
+            MOT_REPORT_ERROR(MOT_ERROR_RESOURCE_LIMIT, "Parallel Redo", "Failed to recover redo operation");
+            return status;
+        }
+        ++worker->m_appliedOperations;
+    }
+
+    status = txn->ValidateCommit();
+    if (status != RC_OK) {
+        MOT_REPORT_ERROR(MOT_ERROR_INTERNAL,
+            "Parallel Redo",
+            "Failed to validate recovery transaction: %s (error code: %u)",
+            RcToString(status),
+            status);
+    }
+    return status;
+}
+
+RC ParallelRedoApplier::ApplyWorkItem(Worker* worker, WorkItem* item, SurrogateState& sState)
+{
+    TxnManager* txn = MOTCurrTxn;
+    TxnTask* task = item->m_task;
+
+    // after an error the share is not applied, but the other workers sharing the transaction still wait for it
+    if (IsErrorSet()) {
+        (void)WaitForSlices(task, false);
+        return RC_OK;
+    }
+
+    RC status = RecoveryOps::BeginTransaction(txn, task->m_replayLsn);
+    if (status != RC_OK) {
+        MOT_REPORT_ERROR(MOT_ERROR_RESOURCE_LIMIT, "Parallel Redo", "Cannot start a new transaction");
+        (void)WaitForSlices(task, false);
+        return status;
+    }
+
+    status = ApplyOperations(worker, txn, item, sState);
+
+    // the transaction is committed only when all its shares are applied, so it is replayed atomically
+    if (!WaitForSlices(task, status == RC_OK)) {
+        RecoveryOps::RollbackTransaction(txn);
+        return status;
+    }
+
+    txn->SetCommitSequenceNumber(task->m_csn);
+    txn->RecordCommit();
+    txn->EndTransaction();
+    return RC_OK;
+}
+
+void ParallelRedoApplier::WorkerFunc(ParallelRedoApplier* applier, uint32_t workerId)
+{
+    // since this is a non-kernel thread we must set-up our own u_sess struct for the current thread
+    MOT_DECLARE_NON_KERNEL_THREAD();
+
+    MOT::MOTEngine* engine = MOT::MOTEngine::GetInstance();
+    Worker* worker = applier->m_workers[workerId];
+    SessionContext* sessionContext = GetSessionManager()->CreateSessionContext();
+    if (sessionContext == nullptr) {
+        MOT_LOG_ERROR("ParallelRedoApplier::WorkerFunc: failed to create session context");
+        applier->OnError(RC_MEMORY_ALLOCATION_ERROR);
+    }
+
+    // in a thread-pooled envelope the affinity could be disabled, so we use task affinity here
+    if (GetGlobalConfiguration().m_enableNuma && !GetTaskAffinity().SetAffinity(MOTCurrThreadId)) {
+        MOT_LOG_WARN("Failed to set affinity of redo worker, redo replay performance may be affected");
+    }
+
+    SurrogateState sState;
+    if (!sState.IsValid()) {
+        MOT_LOG_ERROR("ParallelRedoApplier::WorkerFunc: failed to allocate surrogate state");
+        applier->OnError(RC_MEMORY_ALLOCATION_ERROR);
+    }
+    MOT_LOG_DEBUG("ParallelRedoApplier::WorkerFunc start [%u] on cpu %lu", workerId, sched_getcpu());
+
+    while (true) {
+        WorkItem* item = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(worker->m_lock);
+            worker->m_cond.wait(lock, [worker]() { return worker->m_stop || !worker->m_queue.empty(); });
+            if (worker->m_queue.empty()) {
+                break;
+            }
+            item = worker->m_queue.front();
+            worker->m_queue.pop_front();
+            worker->m_busy = true;
+        }
+        worker->m_cond.notify_all();
+
+        // after an error the queue is still consumed, so that the dispatcher is never blocked
+        RC status = applier->ApplyWorkItem(worker, item, sState);
+        if (status != RC_OK) {
+            MOT_LOG_ERROR("ParallelRedoApplier::WorkerFunc: replay of transaction %lu failed with rc %d",
+                item->m_task->m_transactionId,
+                status);
+            applier->OnError(status);
+        }
+        applier->CompleteTask(item->m_task);
+        delete item;
+
+        {
+            std::lock_guard<std::mutex> lock(worker->m_lock);
+            worker->m_busy = false;
+        }
+        worker->m_cond.notify_all();
+    }
+
+    if (sState.IsValid() && !sState.IsEmpty()) {
+        GetRecoveryManager()->AddSurrogateArrayToList(sState);
+    }
+
+    if (sessionContext != nullptr) {
+        GetSessionManager()->DestroySessionContext(sessionContext);
+    }
+    engine->OnCurrentThreadEnding();
+    MOT_LOG_DEBUG("ParallelRedoApplier::WorkerFunc end [%u] on cpu %lu", workerId, sched_getcpu());
+}
+}  // namespace MOT
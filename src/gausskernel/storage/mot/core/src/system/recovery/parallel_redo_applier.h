@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * parallel_redo_applier.h
+ *    Replays committed redo transactions using multiple worker threads.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/src/system/recovery/parallel_redo_applier.h
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef PARALLEL_REDO_APPLIER_H
+#define PARALLEL_REDO_APPLIER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "global.h"
+#include "irecovery_manager.h"
+#include "redo_log_transaction_segments.h"
+
+namespace MOT {
+class Table;
+class SurrogateState;
+class TxnManager;
+
+/**
+ * @class ParallelRedoApplier
+ * @brief Replays committed redo transactions using a pool of worker threads. The row operations of each
+ * transaction are routed to a worker by table id and primary key hash, so all the changes to a given key are
+ * replayed by the same worker in commit order. Each worker replays its share of a transaction as a single
+ * recovery transaction carrying the original commit sequence number, and validates it. The shares are committed
+ * only once all of them are applied, or are all rolled back if any of them failed, so a transaction never becomes
+ * partially visible. Transactions that do not consist of row operations only (DDL) cannot be split, and must be
+ * replayed serially by the caller after Drain().
+ */
+class ParallelRedoApplier {
+public:
+    explicit ParallelRedoApplier(uint32_t numWorkers);
+
+    ~ParallelRedoApplier();
+
+    /**
+     * @brief Queries whether parallel replay is configured.
+     */
+    inline bool IsEnabled() const
+    {
+        return m_numWorkers > 1;
+    }
+
+    /**
+     * @brief Distributes a committed transaction among the workers.
+     * @param segments the transaction segments. Ownership is taken only if the transaction was dispatched.
+     * @param transactionId the internal transaction id.
+     * @param[out] dispatched set to false if the transaction cannot be replayed in parallel.
+     * @return RC value denoting the operation's status.
+     */
+    RC Dispatch(RedoLogTransactionSegments* segments, uint64_t transactionId, bool& dispatched);
+
+    /**
+     * @brief Waits until all the dispatched transactions are replayed.
+     */
+    void Drain();
+
+    /**
+     * @brief Drains the workers and blocks further dispatching until Resume() is called.
+     */
+    void Suspend();
+
+    /**
+     * @brief Allows dispatching after Suspend().
+     */
+    void Resume();
+
+    /**
+     * @brief Drains and terminates the workers.
+     */
+    void Stop();
+
+    inline bool IsErrorSet() const
+    {
+        return m_errorSet;
+    }
+
+    /**
+     * @brief Retrieves the progress of the workers.
+     * @param stats the output array.
+     * @param maxWorkers the number of entries in the output array.
+     * @return The number of entries filled.
+     */
+    uint32_t GetWorkerStats(RedoWorkerStats* stats, uint32_t maxWorkers) const;
+
+private:
+    /** @var The maximum number of transaction fragments waiting in a worker queue before dispatching blocks. */
+    static constexpr uint32_t MAX_QUEUE_SIZE = 1024;
+
+    /**
+     * @struct TxnTask
+     * @brief A dispatched transaction, shared by all the workers that replay part of it.
+     */
+    struct TxnTask {
+        RedoLogTransactionSegments* m_segments;
+
+        uint64_t m_transactionId;
+
+        uint64_t m_csn;
+
+        uint64_t m_replayLsn;
+
+        std::atomic<uint32_t> m_pendingWorkers;
+
+        /** @var Protects the slice countdown. */
+        std::mutex m_lock;
+
+        std::condition_variable m_cond;
+
+        /** @var The number of workers that have not finished applying their share yet. */
+        uint32_t m_pendingSlices;
+
+        /** @var Set if the share of any worker failed. */
+        bool m_failed;
+    };
+
+    /**
+     * @struct WorkItem
+     * @brief The row operations of a transaction assigned to a single worker.
+     */
+    struct WorkItem {
+        TxnTask* m_task;
+
+        std::vector<uint8_t*> m_operations;
+    };
+
+    /**
+     * @struct Worker
+     * @brief A worker thread and its queue.
+     */
+    struct Worker {
+        std::thread m_thread;
+
+        std::mutex m_lock;
+
+        std::condition_variable m_cond;
+
+        std::deque<WorkItem*> m_queue;
+
+        bool m_busy = false;
+
+        bool m_stop = false;
+
+        std::atomic<uint32_t> m_queueMaxUsage{0};
+
+        std::atomic<uint64_t> m_appliedOperations{0};
+    };
+
+    bool StartWorkers();
+
+    void DrainInternal();
+
+    void Enqueue(uint32_t workerId, WorkItem* item);
+
+    RC ApplyWorkItem(Worker* worker, WorkItem* item, SurrogateState& sState);
+
+    RC ApplyOperations(Worker* worker, TxnManager* txn, WorkItem* item, SurrogateState& sState);
+
+    /**
+     * @brief Reports that a worker finished applying its share of a transaction, and waits for the other workers
+     * sharing the transaction. Since transactions are dispatched in commit order to FIFO queues, the other shares
+     * are never queued behind a share of a later transaction.
+     * @param task the transaction.
+     * @param applied whether the share of the calling worker was applied and validated.
+     * @return True if all the shares were applied and may be committed, false if they must be rolled back.
+     */
+    bool WaitForSlices(TxnTask* task, bool applied);
+
+    /**
+     * @brief Selects the worker of a row operation. Tables with unique secondary indexes are bound to a single
+     * worker, since operations on different primary keys may collide on a secondary key.
+     */
+    uint32_t GetWorkerId(Table* table, const uint8_t* keyData, uint16_t keyLength) const;
+
+    void CompleteTask(TxnTask* task);
+
+    void OnError(RC errorCode);
+
+    static void WorkerFunc(ParallelRedoApplier* applier, uint32_t workerId);
+
+    uint32_t m_numWorkers;
+
+    std::vector<Worker*> m_workers;
+
+    std::atomic<bool> m_started;
+
+    /** @var Serializes dispatching, and is held between Suspend() and Resume(). */
+    std::mutex m_dispatchLock;
+
+    /** @var Protects the worker array against concurrent statistics reporting. */
+    mutable std::mutex m_workersLock;
+
+    std::mutex m_errorLock;
+
+    volatile bool m_errorSet;
+
+    RC m_errorCode;
+};
+}  // namespace MOT
+
+#endif /* PARALLEL_REDO_APPLIER_H */
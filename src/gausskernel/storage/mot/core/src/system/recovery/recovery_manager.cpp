@@ -95,6 +95,9 @@ bool RecoveryManager::RecoverDbStart()
 
 bool RecoveryManager::RecoverDbEnd()
 {
+    // wait for the parallel redo workers to replay all the dispatched transactions
+    m_redoApplier.Stop();
+
     if (MOTEngine::GetInstance()->GetInProcessTransactions().GetNumTxns() != 0) {
         MOT_LOG_ERROR("MOT recovery: There are uncommitted or incomplete transactions, "
             "ignoring and clearing those log segments.");
@@ -117,7 +120,7 @@ bool RecoveryManager::RecoverDbEnd()
         m_logStats->Print();
     }
 
-    bool success = !m_errorSet;
+    bool success = !IsErrorSet();
     MOT_LOG_INFO("MOT recovery %s", success ? "completed" : "failed");
     return success;
 }
@@ -128,6 +131,8 @@ void RecoveryManager::CleanUp()
         return;
     }
 
+    m_redoApplier.Stop();
+
     if (m_logStats != nullptr) {
         delete m_logStats;
         m_logStats = nullptr;
@@ -224,6 +229,10 @@ bool RecoveryManager::OperateOnRecoveredTransaction(
     uint64_t internalTransactionId, uint64_t externalTransactionId, RecoveryOps::RecoveryOpState rState)
 {
     RC status = RC_OK;
+    if (rState != RecoveryOps::RecoveryOpState::ABORT && m_redoApplier.IsEnabled()) {
+        return OperateOnRecoveredTransactionParallel(internalTransactionId, externalTransactionId);
+    }
+
     if (rState != RecoveryOps::RecoveryOpState::ABORT) {
         auto operateLambda = [this](RedoLogTransactionSegments* segments, uint64_t id) -> RC {
             RC redoStatus = RC_OK;
@@ -250,6 +259,44 @@ bool RecoveryManager::OperateOnRecoveredTransaction(
     return true;
 }
 
+bool RecoveryManager::OperateOnRecoveredTransactionParallel(
+    uint64_t internalTransactionId, uint64_t externalTransactionId)
+{
+    InProcessTransactions& inProcessTransactions = MOTEngine::GetInstance()->GetInProcessTransactions();
+    RedoLogTransactionSegments* segments =
+        inProcessTransactions.DetachTransaction(internalTransactionId, externalTransactionId);
+    if (segments == nullptr) {
+        MOT_LOG_ERROR("OperateOnRecoveredTransaction: transaction %lu not found", internalTransactionId);
+        return false;
+    }
+
+    bool dispatched = false;
+    RC status = m_redoApplier.Dispatch(segments, internalTransactionId, dispatched);
+    if (status == RC_OK && !dispatched) {
+        // DDL transaction: replay it serially once all the transactions that precede it are replayed
+        m_redoApplier.Drain();
+        if (m_redoApplier.IsErrorSet()) {
+            status = RC_ERROR;
+        } else {
+            LogSegment* segment = segments->GetSegment(segments->GetCount() - 1);
+            uint64_t csn = segment->m_controlBlock.m_csn;
+            for (uint32_t i = 0; i < segments->GetCount() && status == RC_OK; i++) {
+                status = RedoSegment(
+                    segments->GetSegment(i), csn, internalTransactionId, RecoveryOps::RecoveryOpState::COMMIT);
+            }
+        }
+    }
+
+    if (!dispatched) {
+        delete segments;
+    }
+    if (status != RC_OK) {
+        MOT_LOG_ERROR("OperateOnRecoveredTransaction: wal recovery failed with rc %d", status);
+        return false;
+    }
+    return true;
+}
+
 RC RecoveryManager::RedoSegment(
     LogSegment* segment, uint64_t csn, uint64_t transactionId, RecoveryOps::RecoveryOpState rState)
 {
@@ -293,10 +340,7 @@ RC RecoveryManager::RedoSegment(
         }
     }
 
-    // single threaded, no need for locking or CAS
-    if (csn > m_maxRecoveredCsn) {
-        m_maxRecoveredCsn = csn;
-    }
+    SetCsn(csn);
     if (status != RC_OK) {
         MOT_LOG_ERROR("RecoveryManager::redoSegment: got error %u on tid %lu", status, transactionId);
     }
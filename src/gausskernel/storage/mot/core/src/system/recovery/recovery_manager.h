@@ -36,6 +36,7 @@
 #include "surrogate_state.h"
 #include "checkpoint_recovery.h"
 #include "recovery_ops.h"
+#include "parallel_redo_applier.h"
 
 namespace MOT {
 /**
@@ -57,7 +58,8 @@ public:
           m_errorSet(false),
           m_clogCallback(nullptr),
           m_threadId(AllocThreadId()),
-          m_maxConnections(GetGlobalConfiguration().m_maxConnections)
+          m_maxConnections(GetGlobalConfiguration().m_maxConnections),
+          m_redoApplier(GetGlobalConfiguration().m_parallelRedoWorkers)
     {}
 
     ~RecoveryManager() override
@@ -123,13 +125,14 @@ public:
 
     bool IsErrorSet() const override
     {
-        return m_errorSet;
+        return m_errorSet || m_redoApplier.IsErrorSet();
     }
 
     inline void SetLastReplayLsn(uint64_t replayLsn) override
     {
-        if (m_lastReplayLsn < replayLsn) {
-            m_lastReplayLsn = replayLsn;
+        // may be called concurrently by the parallel redo workers
+        uint64_t currentLsn = m_lastReplayLsn;
+        while (currentLsn < replayLsn && !m_lastReplayLsn.compare_exchange_weak(currentLsn, replayLsn)) {
         }
     }
 
@@ -138,6 +141,28 @@ public:
         return m_lastReplayLsn;
     }
 
+    inline void SuspendRedoApply() override
+    {
+        m_redoApplier.Suspend();
+    }
+
+    inline void ResumeRedoApply() override
+    {
+        m_redoApplier.Resume();
+    }
+
+    inline uint32_t GetRedoWorkerStats(RedoWorkerStats* stats, uint32_t maxWorkers) override
+    {
+        return m_redoApplier.GetWorkerStats(stats, maxWorkers);
+    }
+
+    /**
+     * @brief returns if a recovery memory limit reached.
+     * @return Boolean value that is true if there is not enough memory for
+     * recovery.
+     */
+    bool IsRecoveryMemoryLimitReached(uint32_t numThreads);
+
     /**
      * @class LogStats
      * @brief A per-table recovery stats collector
@@ -274,6 +299,14 @@ private:
     bool OperateOnRecoveredTransaction(
         uint64_t internalTransactionId, uint64_t externalTransactionId, RecoveryOps::RecoveryOpState rState);
 
+    /**
+     * @brief commits a recovered transaction through the parallel redo workers.
+     * @param internalTransactionId the internal transaction id to operate on.
+     * @param externalTransactionId the external transaction id to operate on.
+     * @return Boolean value denoting success or failure.
+     */
+    bool OperateOnRecoveredTransactionParallel(uint64_t internalTransactionId, uint64_t externalTransactionId);
+
     /**
      * @brief checks if a transaction id specified in the log segment is an mot
      * only one.
@@ -296,13 +329,6 @@ private:
      */
     bool IsCheckpointValid(uint64_t id);
 
-    /**
-     * @brief returns if a recovery memory limit reached.
-     * @return Boolean value that is true if there is not enough memory for
-     * recovery.
-     */
-    bool IsRecoveryMemoryLimitReached(uint32_t numThreads);
-
     /**
      * @brief restores the surrogate counters to their last good known state
      */
@@ -314,7 +340,7 @@ private:
 
     uint64_t m_lsn;
 
-    uint64_t m_lastReplayLsn;
+    std::atomic<uint64_t> m_lastReplayLsn;
 
     std::atomic<uint32_t> m_tid;
 
@@ -339,6 +365,8 @@ private:
     uint16_t m_maxConnections;
 
     CheckpointRecovery m_checkpointRecovery;
+
+    ParallelRedoApplier m_redoApplier;
 };
 }  // namespace MOT
 
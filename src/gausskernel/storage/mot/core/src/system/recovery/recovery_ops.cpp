@@ -111,11 +111,11 @@ uint32_t RecoveryOps::RecoverLogOperationCreateTable(
     switch (state) {
         case COMMIT:
             MOT_LOG_DEBUG("RecoverLogOperationCreateTable: COMMIT");
-            CreateTable(txn, (char*)data, status, table, TRANSACTIONAL);
+            CreateTable(txn, (char*)data, bufSize, status, table, TRANSACTIONAL);
             break;
 
         case TPC_APPLY:
-            CreateTable(txn, (char*)data, status, table, DONT_ADD_TO_ENGINE);
+            CreateTable(txn, (char*)data, bufSize, status, table, DONT_ADD_TO_ENGINE);
             if (status == RC_OK && table != nullptr) {
                 tableInfo = new (std::nothrow) TableInfo(table, transactionId);
                 if (tableInfo != nullptr) {
@@ -479,7 +479,7 @@ void RecoveryOps::InsertRow(TxnManager* txn, uint64_t tableId, uint64_t exId, ch
         return;
     }
 
-    Row* row = table->CreateNewRow();
+    Row* row = table->CreateNewRow((const uint8_t*)keyData, keyLen);
     if (row == nullptr) {
         status = RC_ERROR;
         MOT_REPORT_ERROR(MOT_ERROR_OOM, "Recover Insert Row", "Failed to create row");
@@ -654,7 +654,8 @@ void RecoveryOps::UpdateRow(TxnManager* txn, uint64_t tableId, uint64_t exId, ch
     txn->DestroyTxnKey(key);
 }
 
-void RecoveryOps::CreateTable(TxnManager* txn, char* data, RC& status, Table*& table, CreateTableMethod method)
+void RecoveryOps::CreateTable(
+    TxnManager* txn, char* data, size_t len, RC& status, Table*& table, CreateTableMethod method)
 {
     /* first verify that the table does not exists */
     string name;
@@ -675,7 +676,7 @@ void RecoveryOps::CreateTable(TxnManager* txn, char* data, RC& status, Table*& t
         return;
     }
 
-    table->Deserialize((const char*)data);
+    table->Deserialize((const char*)data, len);
     do {
         if (!table->IsDeserialized()) {
             MOT_LOG_ERROR("CreateTable: failed to de-serialize table");
@@ -845,6 +846,59 @@ void RecoveryOps::TruncateTable(TxnManager* txn, char* data, RC& status)
     table->Unlock();
 }
 
+uint32_t RecoveryOps::ParseRowOperation(uint8_t* data, Table*& table, uint8_t*& keyData, uint16_t& keyLength)
+{
+    uint64_t tableId, exId, rowId, rowLength;
+    uint8_t* start = data;
+
+    OperationCode opCode = *(OperationCode*)data;
+    if (opCode != CREATE_ROW && opCode != UPDATE_ROW && opCode != OVERWRITE_ROW && opCode != REMOVE_ROW) {
+        return 0;
+    }
+    data += sizeof(OperationCode);
+
+    Extract(data, tableId);
+    Extract(data, exId);
+    if (opCode == CREATE_ROW) {
+        Extract(data, rowId);
+    }
+    Extract(data, keyLength);
+    keyData = ExtractPtr(data, keyLength);
+
+    table = GetTableManager()->GetTableByExternal(exId);
+    if (table == nullptr) {
+        MOT_LOG_DEBUG("ParseRowOperation: table %" PRIu64 " does not exist", exId);
+        return 0;
+    }
+
+    switch (opCode) {
+        case CREATE_ROW:
+        case OVERWRITE_ROW:
+            Extract(data, rowLength);
+            (void)ExtractPtr(data, rowLength);
+            break;
+        case UPDATE_ROW: {
+            // the size of the delta depends on the columns that were modified
+            uint16_t numColumns = table->GetFieldCount() - 1;
+            BitmapSet updatedColumns(ExtractPtr(data, BitmapSet::GetLength(numColumns)), numColumns);
+            BitmapSet validColumns(ExtractPtr(data, BitmapSet::GetLength(numColumns)), numColumns);
+            BitmapSet::BitmapSetIterator updatedColumnsIt(updatedColumns);
+            BitmapSet::BitmapSetIterator validColumnsIt(validColumns);
+            while (!updatedColumnsIt.End()) {
+                if (updatedColumnsIt.IsSet() && validColumnsIt.IsSet()) {
+                    data += table->GetField(updatedColumnsIt.GetPosition() + 1)->m_size;
+                }
+                validColumnsIt.Next();
+                updatedColumnsIt.Next();
+            }
+            break;
+        }
+        default:
+            break;
+    }
+    return (uint32_t)(data - start);
+}
+
 RC RecoveryOps::BeginTransaction(TxnManager* txn, uint64_t replayLsn)
 {
     if (txn == nullptr) {
@@ -104,7 +104,27 @@ public:
      */
     static RC BeginTransaction(TxnManager* txn, uint64_t replayLsn = 0);
 
+    /**
+     * @brief Commits the current recovery transaction.
+     * @param transaction manager object.
+     * @param transaction's commit sequence number.
+     */
+    static RC CommitTransaction(TxnManager* txn, uint64_t csn);
+
+    /**
+     * @brief Extracts the table and primary key of a row operation without applying it.
+     * @param data the buffer holding the operation.
+     * @param[out] table the table the operation refers to.
+     * @param[out] keyData the primary key data of the row.
+     * @param[out] keyLength the primary key length.
+     * @return Int value denoting the number of bytes the operation occupies, or 0 if the buffer does not
+     * hold a row operation or its table cannot be found.
+     */
+    static uint32_t ParseRowOperation(uint8_t* data, Table*& table, uint8_t*& keyData, uint16_t& keyLength);
+
 private:
+    friend class CheckpointRecovery;
+
     /**
      * @brief performs an insert operation of a data buffer.
      * @param transaction manager object.
@@ -280,11 +300,13 @@ private:
      * @brief performs the actual table creation.
      * @param transaction manager object.
      * @param data the table's data.
+     * @param len the size of the table's data.
      * @param status the returned status of the operation.
      * @param table the returned table object.
      * @param method controls whether the table is added to the engine or not.
      */
-    static void CreateTable(TxnManager* txn, char* data, RC& status, Table*& table, CreateTableMethod method);
+    static void CreateTable(
+        TxnManager* txn, char* data, size_t len, RC& status, Table*& table, CreateTableMethod method);
 
     /**
      * @brief performs the actual table deletion.
@@ -319,13 +341,6 @@ private:
      */
     static void TruncateTable(TxnManager* txn, char* data, RC& status);
 
-    /**
-     * @brief Commits the current recovery transaction.
-     * @param transaction manager object.
-     * @param transaction's commit sequence number.
-     */
-    static RC CommitTransaction(TxnManager* txn, uint64_t csn);
-
     /**
      * @brief Rolls back the current recovery transaction.
      * @param transaction manager object.
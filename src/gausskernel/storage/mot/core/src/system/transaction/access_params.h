@@ -37,6 +37,7 @@ enum AccessFlags : uint8_t {
     row_commited_bit = (1U << 2),
     upgrade_insert_bit = (1U << 3),
     dummy_deleted_bit = (1U << 4),
+    pre_locked_bit = (1U << 5),
 };
 
 /**
@@ -84,6 +85,11 @@ public:
         return m_value & dummy_deleted_bit;
     }
 
+    bool IsPreLocked() const
+    {
+        return m_value & pre_locked_bit;
+    }
+
     void SetPrimarySentinel()
     {
         m_value |= (primary_sentinel_bit | unique_index_bit);
@@ -129,6 +135,16 @@ public:
         m_value &= ~dummy_deleted_bit;
     }
 
+    void SetPreLocked()
+    {
+        m_value |= pre_locked_bit;
+    }
+
+    void UnsetPreLocked()
+    {
+        m_value &= ~pre_locked_bit;
+    }
+
     void AssignParams(T x)
     {
         m_value = x;
@@ -34,6 +34,7 @@
 #include "txn_access.h"
 #include "txn_insert_action.h"
 #include "db_session_statistics.h"
+#include "memory_statistics.h"
 #include "utilities.h"
 #include "mm_api.h"
 
@@ -103,12 +104,31 @@ Row* TxnManager::RowLookup(const AccessType type, Sentinel* const& originalSenti
             return local_row;
         case RC::RC_LOCAL_ROW_NOT_FOUND:
             if (likely(originalSentinel->IsCommited() == true)) {
+                Table* table = originalSentinel->GetIndex()->GetTable();
+                Row* committedRow = originalSentinel->GetData();
+                if (table->GetPlacementNode() != -1 && committedRow != nullptr) {
+                    int placementNode = table->GetRowPlacementNode(committedRow);
+                    MemoryStatisticsProvider::m_provider->AddPlacedRowAccess(placementNode != MOTCurrentNumaNodeId);
+                }
                 // For Read-Only Txn return the Commited row
                 if (GetTxnIsoLevel() == READ_COMMITED and type == AccessType::RD) {
                     return m_accessMgr->GetReadCommitedRow(originalSentinel);
                 } else {
                     // Row is not in the cache,map it and return the local row
                     AccessType rd_type = (type != RD_FOR_UPDATE) ? RD : RD_FOR_UPDATE;
+                    if (rd_type == RD_FOR_UPDATE) {
+                        // A hot row is locked before it is copied, and stays locked until the transaction ends
+                        Sentinel* primarySentinel = static_cast<Sentinel*>(originalSentinel->GetPrimarySentinel());
+                        if (m_occManager.PreLockHotRow(this, primarySentinel)) {
+                            Row* row = m_accessMgr->MapRowtoLocalTable(rd_type, originalSentinel, rc);
+                            if (row != nullptr) {
+                                m_accessMgr->GetLastAccess()->m_params.SetPreLocked();
+                            } else {
+                                m_occManager.ReleasePreLock(primarySentinel);
+                            }
+                            return row;
+                        }
+                    }
                     return m_accessMgr->MapRowtoLocalTable(rd_type, originalSentinel, rc);
                 }
             } else
@@ -336,6 +356,7 @@ void TxnManager::RedoWriteAction(bool isCommit)
 void TxnManager::Cleanup()
 {
     if (m_isLightSession == false) {
+        m_occManager.ReleasePreLocks(this);
         m_accessMgr->ClearSet();
     }
     m_txnDdlAccess->Reset();
@@ -480,6 +501,7 @@ void TxnManager::RollbackDDLs()
                 if (indexArr->GetNumIndexes() > 0) {
                     MOT_ASSERT(indexArr->GetNumIndexes() == table->GetNumIndexes());
                     MOT_LOG_INFO("Rollback of truncate table %s", table->GetLongTableName().c_str());
+                    table->RequestFullCheckpoint();
                     for (int idx = 0; idx < indexArr->GetNumIndexes(); idx++) {
                         uint16_t oldIx = indexArr->GetIndexIx(idx);
                         MOT::Index* oldIndex = indexArr->GetIndex(idx);
@@ -707,6 +729,8 @@ bool TxnManager::Init(uint64_t _thread_id, uint64_t connection_id, bool isLightT
     }
 
     m_occManager.SetPreAbort(GetGlobalConfiguration().m_preAbort);
+    m_occManager.SetHotRowThresholds(
+        GetGlobalConfiguration().m_hotRowConflictThreshold, GetGlobalConfiguration().m_hotRowCooldown);
     if (validation_lock == TxnValidation::TXN_VALIDATION_NO_WAIT)
         m_occManager.SetValidationNoWait(true);
     else if (validation_lock == TxnValidation::TXN_VALIDATION_WAITING) {
@@ -1055,6 +1079,9 @@ RC TxnManager::TruncateTable(Table* table)
     if (m_isLightSession)  // really?
         return res;
 
+    // rows removed by truncate are not tracked individually, so a delta checkpoint cannot express it
+    table->RequestFullCheckpoint();
+
     TxnOrderedSet_t& access_row_set = m_accessMgr->GetOrderedRowSet();
     TxnOrderedSet_t::iterator it = access_row_set.begin();
     while (it != access_row_set.end()) {
@@ -441,6 +441,17 @@ public:
         m_occManager.SetValidationNoWait(b);
     }
 
+    /**
+     * @brief Sets or clears the hot-row-locking flag in OccTransactionManager.
+     * @detail Determines whether rows with frequent commit-time conflicts are
+     * locked at first write. Must be called before the transaction starts.
+     * @param b The new hot-row-locking flag state.
+     */
+    void SetHotRowLocking(bool b)
+    {
+        m_occManager.SetHotRowLocking(b);
+    }
+
     bool IsUpdatedInCurrStmt();
 
 private:
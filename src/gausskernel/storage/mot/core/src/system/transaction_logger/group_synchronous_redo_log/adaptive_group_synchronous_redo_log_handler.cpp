@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * adaptive_group_synchronous_redo_log_handler.cpp
+ *    Implements a per-numa group commit redo log with an adaptive flush window.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/src/system/transaction_logger/
+ *        group_synchronous_redo_log/adaptive_group_synchronous_redo_log_handler.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "adaptive_group_synchronous_redo_log_handler.h"
+#include "utilities.h"
+#include "mot_configuration.h"
+#include "session_context.h"
+#include "log_statistics.h"
+
+namespace MOT {
+DECLARE_LOGGER(AdaptiveGroupSyncRedoLogHandler, RedoLog);
+
+constexpr double AdaptiveGroupSyncRedoLogHandler::SAMPLE_WEIGHT;
+constexpr double AdaptiveGroupSyncRedoLogHandler::MAX_SAMPLE_MICROS;
+
+AdaptiveGroupSyncRedoLogHandler::AdaptiveGroupSyncRedoLogHandler()
+    : m_numaNodes(GetGlobalConfiguration().m_numaNodes),
+      m_collectors(nullptr),
+      m_maxBatchSize(GetGlobalConfiguration().m_groupCommitSize),
+      m_maxWindowMicros(GetGlobalConfiguration().m_groupCommitTimeoutUSec)
+{}
+
+bool AdaptiveGroupSyncRedoLogHandler::Init()
+{
+    m_collectors = new (std::nothrow) NodeCollector[m_numaNodes];
+    if (m_collectors == nullptr) {
+        MOT_LOG_ERROR("Error allocating redo log collector array");
+        return false;
+    }
+    MOT_LOG_INFO("Adaptive group commit initialized with maximum group size %u and maximum timeout %u micro-seconds",
+        (unsigned)m_maxBatchSize,
+        (unsigned)m_maxWindowMicros);
+    return true;
+}
+
+AdaptiveGroupSyncRedoLogHandler::~AdaptiveGroupSyncRedoLogHandler()
+{
+    if (m_collectors != nullptr) {
+        delete[] m_collectors;
+        m_collectors = nullptr;
+    }
+}
+
+RedoLogBuffer* AdaptiveGroupSyncRedoLogHandler::CreateBuffer()
+{
+    RedoLogBuffer* buffer = new (std::nothrow) RedoLogBuffer();
+    if (buffer != nullptr) {
+        if (!buffer->Initialize()) {
+            delete buffer;
+            buffer = nullptr;
+        }
+    }
+    return buffer;
+}
+
+void AdaptiveGroupSyncRedoLogHandler::DestroyBuffer(RedoLogBuffer* buffer)
+{
+    if (buffer != nullptr) {
+        delete buffer;
+    }
+}
+
+inline AdaptiveGroupSyncRedoLogHandler::NodeCollector& AdaptiveGroupSyncRedoLogHandler::GetCollector()
+{
+    int nodeId = MOTCurrentNumaNodeId;
+    if (nodeId < 0 || (unsigned int)nodeId >= m_numaNodes) {
+        nodeId = 0;
+    }
+    return m_collectors[nodeId];
+}
+
+uint64_t AdaptiveGroupSyncRedoLogHandler::ComputeWindow(NodeCollector& collector)
+{
+    // waiting pays off only if more commits are expected to arrive during a log write
+    if (collector.m_arrivalIntervalMicros >= collector.m_writeMicros) {
+        collector.m_targetSize = 1;
+        return 0;
+    }
+
+    double arrivalIntervalMicros = (collector.m_arrivalIntervalMicros < 1.0) ? 1.0 : collector.m_arrivalIntervalMicros;
+    uint64_t targetSize = (uint64_t)(collector.m_writeMicros / arrivalIntervalMicros) + 1;
+    collector.m_targetSize = (targetSize > m_maxBatchSize) ? m_maxBatchSize : targetSize;
+    uint64_t windowMicros = (uint64_t)collector.m_writeMicros;
+    return (windowMicros > m_maxWindowMicros) ? m_maxWindowMicros : windowMicros;
+}
+
+RedoLogBuffer* AdaptiveGroupSyncRedoLogHandler::WriteToLog(RedoLogBuffer* buffer)
+{
+    NodeCollector& collector = GetCollector();
+    Clock::time_point arrival = Clock::now();
+
+    std::unique_lock<std::mutex> lock(collector.m_lock);
+    collector.m_arrivalIntervalMicros = UpdateAverage(collector.m_arrivalIntervalMicros,
+        (double)std::chrono::duration_cast<std::chrono::microseconds>(arrival - collector.m_lastArrival).count());
+    collector.m_lastArrival = arrival;
+
+    // wait for the next batch if the open batch is full
+    collector.m_writtenCond.wait(lock, [this, &collector]() { return collector.m_batch.size() < m_maxBatchSize; });
+    uint64_t batchId = collector.m_openBatchId;
+    collector.m_batch.push_back(buffer);
+
+    if (collector.m_hasLeader) {
+        if (collector.m_batch.size() >= collector.m_targetSize) {
+            collector.m_leaderCond.notify_one();
+        }
+        collector.m_writtenCond.wait(lock, [&collector, batchId]() { return collector.m_writtenBatchId >= batchId; });
+        return buffer;
+    }
+
+    // first to join the batch, so we are the leader
+    collector.m_hasLeader = true;
+    Clock::time_point deadline = arrival + std::chrono::microseconds(ComputeWindow(collector));
+    while (true) {
+        bool previousWritten = (collector.m_writtenBatchId + 1 == batchId);
+        if (previousWritten && (collector.m_batch.size() >= collector.m_targetSize || Clock::now() >= deadline)) {
+            break;
+        }
+        if (previousWritten) {
+            (void)collector.m_leaderCond.wait_until(lock, deadline);
+        } else {
+            collector.m_leaderCond.wait(lock);
+        }
+    }
+
+    // close the batch, new arrivals start the next one
+    std::vector<RedoLogBuffer*> batch;
+    batch.swap(collector.m_batch);
+    collector.m_openBatchId++;
+    collector.m_hasLeader = false;
+    collector.m_writtenCond.notify_all();
+    lock.unlock();
+
+    Clock::time_point writeStart = Clock::now();
+    uint64_t waitMicros = (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(writeStart - arrival).count();
+    WriteBatch(collector, batch);
+    double writeMicros =
+        (double)std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - writeStart).count();
+    LogStatisticsProvider::GetInstance().AddGroupCommitBatch(batch.size(), waitMicros);
+
+    lock.lock();
+    collector.m_writeMicros = UpdateAverage(collector.m_writeMicros, writeMicros);
+    collector.m_writtenBatchId = batchId;
+    MOT_LOG_DEBUG("Batch %" PRIu64 " written: %u transactions, waited %" PRIu64 " micros, wrote in %0.1f micros",
+        batchId,
+        (unsigned)batch.size(),
+        waitMicros,
+        writeMicros);
+    collector.m_writtenCond.notify_all();
+    collector.m_leaderCond.notify_one();
+    return buffer;
+}
+
+void AdaptiveGroupSyncRedoLogHandler::WriteBatch(NodeCollector& collector, const std::vector<RedoLogBuffer*>& batch)
+{
+    if (batch.size() == 1) {
+        (void)m_logger->AddToLog(batch[0]);
+    } else {
+        // the recovery manager replays any number of transactions found in a single log record
+        std::vector<uint8_t>& writeBuffer = collector.m_writeBuffer;
+        writeBuffer.clear();
+        for (RedoLogBuffer* buffer : batch) {
+            uint32_t length = 0;
+            uint8_t* data = buffer->Serialize(&length);
+            (void)writeBuffer.insert(writeBuffer.end(), data, data + length);
+        }
+        (void)m_logger->AddToLog(writeBuffer.data(), (uint32_t)writeBuffer.size());
+    }
+    m_logger->FlushLog();
+}
+
+void AdaptiveGroupSyncRedoLogHandler::Flush()
+{
+    for (unsigned int i = 0; i < m_numaNodes; i++) {
+        NodeCollector& collector = m_collectors[i];
+        std::unique_lock<std::mutex> lock(collector.m_lock);
+        collector.m_writtenCond.wait(lock, [&collector]() {
+            return collector.m_batch.empty() && (collector.m_writtenBatchId + 1 == collector.m_openBatchId);
+        });
+    }
+}
+}  // namespace MOT
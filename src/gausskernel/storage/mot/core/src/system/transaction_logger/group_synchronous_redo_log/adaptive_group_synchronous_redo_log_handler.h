@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * adaptive_group_synchronous_redo_log_handler.h
+ *    Implements a per-numa group commit redo log with an adaptive flush window.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/src/system/transaction_logger/
+ *        group_synchronous_redo_log/adaptive_group_synchronous_redo_log_handler.h
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef ADAPTIVE_GROUP_SYNCHRONOUS_REDO_LOG_HANDLER_H
+#define ADAPTIVE_GROUP_SYNCHRONOUS_REDO_LOG_HANDLER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+#include "redo_log_handler.h"
+
+namespace MOT {
+/**
+ * @class AdaptiveGroupSyncRedoLogHandler
+ * @brief Implements a per-numa group commit redo log. Committing transactions of each NUMA node are collected into
+ * batches, and each batch is written by its leader (the first transaction to join it) as a single log record.
+ * Batches of a node are written in order, and a batch stays open while the previous batch is written, so under load
+ * batches grow naturally with the log write latency. In addition, the leader keeps the batch open for a window that
+ * is sized from the observed commit arrival rate and log write latency: when less than one commit is expected to
+ * arrive during a log write, the batch is written immediately. The configured group commit size and timeout serve as
+ * upper bounds for the batch size and the window.
+ */
+class AdaptiveGroupSyncRedoLogHandler : public RedoLogHandler {
+public:
+    AdaptiveGroupSyncRedoLogHandler();
+    AdaptiveGroupSyncRedoLogHandler(const AdaptiveGroupSyncRedoLogHandler& orig) = delete;
+    AdaptiveGroupSyncRedoLogHandler& operator=(const AdaptiveGroupSyncRedoLogHandler& orig) = delete;
+    virtual ~AdaptiveGroupSyncRedoLogHandler();
+
+    bool Init();
+
+    /**
+     * @brief creates a new Buffer object
+     * @return a Buffer
+     */
+    RedoLogBuffer* CreateBuffer();
+
+    /**
+     * @brief destroys a Buffer object
+     * @param buffer pointer to be destroyed and de-allocated
+     */
+    void DestroyBuffer(RedoLogBuffer* buffer);
+
+    /**
+     * @brief Joins the open batch of the current NUMA node, and waits until the batch is written.
+     * @param buffer The buffer to write to the log.
+     * @return The next buffer to write to, or null in case of failure.
+     */
+    virtual RedoLogBuffer* WriteToLog(RedoLogBuffer* buffer);
+
+    /**
+     * @brief Waits until all open batches are written.
+     */
+    virtual void Flush();
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    /**
+     * @struct NodeCollector
+     * @brief The batches of a single NUMA node.
+     */
+    struct NodeCollector {
+        std::mutex m_lock;
+
+        /** @var Signals the leader of the open batch that the batch is full or that the previous batch was written. */
+        std::condition_variable m_leaderCond;
+
+        /** @var Signals members that their batch was written, or that the open batch was closed. */
+        std::condition_variable m_writtenCond;
+
+        /** @var The buffers of the open batch. */
+        std::vector<RedoLogBuffer*> m_batch;
+
+        /** @var The identifier of the open batch. */
+        uint64_t m_openBatchId = 1;
+
+        /** @var The identifier of the last written batch. */
+        uint64_t m_writtenBatchId = 0;
+
+        bool m_hasLeader = false;
+
+        /** @var The number of transactions after which the leader stops waiting for the open batch to fill. */
+        uint64_t m_targetSize = 1;
+
+        /** @var Time of the last commit arrival. */
+        Clock::time_point m_lastArrival;
+
+        /** @var Moving average of the interval between commit arrivals in micro-seconds. */
+        double m_arrivalIntervalMicros = 0;
+
+        /** @var Moving average of the log write latency (insert and flush to disk) in micro-seconds. */
+        double m_writeMicros = 0;
+
+        /** @var Serialization buffer, used only by the leader currently writing. */
+        std::vector<uint8_t> m_writeBuffer;
+    };
+
+    /** @var The weight of a new sample in the moving averages. */
+    static constexpr double SAMPLE_WEIGHT = 0.125;
+
+    /** @var The maximum interval taken into account in the moving averages in micro-seconds. */
+    static constexpr double MAX_SAMPLE_MICROS = 1000000.0;
+
+    inline NodeCollector& GetCollector();
+
+    /**
+     * @brief Computes the window of a new batch, and its target size. Called by the batch leader.
+     * @param collector The node collector.
+     * @return The window in micro-seconds.
+     */
+    uint64_t ComputeWindow(NodeCollector& collector);
+
+    /**
+     * @brief Writes a closed batch as a single log record.
+     * @param collector The node collector.
+     * @param batch The buffers of the batch.
+     */
+    void WriteBatch(NodeCollector& collector, const std::vector<RedoLogBuffer*>& batch);
+
+    static inline double UpdateAverage(double average, double sample)
+    {
+        if (sample < 0) {
+            sample = 0;  // concurrent arrivals may take the lock out of order
+        } else if (sample > MAX_SAMPLE_MICROS) {
+            sample = MAX_SAMPLE_MICROS;
+        }
+        return average + (sample - average) * SAMPLE_WEIGHT;
+    }
+
+    /** @var Number of NUMA nodes. */
+    const unsigned int m_numaNodes;
+
+    NodeCollector* m_collectors;
+
+    /** @var The maximum number of transactions in a batch. */
+    uint64_t m_maxBatchSize;
+
+    /** @var The maximum window in micro-seconds. */
+    uint64_t m_maxWindowMicros;
+};
+}  // namespace MOT
+
+#endif /* ADAPTIVE_GROUP_SYNCHRONOUS_REDO_LOG_HANDLER_H */
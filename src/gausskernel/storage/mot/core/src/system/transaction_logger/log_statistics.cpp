@@ -39,10 +39,14 @@ LogThreadStatistics::LogThreadStatistics(uint64_t threadId, void* inplaceBuffer)
     : ThreadStatistics(threadId, inplaceBuffer),
       m_txnBuffersDrained(MakeName("txn-buffers-drained", threadId).c_str()),
       m_txnBytesDrained(MakeName("txn-bytes-drained", threadId).c_str()),
-      m_bytesWritten(MakeName("log-bytes-written", threadId).c_str())
+      m_bytesWritten(MakeName("log-bytes-written", threadId).c_str()),
+      m_groupCommitBatchSize(MakeName("group-commit-batch-size", threadId).c_str(), "txns"),
+      m_groupCommitWaitTime(MakeName("group-commit-wait-time", threadId).c_str(), "usec")
 {
     RegisterStatistics(&m_txnBuffersDrained);
     RegisterStatistics(&m_txnBytesDrained);
+    RegisterStatistics(&m_groupCommitBatchSize);
+    RegisterStatistics(&m_groupCommitWaitTime);
 }
 
 LogGlobalStatistics::LogGlobalStatistics(GlobalStatistics::NamingScheme namingScheme)
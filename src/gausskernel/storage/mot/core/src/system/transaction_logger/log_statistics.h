@@ -26,6 +26,7 @@
 #define LOG_STATISTICS_H
 
 #include "frequency_statistic_variable.h"
+#include "histogram_statistic_variable.h"
 #include "rate_statistic_variable.h"
 #include "iconfig_change_listener.h"
 #include "numeric_statistic_variable.h"
@@ -56,10 +57,22 @@ public:
         m_bytesWritten.AddSample(bytes);
     }
 
+    inline void AddGroupCommitBatchSize(uint64_t txnCount)
+    {
+        m_groupCommitBatchSize.AddSample(txnCount);
+    }
+
+    inline void AddGroupCommitWaitTime(uint64_t micros)
+    {
+        m_groupCommitWaitTime.AddSample(micros);
+    }
+
 private:
     FrequencyStatisticVariable m_txnBuffersDrained;
     DataRateStatisticVariable m_txnBytesDrained;
     DataRateStatisticVariable m_bytesWritten;
+    HistogramStatisticVariable m_groupCommitBatchSize;
+    HistogramStatisticVariable m_groupCommitWaitTime;
 };
 
 class LogGlobalStatistics : public GlobalStatistics {
@@ -121,6 +134,20 @@ public:
         }
     }
 
+    /**
+     * @brief Reports a group commit batch written by the current thread.
+     * @param txnCount The number of transactions in the batch.
+     * @param waitMicros The time the batch leader waited for the batch to fill.
+     */
+    inline void AddGroupCommitBatch(uint64_t txnCount, uint64_t waitMicros)
+    {
+        LogThreadStatistics* lts = GetCurrentThreadStatistics<LogThreadStatistics>();
+        if (lts != nullptr) {
+            lts->AddGroupCommitBatchSize(txnCount);
+            lts->AddGroupCommitWaitTime(waitMicros);
+        }
+    }
+
     inline void AddLogFlush()
     {
         LogGlobalStatistics* lts = GetGlobalStatistics<LogGlobalStatistics>();
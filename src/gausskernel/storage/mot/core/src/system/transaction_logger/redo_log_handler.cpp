@@ -31,6 +31,7 @@
 #include "logger_type.h"
 #include "synchronous_redo_log_handler.h"
 #include "segmented_group_synchronous_redo_log_handler.h"
+#include "adaptive_group_synchronous_redo_log_handler.h"
 #include "mot_error.h"
 
 namespace MOT {
@@ -57,6 +58,9 @@ RedoLogHandler* RedoLogHandlerFactory::CreateRedoLogHandler()
         case RedoLogHandlerType::SEGMENTED_GROUP_SYNC_REDO_LOG_HANDLER:
             handler = new (std::nothrow) SegmentedGroupSyncRedoLogHandler();
             break;
+        case RedoLogHandlerType::ADAPTIVE_GROUP_SYNC_REDO_LOG_HANDLER:
+            handler = new (std::nothrow) AdaptiveGroupSyncRedoLogHandler();
+            break;
         default:
             MOT_REPORT_PANIC(MOT_ERROR_INTERNAL,
                 "Redo Log Handler Initialization",
@@ -33,11 +33,13 @@ DECLARE_LOGGER(RedoLogHandlerType, RedoLog)
 static const char* NONE_STR = "none";
 static const char* SYNC_REDO_LOG_HANDLER_STR = "synchronous";
 static const char* SEGMENTED_GROUP_SYNC_REDO_LOG_HANDLER_STR = "segmented_group_synchronous";
+static const char* ADAPTIVE_GROUP_SYNC_REDO_LOG_HANDLER_STR = "adaptive_group_synchronous";
 static const char* INVALID_REDO_LOG_HANDLER_STR = "INVALID";
 
 static const char* redoLogHandlerTypeNames[] = {NONE_STR,
     SYNC_REDO_LOG_HANDLER_STR,
-    SEGMENTED_GROUP_SYNC_REDO_LOG_HANDLER_STR};
+    SEGMENTED_GROUP_SYNC_REDO_LOG_HANDLER_STR,
+    ADAPTIVE_GROUP_SYNC_REDO_LOG_HANDLER_STR};
 
 RedoLogHandlerType RedoLogHandlerTypeFromString(const char* redoLogHandlerType)
 {
@@ -49,6 +51,8 @@ RedoLogHandlerType RedoLogHandlerTypeFromString(const char* redoLogHandlerType)
         handlerType = RedoLogHandlerType::SYNC_REDO_LOG_HANDLER;
     } else if (strcmp(redoLogHandlerType, SEGMENTED_GROUP_SYNC_REDO_LOG_HANDLER_STR) == 0) {
         handlerType = RedoLogHandlerType::SEGMENTED_GROUP_SYNC_REDO_LOG_HANDLER;
+    } else if (strcmp(redoLogHandlerType, ADAPTIVE_GROUP_SYNC_REDO_LOG_HANDLER_STR) == 0) {
+        handlerType = RedoLogHandlerType::ADAPTIVE_GROUP_SYNC_REDO_LOG_HANDLER;
     } else {
         MOT_LOG_ERROR("Invalid redo log handler type: %s", redoLogHandlerType);
     }
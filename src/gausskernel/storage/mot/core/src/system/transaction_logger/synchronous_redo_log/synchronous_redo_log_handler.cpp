@@ -56,8 +56,8 @@ void SynchronousRedoLogHandler::DestroyBuffer(RedoLogBuffer* buffer)
 
 RedoLogBuffer* SynchronousRedoLogHandler::WriteToLog(RedoLogBuffer* buffer)
 {
+    // the record is flushed together with the commit record of the transaction that wrote it
     m_logger->AddToLog(buffer);
-    m_logger->FlushLog();
     return buffer;
 }
 
@@ -25,6 +25,7 @@
 #ifndef GAUSSDB_CONFIG_LOADER_H
 #define GAUSSDB_CONFIG_LOADER_H
 
+#include <algorithm>
 #include "ext_config_loader.h"
 #include "mot_internal.h"
 
@@ -77,7 +78,9 @@ private:
     {
         // NOTE: parallel redo recovery also requires thread ids when invoking MOT engine (in case it is configured)
         MOT::MOTConfiguration& motCfg = MOT::GetGlobalConfiguration();
-        startupThreadCount = motCfg.m_checkpointRecoveryWorkers + motCfg.m_chunkPreallocWorkerCount;
+        // checkpoint recovery workers terminate before the parallel redo workers start, so their ids are reused
+        startupThreadCount = std::max(motCfg.m_checkpointRecoveryWorkers, motCfg.m_parallelRedoWorkers) +
+                             motCfg.m_chunkPreallocWorkerCount;
         runtimeThreadCount = motCfg.m_checkpointWorkers + 1;  // add one for statistics reporting thread
 
         // get the number of threads used to manage user sessions
@@ -148,6 +151,11 @@ private:
             MOT_LOG_INFO("Configuring asynchronous redo-log handler due to synchronous_commit=off");
             result = AddExtTypedConfigItem<MOT::RedoLogHandlerType>(
                 "", "redo_log_handler_type", MOT::RedoLogHandlerType::SYNC_REDO_LOG_HANDLER);
+        } else if (MOT::GetGlobalConfiguration().m_enableGroupCommit &&
+                   MOT::GetGlobalConfiguration().m_enableAdaptiveGroupCommit) {
+            MOT_LOG_INFO("Configuring adaptive-group redo-log handler");
+            result = AddExtTypedConfigItem<MOT::RedoLogHandlerType>(
+                "", "redo_log_handler_type", MOT::RedoLogHandlerType::ADAPTIVE_GROUP_SYNC_REDO_LOG_HANDLER);
         } else if (MOT::GetGlobalConfiguration().m_enableGroupCommit) {
             MOT_LOG_INFO("Configuring segmented-group redo-log handler");
             result = AddExtTypedConfigItem<MOT::RedoLogHandlerType>(
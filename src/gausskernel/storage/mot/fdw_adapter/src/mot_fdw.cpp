@@ -70,6 +70,7 @@
 #include "postmaster/bgwriter.h"
 #include "storage/lmgr.h"
 #include "storage/ipc.h"
+#include "vecexecutor/vecnodes.h"
 
 #include "mot_internal.h"
 #include "storage/mot/jit_exec.h"
@@ -77,7 +78,9 @@
 #include "table.h"
 #include "txn.h"
 #include "checkpoint_manager.h"
+#include "checkpoint_utils.h"
 #include <queue>
+#include <vector>
 #include "recovery_manager.h"
 #include "redo_log_handler_type.h"
 #include "ext_config_loader.h"
@@ -107,6 +110,7 @@ static const struct MOTFdwOption valid_options[] = {
 
     {"null", ForeignTableRelationId},
     {"encoding", ForeignTableRelationId},
+    {"numa_node", ForeignTableRelationId},
     {"force_not_null", AttributeRelationId},
 
     /* Sentinel */
@@ -131,6 +135,7 @@ static ForeignScan* MOTGetForeignPlan(PlannerInfo* root, RelOptInfo* baserel, Oi
 static void MOTExplainForeignScan(ForeignScanState* node, ExplainState* es);
 static void MOTBeginForeignScan(ForeignScanState* node, int eflags);
 static TupleTableSlot* MOTIterateForeignScan(ForeignScanState* node);
+static VectorBatch* MOTVecIterateForeignScan(VecForeignScanState* node);
 static void MOTReScanForeignScan(ForeignScanState* node);
 static void MOTEndForeignScan(ForeignScanState* node);
 static void MOTAddForeignUpdateTargets(Query* parsetree, RangeTblEntry* targetRte, Relation targetRelation);
@@ -180,6 +185,7 @@ void CleanQueryStatesOnError(MOT::TxnManager* txn);
 bool IsMOTExpr(
     RelOptInfo* baserel, MOTFdwStateSt* state, MatchIndexArr* marr, Expr* expr, Expr** result, bool setLocal);
 inline bool IsNotEqualOper(OpExpr* op);
+inline bool IsPointQuery(const MOTFdwStateSt* festate);
 
 static int MOTGetFdwType()
 {
@@ -296,6 +302,7 @@ Datum mot_fdw_handler(PG_FUNCTION_ARGS)
     fdwroutine->ExplainForeignScan = MOTExplainForeignScan;
     fdwroutine->BeginForeignScan = MOTBeginForeignScan;
     fdwroutine->IterateForeignScan = MOTIterateForeignScan;
+    fdwroutine->VecIterateForeignScan = MOTVecIterateForeignScan;
     fdwroutine->ReScanForeignScan = MOTReScanForeignScan;
     fdwroutine->EndForeignScan = MOTEndForeignScan;
     fdwroutine->AnalyzeForeignTable = MOTAnalyzeForeignTable;
@@ -492,6 +499,10 @@ static bool IsOrderingApplicable(PathKey* pathKey, RelOptInfo* rel, MOT::Index*
     else if (ord->m_order != SORT_STRATEGY(pathKey->pk_strategy))
         return res;
 
+    // entries of a hash index have no order
+    if (ix->GetIndexingMethod() == MOT::IndexingMethod::INDEXING_METHOD_HASH)
+        return res;
+
     do {
         const int16_t* cols = ix->GetColumnKeyFields();
         int16_t numKeyCols = ix->GetNumFields();
@@ -784,8 +795,15 @@ static ForeignScan* MOTGetForeignPlan(
     if (tmpLocal != nullptr)
         list_free(tmpLocal);
 
+    // range and full scans of read-only queries may be executed by the vectorized executor, the planner decides
+    // whether to actually vectorize the plan (point queries are left to the row executor and JIT); scans expected
+    // to return less than a full batch gain nothing from batching and stay with the row executor
+    bool vecOutput = u_sess->attr.attr_sql.enable_vectorized_scan && root->parse->commandType == CMD_SELECT &&
+                     !planstate->m_hasForUpdate && root->parse->rowMarks == NIL && !IsPointQuery(planstate) &&
+                     baserel->rows >= BatchMaxSize;
+
     List* quals = planstate->m_localConds;
-    return make_foreignscan(tlist,
+    ForeignScan* scan = make_foreignscan(tlist,
         quals,
         scanRelid,
         remote, /* no expressions to evaluate */
@@ -797,6 +815,8 @@ static ForeignScan* MOTGetForeignPlan(
         nullptr
 #endif
     );
+    ((Plan*)scan)->vec_output = vecOutput;
+    return scan;
 }
 
 /*
@@ -855,6 +875,138 @@ static void MOTExplainForeignScan(ForeignScanState* node, ExplainState* es)
     }
 }
 
+/*
+ * Collects the "column op constant" quals of a vectorized scan over by-value columns, so rows can be filtered
+ * before they are copied into a batch. The executor still evaluates all the quals on the returned batches.
+ */
+static void BuildScanFilters(ForeignScanState* node, MOTFdwStateSt* festate)
+{
+    List* quals = node->ss.ps.plan->qual;
+    ::Index scanRelid = ((Scan*)node->ss.ps.plan)->scanrelid;
+    TupleDesc desc = RelationGetDescr(node->ss.ss_currentRelation);
+    ListCell* lc = nullptr;
+
+    if (quals == NIL) {
+        return;
+    }
+
+    festate->m_scanFilters = (MOTScanFilterSt*)palloc0(sizeof(MOTScanFilterSt) * list_length(quals));
+    foreach (lc, quals) {
+        OpExpr* op = (OpExpr*)lfirst(lc);
+        if (!IsA(op, OpExpr) || list_length(op->args) != 2 || op->opretset) {
+            continue;
+        }
+
+        Expr* left = (Expr*)linitial(op->args);
+        Expr* right = (Expr*)lsecond(op->args);
+        while (IsA(left, RelabelType)) {
+            left = ((RelabelType*)left)->arg;
+        }
+        while (IsA(right, RelabelType)) {
+            right = ((RelabelType*)right)->arg;
+        }
+
+        bool varOnLeft = IsA(left, Var) && IsA(right, Const);
+        if (!varOnLeft && !(IsA(left, Const) && IsA(right, Var))) {
+            continue;
+        }
+        Var* var = (Var*)(varOnLeft ? left : right);
+        Const* cst = (Const*)(varOnLeft ? right : left);
+        if (var->varno != scanRelid || var->varlevelsup != 0 || var->varattno <= 0 || var->varattno > desc->natts ||
+            cst->constisnull || !desc->attrs[var->varattno - 1]->attbyval ||
+            !BITMAP_GET(festate->m_attrsUsed, var->varattno - 1)) {
+            continue;
+        }
+
+        set_opfuncid(op);
+        if (!func_strict(op->opfuncid)) {
+            continue;
+        }
+
+        MOTScanFilterSt* filter = &festate->m_scanFilters[festate->m_numScanFilters++];
+        filter->m_attNum = var->varattno;
+        filter->m_varOnLeft = varOnLeft;
+        filter->m_collation = op->inputcollid;
+        filter->m_const = cst->constvalue;
+        fmgr_info(op->opfuncid, &filter->m_func);
+    }
+}
+
+static bool PassScanFilters(MOTFdwStateSt* festate, TupleDesc desc, uint8_t* data)
+{
+    for (uint16_t i = 0; i < festate->m_numScanFilters; i++) {
+        MOTScanFilterSt* filter = &festate->m_scanFilters[i];
+        Datum value = PointerGetDatum(nullptr);
+        bool isNull = true;
+
+        MOTAdaptor::MOTToDatum(festate->m_table, desc->attrs[filter->m_attNum - 1], data, &value, &isNull);
+        if (isNull) {
+            // all the filter functions are strict
+            return false;
+        }
+
+        Datum result = filter->m_varOnLeft
+                           ? FunctionCall2Coll(&filter->m_func, filter->m_collation, value, filter->m_const)
+                           : FunctionCall2Coll(&filter->m_func, filter->m_collation, filter->m_const, value);
+        if (!DatumGetBool(result)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void FillBatchRow(VectorBatch* batch, MOTFdwStateSt* festate, TupleDesc desc, uint8_t* data)
+{
+    int row = batch->m_rows;
+
+    for (int i = 0; i < batch->m_cols; i++) {
+        ScalarVector* vec = &(batch->m_arr[i]);
+        Datum value = PointerGetDatum(nullptr);
+        bool isNull = true;
+
+        if (BITMAP_GET(festate->m_attrsUsed, i)) {
+            MOTAdaptor::MOTToDatum(festate->m_table, desc->attrs[i], data, &value, &isNull);
+        }
+
+        if (isNull) {
+            vec->SetNull(row);
+        } else if (vec->m_desc.encoded) {
+            // the vectorized executor computes faster on numeric values represented as big integers
+            if (desc->attrs[i]->atttypid == NUMERICOID) {
+                value = try_convert_numeric_normal_to_fast(value);
+            }
+            vec->AddVar(value, row);
+        } else {
+            vec->m_vals[row] = value;
+        }
+        vec->m_rows++;
+    }
+    batch->m_rows++;
+}
+
+static void OpenScanCursor(ForeignScanState* node, MOTFdwStateSt* festate)
+{
+    if (!festate->m_cursorOpened) {
+        ForeignScan* fscan = (ForeignScan*)node->ss.ps.plan;
+        festate->m_execExprs = (List*)ExecInitExpr((Expr*)fscan->fdw_exprs, (PlanState*)node);
+        festate->m_econtext = node->ss.ps.ps_ExprContext;
+        CleanCursors(festate);
+        MOTAdaptor::OpenCursor(node->ss.ss_currentRelation, festate);
+
+        festate->m_cursorOpened = true;
+    }
+}
+
+/*
+ * Let the thread pool serve the session from the NUMA node on which the rows of the table are placed.
+ */
+static inline void SetSessionNumaAffinity(MOT::Table* table)
+{
+    if (table != nullptr && table->GetPlacementNode() >= 0) {
+        u_sess->numa_affinity = table->GetPlacementNode();
+    }
+}
+
 /*
  *
  */
@@ -872,6 +1024,7 @@ static void MOTBeginForeignScan(ForeignScanState* node, int eflags)
     festate->m_currTxn->IncStmtCount();
     festate->m_currTxn->m_queryState[(uint64_t)festate] = (uint64_t)festate;
     festate->m_table = festate->m_currTxn->GetTableByExternalId(RelationGetRelid(node->ss.ss_currentRelation));
+    SetSessionNumaAffinity(festate->m_table);
     node->fdw_state = festate;
     if (node->ss.ps.state->es_result_relation_info &&
         RelationGetRelid(node->ss.ps.state->es_result_relation_info->ri_RelationDesc) ==
@@ -887,6 +1040,10 @@ static void MOTBeginForeignScan(ForeignScanState* node, int eflags)
             break;
         }
     }
+
+    if (IsA(node->ss.ps.plan, VecForeignScan)) {
+        BuildScanFilters(node, festate);
+    }
 }
 
 static void MOTBeginForeignModify(
@@ -902,6 +1059,7 @@ static void MOTBeginForeignModify(
         festate->m_currTxn = GetSafeTxn(__FUNCTION__);
         festate->m_currTxn->m_queryState[(uint64_t)festate] = (uint64_t)festate;
         festate->m_table = festate->m_currTxn->GetTableByExternalId(RelationGetRelid(resultRelInfo->ri_RelationDesc));
+        SetSessionNumaAffinity(festate->m_table);
         resultRelInfo->ri_FdwState = festate;
     } else {
         festate = (MOTFdwStateSt*)resultRelInfo->ri_FdwState;
@@ -1001,24 +1159,14 @@ static TupleTableSlot* MOTIterateForeignScan(ForeignScanState* node)
     MOTFdwStateSt* festate = (MOTFdwStateSt*)node->fdw_state;
     TupleTableSlot* slot = node->ss.ss_ScanTupleSlot;
     bool found = false;
-    bool stopAtFirst = (festate->m_bestIx && festate->m_bestIx->m_ixOpers[0] == KEY_OPER::READ_KEY_EXACT &&
-                        festate->m_bestIx->m_ix->GetUnique() == true);
 
     (void)ExecClearTuple(slot);
 
-    if (stopAtFirst) {
+    if (IsPointQuery(festate)) {
         return IterateForeignScanStopAtFirst(node, festate, slot);
     }
 
-    if (!festate->m_cursorOpened) {
-        ForeignScan* fscan = (ForeignScan*)node->ss.ps.plan;
-        festate->m_execExprs = (List*)ExecInitExpr((Expr*)fscan->fdw_exprs, (PlanState*)node);
-        festate->m_econtext = node->ss.ps.ps_ExprContext;
-        CleanCursors(festate);
-        MOTAdaptor::OpenCursor(node->ss.ss_currentRelation, festate);
-
-        festate->m_cursorOpened = true;
-    }
+    OpenScanCursor(node, festate);
     /*
      * The protocol for loading a virtual tuple into a slot is first
      * ExecClearTuple, then fill the values/isnull arrays, then
@@ -1091,6 +1239,76 @@ static TupleTableSlot* MOTIterateForeignScan(ForeignScanState* node)
     }
 }
 
+/*
+ * Fills the next batch of a vectorized scan directly from the index cursor. Each row version is checked for
+ * visibility like in the row-at-a-time scan, and the simple column quals are applied before the row is copied.
+ * An empty batch denotes the end of the scan.
+ */
+static VectorBatch* MOTVecIterateForeignScan(VecForeignScanState* node)
+{
+    MOT::RC rc = MOT::RC_OK;
+    MOTFdwStateSt* festate = (MOTFdwStateSt*)node->fdw_state;
+    VectorBatch* batch = node->m_pScanBatch;
+    TupleDesc desc = RelationGetDescr(node->ss.ss_currentRelation);
+
+    batch->Reset(true);
+    if (node->ss.is_scan_end) {
+        return batch;
+    }
+
+    OpenScanCursor(node, festate);
+    // festate->cursor[1] might be NULL (in case it is not in use)
+    if (festate->m_cursor[0] == nullptr || !festate->m_cursor[0]->IsValid() ||
+        (festate->m_cursor[1] != nullptr && !festate->m_cursor[1]->IsValid())) {
+        node->ss.is_scan_end = true;
+        return batch;
+    }
+
+    MemoryContextReset(node->m_scanCxt);
+    MemoryContext oldContext = MemoryContextSwitchTo(node->m_scanCxt);
+    while (batch->m_rows < BatchMaxSize && festate->m_cursor[0]->IsValid()) {
+        MOT::Sentinel* sentinel = festate->m_cursor[0]->GetPrimarySentinel();
+        MOT::Row* currRow = festate->m_currTxn->RowLookup(festate->m_internalCmdOper, sentinel, rc);
+        if (currRow == nullptr) {
+            if (rc != MOT::RC_OK) {
+                (void)MemoryContextSwitchTo(oldContext);
+                if (MOT_IS_SEVERE()) {
+                    MOT_REPORT_ERROR(MOT_ERROR_INTERNAL, "MOTVecIterateForeignScan", "Failed to lookup row");
+                    MOT_LOG_ERROR_STACK("Failed to lookup row");
+                }
+
+                CleanQueryStatesOnError(festate->m_currTxn);
+                report_pg_error(rc,
+                    (void*)(festate->m_currTxn->m_errIx != nullptr ? festate->m_currTxn->m_errIx->GetName().c_str()
+                                                                   : "unknown"),
+                    (void*)festate->m_currTxn->m_errMsgBuf);
+                return nullptr;
+            }
+            festate->m_cursor[0]->Next();
+            continue;
+        }
+
+        // check end condition for range search
+        if (MOTAdaptor::IsScanEnd(festate)) {
+            festate->m_cursor[0]->Invalidate();
+            break;
+        }
+
+        uint8_t* data = const_cast<uint8_t*>(currRow->GetData());
+        festate->m_cursor[0]->Next();
+        if (PassScanFilters(festate, desc, data)) {
+            FillBatchRow(batch, festate, desc, data);
+            festate->m_rowsFound++;
+        }
+    }
+    (void)MemoryContextSwitchTo(oldContext);
+
+    if (!festate->m_cursor[0]->IsValid()) {
+        node->ss.is_scan_end = true;
+    }
+    return batch;
+}
+
 /*
  *
  */
@@ -1098,13 +1316,10 @@ static void MOTReScanForeignScan(ForeignScanState* node)
 {
     MOTFdwStateSt* festate = (MOTFdwStateSt*)node->fdw_state;
 
-    bool stopAtFirst = (festate->m_bestIx && festate->m_bestIx->m_ixOpers[0] == KEY_OPER::READ_KEY_EXACT &&
-                        festate->m_bestIx->m_ix->GetUnique() == true);
-
     node->ss.is_scan_end = false;
 
     CleanCursors(festate);
-    if (!stopAtFirst) {
+    if (!IsPointQuery(festate)) {
         if (festate->m_execExprs == NULL) {
             ForeignScan* fscan = (ForeignScan*)node->ss.ps.plan;
             festate->m_execExprs = (List*)ExecInitExpr((Expr*)fscan->fdw_exprs, (PlanState*)node);
@@ -1573,6 +1788,7 @@ static void MOTXactCallback(XactEvent event, void* arg)
             MOTAdaptor::Rollback();
         }
         if (txnState != MOT::TxnState::TXN_PREPARE) {
+            txn->SetHotRowLocking(u_sess->attr.attr_storage.enable_hot_row_locking);
             txn->StartTransaction(tid, u_sess->utils_cxt.XactIsoLevel);
         }
     } else if (event == XACT_EVENT_COMMIT) {
@@ -1977,6 +2193,89 @@ bool MOTCheckpointExists(
     return true;
 }
 
+bool MOTGetCheckpointBaseDir(uint32_t index, char* checkpointDir, size_t checkpointLen)
+{
+    MOT::MOTEngine* engine = MOT::MOTEngine::GetInstance();
+    if (engine == nullptr) {
+        return false;
+    }
+
+    MOT::CheckpointManager* checkpointManager = engine->GetCheckpointManager();
+    if (checkpointManager == nullptr || checkpointManager->GetId() == MOT::CheckpointControlFile::invalidId) {
+        return false;
+    }
+
+    // the first element of the chain is the current checkpoint, which is fetched by itself
+    std::vector<uint64_t> chain;
+    if (!MOT::CheckpointManager::GetCheckpointChain(checkpointManager->GetId(), chain)) {
+        ereport(ERROR,
+            (errcode(ERRCODE_INTERNAL_ERROR), errmodule(MOD_MOT), errmsg("Failed to obtain MOT checkpoint chain")));
+        return false;
+    }
+
+    if ((size_t)index + 1 >= chain.size()) {
+        return false;
+    }
+
+    std::string workingDir;
+    if (checkpointManager->GetCheckpointWorkingDir(workingDir) == false) {
+        ereport(ERROR, (errcode(ERRCODE_INTERNAL_ERROR), errmodule(MOD_MOT), errmsg("Failed to obtain working dir")));
+        return false;
+    }
+
+    std::string dirName;
+    (void)MOT::CheckpointUtils::SetDirName(dirName, chain[index + 1]);
+    errno_t rc =
+        snprintf_s(checkpointDir, checkpointLen, checkpointLen - 1, "%s%s", workingDir.c_str(), dirName.c_str());
+    securec_check_ss(rc, "", "");
+    return true;
+}
+
+MotTableContentionDetail* MOTGetTableContentionDetail(uint32_t* tableCount)
+{
+    *tableCount = 0;
+    MOT::MOTEngine* engine = MOT::MOTEngine::GetInstance();
+    if (engine == nullptr) {
+        return nullptr;
+    }
+
+    // collect the statistics while the tables are locked, and allocate the result only after they are unlocked
+    struct TableStats {
+        uint64_t m_exId;
+        std::string m_name;
+        MOT::Table::ContentionStats m_stats;
+    };
+    std::vector<TableStats> collected;
+    std::list<MOT::Table*> tables;
+    (void)MOT::GetTableManager()->AddTablesToList(tables);
+    collected.reserve(tables.size());
+    for (MOT::Table* table : tables) {
+        TableStats entry;
+        entry.m_exId = table->GetTableExId();
+        entry.m_name = table->GetTableName();
+        table->GetContentionStats(entry.m_stats);
+        collected.push_back(entry);
+        table->Unlock();
+    }
+
+    if (collected.empty()) {
+        return nullptr;
+    }
+
+    MotTableContentionDetail* result =
+        (MotTableContentionDetail*)palloc(collected.size() * sizeof(MotTableContentionDetail));
+    for (size_t i = 0; i < collected.size(); ++i) {
+        result[i].relid = (Oid)collected[i].m_exId;
+        result[i].relname = pstrdup(collected[i].m_name.c_str());
+        result[i].conflicts = (int64)collected[i].m_stats.m_conflicts;
+        result[i].hotRows = (int64)collected[i].m_stats.m_hotRows;
+        result[i].hotRowLocks = (int64)collected[i].m_stats.m_hotRowLocks;
+        result[i].hotRowLockTimeouts = (int64)collected[i].m_stats.m_hotRowLockTimeouts;
+    }
+    *tableCount = (uint32_t)collected.size();
+    return result;
+}
+
 inline bool IsNotEqualOper(OpExpr* op)
 {
     switch (op->opno) {
@@ -2044,6 +2343,12 @@ inline bool IsNotEqualOper(OpExpr* op)
     }
 }
 
+inline bool IsPointQuery(const MOTFdwStateSt* festate)
+{
+    return (festate->m_bestIx && festate->m_bestIx->m_ixOpers[0] == KEY_OPER::READ_KEY_EXACT &&
+            festate->m_bestIx->m_ix->GetUnique() == true);
+}
+
 inline void RevertKeyOperation(KEY_OPER& oper)
 {
     if (oper == KEY_OPER::READ_KEY_BEFORE) {
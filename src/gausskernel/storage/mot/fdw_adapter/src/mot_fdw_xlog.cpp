@@ -29,6 +29,8 @@
 #include "global.h"
 #include "postgres.h"
 #include "access/xlog.h"
+#include "access/redo_statistic.h"
+#include "storage/mot/mot_xlog.h"
 #include "mot_fdw_xlog.h"
 #include "mot_engine.h"
 #include "recovery_manager.h"
@@ -76,6 +78,26 @@ void MOTRedo(XLogReaderState* record)
     }
 }
 
+void MOTGetRedoWorkerStatistic(uint32* realNum, RedoWorkerStatsData* worker, uint32 workerLen)
+{
+    *realNum = 0;
+    MOT::MOTEngine* engine = MOT::MOTEngine::GetInstance();
+    if (engine == nullptr || engine->GetRecoveryManager() == nullptr || workerLen == 0) {
+        return;
+    }
+
+    MOT::RedoWorkerStats* stats = (MOT::RedoWorkerStats*)palloc(sizeof(MOT::RedoWorkerStats) * workerLen);
+    uint32 count = engine->GetRecoveryManager()->GetRedoWorkerStats(stats, workerLen);
+    for (uint32 i = 0; i < count; i++) {
+        worker[i].id = stats[i].m_workerId;
+        worker[i].queue_usage = stats[i].m_queueUsage;
+        worker[i].queue_max_usage = stats[i].m_queueMaxUsage;
+        worker[i].redo_rec_count = stats[i].m_appliedOperations;
+    }
+    pfree(stats);
+    *realNum = count;
+}
+
 uint64_t XLOGLogger::AddToLog(MOT::RedoLogBuffer** redoLogBufferArray, uint32_t size)
 {
     return MOT::ILogger::AddToLog(redoLogBufferArray, size);
@@ -92,7 +114,15 @@ uint64_t XLOGLogger::AddToLog(uint8_t* data, uint32_t size)
 }
 
 void XLOGLogger::FlushLog()
-{}
+{
+    /*
+     * Wait until the records inserted by this thread reach disk. A group commit leader inserts the records of all
+     * the members of its batch, so it waits for them on their behalf.
+     */
+    if (!XLogRecPtrIsInvalid(t_thrd.xlog_cxt.XactLastRecEnd)) {
+        XLogWaitFlush(t_thrd.xlog_cxt.XactLastRecEnd);
+    }
+}
 
 void XLOGLogger::CloseLog()
 {}
@@ -40,6 +40,7 @@
 #include "executor/executor.h"
 #include "storage/ipc.h"
 #include "commands/dbcommands.h"
+#include "commands/defrem.h"
 #include "knl/knl_session.h"
 
 #include "mot_internal.h"
@@ -804,6 +805,13 @@ void MOTAdaptor::OpenCursor(Relation rel, MOTFdwStateSt* festate)
             MOT::Index* ix = festate->m_table->GetPrimaryIndex();
             uint16_t keyLength = ix->GetKeyLength();
 
+            // a hash primary index has no order, so the full scan just walks all of its entries
+            if (ix->GetIndexingMethod() == MOT::IndexingMethod::INDEXING_METHOD_HASH) {
+                festate->m_forwardDirectionScan = true;
+                festate->m_cursor[0] = festate->m_table->Begin(festate->m_currTxn->GetThdId());
+                break;
+            }
+
             if (festate->m_order == SORTDIR_ENUM::SORTDIR_ASC) {
                 fIx = 0;
                 bIx = 1;
@@ -825,6 +833,15 @@ void MOTAdaptor::OpenCursor(Relation rel, MOTFdwStateSt* festate)
             break;
         }
 
+        // a hash index iterator stops by itself after the last entry of the key, so no end cursor is needed
+        if (festate->m_bestIx->m_ix->GetIndexingMethod() == MOT::IndexingMethod::INDEXING_METHOD_HASH) {
+            CreateKeyBuffer(rel, festate, 0);
+            festate->m_forwardDirectionScan = true;
+            festate->m_cursor[0] = festate->m_bestIx->m_ix->Search(
+                &festate->m_stateKey[0], true, true, festate->m_currTxn->GetThdId(), found);
+            break;
+        }
+
         for (int i = 0; i < 2; i++) {
             if (i == 1 && festate->m_bestIx->m_end < 0) {
                 if (festate->m_forwardDirectionScan) {
@@ -1048,8 +1065,8 @@ void MOTAdaptor::ValidateCreateIndex(IndexStmt* stmt, MOT::Table* table, MOT::Tx
         return;
     }
 
-    if (strcmp(stmt->accessMethod, "btree") != 0) {
-        ereport(ERROR, (errmodule(MOD_MOT), errmsg("MOT supports indexes of type BTREE only (btree or btree_art)")));
+    if (strcmp(stmt->accessMethod, "btree") != 0 && strcmp(stmt->accessMethod, "hash") != 0) {
+        ereport(ERROR, (errmodule(MOD_MOT), errmsg("MOT supports indexes of type BTREE or HASH only")));
         return;
     }
 
@@ -1096,6 +1113,10 @@ MOT::RC MOTAdaptor::CreateIndex(IndexStmt* stmt, ::TransactionId tid)
     MOT::IndexingMethod indexing_method = MOT::IndexingMethod::INDEXING_METHOD_TREE;
     MOT::IndexTreeFlavor flavor = MOT::GetGlobalConfiguration().m_indexTreeFlavor;
 
+    if (strcmp(stmt->accessMethod, "hash") == 0) {
+        indexing_method = MOT::IndexingMethod::INDEXING_METHOD_HASH;
+    }
+
     // check if we have primary and delete previous definition
     if (stmt->primary) {
         index_order = MOT::IndexOrder::INDEX_ORDER_PRIMARY;
@@ -1276,6 +1297,38 @@ void MOTAdaptor::AddTableColumns(MOT::Table* table, List *tableElts, bool& hasBl
     }
 }
 
+/*
+ * Retrieves the NUMA node given in the numa_node table option, MOT::Table::HASH_PLACEMENT for 'hash', or -1 if the
+ * option is not specified.
+ */
+static int GetTablePlacementNode(List* options)
+{
+    int node = -1;
+    ListCell* cell = nullptr;
+    foreach (cell, options) {
+        DefElem* def = (DefElem*)lfirst(cell);
+        if (strcmp(def->defname, "numa_node") == 0) {
+            char* value = defGetString(def);
+            if (pg_strcasecmp(value, "hash") == 0) {
+                node = MOT::Table::HASH_PLACEMENT;
+                continue;
+            }
+            char* end = nullptr;
+            long result = strtol(value, &end, 10);
+            uint32_t nodeCount = MOT::GetGlobalConfiguration().m_numaNodes;
+            if (end == value || *end != '\0' || result < 0 || result >= (long)nodeCount) {
+                ereport(ERROR,
+                    (errmodule(MOD_MOT),
+                        errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+                        errmsg("invalid value for option \"numa_node\": \"%s\"", value),
+                        errdetail("Valid values are 0 to %u, or hash", nodeCount - 1)));
+            }
+            node = (int)result;
+        }
+    }
+    return node;
+}
+
 MOT::RC MOTAdaptor::CreateTable(CreateForeignTableStmt* stmt, ::TransactionId tid)
 {
     bool hasBlob = false;
@@ -1286,6 +1339,7 @@ MOT::RC MOTAdaptor::CreateTable(CreateForeignTableStmt* stmt, ::TransactionId ti
     MOT::RC res = MOT::RC_ERROR;
     std::string tname("");
     char* dbname = NULL;
+    int placementNode = GetTablePlacementNode(stmt->options);
 
     do {
         table = new (std::nothrow) MOT::Table();
@@ -1347,6 +1401,7 @@ MOT::RC MOTAdaptor::CreateTable(CreateForeignTableStmt* stmt, ::TransactionId ti
         AddTableColumns(table, stmt->base.tableElts, hasBlob);
 
         table->SetFixedLengthRow(!hasBlob);
+        table->SetPlacementNode(placementNode);
 
         uint32_t tupleSize = table->GetTupleSize();
         if (tupleSize > (unsigned int)MAX_TUPLE_SIZE) {
@@ -2201,6 +2256,9 @@ void ReleaseFdwState(MOTFdwStateSt* state)
     if (state->m_attrsModified != NULL)
         pfree(state->m_attrsModified);
 
+    if (state->m_scanFilters != nullptr)
+        pfree(state->m_scanFilters);
+
     state->m_table = NULL;
     pfree(state);
 }
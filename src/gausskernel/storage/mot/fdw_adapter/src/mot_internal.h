@@ -122,6 +122,15 @@ typedef struct MOTRecConvert {
 
 #define SORT_STRATEGY(x) ((x == BTGreaterStrategyNumber) ? SORTDIR_DESC : SORTDIR_ASC)
 
+// a "column op constant" qual applied to rows while filling the batches of a vectorized scan
+typedef struct MOTScanFilter_St {
+    AttrNumber m_attNum;
+    bool m_varOnLeft;
+    Oid m_collation;
+    Datum m_const;
+    FmgrInfo m_func;
+} MOTScanFilterSt;
+
 struct MOTFdwState_St {
     ::TransactionId m_txnId;
     bool m_allocInScan;
@@ -156,6 +165,8 @@ struct MOTFdwState_St {
     MOT::MaxKey m_stateKey[2];
     bool m_forwardDirectionScan;
     MOT::AccessType m_internalCmdOper;
+    MOTScanFilterSt* m_scanFilters = nullptr;
+    uint16_t m_numScanFilters = 0;
 };
 
 class MOTAdaptor {
@@ -371,6 +371,16 @@ double MatchIndex::GetCost(int numClauses)
             m_ixOpers[0] = m_ixOpers[1];
             m_ixOpers[1] = tmp;
         }
+
+        // a hash index can only look up all of its columns by equality, but does it in constant time
+        if (m_ix->GetIndexingMethod() == MOT::IndexingMethod::INDEXING_METHOD_HASH) {
+            if (IsFullKeyEquality()) {
+                m_cost *= HASH_INDEX_COST_FACTOR;
+            } else {
+                m_ixOpers[0] = KEY_OPER::READ_INVALID;
+                m_ixOpers[1] = KEY_OPER::READ_INVALID;
+            }
+        }
     }
 
     if (m_ixOpers[0] == KEY_OPER::READ_INVALID && m_ixOpers[1] == KEY_OPER::READ_INVALID) {
@@ -407,10 +417,30 @@ bool MatchIndex::AdjustForOrdering(bool desc)
     return true;
 }
 
+bool MatchIndex::IsFullKeyEquality() const
+{
+    if (m_start < 0) {
+        return false;
+    }
+
+    for (int i = 0; i < m_ix->GetNumFields(); i++) {
+        if (m_colMatch[m_start][i] == nullptr || m_opers[m_start][i] != KEY_OPER::READ_KEY_EXACT) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 bool MatchIndex::CanApplyOrdering(const int* orderCols) const
 {
     int16_t numKeyCols = m_ix->GetNumFields();
 
+    // entries of a hash index have no order
+    if (m_ix->GetIndexingMethod() == MOT::IndexingMethod::INDEXING_METHOD_HASH) {
+        return false;
+    }
+
     // check if order columns are overlap index matched columns or are suffix for it
     for (int16_t i = 0; i < numKeyCols; i++) {
         // overlap: we can use index ordering
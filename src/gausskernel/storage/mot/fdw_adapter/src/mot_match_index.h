@@ -35,6 +35,9 @@ typedef struct MOTFdwState_St MOTFdwStateSt;
 
 #define KEY_OPER_PREFIX_BITMASK 0x10
 
+// a hash index lookup costs this fraction of the equivalent tree index lookup
+#define HASH_INDEX_COST_FACTOR 0.5
+
 typedef enum : uint8_t {
     READ_KEY_EXACT = 0,    // equal
     READ_KEY_LIKE = 1,     // like
@@ -120,6 +123,7 @@ public:
         return m_numMatches[0];
     }
 
+    bool IsFullKeyEquality() const;
     double GetCost(int numClauses);
     bool CanApplyOrdering(const int* orderCols) const;
     bool AdjustForOrdering(bool desc);
@@ -41,6 +41,8 @@
 #include "utils/numeric.h"
 #include "utils/numeric_gs.h"
 #include "catalog/pg_aggregate.h"
+#include "nodes/nodeFuncs.h"
+#include "lib/stringinfo.h"
 
 #include "mot_internal.h"
 #include "storage/mot/jit_exec.h"
@@ -348,6 +350,90 @@ extern JitContext* JitCodegenQuery(Query* query, const char* queryString, JitPla
     return jitContext;
 }
 
+/** @struct Parameter signature of a query issued by a PL/pgSQL function. */
+struct FunctionParamSignature {
+    /** @var The textual signature, made of the identifier and type of each referenced parameter. */
+    StringInfoData m_text;
+
+    /** @var Specifies whether all the referenced parameters can be bound by jitted code. */
+    bool m_valid;
+};
+
+static bool CollectFunctionParams(Node* node, FunctionParamSignature* signature)
+{
+    if (node == nullptr) {
+        return false;
+    }
+    if (IsA(node, Param)) {
+        Param* param = (Param*)node;
+        if (param->paramkind != PARAM_EXTERN) {
+            signature->m_valid = false;
+            return true;  // abort walk
+        }
+        appendStringInfo(&signature->m_text, " $%d::%u", param->paramid, param->paramtype);
+        return false;
+    }
+    if (IsA(node, Query)) {
+        return query_tree_walker((Query*)node, (bool (*)())CollectFunctionParams, signature, 0);
+    }
+    return expression_tree_walker(node, (bool (*)())CollectFunctionParams, signature);
+}
+
+extern JitContext* JitCodegenFunctionQuery(Query* query, const char* queryString, Oid functionId)
+{
+    JitContext* jitContext = nullptr;
+
+    // sub-query contexts are resolved by the original query text, so statements with sub-links are not compiled, and
+    // jitted DML is executed without the executor, so it must not return rows
+    bool supportedCommand = (query->commandType == CMD_SELECT) || (query->commandType == CMD_INSERT) ||
+                            (query->commandType == CMD_UPDATE) || (query->commandType == CMD_DELETE);
+    if (!supportedCommand || (query->utilityStmt != nullptr) || query->hasSubLinks || (query->rowMarks != NIL) ||
+        (query->returningList != NIL)) {
+        MOT_LOG_TRACE("Function %u query is not jittable: unsupported statement: %s", functionId, queryString);
+        JitStatisticsProvider::GetInstance().AddFunctionDisqualifiedQuery(functionId);
+        return nullptr;
+    }
+
+    // the same statement text in different functions (or even in the same function) may refer to variables with
+    // different identifiers or types, so the parameter signature must be part of the JIT source key
+    FunctionParamSignature signature;
+    initStringInfo(&signature.m_text);
+    signature.m_valid = true;
+    appendStringInfoString(&signature.m_text, queryString);
+    appendStringInfoString(&signature.m_text, " /* plpgsql params:");
+    (void)query_tree_walker(query, (bool (*)())CollectFunctionParams, &signature, 0);
+    appendStringInfoString(&signature.m_text, " */");
+
+    if (!signature.m_valid) {
+        MOT_LOG_TRACE("Function %u query is not jittable: unsupported parameter kind: %s", functionId, queryString);
+    } else {
+        JitPlan* jitPlan = IsJittable(query, signature.m_text.data);
+        if (jitPlan != nullptr) {
+            jitContext = JitCodegenQuery(query, signature.m_text.data, jitPlan);
+        }
+    }
+    pfree(signature.m_text.data);
+
+    if (jitContext != nullptr) {
+        JitStatisticsProvider::GetInstance().AddFunctionCodeGenQuery(functionId);
+    } else {
+        JitStatisticsProvider::GetInstance().AddFunctionDisqualifiedQuery(functionId);
+    }
+    return jitContext;
+}
+
+extern void JitReportFunctionQueryExec(Oid functionId, bool jitted)
+{
+    JitStatisticsProvider::GetInstance().AddFunctionExecQuery(functionId, jitted);
+}
+
+extern void JitReportFunctionDropped(Oid functionId)
+{
+    if (JitStatisticsProvider::HasInstance()) {
+        JitStatisticsProvider::GetInstance().RemoveFunctionStatistics(functionId);
+    }
+}
+
 extern void JitResetScan(JitContext* jitContext)
 {
     MOT_LOG_DEBUG("JitResetScan(): Resetting iteration count for context %p", jitContext);
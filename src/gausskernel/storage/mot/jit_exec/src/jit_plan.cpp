@@ -260,6 +260,13 @@ static bool prepareSelectExpressions(Query* query, JitSelectExprArray* expr_arra
     return result;
 }
 
+// A hash index finds all the rows of a key, but has no notion of key ranges
+static bool isHashIndexScan(MOT::Index* index, JitIndexScan* index_scan)
+{
+    return (index_scan->_scan_type == JIT_INDEX_SCAN_POINT) ||
+           ((index_scan->_scan_type == JIT_INDEX_SCAN_CLOSED) && (index_scan->_column_count == index->GetNumFields()));
+}
+
 static bool prepareRangeSearchExpressions(
     Query* query, MOT::Table* table, MOT::Index* index, JitIndexScan* index_scan, JoinClauseType join_clause_type)
 {
@@ -278,6 +285,12 @@ static bool prepareRangeSearchExpressions(
             if (index_scan->_scan_type == JIT_INDEX_SCAN_TYPE_INVALID) {
                 MOT_LOG_TRACE("prepareRangeSearchExpressions(): Disqualifying query - invalid range scan type");
                 result = false;
+            } else if ((index->GetIndexingMethod() == MOT::IndexingMethod::INDEXING_METHOD_HASH) &&
+                       !isHashIndexScan(index, index_scan)) {
+                MOT_LOG_TRACE("prepareRangeSearchExpressions(): Disqualifying query - hash index %s can only be "
+                              "searched by equality on all its columns",
+                    index->GetName().c_str());
+                result = false;
             }
         }
     }
@@ -511,6 +524,11 @@ static bool isPlanSortOrderValid(Query* query, JitRangeSelectPlan* plan)
         result = true;
     } else {
         MOT::Index* index = plan->_index_scan._table->GetIndex(plan->_index_scan._index_id);
+        if (index->GetIndexingMethod() == MOT::IndexingMethod::INDEXING_METHOD_HASH) {
+            MOT_LOG_TRACE("isPlanSortOrderValid(): Disqualifying query - Hash index %s has no order",
+                index->GetName().c_str());
+            return false;
+        }
         result = isJittableSortClause(query, plan->_index_scan._table, index, plan->_index_scan._column_count);
         if (!result) {
             MOT_LOG_TRACE("isPlanSortOrderValid(): Disqualifying query - Sort clause is not jittable")
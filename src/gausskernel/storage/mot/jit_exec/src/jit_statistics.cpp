@@ -130,6 +130,122 @@ JitStatisticsProvider& JitStatisticsProvider::GetInstance()
     return *m_provider;
 }
 
+JitStatisticsProvider::JitFunctionStatistics* JitStatisticsProvider::GetFunctionStatistics(uint32_t functionId)
+{
+    // linear probing from the home slot of the function: stop at its slot, or claim the first reusable one
+    JitFunctionStatistics* dropped = nullptr;
+    uint32_t i = 0;
+    while (i < MAX_FUNCTION_STATS) {
+        JitFunctionStatistics* stats = &m_functionStats[(functionId + i) % MAX_FUNCTION_STATS];
+        uint32_t slotId = stats->m_functionId.load(std::memory_order_acquire);
+        if (slotId == functionId) {
+            return stats;
+        }
+        if (slotId == DROPPED_FUNCTION_SLOT) {
+            if (dropped == nullptr) {
+                dropped = stats;
+            }
+        } else if (slotId == FREE_FUNCTION_SLOT) {
+            // the function has no slot, so prefer the slot of a dropped function seen on the way
+            JitFunctionStatistics* claimed = (dropped != nullptr) ? dropped : stats;
+            uint32_t expected = (dropped != nullptr) ? DROPPED_FUNCTION_SLOT : FREE_FUNCTION_SLOT;
+            if (claimed->m_functionId.compare_exchange_strong(expected, functionId, std::memory_order_acq_rel) ||
+                (expected == functionId)) {
+                return claimed;
+            }
+            if (claimed == dropped) {
+                // another function took the dropped slot, so look at the free slot again
+                dropped = nullptr;
+                continue;
+            }
+        }
+        ++i;
+    }
+
+    if (dropped != nullptr) {
+        uint32_t expected = DROPPED_FUNCTION_SLOT;
+        if (dropped->m_functionId.compare_exchange_strong(expected, functionId, std::memory_order_acq_rel) ||
+            (expected == functionId)) {
+            return dropped;
+        }
+    }
+    MOT_LOG_TRACE("Cannot keep JIT statistics for function %u: all %u slots are in use", functionId,
+        MAX_FUNCTION_STATS);
+    return nullptr;
+}
+
+void JitStatisticsProvider::RemoveFunctionStatistics(uint32_t functionId)
+{
+    for (uint32_t i = 0; i < MAX_FUNCTION_STATS; ++i) {
+        JitFunctionStatistics* stats = &m_functionStats[(functionId + i) % MAX_FUNCTION_STATS];
+        uint32_t slotId = stats->m_functionId.load(std::memory_order_acquire);
+        if (slotId == FREE_FUNCTION_SLOT) {
+            return;
+        }
+        if (slotId == functionId) {
+            // the slot stays in the probe sequence of other functions, so it is marked and not freed
+            stats->m_codeGenQueryCount.store(0, std::memory_order_relaxed);
+            stats->m_disqualifiedQueryCount.store(0, std::memory_order_relaxed);
+            stats->m_jitExecCount.store(0, std::memory_order_relaxed);
+            stats->m_interpretedExecCount.store(0, std::memory_order_relaxed);
+            stats->m_functionId.store(DROPPED_FUNCTION_SLOT, std::memory_order_release);
+            return;
+        }
+    }
+}
+
+void JitStatisticsProvider::AddFunctionCodeGenQuery(uint32_t functionId)
+{
+    if (m_enable) {
+        JitFunctionStatistics* stats = GetFunctionStatistics(functionId);
+        if (stats != nullptr) {
+            (void)stats->m_codeGenQueryCount.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+void JitStatisticsProvider::AddFunctionDisqualifiedQuery(uint32_t functionId)
+{
+    if (m_enable) {
+        JitFunctionStatistics* stats = GetFunctionStatistics(functionId);
+        if (stats != nullptr) {
+            (void)stats->m_disqualifiedQueryCount.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+void JitStatisticsProvider::AddFunctionExecQuery(uint32_t functionId, bool jitted)
+{
+    if (m_enable) {
+        JitFunctionStatistics* stats = GetFunctionStatistics(functionId);
+        if (stats != nullptr) {
+            if (jitted) {
+                (void)stats->m_jitExecCount.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                (void)stats->m_interpretedExecCount.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+}
+
+void JitStatisticsProvider::PrintStatisticsEx()
+{
+    for (uint32_t i = 0; i < MAX_FUNCTION_STATS; ++i) {
+        const JitFunctionStatistics* stats = &m_functionStats[i];
+        uint32_t functionId = stats->m_functionId.load(std::memory_order_acquire);
+        if ((functionId == FREE_FUNCTION_SLOT) || (functionId == DROPPED_FUNCTION_SLOT)) {
+            continue;
+        }
+        MOT_LOG_INFO("JIT function %u: compiled statements=%" PRIu64 ", disqualified statements=%" PRIu64
+                     ", jitted executions=%" PRIu64 ", interpreted executions=%" PRIu64,
+            functionId,
+            stats->m_codeGenQueryCount.load(std::memory_order_relaxed),
+            stats->m_disqualifiedQueryCount.load(std::memory_order_relaxed),
+            stats->m_jitExecCount.load(std::memory_order_relaxed),
+            stats->m_interpretedExecCount.load(std::memory_order_relaxed));
+    }
+}
+
 void JitStatisticsProvider::OnConfigChange()
 {
     if (m_enable != MOT::GetGlobalConfiguration().m_enableJitStatistics) {
@@ -32,6 +32,9 @@
 #include "statistics_provider.h"
 #include "typed_statistics_generator.h"
 
+#include <atomic>
+#include <cstdint>
+
 namespace JitExec {
 /**
  * @brief Thread-level statistics collector for database events.
@@ -298,13 +301,65 @@ public:
         }
     }
 
+    /** @brief Records a statement of a PL/pgSQL function that was compiled into jitted code. */
+    void AddFunctionCodeGenQuery(uint32_t functionId);
+
+    /** @brief Records a statement of a PL/pgSQL function that was disqualified from JIT compilation. */
+    void AddFunctionDisqualifiedQuery(uint32_t functionId);
+
+    /**
+     * @brief Records a statement execution of a PL/pgSQL function.
+     * @param functionId The identifier of the function.
+     * @param jitted Specifies whether the statement was executed by jitted code or by the interpreter.
+     */
+    void AddFunctionExecQuery(uint32_t functionId, bool jitted);
+
+    /** @brief Discards the statistics of a dropped PL/pgSQL function. */
+    void RemoveFunctionStatistics(uint32_t functionId);
+
+    /** @brief Queries whether the single instance was created. */
+    static inline bool HasInstance()
+    {
+        return m_provider != nullptr;
+    }
+
     /**
      * @brief Derives classes should react to a notification that configuration changed. New
      * configuration is accessible via the ConfigManager.
      */
     virtual void OnConfigChange();
 
+protected:
+    /** @brief Prints the per-function statistics of PL/pgSQL functions accessing MOT tables. */
+    virtual void PrintStatisticsEx();
+
 private:
+    /** @var The number of functions whose statistics can be kept at the same time. */
+    static constexpr uint32_t MAX_FUNCTION_STATS = 1024;
+
+    /** @var Marks a slot that was never used (the invalid function identifier). */
+    static constexpr uint32_t FREE_FUNCTION_SLOT = 0;
+
+    /** @var Marks a slot of a dropped function, which can be claimed again. */
+    static constexpr uint32_t DROPPED_FUNCTION_SLOT = UINT32_MAX;
+
+    /**
+     * @struct JitFunctionStatistics
+     * @brief JIT statistics of a single PL/pgSQL function, kept in a slot of a fixed table. A slot is claimed by
+     * setting its function identifier, and all its fields are updated without locking.
+     */
+    struct JitFunctionStatistics {
+        std::atomic<uint32_t> m_functionId{FREE_FUNCTION_SLOT};
+
+        std::atomic<uint64_t> m_codeGenQueryCount{0};
+
+        std::atomic<uint64_t> m_disqualifiedQueryCount{0};
+
+        std::atomic<uint64_t> m_jitExecCount{0};
+
+        std::atomic<uint64_t> m_interpretedExecCount{0};
+    };
+
     /** @brief Constructor. */
     JitStatisticsProvider();
 
@@ -314,6 +369,15 @@ private:
     /** @brief Registers the provider in the manager. */
     void RegisterProvider();
 
+    /**
+     * @brief Retrieves (and claims on first use) the statistics slot of a function.
+     * @return The slot, or null if all slots are in use.
+     */
+    JitFunctionStatistics* GetFunctionStatistics(uint32_t functionId);
+
+    /** @var Per-function statistics, an open-addressing table keyed by function identifier. */
+    JitFunctionStatistics m_functionStats[MAX_FUNCTION_STATS];
+
     /** @var The single instance. */
     static JitStatisticsProvider* m_provider;
 
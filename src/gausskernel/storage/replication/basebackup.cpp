@@ -607,6 +607,12 @@ void PerformMotCheckpointFetch()
         /* send the checkpoint dir */
         sendDir(fullChkptDir, (int)basePathLen, false, NIL, false);
 
+        /* send the checkpoints that a delta checkpoint is based on */
+        char baseChkptDir[MAXPGPATH] = {0};
+        for (uint32 i = 0; MOTGetCheckpointBaseDir(i, baseChkptDir, MAXPGPATH); i++) {
+            sendDir(baseChkptDir, (int)basePathLen, false, NIL, false);
+        }
+
         /* CopyDone */
         pq_putemptymessage_noblock('c');
     }
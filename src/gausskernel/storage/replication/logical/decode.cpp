@@ -168,6 +168,8 @@ void LogicalDecodingProcessRecord(LogicalDecodingContext *ctx, XLogReaderState *
         case RM_MOT_ID:
             break;
 #endif
+        case RM_BRIN_ID:
+            break;
         default:
             ereport(WARNING, (errcode(ERRCODE_UNRECOGNIZED_NODE_TYPE),
                             errmsg("unexpected rmgr_id: %d", (RmgrIds)XLogRecGetRmid(buf.record))));
@@ -2548,7 +2548,7 @@ static void ReorderBufferToastReplace(ReorderBuffer *rb, ReorderBufferTXN *txn,
             securec_check(rc, "", "");
             data_done += VARSIZE(chunk) - VARHDRSZ;
         }
-        Assert(data_done == (Size)toast_pointer.va_extsize);
+        Assert(data_done == (Size)VARATT_EXTERNAL_GET_EXTSIZE(toast_pointer));
 
         /* make sure its marked as compressed or not */
         if (VARATT_EXTERNAL_IS_COMPRESSED(toast_pointer))
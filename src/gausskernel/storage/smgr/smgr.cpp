@@ -151,6 +151,10 @@ static void _smgr_init(SMgrRelation reln, int col = 0)
     reln->smgr_fsm_nblocks = InvalidBlockNumber;
     reln->smgr_vm_nblocks = InvalidBlockNumber;
     reln->smgr_cached_nblocks = InvalidBlockNumber;
+    reln->smgr_extent_next = InvalidBlockNumber;
+    reln->smgr_extent_end = InvalidBlockNumber;
+    reln->smgr_extent_size = 0;
+    reln->smgr_extent_time = 0;
 
     reln->smgr_which = 0; /* we only have md.c at present */
 
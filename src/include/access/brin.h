@@ -0,0 +1,48 @@
+/* --------------------------------------------------------------------------
+ * brin.h
+ *	  Public header file for the block range index (BRIN) access method.
+ *
+ *	A BRIN index keeps one small summary tuple per range of consecutive heap
+ *	blocks, e.g. the minimum and maximum value of the indexed column.  A scan
+ *	returns every block of each range whose summary may match the quals, so
+ *	it is only useful for columns whose values follow the physical order of
+ *	the table, such as insertion timestamps or sequence numbers.
+ *
+ * Portions Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ *	src/include/access/brin.h
+ * --------------------------------------------------------------------------
+ */
+#ifndef BRIN_H
+#define BRIN_H
+
+#include "storage/buf/block.h"
+#include "utils/relcache.h"
+
+/*
+ * Storage type for BRIN's reloptions
+ */
+typedef struct BrinOptions {
+    int32 vl_len_;      /* varlena header (do not touch directly!) */
+    int pagesPerRange;  /* heap blocks summarized by one index tuple */
+    bool autosummarize; /* have autovacuum summarize the previous range on insert */
+} BrinOptions;
+
+#define BRIN_DEFAULT_PAGES_PER_RANGE 128
+#define BrinGetPagesPerRange(relation) \
+    ((relation)->rd_options ? (BlockNumber)((BrinOptions *)(relation)->rd_options)->pagesPerRange \
+                            : BRIN_DEFAULT_PAGES_PER_RANGE)
+#define BrinGetAutoSummarize(relation) \
+    ((relation)->rd_options ? ((BrinOptions *)(relation)->rd_options)->autosummarize : false)
+
+/*
+ * BrinStatsData represents stats data for planner use
+ */
+typedef struct BrinStatsData {
+    BlockNumber pagesPerRange;
+} BrinStatsData;
+
+extern void brinGetStats(Relation index, BrinStatsData *stats);
+extern void brin_summarize_range_work(Oid indexoid, BlockNumber heapBlk);
+
+#endif /* BRIN_H */
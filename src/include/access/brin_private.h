@@ -0,0 +1,279 @@
+/* --------------------------------------------------------------------------
+ * brin_private.h
+ *	  header file for the block range index (BRIN) access method
+ *	  implementation.
+ *
+ * Portions Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ *	src/include/access/brin_private.h
+ * --------------------------------------------------------------------------
+ */
+#ifndef BRIN_PRIVATE_H
+#define BRIN_PRIVATE_H
+
+#include "access/brin.h"
+#include "access/genam.h"
+#include "access/htup.h"
+#include "access/skey.h"
+#include "access/xlogreader.h"
+#include "fmgr.h"
+#include "lib/stringinfo.h"
+#include "storage/buf/bufmgr.h"
+#include "storage/buf/bufpage.h"
+#include "storage/item/itemptr.h"
+#include "utils/typcache.h"
+
+/*
+ * amproc indexes for BRIN opclasses.  The hash procedure is only used by
+ * the bloom opclasses.
+ */
+#define BRIN_PROCNUM_OPCINFO 1
+#define BRIN_PROCNUM_ADDVALUE 2
+#define BRIN_PROCNUM_CONSISTENT 3
+#define BRIN_PROCNUM_UNION 4
+#define BRIN_PROCNUM_HASH 5
+#define BRINNProcs 5
+
+/*
+ * Page layout.
+ *
+ * Block 0 is the metapage.  The other pages are either regular pages holding
+ * summary tuples, or pages of the range map ("revmap") that leads from a heap
+ * block to the summary tuple of its range.  The revmap has two levels: the
+ * metapage points to directory pages, and each directory page points to
+ * revmap pages holding one TID per range.  Revmap and directory pages are
+ * allocated on demand at the end of the index and never freed, so their
+ * block numbers can be cached freely once seen.
+ */
+typedef struct BrinSpecialSpace {
+    uint16 flags; /* currently unused */
+    uint16 type;  /* page type, see below */
+} BrinSpecialSpace;
+
+#define BRIN_PAGETYPE_META 0xF091
+#define BRIN_PAGETYPE_DIR 0xF092
+#define BRIN_PAGETYPE_REVMAP 0xF093
+#define BRIN_PAGETYPE_REGULAR 0xF094
+
+#define BrinPageGetSpecial(page) ((BrinSpecialSpace *)PageGetSpecialPointer(page))
+#define BrinPageType(page) (BrinPageGetSpecial(page)->type)
+#define BRIN_IS_META_PAGE(page) (BrinPageType(page) == BRIN_PAGETYPE_META)
+#define BRIN_IS_DIR_PAGE(page) (BrinPageType(page) == BRIN_PAGETYPE_DIR)
+#define BRIN_IS_REVMAP_PAGE(page) (BrinPageType(page) == BRIN_PAGETYPE_REVMAP)
+#define BRIN_IS_REGULAR_PAGE(page) (BrinPageType(page) == BRIN_PAGETYPE_REGULAR)
+
+#define BRIN_METAPAGE_BLKNO 0
+#define BRIN_META_MAGIC 0xA8109CFA
+#define BRIN_CURRENT_VERSION 1
+
+typedef struct BrinMetaPageData {
+    uint32 brinMagic;
+    uint32 brinVersion;
+    BlockNumber pagesPerRange;
+    BlockNumber dirPages[FLEXIBLE_ARRAY_MEMBER]; /* InvalidBlockNumber if not allocated yet */
+} BrinMetaPageData;
+
+/* space available for the array on a metapage, directory or revmap page */
+#define BrinPageContentSize (BLCKSZ - MAXALIGN(SizeOfPageHeaderData) - MAXALIGN(sizeof(BrinSpecialSpace)))
+
+#define BRIN_META_MAX_DIRS ((BrinPageContentSize - offsetof(BrinMetaPageData, dirPages)) / sizeof(BlockNumber))
+#define BRIN_DIR_PAGE_MAXITEMS (BrinPageContentSize / sizeof(BlockNumber))
+#define BRIN_REVMAP_PAGE_MAXITEMS (BrinPageContentSize / sizeof(ItemPointerData))
+
+#define BrinPageGetMeta(page) ((BrinMetaPageData *)PageGetContents(page))
+#define BrinDirPageGetItems(page) ((BlockNumber *)PageGetContents(page))
+#define BrinRevmapPageGetItems(page) ((ItemPointerData *)PageGetContents(page))
+
+/* largest summary tuple that fits on an empty regular page */
+#define BrinMaxItemSize                                                            \
+    MAXALIGN_DOWN(BLCKSZ - (MAXALIGN(SizeOfPageHeaderData + sizeof(ItemIdData)) + \
+                            MAXALIGN(sizeof(BrinSpecialSpace))))
+
+/*
+ * On-disk summary tuple.  The header is followed by a heap tuple image built
+ * over bd_disktdesc: for each index column an "allnulls" and a "hasnulls"
+ * flag and then the values the opclass stores.
+ */
+typedef struct BrinTuple {
+    BlockNumber bt_blkno; /* first heap block of the summarized range */
+    uint16 bt_flags;
+} BrinTuple;
+
+/*
+ * A placeholder is inserted while a range is being summarized.  Scans treat
+ * it as matching everything, inserts add their values to it, and the
+ * summarization merges those with what it found in the heap.
+ */
+#define BRIN_PLACEHOLDER_MASK 0x0001
+
+#define SizeOfBrinTuple MAXALIGN(sizeof(BrinTuple))
+#define BrinTupleIsPlaceholder(tup) (((tup)->bt_flags & BRIN_PLACEHOLDER_MASK) != 0)
+#define BrinTupleGetData(tup) ((HeapTupleHeader)((char *)(tup) + SizeOfBrinTuple))
+
+/*
+ * In-memory summary of one index column.  bv_allnulls means no non-null
+ * value has been seen (bv_values are then meaningless), bv_hasnulls that at
+ * least one null has been seen.  A range with no tuples at all has
+ * bv_allnulls set and bv_hasnulls clear.
+ */
+typedef struct BrinValues {
+    AttrNumber bv_attno; /* index attribute number */
+    bool bv_hasnulls;
+    bool bv_allnulls;
+    Datum *bv_values; /* oi_nstored values, allocated in bt_context */
+} BrinValues;
+
+typedef struct BrinMemTuple {
+    bool bt_placeholder;
+    BlockNumber bt_blkno;
+    MemoryContext bt_context; /* holds the column values */
+    BrinValues bt_columns[FLEXIBLE_ARRAY_MEMBER];
+} BrinMemTuple;
+
+/*
+ * What an opclass's opcinfo procedure returns: how many values it stores per
+ * column and their types, plus private state for its other procedures.
+ */
+typedef struct BrinOpcInfo {
+    uint16 oi_nstored;
+    void *oi_opaque;
+    TypeCacheEntry *oi_typcache[FLEXIBLE_ARRAY_MEMBER];
+} BrinOpcInfo;
+
+#define SizeofBrinOpcInfo(ncols) (offsetof(BrinOpcInfo, oi_typcache) + sizeof(TypeCacheEntry *) * (ncols))
+
+typedef struct BrinDesc {
+    MemoryContext bd_context; /* holds this struct and everything it points to */
+    Relation bd_index;
+    TupleDesc bd_tupdesc;     /* tuple descriptor of the index */
+    TupleDesc bd_disktdesc;   /* tuple descriptor of the on-disk summaries */
+    int bd_totalstored;       /* values stored for all columns */
+    BrinOpcInfo *bd_info[FLEXIBLE_ARRAY_MEMBER];
+} BrinDesc;
+
+typedef struct BrinRevmap BrinRevmap;
+
+/*
+ * XLOG record types for BRIN.  INIT_PAGE is or'ed in when the page the new
+ * tuple goes to was initialized by the operation.  The revmap extension,
+ * vacuum and the end of a build are still logged as full-page images.
+ */
+#define XLOG_BRIN_INSERT 0x10
+#define XLOG_BRIN_UPDATE 0x20
+#define XLOG_BRIN_SAMEPAGE_UPDATE 0x30
+#define XLOG_BRIN_OPMASK 0x70
+#define XLOG_BRIN_INIT_PAGE 0x80
+
+/*
+ * Insertion of the first summary tuple of a range.
+ *
+ * Backup Blk 0: regular page the tuple goes to, with the tuple as data
+ * Backup Blk 1: revmap page
+ */
+typedef struct xl_brin_insert {
+    BlockNumber heapBlk;       /* first heap block of the range */
+    BlockNumber pagesPerRange; /* to locate the map entry of heapBlk */
+    OffsetNumber offnum;       /* where the tuple goes on block 0 */
+} xl_brin_insert;
+
+#define SizeOfBrinInsert (offsetof(xl_brin_insert, offnum) + sizeof(OffsetNumber))
+
+/*
+ * Move of a summary tuple to another page.  Blocks 0 and 1 are as for an
+ * insertion.
+ *
+ * Backup Blk 2: old page the tuple is removed from
+ */
+typedef struct xl_brin_update {
+    OffsetNumber oldOffnum; /* offset of the old tuple on block 2 */
+    xl_brin_insert insert;
+} xl_brin_update;
+
+#define SizeOfBrinUpdate (offsetof(xl_brin_update, insert) + SizeOfBrinInsert)
+
+/*
+ * In-place replacement of a summary tuple.
+ *
+ * Backup Blk 0: the page, with the new tuple as data
+ */
+typedef struct xl_brin_samepage_update {
+    OffsetNumber offnum;
+} xl_brin_samepage_update;
+
+#define SizeOfBrinSamepageUpdate (sizeof(OffsetNumber))
+
+/* brin.cpp */
+extern BrinDesc *brin_build_desc(Relation rel);
+extern void brin_free_desc(BrinDesc *bdesc);
+extern bool brin_add_values(BrinDesc *bdesc, BrinMemTuple *dtup, const Datum *values, const bool *nulls);
+extern void brin_union_tuples(BrinDesc *bdesc, BrinMemTuple *a, BrinMemTuple *b);
+
+extern Datum brinbuild(PG_FUNCTION_ARGS);
+extern Datum brinbuildempty(PG_FUNCTION_ARGS);
+extern Datum brininsert(PG_FUNCTION_ARGS);
+extern Datum brinbeginscan(PG_FUNCTION_ARGS);
+extern Datum bringetbitmap(PG_FUNCTION_ARGS);
+extern Datum brinrescan(PG_FUNCTION_ARGS);
+extern Datum brinendscan(PG_FUNCTION_ARGS);
+extern Datum brinmarkpos(PG_FUNCTION_ARGS);
+extern Datum brinrestrpos(PG_FUNCTION_ARGS);
+extern Datum brinmerge(PG_FUNCTION_ARGS);
+extern Datum brinbulkdelete(PG_FUNCTION_ARGS);
+extern Datum brinvacuumcleanup(PG_FUNCTION_ARGS);
+extern Datum brinoptions(PG_FUNCTION_ARGS);
+extern Datum brin_summarize_new_values(PG_FUNCTION_ARGS);
+
+/* brin_tuple.cpp */
+extern BrinTuple *brin_form_tuple(BrinDesc *bdesc, BlockNumber blkno, BrinMemTuple *dtup, Size *size);
+extern BrinTuple *brin_form_placeholder_tuple(BrinDesc *bdesc, BlockNumber blkno, Size *size);
+extern BrinTuple *brin_copy_tuple(const BrinTuple *tuple, Size len);
+extern bool brin_tuples_equal(const BrinTuple *a, Size alen, const BrinTuple *b, Size blen);
+extern BrinMemTuple *brin_new_memtuple(BrinDesc *bdesc);
+extern void brin_memtuple_initialize(BrinMemTuple *dtup, BrinDesc *bdesc);
+extern BrinMemTuple *brin_deform_tuple(BrinDesc *bdesc, const BrinTuple *tuple, Size len);
+extern void brin_free_memtuple(BrinMemTuple *dtup);
+
+/* brin_revmap.cpp */
+extern BrinRevmap *brinRevmapInitialize(Relation idxrel, BlockNumber *pagesPerRange, bool logChanges);
+extern void brinRevmapTerminate(BrinRevmap *revmap);
+extern bool brinRevmapLogChanges(const BrinRevmap *revmap);
+extern void brinRevmapExtend(BrinRevmap *revmap, BlockNumber heapBlk);
+extern Buffer brinLockRevmapPageForUpdate(BrinRevmap *revmap, BlockNumber heapBlk);
+extern bool brinRevmapGetItem(Buffer rmbuf, BlockNumber pagesPerRange, BlockNumber heapBlk, ItemPointer tid);
+extern void brinSetHeapBlockItemptr(Buffer rmbuf, BlockNumber pagesPerRange, BlockNumber heapBlk, ItemPointerData tid);
+extern bool brinRevmapGetTid(BrinRevmap *revmap, BlockNumber heapBlk, ItemPointer tid);
+extern BrinTuple *brinGetTupleForHeapBlock(BrinRevmap *revmap, BlockNumber heapBlk, Buffer *buf, OffsetNumber *off,
+                                           Size *size, int mode);
+
+/* brin_pageops.cpp */
+extern Buffer brin_extend_relation(Relation idxrel);
+extern void brin_page_init(Page page, uint16 type);
+extern void brin_metapage_init(Page page, BlockNumber pagesPerRange);
+extern bool brin_can_do_samepage_update(Buffer buffer, Size origsz, Size newsz);
+extern bool brin_doinsert(Relation idxrel, BlockNumber pagesPerRange, BrinRevmap *revmap, BlockNumber heapBlk,
+                          BrinTuple *tup, Size itemsz);
+extern bool brin_doupdate(Relation idxrel, BlockNumber pagesPerRange, BrinRevmap *revmap, BlockNumber heapBlk,
+                          Buffer oldbuf, OffsetNumber oldoff, const BrinTuple *origtup, Size origsz,
+                          const BrinTuple *newtup, Size newsz, bool samepage);
+extern void brin_vacuum_scan(Relation idxrel, BrinRevmap *revmap, BufferAccessStrategy strategy);
+extern void brin_log_newpages(Relation idxrel);
+
+/* brin_xlog.cpp */
+extern void brin_redo(XLogReaderState *record);
+
+/* brindesc.cpp */
+extern void brin_desc(StringInfo buf, XLogReaderState *record);
+
+/* brin_minmax.cpp */
+extern Datum brin_minmax_opcinfo(PG_FUNCTION_ARGS);
+extern Datum brin_minmax_add_value(PG_FUNCTION_ARGS);
+extern Datum brin_minmax_consistent(PG_FUNCTION_ARGS);
+extern Datum brin_minmax_union(PG_FUNCTION_ARGS);
+
+/* brin_bloom.cpp */
+extern Datum brin_bloom_opcinfo(PG_FUNCTION_ARGS);
+extern Datum brin_bloom_add_value(PG_FUNCTION_ARGS);
+extern Datum brin_bloom_consistent(PG_FUNCTION_ARGS);
+extern Datum brin_bloom_union(PG_FUNCTION_ARGS);
+
+#endif /* BRIN_PRIVATE_H */
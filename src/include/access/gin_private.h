@@ -684,6 +684,7 @@ extern void ginPrepareEntryScan(GinBtree btree, OffsetNumber attnum, Datum key,
                                 GinState *ginstate);
 extern void ginEntryFillRoot(GinBtree btree, Page root, BlockNumber lblkno, Page lpage, BlockNumber rblkno, Page rpage);
 extern ItemPointer ginReadTuple(GinState *ginstate, OffsetNumber attnum, IndexTuple itup, int *nitems);
+extern IndexTuple GinFormInteriorTuple(IndexTuple itup, Page page, BlockNumber childblk);
 
 /* gindatapage.c */
 extern ItemPointer GinDataLeafPageGetItems(Page page, int *nitems, ItemPointerData advancePast);
@@ -118,6 +118,9 @@ typedef struct BTMetaPageData {
 #define BTREE_SPLIT_UPGRADE_FLAG 0x01
 #define BTREE_DELETE_UPGRADE_FLAG 0x02
 
+/* Upgrade support for posting list tuples (deduplication). */
+extern const uint32 BTREE_DEDUP_VERSION_NUM;
+
 /*
  * Maximum size of a btree index entry, including its tuple header.
  *
@@ -209,6 +212,14 @@ typedef struct BTMetaPageData {
 #define P_FIRSTKEY ((OffsetNumber)2)
 #define P_FIRSTDATAKEY(opaque) (P_RIGHTMOST(opaque) ? P_HIKEY : P_FIRSTKEY)
 
+/*
+ * Upper bound on the number of heap TIDs a leaf page can reference once its
+ * duplicates are merged into posting lists.  Scans size their per-page item
+ * arrays with this rather than MaxIndexTuplesPerPage.
+ */
+#define MaxTIDsPerBTreePage \
+    (int)((BLCKSZ - SizeOfPageHeaderData - sizeof(BTPageOpaqueData)) / sizeof(ItemPointerData))
+
 /*
  * XLOG records for btree operations
  *
@@ -235,6 +246,8 @@ typedef struct BTMetaPageData {
 #define XLOG_BTREE_REUSE_PAGE                   \
     0xD0 /* old page is about to be reused from \
           * FSM */
+#define XLOG_BTREE_DEDUP 0xE0          /* merge duplicates into posting lists */
+#define XLOG_BTREE_UPDATE_POSTING 0xF0 /* replace posting list tuples in place */
 
 
 enum {
@@ -258,6 +271,14 @@ enum {
     BTREE_DELETE_ORIG_BLOCK_NUM = 0,
 };
 
+enum {
+    BTREE_DEDUP_ORIG_BLOCK_NUM = 0,
+};
+
+enum {
+    BTREE_UPDATE_POSTING_ORIG_BLOCK_NUM = 0,
+};
+
 enum {
     BTREE_HALF_DEAD_LEAF_PAGE_NUM = 0,
     BTREE_HALF_DEAD_PARENT_PAGE_NUM,
@@ -400,6 +421,45 @@ typedef struct xl_btree_vacuum {
 
 #define SizeOfBtreeVacuum (offsetof(xl_btree_vacuum, lastBlockVacuumed) + sizeof(BlockNumber))
 
+/*
+ * A run of adjacent leaf items that deduplication merges into one posting
+ * list tuple: the items at baseoff .. baseoff + nitems - 1.
+ */
+typedef struct BTDedupInterval {
+    OffsetNumber baseoff;
+    uint16 nitems;
+} BTDedupInterval;
+
+/*
+ * This is what we need to know about deduplication of a leaf page.  Replay
+ * merges the same intervals the same way, so no tuples are logged.
+ *
+ * Backup Blk 0: leaf page (data contains the BTDedupInterval array)
+ */
+typedef struct xl_btree_dedup {
+    uint16 nintervals;
+
+    /* BTDedupInterval ARRAY FOLLOWS AS BLOCK DATA */
+} xl_btree_dedup;
+
+#define SizeOfBtreeDedup (offsetof(xl_btree_dedup, nintervals) + sizeof(uint16))
+
+/*
+ * This is what we need to know about replacing posting list tuples with
+ * smaller ones, as VACUUM does when only some of a posting list's heap TIDs
+ * are dead.  The item offsets don't change.
+ *
+ * Backup Blk 0: leaf page (data contains the target offsets, followed by
+ * the replacement tuples, each MAXALIGN'd)
+ */
+typedef struct xl_btree_update_posting {
+    uint16 nupdated;
+
+    /* TARGET OFFSET NUMBERS AND NEW TUPLES FOLLOW AS BLOCK DATA */
+} xl_btree_update_posting;
+
+#define SizeOfBtreeUpdatePosting (offsetof(xl_btree_update_posting, nupdated) + sizeof(uint16))
+
 /*
  * This is what we need to know about deletion of a btree page.  The target
  * identifies the tuple removed from the parent page (note that we remove
@@ -546,12 +606,36 @@ typedef struct xl_btree_newroot {
         BTreeTupleSetNAtts((itup), 0);                        \
     } while (0)
 
+/*
+ * Posting list tuples.  When deduplication is enabled for an index (the
+ * deduplicate_items storage parameter), leaf tuples with identical keys are
+ * merged into one tuple holding the key once, followed by an array of the
+ * heap TIDs in ascending order.  Such a tuple has INDEX_ALT_TID_MASK set and
+ * the BT_IS_POSTING bit in its t_tid offset; the low offset bits hold the
+ * number of heap TIDs and the block number holds the offset of the TID array,
+ * which is also the MAXALIGN'd size of the key part.  Pivot tuples are never
+ * posting list tuples.
+ */
+#define BT_IS_POSTING 0x2000
+
+#define BTreeTupleIsPosting(itup)                  \
+    (((itup)->t_info & INDEX_ALT_TID_MASK) != 0 && \
+        (ItemPointerGetOffsetNumberNoCheck(&(itup)->t_tid) & BT_IS_POSTING) != 0)
+#define BTreeTupleGetNPosting(itup) (ItemPointerGetOffsetNumberNoCheck(&(itup)->t_tid) & BT_N_KEYS_OFFSET_MASK)
+#define BTreeTupleGetPostingOffset(itup) ItemPointerGetBlockNumberNoCheck(&(itup)->t_tid)
+#define BTreeTupleGetPosting(itup) ((ItemPointer)((char*)(itup) + BTreeTupleGetPostingOffset(itup)))
+#define BTreeTupleGetPostingN(itup, n) (BTreeTupleGetPosting(itup) + (n))
+
+/* First (or only) heap TID of a leaf tuple */
+#define BTreeTupleGetHeapTID(itup) (BTreeTupleIsPosting(itup) ? BTreeTupleGetPosting(itup) : &(itup)->t_tid)
+
 /*
  * Get/set number of attributes within B-tree index tuple. Asserts should be
- * removed when BT_RESERVED_OFFSET_MASK bits will be used.
+ * removed when BT_RESERVED_OFFSET_MASK bits will be used.  Posting list
+ * tuples always have all attributes.
  */
 #define BTreeTupleGetNAtts(itup, rel)                                                                           \
-    ((itup)->t_info & INDEX_ALT_TID_MASK                                                                        \
+    (((itup)->t_info & INDEX_ALT_TID_MASK) && !BTreeTupleIsPosting(itup)                                        \
             ? (AssertMacro((ItemPointerGetOffsetNumberNoCheck(&(itup)->t_tid) & BT_RESERVED_OFFSET_MASK) == 0), \
                   ItemPointerGetOffsetNumberNoCheck(&(itup)->t_tid) & BT_N_KEYS_OFFSET_MASK)                    \
             : IndexRelationGetNumberOfAttributes(rel))
@@ -678,7 +762,7 @@ typedef struct BTScanPosData {
     int lastItem;  /* last valid index in items[] */
     int itemIndex; /* current index in items[] */
 
-    BTScanPosItem items[MaxIndexTuplesPerPage]; /* MUST BE LAST */
+    BTScanPosItem items[MaxTIDsPerBTreePage]; /* MUST BE LAST */
 } BTScanPosData;
 
 typedef BTScanPosData* BTScanPos;
@@ -836,8 +920,22 @@ extern bool _bt_page_recyclable(Page page);
 extern void _bt_delitems_delete(Relation rel, Buffer buf, OffsetNumber* itemnos, int nitems, Relation heapRel);
 extern void _bt_delitems_vacuum(
     Relation rel, Buffer buf, OffsetNumber* itemnos, int nitems, BlockNumber lastBlockVacuumed);
+extern void _bt_update_posting(Relation rel, Buffer buf, OffsetNumber* itemnos, IndexTuple* itups, int nitems);
 extern int _bt_pagedel(Relation rel, Buffer buf, BTStack stack);
 extern void _bt_page_localupgrade(Page page);
+/*
+ * prototypes for functions in nbtdedup.c
+ */
+extern bool _bt_dedup_enabled(Relation rel);
+extern bool _bt_dedup_one_page(Relation rel, Buffer buf, Size newitemsz);
+extern Page _bt_dedup_page(Page page, const BTDedupInterval* intervals, int nintervals);
+extern IndexTuple _bt_form_posting(IndexTuple base, ItemPointer htids, int nhtids);
+extern IndexTuple _bt_posting_key(IndexTuple itup);
+extern void _bt_update_posting_page(Page page, const OffsetNumber* itemnos, IndexTuple* itups, int nitems);
+extern bool _bt_bottomup_delete(
+    Relation rel, Buffer buf, Relation heapRel, int keysz, ScanKey scankey, Size newitemsz);
+extern Datum gs_btree_bottomup_stat(PG_FUNCTION_ARGS);
+
 /*
  * prototypes for functions in nbtsearch.c
  */
@@ -902,6 +1000,8 @@ extern BTSpool* _bt_spoolinit(Relation index, bool isunique, bool isdead, void*
 extern void _bt_spooldestroy(BTSpool* btspool);
 extern void _bt_spool(BTSpool* btspool, ItemPointer self, Datum* values, const bool* isnull);
 extern void _bt_leafbuild(BTSpool* btspool, BTSpool* spool2);
+extern bool _bt_parallel_build(Relation heap, Relation index, struct IndexInfo* indexInfo, double* heapTuples,
+    double* indexTuples);
 // these 4 functions are move here from nbtsearch.cpp(static functions)
 extern void _bt_buildadd(BTWriteState* wstate, BTPageState* state, IndexTuple itup);
 extern void _bt_uppershutdown(BTWriteState* wstate, BTPageState* state);
@@ -0,0 +1,99 @@
+/* -------------------------------------------------------------------------
+ *
+ * parallelbuild.h
+ *	  Worker threads that share the heap scan of an index build.
+ *
+ *
+ * Portions Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * src/include/access/parallelbuild.h
+ *
+ * -------------------------------------------------------------------------
+ */
+#ifndef PARALLELBUILD_H
+#define PARALLELBUILD_H
+
+#include "access/xact.h"
+#include "gs_thread.h"
+#include "nodes/execnodes.h"
+#include "utils/relcache.h"
+
+#define INDEX_BUILD_ERRMSG_LEN 1024
+
+typedef struct IndexBuildParallel IndexBuildParallel;
+
+/*
+ * Run in each worker once the heap and index are open and the leader's
+ * transaction is restored.  The function does the worker's share of the
+ * heap scan (indexInfo->ii_ParallelWorkers is set, so IndexBuildHeapScan
+ * only returns this worker's stripes) and hands its results to the leader
+ * through pbuild->amstate.  It reports the number of heap tuples scanned.
+ *
+ * Workers started by IndexVacuumParallelBegin get NULL index and indexInfo;
+ * they open the indexes to vacuum themselves, see IndexBuildWorkerOpen.
+ */
+typedef double (*IndexBuildWorkerFunc)(IndexBuildParallel* pbuild, int workerId, Relation heap, Relation index,
+    IndexInfo* indexInfo);
+
+/* Per-worker status.  Written by the worker, read by the leader once finished is set. */
+typedef struct IndexBuildWorkerSlot {
+    IndexBuildParallel* pbuild;
+    int workerId;
+    int childSlot;                  /* postmaster child slot the leader assigned */
+    ThreadId tid;                   /* set by the worker once it runs, under pbuild->mutex */
+    bool finished;                  /* worker is gone, under pbuild->mutex */
+    bool failed;                    /* worker hit an error */
+    int sqlerrcode;
+    char message[INDEX_BUILD_ERRMSG_LEN];
+    char detail[INDEX_BUILD_ERRMSG_LEN];
+    double reltuples;               /* heap tuples the worker scanned */
+    bool brokenHotChain;            /* worker saw a broken HOT chain */
+} IndexBuildWorkerSlot;
+
+struct IndexBuildParallel {
+    int nworkers;                   /* workers sharing the scan */
+    int nlaunched;                  /* workers actually started */
+    IndexBuildWorkerFunc workerFunc;
+    void* amstate;                  /* access method's shared state */
+
+    /* relations; a partition is identified by its parent and its own oid */
+    Oid heapOid;
+    Oid heapParentOid;
+    Oid indexOid;
+    Oid indexParentOid;
+    bool isConcurrent;
+    bool isVacuum;                  /* workers vacuum indexes rather than build one */
+
+    /* settings the workers take over from the leader's session */
+    char* dbName;
+    char* userName;
+    int sortMem;                    /* maintenance_work_mem for each worker, in kB */
+    int workMem;
+    StreamTxnContext txnCxt;
+
+    /* protects the slots and anything the access method shares with the workers */
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    volatile bool aborting;         /* leader gave up, workers should stop */
+
+    IndexBuildWorkerSlot* workers;
+};
+
+extern int IndexBuildParallelDegree(Relation heap, Relation index, IndexInfo* indexInfo);
+extern IndexBuildParallel* IndexBuildParallelBegin(Relation heap, Relation index, IndexInfo* indexInfo,
+    int nworkers, IndexBuildWorkerFunc workerFunc, void* amstate);
+extern IndexBuildParallel* IndexVacuumParallelBegin(Relation heap, int nworkers, IndexBuildWorkerFunc workerFunc,
+    void* amstate);
+extern void IndexBuildParallelWait(IndexBuildParallel* pbuild);
+extern void IndexBuildParallelCheck(IndexBuildParallel* pbuild);
+extern double IndexBuildParallelEnd(IndexBuildParallel* pbuild, IndexInfo* indexInfo);
+extern void IndexBuildParallelAbort(IndexBuildParallel* pbuild);
+extern void IndexBuildWorkerWait(IndexBuildParallel* pbuild);
+extern void IndexBuildWorkerCheckAbort(IndexBuildParallel* pbuild);
+extern Relation IndexBuildWorkerOpen(Oid relOid, Oid parentOid, bool isIndex, Relation* parent, Partition* part);
+extern void IndexBuildWorkerClose(Relation rel, Relation parent, Partition part, bool isIndex);
+
+extern int IndexBuildWorkerAttach(void* payload);
+extern int IndexBuildWorkerMain(void* payload);
+
+#endif /* PARALLELBUILD_H */
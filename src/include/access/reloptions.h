@@ -49,8 +49,9 @@ typedef enum relopt_kind {
     RELOPT_KIND_NPARSER = (1 << 12),  /* text search configuration options defined by ngram */
     RELOPT_KIND_CBTREE = (1 << 13),
     RELOPT_KIND_PPARSER = (1 << 14), /* text search configuration options defined by pound */
+    RELOPT_KIND_BRIN = (1 << 15),
     /* if you add a new kind, make sure you update "last_default" too */
-    RELOPT_KIND_LAST_DEFAULT = RELOPT_KIND_PPARSER,
+    RELOPT_KIND_LAST_DEFAULT = RELOPT_KIND_BRIN,
     /* some compilers treat enums as signed ints, so we can't use 1 << 31 */
     RELOPT_KIND_MAX = (1 << 30)
 } relopt_kind;
@@ -254,6 +255,7 @@ extern bytea* attribute_reloptions(Datum reloptions, bool validate);
 extern bytea* tablespace_reloptions(Datum reloptions, bool validate);
 extern bytea* tsearch_config_reloptions(Datum tsoptions, bool validate, Oid prsoid, bool missing_ok);
 extern void heaprel_set_compressing_modes(Relation rel, int16* modes);
+extern void heaprel_make_compressing_modes(int8 compression, int8 compresslevel, int16* modes);
 extern int8 heaprel_get_compresslevel_from_modes(int16 modes);
 extern int8 heaprel_get_compression_from_modes(int16 modes);
 
@@ -60,3 +60,4 @@ PG_RMGR(RM_BARRIER_ID, "Barrier", barrier_redo, barrier_desc, NULL, NULL, NULL)
 #ifdef ENABLE_MOT
 PG_RMGR(RM_MOT_ID, "MOT", MOTRedo, MOTDesc, NULL, NULL, NULL)
 #endif
+PG_RMGR(RM_BRIN_ID, "BRIN", brin_redo, brin_desc, NULL, NULL, NULL)
@@ -29,7 +29,8 @@
 #define SPGIST_PICKSPLIT_PROC 3
 #define SPGIST_INNER_CONSISTENT_PROC 4
 #define SPGIST_LEAF_CONSISTENT_PROC 5
-#define SPGISTNProc 5
+#define SPGIST_SORTKEY_PROC 6
+#define SPGISTNProc 6
 
 /*
  * Argument structs for spg_config method
@@ -0,0 +1,43 @@
+/* -------------------------------------------------------------------------
+ *
+ * tidstore.h
+ *	  Compact set of heap TIDs, for the dead tuples found by vacuum.
+ *
+ *
+ * Portions Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * src/include/access/tidstore.h
+ *
+ * -------------------------------------------------------------------------
+ */
+#ifndef TIDSTORE_H
+#define TIDSTORE_H
+
+#include "storage/buf/block.h"
+#include "storage/item/itemptr.h"
+#include "storage/off.h"
+
+typedef struct TidStore TidStore;
+typedef struct TidStoreIter TidStoreIter;
+
+/* One block returned by TidStoreIterateNext, offsets in ascending order */
+typedef struct TidStoreIterResult {
+    BlockNumber blkno;
+    int noffsets;
+    OffsetNumber* offsets;
+} TidStoreIterResult;
+
+extern TidStore* TidStoreCreate(Size maxBytes);
+extern void TidStoreDestroy(TidStore* ts);
+extern void TidStoreReset(TidStore* ts);
+extern void TidStoreSetBlockOffsets(TidStore* ts, BlockNumber blkno, const OffsetNumber* offsets, int noffsets);
+extern bool TidStoreIsMember(const TidStore* ts, ItemPointer tid);
+extern bool TidStoreIsFull(const TidStore* ts);
+extern int64 TidStoreNumTids(const TidStore* ts);
+extern Size TidStoreMemoryUsage(const TidStore* ts);
+
+extern TidStoreIter* TidStoreBeginIterate(TidStore* ts);
+extern TidStoreIterResult* TidStoreIterateNext(TidStoreIter* iter);
+extern void TidStoreEndIterate(TidStoreIter* iter);
+
+#endif /* TIDSTORE_H */
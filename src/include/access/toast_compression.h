@@ -0,0 +1,39 @@
+/* -------------------------------------------------------------------------
+ *
+ * toast_compression.h
+ *	  Compression methods for compressed varlena datums.
+ *
+ *
+ * Portions Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * src/include/access/toast_compression.h
+ *
+ * -------------------------------------------------------------------------
+ */
+#ifndef TOAST_COMPRESSION_H
+#define TOAST_COMPRESSION_H
+
+/*
+ * The id of the method a datum was compressed with, kept in the top bits of
+ * its va_rawsize.  These are on disk, so never renumber them; there is room
+ * for one more.
+ */
+typedef enum ToastCompressionId {
+    TOAST_PGLZ_COMPRESSION_ID = 0,
+    TOAST_LZ4_COMPRESSION_ID = 1,
+    TOAST_ZSTD_COMPRESSION_ID = 2,
+    TOAST_INVALID_COMPRESSION_ID = 3
+} ToastCompressionId;
+
+/* shorter values are not worth compressing, whatever the method */
+#define TOAST_MIN_COMPRESS_SIZE 32
+
+extern struct varlena* toast_compress_varlena(const struct varlena* value, ToastCompressionId cmid);
+extern struct varlena* toast_decompress_varlena(const struct varlena* attr);
+extern struct varlena* toast_decompress_varlena_slice(const struct varlena* attr, int32 slicelength);
+
+extern ToastCompressionId CompressionNameToId(const char* name);
+extern const char* CompressionIdToName(ToastCompressionId cmid);
+extern void ValidateToastCompressionOption(const char* value);
+
+#endif /* TOAST_COMPRESSION_H */
@@ -128,6 +128,7 @@ typedef struct tupleDesc {
     /* attrs[N] is a pointer to the description of Attribute Number N+1 */
     TupleConstr* constr;        /* constraints, or NULL if none */
     TupInitDefVal* initdefvals; /* init default value due to ADD COLUMN */
+    uint8* attcompression;      /* toast_compression option of each column, or NULL if none has one */
     Oid tdtypeid;               /* composite type ID for tuple type */
     int32 tdtypmod;             /* typmod for tuple type */
     bool tdhasoid;              /* tuple has oid attribute in its header */
@@ -14,6 +14,7 @@
 #define TUPTOASTER_H
 
 #include "access/htup.h"
+#include "access/toast_compression.h"
 #include "utils/relcache.h"
 
 /*
@@ -100,7 +101,17 @@
  * saves space, so we expect either equality or less-than.
  */
 #define VARATT_EXTERNAL_IS_COMPRESSED(toast_pointer) \
-    ((toast_pointer).va_extsize < (toast_pointer).va_rawsize - VARHDRSZ)
+    (VARATT_EXTERNAL_GET_EXTSIZE(toast_pointer) < (toast_pointer).va_rawsize - VARHDRSZ)
+
+/*
+ * The external size and, for compressed data, the id of the compression
+ * method share va_extinfo.  Values toasted before there was a choice of
+ * methods are pglz, whose id is 0, so they read the same as before.
+ */
+#define VARATT_EXTERNAL_GET_EXTSIZE(toast_pointer) ((int32)((toast_pointer).va_extinfo & VARLENA_RAWSIZE_MASK))
+#define VARATT_EXTERNAL_GET_COMPRESSID(toast_pointer) ((uint32)(toast_pointer).va_extinfo >> VARLENA_RAWSIZE_BITS)
+#define VARATT_EXTERNAL_SET_SIZE_AND_COMPRESSID(toast_pointer, len, cmid) \
+    ((toast_pointer).va_extinfo = (int32)(((uint32)(len)) | (((uint32)(cmid)) << VARLENA_RAWSIZE_BITS)))
 
 /*
  * Macro to fetch the possibly-unaligned contents of an EXTERNAL datum
@@ -221,7 +232,23 @@ extern Datum toast_flatten_tuple_attribute(Datum value, Oid typeId, int32 typeMo
  *	Create a compressed version of a varlena datum, if possible
  * ----------
  */
-extern Datum toast_compress_datum(Datum value);
+extern Datum toast_compress_datum(Datum value, ToastCompressionId cmid);
+
+/* ----------
+ * toast_get_column_compression -
+ *
+ *	Return the compression method for new values of a column
+ * ----------
+ */
+extern ToastCompressionId toast_get_column_compression(Relation rel, int attnum);
+
+/* ----------
+ * toast_get_compression_id -
+ *
+ *	Return the compression method of a varlena datum, if it is compressed
+ * ----------
+ */
+extern ToastCompressionId toast_get_compression_id(struct varlena* attr);
 
 /* ----------
  * toast_raw_datum_size -
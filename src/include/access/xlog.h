@@ -313,6 +313,7 @@ extern void PreInitXlogFileForPrimary(int advance_xlog_file_num);
 extern XLogRecPtr XLogInsertRecord(struct XLogRecData* rdata, XLogRecPtr fpw_lsn, bool isupgrade = false);
 extern void XLogWaitFlush(XLogRecPtr recptr);
 extern void XLogWaitBufferInit(XLogRecPtr recptr);
+extern bool XLogPreInitWalBuffers(void);
 extern void UpdateMinRecoveryPoint(XLogRecPtr lsn, bool force);
 extern bool XLogBackgroundFlush(void);
 extern bool XLogNeedsFlush(XLogRecPtr RecPtr);
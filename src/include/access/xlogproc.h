@@ -736,6 +736,8 @@ void BtreeXlogSplitOperatorLeftpage(
     RedoBufferInfo* lbuf, void* recorddata, BlockNumber rightsib, bool onleft, void* blkdata, Size datalen);
 void BtreeXlogVacuumOperatorPage(RedoBufferInfo* redobuffer, void* recorddata, void* blkdata, Size len);
 void BtreeXlogDeleteOperatorPage(RedoBufferInfo* buffer, void* recorddata, Size recorddatalen);
+void BtreeXlogDedupOperatorPage(RedoBufferInfo* redobuffer, void* recorddata, void* blkdata, Size len);
+void BtreeXlogUpdatePostingOperatorPage(RedoBufferInfo* redobuffer, void* recorddata, void* blkdata, Size len);
 void btreeXlogDeletePageOperatorRightpage(RedoBufferInfo* buffer, void* recorddata);
 
 void BtreeXlogDeletePageOperatorLeftpage(RedoBufferInfo* buffer, void* recorddata);
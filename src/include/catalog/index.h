@@ -24,6 +24,7 @@
 #define CSTORE_BTREE_INDEX_TYPE "cbtree"
 #define DEFAULT_GIN_INDEX_TYPE "gin"
 #define CSTORE_GINBTREE_INDEX_TYPE "cgin"
+#define DEFAULT_BRIN_INDEX_TYPE "brin"
 
 /* Typedef for callback function for IndexBuildHeapScan */
 typedef void (*IndexBuildCallback)(Relation index, HeapTuple htup, Datum *values, const bool *isnull,
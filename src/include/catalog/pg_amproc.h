@@ -192,6 +192,7 @@ DATA(insert (	2593   603 603 4 2580 ));
 DATA(insert (	2593   603 603 5 2581 ));
 DATA(insert (	2593   603 603 6 2582 ));
 DATA(insert (	2593   603 603 7 2584 ));
+DATA(insert (	2593   603 603 9 4521 ));
 DATA(insert (	2594   604 604 1 2585 ));
 DATA(insert (	2594   604 604 2 2583 ));
 DATA(insert (	2594   604 604 3 2586 ));
@@ -199,6 +200,7 @@ DATA(insert (	2594   604 604 4 2580 ));
 DATA(insert (	2594   604 604 5 2581 ));
 DATA(insert (	2594   604 604 6 2582 ));
 DATA(insert (	2594   604 604 7 2584 ));
+DATA(insert (	2594   604 604 9 4521 ));
 DATA(insert (	2595   718 718 1 2591 ));
 DATA(insert (	2595   718 718 2 2583 ));
 DATA(insert (	2595   718 718 3 2592 ));
@@ -206,6 +208,7 @@ DATA(insert (	2595   718 718 4 2580 ));
 DATA(insert (	2595   718 718 5 2581 ));
 DATA(insert (	2595   718 718 6 2582 ));
 DATA(insert (	2595   718 718 7 2584 ));
+DATA(insert (	2595   718 718 9 4521 ));
 DATA(insert (	3655   3614 3614 1 3654 ));
 DATA(insert (	3655   3614 3614 2 3651 ));
 DATA(insert (	3655   3614 3614 3 3648 ));
@@ -228,6 +231,7 @@ DATA(insert (	1029   600 600 5 2581 ));
 DATA(insert (	1029   600 600 6 2582 ));
 DATA(insert (	1029   600 600 7 2584 ));
 DATA(insert (	1029   600 600 8 3064 ));
+DATA(insert (	1029   600 600 9 4521 ));
 
 
 /* gin */
@@ -413,11 +417,13 @@ DATA(insert (	4015   600 600 2 4019 ));
 DATA(insert (	4015   600 600 3 4020 ));
 DATA(insert (	4015   600 600 4 4021 ));
 DATA(insert (	4015   600 600 5 4022 ));
+DATA(insert (	4015   600 600 6 4522 ));
 DATA(insert (	4016   600 600 1 4023 ));
 DATA(insert (	4016   600 600 2 4024 ));
 DATA(insert (	4016   600 600 3 4025 ));
 DATA(insert (	4016   600 600 4 4026 ));
 DATA(insert (	4016   600 600 5 4022 ));
+DATA(insert (	4016   600 600 6 4522 ));
 DATA(insert (	4017   25 25 1 4027 ));
 DATA(insert (	4017   25 25 2 4028 ));
 DATA(insert (	4017   25 25 3 4029 ));
@@ -498,4 +504,96 @@ DATA(insert (	4262	5545	5545	1	5519));
 DATA(insert (	4263	  16	  16	1	1693));
 DATA(insert (	4264	9003	9003	1	5586));
 
+/* brin minmax */
+DATA(insert (	4472	  21	  21	1	4509));
+DATA(insert (	4472	  21	  21	2	4510));
+DATA(insert (	4472	  21	  21	3	4511));
+DATA(insert (	4472	  21	  21	4	4512));
+DATA(insert (	4472	  23	  23	1	4509));
+DATA(insert (	4472	  23	  23	2	4510));
+DATA(insert (	4472	  23	  23	3	4511));
+DATA(insert (	4472	  23	  23	4	4512));
+DATA(insert (	4472	  20	  20	1	4509));
+DATA(insert (	4472	  20	  20	2	4510));
+DATA(insert (	4472	  20	  20	3	4511));
+DATA(insert (	4472	  20	  20	4	4512));
+DATA(insert (	4473	  26	  26	1	4509));
+DATA(insert (	4473	  26	  26	2	4510));
+DATA(insert (	4473	  26	  26	3	4511));
+DATA(insert (	4473	  26	  26	4	4512));
+DATA(insert (	4474	1082	1082	1	4509));
+DATA(insert (	4474	1082	1082	2	4510));
+DATA(insert (	4474	1082	1082	3	4511));
+DATA(insert (	4474	1082	1082	4	4512));
+DATA(insert (	4474	1114	1114	1	4509));
+DATA(insert (	4474	1114	1114	2	4510));
+DATA(insert (	4474	1114	1114	3	4511));
+DATA(insert (	4474	1114	1114	4	4512));
+DATA(insert (	4474	1184	1184	1	4509));
+DATA(insert (	4474	1184	1184	2	4510));
+DATA(insert (	4474	1184	1184	3	4511));
+DATA(insert (	4474	1184	1184	4	4512));
+DATA(insert (	4475	 700	 700	1	4509));
+DATA(insert (	4475	 700	 700	2	4510));
+DATA(insert (	4475	 700	 700	3	4511));
+DATA(insert (	4475	 700	 700	4	4512));
+DATA(insert (	4475	 701	 701	1	4509));
+DATA(insert (	4475	 701	 701	2	4510));
+DATA(insert (	4475	 701	 701	3	4511));
+DATA(insert (	4475	 701	 701	4	4512));
+DATA(insert (	4476	1700	1700	1	4509));
+DATA(insert (	4476	1700	1700	2	4510));
+DATA(insert (	4476	1700	1700	3	4511));
+DATA(insert (	4476	1700	1700	4	4512));
+DATA(insert (	4477	  25	  25	1	4509));
+DATA(insert (	4477	  25	  25	2	4510));
+DATA(insert (	4477	  25	  25	3	4511));
+DATA(insert (	4477	  25	  25	4	4512));
+DATA(insert (	4478	1042	1042	1	4509));
+DATA(insert (	4478	1042	1042	2	4510));
+DATA(insert (	4478	1042	1042	3	4511));
+DATA(insert (	4478	1042	1042	4	4512));
+DATA(insert (	4479	1083	1083	1	4509));
+DATA(insert (	4479	1083	1083	2	4510));
+DATA(insert (	4479	1083	1083	3	4511));
+DATA(insert (	4479	1083	1083	4	4512));
+DATA(insert (	4480	1266	1266	1	4509));
+DATA(insert (	4480	1266	1266	2	4510));
+DATA(insert (	4480	1266	1266	3	4511));
+DATA(insert (	4480	1266	1266	4	4512));
+DATA(insert (	4481	1186	1186	1	4509));
+DATA(insert (	4481	1186	1186	2	4510));
+DATA(insert (	4481	1186	1186	3	4511));
+DATA(insert (	4481	1186	1186	4	4512));
+DATA(insert (	4482	5545	5545	1	4509));
+DATA(insert (	4482	5545	5545	2	4510));
+DATA(insert (	4482	5545	5545	3	4511));
+DATA(insert (	4482	5545	5545	4	4512));
+DATA(insert (	4483	9003	9003	1	4509));
+DATA(insert (	4483	9003	9003	2	4510));
+DATA(insert (	4483	9003	9003	3	4511));
+DATA(insert (	4483	9003	9003	4	4512));
+
+/* brin bloom */
+DATA(insert (	4484	  21	  21	1	4513));
+DATA(insert (	4484	  21	  21	2	4514));
+DATA(insert (	4484	  21	  21	3	4515));
+DATA(insert (	4484	  21	  21	4	4516));
+DATA(insert (	4484	  21	  21	5	449));
+DATA(insert (	4484	  23	  23	1	4513));
+DATA(insert (	4484	  23	  23	2	4514));
+DATA(insert (	4484	  23	  23	3	4515));
+DATA(insert (	4484	  23	  23	4	4516));
+DATA(insert (	4484	  23	  23	5	450));
+DATA(insert (	4484	  20	  20	1	4513));
+DATA(insert (	4484	  20	  20	2	4514));
+DATA(insert (	4484	  20	  20	3	4515));
+DATA(insert (	4484	  20	  20	4	4516));
+DATA(insert (	4484	  20	  20	5	949));
+DATA(insert (	4485	  25	  25	1	4513));
+DATA(insert (	4485	  25	  25	2	4514));
+DATA(insert (	4485	  25	  25	3	4515));
+DATA(insert (	4485	  25	  25	4	4516));
+DATA(insert (	4485	  25	  25	5	400));
+
 #endif   /* PG_AMPROC_H */
@@ -312,6 +312,29 @@ DATA(insert ( 4239    int1_ops         PGNSP    PGUID  4262  5545    t    0));
 DATA(insert ( 4239    bool_ops         PGNSP    PGUID  4263    16    t    0));
 DATA(insert ( 4239    smalldatetime_ops  PGNSP  PGUID  4264  9003    t    0));
 
+/* brin */
+DATA(insert ( 4471    int4_minmax_ops          PGNSP    PGUID  4472    23    t    0));
+DATA(insert ( 4471    int2_minmax_ops          PGNSP    PGUID  4472    21    t    0));
+DATA(insert ( 4471    int8_minmax_ops          PGNSP    PGUID  4472    20    t    0));
+DATA(insert ( 4471    oid_minmax_ops           PGNSP    PGUID  4473    26    t    0));
+DATA(insert ( 4471    date_minmax_ops          PGNSP    PGUID  4474  1082    t    0));
+DATA(insert ( 4471    timestamp_minmax_ops     PGNSP    PGUID  4474  1114    t    0));
+DATA(insert ( 4471    timestamptz_minmax_ops   PGNSP    PGUID  4474  1184    t    0));
+DATA(insert ( 4471    float4_minmax_ops        PGNSP    PGUID  4475   700    t    0));
+DATA(insert ( 4471    float8_minmax_ops        PGNSP    PGUID  4475   701    t    0));
+DATA(insert ( 4471    numeric_minmax_ops       PGNSP    PGUID  4476  1700    t    0));
+DATA(insert ( 4471    text_minmax_ops          PGNSP    PGUID  4477    25    t    0));
+DATA(insert ( 4471    bpchar_minmax_ops        PGNSP    PGUID  4478  1042    t    0));
+DATA(insert ( 4471    time_minmax_ops          PGNSP    PGUID  4479  1083    t    0));
+DATA(insert ( 4471    timetz_minmax_ops        PGNSP    PGUID  4480  1266    t    0));
+DATA(insert ( 4471    interval_minmax_ops      PGNSP    PGUID  4481  1186    t    0));
+DATA(insert ( 4471    int1_minmax_ops          PGNSP    PGUID  4482  5545    t    0));
+DATA(insert ( 4471    smalldatetime_minmax_ops PGNSP    PGUID  4483  9003    t    0));
+DATA(insert ( 4471    int4_bloom_ops           PGNSP    PGUID  4484    23    f    0));
+DATA(insert ( 4471    int2_bloom_ops           PGNSP    PGUID  4484    21    f    0));
+DATA(insert ( 4471    int8_bloom_ops           PGNSP    PGUID  4484    20    f    0));
+DATA(insert ( 4471    text_bloom_ops           PGNSP    PGUID  4485    25    f    0));
+
 /* encrypted column operators */
 DATA(insert ( 403     byteawithoutorderwithequalcol_ops PGNSP PGUID  436  4402 t 0 ));
 DATA(insert ( 405     byteawithoutorderwithequalcol_ops PGNSP PGUID 4470 4402 t 0 ));
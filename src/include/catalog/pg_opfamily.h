@@ -193,5 +193,21 @@ DATA(insert OID = 4262 (4239    int1_ops         PGNSP    PGUID));
 DATA(insert OID = 4263 (4239    bool_ops         PGNSP    PGUID));
 DATA(insert OID = 4264 (4239    smalldatetime_ops  PGNSP  PGUID));
 
+/* brin */
+DATA(insert OID = 4472 (4471    integer_minmax_ops       PGNSP    PGUID));
+DATA(insert OID = 4473 (4471    oid_minmax_ops           PGNSP    PGUID));
+DATA(insert OID = 4474 (4471    datetime_minmax_ops      PGNSP    PGUID));
+DATA(insert OID = 4475 (4471    float_minmax_ops         PGNSP    PGUID));
+DATA(insert OID = 4476 (4471    numeric_minmax_ops       PGNSP    PGUID));
+DATA(insert OID = 4477 (4471    text_minmax_ops          PGNSP    PGUID));
+DATA(insert OID = 4478 (4471    bpchar_minmax_ops        PGNSP    PGUID));
+DATA(insert OID = 4479 (4471    time_minmax_ops          PGNSP    PGUID));
+DATA(insert OID = 4480 (4471    timetz_minmax_ops        PGNSP    PGUID));
+DATA(insert OID = 4481 (4471    interval_minmax_ops      PGNSP    PGUID));
+DATA(insert OID = 4482 (4471    int1_minmax_ops          PGNSP    PGUID));
+DATA(insert OID = 4483 (4471    smalldatetime_minmax_ops PGNSP    PGUID));
+DATA(insert OID = 4484 (4471    integer_bloom_ops        PGNSP    PGUID));
+DATA(insert OID = 4485 (4471    text_bloom_ops           PGNSP    PGUID));
+
 #endif   /* PG_OPFAMILY_H */
 
@@ -277,5 +277,14 @@ typedef FormData_pg_statistic *Form_pg_statistic;
  */
 #define STATISTIC_KIND_DECHIST    5
 
+/*
+ * A "HyperLogLog" slot appears only in the partition-level ('p') rows kept by
+ * incremental ANALYZE of a partitioned table.  stanumbers holds the registers
+ * of a HyperLogLog sketch of the distinct values in the partition's sample,
+ * so that the overlap between partitions can be estimated when their
+ * statistics are merged.  staop and stavalues are not used.
+ */
+#define STATISTIC_KIND_HLL    10002
+
 #endif   /* PG_STATISTIC_H */
 
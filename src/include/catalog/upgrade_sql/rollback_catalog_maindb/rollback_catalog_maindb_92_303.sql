@@ -0,0 +1,48 @@
+DO $DO$
+DECLARE
+  ans boolean;
+BEGIN
+  select case when count(*)=1 then true else false end as ans from (select amname from pg_am where oid = 4471 limit 1) into ans;
+  if ans = true then
+    DROP OPERATOR FAMILY IF EXISTS pg_catalog.integer_minmax_ops USING brin CASCADE;
+    DROP OPERATOR FAMILY IF EXISTS pg_catalog.oid_minmax_ops USING brin CASCADE;
+    DROP OPERATOR FAMILY IF EXISTS pg_catalog.datetime_minmax_ops USING brin CASCADE;
+    DROP OPERATOR FAMILY IF EXISTS pg_catalog.float_minmax_ops USING brin CASCADE;
+    DROP OPERATOR FAMILY IF EXISTS pg_catalog.numeric_minmax_ops USING brin CASCADE;
+    DROP OPERATOR FAMILY IF EXISTS pg_catalog.text_minmax_ops USING brin CASCADE;
+    DROP OPERATOR FAMILY IF EXISTS pg_catalog.bpchar_minmax_ops USING brin CASCADE;
+    DROP OPERATOR FAMILY IF EXISTS pg_catalog.time_minmax_ops USING brin CASCADE;
+    DROP OPERATOR FAMILY IF EXISTS pg_catalog.timetz_minmax_ops USING brin CASCADE;
+    DROP OPERATOR FAMILY IF EXISTS pg_catalog.interval_minmax_ops USING brin CASCADE;
+    DROP OPERATOR FAMILY IF EXISTS pg_catalog.int1_minmax_ops USING brin CASCADE;
+    DROP OPERATOR FAMILY IF EXISTS pg_catalog.smalldatetime_minmax_ops USING brin CASCADE;
+    DROP OPERATOR FAMILY IF EXISTS pg_catalog.integer_bloom_ops USING brin CASCADE;
+    DROP OPERATOR FAMILY IF EXISTS pg_catalog.text_bloom_ops USING brin CASCADE;
+  end if;
+END$DO$;
+
+DELETE FROM pg_catalog.pg_am WHERE oid = 4471;
+
+DROP FUNCTION IF EXISTS pg_catalog.brinbeginscan(internal, internal, internal) CASCADE;
+DROP FUNCTION IF EXISTS pg_catalog.brinbuild(internal, internal, internal) CASCADE;
+DROP FUNCTION IF EXISTS pg_catalog.brinbuildempty(internal) CASCADE;
+DROP FUNCTION IF EXISTS pg_catalog.brinbulkdelete(internal, internal, internal, internal) CASCADE;
+DROP FUNCTION IF EXISTS pg_catalog.brincostestimate(internal, internal, internal, internal, internal, internal, internal) CASCADE;
+DROP FUNCTION IF EXISTS pg_catalog.brinendscan(internal) CASCADE;
+DROP FUNCTION IF EXISTS pg_catalog.bringetbitmap(internal, internal) CASCADE;
+DROP FUNCTION IF EXISTS pg_catalog.brininsert(internal, internal, internal, internal, internal, internal) CASCADE;
+DROP FUNCTION IF EXISTS pg_catalog.brinmarkpos(internal) CASCADE;
+DROP FUNCTION IF EXISTS pg_catalog.brinmerge(internal, internal, internal, internal, internal) CASCADE;
+DROP FUNCTION IF EXISTS pg_catalog.brinoptions(text[], bool) CASCADE;
+DROP FUNCTION IF EXISTS pg_catalog.brinrescan(internal, internal, internal, internal, internal) CASCADE;
+DROP FUNCTION IF EXISTS pg_catalog.brinrestrpos(internal) CASCADE;
+DROP FUNCTION IF EXISTS pg_catalog.brinvacuumcleanup(internal, internal) CASCADE;
+DROP FUNCTION IF EXISTS pg_catalog.brin_minmax_opcinfo(internal) CASCADE;
+DROP FUNCTION IF EXISTS pg_catalog.brin_minmax_add_value(internal, internal, internal) CASCADE;
+DROP FUNCTION IF EXISTS pg_catalog.brin_minmax_consistent(internal, internal, internal) CASCADE;
+DROP FUNCTION IF EXISTS pg_catalog.brin_minmax_union(internal, internal, internal) CASCADE;
+DROP FUNCTION IF EXISTS pg_catalog.brin_bloom_opcinfo(internal) CASCADE;
+DROP FUNCTION IF EXISTS pg_catalog.brin_bloom_add_value(internal, internal, internal) CASCADE;
+DROP FUNCTION IF EXISTS pg_catalog.brin_bloom_consistent(internal, internal, internal) CASCADE;
+DROP FUNCTION IF EXISTS pg_catalog.brin_bloom_union(internal, internal, internal) CASCADE;
+DROP FUNCTION IF EXISTS pg_catalog.brin_summarize_new_values(regclass) CASCADE;
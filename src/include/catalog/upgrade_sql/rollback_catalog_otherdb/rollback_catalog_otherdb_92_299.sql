@@ -0,0 +1,2 @@
+DROP FUNCTION IF EXISTS pg_catalog.gs_auto_param_stat() CASCADE;
+DROP FUNCTION IF EXISTS pg_catalog.gs_wal_insert_latency() CASCADE;
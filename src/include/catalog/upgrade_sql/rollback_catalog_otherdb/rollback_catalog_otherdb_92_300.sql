@@ -0,0 +1,2 @@
+DROP FUNCTION IF EXISTS pg_catalog.gs_btree_bottomup_stat() CASCADE;
+DROP FUNCTION IF EXISTS pg_catalog.mot_table_contention_detail() CASCADE;
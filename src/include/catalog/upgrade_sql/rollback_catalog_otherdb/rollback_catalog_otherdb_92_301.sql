@@ -0,0 +1,5 @@
+DROP FUNCTION IF EXISTS pg_catalog.gist_box_sortkey(box) CASCADE;
+DROP FUNCTION IF EXISTS pg_catalog.spg_point_sortkey(point) CASCADE;
+
+UPDATE pg_catalog.pg_am SET amsupport = 8 WHERE oid = 783;
+UPDATE pg_catalog.pg_am SET amsupport = 5 WHERE oid = 4000;
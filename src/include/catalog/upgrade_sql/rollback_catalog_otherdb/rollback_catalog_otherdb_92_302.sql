@@ -0,0 +1 @@
+DROP FUNCTION IF EXISTS pg_catalog.pg_column_compression("any") CASCADE;
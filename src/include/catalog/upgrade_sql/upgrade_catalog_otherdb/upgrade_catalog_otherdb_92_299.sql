@@ -0,0 +1,26 @@
+-- ----------------------------------------------------------------
+-- gs_auto_param_stat for automatic parameterization
+-- ----------------------------------------------------------------
+DROP FUNCTION IF EXISTS pg_catalog.gs_auto_param_stat() CASCADE;
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 4406;
+CREATE OR REPLACE FUNCTION pg_catalog.gs_auto_param_stat
+(out calls pg_catalog.int8,
+out rejected pg_catalog.int8,
+out hits pg_catalog.int8,
+out gpc_hits pg_catalog.int8,
+out misses pg_catalog.int8,
+out evictions pg_catalog.int8,
+out cached_statements pg_catalog.int8,
+out hit_ratio pg_catalog.float8)
+RETURNS record LANGUAGE INTERNAL VOLATILE STRICT as 'gs_auto_param_stat';
+
+-- ----------------------------------------------------------------
+-- gs_wal_insert_latency for WAL insert latency tracking
+-- ----------------------------------------------------------------
+DROP FUNCTION IF EXISTS pg_catalog.gs_wal_insert_latency() CASCADE;
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 4407;
+CREATE OR REPLACE FUNCTION pg_catalog.gs_wal_insert_latency
+(out lower_us pg_catalog.int8,
+out upper_us pg_catalog.int8,
+out calls pg_catalog.int8)
+RETURNS SETOF record LANGUAGE INTERNAL VOLATILE STRICT as 'gs_wal_insert_latency';
@@ -0,0 +1,25 @@
+-- ----------------------------------------------------------------
+-- gs_btree_bottomup_stat for bottom-up B-tree deletion
+-- ----------------------------------------------------------------
+DROP FUNCTION IF EXISTS pg_catalog.gs_btree_bottomup_stat() CASCADE;
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 4408;
+CREATE OR REPLACE FUNCTION pg_catalog.gs_btree_bottomup_stat
+(out passes pg_catalog.int8,
+out heap_blocks pg_catalog.int8,
+out deleted_tids pg_catalog.int8,
+out splits_avoided pg_catalog.int8)
+RETURNS record LANGUAGE INTERNAL VOLATILE STRICT as 'gs_btree_bottomup_stat';
+
+-- ----------------------------------------------------------------
+-- mot_table_contention_detail for MOT hot row locking
+-- ----------------------------------------------------------------
+DROP FUNCTION IF EXISTS pg_catalog.mot_table_contention_detail() CASCADE;
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 4409;
+CREATE OR REPLACE FUNCTION pg_catalog.mot_table_contention_detail
+(out relid pg_catalog.oid,
+out relname pg_catalog.text,
+out conflicts pg_catalog.int8,
+out hot_rows pg_catalog.int8,
+out hot_row_locks pg_catalog.int8,
+out hot_row_lock_timeouts pg_catalog.int8)
+RETURNS SETOF record LANGUAGE INTERNAL VOLATILE STRICT as 'mot_table_contention_detail';
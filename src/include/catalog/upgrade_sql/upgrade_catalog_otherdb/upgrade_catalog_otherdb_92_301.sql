@@ -0,0 +1,20 @@
+-- ----------------------------------------------------------------
+-- sort key support functions for sorted GiST and SP-GiST builds
+-- ----------------------------------------------------------------
+UPDATE pg_catalog.pg_am SET amsupport = 9 WHERE oid = 783 AND amsupport < 9;
+UPDATE pg_catalog.pg_am SET amsupport = 6 WHERE oid = 4000 AND amsupport < 6;
+
+DROP FUNCTION IF EXISTS pg_catalog.gist_box_sortkey(box) CASCADE;
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 4521;
+CREATE FUNCTION pg_catalog.gist_box_sortkey(box) RETURNS int8 LANGUAGE INTERNAL IMMUTABLE STRICT as 'gist_box_sortkey';
+
+DROP FUNCTION IF EXISTS pg_catalog.spg_point_sortkey(point) CASCADE;
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 4522;
+CREATE FUNCTION pg_catalog.spg_point_sortkey(point) RETURNS int8 LANGUAGE INTERNAL IMMUTABLE STRICT as 'spg_point_sortkey';
+
+ALTER OPERATOR FAMILY pg_catalog.box_ops USING gist ADD FUNCTION 9 (box, box) pg_catalog.gist_box_sortkey(box);
+ALTER OPERATOR FAMILY pg_catalog.poly_ops USING gist ADD FUNCTION 9 (polygon, polygon) pg_catalog.gist_box_sortkey(box);
+ALTER OPERATOR FAMILY pg_catalog.circle_ops USING gist ADD FUNCTION 9 (circle, circle) pg_catalog.gist_box_sortkey(box);
+ALTER OPERATOR FAMILY pg_catalog.point_ops USING gist ADD FUNCTION 9 (point, point) pg_catalog.gist_box_sortkey(box);
+ALTER OPERATOR FAMILY pg_catalog.quad_point_ops USING spgist ADD FUNCTION 6 (point, point) pg_catalog.spg_point_sortkey(point);
+ALTER OPERATOR FAMILY pg_catalog.kd_point_ops USING spgist ADD FUNCTION 6 (point, point) pg_catalog.spg_point_sortkey(point);
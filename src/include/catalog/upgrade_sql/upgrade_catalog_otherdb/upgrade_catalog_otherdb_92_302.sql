@@ -0,0 +1,6 @@
+-- ----------------------------------------------------------------
+-- pg_column_compression for lz4 and zstd TOAST compression
+-- ----------------------------------------------------------------
+DROP FUNCTION IF EXISTS pg_catalog.pg_column_compression("any") CASCADE;
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 4518;
+CREATE FUNCTION pg_catalog.pg_column_compression("any") RETURNS text LANGUAGE INTERNAL STABLE STRICT as 'pg_column_compression';
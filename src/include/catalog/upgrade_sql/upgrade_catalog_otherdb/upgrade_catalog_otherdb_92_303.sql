@@ -0,0 +1,487 @@
+-- ----------------------------------------------------------------
+-- brin index access method
+-- ----------------------------------------------------------------
+DROP FUNCTION IF EXISTS pg_catalog.brinbeginscan(internal, internal, internal) CASCADE;
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 4486;
+CREATE FUNCTION pg_catalog.brinbeginscan(internal, internal, internal) RETURNS internal LANGUAGE INTERNAL VOLATILE STRICT as 'brinbeginscan';
+
+DROP FUNCTION IF EXISTS pg_catalog.brinbuild(internal, internal, internal) CASCADE;
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 4487;
+CREATE FUNCTION pg_catalog.brinbuild(internal, internal, internal) RETURNS internal LANGUAGE INTERNAL VOLATILE STRICT as 'brinbuild';
+
+DROP FUNCTION IF EXISTS pg_catalog.brinbuildempty(internal) CASCADE;
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 4488;
+CREATE FUNCTION pg_catalog.brinbuildempty(internal) RETURNS void LANGUAGE INTERNAL VOLATILE STRICT as 'brinbuildempty';
+
+DROP FUNCTION IF EXISTS pg_catalog.brinbulkdelete(internal, internal, internal, internal) CASCADE;
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 4489;
+CREATE FUNCTION pg_catalog.brinbulkdelete(internal, internal, internal, internal) RETURNS internal LANGUAGE INTERNAL VOLATILE STRICT as 'brinbulkdelete';
+
+DROP FUNCTION IF EXISTS pg_catalog.brincostestimate(internal, internal, internal, internal, internal, internal, internal) CASCADE;
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 4490;
+CREATE FUNCTION pg_catalog.brincostestimate(internal, internal, internal, internal, internal, internal, internal) RETURNS void LANGUAGE INTERNAL VOLATILE STRICT as 'brincostestimate';
+
+DROP FUNCTION IF EXISTS pg_catalog.brinendscan(internal) CASCADE;
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 4491;
+CREATE FUNCTION pg_catalog.brinendscan(internal) RETURNS void LANGUAGE INTERNAL VOLATILE STRICT as 'brinendscan';
+
+DROP FUNCTION IF EXISTS pg_catalog.bringetbitmap(internal, internal) CASCADE;
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 4492;
+CREATE FUNCTION pg_catalog.bringetbitmap(internal, internal) RETURNS int8 LANGUAGE INTERNAL VOLATILE STRICT as 'bringetbitmap';
+
+DROP FUNCTION IF EXISTS pg_catalog.brininsert(internal, internal, internal, internal, internal, internal) CASCADE;
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 4493;
+CREATE FUNCTION pg_catalog.brininsert(internal, internal, internal, internal, internal, internal) RETURNS bool LANGUAGE INTERNAL VOLATILE STRICT as 'brininsert';
+
+DROP FUNCTION IF EXISTS pg_catalog.brinmarkpos(internal) CASCADE;
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 4494;
+CREATE FUNCTION pg_catalog.brinmarkpos(internal) RETURNS void LANGUAGE INTERNAL VOLATILE STRICT as 'brinmarkpos';
+
+DROP FUNCTION IF EXISTS pg_catalog.brinmerge(internal, internal, internal, internal, internal) CASCADE;
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 4495;
+CREATE FUNCTION pg_catalog.brinmerge(internal, internal, internal, internal, internal) RETURNS internal LANGUAGE INTERNAL VOLATILE STRICT as 'brinmerge';
+
+DROP FUNCTION IF EXISTS pg_catalog.brinoptions(text[], bool) CASCADE;
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 4496;
+CREATE FUNCTION pg_catalog.brinoptions(text[], bool) RETURNS bytea LANGUAGE INTERNAL STABLE STRICT as 'brinoptions';
+
+DROP FUNCTION IF EXISTS pg_catalog.brinrescan(internal, internal, internal, internal, internal) CASCADE;
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 4497;
+CREATE FUNCTION pg_catalog.brinrescan(internal, internal, internal, internal, internal) RETURNS void LANGUAGE INTERNAL VOLATILE STRICT as 'brinrescan';
+
+DROP FUNCTION IF EXISTS pg_catalog.brinrestrpos(internal) CASCADE;
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 4498;
+CREATE FUNCTION pg_catalog.brinrestrpos(internal) RETURNS void LANGUAGE INTERNAL VOLATILE STRICT as 'brinrestrpos';
+
+DROP FUNCTION IF EXISTS pg_catalog.brinvacuumcleanup(internal, internal) CASCADE;
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 4499;
+CREATE FUNCTION pg_catalog.brinvacuumcleanup(internal, internal) RETURNS internal LANGUAGE INTERNAL VOLATILE STRICT as 'brinvacuumcleanup';
+
+DROP FUNCTION IF EXISTS pg_catalog.brin_minmax_opcinfo(internal) CASCADE;
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 4509;
+CREATE FUNCTION pg_catalog.brin_minmax_opcinfo(internal) RETURNS internal LANGUAGE INTERNAL VOLATILE STRICT as 'brin_minmax_opcinfo';
+
+DROP FUNCTION IF EXISTS pg_catalog.brin_minmax_add_value(internal, internal, internal) CASCADE;
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 4510;
+CREATE FUNCTION pg_catalog.brin_minmax_add_value(internal, internal, internal) RETURNS bool LANGUAGE INTERNAL VOLATILE STRICT as 'brin_minmax_add_value';
+
+DROP FUNCTION IF EXISTS pg_catalog.brin_minmax_consistent(internal, internal, internal) CASCADE;
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 4511;
+CREATE FUNCTION pg_catalog.brin_minmax_consistent(internal, internal, internal) RETURNS bool LANGUAGE INTERNAL VOLATILE STRICT as 'brin_minmax_consistent';
+
+DROP FUNCTION IF EXISTS pg_catalog.brin_minmax_union(internal, internal, internal) CASCADE;
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 4512;
+CREATE FUNCTION pg_catalog.brin_minmax_union(internal, internal, internal) RETURNS void LANGUAGE INTERNAL VOLATILE STRICT as 'brin_minmax_union';
+
+DROP FUNCTION IF EXISTS pg_catalog.brin_bloom_opcinfo(internal) CASCADE;
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 4513;
+CREATE FUNCTION pg_catalog.brin_bloom_opcinfo(internal) RETURNS internal LANGUAGE INTERNAL VOLATILE STRICT as 'brin_bloom_opcinfo';
+
+DROP FUNCTION IF EXISTS pg_catalog.brin_bloom_add_value(internal, internal, internal) CASCADE;
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 4514;
+CREATE FUNCTION pg_catalog.brin_bloom_add_value(internal, internal, internal) RETURNS bool LANGUAGE INTERNAL VOLATILE STRICT as 'brin_bloom_add_value';
+
+DROP FUNCTION IF EXISTS pg_catalog.brin_bloom_consistent(internal, internal, internal) CASCADE;
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 4515;
+CREATE FUNCTION pg_catalog.brin_bloom_consistent(internal, internal, internal) RETURNS bool LANGUAGE INTERNAL VOLATILE STRICT as 'brin_bloom_consistent';
+
+DROP FUNCTION IF EXISTS pg_catalog.brin_bloom_union(internal, internal, internal) CASCADE;
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 4516;
+CREATE FUNCTION pg_catalog.brin_bloom_union(internal, internal, internal) RETURNS void LANGUAGE INTERNAL VOLATILE STRICT as 'brin_bloom_union';
+
+DROP FUNCTION IF EXISTS pg_catalog.brin_summarize_new_values(regclass) CASCADE;
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 4517;
+CREATE FUNCTION pg_catalog.brin_summarize_new_values(regclass) RETURNS int4 LANGUAGE INTERNAL VOLATILE STRICT as 'brin_summarize_new_values';
+
+DO $DO$
+DECLARE
+  ans boolean;
+BEGIN
+  select case when count(*)=1 then true else false end as ans from (select amname from pg_am where oid = 4471 limit 1) into ans;
+  if ans = true then
+    DROP OPERATOR FAMILY IF EXISTS pg_catalog.integer_minmax_ops USING brin CASCADE;
+    DROP OPERATOR FAMILY IF EXISTS pg_catalog.oid_minmax_ops USING brin CASCADE;
+    DROP OPERATOR FAMILY IF EXISTS pg_catalog.datetime_minmax_ops USING brin CASCADE;
+    DROP OPERATOR FAMILY IF EXISTS pg_catalog.float_minmax_ops USING brin CASCADE;
+    DROP OPERATOR FAMILY IF EXISTS pg_catalog.numeric_minmax_ops USING brin CASCADE;
+    DROP OPERATOR FAMILY IF EXISTS pg_catalog.text_minmax_ops USING brin CASCADE;
+    DROP OPERATOR FAMILY IF EXISTS pg_catalog.bpchar_minmax_ops USING brin CASCADE;
+    DROP OPERATOR FAMILY IF EXISTS pg_catalog.time_minmax_ops USING brin CASCADE;
+    DROP OPERATOR FAMILY IF EXISTS pg_catalog.timetz_minmax_ops USING brin CASCADE;
+    DROP OPERATOR FAMILY IF EXISTS pg_catalog.interval_minmax_ops USING brin CASCADE;
+    DROP OPERATOR FAMILY IF EXISTS pg_catalog.int1_minmax_ops USING brin CASCADE;
+    DROP OPERATOR FAMILY IF EXISTS pg_catalog.smalldatetime_minmax_ops USING brin CASCADE;
+    DROP OPERATOR FAMILY IF EXISTS pg_catalog.integer_bloom_ops USING brin CASCADE;
+    DROP OPERATOR FAMILY IF EXISTS pg_catalog.text_bloom_ops USING brin CASCADE;
+  end if;
+END$DO$;
+
+DELETE FROM pg_catalog.pg_am WHERE oid = 4471;
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_GENERAL, 4471;
+INSERT INTO pg_catalog.pg_am VALUES ('brin', 0, 5, false, false, false, false, true, true, false, true, false, false, false, 0, 'brininsert', 'brinbeginscan', '-', 'bringetbitmap', 'brinrescan', 'brinendscan', 'brinmarkpos', 'brinrestrpos', 'brinmerge', 'brinbuild', 'brinbuildempty', 'brinbulkdelete', 'brinvacuumcleanup', '-', 'brincostestimate', 'brinoptions');
+
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_GENERAL, 4472;
+CREATE OPERATOR FAMILY pg_catalog.integer_minmax_ops USING brin;
+
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_GENERAL, 4473;
+CREATE OPERATOR FAMILY pg_catalog.oid_minmax_ops USING brin;
+
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_GENERAL, 4474;
+CREATE OPERATOR FAMILY pg_catalog.datetime_minmax_ops USING brin;
+
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_GENERAL, 4475;
+CREATE OPERATOR FAMILY pg_catalog.float_minmax_ops USING brin;
+
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_GENERAL, 4476;
+CREATE OPERATOR FAMILY pg_catalog.numeric_minmax_ops USING brin;
+
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_GENERAL, 4477;
+CREATE OPERATOR FAMILY pg_catalog.text_minmax_ops USING brin;
+
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_GENERAL, 4478;
+CREATE OPERATOR FAMILY pg_catalog.bpchar_minmax_ops USING brin;
+
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_GENERAL, 4479;
+CREATE OPERATOR FAMILY pg_catalog.time_minmax_ops USING brin;
+
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_GENERAL, 4480;
+CREATE OPERATOR FAMILY pg_catalog.timetz_minmax_ops USING brin;
+
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_GENERAL, 4481;
+CREATE OPERATOR FAMILY pg_catalog.interval_minmax_ops USING brin;
+
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_GENERAL, 4482;
+CREATE OPERATOR FAMILY pg_catalog.int1_minmax_ops USING brin;
+
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_GENERAL, 4483;
+CREATE OPERATOR FAMILY pg_catalog.smalldatetime_minmax_ops USING brin;
+
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_GENERAL, 4484;
+CREATE OPERATOR FAMILY pg_catalog.integer_bloom_ops USING brin;
+
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_GENERAL, 4485;
+CREATE OPERATOR FAMILY pg_catalog.text_bloom_ops USING brin;
+
+CREATE OPERATOR CLASS pg_catalog.int4_minmax_ops DEFAULT
+   FOR TYPE int4 USING brin FAMILY pg_catalog.integer_minmax_ops AS
+   OPERATOR 1 pg_catalog.<(int4, int4),
+   OPERATOR 2 pg_catalog.<=(int4, int4),
+   OPERATOR 3 pg_catalog.=(int4, int4),
+   OPERATOR 4 pg_catalog.>=(int4, int4),
+   OPERATOR 5 pg_catalog.>(int4, int4),
+   FUNCTION 1 (int4, int4) pg_catalog.brin_minmax_opcinfo(internal),
+   FUNCTION 2 (int4, int4) pg_catalog.brin_minmax_add_value(internal, internal, internal),
+   FUNCTION 3 (int4, int4) pg_catalog.brin_minmax_consistent(internal, internal, internal),
+   FUNCTION 4 (int4, int4) pg_catalog.brin_minmax_union(internal, internal, internal);
+
+CREATE OPERATOR CLASS pg_catalog.int2_minmax_ops DEFAULT
+   FOR TYPE int2 USING brin FAMILY pg_catalog.integer_minmax_ops AS
+   OPERATOR 1 pg_catalog.<(int2, int2),
+   OPERATOR 2 pg_catalog.<=(int2, int2),
+   OPERATOR 3 pg_catalog.=(int2, int2),
+   OPERATOR 4 pg_catalog.>=(int2, int2),
+   OPERATOR 5 pg_catalog.>(int2, int2),
+   FUNCTION 1 (int2, int2) pg_catalog.brin_minmax_opcinfo(internal),
+   FUNCTION 2 (int2, int2) pg_catalog.brin_minmax_add_value(internal, internal, internal),
+   FUNCTION 3 (int2, int2) pg_catalog.brin_minmax_consistent(internal, internal, internal),
+   FUNCTION 4 (int2, int2) pg_catalog.brin_minmax_union(internal, internal, internal);
+
+CREATE OPERATOR CLASS pg_catalog.int8_minmax_ops DEFAULT
+   FOR TYPE int8 USING brin FAMILY pg_catalog.integer_minmax_ops AS
+   OPERATOR 1 pg_catalog.<(int8, int8),
+   OPERATOR 2 pg_catalog.<=(int8, int8),
+   OPERATOR 3 pg_catalog.=(int8, int8),
+   OPERATOR 4 pg_catalog.>=(int8, int8),
+   OPERATOR 5 pg_catalog.>(int8, int8),
+   FUNCTION 1 (int8, int8) pg_catalog.brin_minmax_opcinfo(internal),
+   FUNCTION 2 (int8, int8) pg_catalog.brin_minmax_add_value(internal, internal, internal),
+   FUNCTION 3 (int8, int8) pg_catalog.brin_minmax_consistent(internal, internal, internal),
+   FUNCTION 4 (int8, int8) pg_catalog.brin_minmax_union(internal, internal, internal);
+
+CREATE OPERATOR CLASS pg_catalog.oid_minmax_ops DEFAULT
+   FOR TYPE oid USING brin FAMILY pg_catalog.oid_minmax_ops AS
+   OPERATOR 1 pg_catalog.<(oid, oid),
+   OPERATOR 2 pg_catalog.<=(oid, oid),
+   OPERATOR 3 pg_catalog.=(oid, oid),
+   OPERATOR 4 pg_catalog.>=(oid, oid),
+   OPERATOR 5 pg_catalog.>(oid, oid),
+   FUNCTION 1 (oid, oid) pg_catalog.brin_minmax_opcinfo(internal),
+   FUNCTION 2 (oid, oid) pg_catalog.brin_minmax_add_value(internal, internal, internal),
+   FUNCTION 3 (oid, oid) pg_catalog.brin_minmax_consistent(internal, internal, internal),
+   FUNCTION 4 (oid, oid) pg_catalog.brin_minmax_union(internal, internal, internal);
+
+CREATE OPERATOR CLASS pg_catalog.date_minmax_ops DEFAULT
+   FOR TYPE date USING brin FAMILY pg_catalog.datetime_minmax_ops AS
+   OPERATOR 1 pg_catalog.<(date, date),
+   OPERATOR 2 pg_catalog.<=(date, date),
+   OPERATOR 3 pg_catalog.=(date, date),
+   OPERATOR 4 pg_catalog.>=(date, date),
+   OPERATOR 5 pg_catalog.>(date, date),
+   FUNCTION 1 (date, date) pg_catalog.brin_minmax_opcinfo(internal),
+   FUNCTION 2 (date, date) pg_catalog.brin_minmax_add_value(internal, internal, internal),
+   FUNCTION 3 (date, date) pg_catalog.brin_minmax_consistent(internal, internal, internal),
+   FUNCTION 4 (date, date) pg_catalog.brin_minmax_union(internal, internal, internal);
+
+CREATE OPERATOR CLASS pg_catalog.timestamp_minmax_ops DEFAULT
+   FOR TYPE timestamp USING brin FAMILY pg_catalog.datetime_minmax_ops AS
+   OPERATOR 1 pg_catalog.<(timestamp, timestamp),
+   OPERATOR 2 pg_catalog.<=(timestamp, timestamp),
+   OPERATOR 3 pg_catalog.=(timestamp, timestamp),
+   OPERATOR 4 pg_catalog.>=(timestamp, timestamp),
+   OPERATOR 5 pg_catalog.>(timestamp, timestamp),
+   FUNCTION 1 (timestamp, timestamp) pg_catalog.brin_minmax_opcinfo(internal),
+   FUNCTION 2 (timestamp, timestamp) pg_catalog.brin_minmax_add_value(internal, internal, internal),
+   FUNCTION 3 (timestamp, timestamp) pg_catalog.brin_minmax_consistent(internal, internal, internal),
+   FUNCTION 4 (timestamp, timestamp) pg_catalog.brin_minmax_union(internal, internal, internal);
+
+CREATE OPERATOR CLASS pg_catalog.timestamptz_minmax_ops DEFAULT
+   FOR TYPE timestamptz USING brin FAMILY pg_catalog.datetime_minmax_ops AS
+   OPERATOR 1 pg_catalog.<(timestamptz, timestamptz),
+   OPERATOR 2 pg_catalog.<=(timestamptz, timestamptz),
+   OPERATOR 3 pg_catalog.=(timestamptz, timestamptz),
+   OPERATOR 4 pg_catalog.>=(timestamptz, timestamptz),
+   OPERATOR 5 pg_catalog.>(timestamptz, timestamptz),
+   FUNCTION 1 (timestamptz, timestamptz) pg_catalog.brin_minmax_opcinfo(internal),
+   FUNCTION 2 (timestamptz, timestamptz) pg_catalog.brin_minmax_add_value(internal, internal, internal),
+   FUNCTION 3 (timestamptz, timestamptz) pg_catalog.brin_minmax_consistent(internal, internal, internal),
+   FUNCTION 4 (timestamptz, timestamptz) pg_catalog.brin_minmax_union(internal, internal, internal);
+
+CREATE OPERATOR CLASS pg_catalog.float4_minmax_ops DEFAULT
+   FOR TYPE float4 USING brin FAMILY pg_catalog.float_minmax_ops AS
+   OPERATOR 1 pg_catalog.<(float4, float4),
+   OPERATOR 2 pg_catalog.<=(float4, float4),
+   OPERATOR 3 pg_catalog.=(float4, float4),
+   OPERATOR 4 pg_catalog.>=(float4, float4),
+   OPERATOR 5 pg_catalog.>(float4, float4),
+   FUNCTION 1 (float4, float4) pg_catalog.brin_minmax_opcinfo(internal),
+   FUNCTION 2 (float4, float4) pg_catalog.brin_minmax_add_value(internal, internal, internal),
+   FUNCTION 3 (float4, float4) pg_catalog.brin_minmax_consistent(internal, internal, internal),
+   FUNCTION 4 (float4, float4) pg_catalog.brin_minmax_union(internal, internal, internal);
+
+CREATE OPERATOR CLASS pg_catalog.float8_minmax_ops DEFAULT
+   FOR TYPE float8 USING brin FAMILY pg_catalog.float_minmax_ops AS
+   OPERATOR 1 pg_catalog.<(float8, float8),
+   OPERATOR 2 pg_catalog.<=(float8, float8),
+   OPERATOR 3 pg_catalog.=(float8, float8),
+   OPERATOR 4 pg_catalog.>=(float8, float8),
+   OPERATOR 5 pg_catalog.>(float8, float8),
+   FUNCTION 1 (float8, float8) pg_catalog.brin_minmax_opcinfo(internal),
+   FUNCTION 2 (float8, float8) pg_catalog.brin_minmax_add_value(internal, internal, internal),
+   FUNCTION 3 (float8, float8) pg_catalog.brin_minmax_consistent(internal, internal, internal),
+   FUNCTION 4 (float8, float8) pg_catalog.brin_minmax_union(internal, internal, internal);
+
+CREATE OPERATOR CLASS pg_catalog.numeric_minmax_ops DEFAULT
+   FOR TYPE numeric USING brin FAMILY pg_catalog.numeric_minmax_ops AS
+   OPERATOR 1 pg_catalog.<(numeric, numeric),
+   OPERATOR 2 pg_catalog.<=(numeric, numeric),
+   OPERATOR 3 pg_catalog.=(numeric, numeric),
+   OPERATOR 4 pg_catalog.>=(numeric, numeric),
+   OPERATOR 5 pg_catalog.>(numeric, numeric),
+   FUNCTION 1 (numeric, numeric) pg_catalog.brin_minmax_opcinfo(internal),
+   FUNCTION 2 (numeric, numeric) pg_catalog.brin_minmax_add_value(internal, internal, internal),
+   FUNCTION 3 (numeric, numeric) pg_catalog.brin_minmax_consistent(internal, internal, internal),
+   FUNCTION 4 (numeric, numeric) pg_catalog.brin_minmax_union(internal, internal, internal);
+
+CREATE OPERATOR CLASS pg_catalog.text_minmax_ops DEFAULT
+   FOR TYPE text USING brin FAMILY pg_catalog.text_minmax_ops AS
+   OPERATOR 1 pg_catalog.<(text, text),
+   OPERATOR 2 pg_catalog.<=(text, text),
+   OPERATOR 3 pg_catalog.=(text, text),
+   OPERATOR 4 pg_catalog.>=(text, text),
+   OPERATOR 5 pg_catalog.>(text, text),
+   FUNCTION 1 (text, text) pg_catalog.brin_minmax_opcinfo(internal),
+   FUNCTION 2 (text, text) pg_catalog.brin_minmax_add_value(internal, internal, internal),
+   FUNCTION 3 (text, text) pg_catalog.brin_minmax_consistent(internal, internal, internal),
+   FUNCTION 4 (text, text) pg_catalog.brin_minmax_union(internal, internal, internal);
+
+CREATE OPERATOR CLASS pg_catalog.bpchar_minmax_ops DEFAULT
+   FOR TYPE bpchar USING brin FAMILY pg_catalog.bpchar_minmax_ops AS
+   OPERATOR 1 pg_catalog.<(bpchar, bpchar),
+   OPERATOR 2 pg_catalog.<=(bpchar, bpchar),
+   OPERATOR 3 pg_catalog.=(bpchar, bpchar),
+   OPERATOR 4 pg_catalog.>=(bpchar, bpchar),
+   OPERATOR 5 pg_catalog.>(bpchar, bpchar),
+   FUNCTION 1 (bpchar, bpchar) pg_catalog.brin_minmax_opcinfo(internal),
+   FUNCTION 2 (bpchar, bpchar) pg_catalog.brin_minmax_add_value(internal, internal, internal),
+   FUNCTION 3 (bpchar, bpchar) pg_catalog.brin_minmax_consistent(internal, internal, internal),
+   FUNCTION 4 (bpchar, bpchar) pg_catalog.brin_minmax_union(internal, internal, internal);
+
+CREATE OPERATOR CLASS pg_catalog.time_minmax_ops DEFAULT
+   FOR TYPE time USING brin FAMILY pg_catalog.time_minmax_ops AS
+   OPERATOR 1 pg_catalog.<(time, time),
+   OPERATOR 2 pg_catalog.<=(time, time),
+   OPERATOR 3 pg_catalog.=(time, time),
+   OPERATOR 4 pg_catalog.>=(time, time),
+   OPERATOR 5 pg_catalog.>(time, time),
+   FUNCTION 1 (time, time) pg_catalog.brin_minmax_opcinfo(internal),
+   FUNCTION 2 (time, time) pg_catalog.brin_minmax_add_value(internal, internal, internal),
+   FUNCTION 3 (time, time) pg_catalog.brin_minmax_consistent(internal, internal, internal),
+   FUNCTION 4 (time, time) pg_catalog.brin_minmax_union(internal, internal, internal);
+
+CREATE OPERATOR CLASS pg_catalog.timetz_minmax_ops DEFAULT
+   FOR TYPE timetz USING brin FAMILY pg_catalog.timetz_minmax_ops AS
+   OPERATOR 1 pg_catalog.<(timetz, timetz),
+   OPERATOR 2 pg_catalog.<=(timetz, timetz),
+   OPERATOR 3 pg_catalog.=(timetz, timetz),
+   OPERATOR 4 pg_catalog.>=(timetz, timetz),
+   OPERATOR 5 pg_catalog.>(timetz, timetz),
+   FUNCTION 1 (timetz, timetz) pg_catalog.brin_minmax_opcinfo(internal),
+   FUNCTION 2 (timetz, timetz) pg_catalog.brin_minmax_add_value(internal, internal, internal),
+   FUNCTION 3 (timetz, timetz) pg_catalog.brin_minmax_consistent(internal, internal, internal),
+   FUNCTION 4 (timetz, timetz) pg_catalog.brin_minmax_union(internal, internal, internal);
+
+CREATE OPERATOR CLASS pg_catalog.interval_minmax_ops DEFAULT
+   FOR TYPE interval USING brin FAMILY pg_catalog.interval_minmax_ops AS
+   OPERATOR 1 pg_catalog.<(interval, interval),
+   OPERATOR 2 pg_catalog.<=(interval, interval),
+   OPERATOR 3 pg_catalog.=(interval, interval),
+   OPERATOR 4 pg_catalog.>=(interval, interval),
+   OPERATOR 5 pg_catalog.>(interval, interval),
+   FUNCTION 1 (interval, interval) pg_catalog.brin_minmax_opcinfo(internal),
+   FUNCTION 2 (interval, interval) pg_catalog.brin_minmax_add_value(internal, internal, internal),
+   FUNCTION 3 (interval, interval) pg_catalog.brin_minmax_consistent(internal, internal, internal),
+   FUNCTION 4 (interval, interval) pg_catalog.brin_minmax_union(internal, internal, internal);
+
+CREATE OPERATOR CLASS pg_catalog.int1_minmax_ops DEFAULT
+   FOR TYPE int1 USING brin FAMILY pg_catalog.int1_minmax_ops AS
+   OPERATOR 1 pg_catalog.<(int1, int1),
+   OPERATOR 2 pg_catalog.<=(int1, int1),
+   OPERATOR 3 pg_catalog.=(int1, int1),
+   OPERATOR 4 pg_catalog.>=(int1, int1),
+   OPERATOR 5 pg_catalog.>(int1, int1),
+   FUNCTION 1 (int1, int1) pg_catalog.brin_minmax_opcinfo(internal),
+   FUNCTION 2 (int1, int1) pg_catalog.brin_minmax_add_value(internal, internal, internal),
+   FUNCTION 3 (int1, int1) pg_catalog.brin_minmax_consistent(internal, internal, internal),
+   FUNCTION 4 (int1, int1) pg_catalog.brin_minmax_union(internal, internal, internal);
+
+CREATE OPERATOR CLASS pg_catalog.smalldatetime_minmax_ops DEFAULT
+   FOR TYPE smalldatetime USING brin FAMILY pg_catalog.smalldatetime_minmax_ops AS
+   OPERATOR 1 pg_catalog.<(smalldatetime, smalldatetime),
+   OPERATOR 2 pg_catalog.<=(smalldatetime, smalldatetime),
+   OPERATOR 3 pg_catalog.=(smalldatetime, smalldatetime),
+   OPERATOR 4 pg_catalog.>=(smalldatetime, smalldatetime),
+   OPERATOR 5 pg_catalog.>(smalldatetime, smalldatetime),
+   FUNCTION 1 (smalldatetime, smalldatetime) pg_catalog.brin_minmax_opcinfo(internal),
+   FUNCTION 2 (smalldatetime, smalldatetime) pg_catalog.brin_minmax_add_value(internal, internal, internal),
+   FUNCTION 3 (smalldatetime, smalldatetime) pg_catalog.brin_minmax_consistent(internal, internal, internal),
+   FUNCTION 4 (smalldatetime, smalldatetime) pg_catalog.brin_minmax_union(internal, internal, internal);
+
+CREATE OPERATOR CLASS pg_catalog.int4_bloom_ops
+   FOR TYPE int4 USING brin FAMILY pg_catalog.integer_bloom_ops AS
+   OPERATOR 1 pg_catalog.=(int4, int4),
+   FUNCTION 1 (int4, int4) pg_catalog.brin_bloom_opcinfo(internal),
+   FUNCTION 2 (int4, int4) pg_catalog.brin_bloom_add_value(internal, internal, internal),
+   FUNCTION 3 (int4, int4) pg_catalog.brin_bloom_consistent(internal, internal, internal),
+   FUNCTION 4 (int4, int4) pg_catalog.brin_bloom_union(internal, internal, internal),
+   FUNCTION 5 (int4, int4) pg_catalog.hashint4(int4);
+
+CREATE OPERATOR CLASS pg_catalog.int2_bloom_ops
+   FOR TYPE int2 USING brin FAMILY pg_catalog.integer_bloom_ops AS
+   OPERATOR 1 pg_catalog.=(int2, int2),
+   FUNCTION 1 (int2, int2) pg_catalog.brin_bloom_opcinfo(internal),
+   FUNCTION 2 (int2, int2) pg_catalog.brin_bloom_add_value(internal, internal, internal),
+   FUNCTION 3 (int2, int2) pg_catalog.brin_bloom_consistent(internal, internal, internal),
+   FUNCTION 4 (int2, int2) pg_catalog.brin_bloom_union(internal, internal, internal),
+   FUNCTION 5 (int2, int2) pg_catalog.hashint2(int2);
+
+CREATE OPERATOR CLASS pg_catalog.int8_bloom_ops
+   FOR TYPE int8 USING brin FAMILY pg_catalog.integer_bloom_ops AS
+   OPERATOR 1 pg_catalog.=(int8, int8),
+   FUNCTION 1 (int8, int8) pg_catalog.brin_bloom_opcinfo(internal),
+   FUNCTION 2 (int8, int8) pg_catalog.brin_bloom_add_value(internal, internal, internal),
+   FUNCTION 3 (int8, int8) pg_catalog.brin_bloom_consistent(internal, internal, internal),
+   FUNCTION 4 (int8, int8) pg_catalog.brin_bloom_union(internal, internal, internal),
+   FUNCTION 5 (int8, int8) pg_catalog.hashint8(int8);
+
+CREATE OPERATOR CLASS pg_catalog.text_bloom_ops
+   FOR TYPE text USING brin FAMILY pg_catalog.text_bloom_ops AS
+   OPERATOR 1 pg_catalog.=(text, text),
+   FUNCTION 1 (text, text) pg_catalog.brin_bloom_opcinfo(internal),
+   FUNCTION 2 (text, text) pg_catalog.brin_bloom_add_value(internal, internal, internal),
+   FUNCTION 3 (text, text) pg_catalog.brin_bloom_consistent(internal, internal, internal),
+   FUNCTION 4 (text, text) pg_catalog.brin_bloom_union(internal, internal, internal),
+   FUNCTION 5 (text, text) pg_catalog.hashtext(text);
+
+ALTER OPERATOR FAMILY pg_catalog.integer_minmax_ops USING brin ADD
+   OPERATOR 1 pg_catalog.<(int2, int4),
+   OPERATOR 2 pg_catalog.<=(int2, int4),
+   OPERATOR 3 pg_catalog.=(int2, int4),
+   OPERATOR 4 pg_catalog.>=(int2, int4),
+   OPERATOR 5 pg_catalog.>(int2, int4),
+   OPERATOR 1 pg_catalog.<(int2, int8),
+   OPERATOR 2 pg_catalog.<=(int2, int8),
+   OPERATOR 3 pg_catalog.=(int2, int8),
+   OPERATOR 4 pg_catalog.>=(int2, int8),
+   OPERATOR 5 pg_catalog.>(int2, int8),
+   OPERATOR 1 pg_catalog.<(int4, int2),
+   OPERATOR 2 pg_catalog.<=(int4, int2),
+   OPERATOR 3 pg_catalog.=(int4, int2),
+   OPERATOR 4 pg_catalog.>=(int4, int2),
+   OPERATOR 5 pg_catalog.>(int4, int2),
+   OPERATOR 1 pg_catalog.<(int4, int8),
+   OPERATOR 2 pg_catalog.<=(int4, int8),
+   OPERATOR 3 pg_catalog.=(int4, int8),
+   OPERATOR 4 pg_catalog.>=(int4, int8),
+   OPERATOR 5 pg_catalog.>(int4, int8),
+   OPERATOR 1 pg_catalog.<(int8, int2),
+   OPERATOR 2 pg_catalog.<=(int8, int2),
+   OPERATOR 3 pg_catalog.=(int8, int2),
+   OPERATOR 4 pg_catalog.>=(int8, int2),
+   OPERATOR 5 pg_catalog.>(int8, int2),
+   OPERATOR 1 pg_catalog.<(int8, int4),
+   OPERATOR 2 pg_catalog.<=(int8, int4),
+   OPERATOR 3 pg_catalog.=(int8, int4),
+   OPERATOR 4 pg_catalog.>=(int8, int4),
+   OPERATOR 5 pg_catalog.>(int8, int4);
+
+ALTER OPERATOR FAMILY pg_catalog.datetime_minmax_ops USING brin ADD
+   OPERATOR 1 pg_catalog.<(date, timestamp),
+   OPERATOR 2 pg_catalog.<=(date, timestamp),
+   OPERATOR 3 pg_catalog.=(date, timestamp),
+   OPERATOR 4 pg_catalog.>=(date, timestamp),
+   OPERATOR 5 pg_catalog.>(date, timestamp),
+   OPERATOR 1 pg_catalog.<(date, timestamptz),
+   OPERATOR 2 pg_catalog.<=(date, timestamptz),
+   OPERATOR 3 pg_catalog.=(date, timestamptz),
+   OPERATOR 4 pg_catalog.>=(date, timestamptz),
+   OPERATOR 5 pg_catalog.>(date, timestamptz),
+   OPERATOR 1 pg_catalog.<(timestamp, date),
+   OPERATOR 2 pg_catalog.<=(timestamp, date),
+   OPERATOR 3 pg_catalog.=(timestamp, date),
+   OPERATOR 4 pg_catalog.>=(timestamp, date),
+   OPERATOR 5 pg_catalog.>(timestamp, date),
+   OPERATOR 1 pg_catalog.<(timestamp, timestamptz),
+   OPERATOR 2 pg_catalog.<=(timestamp, timestamptz),
+   OPERATOR 3 pg_catalog.=(timestamp, timestamptz),
+   OPERATOR 4 pg_catalog.>=(timestamp, timestamptz),
+   OPERATOR 5 pg_catalog.>(timestamp, timestamptz),
+   OPERATOR 1 pg_catalog.<(timestamptz, date),
+   OPERATOR 2 pg_catalog.<=(timestamptz, date),
+   OPERATOR 3 pg_catalog.=(timestamptz, date),
+   OPERATOR 4 pg_catalog.>=(timestamptz, date),
+   OPERATOR 5 pg_catalog.>(timestamptz, date),
+   OPERATOR 1 pg_catalog.<(timestamptz, timestamp),
+   OPERATOR 2 pg_catalog.<=(timestamptz, timestamp),
+   OPERATOR 3 pg_catalog.=(timestamptz, timestamp),
+   OPERATOR 4 pg_catalog.>=(timestamptz, timestamp),
+   OPERATOR 5 pg_catalog.>(timestamptz, timestamp);
+
+ALTER OPERATOR FAMILY pg_catalog.float_minmax_ops USING brin ADD
+   OPERATOR 1 pg_catalog.<(float4, float8),
+   OPERATOR 2 pg_catalog.<=(float4, float8),
+   OPERATOR 3 pg_catalog.=(float4, float8),
+   OPERATOR 4 pg_catalog.>=(float4, float8),
+   OPERATOR 5 pg_catalog.>(float4, float8),
+   OPERATOR 1 pg_catalog.<(float8, float4),
+   OPERATOR 2 pg_catalog.<=(float8, float4),
+   OPERATOR 3 pg_catalog.=(float8, float4),
+   OPERATOR 4 pg_catalog.>=(float8, float4),
+   OPERATOR 5 pg_catalog.>(float8, float4);
+
+ALTER OPERATOR FAMILY pg_catalog.integer_bloom_ops USING brin ADD
+   OPERATOR 1 pg_catalog.=(int2, int4),
+   OPERATOR 1 pg_catalog.=(int2, int8),
+   OPERATOR 1 pg_catalog.=(int4, int2),
+   OPERATOR 1 pg_catalog.=(int4, int8),
+   OPERATOR 1 pg_catalog.=(int8, int2),
+   OPERATOR 1 pg_catalog.=(int8, int4);
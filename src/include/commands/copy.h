@@ -278,6 +278,8 @@ typedef struct CopyStateData {
 
     Formatter* formatter;
     FileFormat fileformat;
+    bool columnar;                            /* columnar chunks, a variant of BINARY */
+    struct CopyColumnarState* columnar_state; /* chunk being built or read */
     char* headerFilename; /* User define header filename */
     char* out_filename_prefix;
     char* out_fix_alignment;
@@ -323,6 +325,7 @@ typedef struct CopyStateData {
 
 #define IS_CSV(cstate) ((cstate)->fileformat == FORMAT_CSV)
 #define IS_BINARY(cstate) ((cstate)->fileformat == FORMAT_BINARY)
+#define IS_COLUMNAR(cstate) (IS_BINARY(cstate) && (cstate)->columnar)
 #define IS_FIXED(cstate) ((cstate)->fileformat == FORMAT_FIXED)
 #define IS_TEXT(cstate) ((cstate)->fileformat == FORMAT_TEXT)
 #define IS_REMOTEWRITE(cstate) ((cstate)->fileformat == FORMAT_WRITABLE)
@@ -22,6 +22,7 @@
 #include "storage/buf/buf.h"
 #include "storage/cu.h"
 #include "storage/lock/lock.h"
+#include "utils/atomic.h"
 #include "utils/relcache.h"
 
 typedef enum DELETE_STATS_OPTION {
@@ -183,6 +184,19 @@ typedef struct UpdatePartitionedTableData {
     TransactionId frozenXid;     /* frozen Xid */
 } UpdatePartitionedTableData;
 
+/*
+ * Cost-based delay state shared by a vacuum and the workers vacuuming its
+ * indexes in parallel.  Everyone adds what they spend to balance, and once
+ * it reaches costLimit naps in proportion to their own part of it, so that
+ * together they stay within the leader's limit.
+ */
+typedef struct VacuumSharedCostData {
+    pg_atomic_uint32 balance; /* cost spent by all participants since they last napped */
+    pg_atomic_uint32 nactive; /* participants vacuuming an index right now */
+    volatile int costLimit;   /* the leader's limit, as rebalanced by autovacuum */
+    volatile int costDelay;
+} VacuumSharedCostData;
+
 /* Identify create temp table for attribute or table. */
 typedef enum { TempSmpleTblType_Table, TempSmpleTblType_Attrbute } TempSmpleTblType;
 
@@ -105,6 +105,7 @@ typedef enum knl_thread_role {
     COMM_POOLER_CLEAN,
     CSNMIN_SYNC,
     BARRIER_CREATOR,
+    INDEX_BUILD_WORKER,
     TS_COMPACTION,
     TS_COMPACTION_CONSUMER,
     TS_COMPACTION_AUXILIAY,
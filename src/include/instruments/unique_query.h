@@ -32,5 +32,7 @@
 extern uint32 generate_unique_queryid(Query* query, const char* query_string);
 extern bool normalized_unique_querystring(Query* query, const char* query_string, char* unique_string, int len,
     uint32 multi_sql_offset);
+extern char* parameterize_unique_querystring(Query* query, const char* query_string, int* num_params,
+    List** param_consts);
 
 #endif
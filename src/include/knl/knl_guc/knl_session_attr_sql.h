@@ -42,6 +42,7 @@
 typedef struct knl_session_attr_sql {
     bool enable_fast_numeric;
     bool enable_global_stats;
+    bool enable_incremental_partition_stats;
     bool enable_hdfs_predicate_pushdown;
     bool enable_absolute_tablespace;
     bool enable_hadoop_env;
@@ -85,6 +86,8 @@ typedef struct knl_session_attr_sql {
     bool enable_stream_operator;
     bool enable_stream_concurrent_update;
     bool enable_vector_engine;
+    bool enable_vector_output;
+    bool enable_vectorized_scan;
     bool enable_force_vector_engine;
     bool enable_random_datanode;
     bool enable_fstream;
@@ -205,6 +208,8 @@ typedef struct knl_session_attr_sql {
     bool enable_beta_opfusion;
     bool enable_partition_opfusion;
     int opfusion_debug_mode;
+    bool enable_auto_parameterize;
+    int auto_parameterize_max_statements;
     double cost_weight_index;
     double default_limit_rows;
     int sql_beta_feature;
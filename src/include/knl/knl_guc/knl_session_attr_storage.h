@@ -61,6 +61,8 @@ typedef struct knl_session_attr_storage {
     bool XLOG_DEBUG;
 #endif
     bool synchronize_seqscans;
+    bool enable_btree_bottomup_delete;
+    bool enable_hot_row_locking;
     bool enable_data_replicate;
     bool HaModuleDebug;
     bool hot_standby_feedback;
@@ -140,7 +142,10 @@ typedef struct knl_session_attr_storage {
     int cstore_backwrite_max_threshold;
     int cstore_backwrite_quantity;
     int fast_extend_file_size;
+    int heap_extent_max_blocks;
+    int max_parallel_maintenance_workers;
     int gin_pending_list_limit;
+    int default_toast_compression;
     int gtm_connect_retries;
     int gtm_conn_check_interval;
     int dfs_max_parsig_length;
@@ -252,6 +252,12 @@ typedef struct knl_g_stat_context {
     struct LRUCache* lru;
     List* fifo;
 #endif
+
+    /* bottom-up deletion on B-tree leaf pages, see _bt_bottomup_delete() */
+    volatile uint64 btBottomupPasses;
+    volatile uint64 btBottomupHeapBlocks;
+    volatile uint64 btBottomupDeletedTids;
+    volatile uint64 btBottomupSplitsAvoided;
 } knl_g_stat_context;
 
 /*
@@ -683,6 +689,17 @@ typedef struct knl_g_conn_context {
     slock_t ConnCountLock;
 } knl_g_conn_context;
 
+/*
+ * Buckets of the WAL insert latency histogram: bucket 0 counts inserts that took
+ * less than 1us, bucket b counts [2^(b-1), 2^b) us and the last one is open-ended.
+ */
+#define WAL_INSERT_LATENCY_BUCKETS 20
+
+typedef struct WALInsertLatencyBucketPadded {
+    volatile uint64 count;
+    char padding[PG_CACHE_LINE_SIZE - sizeof(uint64)];
+} WALInsertLatencyBucketPadded;
+
 typedef struct knl_g_wal_context {
     /* Start address of WAL insert status table that contains WAL_INSERT_STATUS_ENTRIES entries */
     WALInsertStatusEntry* walInsertStatusTable;
@@ -704,6 +721,7 @@ typedef struct knl_g_wal_context {
     volatile int lastLRCScanned;
     volatile int lastLRCFlushed;
     int num_locks_in_group;
+    WALInsertLatencyBucketPadded insertLatencyHist[WAL_INSERT_LATENCY_BUCKETS];
 } knl_g_wal_context;
 
 typedef struct GlobalSeqInfoHashBucket {
@@ -735,6 +735,16 @@ typedef struct knl_u_mb_context {
     int pending_client_encoding;
 } knl_u_mb_context;
 
+/* hit statistics of automatic parameterization, see globalplancache_autoparam.cpp */
+typedef struct AutoParamStats {
+    uint64 calls;     /* simple queries considered */
+    uint64 rejected;  /* queries that could not be parameterized */
+    uint64 hits;      /* served by a statement already prepared in this session */
+    uint64 gpc_hits;  /* served by a plan source found in the global plan cache */
+    uint64 misses;    /* a new plan source had to be built */
+    uint64 evictions; /* statements dropped to honor auto_parameterize_max_statements */
+} AutoParamStats;
+
 typedef struct knl_u_plancache_context {
     /*
      * This is the head of the backend's list of "saved" CachedPlanSources (i.e.,
@@ -792,6 +802,11 @@ typedef struct knl_u_plancache_context {
     bool gpc_remote_msg;
     bool gpc_first_send;
     bool gpc_in_try_store;
+
+    /* statements created by automatic parameterization of simple queries */
+    HTAB* auto_param_htab;
+    uint64 auto_param_clock;
+    AutoParamStats auto_param_stats;
 } knl_u_plancache_context;
 
 typedef struct knl_u_typecache_context {
@@ -2276,6 +2291,9 @@ typedef struct knl_session_context {
 
     ThreadId attachPid;
 
+    /* NUMA node of the thread pool group that should serve this session, -1 for any group */
+    int numa_affinity;
+
     MemoryContext top_mem_cxt;
     MemoryContext cache_mem_cxt;
     MemoryContext top_transaction_mem_cxt;
@@ -1342,6 +1342,11 @@ typedef struct knl_t_vacuum_context {
 
     bool VacuumCostActive;
 
+    /* set while the indexes of a relation are vacuumed in parallel */
+    struct VacuumSharedCostData* VacuumSharedCost;
+
+    int VacuumCostBalanceLocal; /* our part of VacuumSharedCost->balance */
+
     /* just for dfs table on "vacuum full" */
     bool vacuum_full_compact;
 
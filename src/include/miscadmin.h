@@ -53,6 +53,7 @@ extern const uint32 PRIVS_VERSION_NUM;
 extern const uint32 ML_OPT_MODEL_VERSION_NUM;
 extern const uint32 RANGE_LIST_DISTRIBUTION_VERSION_NUM;
 extern const uint32 FIX_SQL_ADD_RELATION_REF_COUNT;
+extern const uint32 TOAST_COMPRESSION_VERSION_NUM;
 
 #define INPLACE_UPGRADE_PRECOMMIT_VERSION 1
 
@@ -70,9 +70,10 @@ typedef struct UtilityDesc {
  *		ReadyForInserts		is it valid for inserts?
  *		Concurrent			are we doing a concurrent index build?
  *		BrokenHotChain		did we detect any broken HOT chains?
+ *		ParallelWorkers		number of workers sharing the heap scan, or 0
  *
- * ii_Concurrent and ii_BrokenHotChain are used only during index build;
- * they're conventionally set to false otherwise.
+ * ii_Concurrent, ii_BrokenHotChain and ii_ParallelWorkers are used only
+ * during index build; they're conventionally set to false (0) otherwise.
  * ----------------
  */
 typedef struct IndexInfo {
@@ -95,6 +96,7 @@ typedef struct IndexInfo {
     bool ii_Concurrent;
     bool ii_BrokenHotChain;
     short ii_PgClassAttrId;
+    int ii_ParallelWorkers;
     UtilityDesc ii_desc; /* meminfo for index create */
 } IndexInfo;
 
@@ -723,6 +723,7 @@ typedef struct IndexOptInfo {
     bool amsearchnulls;  /* can AM search for NULL/NOT NULL entries? */
     bool amhasgettuple;  /* does AM have amgettuple interface? */
     bool amhasgetbitmap; /* does AM have amgetbitmap interface? */
+    bool amblockranges;  /* does AM return whole ranges of heap blocks? */
 } IndexOptInfo;
 
 /*
@@ -1998,6 +1998,17 @@ typedef struct MotMemoryDetailPad {
     MotMemoryDetail* memoryDetail;
 } MotMemoryDetailPad;
 
+#define NUM_MOT_TABLE_CONTENTION_DETAIL_ELEM 6
+
+typedef struct MotTableContentionDetail {
+    Oid relid;
+    char* relname;
+    int64 conflicts;
+    int64 hotRows;
+    int64 hotRowLocks;
+    int64 hotRowLockTimeouts;
+} MotTableContentionDetail;
+
 extern MotSessionMemoryDetail* GetMotSessionMemoryDetail(uint32* num);
 extern MotMemoryDetail* GetMotMemoryDetail(uint32* num, bool isGlobal);
 
@@ -138,7 +138,10 @@ extern OM_ONLINE_STATE get_om_online_state(void);
 /*
  * struct varatt_external is a "TOAST pointer", that is, the information
  * needed to fetch a stored-out-of-line Datum.	The data is compressed
- * if and only if va_extsize < va_rawsize - VARHDRSZ.  This struct must not
+ * if and only if its external size < va_rawsize - VARHDRSZ.  va_extinfo
+ * holds the external size, and in its top bits the compression method of
+ * compressed data, like va_rawsize of a compressed datum does; read it with
+ * the VARATT_EXTERNAL_* macros of access/tuptoaster.h.  This struct must not
  * contain any padding, because we sometimes compare pointers using memcmp.
  *
  * Note that this information is stored unaligned within actual tuples, so
@@ -148,7 +151,7 @@ extern OM_ONLINE_STATE get_om_online_state(void);
  */
 typedef struct varatt_external {
     int32 va_rawsize;  /* Original data size (includes header) */
-    int32 va_extsize;  /* External saved size (doesn't) */
+    int32 va_extinfo;  /* External saved size (doesn't), and compression method */
     Oid va_valueid;    /* Unique ID of value within TOAST table */
     Oid va_toastrelid; /* RelID of TOAST table containing it */
 } varatt_external;
@@ -195,7 +198,7 @@ typedef union {
     struct /* Compressed-in-line format */
     {
         uint32 va_header;
-        uint32 va_rawsize;                   /* Original data size (excludes header) */
+        uint32 va_rawsize;                   /* Original data size (excludes header) and method */
         char va_data[FLEXIBLE_ARRAY_MEMBER]; /* Compressed data */
     } va_compressed;
 } varattrib_4b;
@@ -334,7 +337,19 @@ typedef enum {
 #define VARDATA_1B(PTR) (((varattrib_1b*)(PTR))->va_data)
 #define VARDATA_1B_E(PTR) (((varattrib_1b_e*)(PTR))->va_data)
 
-#define VARRAWSIZE_4B_C(PTR) (((varattrib_4b*)(PTR))->va_compressed.va_rawsize)
+/*
+ * The top two bits of va_rawsize of a compressed datum hold the id of the
+ * compression method (see access/toast_compression.h).  Datums compressed
+ * before there was a choice of methods are pglz, whose id is 0, so they read
+ * the same as before.
+ */
+#define VARLENA_RAWSIZE_BITS 30
+#define VARLENA_RAWSIZE_MASK ((1U << VARLENA_RAWSIZE_BITS) - 1)
+
+#define VARRAWSIZE_4B_C(PTR) (((varattrib_4b*)(PTR))->va_compressed.va_rawsize & VARLENA_RAWSIZE_MASK)
+#define VARCOMPRESSID_4B_C(PTR) (((varattrib_4b*)(PTR))->va_compressed.va_rawsize >> VARLENA_RAWSIZE_BITS)
+#define SET_VARRAWSIZE_4B_C(PTR, len, cmid) \
+    (((varattrib_4b*)(PTR))->va_compressed.va_rawsize = ((uint32)(len)) | (((uint32)(cmid)) << VARLENA_RAWSIZE_BITS))
 
 /* Externally visible macros */
 
@@ -17,6 +17,7 @@
 #ifndef AUTOVACUUM_H
 #define AUTOVACUUM_H
 
+#include "storage/buf/block.h"
 #include "utils/guc.h"
 
 #ifdef PGXC /* PGXC_DATANODE */
@@ -43,6 +44,11 @@ typedef enum {
 
 extern const char* AUTO_VACUUM_WORKER;
 
+/* work items backends can ask autovacuum workers to do */
+typedef enum {
+    AVW_BRINSummarizeRange /* summarize the range of a BRIN index */
+} AutoVacuumWorkItemType;
+
 /* Status inquiry functions */
 extern bool AutoVacuumingActive(void);
 extern bool IsAutoVacuumLauncherProcess(void);
@@ -61,6 +67,9 @@ extern void AutoVacWorkerFailed(void);
 /* autovacuum cost-delay balancer */
 extern void AutoVacuumUpdateDelay(void);
 
+/* called from backends to queue a work item */
+extern bool AutoVacuumRequestWork(AutoVacuumWorkItemType type, Oid relationId, BlockNumber blkno);
+
 #ifdef EXEC_BACKEND
 extern void AutoVacLauncherMain();
 extern void AutoVacWorkerMain();
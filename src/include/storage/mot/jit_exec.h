@@ -74,6 +74,30 @@ extern JitPlan* IsJittable(Query* query, const char* queryString);
  */
 extern JitContext* JitCodegenQuery(Query* query, const char* queryString, JitPlan* jitPlan);
 
+/**
+ * @brief Generate jitted code for a query issued through SPI by a PL/pgSQL function. Only queries whose parameters
+ * are all external parameters are compiled, and the parameter identifiers and types are made part of the cache key,
+ * since the same statement text may refer to different function variables.
+ * @param query The parsed SQL query for which jitted code is to be generated.
+ * @param queryString The query text.
+ * @param functionId The identifier of the calling function (used for statistics).
+ * @return The context of the jitted code required for later execution, or NULL if the query cannot be jitted.
+ */
+extern JitContext* JitCodegenFunctionQuery(Query* query, const char* queryString, Oid functionId);
+
+/**
+ * @brief Reports the execution of a statement of a PL/pgSQL function (used for per-function statistics).
+ * @param functionId The identifier of the calling function.
+ * @param jitted Specifies whether the statement was executed by jitted code or by the interpreter.
+ */
+extern void JitReportFunctionQueryExec(Oid functionId, bool jitted);
+
+/**
+ * @brief Discards the per-function statistics of a dropped function.
+ * @param functionId The identifier of the dropped function.
+ */
+extern void JitReportFunctionDropped(Oid functionId);
+
 /** @brief Resets the scan iteration counter for the JIT context. */
 extern void JitResetScan(JitContext* jitContext);
 
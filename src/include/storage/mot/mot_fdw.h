@@ -82,4 +82,22 @@ extern void MOTCheckpointFetchUnlock();
 extern bool MOTCheckpointExists(
     char* ctrlFilePath, size_t ctrlLen, char* checkpointDir, size_t checkpointLen, size_t& basePathLen);
 
+/**
+ * @brief Returns the path of a checkpoint that the current (delta) MOT checkpoint is based on.
+ * @param index the index of the base checkpoint, starting from the nearest one.
+ * @param checkpointDir a buffer to hold the checkpoint path.
+ * @param checkpointLen the length of the given checkpoint path buffer.
+ * @return True if the base checkpoint exists, False if there are no more base checkpoints.
+ */
+extern bool MOTGetCheckpointBaseDir(uint32_t index, char* checkpointDir, size_t checkpointLen);
+
+struct MotTableContentionDetail;
+
+/**
+ * @brief Retrieves the concurrency control statistics of all MOT tables.
+ * @param tableCount the returned number of tables.
+ * @return A palloc'd array of table statistics, or NULL if there are no MOT tables.
+ */
+extern struct MotTableContentionDetail* MOTGetTableContentionDetail(uint32_t* tableCount);
+
 #endif  // MOT_FDW_H
@@ -31,4 +31,7 @@
 extern void MOTRedo(XLogReaderState *record);
 extern void MOTDesc(StringInfo buf, XLogReaderState *record);
 
+struct RedoWorkerStatsData;
+extern void MOTGetRedoWorkerStatistic(uint32 *realNum, RedoWorkerStatsData *worker, uint32 workerLen);
+
 #endif /* MOT_XLOG_H */
@@ -16,6 +16,7 @@
 
 #include "fmgr.h"
 #include "lib/ilist.h"
+#include "datatype/timestamp.h"
 #include "storage/buf/block.h"
 #include "storage/relfilenode.h"
 
@@ -62,6 +63,16 @@ typedef struct SMgrRelationData {
     BlockNumber smgr_vm_nblocks;  /* last known size of vm fork */
     BlockNumber smgr_cached_nblocks; /* last known size of main fork*/
 
+    /*
+     * Extent of new main fork blocks reserved by this backend for its own
+     * inserts, see RelationGetBufferForTuple.  Reset along with the fields
+     * above, the blocks are also in the FSM so unused ones stay usable.
+     */
+    BlockNumber smgr_extent_next; /* next unused reserved block */
+    BlockNumber smgr_extent_end;  /* end of the reserved extent, exclusive */
+    int smgr_extent_size;         /* blocks in the last reserved extent */
+    TimestampTz smgr_extent_time; /* when the last extent was reserved */
+
     int smgr_bcmarry_size;
     BlockNumber* smgr_bcm_nblocks; /* last known size of bcm fork */
 
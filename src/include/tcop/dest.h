@@ -141,6 +141,9 @@ struct _DestReceiver {
     /* Send batch*/
     void (*sendBatch)(VectorBatch* batch, DestReceiver* self);
 
+    /* Send a devectorized batch of nrows rows, values and isnull are row-major */
+    void (*receiveRowBatch)(TupleDesc typeinfo, Datum* values, bool* isnull, int nrows, DestReceiver* self);
+
     void (*finalizeLocalStream)(DestReceiver* self);
 
     /* send sample tuple to coordinator for analyze */
@@ -65,6 +65,7 @@ public:
     void Init(bool enableNumaDistribute);
     void ShutDownThreads(bool forceWait = false);
     int DispatchSession(Port* port);
+    ThreadPoolGroup* FindThreadGroupOnNuma(int numaId);
     void AddWorkerIfNecessary();
     void SetThreadPoolInfo();
     int GetThreadNum();
@@ -47,6 +47,7 @@ public:
     void DelSessionFromEpoll(knl_session_context* session);
     void RemoveWorkerFromList(ThreadPoolWorker* worker);
     void AddEpoll(knl_session_context* session);
+    void TakeOverSession(knl_session_context* session);
     void SendShutDown();
     void ReaperAllSession();
     void ShutDown() const;
@@ -65,6 +66,7 @@ public:
         m_tid = 0;
     }
 private:
+    void RegisterSession(knl_session_context* session, int op);
     void HandleConnEvent(int nevets);
     knl_session_context* GetSessionBaseOnEvent(struct epoll_event* ev);
     void DispatchSession(knl_session_context* session);
@@ -957,6 +957,7 @@ extern Datum unknownout(PG_FUNCTION_ARGS);
 extern Datum unknownrecv(PG_FUNCTION_ARGS);
 extern Datum unknownsend(PG_FUNCTION_ARGS);
 
+extern Datum pg_column_compression(PG_FUNCTION_ARGS);
 extern Datum pg_column_size(PG_FUNCTION_ARGS);
 extern Datum datalength(PG_FUNCTION_ARGS);
 
@@ -1365,6 +1366,7 @@ extern Datum spg_quad_choose(PG_FUNCTION_ARGS);
 extern Datum spg_quad_picksplit(PG_FUNCTION_ARGS);
 extern Datum spg_quad_inner_consistent(PG_FUNCTION_ARGS);
 extern Datum spg_quad_leaf_consistent(PG_FUNCTION_ARGS);
+extern Datum spg_point_sortkey(PG_FUNCTION_ARGS);
 
 /* access/spgist/spgkdtreeproc.c */
 extern Datum spg_kd_config(PG_FUNCTION_ARGS);
@@ -1559,6 +1561,7 @@ extern Datum hypopg_reset_index(PG_FUNCTION_ARGS);
 extern Datum mot_global_memory_detail(PG_FUNCTION_ARGS);
 extern Datum mot_local_memory_detail(PG_FUNCTION_ARGS);
 extern Datum mot_session_memory_detail(PG_FUNCTION_ARGS);
+extern Datum mot_table_contention_detail(PG_FUNCTION_ARGS);
 
 #endif /* !FRONTEND_PARSER */
 #endif /* BUILTINS_H */
@@ -195,6 +195,7 @@ extern Datum point_div(PG_FUNCTION_ARGS);
 extern double point_dt(Point* pt1, Point* pt2);
 extern double point_sl(Point* pt1, Point* pt2);
 extern double pg_hypot(double x, double y);
+extern uint64 point_zorder(double x, double y);
 
 /* public lseg routines */
 extern Datum lseg_in(PG_FUNCTION_ARGS);
@@ -408,6 +409,7 @@ extern Datum gist_circle_consistent(PG_FUNCTION_ARGS);
 extern Datum gist_point_compress(PG_FUNCTION_ARGS);
 extern Datum gist_point_consistent(PG_FUNCTION_ARGS);
 extern Datum gist_point_distance(PG_FUNCTION_ARGS);
+extern Datum gist_box_sortkey(PG_FUNCTION_ARGS);
 
 /* geo_selfuncs.c */
 extern Datum areasel(PG_FUNCTION_ARGS);
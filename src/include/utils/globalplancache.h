@@ -96,4 +96,8 @@ private:
 
 
 
+/* automatic parameterization of simple queries */
+extern List* AutoParamGetExecutePlan(Query* query, const char* query_string);
+extern Datum gs_auto_param_stat(PG_FUNCTION_ARGS);
+
 #endif   /* PLANCACHE_H */
@@ -295,10 +295,12 @@ typedef struct StdRdOptions {
     int partial_cluster_rows;      /* row numbers of partial cluster feature */
     int compresslevel;             /* compress level, see relation storage options 'compresslevel' */
     int internalMask;              /*internal mask*/
+    int parallel_workers;          /* worker threads to build an index or vacuum a table's indexes, -1 if not set */
     bool ignore_enable_hadoop_env; /* ignore enable_hadoop_env */
     bool user_catalog_table;       /* use as an additional catalog relation */
     bool hashbucket;        /* enable hash bucket for this relation */
     bool primarynode;       /* enable primarynode mode for replication table */
+    bool deduplicate_items; /* merge duplicate btree keys into posting lists */
     /* info for redistribution */
     Oid rel_cn_oid;
     RedisHtlAction append_mode_internal;
@@ -353,6 +355,22 @@ typedef struct StdRdOptions {
 #define RelationGetFillFactor(relation, defaultff) \
     ((relation)->rd_options ? ((StdRdOptions*)(relation)->rd_options)->fillfactor : (defaultff))
 
+/*
+ * RelationGetParallelWorkers
+ *		Returns the relation's parallel_workers reloption setting.
+ *		Note multiple eval of argument!
+ */
+#define RelationGetParallelWorkers(relation, defaultpw) \
+    ((relation)->rd_options ? ((StdRdOptions*)(relation)->rd_options)->parallel_workers : (defaultpw))
+
+/*
+ * RelationGetDeduplicateItems
+ *		Returns the relation's deduplicate_items reloption setting.
+ *		Note multiple eval of argument!
+ */
+#define RelationGetDeduplicateItems(relation) \
+    ((relation)->rd_options ? ((StdRdOptions*)(relation)->rd_options)->deduplicate_items : false)
+
 /*
  * RelationGetTargetPageUsage
  *		Returns the relation's desired space usage per page in bytes.
@@ -67,6 +67,8 @@ extern Tuplesortstate* tuplesort_begin_index_btree(
     Relation indexRel, bool enforceUnique, int workMem, bool randomAccess, int maxMem);
 extern Tuplesortstate* tuplesort_begin_index_hash(
     Relation indexRel, uint32 hash_mask, int workMem, bool randomAccess, int maxMem);
+extern Tuplesortstate* tuplesort_begin_index_sortkey(
+    Relation indexRel, FmgrInfo* sortkeyProc, int workMem, bool randomAccess, int maxMem);
 extern Tuplesortstate* tuplesort_begin_datum(
     Oid datumType, Oid sortOperator, Oid sortCollation, bool nullsFirstFlag, int workMem, bool randomAccess);
 #ifdef PGXC
@@ -78,6 +80,7 @@ extern void tuplesort_set_bound(Tuplesortstate* state, int64 bound);
 
 extern void tuplesort_puttupleslot(Tuplesortstate* state, TupleTableSlot* slot);
 extern void tuplesort_putheaptuple(Tuplesortstate* state, HeapTuple tup);
+extern void tuplesort_putindextuple(Tuplesortstate* state, IndexTuple tuple);
 extern void tuplesort_putindextuplevalues(
     Tuplesortstate* state, Relation rel, ItemPointer self, Datum* values, const bool* isnull);
 extern void tuplesort_putdatum(Tuplesortstate* state, Datum val, bool isNull);
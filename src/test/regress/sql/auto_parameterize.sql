@@ -0,0 +1,41 @@
+--
+-- AUTO PARAMETERIZE
+-- Statements of the same shape whose literals differ in type must not share a plan.
+--
+SET enable_auto_parameterize = on;
+CREATE TABLE auto_param_t (a int4, b numeric, c int8);
+INSERT INTO auto_param_t VALUES (1, 1.5, 5000000000);
+INSERT INTO auto_param_t VALUES (2, 2, 2);
+
+-- comparisons
+SELECT a FROM auto_param_t WHERE a = 1;
+SELECT a FROM auto_param_t WHERE a = 1.5;
+SELECT a FROM auto_param_t WHERE a = 5000000000;
+SELECT a FROM auto_param_t WHERE a = 2;
+SELECT a FROM auto_param_t WHERE a = 1.5;
+
+-- expressions in the target list
+SELECT a + 1 AS r FROM auto_param_t WHERE a = 2;
+SELECT a + 1.5 AS r FROM auto_param_t WHERE a = 2;
+SELECT a + 5000000000 AS r FROM auto_param_t WHERE a = 2;
+SELECT a + 1 AS r FROM auto_param_t WHERE a = 2;
+
+-- literals repeated in GROUP BY, ORDER BY, DISTINCT ON and HAVING
+SELECT a + 1 AS r, count(*) FROM auto_param_t GROUP BY a + 1 ORDER BY 1;
+SELECT a + 2 AS r, count(*) FROM auto_param_t GROUP BY a + 2 ORDER BY 1;
+SELECT a FROM auto_param_t ORDER BY a % 2, a;
+SELECT DISTINCT ON (a % 2) a % 2 AS m, a FROM auto_param_t ORDER BY a % 2, a;
+SELECT a + 1 AS r FROM auto_param_t GROUP BY a + 1 HAVING a + 1 > 2;
+SELECT a, sum(b) FROM auto_param_t GROUP BY a HAVING sum(b) > 1.75 ORDER BY a;
+
+-- DML
+UPDATE auto_param_t SET b = 2.25 WHERE a = 2;
+UPDATE auto_param_t SET b = 3 WHERE a = 2;
+SELECT b FROM auto_param_t WHERE a = 2;
+DELETE FROM auto_param_t WHERE a = 1.5;
+SELECT count(*) FROM auto_param_t;
+DELETE FROM auto_param_t WHERE a = 1;
+SELECT a, b, c FROM auto_param_t ORDER BY a;
+
+DROP TABLE auto_param_t;
+RESET enable_auto_parameterize;
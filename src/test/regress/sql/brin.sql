@@ -0,0 +1,43 @@
+--
+-- BRIN indexes
+--
+CREATE TABLE brin_t (a int4, b text);
+INSERT INTO brin_t SELECT g, 'x' || g FROM generate_series(1, 10000) g;
+CREATE INDEX brin_t_a ON brin_t USING brin (a) WITH (pages_per_range = 2);
+CREATE INDEX brin_t_b ON brin_t USING brin (b text_bloom_ops) WITH (pages_per_range = 2);
+
+-- the build summarizes every range, including the last partial one
+SELECT brin_summarize_new_values('brin_t_a');
+
+SET enable_seqscan = off;
+EXPLAIN (COSTS OFF) SELECT count(*) FROM brin_t WHERE a BETWEEN 100 AND 200;
+SELECT count(*) FROM brin_t WHERE a BETWEEN 100 AND 200;
+SELECT count(*) FROM brin_t WHERE b = 'x500';
+
+-- updates widen the summary of the range the new version lands in
+UPDATE brin_t SET a = 20000 WHERE a = 1;
+SELECT count(*) FROM brin_t WHERE a = 20000;
+SELECT count(*) FROM brin_t WHERE a < 10;
+
+-- ranges added after the build stay unsummarized, and match any scan, until summarized
+INSERT INTO brin_t SELECT g, 'y' || g FROM generate_series(30001, 40000) g;
+SELECT count(*) FROM brin_t WHERE a > 30000;
+SELECT brin_summarize_new_values('brin_t_a') > 0 AS summarized;
+SELECT brin_summarize_new_values('brin_t_a');
+SELECT brin_summarize_new_values('brin_t_b') > 0 AS summarized;
+SELECT count(*) FROM brin_t WHERE a > 30000;
+SELECT count(*) FROM brin_t WHERE b = 'y35000';
+
+-- autosummarize only queues work for autovacuum; scans are correct either way
+CREATE INDEX brin_t_auto ON brin_t USING brin (a) WITH (autosummarize = on, pages_per_range = 1);
+SELECT reloptions FROM pg_class WHERE relname = 'brin_t_auto';
+INSERT INTO brin_t SELECT g, 'z' || g FROM generate_series(50001, 60000) g;
+SELECT count(*) FROM brin_t WHERE a BETWEEN 50001 AND 50100;
+RESET enable_seqscan;
+
+-- errors
+CREATE INDEX brin_t_bad ON brin_t USING brin (a) WITH (pages_per_range = 0);
+CREATE INDEX brin_t_btree ON brin_t (a);
+SELECT brin_summarize_new_values('brin_t_btree');
+
+DROP TABLE brin_t;
@@ -0,0 +1,35 @@
+--
+-- B-tree bottom-up deletion
+-- Only inserts of duplicate keys into a full leaf page, with
+-- enable_btree_bottomup_delete on, read the heap to remove dead duplicates.
+--
+CREATE TABLE bt_bottomup_t (k int4, v int4);
+CREATE INDEX bt_bottomup_k ON bt_bottomup_t (k);
+CREATE TABLE bt_bottomup_s AS SELECT passes FROM gs_btree_bottomup_stat();
+
+-- off by default
+SHOW enable_btree_bottomup_delete;
+INSERT INTO bt_bottomup_t SELECT 1, g FROM generate_series(1, 1000) g;
+SELECT b.passes = s.passes AS unchanged FROM gs_btree_bottomup_stat() b, bt_bottomup_s s;
+
+-- unique keys never trigger it
+SET enable_btree_bottomup_delete = on;
+INSERT INTO bt_bottomup_t SELECT g + 1, g FROM generate_series(1, 1000) g;
+SELECT b.passes = s.passes AS unchanged FROM gs_btree_bottomup_stat() b, bt_bottomup_s s;
+
+-- duplicates filling a leaf page do
+DELETE FROM bt_bottomup_t WHERE k = 1;
+INSERT INTO bt_bottomup_t SELECT 1, g FROM generate_series(1, 1000) g;
+SELECT b.passes > s.passes AS ran FROM gs_btree_bottomup_stat() b, bt_bottomup_s s;
+
+-- the index still finds every live row
+SET enable_seqscan = off;
+SET enable_bitmapscan = off;
+SELECT count(*), min(v), max(v) FROM bt_bottomup_t WHERE k = 1;
+SELECT count(*) FROM bt_bottomup_t WHERE k > 1;
+RESET enable_seqscan;
+RESET enable_bitmapscan;
+RESET enable_btree_bottomup_delete;
+
+DROP TABLE bt_bottomup_s;
+DROP TABLE bt_bottomup_t;
@@ -0,0 +1,38 @@
+--
+-- B-tree deduplication
+-- With deduplicate_items on, equal keys are merged into posting tuples
+-- instead of splitting a full leaf page.
+--
+CREATE TABLE bt_dedup_t (k int4, v int4);
+CREATE INDEX bt_dedup_k ON bt_dedup_t (k) WITH (deduplicate_items = on);
+CREATE INDEX bt_plain_k ON bt_dedup_t (k);
+SELECT reloptions FROM pg_class WHERE relname = 'bt_dedup_k';
+CREATE TABLE bt_dedup_s AS
+SELECT pg_relation_size('bt_dedup_k') AS dedup_size, pg_relation_size('bt_plain_k') AS plain_size;
+SELECT dedup_size = plain_size AS same_size FROM bt_dedup_s;
+
+-- both indexes grow with many duplicates, the deduplicated one far less
+INSERT INTO bt_dedup_t SELECT g % 10, g FROM generate_series(1, 100000) g;
+SELECT pg_relation_size('bt_dedup_k') > dedup_size AS grew,
+       pg_relation_size('bt_dedup_k') * 2 < pg_relation_size('bt_plain_k') AS smaller
+FROM bt_dedup_s;
+
+-- scans return one row per heap TID of a posting tuple
+DROP INDEX bt_plain_k;
+SET enable_seqscan = off;
+SET enable_bitmapscan = off;
+EXPLAIN (COSTS OFF) SELECT count(*), min(v), max(v) FROM bt_dedup_t WHERE k = 3;
+SELECT count(*), min(v), max(v) FROM bt_dedup_t WHERE k = 3;
+SELECT count(*) FROM bt_dedup_t WHERE k BETWEEN 2 AND 4;
+SELECT k, count(*) FROM bt_dedup_t WHERE k < 3 GROUP BY k ORDER BY k;
+
+-- VACUUM removes dead TIDs from posting tuples
+DELETE FROM bt_dedup_t WHERE v % 20 < 10;
+VACUUM bt_dedup_t;
+SELECT count(*), min(v), max(v) FROM bt_dedup_t WHERE k = 3;
+SELECT count(*) FROM bt_dedup_t WHERE k BETWEEN 2 AND 4;
+RESET enable_seqscan;
+RESET enable_bitmapscan;
+
+DROP TABLE bt_dedup_s;
+DROP TABLE bt_dedup_t;
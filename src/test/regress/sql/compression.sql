@@ -0,0 +1,47 @@
+--
+-- TOAST compression methods
+--
+CREATE TABLE cmdata (id int, f1 text);
+SHOW default_toast_compression;
+INSERT INTO cmdata VALUES (1, repeat('1234567890', 1000));
+
+-- a column's option takes effect for the next rows
+ALTER TABLE cmdata ALTER COLUMN f1 SET COMPRESSION lz4;
+INSERT INTO cmdata VALUES (2, repeat('1234567890', 1000));
+ALTER TABLE cmdata ALTER COLUMN f1 SET COMPRESSION zstd;
+INSERT INTO cmdata VALUES (3, repeat('1234567890', 1000));
+
+-- values too large to stay inline are compressed before being moved out
+INSERT INTO cmdata SELECT 4, string_agg(g::text, ',') FROM generate_series(1, 100000) g;
+ALTER TABLE cmdata ALTER COLUMN f1 SET COMPRESSION lz4;
+INSERT INTO cmdata SELECT 5, string_agg(g::text, ',') FROM generate_series(1, 100000) g;
+
+-- without the option, default_toast_compression is used
+ALTER TABLE cmdata ALTER COLUMN f1 SET COMPRESSION DEFAULT;
+SET default_toast_compression = zstd;
+INSERT INTO cmdata VALUES (6, repeat('1234567890', 1000));
+RESET default_toast_compression;
+INSERT INTO cmdata SELECT 7, string_agg(g::text, ',') FROM generate_series(1, 100000) g;
+
+-- short values are not compressed at all
+INSERT INTO cmdata VALUES (8, 'short');
+
+SELECT id, pg_column_compression(f1), length(f1) FROM cmdata ORDER BY id;
+SELECT count(DISTINCT md5(f1)) FROM cmdata;
+SELECT substr(f1, 1, 12) FROM cmdata WHERE id = 5;
+
+-- partitions follow the options of their table
+CREATE TABLE cmpart (id int, f1 text) PARTITION BY RANGE (id)
+(
+    PARTITION cmpart_p1 VALUES LESS THAN (10),
+    PARTITION cmpart_p2 VALUES LESS THAN (MAXVALUE)
+);
+ALTER TABLE cmpart ALTER COLUMN f1 SET COMPRESSION lz4;
+INSERT INTO cmpart VALUES (1, repeat('1234567890', 1000)), (20, repeat('1234567890', 1000));
+SELECT id, pg_column_compression(f1) FROM cmpart ORDER BY id;
+
+-- errors
+ALTER TABLE cmdata ALTER COLUMN f1 SET COMPRESSION foo;
+
+DROP TABLE cmpart;
+DROP TABLE cmdata;
@@ -0,0 +1,28 @@
+--
+-- Per-backend extents of new heap blocks (heap_extent_max_blocks)
+--
+CREATE TABLE heap_extent_t (a int4, b char(200));
+CREATE TABLE heap_extent_size (size int8);
+
+SET heap_extent_max_blocks = 64;
+INSERT INTO heap_extent_t SELECT g, 'x' FROM generate_series(1, 20000) g;
+INSERT INTO heap_extent_t VALUES (20001, 'y');
+INSERT INTO heap_extent_t VALUES (20002, 'y');
+SELECT count(*), sum(a) FROM heap_extent_t;
+SELECT count(*) FROM heap_extent_t WHERE b = 'y';
+INSERT INTO heap_extent_size SELECT pg_relation_size('heap_extent_t');
+
+-- blocks left over in the extent are in the FSM, so another session fills them before extending
+\c regression
+SET heap_extent_max_blocks = 0;
+INSERT INTO heap_extent_t SELECT g, 'z' FROM generate_series(1, (SELECT size / 8192 * 40 FROM heap_extent_size)) g;
+SELECT pg_relation_size('heap_extent_t') / 8192 =
+       count(DISTINCT split_part(trim(both '()' FROM ctid::text), ',', 1)) AS no_empty_blocks
+FROM heap_extent_t;
+SELECT count(*) = 20002 + (SELECT size / 8192 * 40 FROM heap_extent_size) AS all_rows FROM heap_extent_t;
+
+-- out of range
+SET heap_extent_max_blocks = 8193;
+RESET heap_extent_max_blocks;
+DROP TABLE heap_extent_t;
+DROP TABLE heap_extent_size;
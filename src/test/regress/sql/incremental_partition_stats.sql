@@ -0,0 +1,39 @@
+--
+-- Statistics of partitioned tables merged from per-partition summaries
+-- (enable_incremental_partition_stats)
+--
+CREATE TABLE ips_t (a int4, b int4, c text)
+PARTITION BY RANGE (a)
+(
+    PARTITION ips_p1 VALUES LESS THAN (1001),
+    PARTITION ips_p2 VALUES LESS THAN (2001),
+    PARTITION ips_p3 VALUES LESS THAN (MAXVALUE)
+);
+-- a is unique, b has the same 10 values in every partition, c is a quarter NULL
+INSERT INTO ips_t SELECT g, g % 10, CASE WHEN g % 4 = 0 THEN NULL ELSE 'c' || g END FROM generate_series(1, 3000) g;
+
+SHOW enable_incremental_partition_stats;
+SET enable_incremental_partition_stats = on;
+ANALYZE ips_t;
+SELECT p.relname, count(*) FROM pg_statistic s JOIN pg_partition p ON s.starelid = p.oid
+WHERE s.starelkind = 'p' AND p.parentid = 'ips_t'::regclass GROUP BY p.relname ORDER BY p.relname;
+SELECT attname, null_frac FROM pg_stats WHERE tablename = 'ips_t' ORDER BY attname;
+SELECT n_distinct FROM pg_stats WHERE tablename = 'ips_t' AND attname = 'b';
+-- distinct values of disjoint partitions add up
+SELECT n_distinct < -0.9 AS mostly_unique FROM pg_stats WHERE tablename = 'ips_t' AND attname = 'a';
+
+-- only the changed partition is sampled again
+INSERT INTO ips_t SELECT 2000 + g, g % 10, NULL FROM generate_series(1, 1000) g;
+ANALYZE ips_t;
+SELECT p.relname, s.stanullfrac FROM pg_statistic s JOIN pg_partition p ON s.starelid = p.oid
+WHERE s.starelkind = 'p' AND p.parentid = 'ips_t'::regclass AND s.staattnum = 3 ORDER BY p.relname;
+SELECT attname, null_frac FROM pg_stats WHERE tablename = 'ips_t' ORDER BY attname;
+SELECT n_distinct FROM pg_stats WHERE tablename = 'ips_t' AND attname = 'b';
+
+-- without the setting, the whole table is sampled and gives the same result
+RESET enable_incremental_partition_stats;
+ANALYZE ips_t;
+SELECT attname, null_frac FROM pg_stats WHERE tablename = 'ips_t' ORDER BY attname;
+SELECT n_distinct FROM pg_stats WHERE tablename = 'ips_t' AND attname = 'b';
+
+DROP TABLE ips_t;
@@ -0,0 +1,43 @@
+--
+-- MOT tables with a hash primary key and hash secondary indexes
+--
+
+CREATE FOREIGN TABLE hash_pk_t (a int4, b int4, c varchar(10), PRIMARY KEY USING hash (a)) SERVER mot_server;
+CREATE INDEX hash_pk_t_b ON hash_pk_t USING hash (b);
+SELECT pg_get_constraintdef(oid) FROM pg_constraint WHERE conname = 'hash_pk_t_pkey';
+INSERT INTO hash_pk_t SELECT i, i % 10, 'v' || i FROM generate_series(1, 100) i;
+INSERT INTO hash_pk_t VALUES (1, 1, 'dup');
+
+-- point lookups
+SELECT a, b, c FROM hash_pk_t WHERE a = 42;
+SELECT count(*) FROM hash_pk_t WHERE b = 3;
+
+-- full, range and ordered scans
+SELECT count(*), sum(a) FROM hash_pk_t;
+SELECT a FROM hash_pk_t WHERE a > 97 ORDER BY a;
+SELECT a FROM hash_pk_t WHERE a BETWEEN 10 AND 13 ORDER BY a DESC;
+SELECT a, c FROM hash_pk_t ORDER BY a LIMIT 3;
+
+-- DML
+UPDATE hash_pk_t SET c = 'upd' WHERE a = 42;
+DELETE FROM hash_pk_t WHERE a > 50;
+SELECT count(*), max(a) FROM hash_pk_t;
+SELECT c FROM hash_pk_t WHERE a = 42;
+
+DROP FOREIGN TABLE hash_pk_t;
+
+-- many duplicates of a few keys of a non-unique hash index
+CREATE FOREIGN TABLE hash_dup_t (a int4 PRIMARY KEY, b int4) SERVER mot_server;
+CREATE INDEX hash_dup_t_b ON hash_dup_t USING hash (b);
+INSERT INTO hash_dup_t SELECT i, i % 3 FROM generate_series(1, 6000) i;
+SELECT b, count(*), sum(a) FROM hash_dup_t WHERE b = 1 GROUP BY b;
+DELETE FROM hash_dup_t WHERE b = 2 AND a > 3000;
+UPDATE hash_dup_t SET b = 5 WHERE b = 0 AND a <= 300;
+SELECT count(*) FROM hash_dup_t WHERE b = 0;
+SELECT count(*) FROM hash_dup_t WHERE b = 2;
+SELECT count(*), min(a), max(a) FROM hash_dup_t WHERE b = 5;
+DELETE FROM hash_dup_t WHERE b = 5;
+SELECT count(*) FROM hash_dup_t WHERE b = 5;
+SELECT count(*) FROM hash_dup_t;
+
+DROP FOREIGN TABLE hash_dup_t;
@@ -0,0 +1,32 @@
+--
+-- Hot-row locking of MOT tables and the contention statistics it reports
+--
+
+CREATE FOREIGN TABLE hot_row_t (a int4 PRIMARY KEY, b int4) SERVER mot_server;
+INSERT INTO hot_row_t SELECT i, 0 FROM generate_series(1, 10) i;
+
+SHOW enable_hot_row_locking;
+SET enable_hot_row_locking = on;
+SHOW enable_hot_row_locking;
+
+-- a single session never fails commit-time validation, so no row becomes hot
+UPDATE hot_row_t SET b = b + 1 WHERE a = 1;
+UPDATE hot_row_t SET b = b + 1 WHERE a = 1;
+BEGIN;
+UPDATE hot_row_t SET b = b + 1 WHERE a = 1;
+UPDATE hot_row_t SET b = b + 1 WHERE a <= 5;
+COMMIT;
+BEGIN;
+UPDATE hot_row_t SET b = b + 100 WHERE a = 1;
+ROLLBACK;
+DELETE FROM hot_row_t WHERE a = 10;
+SELECT a, b FROM hot_row_t WHERE b > 0 ORDER BY a;
+
+SELECT relid = 'hot_row_t'::regclass AS relid_matches, relname, conflicts, hot_rows, hot_row_locks,
+    hot_row_lock_timeouts
+    FROM mot_table_contention_detail() WHERE relname = 'hot_row_t';
+
+RESET enable_hot_row_locking;
+SHOW enable_hot_row_locking;
+DROP FOREIGN TABLE hot_row_t;
+SELECT count(*) FROM mot_table_contention_detail() WHERE relname = 'hot_row_t';
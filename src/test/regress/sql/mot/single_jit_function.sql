@@ -0,0 +1,53 @@
+--
+-- Statements of PL/pgSQL functions on MOT tables are jitted: repeated range scans and DML row counts
+--
+
+CREATE FOREIGN TABLE jit_fn_t (id int4 PRIMARY KEY, v int4) SERVER mot_server;
+INSERT INTO jit_fn_t SELECT i, i * 10 FROM generate_series(1, 20) i;
+
+-- the same range select runs several times in one call, and again in the next call
+CREATE FUNCTION jit_fn_range(lo int4, hi int4, reps int4) RETURNS text AS $$
+DECLARE
+    c int8;
+    m int4;
+    res text := '';
+BEGIN
+    FOR i IN 1..reps LOOP
+        SELECT count(*) INTO c FROM jit_fn_t WHERE id >= lo AND id <= hi;
+        SELECT max(v) INTO m FROM jit_fn_t WHERE id >= lo AND id <= hi;
+        res := res || c || '/' || m || ' ';
+    END LOOP;
+    RETURN res;
+END;
+$$ LANGUAGE plpgsql;
+SELECT jit_fn_range(3, 7, 3);
+SELECT jit_fn_range(3, 7, 2);
+SELECT jit_fn_range(15, 30, 2);
+
+-- DML passes its row count back to the function
+CREATE FUNCTION jit_fn_dml(k int4) RETURNS text AS $$
+DECLARE
+    n int;
+    res text;
+BEGIN
+    INSERT INTO jit_fn_t VALUES (k, k * 10);
+    GET DIAGNOSTICS n = ROW_COUNT;
+    res := 'insert ' || n;
+    UPDATE jit_fn_t SET v = v + 1 WHERE id = k;
+    GET DIAGNOSTICS n = ROW_COUNT;
+    res := res || ', update ' || n;
+    UPDATE jit_fn_t SET v = v + 1 WHERE id = k + 1000;
+    res := res || CASE WHEN FOUND THEN ', found' ELSE ', not found' END;
+    DELETE FROM jit_fn_t WHERE id = k;
+    GET DIAGNOSTICS n = ROW_COUNT;
+    res := res || ', delete ' || n;
+    RETURN res;
+END;
+$$ LANGUAGE plpgsql;
+SELECT jit_fn_dml(100);
+SELECT jit_fn_dml(101);
+SELECT count(*), sum(v) FROM jit_fn_t;
+
+DROP FUNCTION jit_fn_range;
+DROP FUNCTION jit_fn_dml;
+DROP FOREIGN TABLE jit_fn_t;
@@ -0,0 +1,60 @@
+--
+-- MOT tables placed on NUMA nodes
+--
+
+CREATE FOREIGN TABLE numa_fixed_t (a int4 PRIMARY KEY, b int4, c varchar(10)) SERVER mot_server OPTIONS (numa_node '0');
+CREATE INDEX numa_fixed_t_b ON numa_fixed_t (b);
+CREATE FOREIGN TABLE numa_hash_t (a int4 PRIMARY KEY, b int4, c varchar(10)) SERVER mot_server OPTIONS (numa_node 'hash');
+CREATE INDEX numa_hash_t_b ON numa_hash_t (b);
+CREATE FOREIGN TABLE numa_none_t (a int4 PRIMARY KEY) SERVER mot_server;
+SELECT c.relname, ft.ftoptions FROM pg_foreign_table ft JOIN pg_class c ON c.oid = ft.ftrelid
+    WHERE c.relname IN ('numa_fixed_t', 'numa_hash_t') ORDER BY c.relname;
+
+-- invalid placements
+\set VERBOSITY terse
+CREATE FOREIGN TABLE numa_bad_t (a int4) SERVER mot_server OPTIONS (numa_node '1024');
+CREATE FOREIGN TABLE numa_bad_t (a int4) SERVER mot_server OPTIONS (numa_node '-1');
+CREATE FOREIGN TABLE numa_bad_t (a int4) SERVER mot_server OPTIONS (numa_node 'any');
+\set VERBOSITY default
+
+-- placement is fixed once the table is created
+ALTER FOREIGN TABLE numa_fixed_t OPTIONS (SET numa_node 'hash');
+ALTER FOREIGN TABLE numa_hash_t OPTIONS (DROP numa_node);
+ALTER FOREIGN TABLE numa_none_t OPTIONS (ADD numa_node '0');
+
+-- rows of placed tables
+INSERT INTO numa_fixed_t SELECT i, i % 10, 'f' || i FROM generate_series(1, 1000) i;
+INSERT INTO numa_hash_t SELECT i, i % 10, 'h' || i FROM generate_series(1, 1000) i;
+SELECT count(*), sum(a) FROM numa_fixed_t;
+SELECT count(*), sum(a) FROM numa_hash_t;
+SELECT a, b, c FROM numa_hash_t WHERE a = 500;
+SELECT count(*) FROM numa_hash_t WHERE b = 3;
+UPDATE numa_hash_t SET c = 'upd' WHERE a <= 10;
+DELETE FROM numa_hash_t WHERE b = 0;
+SELECT count(*), max(a) FROM numa_hash_t;
+SELECT count(*) FROM numa_hash_t WHERE c = 'upd';
+
+-- placement is kept across truncate
+TRUNCATE numa_hash_t;
+INSERT INTO numa_hash_t SELECT i, i % 10, 'h' || i FROM generate_series(1, 100) i;
+SELECT count(*), sum(a) FROM numa_hash_t;
+
+-- sessions working on placed tables may be moved to another thread pool group between commands
+BEGIN;
+SELECT count(*) FROM numa_fixed_t WHERE b = 1;
+UPDATE numa_fixed_t SET c = 'txn' WHERE a = 1;
+SELECT count(*) FROM numa_none_t;
+SELECT c FROM numa_fixed_t WHERE a = 1;
+COMMIT;
+BEGIN;
+DELETE FROM numa_fixed_t WHERE a = 2;
+SELECT a FROM numa_fixed_t WHERE a = 2;
+ROLLBACK;
+SELECT a, c FROM numa_fixed_t WHERE a <= 2 ORDER BY a;
+INSERT INTO numa_none_t SELECT a FROM numa_fixed_t WHERE a <= 5;
+SELECT count(*) FROM numa_none_t;
+SELECT f.a, h.c FROM numa_fixed_t f JOIN numa_hash_t h ON f.a = h.a WHERE f.a <= 3 ORDER BY f.a;
+
+DROP FOREIGN TABLE numa_fixed_t;
+DROP FOREIGN TABLE numa_hash_t;
+DROP FOREIGN TABLE numa_none_t;
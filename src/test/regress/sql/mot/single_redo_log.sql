@@ -0,0 +1,37 @@
+--
+-- Committed MOT transactions go through the redo log handler and must stay visible
+--
+
+CREATE FOREIGN TABLE redo_t (a int4 PRIMARY KEY, b text) SERVER mot_server;
+
+-- one transaction per statement
+INSERT INTO redo_t VALUES (1, 'one');
+INSERT INTO redo_t VALUES (2, 'two');
+UPDATE redo_t SET b = 'uno' WHERE a = 1;
+DELETE FROM redo_t WHERE a = 2;
+SELECT a, b FROM redo_t ORDER BY a;
+
+-- a transaction larger than the redo buffer is written in several parts before its commit
+INSERT INTO redo_t SELECT i, repeat('x', 200) FROM generate_series(100, 20099) i;
+SELECT count(*), sum(length(b)) FROM redo_t;
+
+-- rolled back transactions leave nothing behind
+START TRANSACTION;
+INSERT INTO redo_t VALUES (3, 'three');
+DELETE FROM redo_t WHERE a >= 100;
+ROLLBACK;
+SELECT count(*) FROM redo_t;
+
+-- several statements in one transaction
+START TRANSACTION;
+INSERT INTO redo_t VALUES (3, 'three');
+UPDATE redo_t SET b = 'y' WHERE a BETWEEN 100 AND 199;
+DELETE FROM redo_t WHERE a >= 10000;
+COMMIT;
+SELECT count(*) FROM redo_t;
+SELECT b, count(*) FROM redo_t WHERE a < 200 GROUP BY b ORDER BY b;
+
+CHECKPOINT;
+SELECT count(*), sum(length(b)) FROM redo_t;
+
+DROP FOREIGN TABLE redo_t;
@@ -0,0 +1,29 @@
+--
+-- Vectorized scans of MOT tables must return the same results as row scans
+--
+
+CREATE FOREIGN TABLE vec_scan_t (a int4 PRIMARY KEY, b int4, c int8) SERVER mot_server;
+INSERT INTO vec_scan_t SELECT i, i % 100, i * 2 FROM generate_series(1, 3000) i;
+ANALYZE vec_scan_t;
+
+-- vector engine; the table holds more than a batch (BatchMaxSize rows), so full scans fill batches
+SET enable_vector_engine = on;
+SET enable_vectorized_scan = on;
+EXPLAIN (COSTS OFF) SELECT sum(c) FROM vec_scan_t;
+SELECT count(*), sum(a), min(b), max(b) FROM vec_scan_t WHERE a > 100;
+SELECT count(*), sum(c) FROM vec_scan_t WHERE b < 50;
+SELECT a, b FROM vec_scan_t WHERE c > 5980 ORDER BY a;
+SELECT b, count(*) FROM vec_scan_t WHERE a > 2900 GROUP BY b ORDER BY b LIMIT 3;
+
+-- row engine
+SET enable_vectorized_scan = off;
+SET enable_vector_engine = off;
+EXPLAIN (COSTS OFF) SELECT sum(c) FROM vec_scan_t;
+SELECT count(*), sum(a), min(b), max(b) FROM vec_scan_t WHERE a > 100;
+SELECT count(*), sum(c) FROM vec_scan_t WHERE b < 50;
+SELECT a, b FROM vec_scan_t WHERE c > 5980 ORDER BY a;
+SELECT b, count(*) FROM vec_scan_t WHERE a > 2900 GROUP BY b ORDER BY b LIMIT 3;
+
+RESET enable_vectorized_scan;
+RESET enable_vector_engine;
+DROP FOREIGN TABLE vec_scan_t;
@@ -0,0 +1,33 @@
+--
+-- Parallel B-tree index builds
+-- Workers each sort stripes of the heap, the leader merges their runs.
+--
+CREATE TABLE pib_t (a int4, b int4, c text);
+INSERT INTO pib_t SELECT g, g % 1000, 'v' || (g % 5000) FROM generate_series(1, 200000) g;
+DELETE FROM pib_t WHERE a % 7 = 0;
+
+SET max_parallel_maintenance_workers = 4;
+CREATE INDEX pib_a ON pib_t (a);
+CREATE UNIQUE INDEX pib_a_uniq ON pib_t (a);
+CREATE INDEX pib_bc ON pib_t (b, c);
+-- the storage parameter wins over the setting
+SET max_parallel_maintenance_workers = 0;
+CREATE INDEX pib_c ON pib_t (c) WITH (parallel_workers = 2);
+RESET max_parallel_maintenance_workers;
+
+-- every index holds exactly the live rows
+SET enable_seqscan = off;
+SET enable_bitmapscan = off;
+SELECT count(*), sum(a) FROM pib_t WHERE a > 0;
+SELECT count(*) FROM pib_t WHERE b = 500;
+SELECT count(*) FROM pib_t WHERE b = 500 AND c = 'v500';
+SELECT count(*) FROM pib_t WHERE c = 'v4999';
+SELECT a FROM pib_t WHERE a BETWEEN 99995 AND 100005 ORDER BY a;
+RESET enable_seqscan;
+RESET enable_bitmapscan;
+SELECT count(*), sum(a) FROM pib_t;
+
+-- the unique index is enforced
+INSERT INTO pib_t VALUES (1, 1, 'v1');
+
+DROP TABLE pib_t;
@@ -0,0 +1,27 @@
+--
+-- VACUUM of sparse and dense dead tuples
+-- The dead tuples of a block are remembered as an array of offsets when the
+-- block has only a few of them, and as a bitmap otherwise.
+--
+CREATE TABLE vac_tids_t (a int4, b int4) WITH (autovacuum_enabled = off);
+CREATE INDEX vac_tids_a ON vac_tids_t (a);
+INSERT INTO vac_tids_t SELECT g, g FROM generate_series(1, 50000) g;
+
+-- sparse: a few dead tuples on every block
+DELETE FROM vac_tids_t WHERE a % 100 = 0;
+-- dense: most tuples of the blocks at the end
+DELETE FROM vac_tids_t WHERE a > 40000 AND a % 10 <> 1;
+VACUUM vac_tids_t;
+
+-- the freed line pointers are reused; index entries still pointing at them would return the new rows
+INSERT INTO vac_tids_t SELECT -g, -g FROM generate_series(1, 10000) g;
+SET enable_seqscan = off;
+SET enable_bitmapscan = off;
+SELECT count(*), sum(a), min(b) FROM vac_tids_t WHERE a > 0;
+SELECT count(*) FROM vac_tids_t WHERE a > 0 AND a % 100 = 0;
+SELECT count(*), max(b) FROM vac_tids_t WHERE a < 0;
+RESET enable_seqscan;
+RESET enable_bitmapscan;
+SELECT count(*), sum(a), min(b) FROM vac_tids_t WHERE a > 0;
+
+DROP TABLE vac_tids_t;
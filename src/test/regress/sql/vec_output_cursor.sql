@@ -0,0 +1,31 @@
+--
+-- Batch output of vectorized plans through cursors fetched in parts
+--
+SET enable_vector_output = on;
+CREATE TABLE vec_output_t (a int4, b text) WITH (orientation = column);
+INSERT INTO vec_output_t SELECT i, 'row' || i FROM generate_series(1, 5) i;
+
+START TRANSACTION;
+CURSOR vec_output_c FOR SELECT a, b FROM vec_output_t ORDER BY a;
+FETCH 2 FROM vec_output_c;
+FETCH ALL FROM vec_output_c;
+FETCH ALL FROM vec_output_c;
+CLOSE vec_output_c;
+END;
+
+START TRANSACTION;
+CURSOR vec_output_c FOR SELECT a FROM vec_output_t ORDER BY a;
+FETCH 1 FROM vec_output_c;
+FETCH 1 FROM vec_output_c;
+FETCH ALL FROM vec_output_c;
+CLOSE vec_output_c;
+END;
+
+START TRANSACTION;
+CURSOR vec_output_c FOR SELECT a FROM vec_output_t ORDER BY a;
+FETCH ALL FROM vec_output_c;
+CLOSE vec_output_c;
+END;
+
+DROP TABLE vec_output_t;
+RESET enable_vector_output;